@@ -0,0 +1,16 @@
+precision highp float;
+
+uniform sampler2D uTexDepth;
+
+in vec2 varTexCoord0;
+
+out vec4 FragColor;
+
+void main(void)
+{
+	// the depth is written as ShadowDepthWriteFS, it is the depth buffer value too
+	float depth = texture(uTexDepth, varTexCoord0.xy).r;
+
+	FragColor = vec4(depth, 0.0, 0.0, 0.0);
+	gl_FragDepth = depth;
+}
\ No newline at end of file
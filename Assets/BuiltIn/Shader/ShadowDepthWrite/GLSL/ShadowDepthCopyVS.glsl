@@ -0,0 +1,14 @@
+in vec4 inPosition;
+in vec3 inNormal;
+in vec4 inColor;
+in vec2 inTexCoord0;
+
+uniform mat4 uMvpMatrix;
+
+out vec2 varTexCoord0;
+
+void main(void)
+{
+	varTexCoord0 = inTexCoord0;
+	gl_Position = uMvpMatrix * inPosition;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+Texture2D uTexDepth : register(t0);
+SamplerState uTexDepthSampler : register(s0);
+
+struct PS_INPUT
+{
+	float4 pos : SV_POSITION;
+	float2 tex0 : TEXCOORD0;
+};
+
+struct PS_OUTPUT
+{
+	float4 color : SV_TARGET;
+	float depth : SV_DEPTH;
+};
+
+PS_OUTPUT main(PS_INPUT input)
+{
+	PS_OUTPUT output;
+
+	// the depth is written as ShadowDepthWriteFS (z * 0.5 + 0.5), the depth buffer value is z
+	float depth = uTexDepth.Sample(uTexDepthSampler, input.tex0).r;
+
+	output.color = float4(depth, 0.0, 0.0, 0.0);
+	output.depth = depth * 2.0 - 1.0;
+
+	return output;
+}
\ No newline at end of file
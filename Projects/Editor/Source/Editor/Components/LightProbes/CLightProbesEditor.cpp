@@ -110,6 +110,9 @@ namespace Skylicht
 
 						probesComponent->setSH(results);
 
+						// the objects blend the SH of 4 probes around them
+						probesComponent->buildTetrahedra();
+
 						entityMgr->setCamera(NULL);
 					}
 
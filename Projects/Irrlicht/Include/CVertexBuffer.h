@@ -153,6 +153,14 @@ namespace scene
 			++ChangedID;
 		}
 
+		virtual void setDirty(u32 begin, u32 end)
+		{
+			if (HardwareBuffer && begin < end)
+				HardwareBuffer->requestUpdate(begin * sizeof(T), (end - begin) * sizeof(T));
+
+			++ChangedID;
+		}
+
 		virtual u32 getChangedID() const
 		{
 			return ChangedID;
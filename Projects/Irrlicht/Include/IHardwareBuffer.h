@@ -61,12 +61,12 @@ class IHardwareBuffer : public virtual IReferenceCounted
 {
 public:
 	IHardwareBuffer(const scene::E_HARDWARE_MAPPING mapping, const u32 flags, const u32 size, const E_HARDWARE_BUFFER_TYPE type, const E_DRIVER_TYPE driverType) :
-		Mapping(mapping), Flags(flags), Size(size), Type(type), DriverType(driverType), Format(ECF_UNKNOWN), NumElements(0), RequiredUpdate(true)
+		Mapping(mapping), Flags(flags), Size(size), Type(type), DriverType(driverType), Format(ECF_UNKNOWN), NumElements(0), RequiredUpdate(true), NumUpdateRange(0)
 	{
 	}
 
 	IHardwareBuffer(const ECOLOR_FORMAT format, const u32 numElements, const u32 size, const E_DRIVER_TYPE driverType) :
-		Mapping(scene::EHM_NEVER), Flags(EHBF_COMPUTE_STRUCTURED), Size(size), Type(EHBT_COMPUTE), DriverType(driverType), Format(format), NumElements(numElements), RequiredUpdate(false)
+		Mapping(scene::EHM_NEVER), Flags(EHBF_COMPUTE_STRUCTURED), Size(size), Type(EHBT_COMPUTE), DriverType(driverType), Format(format), NumElements(numElements), RequiredUpdate(false), NumUpdateRange(0)
 	{
 	}
 
@@ -101,6 +101,89 @@ public:
 	inline void requestUpdate()
 	{
 		RequiredUpdate = true;
+		NumUpdateRange = 0;
+	}
+
+	// Request update only a range (in bytes), the ranges are kept until the buffer is updated.
+	// The overlapped ranges are merged, and the nearest ranges are merged if there are more than MAX_UPDATE_RANGE.
+	inline void requestUpdate(u32 offset, u32 size)
+	{
+		if (size == 0)
+			return;
+
+		if (!RequiredUpdate)
+		{
+			RequiredUpdate = true;
+			NumUpdateRange = 0;
+		}
+		else if (NumUpdateRange == 0)
+		{
+			// the full update is requested
+			return;
+		}
+
+		u32 begin = offset;
+		u32 end = offset + size;
+
+		// merge the overlapped (or adjacent) ranges into the new range
+		u32 n = 0;
+		for (u32 i = 0; i < NumUpdateRange; i++)
+		{
+			u32 b = UpdateRanges[i].Offset;
+			u32 e = b + UpdateRanges[i].Size;
+			if (b <= end && begin <= e)
+			{
+				begin = core::min_(begin, b);
+				end = core::max_(end, e);
+			}
+			else
+			{
+				UpdateRanges[n++] = UpdateRanges[i];
+			}
+		}
+		NumUpdateRange = n;
+
+		if (NumUpdateRange == MAX_UPDATE_RANGE)
+		{
+			// merge with the range that has the smallest gap
+			u32 best = 0;
+			u32 bestGap = 0xFFFFFFFF;
+			for (u32 i = 0; i < NumUpdateRange; i++)
+			{
+				u32 b = UpdateRanges[i].Offset;
+				u32 e = b + UpdateRanges[i].Size;
+				u32 gap = e < begin ? begin - e : b - end;
+				if (gap < bestGap)
+				{
+					best = i;
+					bestGap = gap;
+				}
+			}
+
+			begin = core::min_(begin, UpdateRanges[best].Offset);
+			end = core::max_(end, UpdateRanges[best].Offset + UpdateRanges[best].Size);
+			UpdateRanges[best] = UpdateRanges[--NumUpdateRange];
+		}
+
+		UpdateRanges[NumUpdateRange].Offset = begin;
+		UpdateRanges[NumUpdateRange].Size = end - begin;
+		NumUpdateRange++;
+	}
+
+	//! Get the number of byte ranges that need update, 0 is the full buffer.
+	inline u32 getNumUpdateRange() const
+	{
+		return NumUpdateRange;
+	}
+
+	inline u32 getUpdateOffset(u32 i) const
+	{
+		return UpdateRanges[i].Offset;
+	}
+
+	inline u32 getUpdateSize(u32 i) const
+	{
+		return UpdateRanges[i].Size;
 	}
 
 	//! Get mapping for buffer.
@@ -153,6 +236,17 @@ protected:
 	u32 NumElements;
 
 	bool RequiredUpdate;
+
+	enum { MAX_UPDATE_RANGE = 16 };
+
+	struct SUpdateRange
+	{
+		u32 Offset;
+		u32 Size;
+	};
+
+	SUpdateRange UpdateRanges[MAX_UPDATE_RANGE];
+	u32 NumUpdateRange;
 };
 
 }
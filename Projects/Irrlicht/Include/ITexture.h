@@ -121,7 +121,7 @@ public:
 
 	//! constructor
 	ITexture(const io::path& name) : NamedPath(name), DriverType(EDT_NULL), ColorFormat(ECF_UNKNOWN),
-		Pitch(0), HasMipMaps(false), HasAlpha(false), IsRenderTarget(false), Source(ETS_UNKNOWN), TextureType(ETT_TEXTURE_2D)
+		Pitch(0), HasMipMaps(false), HasAlpha(false), IsRenderTarget(false), Source(ETS_UNKNOWN), TextureType(ETT_TEXTURE_2D), ChangedID(1)
 	{
 	}
 
@@ -220,6 +220,9 @@ public:
 		return TextureType;
 	}
 
+	//! Get the changed ID, it is increased when the pixels are written by lock() and unlock().
+	u32 getChangedID() const { return ChangedID; }
+
 protected:
 
 	//! Helper function, helps to get the desired texture creation format from the flags.
@@ -249,6 +252,7 @@ protected:
 	bool IsRenderTarget;
 	E_TEXTURE_SOURCE Source;
 	E_TEXTURE_TYPE	TextureType;
+	u32 ChangedID;
 };
 
 
@@ -56,6 +56,9 @@ namespace scene
 
 		virtual void setDirty() = 0;
 
+		//! Mark only the vertices [begin, end) changed, the hardware buffer can upload this range.
+		virtual void setDirty(u32 begin, u32 end) = 0;
+
 		virtual u32 getChangedID() const = 0;
 
 		video::IHardwareBuffer* getHardwareBuffer() const
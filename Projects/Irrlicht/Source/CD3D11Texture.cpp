@@ -232,6 +232,7 @@ void CD3D11Texture::unlock()
 	if (LastMapDirection & D3D11_MAP_WRITE)
 	{
 		Context->CopyResource( Texture, TextureBuffer );
+		++ChangedID;
 	}
 }
 
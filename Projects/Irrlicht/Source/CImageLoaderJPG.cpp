@@ -18,7 +18,7 @@ namespace video
 {
 
 // Static members
-io::path CImageLoaderJPG::Filename;
+thread_local io::path CImageLoaderJPG::Filename;
 
 //! constructor
 CImageLoaderJPG::CImageLoaderJPG()
@@ -101,7 +101,7 @@ private:
 	static void term_source (j_decompress_ptr cinfo);
 
 	// Copy filename to have it around for error-messages
-	static io::path Filename;
+	static thread_local io::path Filename;
 
 	#endif // _IRR_COMPILE_WITH_LIBJPEG_
 };
@@ -294,7 +294,21 @@ namespace irr
 					return false;
 				}
 
-				glBufferSubData(target, 0, Size, data);
+				// upload only the dirty ranges, if they are requested
+				bool fullUpdate = NumUpdateRange == 0;
+				for (u32 i = 0; i < NumUpdateRange; i++)
+				{
+					if (UpdateRanges[i].Offset + UpdateRanges[i].Size > Size)
+						fullUpdate = true;
+				}
+
+				if (fullUpdate)
+					glBufferSubData(target, 0, Size, data);
+				else
+				{
+					for (u32 i = 0; i < NumUpdateRange; i++)
+						glBufferSubData(target, UpdateRanges[i].Offset, UpdateRanges[i].Size, (const u8*)data + UpdateRanges[i].Offset);
+				}
 			}
 			else
 			{
@@ -309,6 +323,7 @@ namespace irr
 			glBindBuffer(target, 0);
 
 			RequiredUpdate = false;
+			NumUpdateRange = 0;
 
 			return true;
 		}
@@ -671,6 +671,7 @@ namespace irr
 			{
 				os::Printer::log("[COGLES3Texture::unlock] Update texture");
 				uploadTexture(false, 0, MipLevelStored);
+				++ChangedID;
 			}
 			ReadOnlyLock = false;
 			// cleanup local image
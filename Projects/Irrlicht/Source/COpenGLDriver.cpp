@@ -297,7 +297,21 @@ bool COpenGLHardwareBuffer::update(const scene::E_HARDWARE_MAPPING mapping, cons
 			return false;
 		}
 
-		Driver->extGlBufferSubData(target, 0, Size, data);
+		// upload only the dirty ranges, if they are requested
+		bool fullUpdate = NumUpdateRange == 0;
+		for (u32 i = 0; i < NumUpdateRange; i++)
+		{
+			if (UpdateRanges[i].Offset + UpdateRanges[i].Size > Size)
+				fullUpdate = true;
+		}
+
+		if (fullUpdate)
+			Driver->extGlBufferSubData(target, 0, Size, data);
+		else
+		{
+			for (u32 i = 0; i < NumUpdateRange; i++)
+				Driver->extGlBufferSubData(target, UpdateRanges[i].Offset, UpdateRanges[i].Size, (const u8*)data + UpdateRanges[i].Offset);
+		}
 	}
 	else
 	{
@@ -312,6 +326,7 @@ bool COpenGLHardwareBuffer::update(const scene::E_HARDWARE_MAPPING mapping, cons
 	Driver->extGlBindBuffer(target, 0);
 
 	RequiredUpdate = false;
+	NumUpdateRange = 0;
 
 	return true;
 #else
@@ -693,7 +693,10 @@ namespace irr
 			image->unlock();
 			// copy texture data to GPU
 			if (!ReadOnlyLock)
+			{
 				uploadTexture(false, 0, MipLevelStored);
+				++ChangedID;
+			}
 			ReadOnlyLock = false;
 			// cleanup local image
 			if (MipImage)
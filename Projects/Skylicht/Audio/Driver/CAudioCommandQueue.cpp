@@ -0,0 +1,95 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "stdafx.h"
+#include "CAudioCommandQueue.h"
+
+namespace Skylicht
+{
+	namespace Audio
+	{
+		CAudioCommandQueue::CAudioCommandQueue(unsigned int capacity) :
+			m_mask(capacity - 1),
+			m_enqueuePos(0),
+			m_dequeuePos(0)
+		{
+			m_cells = new SCell[capacity];
+			for (unsigned int i = 0; i < capacity; i++)
+				m_cells[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+
+		CAudioCommandQueue::~CAudioCommandQueue()
+		{
+			delete[] m_cells;
+		}
+
+		bool CAudioCommandQueue::push(const SSourceCommand& command)
+		{
+			unsigned int pos = m_enqueuePos.load(std::memory_order_relaxed);
+			SCell* cell;
+
+			while (true)
+			{
+				cell = &m_cells[pos & m_mask];
+				unsigned int sequence = cell->Sequence.load(std::memory_order_acquire);
+				int diff = (int)(sequence - pos);
+
+				if (diff == 0)
+				{
+					// this cell is free, try to take it
+					if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+				{
+					// full
+					return false;
+				}
+				else
+				{
+					// another thread took it
+					pos = m_enqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+
+			cell->Command = command;
+			cell->Sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool CAudioCommandQueue::pop(SSourceCommand& command)
+		{
+			SCell* cell = &m_cells[m_dequeuePos & m_mask];
+			unsigned int sequence = cell->Sequence.load(std::memory_order_acquire);
+
+			if (sequence != m_dequeuePos + 1)
+				return false;
+
+			command = cell->Command;
+			cell->Sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+			m_dequeuePos++;
+			return true;
+		}
+	}
+}
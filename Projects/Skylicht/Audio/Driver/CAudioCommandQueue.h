@@ -0,0 +1,90 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "stdafx.h"
+#include <atomic>
+
+namespace Skylicht
+{
+	namespace Audio
+	{
+		class CSoundSource;
+
+		/// @brief A parameter change of a sound source, it is applied on the audio thread.
+		struct SSourceCommand
+		{
+			enum ECommand
+			{
+				SetState = 0,
+				SetGain,
+				SetPitch,
+				SetPosition,
+				SetRollOff,
+				Set3DSound
+			};
+
+			ECommand Type;
+			CSoundSource* Source;
+			int State;
+			float Value[3];
+		};
+
+		/// @brief A bounded lock-free queue, many threads can push and the audio thread pops.
+		/**
+		 * The sound sources push their parameter changes here instead of locking the audio thread,
+		 * CDriverNull::fillBuffer pops and applies them before mixing.
+		 * push return false if the queue is full, the caller should send the command again later.
+		 */
+		class CAudioCommandQueue
+		{
+		protected:
+			struct SCell
+			{
+				std::atomic<unsigned int> Sequence;
+				SSourceCommand Command;
+			};
+
+			SCell* m_cells;
+
+			unsigned int m_mask;
+
+			std::atomic<unsigned int> m_enqueuePos;
+
+			unsigned int m_dequeuePos;
+
+		public:
+			/// @param capacity must be a power of 2
+			CAudioCommandQueue(unsigned int capacity = 4096);
+
+			virtual ~CAudioCommandQueue();
+
+			bool push(const SSourceCommand& command);
+
+			/// @brief Pop a command, it must be called from one thread at a time.
+			bool pop(SSourceCommand& command);
+		};
+	}
+}
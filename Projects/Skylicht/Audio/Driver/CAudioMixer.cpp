@@ -0,0 +1,363 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "stdafx.h"
+#include "CAudioMixer.h"
+
+#if !defined(SKYLICHT_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKYLICHT_SIMD_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SKYLICHT_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace Skylicht
+{
+	namespace Audio
+	{
+#if defined(SKYLICHT_SIMD_SSE)
+		static inline void accumulate(float* out, __m128 l, __m128 r)
+		{
+			// interleave to L0 R0 L1 R1, L2 R2 L3 R3
+			__m128 lo = _mm_unpacklo_ps(l, r);
+			__m128 hi = _mm_unpackhi_ps(l, r);
+			_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(out), lo));
+			_mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), hi));
+		}
+
+		static inline int load32(const short* src)
+		{
+			int v;
+			memcpy(&v, src, sizeof(int));
+			return v;
+		}
+
+		static inline long long load64(const short* src)
+		{
+			long long v;
+			memcpy(&v, src, sizeof(long long));
+			return v;
+		}
+
+		// the sign extended low/high 16 bit of each 32 bit lane
+		static inline __m128 lowPCM16(__m128i v)
+		{
+			return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(v, 16), 16));
+		}
+
+		static inline __m128 highPCM16(__m128i v)
+		{
+			return _mm_cvtepi32_ps(_mm_srai_epi32(v, 16));
+		}
+
+		static inline __m128 loadPCM16(const short* src)
+		{
+			__m128i s = _mm_loadl_epi64((const __m128i*)src);
+			return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+		}
+#elif defined(SKYLICHT_SIMD_NEON)
+		static inline void accumulate(float* out, float32x4_t l, float32x4_t r)
+		{
+			float32x4x2_t lr = vzipq_f32(l, r);
+			vst1q_f32(out, vaddq_f32(vld1q_f32(out), lr.val[0]));
+			vst1q_f32(out + 4, vaddq_f32(vld1q_f32(out + 4), lr.val[1]));
+		}
+#endif
+
+		static void mixRange(float* out, int begin, int end, const short* src, int last, bool stereo, float step,
+			float leftGain, float dl, float rightGain, float dr)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				float fi = (float)i;
+				float pos = fi * step;
+				int s1 = (int)pos;
+				float frac = pos - (float)s1;
+
+				if (s1 > last)
+					s1 = last;
+				int s2 = s1 < last ? s1 + 1 : last;
+
+				float l, r;
+				if (stereo)
+				{
+					float l1 = src[s1 * 2];
+					float r1 = src[s1 * 2 + 1];
+					l = l1 + (src[s2 * 2] - l1) * frac;
+					r = r1 + (src[s2 * 2 + 1] - r1) * frac;
+				}
+				else
+				{
+					float v = src[s1];
+					l = v + (src[s2] - v) * frac;
+					r = l;
+				}
+
+				out[i * 2] += l * (leftGain + dl * fi);
+				out[i * 2 + 1] += r * (rightGain + dr * fi);
+			}
+		}
+
+		static void convertRange(short* out, const float* in, int begin, int end)
+		{
+			for (int i = begin; i < end; i++)
+			{
+				float v = in[i];
+				if (v < -32768.0f)
+					v = -32768.0f;
+				else if (v > 32767.0f)
+					v = 32767.0f;
+				out[i] = (short)lrintf(v);
+			}
+		}
+
+		void CAudioMixer::mix(float* out, int numOut,
+			const short* src, int numSrcFrames, int numChannels,
+			float step,
+			float leftGain, float leftGainEnd,
+			float rightGain, float rightGainEnd)
+		{
+			if (numOut <= 0 || numSrcFrames <= 0 || step <= 0.0f)
+				return;
+
+			float dl = (leftGainEnd - leftGain) / (float)numOut;
+			float dr = (rightGainEnd - rightGain) / (float)numOut;
+
+			int last = numSrcFrames - 1;
+
+			// the frames that do not need to clamp the source index
+			int numSafe = 0;
+			if (numSrcFrames >= 2)
+			{
+				numSafe = (int)((float)(numSrcFrames - 2) / step) + 1;
+				if (numSafe > numOut)
+					numSafe = numOut;
+				while (numSafe > 0 && (int)((float)(numSafe - 1) * step) + 1 > last)
+					numSafe--;
+			}
+
+			bool stereo = numChannels == 2;
+			bool contiguous = step == 1.0f;
+
+			int i = 0;
+
+#if defined(SKYLICHT_SIMD_SSE)
+			__m128i vi = _mm_set_epi32(3, 2, 1, 0);
+			__m128i four = _mm_set1_epi32(4);
+			__m128 vstep = _mm_set1_ps(step);
+			__m128 vgl = _mm_set1_ps(leftGain);
+			__m128 vgr = _mm_set1_ps(rightGain);
+			__m128 vdl = _mm_set1_ps(dl);
+			__m128 vdr = _mm_set1_ps(dr);
+
+			for (; i + 4 <= numSafe; i += 4)
+			{
+				__m128 fi = _mm_cvtepi32_ps(vi);
+				vi = _mm_add_epi32(vi, four);
+
+				__m128 l, r;
+
+				if (contiguous)
+				{
+					if (stereo)
+					{
+						__m128i s = _mm_loadu_si128((const __m128i*)(src + i * 2));
+						__m128 a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+						__m128 b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16));
+						l = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+						r = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+					}
+					else
+					{
+						l = loadPCM16(src + i);
+						r = l;
+					}
+				}
+				else
+				{
+					__m128 pos = _mm_mul_ps(fi, vstep);
+					__m128i ipos = _mm_cvttps_epi32(pos);
+					__m128 frac = _mm_sub_ps(pos, _mm_cvtepi32_ps(ipos));
+
+					int s[4];
+					_mm_storeu_si128((__m128i*)s, ipos);
+
+					if (stereo)
+					{
+						// L1 R1 L2 R2 of each frame
+						__m128i p01 = _mm_set_epi64x(load64(src + s[1] * 2), load64(src + s[0] * 2));
+						__m128i p23 = _mm_set_epi64x(load64(src + s[3] * 2), load64(src + s[2] * 2));
+						__m128i a = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(p01), _mm_castsi128_ps(p23), _MM_SHUFFLE(2, 0, 2, 0)));
+						__m128i b = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(p01), _mm_castsi128_ps(p23), _MM_SHUFFLE(3, 1, 3, 1)));
+						__m128 l1 = lowPCM16(a);
+						__m128 r1 = highPCM16(a);
+						l = _mm_add_ps(l1, _mm_mul_ps(_mm_sub_ps(lowPCM16(b), l1), frac));
+						r = _mm_add_ps(r1, _mm_mul_ps(_mm_sub_ps(highPCM16(b), r1), frac));
+					}
+					else
+					{
+						// s1 s2 of each frame
+						__m128i p = _mm_setr_epi32(load32(src + s[0]), load32(src + s[1]), load32(src + s[2]), load32(src + s[3]));
+						__m128 s1 = lowPCM16(p);
+						l = _mm_add_ps(s1, _mm_mul_ps(_mm_sub_ps(highPCM16(p), s1), frac));
+						r = l;
+					}
+				}
+
+				__m128 gl = _mm_add_ps(vgl, _mm_mul_ps(vdl, fi));
+				__m128 gr = _mm_add_ps(vgr, _mm_mul_ps(vdr, fi));
+
+				accumulate(out + i * 2, _mm_mul_ps(l, gl), _mm_mul_ps(r, gr));
+			}
+#elif defined(SKYLICHT_SIMD_NEON)
+			static const float index[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+			float32x4_t fi = vld1q_f32(index);
+			float32x4_t four = vdupq_n_f32(4.0f);
+			float32x4_t vstep = vdupq_n_f32(step);
+			float32x4_t vgl = vdupq_n_f32(leftGain);
+			float32x4_t vgr = vdupq_n_f32(rightGain);
+			float32x4_t vdl = vdupq_n_f32(dl);
+			float32x4_t vdr = vdupq_n_f32(dr);
+
+			for (; i + 4 <= numSafe; i += 4)
+			{
+				float32x4_t l, r;
+
+				if (contiguous)
+				{
+					if (stereo)
+					{
+						int16x4x2_t s = vld2_s16(src + i * 2);
+						l = vcvtq_f32_s32(vmovl_s16(s.val[0]));
+						r = vcvtq_f32_s32(vmovl_s16(s.val[1]));
+					}
+					else
+					{
+						l = vcvtq_f32_s32(vmovl_s16(vld1_s16(src + i)));
+						r = l;
+					}
+				}
+				else
+				{
+					float32x4_t pos = vmulq_f32(fi, vstep);
+					int32x4_t ipos = vcvtq_s32_f32(pos);
+					float32x4_t frac = vsubq_f32(pos, vcvtq_f32_s32(ipos));
+
+					int s[4];
+					vst1q_s32(s, ipos);
+
+					float a[4], b[4];
+					if (stereo)
+					{
+						float c[4], d[4];
+						for (int j = 0; j < 4; j++)
+						{
+							a[j] = src[s[j] * 2];
+							b[j] = src[s[j] * 2 + 2];
+							c[j] = src[s[j] * 2 + 1];
+							d[j] = src[s[j] * 2 + 3];
+						}
+						float32x4_t l1 = vld1q_f32(a);
+						float32x4_t r1 = vld1q_f32(c);
+						l = vaddq_f32(l1, vmulq_f32(vsubq_f32(vld1q_f32(b), l1), frac));
+						r = vaddq_f32(r1, vmulq_f32(vsubq_f32(vld1q_f32(d), r1), frac));
+					}
+					else
+					{
+						for (int j = 0; j < 4; j++)
+						{
+							a[j] = src[s[j]];
+							b[j] = src[s[j] + 1];
+						}
+						float32x4_t s1 = vld1q_f32(a);
+						l = vaddq_f32(s1, vmulq_f32(vsubq_f32(vld1q_f32(b), s1), frac));
+						r = l;
+					}
+				}
+
+				float32x4_t gl = vaddq_f32(vgl, vmulq_f32(vdl, fi));
+				float32x4_t gr = vaddq_f32(vgr, vmulq_f32(vdr, fi));
+				fi = vaddq_f32(fi, four);
+
+				accumulate(out + i * 2, vmulq_f32(l, gl), vmulq_f32(r, gr));
+			}
+#endif
+
+			// the last frames
+			mixRange(out, i, numOut, src, last, stereo, step, leftGain, dl, rightGain, dr);
+		}
+
+		void CAudioMixer::mixScalar(float* out, int numOut,
+			const short* src, int numSrcFrames, int numChannels,
+			float step,
+			float leftGain, float leftGainEnd,
+			float rightGain, float rightGainEnd)
+		{
+			if (numOut <= 0 || numSrcFrames <= 0 || step <= 0.0f)
+				return;
+
+			float dl = (leftGainEnd - leftGain) / (float)numOut;
+			float dr = (rightGainEnd - rightGain) / (float)numOut;
+
+			mixRange(out, 0, numOut, src, numSrcFrames - 1, numChannels == 2, step, leftGain, dl, rightGain, dr);
+		}
+
+		void CAudioMixer::convertToPCM16(short* out, const float* in, int count)
+		{
+			int i = 0;
+
+#if defined(SKYLICHT_SIMD_SSE)
+			__m128 minValue = _mm_set1_ps(-32768.0f);
+			__m128 maxValue = _mm_set1_ps(32767.0f);
+
+			for (; i + 8 <= count; i += 8)
+			{
+				__m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i), minValue), maxValue);
+				__m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + 4), minValue), maxValue);
+				__m128i s = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+				_mm_storeu_si128((__m128i*)(out + i), s);
+			}
+#elif defined(SKYLICHT_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+			float32x4_t minValue = vdupq_n_f32(-32768.0f);
+			float32x4_t maxValue = vdupq_n_f32(32767.0f);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				float32x4_t a = vminq_f32(vmaxq_f32(vld1q_f32(in + i), minValue), maxValue);
+				vst1_s16(out + i, vqmovn_s32(vcvtnq_s32_f32(a)));
+			}
+#endif
+
+			convertRange(out, in, i, count);
+		}
+
+		void CAudioMixer::convertToPCM16Scalar(short* out, const float* in, int count)
+		{
+			convertRange(out, in, 0, count);
+		}
+	}
+}
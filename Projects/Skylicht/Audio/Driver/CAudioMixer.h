@@ -0,0 +1,65 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+	namespace Audio
+	{
+		/// @brief The float mix bus kernels used by CDriverNull and CSoundSource.
+		/**
+		 * The mix bus is the interleaved stereo float buffer, the samples are in the 16 bit range.
+		 * The kernels use SSE2 or NEON when it is available, the result is the same as the scalar code.
+		 */
+		class CAudioMixer
+		{
+		public:
+			/// @brief Resample a 16 bit PCM buffer with linear interpolation and add it to the mix bus.
+			/// @param out the stereo mix bus, numOut frames
+			/// @param src the mono or stereo 16 bit samples, numSrcFrames frames
+			/// @param step the source frames per output frame
+			/// @param leftGain gain of the left channel at the first frame
+			/// @param leftGainEnd gain of the left channel after the last frame, the gain is ramped linearly
+			static void mix(float* out, int numOut,
+				const short* src, int numSrcFrames, int numChannels,
+				float step,
+				float leftGain, float leftGainEnd,
+				float rightGain, float rightGainEnd);
+
+			/// @brief Scalar version of mix, the result is the same.
+			static void mixScalar(float* out, int numOut,
+				const short* src, int numSrcFrames, int numChannels,
+				float step,
+				float leftGain, float leftGainEnd,
+				float rightGain, float rightGainEnd);
+
+			/// @brief Convert the mix bus to 16 bit PCM with saturation.
+			static void convertToPCM16(short* out, const float* in, int count);
+
+			/// @brief Scalar version of convertToPCM16.
+			static void convertToPCM16Scalar(short* out, const float* in, int count);
+		};
+	}
+}
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "stdafx.h"
 #include "CDriverNull.h"
+#include "CAudioMixer.h"
 #include "Engine/CAudioEmitter.h"
 
 namespace Skylicht
@@ -48,7 +49,7 @@ namespace Skylicht
 			delete m_mutex;
 			
 			if (m_mixBuffer)
-				delete m_mixBuffer;
+				delete[] m_mixBuffer;
 			
 			shutdown();
 		}
@@ -96,28 +97,36 @@ namespace Skylicht
 			}
 		}
 		
+		void CDriverNull::processCommands()
+		{
+			SSourceCommand command;
+			while (m_commands.pop(command))
+				command.Source->applyCommand(command);
+		}
+		
 		void CDriverNull::fillBuffer(unsigned short* outBuffer, int numSample)
 		{
+			// this lock only waits the create/destroy source
 			SScopeMutex lockScope(m_mutex);
 			
 			int totalSamples = numSample * 2;	// left & right
-			int safeBufferSize = totalSamples + totalSamples / 2;
 			
 			// alloc mix buffer
 			if (m_numMixSampler < numSample)
 			{
-				m_numMixSampler = numSample;
-				
 				// free current mix buffer
 				if (m_mixBuffer != NULL)
-					delete m_mixBuffer;
+					delete[] m_mixBuffer;
 				
-				m_mixBuffer = new int[safeBufferSize];
+				m_mixBuffer = new float[totalSamples];
 				m_numMixSampler = numSample;
 			}
 			
 			// silent audio
-			memset(m_mixBuffer, 0, sizeof(int)*safeBufferSize);
+			memset(m_mixBuffer, 0, sizeof(float) * totalSamples);
+			
+			// apply the changed state, gain, position...
+			processCommands();
 			
 			// mix audio
 			std::vector<CSoundSource*>::iterator iSource = m_sources.begin(), sourceEnd = m_sources.end();
@@ -134,27 +143,15 @@ namespace Skylicht
 				++iSource;
 			}
 			
-			// clamp audio (convert fixed to short)
-			int *mixingBufferCursor = m_mixBuffer;
-			short *outBufferCursor = (short*)outBuffer;
-			
-			for (int i = 0; i < totalSamples; i++)
-			{
-				if ((unsigned int)(*mixingBufferCursor + 32768) > 65535)
-					*outBufferCursor = (short)(*mixingBufferCursor < 0 ? -32768 : 32767);
-				else
-					*outBufferCursor = (short)(*mixingBufferCursor);
-				
-				outBufferCursor++;
-				mixingBufferCursor++;
-			}
+			// clamp audio (convert float to short)
+			CAudioMixer::convertToPCM16((short*)outBuffer, m_mixBuffer, totalSamples);
 		}
 		
 		ISoundSource* CDriverNull::createSource()
 		{
 			SScopeMutex lockScope(m_mutex);
 			
-			CSoundSource *source = new CSoundSource(m_bufferLength);
+			CSoundSource *source = new CSoundSource(m_bufferLength, &m_commands);
 			m_sources.push_back(source);
 			return source;
 		}
@@ -168,6 +165,9 @@ namespace Skylicht
 			{
 				if ((*i) == driverSource)
 				{
+					// the queue can have the commands of this source
+					processCommands();
+					
 					delete driverSource;
 					m_sources.erase(i);
 					return;
@@ -180,6 +180,8 @@ namespace Skylicht
 		{
 			SScopeMutex lockScope(m_mutex);
 			
+			processCommands();
+			
 			std::vector<CSoundSource*>::iterator i = m_sources.begin(), end = m_sources.end();
 			while (i != end)
 			{
@@ -27,6 +27,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "stdafx.h"
 #include "ISoundDriver.h"
 #include "CSoundSource.h"
+#include "CAudioCommandQueue.h"
 
 #include "Thread/IMutex.h"
 
@@ -41,8 +42,12 @@ namespace Skylicht
 		protected:
 			std::vector<CSoundSource*> m_sources;
 			
-			int* m_mixBuffer;
+			// float stereo mix bus
+			float* m_mixBuffer;
 			int m_numMixSampler;
+
+			// the source parameters from the game & emitter thread
+			CAudioCommandQueue m_commands;
 			
 			unsigned char* m_buffer;
 			float m_bufferLength;
@@ -94,6 +99,10 @@ namespace Skylicht
 			virtual int getBufferSize();
 			
 			virtual void changeDuration(float duration);
+
+		protected:
+
+			void processCommands();
 		};
 	}
 }
@@ -24,6 +24,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "stdafx.h"
 #include "CSoundSource.h"
+#include "CAudioMixer.h"
 
 #include "SkylichtAudio.h"
 
@@ -31,11 +32,15 @@ namespace Skylicht
 {
 	namespace Audio
 	{
-		CSoundSource::CSoundSource(float length)
+		CSoundSource::CSoundSource(float length, CAudioCommandQueue* commands) :
+			m_numDriverBuffer(0),
+			m_driverBuffer(0),
+			m_uploadBuffer(0),
+			m_numQueuedBuffer(0),
+			m_commands(commands)
 		{
 			m_bitPerSample = 16;		// 16 bit
 			m_bufferDuration = length;	// s
-			m_driverBuffer = 0;
 			m_state = ISoundSource::StateInitial;
 			m_mutex = IMutex::createMutex();
 			
@@ -46,6 +51,16 @@ namespace Skylicht
 			m_pitch = 1.0f;
 			m_rollOff = 10.0f;		// 10m
 			m_is3DSound = false;
+			
+			m_rampLeftGain = 0.0f;
+			m_rampRightGain = 0.0f;
+			
+			m_sendState = m_state;
+			m_sendGain = m_gain;
+			m_sendPitch = m_pitch;
+			m_sendRollOff = m_rollOff;
+			m_send3DSound = m_is3DSound;
+			m_pendingCommands = 0;
 		}
 		
 		CSoundSource::~CSoundSource()
@@ -54,7 +69,7 @@ namespace Skylicht
 			{
 				if (m_buffers[i].Data != NULL)
 				{
-					delete m_buffers[i].Data;
+					delete[] m_buffers[i].Data;
 					m_buffers[i].Data = NULL;
 				}
 			}
@@ -64,7 +79,7 @@ namespace Skylicht
 		
 		void CSoundSource::init(const STrackParams& trackParam, const SSourceParam& driverParam)
 		{
-			SScopeMutex scopeLock(m_mutex);
+			// the driver does not mix this source until it is playing
 			m_trackParams = trackParam;
 			
 			m_numDriverBuffer = driverParam.NumBuffer;
@@ -90,6 +105,7 @@ namespace Skylicht
 			}
 			
 			m_state = ISoundSource::StateStopped;
+			m_sendState = m_state;
 		}
 		
 		void CSoundSource::changeDuration(float duration)
@@ -108,40 +124,35 @@ namespace Skylicht
 		
 		bool CSoundSource::needData()
 		{
-			SScopeMutex scopeLock(m_mutex);
-			return m_buffers[m_driverBuffer].Free;
+			return m_numQueuedBuffer.load(std::memory_order_acquire) < m_numDriverBuffer;
 		}
 		
 		void CSoundSource::play()
 		{
-			SScopeMutex scopeLock(m_mutex);
-			if (m_state == ISoundSource::StateInitial)
+			if (m_sendState == ISoundSource::StateInitial)
 				return;
-			m_state = ISoundSource::StatePlaying;
+			setState(ISoundSource::StatePlaying);
 		}
 		
 		void CSoundSource::stop()
 		{
-			SScopeMutex scopeLock(m_mutex);
-			if (m_state == ISoundSource::StateInitial)
+			if (m_sendState == ISoundSource::StateInitial)
 				return;
-			m_state = ISoundSource::StateStopped;
+			setState(ISoundSource::StateStopped);
 		}
 		
 		void CSoundSource::pause()
 		{
-			SScopeMutex scopeLock(m_mutex);
-			if (m_state == ISoundSource::StateInitial)
+			if (m_sendState == ISoundSource::StateInitial)
 				return;
-			m_state = ISoundSource::StatePause;
+			setState(ISoundSource::StatePause);
 		}
 		
 		void CSoundSource::reset()
 		{
-			SScopeMutex scopeLock(m_mutex);
-			if (m_state == ISoundSource::StateInitial)
+			if (m_sendState == ISoundSource::StateInitial)
 				return;
-			m_state = ISoundSource::StateStopped;
+			setState(ISoundSource::StateStopped);
 		}
 		
 		ISoundSource::ESourceState CSoundSource::getState()
@@ -151,7 +162,110 @@ namespace Skylicht
 		
 		void CSoundSource::setState(ESourceState state)
 		{
-			m_state = state;
+			if (m_sendState == state)
+				return;
+
+			m_sendState = state;
+			m_pendingCommands |= 1 << SSourceCommand::SetState;
+			flushCommands();
+		}
+		
+		bool CSoundSource::sendCommand(SSourceCommand::ECommand type, int state, float x, float y, float z)
+		{
+			SSourceCommand command;
+			command.Type = type;
+			command.Source = this;
+			command.State = state;
+			command.Value[0] = x;
+			command.Value[1] = y;
+			command.Value[2] = z;
+			
+			if (m_commands == NULL)
+			{
+				// no audio thread
+				applyCommand(command);
+				return true;
+			}
+			
+			// if the queue is full, the command stays pending and it will be sent again on the next update
+			return m_commands->push(command);
+		}
+
+		void CSoundSource::flushCommands()
+		{
+			if (m_pendingCommands == 0)
+				return;
+
+			unsigned int pending = m_pendingCommands;
+			m_pendingCommands = 0;
+
+			// send the last value of each parameter, the older values are not needed
+			if ((pending & (1 << SSourceCommand::SetState)) && !sendCommand(SSourceCommand::SetState, (int)m_sendState))
+				m_pendingCommands |= 1 << SSourceCommand::SetState;
+
+			if ((pending & (1 << SSourceCommand::SetGain)) && !sendCommand(SSourceCommand::SetGain, 0, m_sendGain))
+				m_pendingCommands |= 1 << SSourceCommand::SetGain;
+
+			if ((pending & (1 << SSourceCommand::SetPitch)) && !sendCommand(SSourceCommand::SetPitch, 0, m_sendPitch))
+				m_pendingCommands |= 1 << SSourceCommand::SetPitch;
+
+			if ((pending & (1 << SSourceCommand::SetPosition)) && !sendCommand(SSourceCommand::SetPosition, 0, m_sendPosition.X, m_sendPosition.Y, m_sendPosition.Z))
+				m_pendingCommands |= 1 << SSourceCommand::SetPosition;
+
+			if ((pending & (1 << SSourceCommand::SetRollOff)) && !sendCommand(SSourceCommand::SetRollOff, 0, m_sendRollOff))
+				m_pendingCommands |= 1 << SSourceCommand::SetRollOff;
+
+			if ((pending & (1 << SSourceCommand::Set3DSound)) && !sendCommand(SSourceCommand::Set3DSound, m_send3DSound ? 1 : 0))
+				m_pendingCommands |= 1 << SSourceCommand::Set3DSound;
+		}
+		
+		void CSoundSource::applyCommand(const SSourceCommand& command)
+		{
+			switch (command.Type)
+			{
+			case SSourceCommand::SetState:
+			{
+				ESourceState state = (ESourceState)command.State;
+				if (state == ISoundSource::StatePlaying && m_state != ISoundSource::StatePlaying)
+				{
+					// ramp in from silent
+					m_rampLeftGain = 0.0f;
+					m_rampRightGain = 0.0f;
+				}
+				else if (state == ISoundSource::StateStopped)
+				{
+					// drop the queued buffers, they are from the old position
+					int numQueued = m_numQueuedBuffer.load(std::memory_order_acquire);
+					if (numQueued > 0)
+					{
+						for (int i = 0; i < numQueued; i++)
+							m_buffers[(m_driverBuffer + i) % m_numDriverBuffer].Free = true;
+						
+						m_driverBuffer = (m_driverBuffer + numQueued) % m_numDriverBuffer;
+						m_numQueuedBuffer.fetch_sub(numQueued, std::memory_order_release);
+					}
+				}
+				m_state = state;
+			}
+			break;
+			case SSourceCommand::SetGain:
+				m_gain = command.Value[0];
+				break;
+			case SSourceCommand::SetPitch:
+				m_pitch = command.Value[0];
+				break;
+			case SSourceCommand::SetPosition:
+				m_position.X = command.Value[0];
+				m_position.Y = command.Value[1];
+				m_position.Z = command.Value[2];
+				break;
+			case SSourceCommand::SetRollOff:
+				m_rollOff = command.Value[0];
+				break;
+			case SSourceCommand::Set3DSound:
+				m_is3DSound = command.State != 0;
+				break;
+			}
 		}
 		
 		long CSoundSource::getByteOffset()
@@ -165,32 +279,33 @@ namespace Skylicht
 		
 		void CSoundSource::uploadData(void* soundData, unsigned int bufferSize)
 		{
-			SScopeMutex scopeLock(m_mutex);
+			// all the buffers are waiting to play
+			if (m_numQueuedBuffer.load(std::memory_order_acquire) >= m_numDriverBuffer)
+				return;
 			
-			if (m_buffers[m_driverBuffer].Data == NULL)
-			{
-				// alloc new
-				m_buffers[m_driverBuffer].Data = new unsigned char[bufferSize];
-				memset(m_buffers[m_driverBuffer].Data, 0, bufferSize);
-			}
-			else
+			SDriverBuffer& buffer = m_buffers[m_uploadBuffer];
+			
+			if (buffer.Data == NULL || buffer.TotalSize < bufferSize)
 			{
-				if (m_buffers[m_driverBuffer].TotalSize < bufferSize)
-				{
-					delete m_buffers[m_driverBuffer].Data;
-					
-					// re-alloc new size
-					m_buffers[m_driverBuffer].Data = new unsigned char[bufferSize];
-					memset(m_buffers[m_driverBuffer].Data, 0, bufferSize);
-				}
+				if (buffer.Data != NULL)
+					delete[] buffer.Data;
+				
+				// re-alloc new size
+				buffer.Data = new unsigned char[bufferSize];
+				buffer.TotalSize = bufferSize;
 			}
 			
 			// copy data
-			memcpy(m_buffers[m_driverBuffer].Data, soundData, bufferSize);
+			memcpy(buffer.Data, soundData, bufferSize);
 			
-			m_buffers[m_driverBuffer].UsedSize = bufferSize;
-			m_buffers[m_driverBuffer].TotalSize = bufferSize;
-			m_buffers[m_driverBuffer].Free = false;
+			buffer.UsedSize = bufferSize;
+			buffer.Free = false;
+			
+			m_uploadBuffer++;
+			m_uploadBuffer %= m_numDriverBuffer;
+			
+			// publish the buffer to the audio thread
+			m_numQueuedBuffer.fetch_add(1, std::memory_order_release);
 		}
 		
 		void CSoundSource::lockThread()
@@ -203,126 +318,131 @@ namespace Skylicht
 			m_mutex->unlock();
 		}
 		
-		void CSoundSource::fillBuffer(int* buffer, int nbSample, float gain)
+		void CSoundSource::fillBuffer(float* buffer, int nbSample, float gain)
 		{
-			SScopeMutex scopeLock(m_mutex);
-			
-			short* sourceBuffer = (short*)m_buffers[m_driverBuffer].Data;
-			
-			if (sourceBuffer == NULL || m_trackParams.BitsPerSample != 16)
-				return;
-			
-			m_distanceGain = 1.0f;
-			m_leftGain = 1.0f;
-			m_rightGain = 1.0f;
-			
-			if (m_is3DSound)
+			if (m_numQueuedBuffer.load(std::memory_order_acquire) == 0)
 			{
-				// calc left, right, distance gain
-				update3D();
+				// no data, the next buffer will ramp in from silent
+				m_rampLeftGain = 0.0f;
+				m_rampRightGain = 0.0f;
+				return;
 			}
 			
-			float rateRatio = m_trackParams.SamplingRate / (float)m_driverSamplingRate;
-			
-			float pitch = rateRatio;
-			float currentSample = 0;
+			SDriverBuffer& driverBuffer = m_buffers[m_driverBuffer];
+			const short* sourceBuffer = (const short*)driverBuffer.Data;
 			
-			int sample = 0;
-			
-			float leftGain = m_leftGain * m_gain * m_distanceGain * gain;
-			float rightGain = m_rightGain * m_gain * m_distanceGain * gain;
-			
-			int sampleValue = 0;
-			
-			if (m_gain > 0.0f && m_distanceGain > 0.0f && m_pitch >= SKYLICHTAUDIO_MIN_PITCH && m_pitch <= SKYLICHTAUDIO_MAX_PITCH)
+			if (sourceBuffer != NULL && m_trackParams.BitsPerSample == 16)
 			{
-				if (m_trackParams.NumChannels == 2)
+				m_distanceGain = 1.0f;
+				m_leftGain = 1.0f;
+				m_rightGain = 1.0f;
+				
+				if (m_is3DSound)
 				{
-					// Mix STEREO
-					for (int i = 0; i < nbSample; ++i)
-					{
-						sample = (int)currentSample;
-						
-						// left
-						sampleValue = (int)(sourceBuffer[sample * 2]);
-						*buffer += (int)(sampleValue * leftGain);
-						++buffer;
-						
-						// right
-						sampleValue = (int)(sourceBuffer[sample * 2 + 1]);
-						*buffer += (int)(sampleValue * rightGain);
-						++buffer;
-						
-						currentSample = i * pitch;
-					}
+					// calc left, right, distance gain
+					update3D();
 				}
-				else
+				
+				float leftGain = 0.0f;
+				float rightGain = 0.0f;
+				
+				if (m_gain > 0.0f && m_distanceGain > 0.0f && m_pitch >= SKYLICHTAUDIO_MIN_PITCH && m_pitch <= SKYLICHTAUDIO_MAX_PITCH)
 				{
-					// Mix MONO
-					for (int i = 0; i < nbSample; i++)
-					{
-						sample = (int)currentSample;
-						
-						sampleValue = (int)(sourceBuffer[sample]);
-						
-						// left
-						*buffer += (int)(sampleValue * leftGain);
-						++buffer;
-						
-						// right
-						*buffer += (int)(sampleValue * rightGain);
-						++buffer;
-						
-						currentSample = i * pitch;
-					}
+					leftGain = m_leftGain * m_gain * m_distanceGain * gain;
+					rightGain = m_rightGain * m_gain * m_distanceGain * gain;
 				}
+				
+				if (leftGain > 0.0f || rightGain > 0.0f || m_rampLeftGain > 0.0f || m_rampRightGain > 0.0f)
+				{
+					float rateRatio = m_trackParams.SamplingRate / (float)m_driverSamplingRate;
+					int numFrames = (int)driverBuffer.UsedSize / (m_trackParams.NumChannels * 2);
+					
+					// linear resample and ramp the gain from the last buffer
+					CAudioMixer::mix(buffer, nbSample,
+						sourceBuffer, numFrames, m_trackParams.NumChannels,
+						rateRatio,
+						m_rampLeftGain, leftGain,
+						m_rampRightGain, rightGain);
+				}
+				
+				m_rampLeftGain = leftGain;
+				m_rampRightGain = rightGain;
 			}
 			
-			// begin to upload data
-			m_buffers[m_driverBuffer].Free = true;
+			// this buffer can upload again
+			driverBuffer.Free = true;
 			
 			// swap buffer
 			m_driverBuffer++;
 			m_driverBuffer %= m_numDriverBuffer;
+			
+			m_numQueuedBuffer.fetch_sub(1, std::memory_order_release);
 		}
 		
 		void CSoundSource::setGain(float gain)
 		{
-			m_gain = gain;
+			if (m_sendGain == gain)
+				return;
+			
+			m_sendGain = gain;
+			m_pendingCommands |= 1 << SSourceCommand::SetGain;
+			flushCommands();
 		}
 		
 		void CSoundSource::setPitch(float pitch)
 		{
-			m_pitch = pitch;
+			if (m_sendPitch == pitch)
+				return;
+			
+			m_sendPitch = pitch;
+			m_pendingCommands |= 1 << SSourceCommand::SetPitch;
+			flushCommands();
 		}
 		
 		void CSoundSource::setPosition(const SVector3& pos)
 		{
-			m_position = pos;
+			if (m_sendPosition.X == pos.X && m_sendPosition.Y == pos.Y && m_sendPosition.Z == pos.Z)
+				return;
+			
+			m_sendPosition = pos;
+			m_pendingCommands |= 1 << SSourceCommand::SetPosition;
+			flushCommands();
 		}
 		
 		void CSoundSource::setRollOff(float rollOff)
 		{
-			m_rollOff = rollOff;
+			if (m_sendRollOff == rollOff)
+				return;
+			
+			m_sendRollOff = rollOff;
+			m_pendingCommands |= 1 << SSourceCommand::SetRollOff;
+			flushCommands();
 		}
 		
 		void CSoundSource::set3DSound(bool b)
 		{
-			m_is3DSound = b;
+			if (m_send3DSound == b)
+				return;
+			
+			m_send3DSound = b;
+			m_pendingCommands |= 1 << SSourceCommand::Set3DSound;
+			flushCommands();
 		}
 		
 		float CSoundSource::getGain()
 		{
-			return m_gain;
+			return m_sendGain;
 		}
 		
 		float CSoundSource::getPitch()
 		{
-			return m_pitch;
+			return m_sendPitch;
 		}
 		
 		void CSoundSource::update(float dt)
 		{
+			// the queue was full when the values changed
+			flushCommands();
 		}
 		
 		float CSoundSource::getBufferLength()
@@ -27,6 +27,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "stdafx.h"
 #include "Thread/IMutex.h"
 #include "ISoundSource.h"
+#include "CAudioCommandQueue.h"
 
 using namespace Skylicht::System;
 
@@ -37,7 +38,7 @@ namespace Skylicht
 		class CSoundSource : public ISoundSource
 		{
 		public:
-			CSoundSource(float length);
+			CSoundSource(float length, CAudioCommandQueue* commands = NULL);
 			virtual ~CSoundSource();
 			
 			virtual void init(const STrackParams& trackParam, const SSourceParam& driverParam);
@@ -63,7 +64,11 @@ namespace Skylicht
 			virtual void lockThread();
 			virtual void unlockThread();
 			
-			virtual void fillBuffer(int* buffer, int nbSample, float gain = 1.0f);
+			/// @brief Mix the current buffer to the float stereo mix bus, it is called on the audio thread.
+			virtual void fillBuffer(float* buffer, int nbSample, float gain = 1.0f);
+
+			/// @brief Apply a parameter change that is sent from setState, setGain..., it is called on the audio thread.
+			void applyCommand(const SSourceCommand& command);
 			
 			virtual void setGain(float gain);
 			virtual void setPitch(float pitch);
@@ -80,13 +85,26 @@ namespace Skylicht
 			virtual int getSampleRate();
 			
 		protected:
+			bool sendCommand(SSourceCommand::ECommand type, int state, float x = 0.0f, float y = 0.0f, float z = 0.0f);
+
+			/// @brief Send the changed values that are not sent yet, the values stay pending if the queue is full.
+			void flushCommands();
+
 			void update3D();
 			float calcDistanceGain(const SListener& listener);
 			void calcLeftRightGain(const SListener& listener, float& left, float& right);
 		protected:
 			STrackParams m_trackParams;
 			int m_numDriverBuffer;
+
+			// the buffer that the audio thread is playing
 			int m_driverBuffer;
+
+			// the next buffer that uploadData writes
+			int m_uploadBuffer;
+
+			// the uploaded buffers that are not played yet
+			std::atomic<int> m_numQueuedBuffer;
 			int m_driverBufferSize;
 			int m_driverSamplingRate;
 			
@@ -109,6 +127,23 @@ namespace Skylicht
 			float m_rollOff;
 			
 			ISoundSource::ESourceState m_state;
+
+			CAudioCommandQueue* m_commands;
+
+			// the gain of the last mixed frame, the next buffer is ramped from it
+			float m_rampLeftGain;
+			float m_rampRightGain;
+
+			// the values that are set on this source, the audio thread applies them from the command queue
+			ISoundSource::ESourceState m_sendState;
+			float m_sendGain;
+			float m_sendPitch;
+			SVector3 m_sendPosition;
+			float m_sendRollOff;
+			bool m_send3DSound;
+
+			// the bit (1 << SSourceCommand::ECommand) of the values that are not in the queue yet
+			unsigned int m_pendingCommands;
 		};
 	}
 }
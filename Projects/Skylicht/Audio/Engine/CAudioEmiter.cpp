@@ -362,6 +362,9 @@ namespace Skylicht
 					// update buffer when driver is changed duration
 					updateSourceBuffer();
 				}
+
+				// resend the changes that did not fit in the driver command queue
+				m_source->update(1000.0f / 30.0f);
 			}
 
 			// force play (fix play when source is not init)
@@ -556,15 +559,11 @@ namespace Skylicht
 
 					if (m_source)
 					{
-						m_source->lockThread();
-
 						if (m_buffer)
 						{
 							for (int i = 0; i < m_numBuffer; i++)
 								memset(m_buffer[i], 0, m_bufferSize);
 						}
-
-						m_source->unlockThread();
 					}
 				}
 
@@ -604,15 +603,11 @@ namespace Skylicht
 
 			if (m_state != ISoundSource::StatePause && m_source)
 			{
-				m_source->lockThread();
-
 				if (m_buffer)
 				{
 					for (int i = 0; i < m_numBuffer; i++)
 						memset(m_buffer[i], 0, m_bufferSize);
 				}
-
-				m_source->unlockThread();
 			}
 
 			m_currentTime = time;
@@ -660,8 +655,6 @@ namespace Skylicht
 			// fix bug dirty sample
 			if (m_state != ISoundSource::StateStopped && m_source)
 			{
-				m_source->lockThread();
-
 				if (m_buffer)
 				{
 					for (int i = 0; i < m_numBuffer; i++)
@@ -670,8 +663,6 @@ namespace Skylicht
 
 				if (m_decoder)
 					m_decoder->seek(0);
-
-				m_source->unlockThread();
 			}
 
 			m_state = ISoundSource::StateStopped;
@@ -690,15 +681,11 @@ namespace Skylicht
 			// fix bug dirty sample
 			if (m_state != ISoundSource::StatePause && m_source)
 			{
-				m_source->lockThread();
-
 				if (m_buffer)
 				{
 					for (int i = 0; i < m_numBuffer; i++)
 						memset(m_buffer[i], 0, m_bufferSize);
 				}
-
-				m_source->unlockThread();
 			}
 
 			// CAudioEngine::getSoundEngine()->pushEvent(EVENT_PAUSE);
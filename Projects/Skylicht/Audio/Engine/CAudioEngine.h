@@ -163,6 +163,8 @@ namespace Skylicht
 
 			/**
 			 * @brief Lock audio thread for safe state modification.
+			 * The sound source parameters (state, gain, pitch, position) do not need this lock,
+			 * they are sent to the audio thread with a lock-free command queue.
 			 */
 			void lockThread()
 			{
@@ -0,0 +1,910 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CBVHBuilder.h"
+
+#include "Debug/CSceneDebug.h"
+#include "Job/CJobScheduler.h"
+#include "Utils/SIMD.h"
+
+#include <algorithm>
+
+namespace Skylicht
+{
+	// packet of rays, 8 lanes on AVX2, 4 lanes on SSE and on the scalar path
+#if defined(SKYLICHT_SIMD_AVX2)
+#define BVH_PACKET_SIZE 8
+	typedef __m256 vfloat;
+
+	static inline vfloat vset(f32 a) { return _mm256_set1_ps(a); }
+	static inline vfloat vload(const f32* a) { return _mm256_loadu_ps(a); }
+	static inline void vstore(f32* a, vfloat v) { _mm256_storeu_ps(a, v); }
+	static inline vfloat vadd(vfloat a, vfloat b) { return _mm256_add_ps(a, b); }
+	static inline vfloat vsub(vfloat a, vfloat b) { return _mm256_sub_ps(a, b); }
+	static inline vfloat vmul(vfloat a, vfloat b) { return _mm256_mul_ps(a, b); }
+	static inline vfloat vdiv(vfloat a, vfloat b) { return _mm256_div_ps(a, b); }
+	static inline vfloat vmin(vfloat a, vfloat b) { return _mm256_min_ps(a, b); }
+	static inline vfloat vmax(vfloat a, vfloat b) { return _mm256_max_ps(a, b); }
+	static inline vfloat vabs(vfloat a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+	static inline vfloat vlt(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static inline vfloat vle(vfloat a, vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+	static inline vfloat vand(vfloat a, vfloat b) { return _mm256_and_ps(a, b); }
+	static inline vfloat vselect(vfloat m, vfloat a, vfloat b) { return _mm256_blendv_ps(b, a, m); }
+	static inline int vmask(vfloat m) { return _mm256_movemask_ps(m); }
+#elif defined(SKYLICHT_SIMD_SSE)
+#define BVH_PACKET_SIZE 4
+	typedef __m128 vfloat;
+
+	static inline vfloat vset(f32 a) { return _mm_set1_ps(a); }
+	static inline vfloat vload(const f32* a) { return _mm_loadu_ps(a); }
+	static inline void vstore(f32* a, vfloat v) { _mm_storeu_ps(a, v); }
+	static inline vfloat vadd(vfloat a, vfloat b) { return _mm_add_ps(a, b); }
+	static inline vfloat vsub(vfloat a, vfloat b) { return _mm_sub_ps(a, b); }
+	static inline vfloat vmul(vfloat a, vfloat b) { return _mm_mul_ps(a, b); }
+	static inline vfloat vdiv(vfloat a, vfloat b) { return _mm_div_ps(a, b); }
+	static inline vfloat vmin(vfloat a, vfloat b) { return _mm_min_ps(a, b); }
+	static inline vfloat vmax(vfloat a, vfloat b) { return _mm_max_ps(a, b); }
+	static inline vfloat vabs(vfloat a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+	static inline vfloat vlt(vfloat a, vfloat b) { return _mm_cmplt_ps(a, b); }
+	static inline vfloat vle(vfloat a, vfloat b) { return _mm_cmple_ps(a, b); }
+	static inline vfloat vand(vfloat a, vfloat b) { return _mm_and_ps(a, b); }
+	static inline vfloat vselect(vfloat m, vfloat a, vfloat b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+	static inline int vmask(vfloat m) { return _mm_movemask_ps(m); }
+#else
+#define BVH_PACKET_SIZE 4
+	// the compiler can vectorize these loops (NEON)
+	struct vfloat
+	{
+		f32 v[BVH_PACKET_SIZE];
+	};
+
+#define BVH_LANE_OP(name, expr) \
+	static inline vfloat name(vfloat a, vfloat b) { vfloat r; for (int i = 0; i < BVH_PACKET_SIZE; i++) r.v[i] = expr; return r; }
+
+	BVH_LANE_OP(vadd, a.v[i] + b.v[i])
+	BVH_LANE_OP(vsub, a.v[i] - b.v[i])
+	BVH_LANE_OP(vmul, a.v[i] * b.v[i])
+	BVH_LANE_OP(vdiv, a.v[i] / b.v[i])
+	BVH_LANE_OP(vmin, a.v[i] < b.v[i] ? a.v[i] : b.v[i])
+	BVH_LANE_OP(vmax, a.v[i] > b.v[i] ? a.v[i] : b.v[i])
+	BVH_LANE_OP(vlt, a.v[i] < b.v[i] ? 1.0f : 0.0f)
+	BVH_LANE_OP(vle, a.v[i] <= b.v[i] ? 1.0f : 0.0f)
+	BVH_LANE_OP(vand, (a.v[i] != 0.0f && b.v[i] != 0.0f) ? 1.0f : 0.0f)
+
+	static inline vfloat vset(f32 a) { vfloat r; for (int i = 0; i < BVH_PACKET_SIZE; i++) r.v[i] = a; return r; }
+	static inline vfloat vload(const f32* a) { vfloat r; for (int i = 0; i < BVH_PACKET_SIZE; i++) r.v[i] = a[i]; return r; }
+	static inline void vstore(f32* a, vfloat v) { for (int i = 0; i < BVH_PACKET_SIZE; i++) a[i] = v.v[i]; }
+	static inline vfloat vabs(vfloat a) { vfloat r; for (int i = 0; i < BVH_PACKET_SIZE; i++) r.v[i] = fabsf(a.v[i]); return r; }
+	static inline vfloat vselect(vfloat m, vfloat a, vfloat b) { vfloat r; for (int i = 0; i < BVH_PACKET_SIZE; i++) r.v[i] = m.v[i] != 0.0f ? a.v[i] : b.v[i]; return r; }
+	static inline int vmask(vfloat m) { int r = 0; for (int i = 0; i < BVH_PACKET_SIZE; i++) r |= (m.v[i] != 0.0f ? 1 : 0) << i; return r; }
+#endif
+
+	const u32 CBVHBuilder::PacketSize = BVH_PACKET_SIZE;
+
+	const u32 CBVHBuilder::MaxDepth = 64;
+
+	static const f32 DetEpsilon = 1e-12f;
+
+	static inline f32 boxArea(const core::aabbox3df& box)
+	{
+		core::vector3df e = box.MaxEdge - box.MinEdge;
+		return 2.0f * (e.X * e.Y + e.Y * e.Z + e.Z * e.X);
+	}
+
+	// the ray direction without zero component, that the slab test does not get NaN
+	static inline f32 safeInverse(f32 d)
+	{
+		if (fabsf(d) < 1e-20f)
+			d = d < 0.0f ? -1e-20f : 1e-20f;
+		return 1.0f / d;
+	}
+
+	static inline bool rayBox(const SBVHNode* node, const core::vector3df& o, const core::vector3df& inv, f32 tBest)
+	{
+		f32 t0 = (node->Min.X - o.X) * inv.X;
+		f32 t1 = (node->Max.X - o.X) * inv.X;
+		f32 tmin = core::min_(t0, t1);
+		f32 tmax = core::max_(t0, t1);
+
+		t0 = (node->Min.Y - o.Y) * inv.Y;
+		t1 = (node->Max.Y - o.Y) * inv.Y;
+		tmin = core::max_(tmin, core::min_(t0, t1));
+		tmax = core::min_(tmax, core::max_(t0, t1));
+
+		t0 = (node->Min.Z - o.Z) * inv.Z;
+		t1 = (node->Max.Z - o.Z) * inv.Z;
+		tmin = core::max_(tmin, core::min_(t0, t1));
+		tmax = core::min_(tmax, core::max_(t0, t1));
+
+		return tmin <= tmax && tmax >= 0.0f && tmin <= tBest;
+	}
+
+	// Moller-Trumbore, two-sided like core::triangle3df::getIntersectionWithLine
+	static inline bool rayTriangle(const SBVHTriangle& tri, const core::vector3df& o, const core::vector3df& d, f32 tBest, f32& t)
+	{
+		core::vector3df p = d.crossProduct(tri.E2);
+		f32 det = tri.E1.dotProduct(p);
+		if (fabsf(det) <= DetEpsilon)
+			return false;
+
+		f32 inv = 1.0f / det;
+		core::vector3df s = o - tri.V0;
+		f32 u = s.dotProduct(p) * inv;
+		if (u < 0.0f || u > 1.0f)
+			return false;
+
+		core::vector3df q = s.crossProduct(tri.E1);
+		f32 v = d.dotProduct(q) * inv;
+		if (v < 0.0f || u + v > 1.0f)
+			return false;
+
+		t = tri.E2.dotProduct(q) * inv;
+		return t >= 0.0f && t < tBest;
+	}
+
+	CBVHBuilder::CBVHBuilder() :
+		m_numBVHNode(0),
+		m_maxLeafSize(4),
+		m_parallelBuildSize(4096)
+	{
+
+	}
+
+	CBVHBuilder::~CBVHBuilder()
+	{
+		clear();
+	}
+
+	void CBVHBuilder::clear()
+	{
+		m_bvh.clear();
+		m_numBVHNode = 0;
+		m_tris.clear();
+		m_refs.clear();
+		m_leafOfInput.clear();
+		m_nodeRange.clear();
+
+		CCollisionBuilder::clear();
+	}
+
+	void CBVHBuilder::build()
+	{
+		const u32 start = os::Timer::getRealTime();
+
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+
+		// step 1: update transform and triangles
+		u32 numNode = m_nodes.size();
+		scheduler->parallelFor(0, (int)numNode, 16, [&](int from, int to)
+			{
+				for (int i = from; i < to; i++)
+					m_nodes[i]->updateTransform();
+			});
+
+		u32 numPoly = 0;
+		for (u32 i = 0; i < numNode; i++)
+			numPoly += m_nodes[i]->Triangles.size();
+
+		// step 2: index triangle & bbox
+		m_nodeRange.clear();
+		m_refs.set_used(numPoly);
+		m_buildIndex.set_used(numPoly);
+		m_buildBox.set_used(numPoly);
+		m_buildCenter.set_used(numPoly);
+
+		u32 idx = 0;
+		for (u32 i = 0; i < numNode; i++)
+		{
+			CCollisionNode* node = m_nodes[i];
+
+			u32 numTris = node->Triangles.size();
+			core::triangle3df* tris = node->Triangles.pointer();
+
+			SNodeRange& range = m_nodeRange[node];
+			range.First = idx;
+			range.Count = numTris;
+
+			for (u32 j = 0; j < numTris; j++)
+			{
+				m_refs[idx].Node = node;
+				m_refs[idx].Triangle = j;
+
+				core::aabbox3df& box = m_buildBox[idx];
+				box.reset(tris[j].pointA);
+				box.addInternalPoint(tris[j].pointB);
+				box.addInternalPoint(tris[j].pointC);
+
+				m_buildCenter[idx] = box.getCenter();
+				m_buildIndex[idx] = idx;
+				idx++;
+			}
+		}
+
+		// step 3: build the tree, the max node count is 2 * numPoly - 1
+		m_bvh.set_used(numPoly > 0 ? numPoly * 2 : 0);
+		m_numBVHNode = 0;
+
+		if (numPoly > 0)
+		{
+			m_numBVHNode = 1;
+			buildNode(0, 0, numPoly, 0);
+		}
+
+		m_bvh.set_used(m_numBVHNode.load());
+
+		// step 4: sort the triangles in leaf order
+		core::array<SBVHTriangleRef> inputRefs(m_refs);
+
+		m_tris.set_used(numPoly);
+		m_leafOfInput.set_used(numPoly);
+
+		for (u32 i = 0; i < numPoly; i++)
+		{
+			u32 input = m_buildIndex[i];
+			m_refs[i] = inputRefs[input];
+			m_leafOfInput[input] = i;
+			updateLeafTriangle(i);
+		}
+
+		m_buildIndex.clear();
+		m_buildBox.clear();
+		m_buildCenter.clear();
+
+		c8 tmp[256];
+		sprintf(tmp, "Needed %ums to CBVHBuilder::build (%u polys, %u nodes)", os::Timer::getRealTime() - start, numPoly, m_numBVHNode.load());
+		os::Printer::log(tmp, ELL_INFORMATION);
+	}
+
+	void CBVHBuilder::buildNode(u32 nodeId, u32 begin, u32 end, u32 depth)
+	{
+		// m_bvh is allocated before build, the reference is safe on the job threads
+		SBVHNode& node = m_bvh[nodeId];
+
+		u32* index = m_buildIndex.pointer();
+		core::aabbox3df* boxes = m_buildBox.pointer();
+		core::vector3df* centers = m_buildCenter.pointer();
+
+		core::aabbox3df box(boxes[index[begin]]);
+		core::aabbox3df centerBox(centers[index[begin]]);
+		for (u32 i = begin + 1; i < end; i++)
+		{
+			box.addInternalBox(boxes[index[i]]);
+			centerBox.addInternalPoint(centers[index[i]]);
+		}
+
+		node.Min = box.MinEdge;
+		node.Max = box.MaxEdge;
+
+		u32 count = end - begin;
+		if (count <= m_maxLeafSize || depth >= MaxDepth)
+		{
+			node.LeftFirst = begin;
+			node.Count = count;
+			return;
+		}
+
+		// binned SAH
+		const int numBin = 16;
+		int bestAxis = -1;
+		int bestSplit = 0;
+		f32 bestCost = FLT_MAX;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			f32 cmin = (&centerBox.MinEdge.X)[axis];
+			f32 extent = (&centerBox.MaxEdge.X)[axis] - cmin;
+			if (extent <= 1e-6f)
+				continue;
+
+			f32 scale = numBin / extent;
+
+			u32 binCount[numBin] = { 0 };
+			core::aabbox3df binBox[numBin];
+
+			for (u32 i = begin; i < end; i++)
+			{
+				u32 t = index[i];
+				int b = core::min_(numBin - 1, (int)(((&centers[t].X)[axis] - cmin) * scale));
+
+				if (binCount[b] == 0)
+					binBox[b] = boxes[t];
+				else
+					binBox[b].addInternalBox(boxes[t]);
+				binCount[b]++;
+			}
+
+			// sweep from the right
+			f32 rightArea[numBin];
+			u32 rightCount[numBin];
+			core::aabbox3df acc;
+			u32 n = 0;
+			for (int b = numBin - 1; b > 0; b--)
+			{
+				if (binCount[b] > 0)
+				{
+					if (n == 0)
+						acc = binBox[b];
+					else
+						acc.addInternalBox(binBox[b]);
+					n += binCount[b];
+				}
+				rightCount[b - 1] = n;
+				rightArea[b - 1] = n > 0 ? boxArea(acc) : 0.0f;
+			}
+
+			// sweep from the left
+			n = 0;
+			for (int b = 0; b < numBin - 1; b++)
+			{
+				if (binCount[b] > 0)
+				{
+					if (n == 0)
+						acc = binBox[b];
+					else
+						acc.addInternalBox(binBox[b]);
+					n += binCount[b];
+				}
+
+				if (n == 0 || rightCount[b] == 0)
+					continue;
+
+				f32 cost = n * boxArea(acc) + rightCount[b] * rightArea[b];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = b;
+				}
+			}
+		}
+
+		// all triangles have the same center, or the split is not better than a leaf
+		f32 area = boxArea(box);
+		if (bestAxis < 0 || (count <= 16 && area + bestCost >= count * area))
+		{
+			node.LeftFirst = begin;
+			node.Count = count;
+			return;
+		}
+
+		f32 cmin = (&centerBox.MinEdge.X)[bestAxis];
+		f32 scale = numBin / ((&centerBox.MaxEdge.X)[bestAxis] - cmin);
+
+		u32* mid = std::partition(index + begin, index + end, [&](u32 t)
+			{
+				int b = core::min_(numBin - 1, (int)(((&centers[t].X)[bestAxis] - cmin) * scale));
+				return b <= bestSplit;
+			});
+
+		u32 split = (u32)(mid - index);
+		if (split == begin || split == end)
+			split = (begin + end) / 2;
+
+		u32 left = m_numBVHNode.fetch_add(2);
+		node.LeftFirst = left;
+		node.Count = 0;
+
+		if (count >= m_parallelBuildSize)
+		{
+			// the two ranges are not overlap, build the left on a job thread
+			System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+			System::CJobHandle job = scheduler->run([=]()
+				{
+					buildNode(left, begin, split, depth + 1);
+				});
+
+			buildNode(left + 1, split, end, depth + 1);
+			scheduler->wait(job);
+		}
+		else
+		{
+			buildNode(left, begin, split, depth + 1);
+			buildNode(left + 1, split, end, depth + 1);
+		}
+	}
+
+	void CBVHBuilder::updateLeafTriangle(u32 leaf)
+	{
+		SBVHTriangleRef& ref = m_refs[leaf];
+		SBVHTriangle& tri = m_tris[leaf];
+
+		if (ref.Node == NULL || ref.Triangle >= ref.Node->Triangles.size())
+		{
+			// the degenerate triangle is never hit
+			tri.E1.set(0.0f, 0.0f, 0.0f);
+			tri.E2.set(0.0f, 0.0f, 0.0f);
+			return;
+		}
+
+		const core::triangle3df& t = ref.Node->Triangles[ref.Triangle];
+		tri.V0 = t.pointA;
+		tri.E1 = t.pointB - t.pointA;
+		tri.E2 = t.pointC - t.pointA;
+	}
+
+	void CBVHBuilder::refitBounds()
+	{
+		// the childs are always allocated after the parent, update from the last node
+		SBVHNode* nodes = m_bvh.pointer();
+
+		for (s32 i = (s32)m_numBVHNode.load() - 1; i >= 0; i--)
+		{
+			SBVHNode& node = nodes[i];
+
+			if (node.Count > 0)
+			{
+				core::aabbox3df box;
+				bool first = true;
+
+				for (u32 j = node.LeftFirst, n = node.LeftFirst + node.Count; j < n; j++)
+				{
+					if (m_refs[j].Node == NULL)
+						continue;
+
+					const SBVHTriangle& tri = m_tris[j];
+					if (first)
+					{
+						box.reset(tri.V0);
+						first = false;
+					}
+					else
+						box.addInternalPoint(tri.V0);
+
+					box.addInternalPoint(tri.V0 + tri.E1);
+					box.addInternalPoint(tri.V0 + tri.E2);
+				}
+
+				// keep the old box if all triangles are removed
+				if (!first)
+				{
+					node.Min = box.MinEdge;
+					node.Max = box.MaxEdge;
+				}
+			}
+			else
+			{
+				const SBVHNode& l = nodes[node.LeftFirst];
+				const SBVHNode& r = nodes[node.LeftFirst + 1];
+
+				node.Min.set(core::min_(l.Min.X, r.Min.X), core::min_(l.Min.Y, r.Min.Y), core::min_(l.Min.Z, r.Min.Z));
+				node.Max.set(core::max_(l.Max.X, r.Max.X), core::max_(l.Max.Y, r.Max.Y), core::max_(l.Max.Z, r.Max.Z));
+			}
+		}
+	}
+
+	void CBVHBuilder::refit()
+	{
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+
+		scheduler->parallelFor(0, (int)m_nodes.size(), 16, [&](int from, int to)
+			{
+				for (int i = from; i < to; i++)
+					m_nodes[i]->updateTransform();
+			});
+
+		scheduler->parallelFor(0, (int)m_tris.size(), 1024, [&](int from, int to)
+			{
+				for (int i = from; i < to; i++)
+					updateLeafTriangle((u32)i);
+			});
+
+		refitBounds();
+	}
+
+	void CBVHBuilder::refit(CCollisionNode** nodes, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			std::map<CCollisionNode*, SNodeRange>::iterator it = m_nodeRange.find(nodes[i]);
+			if (it == m_nodeRange.end())
+				continue;
+
+			nodes[i]->updateTransform();
+
+			const SNodeRange& range = it->second;
+			for (u32 j = 0; j < range.Count; j++)
+				updateLeafTriangle(m_leafOfInput[range.First + j]);
+		}
+
+		refitBounds();
+	}
+
+	void CBVHBuilder::disableNode(CCollisionNode* node)
+	{
+		std::map<CCollisionNode*, SNodeRange>::iterator it = m_nodeRange.find(node);
+		if (it == m_nodeRange.end())
+			return;
+
+		const SNodeRange& range = it->second;
+		for (u32 j = 0; j < range.Count; j++)
+		{
+			u32 leaf = m_leafOfInput[range.First + j];
+			m_refs[leaf].Node = NULL;
+			updateLeafTriangle(leaf);
+		}
+
+		m_nodeRange.erase(it);
+	}
+
+	void CBVHBuilder::removeCollision(CGameObject* object)
+	{
+		for (u32 i = 0, n = m_nodes.size(); i < n; i++)
+		{
+			if (m_nodes[i]->GameObject == object)
+			{
+				disableNode(m_nodes[i]);
+				break;
+			}
+		}
+
+		CCollisionBuilder::removeCollision(object);
+	}
+
+	void CBVHBuilder::removeCollision(CCollisionNode** nodes, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			if (nodes[i] != NULL)
+			{
+				disableNode(nodes[i]);
+				CCollisionBuilder::removeCollision(nodes + i, 1);
+			}
+		}
+	}
+
+	void CBVHBuilder::drawDebug()
+	{
+		CSceneDebug* debug = CSceneDebug::getInstance();
+
+		for (u32 i = 0, n = m_numBVHNode.load(); i < n; i++)
+		{
+			const SBVHNode& node = m_bvh[i];
+			debug->addBoudingBox(core::aabbox3df(node.Min, node.Max), SColor(255, 255, 0, 0));
+		}
+	}
+
+	bool CBVHBuilder::getCollisionPoint(
+		const core::line3d<f32>& ray,
+		f32& outBestDistanceSquared,
+		core::vector3df& outIntersection,
+		core::triangle3df& outTriangle,
+		CCollisionNode*& outNode)
+	{
+		outNode = NULL;
+
+		const f32 lengthSQ = ray.getLengthSQ();
+		if (m_numBVHNode.load() == 0 || lengthSQ <= 0.0f)
+			return false;
+
+		// t is in [0, 1] on the segment
+		const core::vector3df& o = ray.start;
+		core::vector3df d = ray.end - ray.start;
+		core::vector3df inv(safeInverse(d.X), safeInverse(d.Y), safeInverse(d.Z));
+
+		f32 tBest = 1.0f;
+		if (outBestDistanceSquared < lengthSQ)
+			tBest = sqrtf(outBestDistanceSquared / lengthSQ);
+
+		s32 hit = -1;
+
+		const SBVHNode* nodes = m_bvh.pointer();
+		const SBVHTriangle* tris = m_tris.pointer();
+
+		u32 stack[MaxDepth * 2 + 2];
+		u32 stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const SBVHNode* node = &nodes[stack[--stackSize]];
+			if (!rayBox(node, o, inv, tBest))
+				continue;
+
+			if (node->Count > 0)
+			{
+				f32 t;
+				for (u32 i = node->LeftFirst, n = node->LeftFirst + node->Count; i < n; i++)
+				{
+					if (rayTriangle(tris[i], o, d, tBest, t))
+					{
+						tBest = t;
+						hit = (s32)i;
+					}
+				}
+			}
+			else
+			{
+				// visit the near child first
+				const SBVHNode* l = &nodes[node->LeftFirst];
+				const SBVHNode* r = l + 1;
+				core::vector3df diff = (r->Min + r->Max) - (l->Min + l->Max);
+
+				if (diff.dotProduct(d) > 0.0f)
+				{
+					stack[stackSize++] = node->LeftFirst + 1;
+					stack[stackSize++] = node->LeftFirst;
+				}
+				else
+				{
+					stack[stackSize++] = node->LeftFirst;
+					stack[stackSize++] = node->LeftFirst + 1;
+				}
+			}
+		}
+
+		if (hit < 0)
+			return false;
+
+		const SBVHTriangleRef& ref = m_refs[hit];
+		outNode = ref.Node;
+		outTriangle = ref.Node->Triangles[ref.Triangle];
+		outIntersection = o + d * tBest;
+		outBestDistanceSquared = lengthSQ * tBest * tBest;
+		return true;
+	}
+
+	u32 CBVHBuilder::getCollisionPoints(const core::line3df* rays, u32 count, SBVHRayHit* hits)
+	{
+		int numPacket = (int)((count + PacketSize - 1) / PacketSize);
+
+		System::CJobScheduler::getInstance()->parallelFor(0, numPacket, 16, [&](int from, int to)
+			{
+				for (int p = from; p < to; p++)
+				{
+					u32 first = (u32)p * PacketSize;
+					tracePacket(rays + first, core::min_(PacketSize, count - first), hits + first);
+				}
+			});
+
+		u32 numHit = 0;
+		for (u32 i = 0; i < count; i++)
+		{
+			if (hits[i].Node != NULL)
+				numHit++;
+		}
+		return numHit;
+	}
+
+	void CBVHBuilder::tracePacket(const core::line3df* rays, u32 count, SBVHRayHit* hits)
+	{
+		const int P = BVH_PACKET_SIZE;
+
+		f32 ox[P], oy[P], oz[P];
+		f32 dx[P], dy[P], dz[P];
+		f32 ix[P], iy[P], iz[P];
+		f32 tb[P];
+		s32 hitTri[P];
+
+		for (int k = 0; k < P; k++)
+		{
+			hitTri[k] = -1;
+
+			if (k < (int)count)
+			{
+				const core::line3df& ray = rays[k];
+				ox[k] = ray.start.X;
+				oy[k] = ray.start.Y;
+				oz[k] = ray.start.Z;
+				dx[k] = ray.end.X - ray.start.X;
+				dy[k] = ray.end.Y - ray.start.Y;
+				dz[k] = ray.end.Z - ray.start.Z;
+				tb[k] = 1.0f;
+			}
+			else
+			{
+				// the inactive lane never hits
+				ox[k] = oy[k] = oz[k] = 0.0f;
+				dx[k] = dy[k] = dz[k] = 1.0f;
+				tb[k] = -1.0f;
+			}
+
+			ix[k] = safeInverse(dx[k]);
+			iy[k] = safeInverse(dy[k]);
+			iz[k] = safeInverse(dz[k]);
+		}
+
+		if (m_numBVHNode.load() > 0)
+		{
+			const vfloat vox = vload(ox), voy = vload(oy), voz = vload(oz);
+			const vfloat vdx = vload(dx), vdy = vload(dy), vdz = vload(dz);
+			const vfloat vix = vload(ix), viy = vload(iy), viz = vload(iz);
+			const vfloat zero = vset(0.0f);
+			const vfloat one = vset(1.0f);
+			const vfloat eps = vset(DetEpsilon);
+
+			vfloat vtb = vload(tb);
+
+			// the first ray orders the childs
+			const core::vector3df d0(dx[0], dy[0], dz[0]);
+
+			const SBVHNode* nodes = m_bvh.pointer();
+			const SBVHTriangle* tris = m_tris.pointer();
+
+			u32 stack[MaxDepth * 2 + 2];
+			u32 stackSize = 0;
+			stack[stackSize++] = 0;
+
+			while (stackSize > 0)
+			{
+				const SBVHNode* node = &nodes[stack[--stackSize]];
+
+				// slab test for all rays
+				vfloat t0 = vmul(vsub(vset(node->Min.X), vox), vix);
+				vfloat t1 = vmul(vsub(vset(node->Max.X), vox), vix);
+				vfloat tmin = vmin(t0, t1);
+				vfloat tmax = vmax(t0, t1);
+
+				t0 = vmul(vsub(vset(node->Min.Y), voy), viy);
+				t1 = vmul(vsub(vset(node->Max.Y), voy), viy);
+				tmin = vmax(tmin, vmin(t0, t1));
+				tmax = vmin(tmax, vmax(t0, t1));
+
+				t0 = vmul(vsub(vset(node->Min.Z), voz), viz);
+				t1 = vmul(vsub(vset(node->Max.Z), voz), viz);
+				tmin = vmax(tmin, vmin(t0, t1));
+				tmax = vmin(tmax, vmax(t0, t1));
+
+				vfloat boxHit = vand(vand(vle(tmin, tmax), vle(zero, tmax)), vle(tmin, vtb));
+				if (vmask(boxHit) == 0)
+					continue;
+
+				if (node->Count > 0)
+				{
+					for (u32 i = node->LeftFirst, n = node->LeftFirst + node->Count; i < n; i++)
+					{
+						const SBVHTriangle& tri = tris[i];
+
+						const vfloat e1x = vset(tri.E1.X), e1y = vset(tri.E1.Y), e1z = vset(tri.E1.Z);
+						const vfloat e2x = vset(tri.E2.X), e2y = vset(tri.E2.Y), e2z = vset(tri.E2.Z);
+
+						// p = d x e2
+						vfloat px = vsub(vmul(vdy, e2z), vmul(vdz, e2y));
+						vfloat py = vsub(vmul(vdz, e2x), vmul(vdx, e2z));
+						vfloat pz = vsub(vmul(vdx, e2y), vmul(vdy, e2x));
+
+						vfloat det = vadd(vadd(vmul(e1x, px), vmul(e1y, py)), vmul(e1z, pz));
+						vfloat inv = vdiv(one, det);
+
+						vfloat sx = vsub(vox, vset(tri.V0.X));
+						vfloat sy = vsub(voy, vset(tri.V0.Y));
+						vfloat sz = vsub(voz, vset(tri.V0.Z));
+
+						vfloat u = vmul(vadd(vadd(vmul(sx, px), vmul(sy, py)), vmul(sz, pz)), inv);
+
+						// q = s x e1
+						vfloat qx = vsub(vmul(sy, e1z), vmul(sz, e1y));
+						vfloat qy = vsub(vmul(sz, e1x), vmul(sx, e1z));
+						vfloat qz = vsub(vmul(sx, e1y), vmul(sy, e1x));
+
+						vfloat v = vmul(vadd(vadd(vmul(vdx, qx), vmul(vdy, qy)), vmul(vdz, qz)), inv);
+						vfloat t = vmul(vadd(vadd(vmul(e2x, qx), vmul(e2y, qy)), vmul(e2z, qz)), inv);
+
+						vfloat mask = vlt(eps, vabs(det));
+						mask = vand(mask, vand(vle(zero, u), vle(zero, v)));
+						mask = vand(mask, vle(vadd(u, v), one));
+						mask = vand(mask, vand(vle(zero, t), vlt(t, vtb)));
+
+						int bits = vmask(mask);
+						if (bits != 0)
+						{
+							vtb = vselect(mask, t, vtb);
+							for (int k = 0; k < P; k++)
+							{
+								if (bits & (1 << k))
+									hitTri[k] = (s32)i;
+							}
+						}
+					}
+				}
+				else
+				{
+					const SBVHNode* l = &nodes[node->LeftFirst];
+					const SBVHNode* r = l + 1;
+					core::vector3df diff = (r->Min + r->Max) - (l->Min + l->Max);
+
+					if (diff.dotProduct(d0) > 0.0f)
+					{
+						stack[stackSize++] = node->LeftFirst + 1;
+						stack[stackSize++] = node->LeftFirst;
+					}
+					else
+					{
+						stack[stackSize++] = node->LeftFirst;
+						stack[stackSize++] = node->LeftFirst + 1;
+					}
+				}
+			}
+
+			vstore(tb, vtb);
+		}
+
+		for (u32 k = 0; k < count; k++)
+		{
+			SBVHRayHit& hit = hits[k];
+			core::vector3df d(dx[k], dy[k], dz[k]);
+
+			if (hitTri[k] >= 0)
+			{
+				const SBVHTriangleRef& ref = m_refs[hitTri[k]];
+				hit.Node = ref.Node;
+				hit.Triangle = ref.Node->Triangles[ref.Triangle];
+				hit.Intersection = rays[k].start + d * tb[k];
+				hit.DistanceSquared = d.getLengthSQ() * tb[k] * tb[k];
+			}
+			else
+			{
+				hit.Node = NULL;
+				hit.Intersection = rays[k].end;
+				hit.DistanceSquared = d.getLengthSQ();
+			}
+		}
+	}
+
+	void CBVHBuilder::getTriangles(const core::aabbox3df& box,
+		core::array<core::triangle3df*>& result,
+		core::array<CCollisionNode*>& nodes)
+	{
+		if (m_numBVHNode.load() == 0)
+			return;
+
+		const SBVHNode* bvh = m_bvh.pointer();
+
+		u32 stack[MaxDepth * 2 + 2];
+		u32 stackSize = 0;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const SBVHNode* node = &bvh[stack[--stackSize]];
+
+			if (node->Min.X > box.MaxEdge.X || node->Max.X < box.MinEdge.X ||
+				node->Min.Y > box.MaxEdge.Y || node->Max.Y < box.MinEdge.Y ||
+				node->Min.Z > box.MaxEdge.Z || node->Max.Z < box.MinEdge.Z)
+				continue;
+
+			if (node->Count > 0)
+			{
+				for (u32 i = node->LeftFirst, n = node->LeftFirst + node->Count; i < n; i++)
+				{
+					const SBVHTriangleRef& ref = m_refs[i];
+					if (ref.Node == NULL)
+						continue;
+
+					core::triangle3df& triangle = ref.Node->Triangles[ref.Triangle];
+					if (!triangle.isTotalOutsideBox(box))
+					{
+						result.push_back(&triangle);
+						nodes.push_back(ref.Node);
+					}
+				}
+			}
+			else
+			{
+				stack[stackSize++] = node->LeftFirst;
+				stack[stackSize++] = node->LeftFirst + 1;
+			}
+		}
+	}
+}
@@ -0,0 +1,169 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CCollisionBuilder.h"
+
+#include <atomic>
+
+namespace Skylicht
+{
+	// Flattened node, 32 bytes
+	// Count > 0: leaf, the triangles are [LeftFirst, LeftFirst + Count)
+	// Count = 0: the childs are LeftFirst and LeftFirst + 1
+	struct SBVHNode
+	{
+		core::vector3df Min;
+		u32 LeftFirst;
+		core::vector3df Max;
+		u32 Count;
+	};
+
+	// Triangle in leaf order, precomputed for the ray test
+	struct SBVHTriangle
+	{
+		core::vector3df V0;
+		core::vector3df E1;
+		core::vector3df E2;
+	};
+
+	// Source of the triangle in leaf order
+	struct SBVHTriangleRef
+	{
+		CCollisionNode* Node;
+		u32 Triangle;
+	};
+
+	struct SBVHRayHit
+	{
+		//! NULL if the ray does not hit
+		CCollisionNode* Node;
+
+		core::triangle3df Triangle;
+
+		core::vector3df Intersection;
+
+		f32 DistanceSquared;
+	};
+
+	class CBVHBuilder : public CCollisionBuilder
+	{
+	protected:
+		struct SNodeRange
+		{
+			u32 First;
+			u32 Count;
+		};
+
+		core::array<SBVHNode> m_bvh;
+		std::atomic<u32> m_numBVHNode;
+
+		core::array<SBVHTriangle> m_tris;
+		core::array<SBVHTriangleRef> m_refs;
+
+		// the input triangle (node by node) to the leaf order, that use for refit
+		core::array<u32> m_leafOfInput;
+		std::map<CCollisionNode*, SNodeRange> m_nodeRange;
+
+		// build temp
+		core::array<u32> m_buildIndex;
+		core::array<core::aabbox3df> m_buildBox;
+		core::array<core::vector3df> m_buildCenter;
+
+		u32 m_maxLeafSize;
+		u32 m_parallelBuildSize;
+
+	public:
+		CBVHBuilder();
+
+		virtual ~CBVHBuilder();
+
+		virtual void build();
+
+		virtual void clear();
+
+		virtual void drawDebug();
+
+		// update the transform of all nodes, and refit the bounds without rebuild the tree
+		void refit();
+
+		// update the transform of the moving nodes, and refit the bounds
+		// the triangle count of the nodes must not change
+		void refit(CCollisionNode** nodes, int count);
+
+		// the triangles of removed node are disabled, no need to build() again
+		virtual void removeCollision(CGameObject* object);
+
+		virtual void removeCollision(CCollisionNode** nodes, int count);
+
+		inline u32 getBVHNodeCount()
+		{
+			return m_numBVHNode.load();
+		}
+
+		inline u32 getPacketSize()
+		{
+			return PacketSize;
+		}
+
+	public:
+
+		virtual bool getCollisionPoint(
+			const core::line3d<f32>& ray,
+			f32& outBestDistanceSquared,
+			core::vector3df& outIntersection,
+			core::triangle3df& outTriangle,
+			CCollisionNode*& outNode);
+
+		/**
+		 * @brief Trace many segments at once, the rays are traced by the packets of getPacketSize() on the job threads.
+		 * @param rays The segments.
+		 * @param count Number of rays.
+		 * @param hits Output array of count hits, Node is NULL if the ray does not hit.
+		 * @return Number of the rays that hit.
+		 */
+		u32 getCollisionPoints(const core::line3df* rays, u32 count, SBVHRayHit* hits);
+
+		virtual void getTriangles(const core::aabbox3df& box,
+			core::array<core::triangle3df*>& result,
+			core::array<CCollisionNode*>& nodes);
+
+	protected:
+
+		static const u32 PacketSize;
+
+		static const u32 MaxDepth;
+
+		void buildNode(u32 nodeId, u32 begin, u32 end, u32 depth);
+
+		void updateLeafTriangle(u32 leaf);
+
+		void refitBounds();
+
+		void disableNode(CCollisionNode* node);
+
+		void tracePacket(const core::line3df* rays, u32 count, SBVHRayHit* hits);
+	};
+}
@@ -38,11 +38,22 @@ namespace Skylicht
 
 		virtual ~CCollisionBuilder();
 
+		// remember build() after the add
+		inline void addCollision(CCollisionNode* node)
+		{
+			m_nodes.push_back(node);
+		}
+
+		inline u32 getCollisionCount()
+		{
+			return m_nodes.size();
+		}
+
 		// remember build() after the remove
-		void removeCollision(CGameObject* object);
+		virtual void removeCollision(CGameObject* object);
 
 		// remember build() after the remove
-		void removeCollision(CCollisionNode** nodes, int count);
+		virtual void removeCollision(CCollisionNode** nodes, int count);
 
 		virtual void clear();
 
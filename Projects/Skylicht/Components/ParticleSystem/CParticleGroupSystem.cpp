@@ -2,13 +2,15 @@
 #include "CParticleGroupSystem.h"
 
 #include "Entity/CEntityManager.h"
+#include "Job/CJobScheduler.h"
 
 namespace Skylicht
 {
 	namespace Particle
 	{
 		CParticleGroupSystem::CParticleGroupSystem() :
-			m_group(NULL)
+			m_group(NULL),
+			m_parallelUpdate(false)
 		{
 
 		}
@@ -71,6 +73,36 @@ namespace Skylicht
 			CEntity** entities = m_group->getEntities();
 			int numEntity = m_group->getEntityCount();
 
+			if (m_parallelUpdate)
+			{
+				// seed the groups on main thread, the new seed is taken from the shared random sequence
+				for (int i = 0; i < numEntity; i++)
+				{
+					CParticleBufferData* data = GET_ENTITY_DATA(entities[i], CParticleBufferData);
+					for (u32 j = 0, m = data->AllGroups.size(); j < m; j++)
+						data->AllGroups[j]->initRandomSeed();
+				}
+
+				// one job per entity, its sub groups must update after their parent group
+				System::CJobScheduler::getInstance()->parallelFor(0, numEntity, 1, [entities](int from, int to)
+					{
+						for (int i = from; i < to; i++)
+						{
+							CEntity* entity = entities[i];
+
+							CParticleBufferData* data = GET_ENTITY_DATA(entity, CParticleBufferData);
+							CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+
+							for (u32 j = 0, m = data->AllGroups.size(); j < m; j++)
+							{
+								data->AllGroups[j]->setParentWorldMatrix(transform->World);
+								data->AllGroups[j]->update(true);
+							}
+						}
+					});
+				return;
+			}
+
 			for (int i = 0; i < numEntity; i++)
 			{
 				CEntity* entity = entities[i];
@@ -53,6 +53,9 @@ namespace Skylicht
 			/** @brief Internal scratchpad matrix. */
 			core::matrix4 m_transform;
 
+			/** @brief Update the particle groups on the job threads. */
+			bool m_parallelUpdate;
+
 		public:
 			CParticleGroupSystem();
 
@@ -70,6 +73,24 @@ namespace Skylicht
 			/** @brief ECS hook: main logic for particle movement and lifecycle. */
 			virtual void update(CEntityManager* entityManager);
 
+			/**
+			 * @brief Updates the particle groups on the job threads.
+			 * @details The groups of an entity are updated in order on one job (sub groups depend on their parent group),
+			 * the large groups are split into spans, and CParticleRenderer fills the vertex buffers in parallel.
+			 * Each group uses its own random seed, so the result does not depend on the number of threads.
+			 * The setting is per entity manager, get the system with CEntityManager::getSystem<CParticleGroupSystem>().
+			 * @see CGroup::initRandomSeed, System::CJobScheduler
+			 */
+			inline void setParallelUpdate(bool b)
+			{
+				m_parallelUpdate = b;
+			}
+
+			inline bool isParallelUpdate()
+			{
+				return m_parallelUpdate;
+			}
+
 		protected:
 
 		};
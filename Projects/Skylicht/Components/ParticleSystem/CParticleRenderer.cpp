@@ -25,6 +25,8 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "Entity/CEntityManager.h"
 #include "CParticleRenderer.h"
+#include "CParticleGroupSystem.h"
+#include "Job/CJobScheduler.h"
 
 #include "Material/Shader/ShaderCallback/CShaderParticle.h"
 #include "Material/Shader/ShaderCallback/CShaderMaterial.h"
@@ -36,7 +38,8 @@ namespace Skylicht
 	namespace Particle
 	{
 		CParticleRenderer::CParticleRenderer() :
-			m_group(NULL)
+			m_group(NULL),
+			m_groupSystem(NULL)
 		{
 			m_renderPass = Transparent;
 		}
@@ -55,6 +58,9 @@ namespace Skylicht
 				if (!m_group)
 					m_group = entityManager->createGroupFromVisible(particle, 1);
 			}
+
+			if (m_groupSystem == NULL)
+				m_groupSystem = entityManager->getSystem<CParticleGroupSystem>();
 		}
 
 		void CParticleRenderer::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
@@ -106,6 +112,10 @@ namespace Skylicht
 			CEntity** entities = m_group->getEntities();
 			int numEntity = m_group->getEntityCount();
 
+			bool parallel = m_groupSystem != NULL && m_groupSystem->isParallelUpdate();
+			if (parallel)
+				updateParticleBuffers(entities, numEntity);
+
 			for (int i = 0; i < numEntity; i++)
 			{
 				CEntity* entity = entities[i];
@@ -115,8 +125,11 @@ namespace Skylicht
 
 				if (culling->Visible == true)
 				{
-					for (u32 j = 0, m = data->AllGroups.size(); j < m; j++)
-						data->AllGroups[j]->updateForRenderer();
+					if (!parallel)
+					{
+						for (u32 j = 0, m = data->AllGroups.size(); j < m; j++)
+							data->AllGroups[j]->updateForRenderer();
+					}
 
 					CIndirectLightingData* lightingData = GET_ENTITY_DATA(entity, CIndirectLightingData);
 					if (lightingData != NULL)
@@ -155,6 +168,53 @@ namespace Skylicht
 			}
 		}
 
+		void CParticleRenderer::updateParticleBuffers(CEntity** entities, int numEntity)
+		{
+			m_updateGroups.set_used(0);
+
+			// the renderer mesh and the groups that billboard by their orientation are updated on main thread
+			CShaderParticle::setViewUp(m_billboardUp);
+			CShaderParticle::setViewLook(m_billboardLook);
+
+			for (int i = 0; i < numEntity; i++)
+			{
+				CEntity* entity = entities[i];
+
+				CParticleBufferData* data = GET_ENTITY_DATA(entity, CParticleBufferData);
+				CCullingData* culling = GET_ENTITY_DATA(entity, CCullingData);
+
+				if (culling->Visible == false)
+					continue;
+
+				for (u32 j = 0, m = data->AllGroups.size(); j < m; j++)
+				{
+					CGroup* g = data->AllGroups[j];
+					g->updateRendererMesh();
+
+					IRenderer* renderer = g->getRenderer();
+					if (g->UseOrientationAsBillboard && renderer != NULL && !renderer->useInstancing())
+					{
+						CShaderParticle::setViewUp(g->getTransformVector(g->OrientationUp));
+						CShaderParticle::setViewLook(g->getTransformVector(g->OrientationNormal));
+						g->updateRendererBuffer();
+						CShaderParticle::setViewUp(m_billboardUp);
+						CShaderParticle::setViewLook(m_billboardLook);
+					}
+					else
+					{
+						m_updateGroups.push_back(g);
+					}
+				}
+			}
+
+			CGroup** groups = m_updateGroups.pointer();
+			System::CJobScheduler::getInstance()->parallelFor(0, (int)m_updateGroups.size(), 1, [groups](int from, int to)
+				{
+					for (int i = from; i < to; i++)
+						groups[i]->updateRendererBuffer();
+				});
+		}
+
 		void CParticleRenderer::renderParticleGroup(CParticleBufferData* data, const core::matrix4& world)
 		{
 			IVideoDriver* driver = getVideoDriver();
@@ -39,6 +39,8 @@ namespace Skylicht
 {
 	namespace Particle
 	{
+		class CParticleGroupSystem;
+
 		/**
 		 * @class CParticleRenderer
 		 * @brief ECS render system for particles.
@@ -50,6 +52,8 @@ namespace Skylicht
 		protected:
 			/** @brief Cached entity group. */
 			CEntityGroup* m_group;
+			/** @brief Cached particle update system, it has the parallel update setting. */
+			CParticleGroupSystem* m_groupSystem;
 			/** @brief Internal scratchpad matrix. */
 			core::matrix4 m_transform;
 
@@ -57,6 +61,9 @@ namespace Skylicht
 			core::vector3df m_billboardUp;
 			/** @brief Current billboard look vector. */
 			core::vector3df m_billboardLook;
+
+			/** @brief The groups that fill their vertex buffer on the job threads. */
+			core::array<CGroup*> m_updateGroups;
 		public:
 			CParticleRenderer();
 
@@ -88,6 +95,9 @@ namespace Skylicht
 			/** @brief Internal helper to calculate transform without rotation. */
 			const core::matrix4& getTransformNoRotate(const core::matrix4& world);
 
+			/** @brief Internal: fills the vertex buffers of the visible groups on the job threads. */
+			void updateParticleBuffers(CEntity** entities, int numEntity);
+
 			/** @brief Internal: renders all groups for an entity. */
 			void renderParticleGroup(CParticleBufferData* data, const core::matrix4& world);
 
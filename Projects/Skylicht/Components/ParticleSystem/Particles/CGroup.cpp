@@ -28,6 +28,10 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Systems/CParticleSystem.h"
 #include "Utils/CStringImp.h"
+#include "Job/CJobScheduler.h"
+
+// the particles of a large group are updated in spans of this size on the job threads
+#define PARTICLE_SPAN_SIZE 2048
 
 namespace Skylicht
 {
@@ -47,7 +51,8 @@ namespace Skylicht
 			Name(L"Group"),
 			Visible(true),
 			Optimized(true),
-			m_frameUpdate(0)
+			m_frameUpdate(0),
+			m_randomSeed(0)
 		{
 			m_particleSystem = new CParticleSystem();
 
@@ -201,10 +206,17 @@ namespace Skylicht
 			}
 		}
 
-		void CGroup::update()
+		void CGroup::update(bool parallel)
 		{
 			float dt = getTimeStep();
 
+			s32* lastSeed = NULL;
+			if (parallel)
+			{
+				initRandomSeed();
+				lastSeed = random_bind(&m_randomSeed);
+			}
+
 			bornParticle();
 
 			updateLaunchEmitter();
@@ -214,13 +226,47 @@ namespace Skylicht
 
 			if (Visible)
 			{
-				// update particle system
-				m_particleSystem->update(particles, numParticles, this, dt);
+				SParticleSpan span(particles, 0, (int)numParticles);
 
-				for (ISystem* s : m_systems)
+				if (parallel && numParticles >= 2 * PARTICLE_SPAN_SIZE)
+				{
+					System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+
+					// update particle system
+					m_particleSystem->updateModelCache(this);
+					scheduler->parallelFor(0, (int)numParticles, PARTICLE_SPAN_SIZE, [&](int from, int to)
+						{
+							m_particleSystem->updateSpan(SParticleSpan(particles, from, to), this, dt);
+						});
+
+					for (ISystem* s : m_systems)
+					{
+						if (s->isEnable() == false)
+							continue;
+
+						if (s->supportParallelSpan())
+						{
+							scheduler->parallelFor(0, (int)numParticles, PARTICLE_SPAN_SIZE, [&](int from, int to)
+								{
+									s->updateSpan(SParticleSpan(particles, from, to), this, dt);
+								});
+						}
+						else
+						{
+							s->updateSpan(span, this, dt);
+						}
+					}
+				}
+				else
 				{
-					if (s->isEnable() == true)
-						s->update(particles, numParticles, this, dt);
+					// update particle system
+					m_particleSystem->update(particles, numParticles, this, dt);
+
+					for (ISystem* s : m_systems)
+					{
+						if (s->isEnable() == true)
+							s->updateSpan(span, this, dt);
+					}
 				}
 			}
 			else
@@ -253,9 +299,29 @@ namespace Skylicht
 					m_bbox.addInternalPoint(p.Position);
 				}
 			}
+
+			if (parallel)
+				random_bind(lastSeed);
 		}
 
 		void CGroup::updateForRenderer()
+		{
+			updateRendererMesh();
+			updateRendererBuffer();
+		}
+
+		void CGroup::updateRendererMesh()
+		{
+			if (Visible && m_renderer != NULL && m_renderer->needUpdateMesh())
+			{
+				if (m_renderer->useInstancing() == true)
+					m_renderer->getParticleBuffer(m_instancing->getMeshBuffer());
+				else
+					m_renderer->getParticleBuffer(m_cpuBuffer->getMeshBuffer());
+			}
+		}
+
+		void CGroup::updateRendererBuffer()
 		{
 			float dt = getTimeStep();
 
@@ -265,14 +331,6 @@ namespace Skylicht
 			// update instancing buffer
 			if (Visible && m_renderer != NULL)
 			{
-				if (m_renderer->needUpdateMesh())
-				{
-					if (m_renderer->useInstancing() == true)
-						m_renderer->getParticleBuffer(m_instancing->getMeshBuffer());
-					else
-						m_renderer->getParticleBuffer(m_cpuBuffer->getMeshBuffer());
-				}
-
 				if (m_renderer->useInstancing() == true)
 					m_instancingSystem->update(particles, numParticles, this, dt);
 				else
@@ -204,6 +204,9 @@ namespace Skylicht
 			core::aabbox3df m_bbox;
 
 			int m_frameUpdate;
+
+			/** @brief Random seed of the group, used when the group is updated on the job threads, 0 if it is not seeded yet. */
+			s32 m_randomSeed;
 		public:
 			CGroup();
 
@@ -215,12 +218,20 @@ namespace Skylicht
 			/** @brief Clears only immortal particles. */
 			void clearImmortalParticles();
 
-			/** @brief Main update loop for particle physics and lifecycle. */
-			void update();
+			/** @brief Main update loop for particle physics and lifecycle.
+			 * @param parallel true if the group is updated on a job thread: it uses its own random seed and the large group is split into spans.
+			 */
+			void update(bool parallel = false);
 
 			/** @brief Updates buffers for rendering. */
 			void updateForRenderer();
 
+			/** @brief Rebuilds the renderer mesh if needed, the main thread part of updateForRenderer. */
+			void updateRendererMesh();
+
+			/** @brief Fills the instancing or CPU vertex buffer, it can run on a job thread after updateRendererMesh. */
+			void updateRendererBuffer();
+
 			/** @brief Sets gravity direction using euler rotation. */
 			void setGravityRotation(const core::vector3df& euler);
 
@@ -424,6 +435,27 @@ namespace Skylicht
 				return m_frameUpdate;
 			}
 
+			/** @brief Sets the random seed of the group, the parallel update is deterministic for a fixed seed. */
+			inline void setRandomSeed(s32 seed)
+			{
+				m_randomSeed = seed;
+			}
+
+			/** @brief Takes a seed from the shared random sequence if the group is not seeded yet.
+			 * @details Call it on main thread before the group is updated on a job thread, see CParticleGroupSystem::setParallelUpdate.
+			 */
+			inline void initRandomSeed()
+			{
+				if (m_randomSeed == 0)
+					m_randomSeed = random_new_seed();
+			}
+
+			/** @brief Gets the random seed state of the group, 0 if it is not seeded yet. */
+			inline s32 getRandomSeed()
+			{
+				return m_randomSeed;
+			}
+
 			/** @brief Syncs frame count. */
 			inline void updateFrame(int frame)
 			{
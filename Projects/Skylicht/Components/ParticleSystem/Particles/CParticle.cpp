@@ -30,16 +30,17 @@ namespace Skylicht
 	namespace Particle
 	{
 		CParticle::CParticle(u32 index) :
-			Index(index),
-			ParentIndex(-1),
-			Immortal(false),
 			Age(0.0f),
 			Life(0.0f),
 			LifeTime(0.0f),
+			Immortal(false),
 			HaveRotate(false),
+			Index(index),
+			ParentIndex(-1),
 			SubEmitterDirection(0.0f, 1.0f, 0.0f),
 			UserData(NULL)
 		{
+			memset(Params, 0, sizeof(float) * NumParams);
 			memset(StartValue, 0, sizeof(float) * NumParams);
 			memset(EndValue, 0, sizeof(float) * NumParams);
 
@@ -100,6 +101,7 @@ namespace Skylicht
 
 			// note: dont swap [p.Index], just swap data
 			ParentIndex = p.ParentIndex;
+			Immortal = p.Immortal;
 			Age = p.Age;
 			Life = p.Life;
 			LifeTime = p.LifeTime;
@@ -64,20 +64,8 @@ namespace Skylicht
 		class COMPONENT_API CParticle
 		{
 		public:
-			/** @brief Global index in the group's particle array. */
-			u32 Index;
-			/** @brief Index of the parent particle in a parent group (for sub-emitters). */
-			s32 ParentIndex;
-
-			/** @brief If true, this particle never dies from age. */
-			bool Immortal;
-
-			/** @brief Current values of animated parameters. @see EParticleParams */
-			float Params[NumParams];
-			/** @brief Initial values of animated parameters. */
-			float StartValue[NumParams];
-			/** @brief Targeted end values of animated parameters. */
-			float EndValue[NumParams];
+			// the attributes of the simulation are declared first, so the update loop of
+			// CParticleSystem reads them in one cache line
 
 			/** @brief Time since birth in seconds. */
 			float Age;
@@ -86,19 +74,35 @@ namespace Skylicht
 			/** @brief Total expected lifespan in seconds. */
 			float LifeTime;
 
+			/** @brief If true, this particle never dies from age. */
+			bool Immortal;
+
 			/** @brief Optimization flag: whether this particle has active rotation logic. */
 			bool HaveRotate;
 
 			/** @brief Current world position. */
 			core::vector3df Position;
-			/** @brief Current world rotation (Euler). */
-			core::vector3df Rotation;
 			/** @brief Current movement velocity. */
 			core::vector3df Velocity;
 
 			/** @brief Position in the previous frame. */
 			core::vector3df LastPosition;
 
+			/** @brief Current world rotation (Euler). */
+			core::vector3df Rotation;
+
+			/** @brief Global index in the group's particle array. */
+			u32 Index;
+			/** @brief Index of the parent particle in a parent group (for sub-emitters). */
+			s32 ParentIndex;
+
+			/** @brief Current values of animated parameters. @see EParticleParams */
+			float Params[NumParams];
+			/** @brief Initial values of animated parameters. */
+			float StartValue[NumParams];
+			/** @brief Targeted end values of animated parameters. */
+			float EndValue[NumParams];
+
 			/** @brief Initial direction for sub-emitters if velocity is zero. */
 			core::vector3df SubEmitterDirection;
 			/** @brief Optional user-defined data. */
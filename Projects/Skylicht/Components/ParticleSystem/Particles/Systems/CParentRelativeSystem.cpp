@@ -45,6 +45,11 @@ namespace Skylicht
 		}
 
 		void CParentRelativeSystem::update(CParticle* particles, int num, CGroup* group, float dt)
+		{
+			updateSpan(SParticleSpan(particles, 0, num), group, dt);
+		}
+
+		void CParentRelativeSystem::updateSpan(const SParticleSpan& span, CGroup* group, float dt)
 		{
 			CSubGroup* subGroup = dynamic_cast<CSubGroup*>(group);
 			if (subGroup == NULL)
@@ -52,11 +57,11 @@ namespace Skylicht
 
 			CGroup* parentGroup = subGroup->getParentGroup();
 
+			CParticle* particles = span.Particles;
 			CParticle* baseParticles = parentGroup->getParticlePointer();
 			CParticle* p;
 
-// #pragma omp parallel for private(p)
-			for (int i = 0; i < num; i++)
+			for (int i = span.Begin; i < span.End; i++)
 			{
 				p = particles + i;
 
@@ -51,6 +51,14 @@ namespace Skylicht
 			/** @brief Implementation: performs relative movement and parameter syncing. */
 			virtual void update(CParticle* particles, int num, CGroup* group, float dt);
 
+			/** @brief Performs relative movement and parameter syncing on a span of particles. */
+			virtual void updateSpan(const SParticleSpan& span, CGroup* group, float dt);
+
+			virtual bool supportParallelSpan()
+			{
+				return true;
+			}
+
 			/** @brief Configures synchronization parameters. */
 			void syncParams(bool life, bool color)
 			{
@@ -61,44 +61,58 @@ namespace Skylicht
 			}
 		}
 
-		void CParticleSystem::update(CParticle* particles, int num, CGroup* group, float dt)
+		void CParticleSystem::updateModelCache(CGroup* group)
 		{
-			dt = dt * 0.001f;
-
-			float pi2 = 2 * core::PI;
-			core::vector3df gravity = group->Gravity * dt;
-
-			float friction = group->Friction * dt;
-
-			CParticle* p;
-			float* params;
-
 			std::vector<CModel*>& listModel = group->getModels();
 
 			CModel** models = listModel.data();
 			u32 numModels = (u32)listModel.size();
 
-			EParticleParams* paramTypes = new EParticleParams[numModels];
-			CInterpolator** modelInterpolators = new CInterpolator * [numModels];
+			// reuse the arrays, this function is called every frame for every group
+			m_paramTypes.set_used(numModels);
+			m_modelInterpolators.set_used(numModels);
 
 			for (u32 i = 0; i < numModels; i++)
 			{
 				CModel* m = models[i];
 
-				paramTypes[i] = m->getType();
+				m_paramTypes[i] = m->getType();
 
 				CInterpolator* it = m->getInterpolator();
 				if (it && !it->empty())
-					modelInterpolators[i] = it;
+					m_modelInterpolators[i] = it;
 				else
-					modelInterpolators[i] = NULL;
+					m_modelInterpolators[i] = NULL;
 			}
+		}
+
+		void CParticleSystem::update(CParticle* particles, int num, CGroup* group, float dt)
+		{
+			updateModelCache(group);
+			updateSpan(SParticleSpan(particles, 0, num), group, dt);
+		}
+
+		void CParticleSystem::updateSpan(const SParticleSpan& span, CGroup* group, float dt)
+		{
+			dt = dt * 0.001f;
 
+			float pi2 = 2 * core::PI;
+			core::vector3df gravity = group->Gravity * dt;
+
+			float friction = group->Friction * dt;
+			bool useFriction = group->Friction > 0.0f;
+
+			u32 numModels = m_paramTypes.size();
+			EParticleParams* paramTypes = m_paramTypes.pointer();
+			CInterpolator** modelInterpolators = m_modelInterpolators.pointer();
+
+			CParticle* particles = span.Particles;
+			CParticle* p;
+			float* params;
 			float f, x, y;
 			EParticleParams t;
 
-			// #pragma omp parallel for private(p, params, f, x, y, t)
-			for (int i = 0; i < num; i++)
+			for (int i = span.Begin; i < span.End; i++)
 			{
 				p = particles + i;
 				params = p->Params;
@@ -123,18 +137,25 @@ namespace Skylicht
 					p->Rotation.Y = p->Rotation.Y + params[RotateSpeedY] * dt;
 					p->Rotation.Z = p->Rotation.Z + params[RotateSpeedZ] * dt;
 
-					p->Rotation.X = fmod(p->Rotation.X, pi2);
-					p->Rotation.Y = fmod(p->Rotation.Y, pi2);
-					p->Rotation.Z = fmod(p->Rotation.Z, pi2);
+					// fmod is only needed when the angle is out of (-2pi, 2pi)
+					if (fabsf(p->Rotation.X) >= pi2)
+						p->Rotation.X = fmod(p->Rotation.X, pi2);
+					if (fabsf(p->Rotation.Y) >= pi2)
+						p->Rotation.Y = fmod(p->Rotation.Y, pi2);
+					if (fabsf(p->Rotation.Z) >= pi2)
+						p->Rotation.Z = fmod(p->Rotation.Z, pi2);
 				}
 
 				// update friction
-				if (group->Friction > 0.0f)
+				if (useFriction)
 				{
 					f = 1.0f - core::min_(1.0f, friction / params[Mass]);
 					p->Velocity *= f;
 				}
 
+				if (numModels == 0)
+					continue;
+
 				// update interpolate parameters
 				x = core::clamp(p->Age / p->LifeTime, 0.0f, 1.0f);
 
@@ -164,9 +185,6 @@ namespace Skylicht
 					}
 				}
 			}
-
-			delete[] paramTypes;
-			delete[] modelInterpolators;
 		}
 	}
 }
\ No newline at end of file
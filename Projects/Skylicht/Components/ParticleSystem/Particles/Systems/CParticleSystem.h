@@ -25,6 +25,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #pragma once
 
 #include "ISystem.h"
+#include "Utils/CInterpolator.h"
 
 namespace Skylicht
 {
@@ -38,6 +39,13 @@ namespace Skylicht
 		 */
 		class COMPONENT_API CParticleSystem : public ISystem
 		{
+		protected:
+			/** @brief Cached parameter type of the group's models. */
+			core::array<EParticleParams> m_paramTypes;
+
+			/** @brief Cached interpolator of the group's models, NULL if the model is linear. */
+			core::array<CInterpolator*> m_modelInterpolators;
+
 		public:
 			CParticleSystem();
 
@@ -48,6 +56,14 @@ namespace Skylicht
 
 			/** @brief Implementation: standard particle physics and parameter animation. */
 			virtual void update(CParticle *particles, int num, CGroup *group, float dt);
+
+			/** @brief Updates the model parameter cache from the group's models, call it before updateSpan. */
+			void updateModelCache(CGroup* group);
+
+			/** @brief Standard particle physics on a span, the spans of a group can be updated on many threads.
+			 * @details It uses the model cache of the last updateModelCache call.
+			 */
+			virtual void updateSpan(const SParticleSpan& span, CGroup* group, float dt);
 		};
 	}
 }
\ No newline at end of file
@@ -50,6 +50,11 @@ namespace Skylicht
 		}
 
 		void CVortexSystem::update(CParticle *particles, int num, CGroup *group, float dt)
+		{
+			updateSpan(SParticleSpan(particles, 0, num), group, dt);
+		}
+
+		void CVortexSystem::updateSpan(const SParticleSpan& span, CGroup* group, float dt)
 		{
 			core::vector3df position = group->getTransformPosition(m_position);
 
@@ -58,12 +63,12 @@ namespace Skylicht
 
 			float deltaTime = dt * 0.001f;
 
+			CParticle* particles = span.Particles;
 			CParticle *p;
 			float dist, angle, endRadius;
 			core::vector3df rotationCenter, normal, tangent, attraction;
 
-// #pragma omp parallel for private(p, dist, angle, endRadius, rotationCenter, normal, tangent, attraction)
-			for (int i = 0; i < num; i++)
+			for (int i = span.Begin; i < span.End; i++)
 			{
 				p = particles + i;
 
@@ -69,6 +69,14 @@ namespace Skylicht
 			/** @brief Implementation: applies vortex forces to particles. */
 			virtual void update(CParticle *particles, int num, CGroup *group, float dt);
 
+			/** @brief Applies vortex forces to a span of particles. */
+			virtual void updateSpan(const SParticleSpan& span, CGroup* group, float dt);
+
+			virtual bool supportParallelSpan()
+			{
+				return true;
+			}
+
 			/** @brief Gets center position. */
 			inline core::vector3df getPosition()
 			{
@@ -24,13 +24,38 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #pragma once
 
+#include "ParticleSystem/Particles/CParticle.h"
+
 namespace Skylicht
 {
 	namespace Particle
 	{
-		class CParticle;
 		class CGroup;
 
+		/**
+		 * @struct SParticleSpan
+		 * @ingroup ParticleSystem
+		 * @brief A range [Begin, End) of the group's particle array.
+		 */
+		struct SParticleSpan
+		{
+			CParticle* Particles;
+			int Begin;
+			int End;
+
+			SParticleSpan(CParticle* particles, int begin, int end) :
+				Particles(particles),
+				Begin(begin),
+				End(end)
+			{
+			}
+
+			inline int size() const
+			{
+				return End - Begin;
+			}
+		};
+
 		/**
 		 * @class ISystem
 		 * @ingroup ParticleSystem
@@ -63,6 +88,24 @@ namespace Skylicht
 			 */
 			virtual void update(CParticle *particles, int num, CGroup *group, float dt) = 0;
 
+			/** @brief Updates a span of particles.
+			 * @details The systems that do not read the other particles of the span override this function,
+			 * so the group can split its particles into many spans. The default implementation calls update.
+			 * @param span The range of particles.
+			 * @param group The owner group.
+			 * @param dt Delta time in milliseconds.
+			 */
+			virtual void updateSpan(const SParticleSpan& span, CGroup* group, float dt)
+			{
+				update(span.Particles + span.Begin, span.size(), group, dt);
+			}
+
+			/** @brief Returns true if the spans of a group can be updated concurrently on the job threads. */
+			virtual bool supportParallelSpan()
+			{
+				return false;
+			}
+
 			/** @brief Enables or disables the system. */
 			inline void setEnable(bool b)
 			{
@@ -39,14 +39,18 @@ namespace Skylicht
 		const s32 r = m % a;		// again less than q
 		const s32 rMax = m - 1;
 
+		// the seed of the current thread, see random_bind
+		thread_local s32* currentSeed = &seed;
+
 		s32 particle_rand()
 		{
 			// (a*seed)%m with Schrage's method
-			seed = a * (seed % q) - r * (seed / q);
-			if (seed < 0)
-				seed += m;
+			s32& s = *currentSeed;
+			s = a * (s % q) - r * (s / q);
+			if (s < 0)
+				s += m;
 
-			return seed;
+			return s;
 		}
 
 		f32 particle_frand()
@@ -64,6 +68,18 @@ namespace Skylicht
 			seed = value;
 		}
 
+		s32 random_new_seed()
+		{
+			return particle_rand();
+		}
+
+		s32* random_bind(s32* state)
+		{
+			s32* last = currentSeed;
+			currentSeed = state != NULL ? state : &seed;
+			return last;
+		}
+
 		int random(int from, int to)
 		{
 			s32 r = particle_rand() % (to - from);
@@ -39,6 +39,17 @@ namespace Skylicht
 
 		COMPONENT_API void random_reset(s32 seed);
 
+		/** @brief Returns a new seed from the shared random sequence. */
+		COMPONENT_API s32 random_new_seed();
+
+		/**
+		 * @brief Binds the random functions of the current thread to a seed state.
+		 * @details The groups updated on the job threads bind their own seed, so the result does not depend on the update order.
+		 * @param state The seed state, NULL to use the shared seed.
+		 * @return The previous state.
+		 */
+		COMPONENT_API s32* random_bind(s32* state);
+
 		/**
 		 * @enum EZone
 		 * @ingroup ParticleSystem
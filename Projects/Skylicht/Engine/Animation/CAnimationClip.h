@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CAnimationTrack.h"
+#include "CCompressedAnimationTrack.h"
 
 namespace Skylicht
 {
@@ -101,6 +102,17 @@ namespace Skylicht
 			AnimNameToInfo[anim->Name] = anim;
 		}
 
+		/**
+		 * @brief Compresses all tracks, see CCompressedAnimationTrack.
+		 * @param setting Sample rate and the error bounds.
+		 * @param releaseKeys Free the full precision keys after compress.
+		 */
+		void compress(const SAnimationCompressSetting& setting = SAnimationCompressSetting(), bool releaseKeys = true)
+		{
+			for (SEntityAnim* anim : AnimInfo)
+				anim->Data.compress(setting, releaseKeys);
+		}
+
 		/**
 		 * @brief Gets the number of entity animations (tracks) in the clip.
 		 * @return Track count.
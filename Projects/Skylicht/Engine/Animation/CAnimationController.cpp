@@ -26,6 +26,8 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "GameObject/CGameObject.h"
 #include "CAnimationController.h"
 #include "CAnimationManager.h"
+#include "CAnimationSystem.h"
+#include "Entity/CEntityManager.h"
 
 #include "RenderMesh/CRenderMesh.h"
 #include "MeshManager/CMeshManager.h"
@@ -38,13 +40,19 @@ namespace Skylicht
 
 	CAnimationController::CAnimationController() :
 		m_output(NULL),
-		m_loop(true)
+		m_loop(true),
+		m_animationSystem(NULL),
+		m_enableLOD(true),
+		m_lodFrame(-1)
 	{
 
 	}
 
 	CAnimationController::~CAnimationController()
 	{
+		if (m_animationSystem != NULL)
+			m_animationSystem->unRegisterController(this);
+
 		releaseAllSkeleton();
 	}
 
@@ -67,6 +75,17 @@ namespace Skylicht
 				skeleton->syncAnimationByTimeScale();
 		}
 
+		if (m_animationSystem == NULL)
+			m_animationSystem = m_gameObject->getEntityManager()->getSystem<CAnimationSystem>();
+
+		if (m_animationSystem != NULL)
+			m_animationSystem->registerController(this);
+		else
+			updateSkeletons();
+	}
+
+	void CAnimationController::updateSkeletons()
+	{
 		for (CSkeleton*& skeleton : m_skeletons)
 		{
 			if (skeleton->isEnable() == true)
@@ -79,6 +98,23 @@ namespace Skylicht
 			m_output->applyTransform();
 	}
 
+	bool CAnimationController::updateLODFrame(int interval, int stagger)
+	{
+		if (m_lodFrame < 0)
+		{
+			m_lodFrame = stagger % interval;
+			return true;
+		}
+
+		if (++m_lodFrame >= interval)
+		{
+			m_lodFrame = 0;
+			return true;
+		}
+
+		return false;
+	}
+
 	CObjectSerializable* CAnimationController::createSerializable()
 	{
 		CObjectSerializable* object = CComponentSystem::createSerializable();
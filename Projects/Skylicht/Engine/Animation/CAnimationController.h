@@ -29,6 +29,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	class CAnimationSystem;
+
 	/**
 	 * @brief Component that manages and updates animation skeletons for a GameObject.
 	 * @ingroup Animation
@@ -54,6 +56,8 @@ namespace Skylicht
 	 * attack->setTarget(result);
 	 * attack->setLayerType(CSkeleton::Replace); // Overrides movement
 	 * @endcode
+	 *
+	 * The timelines are updated in updateComponent, the skeletons are sampled later by CAnimationSystem on the job threads.
 	 */
 	class SKYLICHT_API CAnimationController : public CComponentSystem
 	{
@@ -70,6 +74,15 @@ namespace Skylicht
 		//! Whether the default animation should loop.
 		bool m_loop;
 
+		//! The system that samples the skeletons of this controller.
+		CAnimationSystem* m_animationSystem;
+
+		//! Whether the skeletons are sampled at a lower rate by the animation LOD.
+		bool m_enableLOD;
+
+		//! Number of frames since the last sample, -1 if it is not sampled yet.
+		int m_lodFrame;
+
 	public:
 		CAnimationController();
 
@@ -87,6 +100,33 @@ namespace Skylicht
 
 	public:
 
+		/**
+		 * @brief Samples, blends the skeletons and applies the output transforms.
+		 * It is called by CAnimationSystem, or in updateComponent if the entity manager has no CAnimationSystem.
+		 */
+		void updateSkeletons();
+
+		/**
+		 * @brief Counts the frames for the animation LOD.
+		 * @param interval Sample the skeletons once every interval frames.
+		 * @param stagger The offset of the first sample.
+		 * @return true if the skeletons need to be sampled at this frame.
+		 */
+		bool updateLODFrame(int interval, int stagger);
+
+		/**
+		 * @brief Enables or disables the animation LOD, e.g. disable it on the main character.
+		 */
+		inline void setEnableLOD(bool b)
+		{
+			m_enableLOD = b;
+		}
+
+		inline bool isEnableLOD()
+		{
+			return m_enableLOD;
+		}
+
 		/**
 		 * @brief Creates a new skeleton managed by this controller, using the GameObject's entities.
 		 * @return Pointer to the newly created skeleton.
@@ -0,0 +1,153 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CAnimationSystem.h"
+#include "CAnimationController.h"
+#include "Entity/CEntityManager.h"
+#include "GameObject/CGameObject.h"
+#include "Camera/CCamera.h"
+#include "Job/CJobScheduler.h"
+
+// the characters are split to the job threads when there are many of them
+#define PARALLEL_ANIMATION_COUNT 16
+#define PARALLEL_ANIMATION_GRAIN 4
+
+namespace Skylicht
+{
+	CAnimationSystem::CAnimationSystem()
+	{
+
+	}
+
+	CAnimationSystem::~CAnimationSystem()
+	{
+
+	}
+
+	void CAnimationSystem::registerController(CAnimationController* controller)
+	{
+		m_controllers.push_back(controller);
+	}
+
+	void CAnimationSystem::unRegisterController(CAnimationController* controller)
+	{
+		std::vector<CAnimationController*>::iterator i = std::find(m_controllers.begin(), m_controllers.end(), controller);
+		if (i != m_controllers.end())
+			m_controllers.erase(i);
+	}
+
+	void CAnimationSystem::addLOD(float from, float to, int updateInterval)
+	{
+		SAnimationLOD lod;
+		lod.From = from * from;
+		lod.To = to * to;
+		lod.UpdateInterval = core::max_(updateInterval, 1);
+		m_lods.push_back(lod);
+	}
+
+	void CAnimationSystem::clearLOD()
+	{
+		m_lods.clear();
+	}
+
+	int CAnimationSystem::getUpdateInterval(float distance)
+	{
+		for (SAnimationLOD& lod : m_lods)
+		{
+			if (distance >= lod.From && distance < lod.To)
+				return lod.UpdateInterval;
+		}
+		return 1;
+	}
+
+	void CAnimationSystem::beginQuery(CEntityManager* entityManager)
+	{
+
+	}
+
+	void CAnimationSystem::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
+	{
+
+	}
+
+	void CAnimationSystem::init(CEntityManager* entityManager)
+	{
+
+	}
+
+	void CAnimationSystem::update(CEntityManager* entityManager)
+	{
+		int numController = (int)m_controllers.size();
+		if (numController == 0)
+			return;
+
+		CAnimationController** controllers = m_controllers.data();
+
+		bool useLOD = false;
+		core::vector3df cameraPosition;
+
+		CCamera* camera = entityManager->getCamera();
+		if (camera != NULL && m_lods.size() > 0)
+		{
+			cameraPosition = camera->getGameObject()->getPosition();
+			useLOD = true;
+		}
+
+		auto updateControllers = [&](int from, int to)
+			{
+				for (int i = from; i < to; i++)
+				{
+					CAnimationController* controller = controllers[i];
+
+					if (useLOD && controller->isEnableLOD())
+					{
+						CWorldTransformData* transform = GET_ENTITY_DATA(controller->getGameObject()->getEntity(), CWorldTransformData);
+						const f32* m = transform->World.pointer();
+
+						float x = cameraPosition.X - m[12];
+						float z = cameraPosition.Z - m[14];
+
+						// the index staggers the characters that have the same interval
+						if (!controller->updateLODFrame(getUpdateInterval(x * x + z * z), i))
+							continue;
+					}
+
+					controller->updateSkeletons();
+				}
+			};
+
+		if (numController >= PARALLEL_ANIMATION_COUNT)
+		{
+			// each character writes its own joint transforms
+			System::CJobScheduler::getInstance()->parallelFor(0, numController, PARALLEL_ANIMATION_GRAIN, updateControllers);
+		}
+		else
+		{
+			updateControllers(0, numController);
+		}
+
+		m_controllers.clear();
+	}
+}
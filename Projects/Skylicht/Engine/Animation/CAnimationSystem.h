@@ -0,0 +1,109 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Entity/IEntitySystem.h"
+
+namespace Skylicht
+{
+	class CAnimationController;
+
+	/**
+	 * @brief Animation level of detail, the skeletons far from the camera are sampled at a lower rate.
+	 * @ingroup Animation
+	 */
+	struct SAnimationLOD
+	{
+		//! Squared distance from the camera on XZ plane, the same with CLODData.
+		float From;
+
+		//! Squared distance from the camera on XZ plane, the same with CLODData.
+		float To;
+
+		//! The skeletons are sampled once every UpdateInterval frames.
+		int UpdateInterval;
+	};
+
+	/**
+	 * @brief The system that samples, blends and applies the skeletons of all the animation controllers.
+	 * @ingroup Animation
+	 *
+	 * CAnimationController::updateComponent only updates the timelines on the main thread and registers to this system.
+	 * The system is updated before CWorldTransformSystem, and the characters are evaluated in parallel on the job threads.
+	 *
+	 * Example: Sampling the characters far from the camera at a lower rate
+	 * @code
+	 * CAnimationSystem* animationSystem = entityManager->getSystem<CAnimationSystem>();
+	 * animationSystem->addLOD(20.0f, 50.0f, 2);
+	 * animationSystem->addLOD(50.0f, 1000.0f, 4);
+	 * @endcode
+	 */
+	class SKYLICHT_API CAnimationSystem : public IEntitySystem
+	{
+	protected:
+		std::vector<CAnimationController*> m_controllers;
+
+		std::vector<SAnimationLOD> m_lods;
+
+	public:
+		CAnimationSystem();
+
+		virtual ~CAnimationSystem();
+
+		void registerController(CAnimationController* controller);
+
+		void unRegisterController(CAnimationController* controller);
+
+		/**
+		 * @brief Adds an animation LOD level.
+		 * @param from Distance from the camera in world unit.
+		 * @param to Distance from the camera in world unit.
+		 * @param updateInterval Sample the skeletons once every updateInterval frames.
+		 */
+		void addLOD(float from, float to, int updateInterval);
+
+		void clearLOD();
+
+		/**
+		 * @brief Gets the update interval of a character.
+		 * @param distance Squared distance from the camera on XZ plane.
+		 * @return Number of frames between 2 samples.
+		 */
+		int getUpdateInterval(float distance);
+
+		inline std::vector<SAnimationLOD>& getLODs()
+		{
+			return m_lods;
+		}
+
+		virtual void beginQuery(CEntityManager* entityManager);
+
+		virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity);
+
+		virtual void init(CEntityManager* entityManager);
+
+		virtual void update(CEntityManager* entityManager);
+	};
+}
@@ -24,11 +24,78 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CAnimationTrack.h"
+#include "CCompressedAnimationTrack.h"
 
 namespace Skylicht
 {
+	CAnimationData::CAnimationData(const CAnimationData& data) :
+		Compressed(NULL)
+	{
+		*this = data;
+	}
+
+	CAnimationData::~CAnimationData()
+	{
+		if (Compressed != NULL)
+			delete Compressed;
+	}
+
+	CAnimationData& CAnimationData::operator=(const CAnimationData& data)
+	{
+		if (this == &data)
+			return *this;
+
+		Positions = data.Positions;
+		Rotations = data.Rotations;
+		Scales = data.Scales;
+
+		// the compressed track is owned, copy it
+		if (Compressed != NULL)
+			delete Compressed;
+
+		Compressed = data.Compressed != NULL ? new CCompressedAnimationTrack(*data.Compressed) : NULL;
+		return *this;
+	}
+
+	void CAnimationData::compress(const SAnimationCompressSetting& setting, bool releaseKeys)
+	{
+		// the keys are released on the last compress
+		if (isReleasedKeys())
+			return;
+
+		if (Compressed == NULL)
+			Compressed = new CCompressedAnimationTrack();
+
+		Compressed->compress(this, setting);
+
+		if (releaseKeys)
+		{
+			Positions.Data.clear();
+			Rotations.Data.clear();
+			Scales.Data.clear();
+
+			Positions.clearHint();
+			Rotations.clearHint();
+			Scales.clearHint();
+		}
+	}
+
+	f32 CAnimationData::getLastFrame()
+	{
+		if (Compressed != NULL)
+			return Compressed->getLastFrame();
+
+		f32 lastFrame = Positions.getLastFrame();
+		lastFrame = core::max_(lastFrame, Rotations.getLastFrame());
+		lastFrame = core::max_(lastFrame, Scales.getLastFrame());
+		return lastFrame;
+	}
+
 	CAnimationTrack::CAnimationTrack() :
 		m_data(NULL),
+		m_positionHint(0),
+		m_rotationHint(0),
+		m_scaleHint(0),
 		HaveAnimation(false)
 	{
 	}
@@ -54,6 +121,13 @@ namespace Skylicht
 			return;
 		}
 
+		// O(1) sampling
+		if (data->Compressed != NULL)
+		{
+			data->Compressed->getFrameData(frame, position, scale, rotation);
+			return;
+		}
+
 		s32 foundPositionIndex = -1;
 		s32 foundScaleIndex = -1;
 		s32 foundRotationIndex = -1;
@@ -64,7 +138,7 @@ namespace Skylicht
 
 		if (numPositionKey)
 		{
-			foundPositionIndex = data->Positions.getIndex(frame);
+			foundPositionIndex = data->Positions.getIndex(frame, m_positionHint);
 			CPositionKey* pPositions = data->Positions.pointer();
 
 			// Do interpolation...
@@ -110,7 +184,7 @@ namespace Skylicht
 		u32 numScaleKey = data->Scales.size();
 		if (numScaleKey)
 		{
-			foundScaleIndex = data->Scales.getIndex(frame);
+			foundScaleIndex = data->Scales.getIndex(frame, m_scaleHint);
 			CScaleKey* pScale = data->Scales.pointer();
 
 			// Do interpolation...
@@ -156,7 +230,7 @@ namespace Skylicht
 
 		if (numRotKey)
 		{
-			foundRotationIndex = data->Rotations.getIndex(frame);
+			foundRotationIndex = data->Rotations.getIndex(frame, m_rotationHint);
 			CRotationKey* pRotation = data->Rotations.pointer();
 
 			// Do interpolation...
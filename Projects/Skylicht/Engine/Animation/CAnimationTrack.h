@@ -76,7 +76,19 @@ namespace Skylicht
 		 * @param frame Time in seconds.
 		 * @return Index in the Data array.
 		 */
-		int getIndex(f32 frame);
+		int getIndex(f32 frame)
+		{
+			return getIndex(frame, Hint);
+		}
+
+		/**
+		 * @brief Finds the index of the keyframe with an external search hint.
+		 * The keys can be shared by many tracks, so each track that samples on a job thread keeps its own hint.
+		 * @param frame Time in seconds.
+		 * @param hint [in, out] The search hint.
+		 * @return Index in the Data array.
+		 */
+		int getIndex(f32 frame, int& hint);
 
 		/**
 		 * @brief Gets the number of keyframes.
@@ -110,7 +122,7 @@ namespace Skylicht
 	};
 
 	template<class T>
-	int CArrayKeyFrame<T>::getIndex(f32 frame)
+	int CArrayKeyFrame<T>::getIndex(f32 frame, int& hint)
 	{
 		int foundPositionIndex = -1;
 
@@ -118,37 +130,52 @@ namespace Skylicht
 		CKeyFrameData<T>* pData = Data.pointer();
 
 		// Test the Hints...
-		if (Hint >= 0 && Hint < numKey)
+		if (hint >= 0 && hint < numKey)
 		{
-			if (Hint > 0 && pData[Hint].Frame >= frame && pData[Hint - 1].Frame < frame)
-				foundPositionIndex = Hint;
-			else if (Hint + 1 < numKey)
+			if (hint > 0 && pData[hint].Frame >= frame && pData[hint - 1].Frame < frame)
+				foundPositionIndex = hint;
+			else if (hint + 1 < numKey)
 			{
-				if (pData[Hint + 1].Frame >= frame && pData[Hint + 0].Frame < frame)
+				if (pData[hint + 1].Frame >= frame && pData[hint + 0].Frame < frame)
 				{
-					Hint++;
-					foundPositionIndex = Hint;
+					hint++;
+					foundPositionIndex = hint;
 				}
 			}
 		}
 
-		// The Hint test failed, do a full scan...
+		// The Hint test failed (seek or blend jump), binary search the first key >= frame
 		if (foundPositionIndex == -1)
 		{
-			for (s32 i = 0; i < numKey; ++i)
+			// Keys should to be sorted by frame
+			s32 first = 0;
+			s32 count = numKey;
+			while (count > 0)
 			{
-				if (pData[i].Frame >= frame) // Keys should to be sorted by frame
+				s32 step = count / 2;
+				if (pData[first + step].Frame < frame)
 				{
-					foundPositionIndex = i;
-					Hint = i;
-					break;
+					first += step + 1;
+					count -= step + 1;
 				}
+				else
+					count = step;
+			}
+
+			if (first < numKey)
+			{
+				foundPositionIndex = first;
+				hint = first;
 			}
 		}
 
 		return foundPositionIndex;
 	}
 
+	class CCompressedAnimationTrack;
+
+	struct SAnimationCompressSetting;
+
 	/**
 	 * @brief Container for PRS (Position, Rotation, Scale) animation data.
 	 * @ingroup Animation
@@ -160,9 +187,39 @@ namespace Skylicht
 		CArrayKeyFrame<core::quaternion> Rotations;
 		CArrayKeyFrame<core::vector3df> Scales;
 
-		CAnimationData()
+		//! Compressed keys, the track samples it instead of the arrays when it is not NULL.
+		CCompressedAnimationTrack* Compressed;
+
+		CAnimationData() :
+			Compressed(NULL)
 		{
 		}
+
+		CAnimationData(const CAnimationData& data);
+
+		~CAnimationData();
+
+		CAnimationData& operator=(const CAnimationData& data);
+
+		/**
+		 * @brief Compresses the keys, see CCompressedAnimationTrack.
+		 * @param setting Sample rate and the error bounds.
+		 * @param releaseKeys Free the full precision keys after compress.
+		 */
+		void compress(const SAnimationCompressSetting& setting, bool releaseKeys);
+
+		//! The full precision keys are released, the data is only in the compressed track.
+		inline bool isReleasedKeys()
+		{
+			return Compressed != NULL && Positions.size() == 0 && Rotations.size() == 0 && Scales.size() == 0;
+		}
+
+		/**
+		 * @brief Gets the time of the last key of all channels.
+		 * @return Time in seconds.
+		 */
+		f32 getLastFrame();
+
 	};
 
 	/**
@@ -175,6 +232,11 @@ namespace Skylicht
 		//! Pointer to the shared animation data.
 		CAnimationData* m_data;
 
+		//! Keyframe search hints of this track, the animation data is shared between the skeletons.
+		int m_positionHint;
+		int m_rotationHint;
+		int m_scaleHint;
+
 	public:
 		//! The name of the track.
 		std::string Name;
@@ -219,14 +281,10 @@ namespace Skylicht
 		 */
 		void clearAllKeyFrame()
 		{
-			if (m_data)
-			{
-				m_data->Positions.clearHint();
-				m_data->Rotations.clearHint();
-				m_data->Scales.clearHint();
-			}
-
 			m_data = NULL;
+			m_positionHint = 0;
+			m_rotationHint = 0;
+			m_scaleHint = 0;
 
 			Name = "";
 			HaveAnimation = false;
@@ -239,6 +297,9 @@ namespace Skylicht
 		void setAnimationData(CAnimationData* data)
 		{
 			m_data = data;
+			m_positionHint = 0;
+			m_rotationHint = 0;
+			m_scaleHint = 0;
 		}
 
 		/**
@@ -0,0 +1,616 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CCompressedAnimationTrack.h"
+#include "Utils/CMemoryStream.h"
+
+namespace Skylicht
+{
+	// smallest-three range [-1/sqrt(2), 1/sqrt(2)] in 15 bits
+	static const f32 SmallestThreeRange = 0.70710678f;
+	static const f32 SmallestThreeMax = 32767.0f;
+
+	// the channel doubles the sample rate 3 times at most
+	static const int MaxSampleRateDouble = 3;
+
+	static core::vector3df evalVector(CArrayKeyFrame<core::vector3df>& keys, f32 frame)
+	{
+		CPositionKey* data = keys.pointer();
+
+		int id = keys.getIndex(frame);
+		if (id == 0)
+			return data[0].Value;
+		else if (id == -1)
+			return data[keys.size() - 1].Value;
+
+		const CPositionKey& a = data[id - 1];
+		const CPositionKey& b = data[id];
+		f32 t = (frame - a.Frame) / (b.Frame - a.Frame);
+		return a.Value + (b.Value - a.Value) * t;
+	}
+
+	static core::quaternion evalRotation(CArrayKeyFrame<core::quaternion>& keys, f32 frame)
+	{
+		CRotationKey* data = keys.pointer();
+
+		int id = keys.getIndex(frame);
+		if (id == 0)
+			return data[0].Value;
+		else if (id == -1)
+			return data[keys.size() - 1].Value;
+
+		// the same interpolation with CAnimationTrack::getFrameData
+		const CRotationKey& a = data[id];
+		const CRotationKey& b = data[id - 1];
+		f32 t = (a.Frame - frame) / (a.Frame - b.Frame);
+
+		core::quaternion result;
+		CAnimationTrack::quaternionSlerp(result, a.Value, b.Value, t);
+		return result;
+	}
+
+	static f32 vectorError(const core::vector3df& a, const core::vector3df& b)
+	{
+		return core::max_(fabsf(a.X - b.X), fabsf(a.Y - b.Y), fabsf(a.Z - b.Z));
+	}
+
+	// q and -q are the same rotation
+	static f32 rotationError(const core::quaternion& a, const core::quaternion& b)
+	{
+		f32 e1 = core::max_(core::max_(fabsf(a.X - b.X), fabsf(a.Y - b.Y)), core::max_(fabsf(a.Z - b.Z), fabsf(a.W - b.W)));
+		f32 e2 = core::max_(core::max_(fabsf(a.X + b.X), fabsf(a.Y + b.Y)), core::max_(fabsf(a.Z + b.Z), fabsf(a.W + b.W)));
+		return core::min_(e1, e2);
+	}
+
+	static void nlerp(core::quaternion& result, const core::quaternion& a, core::quaternion b, f32 t)
+	{
+		if (a.dotProduct(b) < 0.0f)
+			b = b * -1.0f;
+
+		result.X = a.X + (b.X - a.X) * t;
+		result.Y = a.Y + (b.Y - a.Y) * t;
+		result.Z = a.Z + (b.Z - a.Z) * t;
+		result.W = a.W + (b.W - a.W) * t;
+		result.normalize();
+	}
+
+	static u16 quantizeSmallestThree(f32 v)
+	{
+		f32 x = (v / SmallestThreeRange + 1.0f) * 0.5f * SmallestThreeMax + 0.5f;
+		return (u16)core::clamp(x, 0.0f, SmallestThreeMax);
+	}
+
+	static f32 dequantizeSmallestThree(u16 v)
+	{
+		return ((f32)v / SmallestThreeMax * 2.0f - 1.0f) * SmallestThreeRange;
+	}
+
+	CCompressedAnimationTrack::CCompressedAnimationTrack() :
+		m_start(0.0f),
+		m_duration(0.0f)
+	{
+	}
+
+	CCompressedAnimationTrack::~CCompressedAnimationTrack()
+	{
+	}
+
+	void CCompressedAnimationTrack::compress(CAnimationData* data, const SAnimationCompressSetting& setting)
+	{
+		m_quantized.clear();
+		m_raw.clear();
+
+		// the range of all channels
+		bool first = true;
+		f32 end = 0.0f;
+		m_start = 0.0f;
+
+		CArrayKeyFrame<core::vector3df>* vectors[] = { &data->Positions, &data->Scales };
+		for (int i = 0; i < 2; i++)
+		{
+			if (vectors[i]->size() > 0)
+			{
+				f32 a = vectors[i]->Data[0].Frame;
+				f32 b = vectors[i]->getLastFrame();
+				m_start = first ? a : core::min_(m_start, a);
+				end = first ? b : core::max_(end, b);
+				first = false;
+			}
+		}
+
+		if (data->Rotations.size() > 0)
+		{
+			f32 a = data->Rotations.Data[0].Frame;
+			f32 b = data->Rotations.getLastFrame();
+			m_start = first ? a : core::min_(m_start, a);
+			end = first ? b : core::max_(end, b);
+		}
+
+		m_duration = end - m_start;
+
+		compressVector(m_position, data->Positions, setting.SampleRate, setting.PositionError);
+		compressRotation(m_rotation, data->Rotations, setting.SampleRate, setting.RotationError);
+		compressVector(m_scale, data->Scales, setting.SampleRate, setting.ScaleError);
+	}
+
+	void CCompressedAnimationTrack::compressVector(SChannel& channel, CArrayKeyFrame<core::vector3df>& keys, f32 rate, f32 maxError)
+	{
+		channel = SChannel();
+
+		u32 numKey = keys.size();
+		if (numKey == 0)
+		{
+			channel.Min = keys.Default;
+			return;
+		}
+
+		CPositionKey* data = keys.pointer();
+
+		// constant track
+		core::aabbox3df range(data[0].Value);
+		for (u32 i = 1; i < numKey; i++)
+			range.addInternalPoint(data[i].Value);
+
+		core::vector3df extent = range.getExtent();
+		if (m_duration <= 0.0f || core::max_(extent.X, extent.Y, extent.Z) * 0.5f <= maxError)
+		{
+			channel.Min = range.getCenter();
+			return;
+		}
+
+		// linear track (2 samples), then the uniform samples
+		u32 numUniform = core::max_(2u, (u32)ceilf(m_duration * rate) + 1);
+		u32 candidates[MaxSampleRateDouble + 2];
+		candidates[0] = 2;
+		candidates[1] = numUniform;
+		for (int i = 2; i < MaxSampleRateDouble + 2; i++)
+			candidates[i] = candidates[i - 1] * 2 - 1;
+
+		// half of the error for the resample, half for the quantization
+		f32 resampleError = maxError * 0.5f;
+
+		core::array<core::vector3df> samples;
+		u32 numSample = 0;
+		bool resampled = false;
+
+		for (int c = 0; c < MaxSampleRateDouble + 2 && !resampled; c++)
+		{
+			numSample = candidates[c];
+			samples.set_used(numSample);
+
+			f32 interval = m_duration / (f32)(numSample - 1);
+			for (u32 i = 0; i < numSample; i++)
+				samples[i] = evalVector(keys, m_start + interval * i);
+
+			// the source and the samples are linear, the max error is at the key
+			f32 error = 0.0f;
+			f32 invInterval = (f32)(numSample - 1) / m_duration;
+			for (u32 i = 0; i < numKey && error <= resampleError; i++)
+			{
+				f32 x = core::clamp((data[i].Frame - m_start) * invInterval, 0.0f, (f32)(numSample - 1));
+				u32 id = core::min_((u32)x, numSample - 2);
+				f32 t = x - (f32)id;
+
+				core::vector3df v = samples[id] + (samples[id + 1] - samples[id]) * t;
+				error = core::max_(error, vectorError(v, data[i].Value));
+			}
+
+			resampled = error <= resampleError;
+		}
+
+		if (!resampled)
+		{
+			// the uniform samples can not reach the error bound, keep the source keys
+			channel.Mode = Key;
+			channel.NumSample = numKey;
+			channel.Offset = m_raw.size();
+			for (u32 i = 0; i < numKey; i++)
+				m_raw.push_back(data[i].Frame);
+			for (u32 i = 0; i < numKey; i++)
+			{
+				m_raw.push_back(data[i].Value.X);
+				m_raw.push_back(data[i].Value.Y);
+				m_raw.push_back(data[i].Value.Z);
+			}
+			return;
+		}
+
+		channel.NumSample = numSample;
+		channel.InvInterval = (f32)(numSample - 1) / m_duration;
+
+		range.reset(samples[0]);
+		for (u32 i = 1; i < numSample; i++)
+			range.addInternalPoint(samples[i]);
+
+		extent = range.getExtent();
+		channel.Min = range.MinEdge;
+		channel.Scale = extent / 65535.0f;
+
+		f32 quantizeError = core::max_(channel.Scale.X, channel.Scale.Y, channel.Scale.Z) * 0.5f;
+		if (quantizeError > maxError * 0.5f)
+		{
+			// keep the full precision
+			channel.Mode = Raw;
+			channel.Offset = m_raw.size();
+			for (u32 i = 0; i < numSample; i++)
+			{
+				m_raw.push_back(samples[i].X);
+				m_raw.push_back(samples[i].Y);
+				m_raw.push_back(samples[i].Z);
+			}
+			return;
+		}
+
+		channel.Mode = Quantized;
+		channel.Offset = m_quantized.size();
+
+		for (u32 i = 0; i < numSample; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				f32 scale = (&channel.Scale.X)[j];
+				f32 v = scale > 0.0f ? ((&samples[i].X)[j] - (&channel.Min.X)[j]) / scale + 0.5f : 0.0f;
+				m_quantized.push_back((u16)core::clamp(v, 0.0f, 65535.0f));
+			}
+		}
+	}
+
+	void CCompressedAnimationTrack::compressRotation(SChannel& channel, CArrayKeyFrame<core::quaternion>& keys, f32 rate, f32 maxError)
+	{
+		channel = SChannel();
+
+		u32 numKey = keys.size();
+		CRotationKey* data = keys.pointer();
+
+		// constant track
+		bool constant = true;
+		for (u32 i = 1; i < numKey && constant; i++)
+		{
+			if (rotationError(data[i].Value, data[0].Value) > maxError)
+				constant = false;
+		}
+
+		if (numKey == 0 || m_duration <= 0.0f || constant)
+		{
+			core::quaternion q = numKey == 0 ? keys.Default : data[0].Value;
+
+			channel.Offset = m_raw.size();
+			m_raw.push_back(q.X);
+			m_raw.push_back(q.Y);
+			m_raw.push_back(q.Z);
+			m_raw.push_back(q.W);
+			return;
+		}
+
+		u32 numUniform = core::max_(2u, (u32)ceilf(m_duration * rate) + 1);
+		u32 candidates[MaxSampleRateDouble + 2];
+		candidates[0] = 2;
+		candidates[1] = numUniform;
+		for (int i = 2; i < MaxSampleRateDouble + 2; i++)
+			candidates[i] = candidates[i - 1] * 2 - 1;
+
+		f32 resampleError = maxError * 0.5f;
+
+		core::array<core::quaternion> samples;
+		u32 numSample = 0;
+		bool resampled = false;
+
+		for (int c = 0; c < MaxSampleRateDouble + 2 && !resampled; c++)
+		{
+			numSample = candidates[c];
+			samples.set_used(numSample);
+
+			f32 interval = m_duration / (f32)(numSample - 1);
+			for (u32 i = 0; i < numSample; i++)
+			{
+				core::quaternion q = evalRotation(keys, m_start + interval * i);
+				q.normalize();
+
+				// keep the samples on the same hemisphere
+				if (i > 0 && samples[i - 1].dotProduct(q) < 0.0f)
+					q = q * -1.0f;
+
+				samples[i] = q;
+			}
+
+			f32 error = 0.0f;
+			f32 invInterval = (f32)(numSample - 1) / m_duration;
+			for (u32 i = 0; i < numKey && error <= resampleError; i++)
+			{
+				f32 x = core::clamp((data[i].Frame - m_start) * invInterval, 0.0f, (f32)(numSample - 1));
+				u32 id = core::min_((u32)x, numSample - 2);
+
+				core::quaternion q;
+				nlerp(q, samples[id], samples[id + 1], x - (f32)id);
+
+				core::quaternion key = data[i].Value;
+				key.normalize();
+				error = core::max_(error, rotationError(q, key));
+			}
+
+			resampled = error <= resampleError;
+		}
+
+		if (!resampled)
+		{
+			// the uniform samples can not reach the error bound, keep the source keys
+			channel.Mode = Key;
+			channel.NumSample = numKey;
+			channel.Offset = m_raw.size();
+			for (u32 i = 0; i < numKey; i++)
+				m_raw.push_back(data[i].Frame);
+			for (u32 i = 0; i < numKey; i++)
+			{
+				m_raw.push_back(data[i].Value.X);
+				m_raw.push_back(data[i].Value.Y);
+				m_raw.push_back(data[i].Value.Z);
+				m_raw.push_back(data[i].Value.W);
+			}
+			return;
+		}
+
+		channel.NumSample = numSample;
+		channel.InvInterval = (f32)(numSample - 1) / m_duration;
+
+		// smallest-three error is about 1 / 32767
+		if (maxError * 0.5f < 1.0f / SmallestThreeMax)
+		{
+			channel.Mode = Raw;
+			channel.Offset = m_raw.size();
+			for (u32 i = 0; i < numSample; i++)
+			{
+				m_raw.push_back(samples[i].X);
+				m_raw.push_back(samples[i].Y);
+				m_raw.push_back(samples[i].Z);
+				m_raw.push_back(samples[i].W);
+			}
+			return;
+		}
+
+		channel.Mode = Quantized;
+		channel.Offset = m_quantized.size();
+
+		for (u32 i = 0; i < numSample; i++)
+		{
+			core::quaternion q = samples[i];
+			f32* c = &q.X;
+
+			// drop the largest component, it is positive and restored from the unit length
+			int largest = 0;
+			for (int j = 1; j < 4; j++)
+			{
+				if (fabsf(c[j]) > fabsf(c[largest]))
+					largest = j;
+			}
+
+			if (c[largest] < 0.0f)
+				q = q * -1.0f;
+
+			u16 v[3];
+			int n = 0;
+			for (int j = 0; j < 4; j++)
+			{
+				if (j != largest)
+					v[n++] = quantizeSmallestThree(c[j]);
+			}
+
+			// the index of the largest is stored at the high bit of 2 first values
+			m_quantized.push_back(v[0] | (u16)((largest >> 1) << 15));
+			m_quantized.push_back(v[1] | (u16)((largest & 1) << 15));
+			m_quantized.push_back(v[2]);
+		}
+	}
+
+	void CCompressedAnimationTrack::decodeVector(const SChannel& channel, u32 id, core::vector3df& result)
+	{
+		if (channel.Mode == Quantized)
+		{
+			const u16* p = m_quantized.const_pointer() + channel.Offset + id * 3;
+			result.X = channel.Min.X + p[0] * channel.Scale.X;
+			result.Y = channel.Min.Y + p[1] * channel.Scale.Y;
+			result.Z = channel.Min.Z + p[2] * channel.Scale.Z;
+		}
+		else
+		{
+			// the values of Key channel are after the frames
+			u32 offset = channel.Mode == Key ? channel.Offset + channel.NumSample : channel.Offset;
+			const f32* p = m_raw.const_pointer() + offset + id * 3;
+			result.set(p[0], p[1], p[2]);
+		}
+	}
+
+	void CCompressedAnimationTrack::decodeRotation(const SChannel& channel, u32 id, core::quaternion& result)
+	{
+		if (channel.Mode == Quantized)
+		{
+			const u16* p = m_quantized.const_pointer() + channel.Offset + id * 3;
+			int largest = ((p[0] >> 15) << 1) | (p[1] >> 15);
+
+			f32 v[3];
+			v[0] = dequantizeSmallestThree(p[0] & 0x7fff);
+			v[1] = dequantizeSmallestThree(p[1] & 0x7fff);
+			v[2] = dequantizeSmallestThree(p[2] & 0x7fff);
+
+			f32* c = &result.X;
+			int n = 0;
+			for (int j = 0; j < 4; j++)
+			{
+				if (j != largest)
+					c[j] = v[n++];
+			}
+
+			c[largest] = sqrtf(core::max_(0.0f, 1.0f - v[0] * v[0] - v[1] * v[1] - v[2] * v[2]));
+		}
+		else
+		{
+			u32 offset = channel.Mode == Key ? channel.Offset + channel.NumSample : channel.Offset;
+			const f32* p = m_raw.const_pointer() + offset + id * 4;
+			result.set(p[0], p[1], p[2], p[3]);
+		}
+	}
+
+	void CCompressedAnimationTrack::getKey(const SChannel& channel, f32 frame, u32& id, f32& t)
+	{
+		const f32* frames = m_raw.const_pointer() + channel.Offset;
+		u32 last = channel.NumSample - 1;
+
+		if (frame <= frames[0])
+		{
+			id = 0;
+			t = 0.0f;
+		}
+		else if (frame >= frames[last])
+		{
+			id = last - 1;
+			t = 1.0f;
+		}
+		else
+		{
+			// the first key after the frame
+			u32 next = (u32)(std::upper_bound(frames, frames + channel.NumSample, frame) - frames);
+			id = next - 1;
+			t = (frame - frames[id]) / (frames[next] - frames[id]);
+		}
+	}
+
+	void CCompressedAnimationTrack::getVector(const SChannel& channel, f32 frame, core::vector3df& result)
+	{
+		if (channel.Mode == Constant)
+		{
+			result = channel.Min;
+			return;
+		}
+
+		u32 id;
+		f32 t;
+		if (channel.Mode == Key)
+			getKey(channel, frame, id, t);
+		else
+			getSample(channel, frame, id, t);
+
+		core::vector3df a, b;
+		decodeVector(channel, id, a);
+		decodeVector(channel, id + 1, b);
+
+		result = a + (b - a) * t;
+	}
+
+	void CCompressedAnimationTrack::getRotation(const SChannel& channel, f32 frame, core::quaternion& result)
+	{
+		if (channel.Mode == Constant)
+		{
+			const f32* p = m_raw.const_pointer() + channel.Offset;
+			result.set(p[0], p[1], p[2], p[3]);
+			return;
+		}
+
+		u32 id;
+		f32 t;
+
+		core::quaternion a, b;
+
+		if (channel.Mode == Key)
+		{
+			getKey(channel, frame, id, t);
+			decodeRotation(channel, id, a);
+			decodeRotation(channel, id + 1, b);
+
+			// the same interpolation with CAnimationTrack::getFrameData
+			CAnimationTrack::quaternionSlerp(result, b, a, 1.0f - t);
+			return;
+		}
+
+		getSample(channel, frame, id, t);
+		decodeRotation(channel, id, a);
+		decodeRotation(channel, id + 1, b);
+
+		nlerp(result, a, b, t);
+	}
+
+	void CCompressedAnimationTrack::getFrameData(f32 frame,
+		core::vector3df& position,
+		core::vector3df& scale,
+		core::quaternion& rotation)
+	{
+		getVector(m_position, frame, position);
+		getVector(m_scale, frame, scale);
+		getRotation(m_rotation, frame, rotation);
+	}
+
+	u32 CCompressedAnimationTrack::getMemorySize()
+	{
+		return sizeof(CCompressedAnimationTrack) + m_quantized.size() * sizeof(u16) + m_raw.size() * sizeof(f32);
+	}
+
+	void CCompressedAnimationTrack::serializable(CMemoryStream* stream)
+	{
+		stream->writeFloat(m_start);
+		stream->writeFloat(m_duration);
+
+		SChannel* channels[] = { &m_position, &m_rotation, &m_scale };
+		for (int i = 0; i < 3; i++)
+		{
+			SChannel* c = channels[i];
+			stream->writeUInt(c->Mode);
+			stream->writeUInt(c->NumSample);
+			stream->writeUInt(c->Offset);
+			stream->writeFloat(c->InvInterval);
+			stream->writeFloatArray(&c->Min.X, 3);
+			stream->writeFloatArray(&c->Scale.X, 3);
+		}
+
+		stream->writeUInt(m_quantized.size());
+		stream->writeData(m_quantized.const_pointer(), m_quantized.size() * sizeof(u16));
+
+		stream->writeUInt(m_raw.size());
+		stream->writeFloatArray(m_raw.const_pointer(), (int)m_raw.size());
+	}
+
+	void CCompressedAnimationTrack::deserializable(CMemoryStream* stream)
+	{
+		m_start = stream->readFloat();
+		m_duration = stream->readFloat();
+
+		SChannel* channels[] = { &m_position, &m_rotation, &m_scale };
+		for (int i = 0; i < 3; i++)
+		{
+			SChannel* c = channels[i];
+			c->Mode = stream->readUInt();
+			c->NumSample = stream->readUInt();
+			c->Offset = stream->readUInt();
+			c->InvInterval = stream->readFloat();
+			stream->readFloatArray(&c->Min.X, 3);
+			stream->readFloatArray(&c->Scale.X, 3);
+		}
+
+		u32 count = stream->readUInt();
+		m_quantized.set_used(count);
+		stream->readData(m_quantized.pointer(), count * sizeof(u16));
+
+		count = stream->readUInt();
+		m_raw.set_used(count);
+		stream->readFloatArray(m_raw.pointer(), (int)count);
+	}
+}
@@ -0,0 +1,206 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CAnimationTrack.h"
+
+namespace Skylicht
+{
+	class CMemoryStream;
+
+	/**
+	 * @brief Settings of the animation compression.
+	 * @ingroup Animation
+	 */
+	struct SKYLICHT_API SAnimationCompressSetting
+	{
+		//! Uniform samples per second, it is doubled on the track that exceeds the error (3 times at most).
+		f32 SampleRate;
+
+		//! Max error of the position (unit).
+		f32 PositionError;
+
+		//! Max error of a quaternion component.
+		f32 RotationError;
+
+		//! Max error of the scale.
+		f32 ScaleError;
+
+		SAnimationCompressSetting() :
+			SampleRate(30.0f),
+			PositionError(0.001f),
+			RotationError(0.0005f),
+			ScaleError(0.001f)
+		{
+		}
+	};
+
+	/**
+	 * @brief Uniformly sampled and quantized PRS track, sampling is O(1) per frame.
+	 * @ingroup Animation
+	 *
+	 * Each channel is pruned to a constant, a linear (2 samples) or a uniform track.
+	 * Positions and scales are range-reduced to 16 bits per component,
+	 * rotations are quantized with the smallest-three (3 x 16 bits).
+	 * A channel keeps the full float samples if the quantization exceeds the error bound,
+	 * and keeps the source keys if the uniform samples still exceed it at the max sample rate.
+	 */
+	class SKYLICHT_API CCompressedAnimationTrack
+	{
+	public:
+		enum EChannelMode
+		{
+			Constant = 0,
+			Quantized,
+			Raw,
+			Key
+		};
+
+		struct SChannel
+		{
+			u32 Mode;
+			u32 NumSample;
+
+			// offset in m_quantized (Quantized) or m_raw (Raw, Key, Constant rotation)
+			// the Key channel stores the frames of all keys, then the values
+			u32 Offset;
+
+			// (NumSample - 1) / duration
+			f32 InvInterval;
+
+			// the constant value, or the range of the quantized samples
+			core::vector3df Min;
+			core::vector3df Scale;
+
+			SChannel() :
+				Mode(Constant),
+				NumSample(1),
+				Offset(0),
+				InvInterval(0.0f)
+			{
+			}
+		};
+
+	protected:
+		f32 m_start;
+		f32 m_duration;
+
+		SChannel m_position;
+		SChannel m_rotation;
+		SChannel m_scale;
+
+		core::array<u16> m_quantized;
+		core::array<f32> m_raw;
+
+	public:
+		CCompressedAnimationTrack();
+
+		virtual ~CCompressedAnimationTrack();
+
+		/**
+		 * @brief Compresses the keys of an animation data.
+		 * @param data Source keys, the keys must be sorted by frame.
+		 * @param setting Sample rate and the error bounds.
+		 */
+		void compress(CAnimationData* data, const SAnimationCompressSetting& setting);
+
+		/**
+		 * @brief Samples the track, the frame is clamped to the track range.
+		 * @param frame Time in seconds.
+		 */
+		void getFrameData(f32 frame,
+			core::vector3df& position,
+			core::vector3df& scale,
+			core::quaternion& rotation);
+
+		inline f32 getLastFrame()
+		{
+			return m_start + m_duration;
+		}
+
+		inline const SChannel& getPositionChannel()
+		{
+			return m_position;
+		}
+
+		inline const SChannel& getRotationChannel()
+		{
+			return m_rotation;
+		}
+
+		inline const SChannel& getScaleChannel()
+		{
+			return m_scale;
+		}
+
+		/**
+		 * @brief Gets the memory of the samples.
+		 * @return Size in bytes.
+		 */
+		u32 getMemorySize();
+
+		void serializable(CMemoryStream* stream);
+
+		void deserializable(CMemoryStream* stream);
+
+	protected:
+
+		void compressVector(SChannel& channel, CArrayKeyFrame<core::vector3df>& keys, f32 rate, f32 maxError);
+
+		void compressRotation(SChannel& channel, CArrayKeyFrame<core::quaternion>& keys, f32 rate, f32 maxError);
+
+		inline void getSample(const SChannel& channel, f32 frame, u32& id, f32& t)
+		{
+			f32 x = (frame - m_start) * channel.InvInterval;
+			f32 last = (f32)(channel.NumSample - 1);
+
+			if (x <= 0.0f)
+			{
+				id = 0;
+				t = 0.0f;
+			}
+			else if (x >= last)
+			{
+				id = channel.NumSample - 2;
+				t = 1.0f;
+			}
+			else
+			{
+				id = (u32)x;
+				t = x - (f32)id;
+			}
+		}
+
+		void getKey(const SChannel& channel, f32 frame, u32& id, f32& t);
+
+		void getVector(const SChannel& channel, f32 frame, core::vector3df& result);
+
+		void getRotation(const SChannel& channel, f32 frame, core::quaternion& result);
+
+		void decodeVector(const SChannel& channel, u32 id, core::vector3df& result);
+
+		void decodeRotation(const SChannel& channel, u32 id, core::quaternion& result);
+	};
+}
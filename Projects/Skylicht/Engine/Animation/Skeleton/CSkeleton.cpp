@@ -212,9 +212,7 @@ namespace Skylicht
 				track.setAnimationData(&anim->Data);
 
 				// get anim duration
-				float totalFrame = anim->Data.Positions.getLastFrame();
-				totalFrame = core::max_(totalFrame, anim->Data.Rotations.getLastFrame());
-				totalFrame = core::max_(totalFrame, anim->Data.Scales.getLastFrame());
+				float totalFrame = anim->Data.getLastFrame();
 
 				if (m_timeline.Duration < totalFrame)
 					m_timeline.Duration = totalFrame;
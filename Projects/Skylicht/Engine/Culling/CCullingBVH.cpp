@@ -0,0 +1,616 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CCullingBVH.h"
+#include "Utils/SIMD.h"
+
+// reference: Box2D b2DynamicTree (Erin Catto)
+// https://github.com/erincatto/box2d
+
+namespace Skylicht
+{
+	static inline float getSurfaceArea(const core::aabbox3df& box)
+	{
+		core::vector3df e = box.MaxEdge - box.MinEdge;
+		return 2.0f * (e.X * e.Y + e.Y * e.Z + e.Z * e.X);
+	}
+
+	static inline void mergeBox(core::aabbox3df& out, const core::aabbox3df& a, const core::aabbox3df& b)
+	{
+		out.MinEdge.X = core::min_(a.MinEdge.X, b.MinEdge.X);
+		out.MinEdge.Y = core::min_(a.MinEdge.Y, b.MinEdge.Y);
+		out.MinEdge.Z = core::min_(a.MinEdge.Z, b.MinEdge.Z);
+		out.MaxEdge.X = core::max_(a.MaxEdge.X, b.MaxEdge.X);
+		out.MaxEdge.Y = core::max_(a.MaxEdge.Y, b.MaxEdge.Y);
+		out.MaxEdge.Z = core::max_(a.MaxEdge.Z, b.MaxEdge.Z);
+	}
+
+	// planes of frustum in SoA form, 6 planes are padded to 8
+	struct SFrustumPlanes
+	{
+		f32 NX[8];
+		f32 NY[8];
+		f32 NZ[8];
+		f32 D[8];
+		f32 AX[8];
+		f32 AY[8];
+		f32 AZ[8];
+
+		SFrustumPlanes(const SViewFrustum& frustum)
+		{
+			for (int i = 0; i < 8; i++)
+			{
+				const core::plane3df& p = frustum.planes[i < SViewFrustum::VF_PLANE_COUNT ? i : 0];
+				NX[i] = p.Normal.X;
+				NY[i] = p.Normal.Y;
+				NZ[i] = p.Normal.Z;
+				D[i] = p.D;
+				AX[i] = fabsf(p.Normal.X);
+				AY[i] = fabsf(p.Normal.Y);
+				AZ[i] = fabsf(p.Normal.Z);
+			}
+		}
+
+		// the frustum planes normal point outside
+		// return 0: outside, 1: intersect, 2: inside
+		inline int classifyBox(const core::aabbox3df& box) const
+		{
+			f32 cx = (box.MinEdge.X + box.MaxEdge.X) * 0.5f;
+			f32 cy = (box.MinEdge.Y + box.MaxEdge.Y) * 0.5f;
+			f32 cz = (box.MinEdge.Z + box.MaxEdge.Z) * 0.5f;
+			f32 ex = (box.MaxEdge.X - box.MinEdge.X) * 0.5f;
+			f32 ey = (box.MaxEdge.Y - box.MinEdge.Y) * 0.5f;
+			f32 ez = (box.MaxEdge.Z - box.MinEdge.Z) * 0.5f;
+
+#if defined(SKYLICHT_SIMD_SSE)
+			__m128 vcx = _mm_set1_ps(cx);
+			__m128 vcy = _mm_set1_ps(cy);
+			__m128 vcz = _mm_set1_ps(cz);
+			__m128 vex = _mm_set1_ps(ex);
+			__m128 vey = _mm_set1_ps(ey);
+			__m128 vez = _mm_set1_ps(ez);
+			__m128 rounding = _mm_set1_ps(core::ROUNDING_ERROR_f32);
+
+			int outside = 0;
+			int inside = 0;
+
+			for (int i = 0; i < 8; i += 4)
+			{
+				__m128 dist = _mm_add_ps(_mm_loadu_ps(D + i), _mm_mul_ps(_mm_loadu_ps(NX + i), vcx));
+				dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(NY + i), vcy));
+				dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(NZ + i), vcz));
+
+				__m128 radius = _mm_mul_ps(_mm_loadu_ps(AX + i), vex);
+				radius = _mm_add_ps(radius, _mm_mul_ps(_mm_loadu_ps(AY + i), vey));
+				radius = _mm_add_ps(radius, _mm_mul_ps(_mm_loadu_ps(AZ + i), vez));
+
+				outside |= _mm_movemask_ps(_mm_cmpgt_ps(_mm_sub_ps(dist, radius), rounding));
+				inside |= _mm_movemask_ps(_mm_cmpge_ps(_mm_add_ps(dist, radius), rounding));
+			}
+
+			if (outside)
+				return 0;
+			return inside ? 1 : 2;
+#else
+			bool intersect = false;
+			for (int i = 0; i < SViewFrustum::VF_PLANE_COUNT; i++)
+			{
+				f32 dist = NX[i] * cx + NY[i] * cy + NZ[i] * cz + D[i];
+				f32 radius = AX[i] * ex + AY[i] * ey + AZ[i] * ez;
+
+				if (dist - radius > core::ROUNDING_ERROR_f32)
+					return 0;
+
+				if (dist + radius >= core::ROUNDING_ERROR_f32)
+					intersect = true;
+			}
+			return intersect ? 1 : 2;
+#endif
+		}
+	};
+
+	CCullingBVH::CCullingBVH() :
+		m_root(-1),
+		m_freeList(-1),
+		m_leafCount(0),
+		m_margin(0.1f)
+	{
+
+	}
+
+	CCullingBVH::~CCullingBVH()
+	{
+
+	}
+
+	void CCullingBVH::clear()
+	{
+		m_nodes.set_used(0);
+		m_root = -1;
+		m_freeList = -1;
+		m_leafCount = 0;
+	}
+
+	int CCullingBVH::allocateNode()
+	{
+		int id;
+		if (m_freeList == -1)
+		{
+			id = (int)m_nodes.size();
+			m_nodes.push_back(SNode());
+		}
+		else
+		{
+			id = m_freeList;
+			m_freeList = m_nodes[id].Parent;
+		}
+
+		SNode& node = m_nodes[id];
+		node.Entity = NULL;
+		node.Parent = -1;
+		node.Child1 = -1;
+		node.Child2 = -1;
+		node.Height = 0;
+		return id;
+	}
+
+	void CCullingBVH::freeNode(int id)
+	{
+		SNode& node = m_nodes[id];
+		node.Entity = NULL;
+		node.Parent = m_freeList;
+		node.Height = -1;
+		m_freeList = id;
+	}
+
+	int CCullingBVH::createProxy(const core::aabbox3df& box, CEntity* entity)
+	{
+		int id = allocateNode();
+
+		core::vector3df margin = box.getExtent() * m_margin + core::vector3df(0.01f, 0.01f, 0.01f);
+
+		SNode& node = m_nodes[id];
+		node.Box.MinEdge = box.MinEdge - margin;
+		node.Box.MaxEdge = box.MaxEdge + margin;
+		node.Entity = entity;
+
+		insertLeaf(id);
+		m_leafCount++;
+		return id;
+	}
+
+	void CCullingBVH::destroyProxy(int proxy)
+	{
+		removeLeaf(proxy);
+		freeNode(proxy);
+		m_leafCount--;
+	}
+
+	bool CCullingBVH::moveProxy(int proxy, const core::aabbox3df& box)
+	{
+		SNode& node = m_nodes[proxy];
+		if (box.isFullInside(node.Box))
+			return false;
+
+		removeLeaf(proxy);
+
+		core::vector3df margin = box.getExtent() * m_margin + core::vector3df(0.01f, 0.01f, 0.01f);
+		node.Box.MinEdge = box.MinEdge - margin;
+		node.Box.MaxEdge = box.MaxEdge + margin;
+
+		insertLeaf(proxy);
+		return true;
+	}
+
+	void CCullingBVH::insertLeaf(int leaf)
+	{
+		if (m_root == -1)
+		{
+			m_root = leaf;
+			m_nodes[leaf].Parent = -1;
+			return;
+		}
+
+		// find the best sibling
+		core::aabbox3df leafBox = m_nodes[leaf].Box;
+		core::aabbox3df combined;
+
+		int index = m_root;
+		while (!m_nodes[index].isLeaf())
+		{
+			const SNode& node = m_nodes[index];
+			int child1 = node.Child1;
+			int child2 = node.Child2;
+
+			float area = getSurfaceArea(node.Box);
+
+			mergeBox(combined, node.Box, leafBox);
+			float combinedArea = getSurfaceArea(combined);
+
+			// cost of creating a new parent for this node and the new leaf
+			float cost = 2.0f * combinedArea;
+
+			// minimum cost of pushing the leaf further down the tree
+			float inheritanceCost = 2.0f * (combinedArea - area);
+
+			mergeBox(combined, m_nodes[child1].Box, leafBox);
+			float cost1 = getSurfaceArea(combined) + inheritanceCost;
+			if (!m_nodes[child1].isLeaf())
+				cost1 -= getSurfaceArea(m_nodes[child1].Box);
+
+			mergeBox(combined, m_nodes[child2].Box, leafBox);
+			float cost2 = getSurfaceArea(combined) + inheritanceCost;
+			if (!m_nodes[child2].isLeaf())
+				cost2 -= getSurfaceArea(m_nodes[child2].Box);
+
+			if (cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? child1 : child2;
+		}
+
+		int sibling = index;
+
+		// create a new parent
+		int oldParent = m_nodes[sibling].Parent;
+		int newParent = allocateNode();
+
+		SNode& parent = m_nodes[newParent];
+		parent.Parent = oldParent;
+		mergeBox(parent.Box, leafBox, m_nodes[sibling].Box);
+		parent.Height = m_nodes[sibling].Height + 1;
+		parent.Child1 = sibling;
+		parent.Child2 = leaf;
+
+		if (oldParent != -1)
+		{
+			if (m_nodes[oldParent].Child1 == sibling)
+				m_nodes[oldParent].Child1 = newParent;
+			else
+				m_nodes[oldParent].Child2 = newParent;
+		}
+		else
+		{
+			m_root = newParent;
+		}
+
+		m_nodes[sibling].Parent = newParent;
+		m_nodes[leaf].Parent = newParent;
+
+		// walk back up the tree fixing heights and boxes
+		index = m_nodes[leaf].Parent;
+		while (index != -1)
+		{
+			index = balance(index);
+
+			SNode& node = m_nodes[index];
+			const SNode& child1 = m_nodes[node.Child1];
+			const SNode& child2 = m_nodes[node.Child2];
+
+			node.Height = 1 + core::max_(child1.Height, child2.Height);
+			mergeBox(node.Box, child1.Box, child2.Box);
+
+			index = node.Parent;
+		}
+	}
+
+	void CCullingBVH::removeLeaf(int leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = -1;
+			return;
+		}
+
+		int parent = m_nodes[leaf].Parent;
+		int grandParent = m_nodes[parent].Parent;
+		int sibling = m_nodes[parent].Child1 == leaf ? m_nodes[parent].Child2 : m_nodes[parent].Child1;
+
+		if (grandParent != -1)
+		{
+			// destroy parent and connect sibling to grand parent
+			if (m_nodes[grandParent].Child1 == parent)
+				m_nodes[grandParent].Child1 = sibling;
+			else
+				m_nodes[grandParent].Child2 = sibling;
+
+			m_nodes[sibling].Parent = grandParent;
+			freeNode(parent);
+
+			// adjust ancestor bounds
+			int index = grandParent;
+			while (index != -1)
+			{
+				index = balance(index);
+
+				SNode& node = m_nodes[index];
+				const SNode& child1 = m_nodes[node.Child1];
+				const SNode& child2 = m_nodes[node.Child2];
+
+				mergeBox(node.Box, child1.Box, child2.Box);
+				node.Height = 1 + core::max_(child1.Height, child2.Height);
+
+				index = node.Parent;
+			}
+		}
+		else
+		{
+			m_root = sibling;
+			m_nodes[sibling].Parent = -1;
+			freeNode(parent);
+		}
+	}
+
+	int CCullingBVH::balance(int iA)
+	{
+		SNode& A = m_nodes[iA];
+		if (A.isLeaf() || A.Height < 2)
+			return iA;
+
+		int iB = A.Child1;
+		int iC = A.Child2;
+		SNode& B = m_nodes[iB];
+		SNode& C = m_nodes[iC];
+
+		int diff = C.Height - B.Height;
+
+		// rotate C up
+		if (diff > 1)
+		{
+			int iF = C.Child1;
+			int iG = C.Child2;
+			SNode& F = m_nodes[iF];
+			SNode& G = m_nodes[iG];
+
+			// swap A and C
+			C.Child1 = iA;
+			C.Parent = A.Parent;
+			A.Parent = iC;
+
+			// A's old parent should point to C
+			if (C.Parent != -1)
+			{
+				if (m_nodes[C.Parent].Child1 == iA)
+					m_nodes[C.Parent].Child1 = iC;
+				else
+					m_nodes[C.Parent].Child2 = iC;
+			}
+			else
+			{
+				m_root = iC;
+			}
+
+			// rotate
+			if (F.Height > G.Height)
+			{
+				C.Child2 = iF;
+				A.Child2 = iG;
+				G.Parent = iA;
+				mergeBox(A.Box, B.Box, G.Box);
+				mergeBox(C.Box, A.Box, F.Box);
+
+				A.Height = 1 + core::max_(B.Height, G.Height);
+				C.Height = 1 + core::max_(A.Height, F.Height);
+			}
+			else
+			{
+				C.Child2 = iG;
+				A.Child2 = iF;
+				F.Parent = iA;
+				mergeBox(A.Box, B.Box, F.Box);
+				mergeBox(C.Box, A.Box, G.Box);
+
+				A.Height = 1 + core::max_(B.Height, F.Height);
+				C.Height = 1 + core::max_(A.Height, G.Height);
+			}
+
+			return iC;
+		}
+
+		// rotate B up
+		if (diff < -1)
+		{
+			int iD = B.Child1;
+			int iE = B.Child2;
+			SNode& D = m_nodes[iD];
+			SNode& E = m_nodes[iE];
+
+			// swap A and B
+			B.Child1 = iA;
+			B.Parent = A.Parent;
+			A.Parent = iB;
+
+			// A's old parent should point to B
+			if (B.Parent != -1)
+			{
+				if (m_nodes[B.Parent].Child1 == iA)
+					m_nodes[B.Parent].Child1 = iB;
+				else
+					m_nodes[B.Parent].Child2 = iB;
+			}
+			else
+			{
+				m_root = iB;
+			}
+
+			// rotate
+			if (D.Height > E.Height)
+			{
+				B.Child2 = iD;
+				A.Child1 = iE;
+				E.Parent = iA;
+				mergeBox(A.Box, C.Box, E.Box);
+				mergeBox(B.Box, A.Box, D.Box);
+
+				A.Height = 1 + core::max_(C.Height, E.Height);
+				B.Height = 1 + core::max_(A.Height, D.Height);
+			}
+			else
+			{
+				B.Child2 = iE;
+				A.Child1 = iD;
+				D.Parent = iA;
+				mergeBox(A.Box, C.Box, D.Box);
+				mergeBox(B.Box, A.Box, E.Box);
+
+				A.Height = 1 + core::max_(C.Height, D.Height);
+				B.Height = 1 + core::max_(A.Height, E.Height);
+			}
+
+			return iB;
+		}
+
+		return iA;
+	}
+
+	void CCullingBVH::collectLeaves(int node, CFastArray<CEntity*>& result)
+	{
+		const SNode& n = m_nodes[node];
+		if (n.isLeaf())
+		{
+			result.push(n.Entity);
+			return;
+		}
+
+		collectLeaves(n.Child1, result);
+		collectLeaves(n.Child2, result);
+	}
+
+	void CCullingBVH::queryFrustum(const SViewFrustum& frustum, CFastArray<CEntity*>& result)
+	{
+		if (m_root == -1)
+			return;
+
+		SFrustumPlanes planes(frustum);
+
+		m_stack.set_used(0);
+		m_stack.push_back(m_root);
+
+		while (m_stack.size() > 0)
+		{
+			int id = m_stack.getLast();
+			m_stack.erase(m_stack.size() - 1);
+
+			const SNode& node = m_nodes[id];
+
+			int test = planes.classifyBox(node.Box);
+			if (test == 0)
+				continue;
+
+			if (test == 2 || node.isLeaf())
+			{
+				// all the boxes in this node are visible
+				collectLeaves(id, result);
+			}
+			else
+			{
+				m_stack.push_back(node.Child1);
+				m_stack.push_back(node.Child2);
+			}
+		}
+	}
+
+	void CCullingBVH::queryBox(const core::aabbox3df& box, CFastArray<CEntity*>& result)
+	{
+		if (m_root == -1)
+			return;
+
+		m_stack.set_used(0);
+		m_stack.push_back(m_root);
+
+		while (m_stack.size() > 0)
+		{
+			int id = m_stack.getLast();
+			m_stack.erase(m_stack.size() - 1);
+
+			const SNode& node = m_nodes[id];
+			if (!node.Box.intersectsWithBox(box))
+				continue;
+
+			if (node.isLeaf())
+			{
+				result.push(node.Entity);
+			}
+			else if (node.Box.isFullInside(box))
+			{
+				collectLeaves(id, result);
+			}
+			else
+			{
+				m_stack.push_back(node.Child1);
+				m_stack.push_back(node.Child2);
+			}
+		}
+	}
+
+	void CCullingBVH::removeInvalidProxy(bool (*isValid)(CEntity* entity, int proxy))
+	{
+		for (int i = 0, n = (int)m_nodes.size(); i < n; i++)
+		{
+			SNode& node = m_nodes[i];
+			if (node.Height == 0 && !isValid(node.Entity, i))
+				destroyProxy(i);
+		}
+	}
+
+	int CCullingBVH::getHeight()
+	{
+		if (m_root == -1)
+			return 0;
+		return m_nodes[m_root].Height;
+	}
+
+	bool CCullingBVH::validate()
+	{
+		if (m_root == -1)
+			return m_leafCount == 0;
+
+		if (m_nodes[m_root].Parent != -1)
+			return false;
+
+		return validate(m_root);
+	}
+
+	bool CCullingBVH::validate(int id)
+	{
+		const SNode& node = m_nodes[id];
+		if (node.isLeaf())
+			return node.Height == 0 && node.Child2 == -1;
+
+		const SNode& child1 = m_nodes[node.Child1];
+		const SNode& child2 = m_nodes[node.Child2];
+
+		if (child1.Parent != id || child2.Parent != id)
+			return false;
+
+		if (node.Height != 1 + core::max_(child1.Height, child2.Height))
+			return false;
+
+		if (!child1.Box.isFullInside(node.Box) || !child2.Box.isFullInside(node.Box))
+			return false;
+
+		return validate(node.Child1) && validate(node.Child2);
+	}
+}
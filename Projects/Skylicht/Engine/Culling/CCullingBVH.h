@@ -0,0 +1,154 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Entity/CEntity.h"
+#include "Entity/CArrayUtils.h"
+
+namespace Skylicht
+{
+	/**
+	 * @brief Dynamic AABB tree of the culling bounding boxes.
+	 * @ingroup Culling
+	 *
+	 * The leaves store a fat box (the box enlarged by a margin), so the small movement of an entity does not modify the tree.
+	 * When the box moves out of the fat box, the leaf is removed and inserted again, and the tree is balanced by rotations.
+	 *
+	 * @code
+	 * int proxy = tree->createProxy(worldBox, entity);
+	 * ...
+	 * tree->moveProxy(proxy, newWorldBox);
+	 * ...
+	 * CFastArray<CEntity*> result;
+	 * tree->queryFrustum(camera->getViewFrustum(), result);
+	 * @endcode
+	 */
+	class SKYLICHT_API CCullingBVH
+	{
+	public:
+		struct SNode
+		{
+			core::aabbox3df Box;
+
+			CEntity* Entity;
+
+			// parent node, or next node in free list
+			int Parent;
+
+			int Child1;
+
+			int Child2;
+
+			// leaf = 0, free node = -1
+			int Height;
+
+			inline bool isLeaf() const
+			{
+				return Child1 == -1;
+			}
+		};
+
+	protected:
+		core::array<SNode> m_nodes;
+
+		int m_root;
+
+		int m_freeList;
+
+		int m_leafCount;
+
+		float m_margin;
+
+		core::array<int> m_stack;
+
+	public:
+		CCullingBVH();
+
+		virtual ~CCullingBVH();
+
+		/// @brief Insert a box to the tree
+		/// @return the proxy id, that is used to move or destroy
+		int createProxy(const core::aabbox3df& box, CEntity* entity);
+
+		void destroyProxy(int proxy);
+
+		/// @brief Update the box of a proxy
+		/// @return true if the proxy is reinserted to the tree
+		bool moveProxy(int proxy, const core::aabbox3df& box);
+
+		void clear();
+
+		/// @brief Get all entities that their box is not outside the frustum planes
+		void queryFrustum(const SViewFrustum& frustum, CFastArray<CEntity*>& result);
+
+		/// @brief Get all entities that their box intersects the box
+		void queryBox(const core::aabbox3df& box, CFastArray<CEntity*>& result);
+
+		/// @brief Remove the leaves that return false by the callback
+		void removeInvalidProxy(bool (*isValid)(CEntity* entity, int proxy));
+
+		inline CEntity* getEntity(int proxy)
+		{
+			return m_nodes[proxy].Entity;
+		}
+
+		inline const core::aabbox3df& getFatBox(int proxy)
+		{
+			return m_nodes[proxy].Box;
+		}
+
+		inline int getLeafCount()
+		{
+			return m_leafCount;
+		}
+
+		/// @brief Margin (ratio of the box size) is added to the box of leaf
+		inline void setMargin(float margin)
+		{
+			m_margin = margin;
+		}
+
+		int getHeight();
+
+		/// @brief Check parent/child links and the boxes, for debug and unit test
+		bool validate();
+
+	protected:
+
+		int allocateNode();
+
+		void freeNode(int node);
+
+		void insertLeaf(int leaf);
+
+		void removeLeaf(int leaf);
+
+		int balance(int a);
+
+		void collectLeaves(int node, CFastArray<CEntity*>& result);
+
+		bool validate(int node);
+	};
+}
@@ -36,7 +36,11 @@ namespace Skylicht
 		Visible(true),
 		Occlusion(false),
 		ShadowCasting(true),
-		NeedValidate(true)
+		NeedValidate(true),
+		ShadowCascadeMask(0xFFFFFFFF),
+		ShadowDynamic(false),
+		BVHProxy(-1),
+		QueryIndex(-1)
 	{
 
 	}
@@ -53,6 +53,18 @@ namespace Skylicht
 
 		bool NeedValidate;
 
+		// the shadow cascades that this caster touches (see CShadowCasterCulling)
+		u32 ShadowCascadeMask;
+
+		// the caster moves or animates on this frame, it is not drawn in the static shadow depth (see CShadowMapRP)
+		bool ShadowDynamic;
+
+		// proxy id of BBox in CCullingBVH
+		int BVHProxy;
+
+		// index in the query list of CCullingSystem, -1 if it is hidden or has no bounding box
+		int QueryIndex;
+
 	public:
 		CCullingData();
 
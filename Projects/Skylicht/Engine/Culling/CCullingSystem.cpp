@@ -30,10 +30,16 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Camera/CCamera.h"
 
 #include "RenderPipeline/CShadowMapRP.h"
+#include "Shadow/CShadowCasterCulling.h"
+#include "OcclusionQuery/CSoftwareOcclusion.h"
+#include "OcclusionQuery/COccluderData.h"
+
+#include <chrono>
 
 namespace Skylicht
 {
 	bool g_useCacheCulling = false;
+	bool g_useBVHCulling = true;
 
 	void CCullingSystem::useCacheCulling(bool b)
 	{
@@ -45,15 +51,53 @@ namespace Skylicht
 		return g_useCacheCulling;
 	}
 
+	void CCullingSystem::useBVHCulling(bool b)
+	{
+		g_useBVHCulling = b;
+	}
+
+	bool CCullingSystem::useBVHCulling()
+	{
+		return g_useBVHCulling;
+	}
+
+	static bool isValidProxy(CEntity* entity, int proxy)
+	{
+		if (!entity->isAlive())
+			return false;
+
+		CCullingData* culling = GET_ENTITY_DATA(entity, CCullingData);
+		return culling != NULL && culling->BVHProxy == proxy;
+	}
+
 	CCullingSystem::CCullingSystem() :
-		m_group(NULL)
+		m_group(NULL),
+		m_occluderGroup(NULL),
+		m_softwareOcclusion(NULL)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
 	}
 
 	CCullingSystem::~CCullingSystem()
 	{
+		if (m_softwareOcclusion)
+			delete m_softwareOcclusion;
+	}
 
+	void CCullingSystem::enableSoftwareOcclusion(bool b, int width, int height)
+	{
+		if (b)
+		{
+			if (m_softwareOcclusion == NULL)
+				m_softwareOcclusion = new CSoftwareOcclusion(width, height);
+			else
+				m_softwareOcclusion->setResolution(width, height);
+		}
+		else if (m_softwareOcclusion)
+		{
+			delete m_softwareOcclusion;
+			m_softwareOcclusion = NULL;
+		}
 	}
 
 	void CCullingSystem::beginQuery(CEntityManager* entityManager)
@@ -63,6 +107,12 @@ namespace Skylicht
 			const u32 type[] = { DATA_TYPE_INDEX(CCullingData) };
 			m_group = entityManager->createGroup(type, 1);
 		}
+
+		if (m_occluderGroup == NULL && m_softwareOcclusion != NULL)
+		{
+			const u32 type[] = GET_LIST_ENTITY_DATA(COccluderData);
+			m_occluderGroup = entityManager->createGroupFromVisible(type, 1);
+		}
 	}
 
 	void CCullingSystem::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
@@ -74,6 +124,7 @@ namespace Skylicht
 		numEntity = m_group->getEntityCount();
 
 		m_bboxAndMaterials.reset();
+		m_changed.reset();
 
 		CEntity* entity;
 		CCullingData* culling;
@@ -95,6 +146,7 @@ namespace Skylicht
 
 			culling->CullingLayer = visible->CullingLayer;
 			culling->ShadowCasting = visible->ShadowCasting;
+			culling->QueryIndex = -1;
 
 			if (visible->Culled || !visible->Visible)
 			{
@@ -116,6 +168,7 @@ namespace Skylicht
 					m->Materials = &mesh->getMaterials();
 
 					m->Culling->NeedValidate |= transform->NeedValidate;
+					m->Dynamic = m->Culling->NeedValidate || mesh->isSkinnedMesh();
 				}
 				else
 				{
@@ -130,11 +183,26 @@ namespace Skylicht
 						m->Materials = &bbox->Materials;
 
 						m->Culling->NeedValidate |= (bbox->NeedValidate || transform->NeedValidate);
+						m->Dynamic = m->Culling->NeedValidate;
 						bbox->NeedValidate = false;
 					}
+					else
+					{
+						continue;
+					}
 				}
+
+				culling->QueryIndex = m_bboxAndMaterials.count() - 1;
+
+				// the box will be updated in the BVH
+				if (culling->NeedValidate || culling->BVHProxy == -1)
+					m_changed.push(culling->QueryIndex);
 			}
 		}
+
+		// remove the proxies of deleted entities
+		if (m_group->needValidate())
+			m_bvh.removeInvalidProxy(isValidProxy);
 	}
 
 	void CCullingSystem::init(CEntityManager* entityManager)
@@ -148,27 +216,45 @@ namespace Skylicht
 		if (rp == NULL)
 			return;
 
-		core::matrix4 invTrans;
-
 		// camera
 		CCamera* camera = entityManager->getCamera();
-		const core::aabbox3df& cameraBox = camera->getViewFrustum().getBoundingBox();
 
+		m_visibleIndex.reset();
+
+		if (g_useBVHCulling && !g_useCacheCulling)
+			updateBVHCulling(rp, camera);
+		else
+			updateCulling(rp, camera);
+
+		// classify the visible casters with the shadow cascades
+		if (rp->getType() == IRenderPipeline::ShadowMap && !g_useCacheCulling)
+		{
+			CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
+			CShadowCasterCulling* casterCulling = shadowMapRP->getCasterCulling();
+			if (casterCulling != NULL && shadowMapRP->getRenderShadowState() == CShadowMapRP::DirectionLight)
+				testShadowCascades(casterCulling);
+		}
+
+		// 3. Occlusion culling
+		if (m_softwareOcclusion != NULL && m_occluderGroup != NULL && !g_useCacheCulling && rp->getType() != IRenderPipeline::ShadowMap)
+			testOcclusion(camera);
+	}
+
+	void CCullingSystem::updateCulling(IRenderPipeline* rp, CCamera* camera)
+	{
 		int count = m_bboxAndMaterials.count();
 
 		SBBoxAndMaterial* bbBoxMats = m_bboxAndMaterials.pointer();
 		SBBoxAndMaterial* bbBoxMat;
-		CEntity* entity;
 		CCullingData* culling;
-		CMaterial** materials;
-		CMaterial* m;
-		int materialCount;
+
+		// keep the entities that are not culled, if the BVH culling is enabled again
+		m_queryResult.reset();
 
 		for (int i = 0; i < count; i++)
 		{
 			bbBoxMat = &bbBoxMats[i];
 
-			entity = bbBoxMat->Entity;
 			culling = bbBoxMat->Culling;
 
 			if (g_useCacheCulling)
@@ -182,109 +268,316 @@ namespace Skylicht
 				culling->CameraCulled = false;
 			}
 
-			culling->Visible = true;
-
 			// check material first
-			if (bbBoxMat->Materials != NULL)
-			{
-				materials = bbBoxMat->Materials->data();
-				materialCount = (int)bbBoxMat->Materials->size();
+			culling->Visible = canRender(rp, bbBoxMat);
 
-				for (int j = 0; j < materialCount; j++)
-				{
-					m = materials[j];
-					if (m != NULL && rp->canRenderMaterial(m) == false)
-					{
-						culling->Visible = false;
-						break;
-					}
-				}
+			if (culling->Visible && !g_useCacheCulling)
+			{
+				updateBBox(bbBoxMat);
+				testCulling(rp, camera, bbBoxMat);
 			}
 
-			if (culling->Visible == false)
+			if (!culling->CameraCulled)
+				m_queryResult.push(bbBoxMat->Entity);
+
+			if (culling->Visible)
+				m_visibleIndex.push(i);
+		}
+	}
+
+	void CCullingSystem::updateBVHCulling(IRenderPipeline* rp, CCamera* camera)
+	{
+		int count = m_bboxAndMaterials.count();
+
+		SBBoxAndMaterial* bbBoxMats = m_bboxAndMaterials.pointer();
+		SBBoxAndMaterial* bbBoxMat;
+		CCullingData* culling;
+
+		// reset the entities of last query, the others are already culled
+		CEntity** hits = m_queryResult.pointer();
+		int numHit = m_queryResult.count();
+
+		for (int i = 0; i < numHit; i++)
+		{
+			if (!hits[i]->isAlive())
 				continue;
 
-			if (rp->getType() == IRenderPipeline::ShadowMap && !culling->ShadowCasting)
+			culling = GET_ENTITY_DATA(hits[i], CCullingData);
+			if (culling != NULL)
 			{
 				culling->Visible = false;
-				continue;
+				culling->CameraCulled = true;
 			}
+		}
 
-			if (g_useCacheCulling)
+		// refit the moved boxes and insert the new entities
+		int* changed = m_changed.pointer();
+		int numChanged = m_changed.count();
+
+		for (int i = 0; i < numChanged; i++)
+		{
+			bbBoxMat = &bbBoxMats[changed[i]];
+			culling = bbBoxMat->Culling;
+
+			updateBBox(bbBoxMat);
+
+			if (culling->BVHProxy == -1)
+			{
+				culling->BVHProxy = m_bvh.createProxy(culling->BBox, bbBoxMat->Entity);
+
+				// this entity will be visible if the query hits it
+				culling->Visible = false;
+				culling->CameraCulled = true;
+			}
+		}
+
+		// query the visible entities
+		m_queryResult.reset();
+
+		bool shadowMap = rp->getType() == IRenderPipeline::ShadowMap;
+		if (shadowMap)
+		{
+			CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
+			if (shadowMapRP->getRenderShadowState() == CShadowMapRP::DirectionLight)
+				m_bvh.queryBox(shadowMapRP->getFrustumBox(), m_queryResult);
+			else
+				m_bvh.queryBox(camera->getViewFrustum().getBoundingBox(), m_queryResult);
+		}
+		else
+		{
+			m_bvh.queryFrustum(camera->getViewFrustum(), m_queryResult);
+		}
+
+		hits = m_queryResult.pointer();
+		numHit = m_queryResult.count();
+
+		for (int i = 0; i < numHit; i++)
+		{
+			culling = GET_ENTITY_DATA(hits[i], CCullingData);
+
+			// the entity is hidden on this frame
+			int id = culling->QueryIndex;
+			if (id < 0 || id >= count || bbBoxMats[id].Entity != hits[i])
 				continue;
 
-			// update bbox
-			if (culling->NeedValidate)
+			bbBoxMat = &bbBoxMats[id];
+
+			culling->CameraCulled = false;
+
+			if (!canRender(rp, bbBoxMat))
+				continue;
+
+			if (!shadowMap && culling->Type == CCullingData::FrustumBox && !testFrustumBox(camera, bbBoxMat))
 			{
-				culling->BBox = *bbBoxMat->BBox;
-				bbBoxMat->Transform->World.transformBoxEx(culling->BBox);
-				culling->NeedValidate = false;
+				culling->CameraCulled = true;
+				continue;
 			}
 
-			// 1. Detect by bounding box
-			if (rp->getType() == IRenderPipeline::ShadowMap)
+			culling->Visible = true;
+			m_visibleIndex.push(id);
+		}
+	}
+
+	bool CCullingSystem::canRender(IRenderPipeline* rp, SBBoxAndMaterial* bbBoxMat)
+	{
+		if (bbBoxMat->Materials != NULL)
+		{
+			CMaterial** materials = bbBoxMat->Materials->data();
+			int materialCount = (int)bbBoxMat->Materials->size();
+
+			for (int j = 0; j < materialCount; j++)
 			{
-				CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
+				CMaterial* m = materials[j];
+				if (m != NULL && rp->canRenderMaterial(m) == false)
+					return false;
+			}
+		}
 
-				if (shadowMapRP->getRenderShadowState() == CShadowMapRP::DirectionLight)
-				{
-					const core::aabbox3df& box = shadowMapRP->getFrustumBox();
-					culling->CameraCulled = !culling->BBox.intersectsWithBox(box);
-					culling->Visible = !culling->CameraCulled;
-				}
-				else
-				{
-					culling->CameraCulled = !culling->BBox.intersectsWithBox(cameraBox);
-					culling->Visible = !culling->CameraCulled;
-				}
-				continue;
+		if (rp->getType() == IRenderPipeline::ShadowMap && !bbBoxMat->Culling->ShadowCasting)
+			return false;
+
+		return true;
+	}
+
+	void CCullingSystem::testShadowCascades(CShadowCasterCulling* casterCulling)
+	{
+		int count = m_visibleIndex.count();
+		int* visibleIndex = m_visibleIndex.pointer();
+		SBBoxAndMaterial* bbBoxMats = m_bboxAndMaterials.pointer();
+
+		casterCulling->beginCasters();
+
+		for (int i = 0; i < count; i++)
+		{
+			SBBoxAndMaterial& bbBoxMat = bbBoxMats[visibleIndex[i]];
+			casterCulling->addCaster(bbBoxMat.Culling->BBox, (u32)bbBoxMat.Entity->getIndex(), bbBoxMat.Dynamic);
+		}
+
+		casterCulling->classify();
+
+		for (int i = 0; i < count; i++)
+		{
+			SBBoxAndMaterial& bbBoxMat = bbBoxMats[visibleIndex[i]];
+			CCullingData* culling = bbBoxMat.Culling;
+
+			culling->ShadowCascadeMask = casterCulling->getMask((u32)i);
+			culling->ShadowDynamic = bbBoxMat.Dynamic;
+
+			// the caster is not in any cascade
+			if (culling->ShadowCascadeMask == 0)
+				culling->Visible = false;
+		}
+	}
+
+	void CCullingSystem::updateBBox(SBBoxAndMaterial* bbBoxMat)
+	{
+		CCullingData* culling = bbBoxMat->Culling;
+
+		if (culling->NeedValidate)
+		{
+			culling->BBox = *bbBoxMat->BBox;
+			bbBoxMat->Transform->World.transformBoxEx(culling->BBox);
+			culling->NeedValidate = false;
+
+			// refit the tree
+			if (culling->BVHProxy != -1)
+				m_bvh.moveProxy(culling->BVHProxy, culling->BBox);
+		}
+	}
+
+	void CCullingSystem::testCulling(IRenderPipeline* rp, CCamera* camera, SBBoxAndMaterial* bbBoxMat)
+	{
+		CCullingData* culling = bbBoxMat->Culling;
+		const core::aabbox3df& cameraBox = camera->getViewFrustum().getBoundingBox();
+
+		// 1. Detect by bounding box
+		if (rp->getType() == IRenderPipeline::ShadowMap)
+		{
+			CShadowMapRP* shadowMapRP = (CShadowMapRP*)rp;
+
+			if (shadowMapRP->getRenderShadowState() == CShadowMapRP::DirectionLight)
+			{
+				const core::aabbox3df& box = shadowMapRP->getFrustumBox();
+				culling->CameraCulled = !culling->BBox.intersectsWithBox(box);
+				culling->Visible = !culling->CameraCulled;
 			}
 			else
 			{
 				culling->CameraCulled = !culling->BBox.intersectsWithBox(cameraBox);
 				culling->Visible = !culling->CameraCulled;
 			}
+			return;
+		}
+		else
+		{
+			culling->CameraCulled = !culling->BBox.intersectsWithBox(cameraBox);
+			culling->Visible = !culling->CameraCulled;
+		}
 
-			// 2. Detect algorithm
-			if (culling->Visible == true)
+		// 2. Detect algorithm
+		if (culling->Visible == true && culling->Type == CCullingData::FrustumBox)
+		{
+			if (!testFrustumBox(camera, bbBoxMat))
+			{
+				culling->CameraCulled = true;
+				culling->Visible = false;
+			}
+		}
+	}
+
+	bool CCullingSystem::testFrustumBox(CCamera* camera, SBBoxAndMaterial* bbBoxMat)
+	{
+		CWorldInverseTransformData* invTransform = GET_ENTITY_DATA(bbBoxMat->Entity, CWorldInverseTransformData);
+		if (invTransform == NULL)
+			return true;
+
+		// transform the frustum to the node's current absolute transformation
+		SViewFrustum frust = camera->getViewFrustum();
+		frust.transform(invTransform->WorldInverse);
+
+		core::vector3df edges[8];
+		bbBoxMat->BBox->getEdges(edges);
+
+		for (s32 i = 0; i < scene::SViewFrustum::VF_PLANE_COUNT; ++i)
+		{
+			bool boxInFrustum = false;
+			for (u32 j = 0; j < 8; ++j)
 			{
-				if (culling->Type == CCullingData::FrustumBox)
+				if (frust.planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
 				{
-					CWorldInverseTransformData* invTransform = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
-					if (invTransform)
-					{
-						// transform the frustum to the node's current absolute transformation
-						invTrans = invTransform->WorldInverse;
-
-						SViewFrustum frust = camera->getViewFrustum();
-						frust.transform(invTrans);
-
-						core::vector3df edges[8];
-						bbBoxMat->BBox->getEdges(edges);
-
-						for (s32 i = 0; i < scene::SViewFrustum::VF_PLANE_COUNT; ++i)
-						{
-							bool boxInFrustum = false;
-							for (u32 j = 0; j < 8; ++j)
-							{
-								if (frust.planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
-								{
-									boxInFrustum = true;
-									break;
-								}
-							}
-
-							if (!boxInFrustum)
-							{
-								culling->CameraCulled = true;
-								culling->Visible = false;
-								break;
-							}
-						}
-					} // if invTransform
+					boxInFrustum = true;
+					break;
 				}
 			}
+
+			if (!boxInFrustum)
+				return false;
+		}
+
+		return true;
+	}
+
+	void CCullingSystem::testOcclusion(CCamera* camera)
+	{
+		m_softwareOcclusion->beginFrame(camera->getProjectionMatrix() * camera->getViewMatrix());
+
+		// draw the occluders
+		CEntity** entities = m_occluderGroup->getEntities();
+		int numEntity = m_occluderGroup->getEntityCount();
+
+		for (int i = 0; i < numEntity; i++)
+		{
+			CEntity* entity = entities[i];
+
+			COccluderData* occluder = GET_ENTITY_DATA(entity, COccluderData);
+			if (!occluder->Enable)
+				continue;
+
+			// the occluder is out of the camera
+			CCullingData* culling = GET_ENTITY_DATA(entity, CCullingData);
+			if (culling != NULL && !culling->Visible)
+				continue;
+
+			CMesh* mesh = occluder->getMesh();
+			if (mesh == NULL)
+			{
+				CRenderMeshData* renderMesh = GET_ENTITY_DATA(entity, CRenderMeshData);
+				if (renderMesh != NULL)
+					mesh = renderMesh->getMesh();
+			}
+
+			if (mesh == NULL)
+				continue;
+
+			CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+			m_softwareOcclusion->addOccluder(mesh, transform->World);
 		}
+
+		m_softwareOcclusion->rasterize();
+
+		// test the visible boxes
+		std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+
+		int count = m_visibleIndex.count();
+		int* visibleIndex = m_visibleIndex.pointer();
+		SBBoxAndMaterial* bbBoxMats = m_bboxAndMaterials.pointer();
+
+		for (int i = 0; i < count; i++)
+		{
+			SBBoxAndMaterial& bbBoxMat = bbBoxMats[visibleIndex[i]];
+			CCullingData* culling = bbBoxMat.Culling;
+
+			// the occluder is not tested with itself
+			COccluderData* occluder = GET_ENTITY_DATA(bbBoxMat.Entity, COccluderData);
+			if (occluder != NULL && occluder->Enable)
+				continue;
+
+			if (!m_softwareOcclusion->testBox(culling->BBox))
+				culling->Visible = false;
+		}
+
+		std::chrono::duration<float, std::milli> testTime = std::chrono::high_resolution_clock::now() - begin;
+		m_softwareOcclusion->addTestTime(testTime.count());
 	}
 
 	void CCullingSystem::render(CEntityManager* entityManager)
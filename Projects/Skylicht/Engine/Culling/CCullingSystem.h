@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "CCullingData.h"
 #include "CVisibleData.h"
+#include "CCullingBVH.h"
 #include "Entity/CEntityGroup.h"
 #include "Entity/IRenderSystem.h"
 #include "Transform/CWorldTransformData.h"
@@ -34,6 +35,10 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	class CCamera;
+	class CSoftwareOcclusion;
+	class CShadowCasterCulling;
+
 	struct SBBoxAndMaterial
 	{
 		CEntity* Entity;
@@ -47,9 +52,13 @@ namespace Skylicht
 		// Material to check render pipeline cull
 		ArrayMaterial* Materials;
 
+		// the caster moves or animates on this frame
+		bool Dynamic;
+
 		SBBoxAndMaterial()
 		{
 			Entity = NULL;
+			Dynamic = false;
 			BBox = NULL;
 			Culling = NULL;
 			Materials = NULL;
@@ -64,6 +73,21 @@ namespace Skylicht
 
 		CEntityGroup* m_group;
 
+		CCullingBVH m_bvh;
+
+		// the entities hit by the last BVH query, they are reset before the next query
+		CFastArray<CEntity*> m_queryResult;
+
+		// the entities that need to refit the BVH proxy
+		CFastArray<int> m_changed;
+
+		// the visible entities of this update (index of m_bboxAndMaterials)
+		CFastArray<int> m_visibleIndex;
+
+		CEntityGroup* m_occluderGroup;
+
+		CSoftwareOcclusion* m_softwareOcclusion;
+
 	public:
 		CCullingSystem();
 
@@ -84,5 +108,43 @@ namespace Skylicht
 		static void useCacheCulling(bool b);
 
 		static bool useCacheCulling();
+
+		/// @brief Use the dynamic AABB tree to find the visible entities, instead of testing all the bounding boxes (default: true)
+		static void useBVHCulling(bool b);
+
+		static bool useBVHCulling();
+
+		inline CCullingBVH* getBVH()
+		{
+			return &m_bvh;
+		}
+
+		/// @brief Test the visible bounding boxes with the depth buffer of occluders (see COccluderData) on CPU.
+		/// @param width the resolution of software depth buffer
+		void enableSoftwareOcclusion(bool b, int width = 256, int height = 128);
+
+		/// @brief The software occlusion, NULL if it is not enabled. Use it to get the stats of last pass.
+		inline CSoftwareOcclusion* getSoftwareOcclusion()
+		{
+			return m_softwareOcclusion;
+		}
+
+	protected:
+
+		void updateCulling(IRenderPipeline* rp, CCamera* camera);
+
+		void updateBVHCulling(IRenderPipeline* rp, CCamera* camera);
+
+		void updateBBox(SBBoxAndMaterial* bbBoxMat);
+
+		bool canRender(IRenderPipeline* rp, SBBoxAndMaterial* bbBoxMat);
+
+		void testCulling(IRenderPipeline* rp, CCamera* camera, SBBoxAndMaterial* bbBoxMat);
+
+		bool testFrustumBox(CCamera* camera, SBBoxAndMaterial* bbBoxMat);
+
+		void testShadowCascades(CShadowCasterCulling* casterCulling);
+
+		void testOcclusion(CCamera* camera);
 	};
 }
\ No newline at end of file
@@ -70,6 +70,14 @@ namespace Skylicht
 			return m_count;
 		}
 
+		void set_used(int count)
+		{
+			if (count >= m_alloc)
+				alloc(count);
+
+			m_count = count;
+		}
+
 		void push(T element)
 		{
 			if (m_count + 1 >= m_alloc)
@@ -37,7 +37,9 @@ namespace Skylicht
 	CEntity::CEntity(CEntityManager* mgr) :
 		m_alive(true),
 		m_visible(true),
-		m_mgr(mgr)
+		m_mgr(mgr),
+		m_signature(0),
+		m_chunkData(0)
 	{
 		m_index = mgr->getNumEntities();
 
@@ -48,7 +50,9 @@ namespace Skylicht
 	CEntity::CEntity(CEntityPrefab* mgr) :
 		m_alive(true),
 		m_visible(true),
-		m_mgr(NULL)
+		m_mgr(NULL),
+		m_signature(0),
+		m_chunkData(0)
 	{
 		m_index = mgr->getNumEntities();
 
@@ -72,14 +76,70 @@ namespace Skylicht
 		{
 			notifyUpdateGroup(index);
 
-			delete Data[index];
-			Data[index] = NULL;
+			releaseData(index);
 			return true;
 		}
 
 		return false;
 	}
 
+	void* CEntity::allocData(u32 index, u32 size, u32 align)
+	{
+		if (m_mgr == NULL || index >= MAX_ENTITY_DATA)
+			return NULL;
+
+		CEntityDataAllocator* allocator = m_mgr->getDataAllocator();
+		if (allocator == NULL)
+			return NULL;
+
+		return allocator->alloc(index, size, align);
+	}
+
+	void CEntity::freeData(u32 index, void* memory)
+	{
+		CEntityDataAllocator* allocator = m_mgr->getDataAllocator();
+		if (allocator)
+			allocator->free(index, memory);
+	}
+
+	void CEntity::releaseData(u32 index)
+	{
+		IEntityData* data = Data[index];
+		if (data == NULL)
+			return;
+
+		u64 bit = ((u64)1 << index);
+
+		if (m_chunkData & bit)
+		{
+			// the data is constructed on chunk storage
+			void* memory = dynamic_cast<void*>(data);
+			data->~IEntityData();
+			freeData(index, memory);
+		}
+		else
+		{
+			delete data;
+		}
+
+		Data[index] = NULL;
+
+		m_signature &= ~bit;
+		m_chunkData &= ~bit;
+	}
+
+	void CEntity::onAddData(u32 index, bool chunkData)
+	{
+		u64 bit = ((u64)1 << index);
+
+		m_signature |= bit;
+
+		if (chunkData)
+			m_chunkData |= bit;
+		else
+			m_chunkData &= ~bit;
+	}
+
 	IEntityData* CEntity::addDataByActivator(const char* dataType)
 	{
 		IActivatorObject* obj = CActivator::getInstance()->createInstance(dataType);
@@ -103,11 +163,13 @@ namespace Skylicht
 		int index = CEntityDataTypeManager::getDataIndex(typeid(*data));
 
 		if (Data[index])
-			delete Data[index];
+			releaseData(index);
 
 		// save at index
 		Data[index] = data;
 
+		onAddData(index, false);
+
 		notifyUpdateGroup(index);
 
 		return data;
@@ -120,8 +182,7 @@ namespace Skylicht
 		{
 			if (Data[i])
 			{
-				delete Data[i];
-				Data[i] = NULL;
+				releaseData(i);
 
 				notifyUpdateGroup(i);
 			}
@@ -66,6 +66,12 @@ namespace Skylicht
 		std::string m_id;
 
 		CEntityManager* m_mgr;
+
+		// bit mask of data types that attached on this entity
+		u64 m_signature;
+
+		// bit mask of data types that allocated by CEntityDataAllocator
+		u64 m_chunkData;
 	public:
 
 		IEntityData* Data[MAX_ENTITY_DATA];
@@ -136,6 +142,18 @@ namespace Skylicht
 			return m_visible;
 		}
 
+		/// @brief The bit mask of data types (archetype) that attached on this entity
+		inline u64 getSignature()
+		{
+			return m_signature;
+		}
+
+		/// @brief The data at index is allocated in a chunk of CEntityDataAllocator
+		inline bool isChunkData(u32 index)
+		{
+			return (m_chunkData & ((u64)1 << index)) != 0;
+		}
+
 		void setVisible(bool b);
 
 		void notifyUpdateGroup(int type);
@@ -147,45 +165,32 @@ namespace Skylicht
 			m_alive = b;
 		}
 
+		void* allocData(u32 index, u32 size, u32 align);
+
+		void freeData(u32 index, void* memory);
+
+		void releaseData(u32 index);
+
+		void onAddData(u32 index, bool chunkData);
+
 	};
 
 	template<class T>
 	T* CEntity::addData()
 	{
-		T* newData = new T();
-		IEntityData* data = dynamic_cast<IEntityData*>(newData);
-		if (data == NULL)
-		{
-			char exceptionInfo[512];
-			sprintf(exceptionInfo, "CEntity::addData %s must inherit IEntityData", typeid(T).name());
-			os::Printer::log(exceptionInfo);
-
-			delete newData;
-			return NULL;
-		}
-
 		// get index of type
 		u32 index = CEntityDataTypeManager::getDataIndex(typeid(T));
 
-		// also save this entity index
-		data->EntityIndex = m_index;
-		data->Entity = this;
-
-		if (Data[index])
-			delete Data[index];
-
-		// save at index
-		Data[index] = newData;
-
-		notifyUpdateGroup(index);
-
-		return newData;
+		return addData<T>(index);
 	}
 
 	template<class T>
 	T* CEntity::addData(int index)
 	{
-		T* newData = new T();
+		// allocate on the chunk storage if the entity manager enable it
+		void* memory = allocData(index, sizeof(T), alignof(T));
+		T* newData = memory ? new(memory) T() : new T();
+
 		IEntityData* data = dynamic_cast<IEntityData*>(newData);
 		if (data == NULL)
 		{
@@ -193,7 +198,15 @@ namespace Skylicht
 			sprintf(exceptionInfo, "CEntity::addData %s must inherit IEntityData", typeid(T).name());
 			os::Printer::log(exceptionInfo);
 
-			delete newData;
+			if (memory)
+			{
+				newData->~T();
+				freeData(index, memory);
+			}
+			else
+			{
+				delete newData;
+			}
 			return NULL;
 		}
 
@@ -202,11 +215,13 @@ namespace Skylicht
 		data->Entity = this;
 
 		if (Data[index])
-			delete Data[index];
+			releaseData(index);
 
 		// save at index
 		Data[index] = newData;
 
+		onAddData(index, memory != NULL);
+
 		notifyUpdateGroup(index);
 
 		return newData;
@@ -238,8 +253,7 @@ namespace Skylicht
 
 		if (Data[index])
 		{
-			delete Data[index];
-			Data[index] = NULL;
+			releaseData(index);
 
 			notifyUpdateGroup(index);
 
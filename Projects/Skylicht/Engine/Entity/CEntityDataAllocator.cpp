@@ -0,0 +1,208 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CEntityDataAllocator.h"
+
+namespace Skylicht
+{
+	CEntityDataAllocator::CEntityDataAllocator()
+	{
+
+	}
+
+	CEntityDataAllocator::~CEntityDataAllocator()
+	{
+		releaseAll();
+	}
+
+	void CEntityDataAllocator::releaseAll()
+	{
+		for (u32 i = 0, n = m_pools.size(); i < n; i++)
+		{
+			SPool* pool = m_pools[i];
+			if (pool == NULL)
+				continue;
+
+			for (u32 j = 0, m = pool->Chunks.size(); j < m; j++)
+			{
+				delete[] pool->Chunks[j]->Memory;
+				delete pool->Chunks[j];
+			}
+
+			delete pool;
+		}
+		m_pools.clear();
+	}
+
+	CEntityDataAllocator::SPool* CEntityDataAllocator::getPool(u32 dataType)
+	{
+		while (m_pools.size() <= dataType)
+			m_pools.push_back(NULL);
+
+		if (m_pools[dataType] == NULL)
+			m_pools[dataType] = new SPool();
+
+		return m_pools[dataType];
+	}
+
+	CEntityDataAllocator::SChunk* CEntityDataAllocator::createChunk(SPool* pool)
+	{
+		SChunk* chunk = new SChunk();
+		chunk->SlotSize = pool->SlotSize;
+		chunk->Used = 0;
+		chunk->AliveMask = 0;
+
+		// align the data to the cache line
+		chunk->Memory = new u8[pool->SlotSize * ENTITY_DATA_CHUNK_SLOTS + ENTITY_DATA_CHUNK_ALIGN];
+		size_t address = (size_t)chunk->Memory;
+		address = (address + ENTITY_DATA_CHUNK_ALIGN - 1) & ~((size_t)ENTITY_DATA_CHUNK_ALIGN - 1);
+		chunk->Data = (u8*)address;
+
+		pool->Chunks.push_back(chunk);
+
+		// keep the chunks sorted by address for findChunk
+		u32 pos = 0;
+		u32 count = pool->SortChunks.size();
+		while (pos < count && pool->SortChunks[pos]->Data < chunk->Data)
+			pos++;
+		pool->SortChunks.insert(chunk, pos);
+
+		// push the free slots in the reverse order, so the data will be allocated from the begin of chunk
+		for (int i = ENTITY_DATA_CHUNK_SLOTS - 1; i >= 0; i--)
+			pool->Free.push_back(chunk->Data + i * pool->SlotSize);
+
+		return chunk;
+	}
+
+	CEntityDataAllocator::SChunk* CEntityDataAllocator::findChunk(SPool* pool, void* data)
+	{
+		u8* p = (u8*)data;
+		SChunk** chunks = pool->SortChunks.pointer();
+
+		int low = 0;
+		int high = (int)pool->SortChunks.size() - 1;
+
+		while (low <= high)
+		{
+			int mid = (low + high) / 2;
+			SChunk* chunk = chunks[mid];
+
+			if (p < chunk->Data)
+				high = mid - 1;
+			else if (p >= chunk->Data + chunk->SlotSize * ENTITY_DATA_CHUNK_SLOTS)
+				low = mid + 1;
+			else
+				return chunk;
+		}
+
+		return NULL;
+	}
+
+	void* CEntityDataAllocator::alloc(u32 dataType, u32 size, u32 align)
+	{
+		SPool* pool = getPool(dataType);
+
+		if (pool->SlotSize == 0)
+		{
+			if (align < 16)
+				align = 16;
+			pool->SlotSize = (size + align - 1) & ~(align - 1);
+		}
+		else if (size > pool->SlotSize)
+		{
+			os::Printer::log("CEntityDataAllocator::alloc data size is not match with the pool");
+			return NULL;
+		}
+
+		SChunk* chunk = NULL;
+		if (pool->Free.size() == 0)
+			chunk = createChunk(pool);
+
+		u32 last = pool->Free.size() - 1;
+		void* data = pool->Free[last];
+		pool->Free.erase(last);
+
+		if (chunk == NULL)
+			chunk = findChunk(pool, data);
+
+		u32 slot = (u32)(((u8*)data - chunk->Data) / chunk->SlotSize);
+		chunk->AliveMask |= ((u64)1 << slot);
+		chunk->Used++;
+
+		return data;
+	}
+
+	void CEntityDataAllocator::free(u32 dataType, void* data)
+	{
+		if (dataType >= m_pools.size() || m_pools[dataType] == NULL)
+			return;
+
+		SPool* pool = m_pools[dataType];
+
+		SChunk* chunk = findChunk(pool, data);
+		if (chunk == NULL)
+			return;
+
+		u32 slot = (u32)(((u8*)data - chunk->Data) / chunk->SlotSize);
+		chunk->AliveMask &= ~((u64)1 << slot);
+		chunk->Used--;
+
+		pool->Free.push_back(data);
+	}
+
+	u32 CEntityDataAllocator::getChunkCount(u32 dataType)
+	{
+		if (dataType >= m_pools.size() || m_pools[dataType] == NULL)
+			return 0;
+
+		return m_pools[dataType]->Chunks.size();
+	}
+
+	const CEntityDataAllocator::SChunk* CEntityDataAllocator::getChunk(u32 dataType, u32 id)
+	{
+		return m_pools[dataType]->Chunks[id];
+	}
+
+	u32 CEntityDataAllocator::getAllocatedCount(u32 dataType)
+	{
+		if (dataType >= m_pools.size() || m_pools[dataType] == NULL)
+			return 0;
+
+		u32 count = 0;
+		core::array<SChunk*>& chunks = m_pools[dataType]->Chunks;
+		for (u32 i = 0, n = chunks.size(); i < n; i++)
+			count += chunks[i]->Used;
+
+		return count;
+	}
+
+	u32 CEntityDataAllocator::getSlotSize(u32 dataType)
+	{
+		if (dataType >= m_pools.size() || m_pools[dataType] == NULL)
+			return 0;
+
+		return m_pools[dataType]->SlotSize;
+	}
+}
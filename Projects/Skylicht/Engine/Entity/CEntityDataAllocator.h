@@ -0,0 +1,113 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+#define ENTITY_DATA_CHUNK_SLOTS 64
+#define ENTITY_DATA_CHUNK_ALIGN 64
+
+	/// @brief This object class allocates IEntityData of the same type in contiguous, cache-aligned chunks.
+	/// @ingroup ECS
+	/**
+	 * It is used by CEntityManager when the chunk storage mode is enabled (see CEntityManager::setUseChunkStorage).
+	 * Entities created together will store their data next to each other, so the systems that iterate
+	 * the data of an entity group will read the memory sequentially instead of chasing scattered heap objects.
+	 *
+	 * Each chunk has ENTITY_DATA_CHUNK_SLOTS slots, and the AliveMask tells which slot is in use,
+	 * so a system can also iterate the data directly by chunk spans (see CEntityGroup::getDataSpans).
+	 * @code
+	 * CEntityDataAllocator* allocator = entityManager->getDataAllocator();
+	 * u32 type = DATA_TYPE_INDEX(CWorldTransformData);
+	 * for (u32 i = 0, n = allocator->getChunkCount(type); i < n; i++)
+	 * {
+	 *	const CEntityDataAllocator::SChunk* chunk = allocator->getChunk(type, i);
+	 *	for (u32 j = 0; j < ENTITY_DATA_CHUNK_SLOTS; j++)
+	 *	{
+	 *		if (chunk->AliveMask & ((u64)1 << j))
+	 *		{
+	 *			CWorldTransformData* t = (CWorldTransformData*)(chunk->Data + j * chunk->SlotSize);
+	 *			...
+	 *		}
+	 *	}
+	 * }
+	 * @endcode
+	 */
+	class SKYLICHT_API CEntityDataAllocator
+	{
+	public:
+		struct SChunk
+		{
+			u8* Memory;
+			u8* Data;
+			u32 SlotSize;
+			u32 Used;
+			u64 AliveMask;
+		};
+
+	protected:
+		struct SPool
+		{
+			u32 SlotSize;
+			core::array<SChunk*> Chunks;
+			core::array<SChunk*> SortChunks;
+			core::array<void*> Free;
+
+			SPool() :
+				SlotSize(0)
+			{
+			}
+		};
+
+		core::array<SPool*> m_pools;
+
+	public:
+		CEntityDataAllocator();
+
+		virtual ~CEntityDataAllocator();
+
+		void* alloc(u32 dataType, u32 size, u32 align);
+
+		void free(u32 dataType, void* data);
+
+		void releaseAll();
+
+		u32 getChunkCount(u32 dataType);
+
+		const SChunk* getChunk(u32 dataType, u32 id);
+
+		u32 getAllocatedCount(u32 dataType);
+
+		u32 getSlotSize(u32 dataType);
+
+	protected:
+
+		SPool* getPool(u32 dataType);
+
+		SChunk* createChunk(SPool* pool);
+
+		SChunk* findChunk(SPool* pool, void* data);
+	};
+}
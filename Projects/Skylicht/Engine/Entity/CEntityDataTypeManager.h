@@ -38,6 +38,8 @@ namespace Skylicht
 
 #define DATA_TYPE_INDEX(type) type##_DataTypeIndex
 
+#define DATA_TYPE_MASK(type) ((u64)1 << type##_DataTypeIndex)
+
 	class SKYLICHT_API CEntityDataTypeManager
 	{
 	public:
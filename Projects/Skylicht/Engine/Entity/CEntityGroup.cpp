@@ -24,24 +24,34 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CEntityGroup.h"
+#include "CEntityManager.h"
 
 namespace Skylicht
 {
 	CEntityGroup::CEntityGroup(const u32* dataTypes, int count) :
 		m_needQuery(true),
 		m_needValidate(true),
-		m_parentGroup(NULL)
+		m_parentGroup(NULL),
+		m_signature(0)
 	{
 		for (int i = 0; i < count; i++)
+		{
 			m_dataTypes.push_back(dataTypes[i]);
+			m_signature |= ((u64)1 << dataTypes[i]);
+		}
 	}
 
 	CEntityGroup::CEntityGroup(const u32* dataTypes, int count, CEntityGroup* parentGroup) :
 		m_needQuery(true),
-		m_parentGroup(parentGroup)
+		m_needValidate(true),
+		m_parentGroup(parentGroup),
+		m_signature(0)
 	{
 		for (int i = 0; i < count; i++)
+		{
 			m_dataTypes.push_back(dataTypes[i]);
+			m_signature |= ((u64)1 << dataTypes[i]);
+		}
 	}
 
 	CEntityGroup::~CEntityGroup()
@@ -51,9 +61,6 @@ namespace Skylicht
 
 	void CEntityGroup::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
 	{
-		u32* types = m_dataTypes.pointer();
-		int count = m_dataTypes.size();
-
 		m_entities.reset();
 
 		if (m_parentGroup)
@@ -62,21 +69,14 @@ namespace Skylicht
 			entities = m_parentGroup->getEntities();
 		}
 
+		// the entity archetype must contain all the data types of the group
+		u64 signature = m_signature;
+
 		for (int i = 0; i < numEntity; i++)
 		{
 			CEntity* entity = entities[i];
-			bool selectEntity = true;
 
-			for (int j = 0; j < count; j++)
-			{
-				if (entity->Data[types[j]] == NULL)
-				{
-					selectEntity = false;
-					break;
-				}
-			}
-
-			if (selectEntity)
+			if ((entity->getSignature() & signature) == signature)
 			{
 				m_entities.push(entity);
 			}
@@ -86,6 +86,67 @@ namespace Skylicht
 		m_needValidate = true;
 	}
 
+	void CEntityGroup::updateDataSpans(CEntityManager* entityManager)
+	{
+		u32 numType = m_dataTypes.size();
+		m_dataSpans.resize(numType);
+
+		CEntityDataAllocator* allocator = entityManager->getDataAllocator();
+
+		CEntity** entities = m_entities.pointer();
+		u32 numEntity = (u32)m_entities.count();
+
+		for (u32 t = 0; t < numType; t++)
+		{
+			u32 type = m_dataTypes[t];
+			core::array<SDataSpan>& spans = m_dataSpans[t];
+			spans.set_used(0);
+
+			// without the chunk storage, each entity is a span
+			u32 stride = allocator ? allocator->getSlotSize(type) : 0;
+			bool lastInChunk = false;
+
+			for (u32 i = 0; i < numEntity; i++)
+			{
+				CEntity* entity = entities[i];
+				u8* data = (u8*)entity->getDataByIndex(type);
+
+				// only the chunk data is stored with a fixed stride
+				bool inChunk = stride > 0 && entity->isChunkData(type);
+				if (inChunk && lastInChunk)
+				{
+					SDataSpan& last = spans.getLast();
+					if (last.Data + last.Count * stride == data)
+					{
+						last.Count++;
+						continue;
+					}
+				}
+
+				SDataSpan span;
+				span.Begin = i;
+				span.Count = 1;
+				span.Data = data;
+				span.Stride = stride;
+				spans.push_back(span);
+
+				lastInChunk = inChunk;
+			}
+		}
+	}
+
+	const core::array<CEntityGroup::SDataSpan>& CEntityGroup::getDataSpans(u32 dataType)
+	{
+		for (u32 i = 0, n = (u32)m_dataSpans.size(); i < n; i++)
+		{
+			if (m_dataTypes[i] == dataType)
+				return m_dataSpans[i];
+		}
+
+		static core::array<SDataSpan> empty;
+		return empty;
+	}
+
 	bool CEntityGroup::haveDataType(u32 type)
 	{
 		u32* types = m_dataTypes.pointer();
@@ -49,12 +49,42 @@ namespace Skylicht
 	 * const u32 primitive[] = GET_LIST_ENTITY_DATA(CPrimiviteData);
 	 * CEntityGroup* group = entityManager->createGroupFromVisible(primitive, 1);
 	 * @endcode
+	 *
+	 * When the chunk storage is enabled (CEntityManager::setUseChunkStorage), a system can iterate the data of the group by spans,
+	 * each span is a run of entities whose data is stored contiguously in a chunk.
+	 * @code
+	 * CEntity** entities = group->getEntities();
+	 * const core::array<CEntityGroup::SDataSpan>& spans = group->getDataSpans(DATA_TYPE_INDEX(CPrimiviteData));
+	 * for (u32 i = 0, n = spans.size(); i < n; i++)
+	 * {
+	 *	const CEntityGroup::SDataSpan& span = spans[i];
+	 *	for (u32 j = 0; j < span.Count; j++)
+	 *	{
+	 *		CPrimiviteData* data = (CPrimiviteData*)(IEntityData*)(span.Data + j * span.Stride);
+	 *		CEntity* entity = entities[span.Begin + j];
+	 *		...
+	 *	}
+	 * }
+	 * @endcode
 	 */
 	class SKYLICHT_API CEntityGroup
 	{
+	public:
+		struct SDataSpan
+		{
+			// index of the first entity in getEntities()
+			u32 Begin;
+			u32 Count;
+			u8* Data;
+			u32 Stride;
+		};
+
 	protected:
 		core::array<u32> m_dataTypes;
 
+		// bit mask of m_dataTypes, that is compared with CEntity::getSignature
+		u64 m_signature;
+
 		CEntityGroup* m_parentGroup;
 
 		// needQuery tell this group will query again at next frame
@@ -65,6 +95,9 @@ namespace Skylicht
 
 		CFastArray<CEntity*> m_entities;
 
+		// the spans of each type in m_dataTypes
+		std::vector<core::array<SDataSpan>> m_dataSpans;
+
 	public:
 		CEntityGroup(const u32* dataTypes, int count);
 
@@ -74,6 +107,10 @@ namespace Skylicht
 
 		virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity);
 
+		void updateDataSpans(CEntityManager* entityManager);
+
+		const core::array<SDataSpan>& getDataSpans(u32 dataType);
+
 		inline CEntity** getEntities()
 		{
 			return m_entities.pointer();
@@ -106,6 +143,11 @@ namespace Skylicht
 
 		bool haveDataType(u32 type);
 
+		inline u64 getSignature()
+		{
+			return m_signature;
+		}
+
 		inline CEntityGroup* getParent()
 		{
 			return m_parentGroup;
@@ -28,6 +28,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Transform/CGroupComponent.h"
 #include "Transform/CWorldTransformSystem.h"
 #include "Transform/CWorldInverseTransformSystem.h"
+#include "Animation/CAnimationSystem.h"
 #include "RenderMesh/CMeshRenderer.h"
 #include "RenderMesh/CMeshRendererInstancing.h"
 #include "RenderMesh/CSkinnedMeshRenderer.h"
@@ -46,20 +47,25 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Debug/CDebugRenderer.h"
 #include "TextBillboard/CTextBillboardRenderer.h"
 
+#include "Job/CJobScheduler.h"
+
 namespace Skylicht
 {
 	CEntityManager::CEntityManager() :
 		m_camera(NULL),
 		m_renderPipeline(NULL),
+		m_dataAllocator(NULL),
 		m_systemChanged(true),
 		m_rendererChanged(true),
-		m_needSortEntities(true)
+		m_needSortEntities(true),
+		m_parallelUpdate(false)
 	{
 		CGroupVisible* groupVisible = new CGroupVisible();
 		addCustomGroup(groupVisible);
 		addCustomGroup(new CGroupComponent(groupVisible));
 
 		// core engine systems
+		addSystem<CAnimationSystem>();
 		addSystem<CWorldTransformSystem>();
 		addSystem<CWorldInverseTransformSystem>();
 		addSystem<CJointAnimationSystem>();
@@ -90,6 +96,33 @@ namespace Skylicht
 		releaseAllEntities();
 		releaseAllSystems();
 		releaseAllGroups();
+
+		if (m_dataAllocator)
+			delete m_dataAllocator;
+	}
+
+	bool CEntityManager::setUseChunkStorage(bool b)
+	{
+		if (isUseChunkStorage() == b)
+			return true;
+
+		if (m_entities.size() > 0)
+		{
+			os::Printer::log("CEntityManager::setUseChunkStorage must be called before creating any entity");
+			return false;
+		}
+
+		if (b)
+		{
+			m_dataAllocator = new CEntityDataAllocator();
+		}
+		else
+		{
+			delete m_dataAllocator;
+			m_dataAllocator = NULL;
+		}
+
+		return true;
 	}
 
 	void CEntityManager::registerCallback(IEntityManagerCallback* callback)
@@ -481,7 +514,16 @@ namespace Skylicht
 			g->finishValidate();
 
 			if (g->needQuery())
+			{
 				g->onQuery(this, entities, numEntity);
+				g->updateDataSpans(this);
+			}
+		}
+
+		if (m_parallelUpdate)
+		{
+			updateSystemsParallel(entities, numEntity);
+			return;
 		}
 
 		for (IEntitySystem*& s : m_sortUpdate)
@@ -495,6 +537,67 @@ namespace Skylicht
 		}
 	}
 
+	void CEntityManager::updateSystemsParallel(CEntity** entities, int numEntity)
+	{
+		struct SSystemJob
+		{
+			u64 Read;
+			u64 Write;
+			System::CJobHandle Job;
+		};
+
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+
+		std::vector<SSystemJob> running;
+		std::vector<System::CJobHandle> dependencies;
+
+		for (IEntitySystem*& s : m_sortUpdate)
+		{
+			if (s->isRenderSystem())
+				continue;
+
+			u64 read = 0;
+			u64 write = 0;
+
+			if (!s->getDataAccess(read, write) || scheduler->getWorkerCount() == 0)
+			{
+				// the system does not declare data access, run it on main thread after all the previous systems
+				for (SSystemJob& job : running)
+					scheduler->wait(job.Job);
+				running.clear();
+
+				s->onQuery(this, entities, numEntity);
+				s->update(this);
+				continue;
+			}
+
+			// wait the systems that have conflict data access
+			dependencies.clear();
+			for (SSystemJob& job : running)
+			{
+				if ((write & (job.Read | job.Write)) || (read & job.Write))
+					dependencies.push_back(job.Job);
+			}
+
+			IEntitySystem* system = s;
+			SSystemJob job;
+			job.Read = read;
+			job.Write = write;
+			job.Job = scheduler->run([this, system, entities, numEntity]()
+				{
+					system->onQuery(this, entities, numEntity);
+					system->update(this);
+				},
+				dependencies.data(),
+				(int)dependencies.size());
+
+			running.push_back(job);
+		}
+
+		for (SSystemJob& job : running)
+			scheduler->wait(job.Job);
+	}
+
 	void CEntityManager::sortRenderer()
 	{
 		m_sortRender = m_renders;
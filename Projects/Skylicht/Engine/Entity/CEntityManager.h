@@ -28,6 +28,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "IRenderSystem.h"
 #include "CEntity.h"
 #include "CEntityGroup.h"
+#include "CEntityDataAllocator.h"
 
 #include "GameObject/CGameObject.h"
 #include "Camera/CCamera.h"
@@ -108,11 +109,14 @@ namespace Skylicht
 		bool m_systemChanged;
 		bool m_rendererChanged;
 		bool m_needSortEntities;
+		bool m_parallelUpdate;
 
 		CCamera* m_camera;
 
 		IRenderPipeline* m_renderPipeline;
 
+		CEntityDataAllocator* m_dataAllocator;
+
 	public:
 		CEntityManager();
 
@@ -128,10 +132,24 @@ namespace Skylicht
 
 		void updateRenderer();
 
+		/// @brief Update the systems on the job threads by their declared data access
+		/// @see IEntitySystem::getDataAccess, System::CJobScheduler
+		inline void setParallelUpdate(bool b)
+		{
+			m_parallelUpdate = b;
+		}
+
+		inline bool isParallelUpdate()
+		{
+			return m_parallelUpdate;
+		}
+
 	protected:
 
 		int getDepth(CWorldTransformData* t);
 
+		void updateSystemsParallel(CEntity** entities, int numEntity);
+
 		void sortAliveEntities();
 
 	public:
@@ -160,6 +178,27 @@ namespace Skylicht
 			return m_renderPipeline;
 		}
 
+		/// @brief Store the IEntityData of entities in contiguous chunks per data type
+		/// @param b true to enable the chunk storage mode.
+		/// @return false if the entity manager already has entities, the storage mode can't be changed.
+		/**
+		 * The data of entities that created together will be allocated next to each other,
+		 * this reduces the cache misses when the systems iterate their groups.
+		 * The data still be accessed by GET_ENTITY_DATA as the default mode.
+		 * @see CEntityDataAllocator
+		 */
+		bool setUseChunkStorage(bool b);
+
+		inline bool isUseChunkStorage()
+		{
+			return m_dataAllocator != NULL;
+		}
+
+		inline CEntityDataAllocator* getDataAllocator()
+		{
+			return m_dataAllocator;
+		}
+
 		CEntity* createEntity();
 
 		CEntity** createEntity(int num, core::array<CEntity*>& entities);
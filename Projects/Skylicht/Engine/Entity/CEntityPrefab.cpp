@@ -4,7 +4,8 @@
 
 namespace Skylicht
 {
-	CEntityPrefab::CEntityPrefab()
+	CEntityPrefab::CEntityPrefab() :
+		m_revision(0)
 	{
 
 	}
@@ -16,6 +17,8 @@ namespace Skylicht
 
 	CEntity* CEntityPrefab::createEntity()
 	{
+		m_revision++;
+
 		if (m_unused.size() > 0)
 		{
 			int last = (int)m_unused.size() - 1;
@@ -37,6 +40,8 @@ namespace Skylicht
 		entities.reallocate(num);
 		entities.set_used(0);
 
+		m_revision++;
+
 		for (int i = 0; i < num; i++)
 		{
 			CEntity* entity = new CEntity(this);
@@ -59,6 +64,8 @@ namespace Skylicht
 
 		m_entities.set_used(0);
 		m_unused.set_used(0);
+
+		m_revision++;
 	}
 
 	void CEntityPrefab::removeEntity(u32 index)
@@ -69,6 +76,7 @@ namespace Skylicht
 			entity->setAlive(false);
 			entity->removeAllData();
 			m_unused.push_back(entity);
+			m_revision++;
 		}
 	}
 
@@ -79,6 +87,7 @@ namespace Skylicht
 			entity->setAlive(false);
 			entity->removeAllData();
 			m_unused.push_back(entity);
+			m_revision++;
 		}
 	}
 
@@ -88,6 +97,8 @@ namespace Skylicht
 		transformData->Relative = transform;
 		transformData->Name = name;
 
+		m_revision++;
+
 		// add parent relative
 		if (parent != NULL)
 		{
@@ -102,6 +113,8 @@ namespace Skylicht
 		if (!transformData)
 			return;
 
+		m_revision++;
+
 		if (parent != NULL)
 		{
 			transformData->ParentIndex = parent->getIndex();
@@ -40,6 +40,8 @@ namespace Skylicht
 		core::array<CEntity*> m_entities;
 		core::array<CEntity*> m_unused;
 
+		u32 m_revision;
+
 	public:
 		CEntityPrefab();
 
@@ -70,6 +72,12 @@ namespace Skylicht
 			return m_entities[index];
 		}
 
+		/// Changed when an entity is created, removed or changes its parent
+		inline u32 getRevision()
+		{
+			return m_revision;
+		}
+
 		void addTransformData(CEntity* entity, CEntity* parent, const core::matrix4& transform, const char* name);
 
 		void changeParent(CEntity* entity, CEntity* parent);
@@ -73,6 +73,26 @@ namespace Skylicht
 
 		virtual void update(CEntityManager* entityManager) = 0;
 
+		/// @brief Declare the entity data types that this system reads and writes in onQuery and update.
+		/// @param read bit mask of data types that are read, see DATA_TYPE_MASK
+		/// @param write bit mask of data types that are written
+		/// @return false if the system does not declare its data access, it will be updated on the main thread and wait all the systems before it.
+		/**
+		 * When CEntityManager::setParallelUpdate is enabled, the systems that have no conflict data access will be updated concurrently on the job threads.
+		 * @code
+		 * virtual bool getDataAccess(u64& read, u64& write)
+		 * {
+		 *	read = DATA_TYPE_MASK(CWorldTransformData);
+		 *	write = DATA_TYPE_MASK(CWorldInverseTransformData);
+		 *	return true;
+		 * }
+		 * @endcode
+		 */
+		virtual bool getDataAccess(u64& read, u64& write)
+		{
+			return false;
+		}
+
 		inline void setSystemOrder(int order)
 		{
 			m_systemOrder = order;
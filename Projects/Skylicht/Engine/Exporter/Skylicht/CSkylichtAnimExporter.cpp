@@ -31,7 +31,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
-	CSkylichtAnimExporter::CSkylichtAnimExporter()
+	CSkylichtAnimExporter::CSkylichtAnimExporter() :
+		m_compress(false)
 	{
 
 	}
@@ -50,11 +51,22 @@ namespace Skylicht
 		if (writeFile == NULL)
 			return false;
 
+		// the released keys are only in the compressed track
+		bool compress = m_compress;
+		for (u32 i = 0, n = (u32)clip->AnimInfo.size(); i < n && !compress; i++)
+		{
+			if (clip->AnimInfo[i]->Data.isReleasedKeys())
+			{
+				os::Printer::log("CSkylichtAnimExporter: the keys are released, export the compressed tracks");
+				compress = true;
+			}
+		}
+
 		// write header
 		SAssetHeader assetHeader;
 		strcpy(assetHeader.Sign, "SLT");
 		assetHeader.AssetType = (u32)AssetAnimation;
-		assetHeader.AssetVersion = 1;
+		assetHeader.AssetVersion = compress ? 3 : 2;
 		writeFile->write(&assetHeader, sizeof(SAssetHeader));
 
 		// init memory (it will grow later)
@@ -70,6 +82,9 @@ namespace Skylicht
 		// flush to file
 		writeFile->write(memoryAnim.getData(), memoryAnim.getSize());
 
+		// the key arrays are aligned in the file, that the loader copies them at once
+		u32 filePos = sizeof(SAssetHeader) + memoryAnim.getSize();
+
 		for (u32 i = 0; i < count; i++)
 		{
 			SEntityAnim* entityAnim = clip->AnimInfo[i];
@@ -77,6 +92,29 @@ namespace Skylicht
 			memoryAnim.resetWrite();
 			memoryAnim.writeString(entityAnim->Name);
 
+			if (compress)
+			{
+				CAnimationData& data = entityAnim->Data;
+				memoryAnim.writeFloatArray(&data.Positions.Default.X, 3);
+				memoryAnim.writeFloatArray(&data.Rotations.Default.X, 4);
+				memoryAnim.writeFloatArray(&data.Scales.Default.X, 3);
+
+				// use the compressed track if the keys are released
+				CCompressedAnimationTrack compressed;
+				CCompressedAnimationTrack* track = data.Compressed;
+				if (!data.isReleasedKeys())
+				{
+					compressed.compress(&data, m_compressSetting);
+					track = &compressed;
+				}
+
+				track->serializable(&memoryAnim);
+
+				writeFile->write(memoryAnim.getData(), memoryAnim.getSize());
+				filePos += memoryAnim.getSize();
+				continue;
+			}
+
 			// position
 			CArrayKeyFrame<core::vector3df>& positions = entityAnim->Data.Positions;
 
@@ -85,12 +123,8 @@ namespace Skylicht
 			u32 numKey = positions.size();
 			memoryAnim.writeUInt(numKey);
 
-			for (u32 j = 0; j < numKey; j++)
-			{
-				const CPositionKey& posKey = positions.Data[j];
-				memoryAnim.writeFloat(posKey.Frame);
-				memoryAnim.writeFloatArray(&posKey.Value.X, 3);
-			}
+			memoryAnim.writePadding(16, filePos);
+			memoryAnim.writeData(positions.pointer(), numKey * sizeof(CPositionKey));
 
 			// rotation
 			CArrayKeyFrame<core::quaternion>& rotations = entityAnim->Data.Rotations;
@@ -100,12 +134,8 @@ namespace Skylicht
 			numKey = rotations.size();
 			memoryAnim.writeUInt(numKey);
 
-			for (u32 j = 0; j < numKey; j++)
-			{
-				const CRotationKey& rotKey = rotations.Data[j];
-				memoryAnim.writeFloat(rotKey.Frame);
-				memoryAnim.writeFloatArray(&rotKey.Value.X, 4);
-			}
+			memoryAnim.writePadding(16, filePos);
+			memoryAnim.writeData(rotations.pointer(), numKey * sizeof(CRotationKey));
 
 			// scale
 			CArrayKeyFrame<core::vector3df>& scales = entityAnim->Data.Scales;
@@ -115,15 +145,12 @@ namespace Skylicht
 			numKey = scales.size();
 			memoryAnim.writeUInt(numKey);
 
-			for (u32 j = 0; j < numKey; j++)
-			{
-				const CScaleKey& scaleKey = scales.Data[j];
-				memoryAnim.writeFloat(scaleKey.Frame);
-				memoryAnim.writeFloatArray(&scaleKey.Value.X, 3);
-			}
+			memoryAnim.writePadding(16, filePos);
+			memoryAnim.writeData(scales.pointer(), numKey * sizeof(CScaleKey));
 
 			// flush data to file
 			writeFile->write(memoryAnim.getData(), memoryAnim.getSize());
+			filePos += memoryAnim.getSize();
 		}
 
 		writeFile->drop();
@@ -25,16 +25,33 @@ https://github.com/skylicht-lab/skylicht-engine
 #pragma once
 
 #include "Exporter/IAnimationExporter.h"
+#include "Animation/CCompressedAnimationTrack.h"
 
 namespace Skylicht
 {
 	class SKYLICHT_API CSkylichtAnimExporter : public IAnimationExporter
 	{
+	protected:
+		bool m_compress;
+
+		SAnimationCompressSetting m_compressSetting;
+
 	public:
 		CSkylichtAnimExporter();
 
 		virtual ~CSkylichtAnimExporter();
 
 		virtual bool exportAnim(CAnimationClip* clip, const char* output);
+
+		/**
+		 * @brief Export the compressed tracks (asset version 3), see CCompressedAnimationTrack.
+		 * @param compress Enable the compression.
+		 * @param setting Sample rate and the error bounds.
+		 */
+		void setCompression(bool compress, const SAnimationCompressSetting& setting = SAnimationCompressSetting())
+		{
+			m_compress = compress;
+			m_compressSetting = setting;
+		}
 	};
 }
\ No newline at end of file
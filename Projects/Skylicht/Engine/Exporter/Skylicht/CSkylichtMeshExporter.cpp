@@ -54,12 +54,15 @@ namespace Skylicht
 		SAssetHeader assetHeader;
 		strcpy(assetHeader.Sign, "SLT");
 		assetHeader.AssetType = (u32)AssetModel;
-		assetHeader.AssetVersion = 1;
+		assetHeader.AssetVersion = 2;
 		writeFile->write(&assetHeader, sizeof(SAssetHeader));
 
 		// write num of entities
 		writeFile->write(&count, sizeof(u32));
 
+		// the data blocks are aligned in the file, that the loader can read them from the mapped memory
+		u32 filePos = sizeof(SAssetHeader) + sizeof(u32);
+
 		// init memory (it will grow later)
 		CMemoryStream memoryEntity(512);
 		CMemoryStream memoryData(512);
@@ -101,8 +104,9 @@ namespace Skylicht
 					// size
 					memoryEntity.writeInt(memoryData.getSize());
 
-					// name					
+					// name
 					memoryEntity.writeString(typeName);
+					memoryEntity.writePadding(16, filePos);
 
 					// data
 					memoryEntity.writeStream(&memoryData);
@@ -122,6 +126,7 @@ namespace Skylicht
 
 			// flush data to file
 			writeFile->write(memoryEntity.getData(), memoryEntity.getSize());
+			filePos += memoryEntity.getSize();
 		}
 
 		writeFile->drop();
@@ -174,7 +174,8 @@ namespace Skylicht
 		if (m_needUpdateTexture)
 		{
 			void *data = m_texture->lock();
-			memcpy(data, m_image->lock(), m_width * m_height * 4);
+			if (data != NULL)
+				memcpy(data, m_image->lock(), m_width * m_height * 4);
 			m_texture->unlock();
 			m_texture->regenerateMipMapLevels();
 			m_needUpdateTexture = false;
@@ -0,0 +1,228 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CRuntimeAtlas.h"
+
+namespace Skylicht
+{
+	CRuntimeAtlas::CRuntimeAtlas(int atlasSize, int maxTextureSize) :
+		m_atlasSize(atlasSize),
+		m_maxTextureSize(maxTextureSize),
+		m_revision(0)
+	{
+
+	}
+
+	CRuntimeAtlas::~CRuntimeAtlas()
+	{
+		clear();
+	}
+
+	void CRuntimeAtlas::clear()
+	{
+		for (CAtlas* a : m_atlas)
+			delete a;
+		m_atlas.clear();
+
+		for (std::map<ITexture*, SSlot>::iterator i = m_slots.begin(), end = m_slots.end(); i != end; i++)
+			i->first->drop();
+		m_slots.clear();
+
+		for (ITexture* texture : m_skip)
+			texture->drop();
+		m_skip.clear();
+
+		m_revision++;
+	}
+
+	void CRuntimeAtlas::releaseTexture(ITexture* texture)
+	{
+		std::map<ITexture*, SSlot>::iterator i = m_slots.find(texture);
+		if (i != m_slots.end())
+		{
+			m_slots.erase(i);
+			texture->drop();
+			m_revision++;
+		}
+
+		std::set<ITexture*>::iterator j = m_skip.find(texture);
+		if (j != m_skip.end())
+		{
+			m_skip.erase(j);
+			texture->drop();
+		}
+	}
+
+	CRuntimeAtlas::SSlot* CRuntimeAtlas::getSlot(ITexture* texture)
+	{
+		std::map<ITexture*, SSlot>::iterator i = m_slots.find(texture);
+		if (i != m_slots.end())
+		{
+			SSlot& slot = i->second;
+			if (slot.ChangedID == texture->getChangedID())
+				return &slot;
+
+			// the pixels have changed, copy them again to the same area if the size is not changed
+			const core::dimension2du& size = texture->getSize();
+			if ((int)size.Width == slot.Rect.getWidth() && (int)size.Height == slot.Rect.getHeight())
+			{
+				IImage* image = readTexture(texture);
+				if (image)
+				{
+					copyImage(image, slot.Atlas, slot.Rect);
+					image->drop();
+
+					slot.ChangedID = texture->getChangedID();
+					return &slot;
+				}
+			}
+
+			releaseTexture(texture);
+		}
+
+		if (m_skip.find(texture) != m_skip.end())
+			return NULL;
+
+		// keep the texture, so its address is not reused by another texture
+		texture->grab();
+
+		SSlot slot;
+		if (!packTexture(texture, slot))
+		{
+			m_skip.insert(texture);
+			return NULL;
+		}
+
+		SSlot& result = m_slots[texture];
+		result = slot;
+		return &result;
+	}
+
+	IImage* CRuntimeAtlas::readTexture(ITexture* texture)
+	{
+		const core::dimension2du& size = texture->getSize();
+		int w = (int)size.Width;
+		int h = (int)size.Height;
+
+		if (w == 0 || h == 0 || w > m_maxTextureSize || h > m_maxTextureSize)
+			return NULL;
+
+		ECOLOR_FORMAT format = texture->getColorFormat();
+		if (texture->isRenderTarget() ||
+			IImage::isCompressedFormat(format) ||
+			IImage::isRenderTargetOnlyFormat(format))
+			return NULL;
+
+		// read back the pixels
+		void* data = texture->lock(video::ETLM_READ_ONLY);
+		if (data == NULL)
+		{
+			texture->unlock();
+			return NULL;
+		}
+
+		IImage* image = getVideoDriver()->createImageFromData(format, size, data, false, true);
+		texture->unlock();
+		return image;
+	}
+
+	bool CRuntimeAtlas::packTexture(ITexture* texture, SSlot& slot)
+	{
+		IImage* image = readTexture(texture);
+		if (image == NULL)
+			return false;
+
+		const core::dimension2du& size = image->getDimension();
+		int w = (int)size.Width;
+		int h = (int)size.Height;
+
+		int cellW = w;
+		int cellH = h;
+		CAtlas::calcCellSize(&cellW, &cellH);
+
+		CAtlas* atlas = NULL;
+		core::recti region;
+
+		for (CAtlas* a : m_atlas)
+		{
+			region = a->createRect(cellW, cellH);
+			if (region.getWidth() != 0 && region.getHeight() != 0)
+			{
+				atlas = a;
+				break;
+			}
+		}
+
+		if (atlas == NULL)
+		{
+			atlas = new CAtlas(ECF_A8R8G8B8, m_atlasSize, m_atlasSize);
+			m_atlas.push_back(atlas);
+
+			region = atlas->createRect(cellW, cellH);
+		}
+
+		// 1 pixel border
+		int x = region.UpperLeftCorner.X + 1;
+		int y = region.UpperLeftCorner.Y + 1;
+
+		slot.Atlas = atlas;
+		slot.Rect = core::recti(x, y, x + w, y + h);
+		slot.ChangedID = texture->getChangedID();
+
+		copyImage(image, atlas, slot.Rect);
+		image->drop();
+
+		float s = (float)m_atlasSize;
+		slot.UV.UpperLeftCorner.set(x / s, y / s);
+		slot.UV.LowerRightCorner.set((x + w) / s, (y + h) / s);
+		return true;
+	}
+
+	void CRuntimeAtlas::copyImage(IImage* image, CAtlas* atlas, const core::recti& region)
+	{
+		int x = region.UpperLeftCorner.X;
+		int y = region.UpperLeftCorner.Y;
+		int w = region.getWidth();
+		int h = region.getHeight();
+
+		atlas->bitBltImage(image, x, y);
+
+		// extrude the edges to the border, that avoid the bleeding of the near texture on linear filter
+		IImage* target = atlas->getImage();
+		image->copyTo(target, core::vector2di(x - 1, y), core::recti(0, 0, 1, h));
+		image->copyTo(target, core::vector2di(x + w, y), core::recti(w - 1, 0, w, h));
+		image->copyTo(target, core::vector2di(x, y - 1), core::recti(0, 0, w, 1));
+		image->copyTo(target, core::vector2di(x, y + h), core::recti(0, h - 1, w, h));
+	}
+
+	void CRuntimeAtlas::updateTextures()
+	{
+		for (CAtlas* a : m_atlas)
+		{
+			if (a->needUpdateTexture())
+				a->updateTexture();
+		}
+	}
+}
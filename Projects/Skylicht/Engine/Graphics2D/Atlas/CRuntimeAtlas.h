@@ -0,0 +1,132 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CAtlas.h"
+#include <set>
+
+namespace Skylicht
+{
+	/**
+	 * @brief Packs small standalone textures into shared atlases at runtime, so CGraphics2D can draw them in one batch.
+	 * @ingroup Graphics2D
+	 *
+	 * The pixels of a texture are copied into the atlas when it is first drawn, so the atlas holds a frozen copy of the texture.
+	 * A texture written by lock() and unlock() is copied again on its next draw (ITexture::getChangedID),
+	 * the other updates (ex: a render to texture, a texture re-created at the same size) must call releaseTexture.
+	 * The textures are kept (grab) until releaseTexture or clear, so their addresses are not reused by another texture.
+	 * The textures that are too big, compressed, render target or can not be locked are not packed.
+	 *
+	 * @see CGraphics2D::setEnableRuntimeAtlas
+	 */
+	class SKYLICHT_API CRuntimeAtlas
+	{
+	public:
+		struct SSlot
+		{
+			CAtlas* Atlas;
+			core::recti Rect;
+			core::rectf UV;
+			u32 ChangedID;
+		};
+
+	protected:
+		int m_atlasSize;
+		int m_maxTextureSize;
+
+		std::vector<CAtlas*> m_atlas;
+
+		std::map<ITexture*, SSlot> m_slots;
+
+		std::set<ITexture*> m_skip;
+
+		u32 m_revision;
+
+	public:
+		CRuntimeAtlas(int atlasSize = 2048, int maxTextureSize = 256);
+
+		virtual ~CRuntimeAtlas();
+
+		/**
+		 * @brief Get the atlas slot of a texture, the texture is packed when it is first used, and copied again when its pixels have changed.
+		 * @param texture The source texture.
+		 * @return The slot, or NULL if the texture can not be packed.
+		 */
+		SSlot* getSlot(ITexture* texture);
+
+		/**
+		 * @brief Remove a texture from the atlas and drop it, the texture is packed again on its next draw.
+		 * The area of the texture in the atlas is not reused until clear.
+		 * @param texture The source texture.
+		 */
+		void releaseTexture(ITexture* texture);
+
+		/**
+		 * @brief Remove all the atlases and drop all the textures.
+		 */
+		void clear();
+
+		/**
+		 * @brief Upload the atlases that have new textures.
+		 */
+		void updateTextures();
+
+		inline int getAtlasSize()
+		{
+			return m_atlasSize;
+		}
+
+		inline u32 getNumAtlas()
+		{
+			return (u32)m_atlas.size();
+		}
+
+		inline CAtlas* getAtlas(u32 i)
+		{
+			return m_atlas[i];
+		}
+
+		/**
+		 * @brief The revision is increased when the textures are released, the UV and atlas of a released texture are not valid.
+		 */
+		inline u32 getRevision()
+		{
+			return m_revision;
+		}
+
+		inline u32 getNumTexture()
+		{
+			return (u32)m_slots.size();
+		}
+
+	protected:
+
+		bool packTexture(ITexture* texture, SSlot& slot);
+
+		IImage* readTexture(ITexture* texture);
+
+		void copyImage(IImage* image, CAtlas* atlas, const core::recti& region);
+	};
+}
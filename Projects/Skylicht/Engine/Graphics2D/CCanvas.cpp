@@ -39,6 +39,8 @@ namespace Skylicht
 		m_scaleGUI(1.0f),
 		m_haveScaleGUI(false),
 		m_is3DBillboard(false),
+		m_enableRenderCache(false),
+		m_entityRevision(0),
 		m_renderCamera(NULL),
 		m_currentMask(NULL),
 		IsInEditor(false),
@@ -119,45 +121,51 @@ namespace Skylicht
 
 	void CCanvas::updateEntities()
 	{
-		for (u32 i = 0; i < MAX_ENTITY_DEPTH; i++)
+		// the depth order only changes when an element is added, removed or moved to another parent
+		u32 revision = m_entityMgr->getRevision();
+		if (revision != m_entityRevision || m_alives.count() == 0)
 		{
-			m_depth[i].reset();
-		}
+			m_entityRevision = revision;
+
+			for (u32 i = 0; i < MAX_ENTITY_DEPTH; i++)
+			{
+				m_depth[i].reset();
+			}
 
-		CEntity** entities = m_entityMgr->getEntities();
-		int numEntity = m_entityMgr->getNumEntities();
+			CEntity** entities = m_entityMgr->getEntities();
+			int numEntity = m_entityMgr->getNumEntities();
 
-		int maxDepth = 0;
+			int maxDepth = 0;
 
-		for (int i = 0; i < numEntity; i++)
-		{
-			CEntity* entity = entities[i];
-			if (entity->isAlive())
+			for (int i = 0; i < numEntity; i++)
 			{
-				CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+				CEntity* entity = entities[i];
+				if (entity->isAlive())
+				{
+					CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
 
-				m_depth[world->Depth].push(entity);
+					m_depth[world->Depth].push(entity);
 
-				if (maxDepth < world->Depth)
-					maxDepth = world->Depth;
+					if (maxDepth < world->Depth)
+						maxDepth = world->Depth;
 
-				if (world->ParentIndex != -1)
-					world->Parent = GET_ENTITY_DATA(entities[world->ParentIndex], CWorldTransformData);
-				else
-					world->Parent = NULL;
+					if (world->ParentIndex != -1)
+						world->Parent = GET_ENTITY_DATA(entities[world->ParentIndex], CWorldTransformData);
+					else
+						world->Parent = NULL;
+				}
 			}
-		}
 
-		m_alives.reset();
+			m_alives.reset();
 
-		// copy and sort the alives by depth
-		int count = 0;
-		for (int i = 0; i <= maxDepth; i++)
-		{
-			CEntity** entitiesPtr = m_depth[i].pointer();
+			// copy and sort the alives by depth
+			for (int i = 0; i <= maxDepth; i++)
+			{
+				CEntity** entitiesPtr = m_depth[i].pointer();
 
-			for (int j = 0, n = m_depth[i].count(); j < n; j++)
-				m_alives.push(entitiesPtr[j]);
+				for (int j = 0, n = m_depth[i].count(); j < n; j++)
+					m_alives.push(entitiesPtr[j]);
+			}
 		}
 
 		// update systems
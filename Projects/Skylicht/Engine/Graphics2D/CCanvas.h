@@ -99,6 +99,12 @@ namespace Skylicht
 		/// Enable 3D billboard rendering for the canvas.
 		bool m_is3DBillboard;
 
+		/// Elements keep their generated geometry and only regenerate it when changed.
+		bool m_enableRenderCache;
+
+		/// The entity revision of the last sort by depth.
+		u32 m_entityRevision;
+
 		/// The world transform used for rendering.
 		core::matrix4 m_renderWorldTransform;
 
@@ -284,6 +290,27 @@ namespace Skylicht
 			return m_is3DBillboard;
 		}
 
+		/**
+		 * @brief Enable or disable the render cache (retained mode).
+		 *
+		 * Each image, sprite and text element keeps the vertices it generated and copies them to the batch
+		 * while its transform, rect, color and content do not change. This suits the HUD that rarely changes.
+		 * @param b True to enable.
+		 */
+		inline void setEnableRenderCache(bool b)
+		{
+			m_enableRenderCache = b;
+		}
+
+		/**
+		 * @brief Check if the render cache is enabled.
+		 * @return True if enabled.
+		 */
+		inline bool isRenderCacheEnabled()
+		{
+			return m_enableRenderCache;
+		}
+
 		/**
 		 * @brief Remove all GUI elements from the canvas.
 		 */
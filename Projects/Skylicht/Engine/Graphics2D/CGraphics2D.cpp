@@ -27,14 +27,16 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CCanvas.h"
 
 #include "CGraphics2D.h"
+#include "Atlas/CRuntimeAtlas.h"
 #include "Material/Shader/CShaderManager.h"
 #include "Material/Shader/ShaderCallback/CShaderMaterial.h"
 
 // camera transform
 #include "GameObject/CGameObject.h"
 
-#define MAX_VERTICES (1024*4)
-#define MAX_INDICES	(1024*6)
+// the limit of 16bit index
+#define MAX_VERTICES (1024*64)
+#define MAX_INDICES	(1024*96)
 
 namespace Skylicht
 {
@@ -44,7 +46,13 @@ namespace Skylicht
 		m_currentW(-1),
 		m_currentH(-1),
 		m_vertexColorShader(0),
-		m_bufferID(0)
+		m_bufferID(0),
+		m_cache(NULL),
+		m_cacheVertex(0),
+		m_cacheIndex(0),
+		m_runtimeAtlas(NULL),
+		m_enableRuntimeAtlas(false),
+		m_drawCall(0)
 	{
 		m_driver = getVideoDriver();
 
@@ -74,6 +82,9 @@ namespace Skylicht
 		}
 
 		m_allBuffers.clear();
+
+		if (m_runtimeAtlas)
+			delete m_runtimeAtlas;
 	}
 
 	void CGraphics2D::resize()
@@ -125,6 +136,10 @@ namespace Skylicht
 		std::vector<CCanvas*>::iterator i = std::find(m_canvas.begin(), m_canvas.end(), canvas);
 		if (i != m_canvas.end())
 			m_canvas.erase(i);
+
+		// the scene or canvas is unloaded, release the textures of the runtime atlas
+		if (m_canvas.size() == 0)
+			clearRuntimeAtlas();
 	}
 
 	void CGraphics2D::render(CCamera* camera)
@@ -293,6 +308,7 @@ namespace Skylicht
 
 	void CGraphics2D::prepareBuffer()
 	{
+		m_drawCall = 0;
 		m_bufferID = 0;
 		m_buffer = m_allBuffers[m_bufferID];
 		m_vertices = (SVertexBuffer*)m_buffer->getVertexBuffer();
@@ -331,6 +347,12 @@ namespace Skylicht
 
 		if (indices->getIndexCount() > 0 && vertices->getVertexCount() > 0)
 		{
+			m_drawCall++;
+
+			// upload the new packed textures
+			if (m_runtimeAtlas)
+				m_runtimeAtlas->updateTextures();
+
 			// set shader if default
 			if (material.MaterialType > 0)
 			{
@@ -357,6 +379,9 @@ namespace Skylicht
 		if (m_vertexColorShader == 0)
 			m_vertexColorShader = CShaderManager::getInstance()->getShaderIDByName("VertexColorAlpha");
 
+		if (m_cache)
+			recordCache(NULL);
+
 		flushBuffer(m_buffer, m_2dMaterial);
 	}
 
@@ -371,9 +396,164 @@ namespace Skylicht
 		m_customMaterial.ZBuffer = m_2dMaterial.ZBuffer;
 		m_customMaterial.ZWriteEnable = m_2dMaterial.ZWriteEnable;
 
+		if (m_cache)
+			recordCache(material);
+
 		flushBuffer(m_buffer, m_customMaterial);
 	}
 
+	void CGraphics2D::beginCache(CGraphics2DCache* cache)
+	{
+		m_cache = cache;
+		m_cache->clear();
+
+		m_cacheVertex = m_vertices->getVertexCount();
+		m_cacheIndex = m_indices->getIndexCount();
+	}
+
+	void CGraphics2D::endCache()
+	{
+		if (m_cache)
+			recordCache(NULL);
+
+		m_cache = NULL;
+	}
+
+	void CGraphics2D::recordCache(CMaterial* material)
+	{
+		u32 numVertices = m_vertices->getVertexCount();
+		u32 numIndices = m_indices->getIndexCount();
+
+		if (numVertices > m_cacheVertex && numIndices > m_cacheIndex)
+		{
+			CGraphics2DCache::SBatch batch;
+			batch.Texture = m_2dMaterial.getTexture(0);
+			batch.ShaderID = m_2dMaterial.MaterialType;
+			batch.Material = material;
+			batch.VertexBegin = m_cache->Vertices.size();
+			batch.VertexCount = numVertices - m_cacheVertex;
+			batch.IndexBegin = m_cache->Indices.size();
+			batch.IndexCount = numIndices - m_cacheIndex;
+
+			m_cache->Vertices.set_used(batch.VertexBegin + batch.VertexCount);
+			m_cache->Indices.set_used(batch.IndexBegin + batch.IndexCount);
+
+			S3DVertex* vertices = (S3DVertex*)m_vertices->getVertices();
+			memcpy(m_cache->Vertices.pointer() + batch.VertexBegin, vertices + m_cacheVertex, batch.VertexCount * sizeof(S3DVertex));
+
+			// the cached indices are relative to the first vertex of the batch
+			u16* indices = (u16*)m_indices->getIndices();
+			u16* cacheIndices = m_cache->Indices.pointer() + batch.IndexBegin;
+			for (u32 i = 0; i < batch.IndexCount; i++)
+				cacheIndices[i] = indices[m_cacheIndex + i] - (u16)m_cacheVertex;
+
+			m_cache->Batches.push_back(batch);
+		}
+
+		// the buffer is cleared after flush
+		m_cacheVertex = 0;
+		m_cacheIndex = 0;
+	}
+
+	void CGraphics2D::addCacheBatch(CGraphics2DCache* cache)
+	{
+		S3DVertex* cacheVertices = cache->Vertices.pointer();
+		u16* cacheIndices = cache->Indices.pointer();
+
+		for (u32 i = 0, n = cache->Batches.size(); i < n; i++)
+		{
+			CGraphics2DCache::SBatch& batch = cache->Batches[i];
+
+			if (m_2dMaterial.getTexture(0) != batch.Texture || m_2dMaterial.MaterialType != batch.ShaderID || batch.Material != NULL)
+				flush();
+
+			int numVertices = m_vertices->getVertexCount();
+			int numVerticesUse = numVertices + batch.VertexCount;
+			int numIndex = m_indices->getIndexCount();
+			int numIndexUse = numIndex + batch.IndexCount;
+
+			if (numVerticesUse > MAX_VERTICES || numIndexUse > MAX_INDICES)
+			{
+				flush();
+				numVertices = 0;
+				numIndex = 0;
+				numVerticesUse = batch.VertexCount;
+				numIndexUse = batch.IndexCount;
+			}
+
+			m_vertices->set_used(numVerticesUse);
+			S3DVertex* vertices = (S3DVertex*)m_vertices->getVertices();
+			memcpy(vertices + numVertices, cacheVertices + batch.VertexBegin, batch.VertexCount * sizeof(S3DVertex));
+
+			m_indices->set_used(numIndexUse);
+			u16* index = (u16*)m_indices->getIndices();
+			u16* src = cacheIndices + batch.IndexBegin;
+			for (u32 j = 0; j < batch.IndexCount; j++)
+				index[numIndex + j] = numVertices + src[j];
+
+			m_2dMaterial.setTexture(0, batch.Texture);
+			m_2dMaterial.MaterialType = batch.ShaderID;
+
+			m_buffer->setDirty();
+
+			if (batch.Material != NULL)
+				flushWithMaterial(batch.Material);
+		}
+	}
+
+	void CGraphics2D::setEnableRuntimeAtlas(bool b)
+	{
+		m_enableRuntimeAtlas = b;
+
+		if (m_enableRuntimeAtlas && m_runtimeAtlas == NULL)
+			m_runtimeAtlas = new CRuntimeAtlas();
+		else if (!m_enableRuntimeAtlas)
+			clearRuntimeAtlas();
+	}
+
+	void CGraphics2D::releaseRuntimeAtlasTexture(ITexture* texture)
+	{
+		if (m_runtimeAtlas)
+			m_runtimeAtlas->releaseTexture(texture);
+	}
+
+	void CGraphics2D::clearRuntimeAtlas()
+	{
+		if (m_runtimeAtlas)
+			m_runtimeAtlas->clear();
+	}
+
+	u32 CGraphics2D::getRuntimeAtlasRevision()
+	{
+		return m_runtimeAtlas ? m_runtimeAtlas->getRevision() : 0;
+	}
+
+	ITexture* CGraphics2D::getAtlasTexture(ITexture* img, core::rectf& uv)
+	{
+		if (!m_enableRuntimeAtlas)
+			return img;
+
+		// the atlas can not repeat the texture
+		if (uv.UpperLeftCorner.X < 0.0f || uv.UpperLeftCorner.Y < 0.0f ||
+			uv.LowerRightCorner.X > 1.0f || uv.LowerRightCorner.Y > 1.0f)
+			return img;
+
+		CRuntimeAtlas::SSlot* slot = m_runtimeAtlas->getSlot(img);
+		if (slot == NULL)
+			return img;
+
+		const core::rectf& r = slot->UV;
+		float w = r.getWidth();
+		float h = r.getHeight();
+
+		uv.UpperLeftCorner.X = r.UpperLeftCorner.X + uv.UpperLeftCorner.X * w;
+		uv.UpperLeftCorner.Y = r.UpperLeftCorner.Y + uv.UpperLeftCorner.Y * h;
+		uv.LowerRightCorner.X = r.UpperLeftCorner.X + uv.LowerRightCorner.X * w;
+		uv.LowerRightCorner.Y = r.UpperLeftCorner.Y + uv.LowerRightCorner.Y * h;
+
+		return slot->Atlas->getTexture();
+	}
+
 	void CGraphics2D::addExternalBuffer(IMeshBuffer* meshBuffer, const core::matrix4& absoluteMatrix, int shaderID, CMaterial* material)
 	{
 		if (m_2dMaterial.MaterialType != shaderID || material != NULL)
@@ -398,8 +578,8 @@ namespace Skylicht
 			flush();
 			numVertices = 0;
 			numIndex = 0;
-			numVerticesUse = 6;
-			numIndexUse = 4;
+			numVerticesUse = numVtx;
+			numIndexUse = numIdx;
 		}
 
 		m_indices->set_used(numIndexUse);
@@ -428,11 +608,14 @@ namespace Skylicht
 
 	void CGraphics2D::addImageBatch(ITexture* img, const SColor& color, const core::matrix4& absoluteMatrix, int shaderID, CMaterial* material, float pivotX, float pivotY)
 	{
-		if (m_2dMaterial.getTexture(0) != img || m_2dMaterial.MaterialType != shaderID || material != NULL)
+		core::rectf uv(0.0f, 0.0f, 1.0f, 1.0f);
+		ITexture* tex = material == NULL ? getAtlasTexture(img, uv) : img;
+
+		if (m_2dMaterial.getTexture(0) != tex || m_2dMaterial.MaterialType != shaderID || material != NULL)
 			flush();
 
 		int numVertices = m_vertices->getVertexCount();
-		int numVerticesUse = numVertices + 6;
+		int numVerticesUse = numVertices + 4;
 		int numIndex = m_indices->getIndexCount();
 		int numIndexUse = numIndex + 6;
 
@@ -441,8 +624,8 @@ namespace Skylicht
 			flush();
 			numVertices = 0;
 			numIndex = 0;
-			numVerticesUse = 6;
-			numIndexUse = 4;
+			numVerticesUse = 4;
+			numIndexUse = 6;
 		}
 
 		m_indices->set_used(numIndexUse);
@@ -463,17 +646,22 @@ namespace Skylicht
 		pos.LowerRightCorner.X = pos.UpperLeftCorner.X + (f32)img->getSize().Width;
 		pos.LowerRightCorner.Y = pos.UpperLeftCorner.Y + (f32)img->getSize().Height;
 
+		float tx1 = uv.UpperLeftCorner.X;
+		float ty1 = uv.UpperLeftCorner.Y;
+		float tx2 = uv.LowerRightCorner.X;
+		float ty2 = uv.LowerRightCorner.Y;
+
 		// add vertices
-		vertices[numVertices + 0] = S3DVertex(pos.UpperLeftCorner.X, pos.UpperLeftCorner.Y, 0.0f, 0.0f, 0.0f, 1.0f, color, 0.0f, 0.0f);
-		vertices[numVertices + 1] = S3DVertex(pos.LowerRightCorner.X, pos.UpperLeftCorner.Y, 0.0f, 1.0f, 0.0f, 1.0f, color, 1.0f, 0.0f);
-		vertices[numVertices + 2] = S3DVertex(pos.LowerRightCorner.X, pos.LowerRightCorner.Y, 0.0f, 1.0f, 1.0f, 1.0f, color, 1.0f, 1.0f);
-		vertices[numVertices + 3] = S3DVertex(pos.UpperLeftCorner.X, pos.LowerRightCorner.Y, 0.0f, 0.0f, 1.0f, 1.0f, color, 0.0f, 1.0f);
+		vertices[numVertices + 0] = S3DVertex(pos.UpperLeftCorner.X, pos.UpperLeftCorner.Y, 0.0f, 0.0f, 0.0f, 1.0f, color, tx1, ty1);
+		vertices[numVertices + 1] = S3DVertex(pos.LowerRightCorner.X, pos.UpperLeftCorner.Y, 0.0f, 1.0f, 0.0f, 1.0f, color, tx2, ty1);
+		vertices[numVertices + 2] = S3DVertex(pos.LowerRightCorner.X, pos.LowerRightCorner.Y, 0.0f, 1.0f, 1.0f, 1.0f, color, tx2, ty2);
+		vertices[numVertices + 3] = S3DVertex(pos.UpperLeftCorner.X, pos.LowerRightCorner.Y, 0.0f, 0.0f, 1.0f, 1.0f, color, tx1, ty2);
 
 		// transform
 		for (int i = 0; i < 4; i++)
 			absoluteMatrix.transformVect(vertices[numVertices + i].Pos);
 
-		m_2dMaterial.setTexture(0, img);
+		m_2dMaterial.setTexture(0, tex);
 		m_2dMaterial.MaterialType = shaderID;
 
 		m_buffer->setDirty();
@@ -484,11 +672,19 @@ namespace Skylicht
 
 	void CGraphics2D::addImageBatch(ITexture* img, const core::rectf& dest, const core::rectf& source, const SColor& color, const core::matrix4& absoluteMatrix, int shaderID, CMaterial* material, float pivotX, float pivotY)
 	{
-		if (m_2dMaterial.getTexture(0) != img || m_2dMaterial.MaterialType != shaderID || material != NULL)
+		core::rectf uv(
+			source.UpperLeftCorner.X / (float)img->getSize().Width,
+			source.UpperLeftCorner.Y / (float)img->getSize().Height,
+			source.LowerRightCorner.X / (float)img->getSize().Width,
+			source.LowerRightCorner.Y / (float)img->getSize().Height);
+
+		ITexture* tex = material == NULL ? getAtlasTexture(img, uv) : img;
+
+		if (m_2dMaterial.getTexture(0) != tex || m_2dMaterial.MaterialType != shaderID || material != NULL)
 			flush();
 
 		int numVertices = m_vertices->getVertexCount();
-		int numVerticesUse = numVertices + 6;
+		int numVerticesUse = numVertices + 4;
 		int numIndex = m_indices->getIndexCount();
 		int numIndexUse = numIndex + 6;
 
@@ -497,8 +693,8 @@ namespace Skylicht
 			flush();
 			numVertices = 0;
 			numIndex = 0;
-			numVerticesUse = 6;
-			numIndexUse = 4;
+			numVerticesUse = 4;
+			numIndexUse = 6;
 		}
 
 		m_indices->set_used(numIndexUse);
@@ -519,10 +715,10 @@ namespace Skylicht
 		pos.LowerRightCorner.X = pos.UpperLeftCorner.X + dest.getWidth();
 		pos.LowerRightCorner.Y = pos.UpperLeftCorner.Y + dest.getHeight();
 
-		float tx1 = source.UpperLeftCorner.X / (float)img->getSize().Width;
-		float ty1 = source.UpperLeftCorner.Y / (float)img->getSize().Height;
-		float tx2 = source.LowerRightCorner.X / (float)img->getSize().Width;
-		float ty2 = source.LowerRightCorner.Y / (float)img->getSize().Height;
+		float tx1 = uv.UpperLeftCorner.X;
+		float ty1 = uv.UpperLeftCorner.Y;
+		float tx2 = uv.LowerRightCorner.X;
+		float ty2 = uv.LowerRightCorner.Y;
 
 		// add vertices
 		vertices[numVertices + 0] = S3DVertex(pos.UpperLeftCorner.X, pos.UpperLeftCorner.Y, 0.0f, 0.0f, 0.0f, 1.0f, color, tx1, ty1);
@@ -534,7 +730,7 @@ namespace Skylicht
 		for (int i = 0; i < 4; i++)
 			absoluteMatrix.transformVect(vertices[numVertices + i].Pos);
 
-		m_2dMaterial.setTexture(0, img);
+		m_2dMaterial.setTexture(0, tex);
 		m_2dMaterial.MaterialType = shaderID;
 
 		if (material != NULL)
@@ -1457,6 +1653,9 @@ namespace Skylicht
 		if (m_2dMaterial.MaterialType != shaderID || material != NULL)
 			flush();
 
+		if (m_vertices->getVertexCount() + 4 > MAX_VERTICES || m_indices->getIndexCount() + 6 > MAX_INDICES)
+			flush();
+
 		int numVertices = m_vertices->getVertexCount();
 		int vertexUse = numVertices + 4;
 
@@ -1503,9 +1702,13 @@ namespace Skylicht
 		if (m_2dMaterial.MaterialType != shaderID || material != NULL)
 			flush();
 
+		int numStep = 30;
+
+		if (m_vertices->getVertexCount() + numStep + 2 > MAX_VERTICES || m_indices->getIndexCount() + numStep * 3 > MAX_INDICES)
+			flush();
+
 		int fromVertices = m_vertices->getVertexCount();
 
-		int numStep = 30;
 		if (a > b)
 		{
 			float t = a;
@@ -29,12 +29,14 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Utils/CSingleton.h"
 #include "Graphics2D/SpriteFrame/CSpriteFrame.h"
 #include "Graphics2D/SpriteFrame/CGlyphFont.h"
+#include "Graphics2D/CGraphics2DCache.h"
 #include "Material/CMaterial.h"
 
 namespace Skylicht
 {
 	class CCamera;
 	class CCanvas;
+	class CRuntimeAtlas;
 
 	/**
 	 * @brief The object class supports 2D drawing on the screen.
@@ -84,6 +86,16 @@ namespace Skylicht
 		scene::SVertexBuffer* m_vertices;
 		scene::CIndexBuffer* m_indices;
 
+		CGraphics2DCache* m_cache;
+		u32 m_cacheVertex;
+		u32 m_cacheIndex;
+
+		CRuntimeAtlas* m_runtimeAtlas;
+		bool m_enableRuntimeAtlas;
+
+		// number of batches flushed since the last prepareBuffer
+		u32 m_drawCall;
+
 	public:
 		CGraphics2D();
 		virtual ~CGraphics2D();
@@ -170,6 +182,12 @@ namespace Skylicht
 
 		void addEclipseBatch(const core::rectf& pos, const core::rectf& uv, const SColor& color, const core::matrix4& absoluteTransform, int shaderID, float a = 0.0f, float b = 360.0f, CMaterial* material = NULL);
 
+		void beginCache(CGraphics2DCache* cache);
+
+		void endCache();
+
+		void addCacheBatch(CGraphics2DCache* cache);
+
 		void beginDrawDepth();
 
 		void endDrawDepth();
@@ -218,8 +236,47 @@ namespace Skylicht
 			return m_buffer;
 		}
 
+		/**
+		 * @brief Pack the small textures into runtime atlases, so the images of many textures are drawn in one batch.
+		 * The atlas copies the pixels of a texture on its first draw, a texture updated without lock()/unlock() keeps its old pixels
+		 * until releaseRuntimeAtlasTexture is called. Disable it to release the atlases.
+		 * @see CRuntimeAtlas
+		 */
+		void setEnableRuntimeAtlas(bool b);
+
+		/**
+		 * @brief Remove a texture from the runtime atlas, it is called when the texture is unloaded or its pixels are changed.
+		 */
+		void releaseRuntimeAtlasTexture(ITexture* texture);
+
+		/**
+		 * @brief Remove all the textures from the runtime atlas, it is called when the last canvas is removed.
+		 */
+		void clearRuntimeAtlas();
+
+		inline bool isRuntimeAtlasEnabled()
+		{
+			return m_enableRuntimeAtlas;
+		}
+
+		inline CRuntimeAtlas* getRuntimeAtlas()
+		{
+			return m_runtimeAtlas;
+		}
+
+		u32 getRuntimeAtlasRevision();
+
+		inline u32 getDrawCallCount()
+		{
+			return m_drawCall;
+		}
+
 	private:
 
+		void recordCache(CMaterial* material);
+
+		ITexture* getAtlasTexture(ITexture* img, core::rectf& uv);
+
 		void updateRectBuffer(video::S3DVertex* vtx, const core::rectf& r, const core::matrix4& mat);
 
 		void updateRectTexcoordBuffer(
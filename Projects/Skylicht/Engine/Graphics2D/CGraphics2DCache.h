@@ -0,0 +1,77 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "Material/CMaterial.h"
+
+namespace Skylicht
+{
+	/**
+	 * @brief The vertices and indices that a GUI element sent to CGraphics2D, kept to draw it again without regenerating.
+	 * @ingroup Graphics2D
+	 *
+	 * The geometry is split into batches by texture, shader and material, in the order it was added.
+	 * Indices of a batch are relative to its first vertex.
+	 *
+	 * @see CGraphics2D::beginCache, CGraphics2D::addCacheBatch
+	 */
+	class SKYLICHT_API CGraphics2DCache
+	{
+	public:
+		struct SBatch
+		{
+			ITexture* Texture;
+			int ShaderID;
+			CMaterial* Material;
+			u32 VertexBegin;
+			u32 VertexCount;
+			u32 IndexBegin;
+			u32 IndexCount;
+		};
+
+		core::array<video::S3DVertex> Vertices;
+
+		core::array<u16> Indices;
+
+		core::array<SBatch> Batches;
+
+	public:
+		CGraphics2DCache()
+		{
+		}
+
+		inline void clear()
+		{
+			Vertices.set_used(0);
+			Indices.set_used(0);
+			Batches.set_used(0);
+		}
+
+		inline bool isEmpty()
+		{
+			return Batches.size() == 0;
+		}
+	};
+}
@@ -43,7 +43,13 @@ namespace Skylicht
 		m_materialId(0),
 		m_renderOrder(0),
 		m_applyCurrentMask(NULL),
-		m_tagInt(0)
+		m_tagInt(0),
+		m_renderCache(NULL),
+		m_renderRevision(1),
+		m_cacheRevision(0),
+		m_cacheAtlasRevision(0),
+		m_cacheShaderID(0),
+		m_cacheMaterial(NULL)
 	{
 		CEntityPrefab* entityPrefab = m_canvas->getEntityManager();
 		m_entity = entityPrefab->createEntity();
@@ -68,7 +74,13 @@ namespace Skylicht
 		m_materialId(0),
 		m_renderOrder(0),
 		m_applyCurrentMask(NULL),
-		m_tagInt(0)
+		m_tagInt(0),
+		m_renderCache(NULL),
+		m_renderRevision(1),
+		m_cacheRevision(0),
+		m_cacheAtlasRevision(0),
+		m_cacheShaderID(0),
+		m_cacheMaterial(NULL)
 	{
 		CEntityPrefab* entityPrefab = m_canvas->getEntityManager();
 		m_entity = entityPrefab->createEntity();
@@ -91,6 +103,9 @@ namespace Skylicht
 
 		CEntityPrefab* entityPrefab = m_canvas->getEntityManager();
 		entityPrefab->removeEntity(m_entity);
+
+		if (m_renderCache)
+			delete m_renderCache;
 	}
 
 	void CGUIElement::setName(const wchar_t* name)
@@ -296,6 +311,54 @@ namespace Skylicht
 		}
 	}
 
+	bool CGUIElement::drawRenderCache()
+	{
+		if (!m_canvas->isRenderCacheEnabled() || m_renderCache == NULL)
+			return false;
+
+		// the cached batches keep the texture and UV of the runtime atlas
+		if (m_cacheRevision != m_renderRevision ||
+			m_cacheAtlasRevision != CGraphics2D::getInstance()->getRuntimeAtlasRevision() ||
+			m_cacheShaderID != m_renderData->ShaderID ||
+			m_cacheMaterial != m_renderData->Material ||
+			m_cacheColor != getColor() ||
+			m_cacheRect != getRect() ||
+			m_cacheWorld != m_transform->World)
+		{
+			return false;
+		}
+
+		CGraphics2D::getInstance()->addCacheBatch(m_renderCache);
+		return true;
+	}
+
+	void CGUIElement::beginRenderCache()
+	{
+		if (!m_canvas->isRenderCacheEnabled())
+			return;
+
+		if (m_renderCache == NULL)
+			m_renderCache = new CGraphics2DCache();
+
+		m_cacheRevision = m_renderRevision;
+		m_cacheAtlasRevision = CGraphics2D::getInstance()->getRuntimeAtlasRevision();
+		m_cacheShaderID = m_renderData->ShaderID;
+		m_cacheMaterial = m_renderData->Material;
+		m_cacheColor = getColor();
+		m_cacheRect = getRect();
+		m_cacheWorld = m_transform->World;
+
+		CGraphics2D::getInstance()->beginCache(m_renderCache);
+	}
+
+	void CGUIElement::endRenderCache()
+	{
+		if (!m_canvas->isRenderCacheEnabled())
+			return;
+
+		CGraphics2D::getInstance()->endCache();
+	}
+
 	void CGUIElement::setMaterialSource(const char* material)
 	{
 		std::string materialFile = material;
@@ -467,6 +530,7 @@ namespace Skylicht
 	{
 		m_guiTransform->HasChanged = true;
 		m_transform->HasChanged = true;
+		m_renderRevision++;
 	}
 
 	CGUIElement* CGUIElement::getChildBefore(CGUIElement* object)
@@ -36,6 +36,7 @@ namespace Skylicht
 {
 	class CCanvas;
 	class CGUIMask;
+	class CGraphics2DCache;
 
 	/**
 	 * @brief This is the base object class from which other GUIs inherit. It's an empty GUI and can contain child GUIs in a tree structure.
@@ -83,6 +84,16 @@ namespace Skylicht
 
 		std::string m_maskId;
 
+		CGraphics2DCache* m_renderCache;
+		u32 m_renderRevision;
+		u32 m_cacheRevision;
+		u32 m_cacheAtlasRevision;
+		core::matrix4 m_cacheWorld;
+		core::rectf m_cacheRect;
+		SColor m_cacheColor;
+		int m_cacheShaderID;
+		CMaterial* m_cacheMaterial;
+
 	public:
 
 		std::function<void(CGUIElement*)> OnRender;
@@ -121,6 +132,22 @@ namespace Skylicht
 			return m_applyCurrentMask;
 		}
 
+		/**
+		 * @brief Draw the geometry cached by the last render, used when the canvas render cache is enabled.
+		 * @return False if the cache is disabled or out of date, the element must render again between beginRenderCache and endRenderCache.
+		 */
+		bool drawRenderCache();
+
+		/**
+		 * @brief Start to record the batches of this element into its render cache.
+		 */
+		void beginRenderCache();
+
+		/**
+		 * @brief Stop recording the render cache.
+		 */
+		void endRenderCache();
+
 	public:
 		/**
 		 * @brief Destructor.
@@ -445,6 +472,17 @@ namespace Skylicht
 			m_guiTransform->HasChanged = true;
 		}
 
+		/**
+		 * @brief Mark the cached geometry of this element out of date.
+		 *
+		 * The transform, rect, color, shader and material are checked on render,
+		 * call this when the content (image, frame, text...) has changed.
+		 */
+		inline void invalidateRender()
+		{
+			m_renderRevision++;
+		}
+
 		/**
 		 * @brief Set the local position.
 		 * @param v Local position.
@@ -55,10 +55,14 @@ namespace Skylicht
 	void CGUIElipse::render(CCamera* camera)
 	{
 		const SColor& color = getColor();
-		if (color.getAlpha() > 0)
+		if (color.getAlpha() > 0 && !drawRenderCache())
 		{
+			beginRenderCache();
+
 			core::rectf uv(0.0f, 0.0f, 1.0f, 1.0f);
 			CGraphics2D::getInstance()->addEclipseBatch(getRect(), uv, color, m_transform->World, getShaderID(), m_a, m_b, getMaterial());
+
+			endRenderCache();
 		}
 		CGUIElement::render(camera);
 	}
@@ -76,5 +80,7 @@ namespace Skylicht
 		CGUIElement::loadSerializable(object);
 		m_a = object->get<float>("angleA", 0.0f);
 		m_b = object->get<float>("angleB", 360.0f);
+
+		invalidateRender();
 	}
 }
\ No newline at end of file
@@ -83,6 +83,7 @@ namespace Skylicht
 		{
 			m_a = a;
 			m_b = b;
+			invalidateRender();
 		}
 
 		/**
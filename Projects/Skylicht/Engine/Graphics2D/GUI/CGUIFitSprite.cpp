@@ -68,8 +68,10 @@ namespace Skylicht
 		if (m_frame != NULL && m_frame->ModuleOffset.size() > 0)
 		{
 			const SColor& color = getColor();
-			if (color.getAlpha() > 0)
+			if (color.getAlpha() > 0 && !drawRenderCache())
 			{
+				beginRenderCache();
+
 				CGraphics2D* g = CGraphics2D::getInstance();
 
 				SFrame* frame = m_frame->ModuleOffset[0].Frame;
@@ -113,6 +115,8 @@ namespace Skylicht
 				default:
 					break;
 				}
+
+				endRenderCache();
 			}
 		}
 
@@ -160,6 +164,8 @@ namespace Skylicht
 		{
 			m_frame = NULL;
 		}
+
+		invalidateRender();
 	}
 
 	void CGUIFitSprite::setFrameSource(const char* spritePath, const char* frameName, const char* editorFileRef)
@@ -182,6 +188,8 @@ namespace Skylicht
 				m_spriteId = sprite->getId();
 			}
 		}
+
+		invalidateRender();
 	}
 
 	void CGUIFitSprite::setAnchor(AnchorType type, float left, float right, float top, float bottom)
@@ -191,6 +199,7 @@ namespace Skylicht
 		m_anchorRight = core::max_(right, 0.0f);
 		m_anchorTop = core::max_(top, 0.0f);
 		m_anchorBottom = core::max_(bottom, 0.0f);
+		invalidateRender();
 	}
 
 	CObjectSerializable* CGUIFitSprite::createSerializable()
@@ -251,5 +260,7 @@ namespace Skylicht
 				}
 			}
 		}
+
+		invalidateRender();
 	}
 }
\ No newline at end of file
@@ -127,6 +127,7 @@ namespace Skylicht
 		inline void setFrame(SFrame* frame)
 		{
 			m_frame = frame;
+			invalidateRender();
 		}
 
 		/**
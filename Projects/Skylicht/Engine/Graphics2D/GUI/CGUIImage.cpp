@@ -54,8 +54,10 @@ namespace Skylicht
 		if (m_image != NULL)
 		{
 			const SColor& color = getColor();
-			if (color.getAlpha() > 0)
+			if (color.getAlpha() > 0 && !drawRenderCache())
 			{
+				beginRenderCache();
+
 				CGraphics2D::getInstance()->addImageBatch(
 					m_image,
 					getRect(),
@@ -65,6 +67,8 @@ namespace Skylicht
 					getShaderID(),
 					getMaterial(),
 					m_pivot.X, m_pivot.Y);
+
+				endRenderCache();
 			}
 		}
 
@@ -86,6 +90,7 @@ namespace Skylicht
 	void CGUIImage::setImage(ITexture* texture)
 	{
 		m_image = texture;
+		invalidateRender();
 
 		if (m_image)
 			setSourceRect(0, 0, (float)m_image->getSize().Width, (float)m_image->getSize().Height);
@@ -134,5 +139,7 @@ namespace Skylicht
 
 		m_resource = src;
 		m_id = id;
+
+		invalidateRender();
 	}
 }
\ No newline at end of file
@@ -130,6 +130,7 @@ namespace Skylicht
 			m_sourceRect.UpperLeftCorner.Y = y;
 			m_sourceRect.LowerRightCorner.X = x + w;
 			m_sourceRect.LowerRightCorner.Y = y + h;
+			invalidateRender();
 		}
 
 		/**
@@ -140,6 +141,7 @@ namespace Skylicht
 		void setPivot(float x, float y)
 		{
 			m_pivot.set(x, y);
+			invalidateRender();
 		}
 
 		/**
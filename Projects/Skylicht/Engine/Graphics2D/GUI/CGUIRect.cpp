@@ -51,10 +51,14 @@ namespace Skylicht
 	void CGUIRect::render(CCamera* camera)
 	{
 		const SColor& color = getColor();
-		if (color.getAlpha() > 0)
+		if (color.getAlpha() > 0 && !drawRenderCache())
 		{
+			beginRenderCache();
+
 			core::rectf uv(0.0f, 0.0f, 1.0f, 1.0f);
 			CGraphics2D::getInstance()->addRectangleBatch(getRect(), uv, color, m_transform->World, getShaderID(), getMaterial());
+
+			endRenderCache();
 		}
 		CGUIElement::render(camera);
 	}
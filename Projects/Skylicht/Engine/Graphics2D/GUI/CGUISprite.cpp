@@ -91,10 +91,17 @@ namespace Skylicht
 			const SColor& color = getColor();
 			if (color.getAlpha() > 0)
 			{
-				if (m_stretch)
-					CGraphics2D::getInstance()->addFrameBatch(getRect(), m_frame, color, m_transform->World, getShaderID(), getMaterial());
-				else
-					CGraphics2D::getInstance()->addFrameBatch(m_frame, color, m_transform->World, getShaderID(), getMaterial());
+				if (!drawRenderCache())
+				{
+					beginRenderCache();
+
+					if (m_stretch)
+						CGraphics2D::getInstance()->addFrameBatch(getRect(), m_frame, color, m_transform->World, getShaderID(), getMaterial());
+					else
+						CGraphics2D::getInstance()->addFrameBatch(m_frame, color, m_transform->World, getShaderID(), getMaterial());
+
+					endRenderCache();
+				}
 
 				CGUIElement::render(camera);
 			}
@@ -129,6 +136,8 @@ namespace Skylicht
 		{
 			m_frame = NULL;
 		}
+
+		invalidateRender();
 	}
 
 	void CGUISprite::setFrameSource(const char* spritePath, const char* frameName, const char* editorFileRef)
@@ -150,6 +159,8 @@ namespace Skylicht
 				m_spriteId = sprite->getId();
 			}
 		}
+
+		invalidateRender();
 	}
 
 	void CGUISprite::setAutoRotate(bool rotate, float rotateAngle, float framePerSec)
@@ -174,6 +185,7 @@ namespace Skylicht
 
 			m_frame->ModuleOffset[0].OffsetX = -((float)m_frame->getWidth() * 0.5f);
 			m_frame->ModuleOffset[0].OffsetY = -((float)m_frame->getHeight() * 0.5f);
+			invalidateRender();
 		}
 	}
 
@@ -184,6 +196,7 @@ namespace Skylicht
 			m_frame->ModuleOffset[0].OffsetX = m_defaultOffsetX;
 			m_frame->ModuleOffset[0].OffsetY = m_defaultOffsetY;
 			m_isCenter = false;
+			invalidateRender();
 		}
 	}
 
@@ -193,6 +206,7 @@ namespace Skylicht
 		{
 			m_frame->ModuleOffset[0].OffsetX = x;
 			m_frame->ModuleOffset[0].OffsetY = y;
+			invalidateRender();
 		}
 	}
 
@@ -237,5 +251,7 @@ namespace Skylicht
 					m_frame = sprite->getFrameById(m_guid.c_str());
 			}
 		}
+
+		invalidateRender();
 	}
 }
\ No newline at end of file
@@ -137,6 +137,7 @@ namespace Skylicht
 		inline void setFrame(SFrame* frame)
 		{
 			m_frame = frame;
+			invalidateRender();
 		}
 
 		/**
@@ -191,6 +192,7 @@ namespace Skylicht
 		inline void setStretch(bool b)
 		{
 			m_stretch = b;
+			invalidateRender();
 		}
 
 		/**
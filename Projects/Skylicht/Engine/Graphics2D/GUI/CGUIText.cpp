@@ -808,6 +808,20 @@ namespace Skylicht
 
 		m_font->updateFontTexture();
 
+#ifdef HAVE_CARET
+		// the caret blinks, so the text is not cached while it is shown
+		if (m_showCaret)
+			invalidateRender();
+#endif
+
+		if (drawRenderCache())
+		{
+			CGUIElement::render(camera);
+			return;
+		}
+
+		beginRenderCache();
+
 		// calc multiline height
 		int textHeight = (int)m_arrayCharRender.size() * (m_textHeight + m_linePadding);
 		textHeight -= m_linePadding;
@@ -834,6 +848,8 @@ namespace Skylicht
 			y += (m_textHeight + m_linePadding);
 		}
 
+		endRenderCache();
+
 		CGUIElement::render(camera);
 	}
 
@@ -942,6 +958,8 @@ namespace Skylicht
 
 	void CGUIText::updateSplitText()
 	{
+		invalidateRender();
+
 		// encode string to list modules & format
 		m_arrayCharRender.clear();
 		m_arrayCharFormat.clear();
@@ -1269,6 +1287,7 @@ namespace Skylicht
 		}
 
 		m_updateTextRender = true;
+		invalidateRender();
 	}
 
 	void CGUIText::setFontSource(const char* fontSource)
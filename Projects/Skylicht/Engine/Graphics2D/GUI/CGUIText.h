@@ -174,6 +174,7 @@ namespace Skylicht
 		{
 			TextVertical = v;
 			TextHorizontal = h;
+			invalidateRender();
 		}
 
 		/*
@@ -199,6 +200,7 @@ namespace Skylicht
 		{
 			if (id < MAX_FORMATCOLOR)
 				m_colorFormat[id] = c;
+			invalidateRender();
 		}
 
 		/**
@@ -340,6 +342,7 @@ namespace Skylicht
 		inline void setEnableTextFormnat(bool b)
 		{
 			m_enableTextFormat = b;
+			invalidateRender();
 		}
 
 		/**
@@ -374,6 +377,7 @@ namespace Skylicht
 		{
 			m_charPadding = charPadding;
 			m_charSpacePadding = charPadding;
+			invalidateRender();
 		}
 
 		/**
@@ -383,6 +387,7 @@ namespace Skylicht
 		inline void setLinePadding(int linePadding)
 		{
 			m_linePadding = linePadding;
+			invalidateRender();
 		}
 
 		/**
@@ -392,6 +397,7 @@ namespace Skylicht
 		inline void setMultiLine(bool b)
 		{
 			m_multiLine = b;
+			invalidateRender();
 		}
 
 		/**
@@ -401,6 +407,7 @@ namespace Skylicht
 		inline void setCenterRotate(bool b)
 		{
 			m_centerRotate = b;
+			invalidateRender();
 		}
 
 		/**
@@ -28,10 +28,37 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Exporter/ExportResources.h"
 
 #include "Utils/CMemoryStream.h"
+#include "Utils/CMappedFile.h"
 #include "Animation/CAnimationClip.h"
+#include "Animation/CCompressedAnimationTrack.h"
 
 namespace Skylicht
 {
+	// version 2 stores the key arrays as raw memory
+	static_assert(sizeof(CPositionKey) == 4 * sizeof(f32), "CPositionKey must be packed");
+	static_assert(sizeof(CRotationKey) == 5 * sizeof(f32), "CRotationKey must be packed");
+
+	template<class T>
+	static void readKeys(CMemoryStream* stream, int version, CArrayKeyFrame<T>& keys, int numFloat)
+	{
+		u32 numKey = stream->readUInt();
+		keys.Data.set_used(numKey);
+
+		if (version >= 2)
+		{
+			stream->readPadding(16);
+			stream->readData(keys.pointer(), numKey * sizeof(CKeyFrameData<T>));
+			return;
+		}
+
+		for (u32 j = 0; j < numKey; j++)
+		{
+			CKeyFrameData<T>& key = keys.Data[j];
+			key.Frame = stream->readFloat();
+			stream->readFloatArray(&key.Value.X, numFloat);
+		}
+	}
+
 	CSkylichtAnimLoader::CSkylichtAnimLoader()
 	{
 
@@ -44,46 +71,30 @@ namespace Skylicht
 
 	bool CSkylichtAnimLoader::loadAnimation(const char* resource, CAnimationClip* output)
 	{
-		IrrlichtDevice* device = getIrrlichtDevice();
-		io::IFileSystem* fs = device->getFileSystem();
-
-		io::IReadFile* readFile = fs->createAndOpenFile(resource);
-		if (readFile == NULL)
+		// the file is mapped, the data is copied once to the key arrays
+		CMappedFile file;
+		if (!file.open(resource))
 			return false;
 
-		u32 size = readFile->getSize();
-
-		unsigned char* data = new unsigned char[size];
-		readFile->read(data, size);
-		readFile->drop();
+		if (file.getSize() < sizeof(SAssetHeader))
+			return false;
 
-		CMemoryStream stream(data, size);
+		CMemoryStream stream((unsigned char*)file.getData(), file.getSize());
 
 		// read header
 		SAssetHeader assetHeader;
 		stream.readData(&assetHeader, sizeof(SAssetHeader));
 
 		if (strcmp(assetHeader.Sign, "SLT") != 0)
-		{
-			delete[] data;
 			return false;
-		}
 
 		if (assetHeader.AssetType != (u32)AssetAnimation)
-		{
-			delete[] data;
 			return false;
-		}
 
-		if (assetHeader.AssetVersion == 1)
-			loadVersion(&stream, output, assetHeader.AssetVersion);
-		else
-		{
-			delete[] data;
+		if (assetHeader.AssetVersion < 1 || assetHeader.AssetVersion > 3)
 			return false;
-		}
 
-		delete[] data;
+		loadVersion(&stream, output, assetHeader.AssetVersion);
 		return true;
 	}
 
@@ -100,50 +111,35 @@ namespace Skylicht
 			SEntityAnim* entityAnim = new SEntityAnim();
 			entityAnim->Name = stream->readString();
 
-			// positions
-			CArrayKeyFrame<core::vector3df>& positions = entityAnim->Data.Positions;
-
-			stream->readFloatArray(&positions.Default.X, 3);
+			// version 3: compressed track
+			if (version >= 3)
+			{
+				CAnimationData& data = entityAnim->Data;
+				stream->readFloatArray(&data.Positions.Default.X, 3);
+				stream->readFloatArray(&data.Rotations.Default.X, 4);
+				stream->readFloatArray(&data.Scales.Default.X, 3);
 
-			u32 numKey = stream->readUInt();
-			positions.Data.set_used(numKey);
+				data.Compressed = new CCompressedAnimationTrack();
+				data.Compressed->deserializable(stream);
 
-			for (u32 j = 0; j < numKey; j++)
-			{
-				CPositionKey& posKey = positions.Data[j];
-				posKey.Frame = stream->readFloat();
-				stream->readFloatArray(&posKey.Value.X, 3);
+				output->addAnim(entityAnim);
+				continue;
 			}
 
+			// positions
+			CArrayKeyFrame<core::vector3df>& positions = entityAnim->Data.Positions;
+			stream->readFloatArray(&positions.Default.X, 3);
+			readKeys(stream, version, positions, 3);
+
 			// rotations
 			CArrayKeyFrame<core::quaternion>& rotations = entityAnim->Data.Rotations;
-
 			stream->readFloatArray(&rotations.Default.X, 4);
-
-			numKey = stream->readUInt();
-			rotations.Data.set_used(numKey);
-
-			for (u32 j = 0; j < numKey; j++)
-			{
-				CRotationKey& rotKey = rotations.Data[j];
-				rotKey.Frame = stream->readFloat();
-				stream->readFloatArray(&rotKey.Value.X, 4);
-			}
+			readKeys(stream, version, rotations, 4);
 
 			// scales
 			CArrayKeyFrame<core::vector3df>& scales = entityAnim->Data.Scales;
-
 			stream->readFloatArray(&scales.Default.X, 3);
-
-			numKey = stream->readUInt();
-			scales.Data.set_used(numKey);
-
-			for (u32 j = 0; j < numKey; j++)
-			{
-				CScaleKey& scaleKey = scales.Data[j];
-				scaleKey.Frame = stream->readFloat();
-				stream->readFloatArray(&scaleKey.Value.X, 3);
-			}
+			readKeys(stream, version, scales, 3);
 
 			output->addAnim(entityAnim);
 		}
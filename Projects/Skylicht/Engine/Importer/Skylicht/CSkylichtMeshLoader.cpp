@@ -30,6 +30,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Exporter/ExportResources.h"
 
 #include "Utils/CMemoryStream.h"
+#include "Utils/CMappedFile.h"
 #include "Utils/CActivator.h"
 
 #include "Transform/CWorldTransformData.h"
@@ -48,46 +49,30 @@ namespace Skylicht
 
 	bool CSkylichtMeshLoader::loadModel(const char* resource, CEntityPrefab* output, bool normalMap, bool flipNormalMap, bool texcoord2, bool batching)
 	{
-		IrrlichtDevice* device = getIrrlichtDevice();
-		io::IFileSystem* fs = device->getFileSystem();
-
-		io::IReadFile* readFile = fs->createAndOpenFile(resource);
-		if (readFile == NULL)
+		// the file is mapped, the data is copied once to the mesh buffers
+		CMappedFile file;
+		if (!file.open(resource))
 			return false;
 
-		long size = readFile->getSize();
-
-		unsigned char* data = new unsigned char[size];
-		readFile->read(data, (u32)size);
-		readFile->drop();
+		if (file.getSize() < sizeof(SAssetHeader))
+			return false;
 
-		CMemoryStream stream(data, (u32)size);
+		CMemoryStream stream((unsigned char*)file.getData(), file.getSize());
 
 		// read header
 		SAssetHeader assetHeader;
 		stream.readData(&assetHeader, sizeof(SAssetHeader));
 
 		if (strcmp(assetHeader.Sign, "SLT") != 0)
-		{
-			delete[] data;
 			return false;
-		}
 
 		if (assetHeader.AssetType != (u32)AssetModel)
-		{
-			delete[] data;
 			return false;
-		}
 
-		if (assetHeader.AssetVersion == 1)
-			loadVersion(&stream, output, assetHeader.AssetVersion, normalMap, texcoord2, batching);
-		else
-		{
-			delete[] data;
+		if (assetHeader.AssetVersion != 1 && assetHeader.AssetVersion != 2)
 			return false;
-		}
 
-		delete[] data;
+		loadVersion(&stream, output, assetHeader.AssetVersion, normalMap, texcoord2, batching);
 		return true;
 	}
 
@@ -111,6 +96,11 @@ namespace Skylicht
 			while (entityDataSize != -1)
 			{
 				std::string entityDataName = stream->readString();
+
+				// version 2: the data block is aligned
+				if (version >= 2)
+					stream->readPadding(16);
+
 				u32 seek = stream->getPos();
 
 				IEntityData* data = entity->addDataByActivator(entityDataName.c_str());
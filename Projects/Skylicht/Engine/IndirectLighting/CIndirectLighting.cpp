@@ -116,6 +116,7 @@ namespace Skylicht
 		data->CustomIntensity = &m_customIntensity;
 		data->ReleaseSH = false;
 		data->InvalidateProbe = true;
+		data->notifyChanged();
 
 		if (std::find(m_data.begin(), m_data.end(), data) == m_data.end())
 			m_data.push_back(data);
@@ -233,6 +234,10 @@ namespace Skylicht
 		m_autoSH = false;
 		for (int i = 0; i < 9; i++)
 			m_sh[i] = sh[i];
+
+		// the data shares m_sh
+		for (CIndirectLightingData* data : m_data)
+			data->notifyChanged();
 	}
 
 	void CIndirectLighting::setCustomIntensity(float intensity)
@@ -248,6 +253,7 @@ namespace Skylicht
 		for (CIndirectLightingData* data : m_data)
 		{
 			data->Color = color;
+			data->notifyChanged();
 		}
 	}
 
@@ -319,6 +325,8 @@ namespace Skylicht
 			{
 				data->Type = CIndirectLightingData::VertexColor;
 			}
+
+			data->notifyChanged();
 		}
 	}
 }
\ No newline at end of file
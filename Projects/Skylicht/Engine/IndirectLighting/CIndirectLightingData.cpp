@@ -44,7 +44,9 @@ namespace Skylicht
 		Intensity(NULL),
 		CustomIntensity(NULL),
 		LightLayers(1),
-		ReleaseSH(false)
+		ReleaseSH(false),
+		ProbeTetrahedron(-1),
+		ChangeRevision(0)
 	{
 
 	}
@@ -69,6 +71,8 @@ namespace Skylicht
 		*CustomIntensity = 1.0f;
 
 		ReleaseSH = true;
+
+		notifyChanged();
 	}
 
 	void CIndirectLightingData::releaseSH()
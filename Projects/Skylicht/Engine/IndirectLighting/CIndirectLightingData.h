@@ -63,6 +63,12 @@ namespace Skylicht
 
 		SVec4 LightIndex;
 
+		// the tetrahedron of last probe lookup, see CProbeTetrahedra
+		int ProbeTetrahedron;
+
+		// increased when Type, SH, Color or LightIndex is changed, the instancing renderer rewrites the instance on change
+		u32 ChangeRevision;
+
 	public:
 
 		CIndirectLightingData();
@@ -74,6 +80,11 @@ namespace Skylicht
 		void releaseSH();
 
 		void applyShader();
+
+		inline void notifyChanged()
+		{
+			ChangeRevision++;
+		}
 	};
 
 	DECLARE_PUBLIC_DATA_TYPE_INDEX(CIndirectLightingData);
@@ -34,7 +34,8 @@ namespace Skylicht
 		m_probeChange(false),
 		m_groupLighting(NULL),
 		m_groupProbes(NULL),
-		m_uboProbes(NULL)
+		m_uboProbes(NULL),
+		m_tetrahedra(NULL)
 	{
 		m_kdtree = new CKDTree3f();
 	}
@@ -130,15 +131,21 @@ namespace Skylicht
 		{
 			m_kdtree->clear();
 
-			u32 n = m_probePositions.size();
+			// blend the SH in tetrahedra, if it is built with these probes
+			m_tetrahedra = updateTetrahedra();
 
-			CWorldTransformData** worlds = m_probePositions.pointer();
-			CLightProbeData** data = m_probes.pointer();
-
-			for (u32 i = 0; i < n; i++)
+			if (m_tetrahedra == NULL)
 			{
-				f32* m = worlds[i]->World.pointer();
-				m_kdtree->insert(m[12], m[13], m[14], data[i]);
+				u32 n = m_probePositions.size();
+
+				CWorldTransformData** worlds = m_probePositions.pointer();
+				CLightProbeData** data = m_probes.pointer();
+
+				for (u32 i = 0; i < n; i++)
+				{
+					f32* m = worlds[i]->World.pointer();
+					m_kdtree->insert(m[12], m[13], m[14], data[i]);
+				}
 			}
 
 			if (m_uboProbes)
@@ -152,13 +159,6 @@ namespace Skylicht
 		CWorldTransformData** worlds = m_entitiesPositions.pointer();
 		CIndirectLightingData** data = m_entities.pointer();
 
-		float* m;
-
-		CKDTree3f::SKDNode* node;
-
-		CLightProbeData* probe;
-		CIndirectLightingData* indirectData;
-
 		for (u32 i = 0; i < n; i++)
 		{
 			if (!worlds[i]->NeedValidate &&
@@ -168,34 +168,118 @@ namespace Skylicht
 				continue;
 			}
 
-			m = worlds[i]->World.pointer();
+			if (m_tetrahedra)
+				updateTetrahedraSH(data[i], worlds[i]->World.pointer());
+			else
+				updateNearestSH(data[i], worlds[i]->World.pointer());
+		}
 
-			// query nearst probe
-			node = m_kdtree->nearest(m);
-			if (node)
-			{
-				probe = (CLightProbeData*)node->Data;
-				if (probe != NULL)
-				{
-					// get indirectData
-					indirectData = data[i];
+		m_probeChange = false;
+	}
+
+	CProbeTetrahedra* CIndirectLightingSystem::updateTetrahedra()
+	{
+		u32 n = m_probes.size();
+		if (n == 0)
+			return NULL;
+
+		// all probes must be in one tetrahedra
+		CProbeTetrahedra* tetrahedra = m_probes[0]->Tetrahedra;
+		if (tetrahedra == NULL || tetrahedra->getVertexCount() != (int)n)
+			return NULL;
+
+		m_tetrahedraProbes.set_used(n);
+		m_tetrahedraPositions.set_used(n);
+
+		for (u32 i = 0; i < n; i++)
+			m_tetrahedraProbes[i] = NULL;
+
+		for (u32 i = 0; i < n; i++)
+		{
+			CLightProbeData* probe = m_probes[i];
+			int vertex = probe->TetrahedraVertex;
+
+			if (probe->Tetrahedra != tetrahedra ||
+				vertex < 0 ||
+				vertex >= (int)n ||
+				m_tetrahedraProbes[vertex] != NULL)
+				return NULL;
+
+			m_tetrahedraProbes[vertex] = probe;
+			m_tetrahedraPositions[vertex] = m_probePositions[i]->World.getTranslation();
+		}
 
-					// copy sh data
-					// need interpolate here, todo later
-					for (int j = 0; j < 9; j++)
-					{
-						indirectData->SH[j].set(probe->SH[j]);
-					}
+		// bind the current positions, the topology is not rebuilt
+		if (!tetrahedra->updatePositions(m_tetrahedraPositions.pointer(), (int)n))
+			return NULL;
 
-					*indirectData->Intensity = probe->Intensity * *indirectData->CustomIntensity;
+		return tetrahedra;
+	}
 
-					indirectData->InvalidateProbe = false;
-					indirectData->LightIndex.W = (float)probe->UBOIndex;
+	void CIndirectLightingSystem::updateNearestSH(CIndirectLightingData* indirectData, float* position)
+	{
+		// query nearst probe with the translation of world matrix
+		CKDTree3f::SKDNode* node = m_kdtree->nearest(position[12], position[13], position[14]);
+		if (node)
+		{
+			CLightProbeData* probe = (CLightProbeData*)node->Data;
+			if (probe != NULL)
+			{
+				// copy sh data
+				for (int j = 0; j < 9; j++)
+				{
+					indirectData->SH[j].set(probe->SH[j]);
 				}
+
+				*indirectData->Intensity = probe->Intensity * *indirectData->CustomIntensity;
+
+				indirectData->InvalidateProbe = false;
+				indirectData->LightIndex.W = (float)probe->UBOIndex;
+				indirectData->notifyChanged();
 			}
 		}
+	}
 
-		m_probeChange = false;
+	void CIndirectLightingSystem::updateTetrahedraSH(CIndirectLightingData* indirectData, float* position)
+	{
+		float weights[4];
+
+		// walk from the tetrahedron of last frame
+		int tet = m_tetrahedra->findTetrahedron(core::vector3df(position[12], position[13], position[14]), indirectData->ProbeTetrahedron, weights);
+		if (tet < 0)
+			return;
+
+		indirectData->ProbeTetrahedron = tet;
+
+		const CProbeTetrahedra::STetrahedron& t = m_tetrahedra->getTetrahedron(tet);
+
+		core::vector3df sh[9];
+		float intensity = 0.0f;
+		int nearest = 0;
+
+		for (int k = 0; k < 4; k++)
+		{
+			CLightProbeData* probe = m_tetrahedraProbes[t.Vertex[k]];
+
+			for (int j = 0; j < 9; j++)
+				sh[j] += probe->SH[j] * weights[k];
+
+			intensity += probe->Intensity * weights[k];
+
+			if (weights[k] > weights[nearest])
+				nearest = k;
+		}
+
+		for (int j = 0; j < 9; j++)
+			indirectData->SH[j] = sh[j];
+
+		*indirectData->Intensity = intensity * *indirectData->CustomIntensity;
+
+		indirectData->InvalidateProbe = false;
+
+		// the shader reads the probe buffer by one index
+		indirectData->LightIndex.W = (float)m_tetrahedraProbes[t.Vertex[nearest]]->UBOIndex;
+		indirectData->notifyChanged();
 	}
 
 	void CIndirectLightingSystem::setUBOProbes(IHardwareBuffer* buffer)
@@ -31,6 +31,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Transform/CWorldTransformData.h"
 #include "IndirectLighting/CIndirectLightingData.h"
 #include "LightProbes/CLightProbeData.h"
+#include "LightProbes/CProbeTetrahedra.h"
 #include "Culling/CVisibleData.h"
 
 #include "Utils/CKDTree3f.h"
@@ -47,6 +48,11 @@ namespace Skylicht
 
 		CKDTree3f* m_kdtree;
 
+		// the tetrahedra of probes, NULL if the objects use the nearest probe
+		CProbeTetrahedra* m_tetrahedra;
+		core::array<CLightProbeData*> m_tetrahedraProbes;
+		core::array<core::vector3df> m_tetrahedraPositions;
+
 		bool m_probeChange;
 
 		CEntityGroup* m_groupLighting;
@@ -72,5 +78,11 @@ namespace Skylicht
 	protected:
 
 		void updateUBOProbes(core::array<CLightProbeData*>& probes, IHardwareBuffer* buffer);
+
+		CProbeTetrahedra* updateTetrahedra();
+
+		void updateNearestSH(CIndirectLightingData* indirectData, float* position);
+
+		void updateTetrahedraSH(CIndirectLightingData* indirectData, float* position);
 	};
 }
\ No newline at end of file
@@ -31,6 +31,8 @@ namespace Skylicht
 
 	IMPLEMENT_DATA_TYPE_INDEX(CInstancingMaterialData);
 
+	u32 CInstancingMaterialData::s_changeID = 0;
+
 	CInstancingMaterialData::CInstancingMaterialData() :
 		Enable(false)
 	{
@@ -49,6 +51,8 @@ namespace Skylicht
 
 		Materials.clear();
 		Enable = false;
+
+		notifyChanged();
 	}
 
 	void CInstancingMaterialData::initCustomMaterial(SMeshInstancing* instancing)
@@ -66,5 +70,7 @@ namespace Skylicht
 			Materials.push_back(material);
 		}
 		Enable = true;
+
+		notifyChanged();
 	}
 }
\ No newline at end of file
@@ -31,6 +31,9 @@ namespace Skylicht
 {
 	class SKYLICHT_API CInstancingMaterialData : public IEntityData
 	{
+	protected:
+		static u32 s_changeID;
+
 	public:
 		core::array<CMaterial*> Materials;
 
@@ -44,6 +47,18 @@ namespace Skylicht
 
 		void initCustomMaterial(SMeshInstancing* instancing);
 
+		// call it after change Materials or Enable, the instancing renderer rebatches the materials
+		static void notifyChanged()
+		{
+			s_changeID++;
+		}
+
+		// increased when the materials of any instance are changed
+		static u32 getChangeID()
+		{
+			return s_changeID;
+		}
+
 		DECLARE_GETTYPENAME(CInstancingMaterialData)
 	};
 
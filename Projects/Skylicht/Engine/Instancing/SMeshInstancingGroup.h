@@ -31,14 +31,65 @@ using namespace irr::scene;
 #include "Entity/CEntity.h"
 #include "Entity/CArrayUtils.h"
 #include "Entity/CEntityPrefab.h"
+#include "Material/Shader/Instancing/VertexInstancingType.h"
 
 namespace Skylicht
 {
+	class CRenderMeshData;
+	class CWorldTransformData;
+	class CIndirectLightingData;
+	class CInstancingMaterialData;
+
+	struct SMeshInstanceSlot
+	{
+		CRenderMeshData* RenderMesh;
+
+		// the entity data are cached when the instance is added
+		CWorldTransformData* Transform;
+		CIndirectLightingData* IndirectLighting;
+		CInstancingMaterialData* Material;
+
+		// the last frame that the instance is visible
+		u32 Frame;
+
+		// the CIndirectLightingData::ChangeRevision that is written to the buffer
+		u32 LightingRevision;
+	};
+
 	struct SMeshInstancingGroup
 	{
 		CFastArray<CMaterial*> Materials;
 		CFastArray<CEntity*> Entities;
 
+		// persistent instance slots, that keep the index of instance
+		// Entities[i] is the entity of Slots[i]
+		CFastArray<SMeshInstanceSlot> Slots;
+
+		// the slots that are added, moved or their transform (indirect lighting) is changed in this frame, they must be rewritten
+		CFastArray<int> DirtySlots;
+
+		// an instance is added or moved in this frame
+		bool SlotsMoved;
+
+		// the instancing buffers, they are casted when the buffer is changed
+		IVertexBuffer* TransformBuffer;
+		IVertexBuffer* IndirectLightingBuffer;
+		CVertexBuffer<SVtxTransform>* TransformVertices;
+		CVertexBuffer<SVtxIndirectLighting>* IndirectLightingVertices;
+
+		// the buffer state after this group batched it
+		// the buffer is rebatched if another group (share buffer) writes it
+		IVertexBuffer* BatchedTransformBuffer;
+		u32 BatchedTransformID;
+
+		core::array<IVertexBuffer*> BatchedMaterialBuffer;
+		core::array<u32> BatchedMaterialID;
+		core::array<u32> BatchedMaterialHash;
+
+		// the material change counters when the materials are batched
+		u32 BatchedParamsChangeID;
+		u32 BatchedMaterialDataID;
+
 		// the instancing root object
 		int RootEntityIndex;
 
@@ -65,6 +116,15 @@ namespace Skylicht
 			RenderMesh = NULL;
 			RootEntityIndex = -1;
 			MeshIndex = 0;
+			SlotsMoved = false;
+			TransformBuffer = NULL;
+			IndirectLightingBuffer = NULL;
+			TransformVertices = NULL;
+			IndirectLightingVertices = NULL;
+			BatchedTransformBuffer = NULL;
+			BatchedTransformID = 0;
+			BatchedParamsChangeID = 0;
+			BatchedMaterialDataID = 0;
 		}
 	};
 }
\ No newline at end of file
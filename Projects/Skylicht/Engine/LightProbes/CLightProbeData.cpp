@@ -34,7 +34,9 @@ namespace Skylicht
 	CLightProbeData::CLightProbeData() :
 		NeedValidate(true),
 		Intensity(1.0f),
-		UBOIndex(0)
+		UBOIndex(0),
+		Tetrahedra(NULL),
+		TetrahedraVertex(-1)
 	{
 
 	}
@@ -28,6 +28,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	class CProbeTetrahedra;
+
 	class SKYLICHT_API CLightProbeData : public IEntityData
 	{
 	public:
@@ -37,6 +39,10 @@ namespace Skylicht
 		bool NeedValidate;
 
 		int UBOIndex;
+
+		// the tetrahedra of CLightProbes, and the vertex of this probe
+		CProbeTetrahedra* Tetrahedra;
+		int TetrahedraVertex;
 	public:
 		CLightProbeData();
 
@@ -27,6 +27,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CLightProbeData.h"
 #include "CLightProbeRender.h"
 #include "CProbeSerializable.h"
+#include "CProbeTetrahedronSerializable.h"
 
 #include "Entity/CEntityManager.h"
 #include "GameObject/CGameObject.h"
@@ -41,10 +42,16 @@ namespace Skylicht
 	CLightProbes::CLightProbes() :
 		m_intensity(1.0f)
 	{
+		m_tetrahedra = new CProbeTetrahedra();
 	}
 
 	CLightProbes::~CLightProbes()
 	{
+		// the probe entities are removed later
+		if (m_gameObject != NULL && m_gameObject->getEntityManager() != NULL)
+			setTetrahedraData(NULL);
+
+		delete m_tetrahedra;
 	}
 
 	void CLightProbes::initComponent()
@@ -102,6 +109,27 @@ namespace Skylicht
 				probeData->SH[j]->set(light->SH[j]);
 		}
 
+		// save the tetrahedra that is built with these probes
+		if (m_tetrahedra->getVertexCount() == numProbes)
+		{
+			CArraySerializable* tetrahedra = new CArraySerializable("Tetrahedra");
+			object->addProperty(tetrahedra);
+			object->autoRelease(tetrahedra);
+
+			const CProbeTetrahedra::STetrahedron* tets = m_tetrahedra->getTetrahedra();
+			for (int i = 0, n = m_tetrahedra->getTetrahedronCount(); i < n; i++)
+			{
+				CProbeTetrahedronSerializable* tetData = new CProbeTetrahedronSerializable(tetrahedra);
+				tetrahedra->autoRelease(tetData);
+
+				for (int j = 0; j < 4; j++)
+				{
+					tetData->Vertex[j]->set(tets[i].Vertex[j]);
+					tetData->Neighbor[j]->set(tets[i].Neighbor[j]);
+				}
+			}
+		}
+
 		return object;
 	}
 
@@ -143,6 +171,39 @@ namespace Skylicht
 			// intensity
 			light->Intensity = m_intensity;
 		}
+
+		// load the tetrahedra, the positions are bound by CIndirectLightingSystem
+		m_tetrahedra->clear();
+
+		CArraySerializable* tetrahedra = (CArraySerializable*)object->getProperty("Tetrahedra");
+		if (tetrahedra != NULL)
+		{
+			int numTet = tetrahedra->getElementCount();
+
+			core::array<CProbeTetrahedra::STetrahedron> tets;
+			tets.reallocate(numTet);
+
+			for (int i = 0; i < numTet; i++)
+			{
+				CProbeTetrahedronSerializable* tetData = (CProbeTetrahedronSerializable*)tetrahedra->getElement(i);
+				if (tetData == NULL)
+					break;
+
+				CProbeTetrahedra::STetrahedron t;
+				for (int j = 0; j < 4; j++)
+				{
+					t.Vertex[j] = tetData->Vertex[j]->get();
+					t.Neighbor[j] = tetData->Neighbor[j]->get();
+				}
+				tets.push_back(t);
+			}
+
+			if ((int)tets.size() == numTet)
+			{
+				m_tetrahedra->setTetrahedra(tets.pointer(), numTet, numProbes);
+				setTetrahedraData(m_tetrahedra);
+			}
+		}
 	}
 
 	CEntity* CLightProbes::spawn()
@@ -155,6 +216,9 @@ namespace Skylicht
 		CEntity* entity = createEntity();
 		entity->addData<CLightProbeData>();
 
+		// the new probe is not in tetrahedra, need build again
+		m_tetrahedra->clear();
+
 		CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
 		transform->Relative.setTranslation(position);
 
@@ -185,4 +249,34 @@ namespace Skylicht
 				data->SH[j] = sh[i++];
 		}
 	}
-}
\ No newline at end of file
+
+	bool CLightProbes::buildTetrahedra()
+	{
+		std::vector<core::vector3df> positions;
+		getPositions(positions);
+
+		if (positions.size() == 0 || !m_tetrahedra->build(positions.data(), (int)positions.size()))
+		{
+			m_tetrahedra->clear();
+			setTetrahedraData(NULL);
+			return false;
+		}
+
+		setTetrahedraData(m_tetrahedra);
+		return true;
+	}
+
+	void CLightProbes::setTetrahedraData(CProbeTetrahedra* tetrahedra)
+	{
+		for (u32 i = 0, n = m_entities.size(); i < n; i++)
+		{
+			if (!m_entities[i]->isAlive())
+				continue;
+
+			CLightProbeData* data = GET_ENTITY_DATA(m_entities[i], CLightProbeData);
+			data->Tetrahedra = tetrahedra;
+			data->TetrahedraVertex = tetrahedra ? (int)i : -1;
+			data->NeedValidate = true;
+		}
+	}
+}
@@ -27,6 +27,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Components/CComponentSystem.h"
 #include "Entity/CEntity.h"
 #include "Entity/CEntityHandler.h"
+#include "CProbeTetrahedra.h"
 
 namespace Skylicht
 {
@@ -40,7 +41,8 @@ namespace Skylicht
 	 * @image html Lighting/light_probes_0.jpg "The ambient light that shines on objects is influenced by light probes and the environment" width=1200px
 	 *
 	 * The baking process recalculates the colors and stores them in CLightProbeData.
-	 * This value is then mapped to the nearest objects with CIndirectLightingData.
+	 * This value is then blended from the 4 probes around the objects with CIndirectLightingData (see buildTetrahedra),
+	 * or mapped from the nearest probe if the tetrahedra is not built.
 	 * This SH value will eventually be passed to the Shader during the drawing step.
 	 *
 	 * @image html Lighting/light_probes_1.jpg "When the environment changes, you need to rebake the light probes" width=600px
@@ -85,6 +87,8 @@ namespace Skylicht
 	protected:
 		float m_intensity;
 
+		CProbeTetrahedra* m_tetrahedra;
+
 	public:
 		CLightProbes();
 
@@ -106,6 +110,21 @@ namespace Skylicht
 
 		void setSH(std::vector<core::vector3df>& sh);
 
+		/**
+		 * @brief Build the tetrahedra of probe positions to blend the SH, call it after the probes are placed (it is saved with the probes).
+		 * @return false if there are less than 4 probes or they are on a plane, the objects use the nearest probe.
+		 */
+		bool buildTetrahedra();
+
+		inline CProbeTetrahedra* getTetrahedra()
+		{
+			return m_tetrahedra;
+		}
+
 		DECLARE_GETTYPENAME(CLightProbes)
+
+	protected:
+
+		void setTetrahedraData(CProbeTetrahedra* tetrahedra);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,518 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CProbeTetrahedra.h"
+
+#include <algorithm>
+
+namespace Skylicht
+{
+	typedef core::vector3d<f64> SVec3d;
+
+	struct SBuildTetrahedron
+	{
+		int V[4];
+
+		// the circumsphere center = Origin + Offset
+		SVec3d Origin;
+		SVec3d Offset;
+		bool Flat;
+
+		bool inSphere(const SVec3d& p) const
+		{
+			if (Flat)
+				return true;
+
+			// |p - center|^2 < |offset|^2, without the large radius of the super tetrahedron
+			SVec3d d = p - Origin;
+			return d.getLengthSQ() < 2.0 * d.dotProduct(Offset);
+		}
+	};
+
+	struct SBuildFace
+	{
+		u64 Key;
+		int V[3];
+
+		bool operator<(const SBuildFace& other) const
+		{
+			return Key < other.Key;
+		}
+	};
+
+	// the vertices of the face that is opposite to vertex i
+	static const int s_faceVertex[4][3] = {
+		{1, 2, 3},
+		{0, 3, 2},
+		{0, 1, 3},
+		{0, 2, 1}
+	};
+
+	static u64 getFaceKey(int a, int b, int c)
+	{
+		if (a > b) core::swap(a, b);
+		if (b > c) core::swap(b, c);
+		if (a > b) core::swap(a, b);
+		return (u64)a | ((u64)b << 21) | ((u64)c << 42);
+	}
+
+	// > 0 if the tetrahedron abcd has the positive volume
+	static f64 orient3d(const SVec3d& a, const SVec3d& b, const SVec3d& c, const SVec3d& d)
+	{
+		SVec3d ad = a - d;
+		SVec3d bd = b - d;
+		SVec3d cd = c - d;
+		return ad.dotProduct(bd.crossProduct(cd));
+	}
+
+	static void getCircumsphere(const core::array<SVec3d>& points, SBuildTetrahedron& t)
+	{
+		const SVec3d& a = points[t.V[0]];
+		SVec3d ba = points[t.V[1]] - a;
+		SVec3d ca = points[t.V[2]] - a;
+		SVec3d da = points[t.V[3]] - a;
+
+		t.Origin = a;
+
+		f64 det = ba.dotProduct(ca.crossProduct(da));
+		if (fabs(det) < 1e-30)
+		{
+			// flat tetrahedron, it is always removed by the next point
+			t.Flat = true;
+			return;
+		}
+
+		t.Flat = false;
+		t.Offset = (ca.crossProduct(da) * ba.getLengthSQ() +
+			da.crossProduct(ba) * ca.getLengthSQ() +
+			ba.crossProduct(ca) * da.getLengthSQ()) / (2.0 * det);
+	}
+
+	static bool isFlat(const core::array<SVec3d>& points, const CProbeTetrahedra::STetrahedron& t)
+	{
+		f64 maxEdge = 0.0;
+		for (int i = 0; i < 4; i++)
+		{
+			for (int j = i + 1; j < 4; j++)
+				maxEdge = core::max_(maxEdge, (points[t.Vertex[i]] - points[t.Vertex[j]]).getLengthSQ());
+		}
+
+		maxEdge = sqrt(maxEdge);
+
+		f64 volume = orient3d(points[t.Vertex[0]], points[t.Vertex[1]], points[t.Vertex[2]], points[t.Vertex[3]]);
+		return volume < maxEdge * maxEdge * maxEdge * 1e-4;
+	}
+
+	CProbeTetrahedra::CProbeTetrahedra() :
+		m_numVertex(0),
+		m_valid(false)
+	{
+
+	}
+
+	CProbeTetrahedra::~CProbeTetrahedra()
+	{
+
+	}
+
+	void CProbeTetrahedra::clear()
+	{
+		m_numVertex = 0;
+		m_tetrahedra.set_used(0);
+		m_matrix.set_used(0);
+		m_positions.set_used(0);
+		m_valid = false;
+	}
+
+	void CProbeTetrahedra::jitterPositions(const core::vector3df* positions, int count, core::array<core::vector3df>& result)
+	{
+		result.set_used(count);
+		if (count == 0)
+			return;
+
+		core::aabbox3df box(positions[0]);
+		for (int i = 1; i < count; i++)
+			box.addInternalPoint(positions[i]);
+
+		float size = box.getExtent().getLength();
+		if (size <= 0.0f)
+			size = 1.0f;
+
+		// the probes are often on a grid, a tiny fixed offset breaks the cospherical points of Delaunay
+		// and keeps the grid cells from the flat tetrahedra
+		float scale = size * 1e-5f;
+
+		for (int i = 0; i < count; i++)
+		{
+			float offset[3];
+			u32 h = (u32)i * 2654435761u + 1;
+
+			for (int j = 0; j < 3; j++)
+			{
+				h ^= h >> 15;
+				h *= 2246822519u;
+				h ^= h >> 13;
+				offset[j] = ((h & 0xFFFF) / 65535.0f) * 2.0f - 1.0f;
+			}
+
+			result[i] = positions[i] + core::vector3df(offset[0], offset[1], offset[2]) * scale;
+		}
+	}
+
+	bool CProbeTetrahedra::build(const core::vector3df* positions, int count)
+	{
+		clear();
+
+		if (count < 4)
+			return false;
+
+		core::array<core::vector3df> jitter;
+		jitterPositions(positions, count, jitter);
+
+		core::array<SVec3d> points;
+		points.reallocate(count + 4);
+
+		core::aabbox3d<f64> box;
+		box.reset(SVec3d(jitter[0].X, jitter[0].Y, jitter[0].Z));
+
+		for (int i = 0; i < count; i++)
+		{
+			SVec3d p(jitter[i].X, jitter[i].Y, jitter[i].Z);
+			points.push_back(p);
+			box.addInternalPoint(p);
+		}
+
+		f64 size = core::max_(box.getExtent().getLength(), 1.0);
+
+		// the super tetrahedron that contains all points
+		// note: a larger one loses the precision of circumsphere test and breaks the cavity
+		SVec3d center = box.getCenter();
+		f64 r = size * 10.0;
+		points.push_back(center + SVec3d(r, r, r));
+		points.push_back(center + SVec3d(r, -r, -r));
+		points.push_back(center + SVec3d(-r, r, -r));
+		points.push_back(center + SVec3d(-r, -r, r));
+
+		std::vector<SBuildTetrahedron> tets;
+		std::vector<SBuildTetrahedron> keep;
+		std::vector<SBuildFace> faces;
+
+		SBuildTetrahedron super;
+		for (int i = 0; i < 4; i++)
+			super.V[i] = count + i;
+		if (orient3d(points[super.V[0]], points[super.V[1]], points[super.V[2]], points[super.V[3]]) < 0.0)
+			core::swap(super.V[0], super.V[1]);
+		getCircumsphere(points, super);
+		tets.push_back(super);
+
+		// insert the points in a shuffled order, the probes on a grid line make the thin tetrahedra that are not stable
+		std::vector<int> order(count);
+		u32 seed = 5381;
+		for (int i = 0; i < count; i++)
+			order[i] = i;
+		for (int i = count - 1; i > 0; i--)
+		{
+			seed = seed * 1664525 + 1013904223;
+			core::swap(order[i], order[(seed >> 8) % (i + 1)]);
+		}
+
+		// Bowyer-Watson: remove the tetrahedra that their circumsphere contains the point, and fill the cavity
+		for (int it = 0; it < count; it++)
+		{
+			int i = order[it];
+			const SVec3d& p = points[i];
+
+			keep.clear();
+			faces.clear();
+
+			for (const SBuildTetrahedron& t : tets)
+			{
+				if (t.inSphere(p))
+				{
+					for (int k = 0; k < 4; k++)
+					{
+						SBuildFace f;
+						f.V[0] = t.V[s_faceVertex[k][0]];
+						f.V[1] = t.V[s_faceVertex[k][1]];
+						f.V[2] = t.V[s_faceVertex[k][2]];
+						f.Key = getFaceKey(f.V[0], f.V[1], f.V[2]);
+						faces.push_back(f);
+					}
+				}
+				else
+				{
+					keep.push_back(t);
+				}
+			}
+
+			// the boundary faces of cavity are not shared by 2 removed tetrahedra
+			std::sort(faces.begin(), faces.end());
+
+			for (size_t j = 0, n = faces.size(); j < n; j++)
+			{
+				if ((j > 0 && faces[j - 1].Key == faces[j].Key) ||
+					(j + 1 < n && faces[j + 1].Key == faces[j].Key))
+					continue;
+
+				SBuildTetrahedron t;
+				t.V[0] = faces[j].V[0];
+				t.V[1] = faces[j].V[1];
+				t.V[2] = faces[j].V[2];
+				t.V[3] = i;
+
+				if (orient3d(points[t.V[0]], points[t.V[1]], points[t.V[2]], points[t.V[3]]) < 0.0)
+					core::swap(t.V[0], t.V[1]);
+
+				getCircumsphere(points, t);
+				keep.push_back(t);
+			}
+
+			tets.swap(keep);
+		}
+
+		// remove the tetrahedra of super vertices
+		f64 volume = 0.0;
+
+		for (const SBuildTetrahedron& t : tets)
+		{
+			if (t.V[0] >= count || t.V[1] >= count || t.V[2] >= count || t.V[3] >= count)
+				continue;
+
+			STetrahedron tet;
+			for (int k = 0; k < 4; k++)
+			{
+				tet.Vertex[k] = t.V[k];
+				tet.Neighbor[k] = -1;
+			}
+
+			m_tetrahedra.push_back(tet);
+			volume += orient3d(points[t.V[0]], points[t.V[1]], points[t.V[2]], points[t.V[3]]) / 6.0;
+		}
+
+		// all probes are on a plane
+		if (m_tetrahedra.size() == 0 || volume < size * size * size * 1e-4)
+		{
+			clear();
+			return false;
+		}
+
+		m_numVertex = count;
+		updateNeighbors();
+
+		// the points on the flat side of hull make the flat tetrahedra, remove them to keep the hull convex
+		bool removed = true;
+		while (removed)
+		{
+			removed = false;
+
+			core::array<STetrahedron> tetrahedra;
+			for (u32 i = 0, n = m_tetrahedra.size(); i < n; i++)
+			{
+				const STetrahedron& t = m_tetrahedra[i];
+
+				bool hull = t.Neighbor[0] == -1 || t.Neighbor[1] == -1 || t.Neighbor[2] == -1 || t.Neighbor[3] == -1;
+				if (hull && isFlat(points, t))
+				{
+					removed = true;
+					continue;
+				}
+
+				tetrahedra.push_back(t);
+			}
+
+			if (removed)
+			{
+				m_tetrahedra = tetrahedra;
+				updateNeighbors();
+			}
+		}
+
+		if (m_tetrahedra.size() == 0)
+		{
+			clear();
+			return false;
+		}
+
+		return updatePositions(positions, count);
+	}
+
+	void CProbeTetrahedra::setTetrahedra(const STetrahedron* tetrahedra, int numTetrahedra, int numVertex)
+	{
+		clear();
+
+		m_numVertex = numVertex;
+		for (int i = 0; i < numTetrahedra; i++)
+			m_tetrahedra.push_back(tetrahedra[i]);
+	}
+
+	void CProbeTetrahedra::updateNeighbors()
+	{
+		std::vector<SBuildFace> faces;
+
+		for (u32 i = 0, n = m_tetrahedra.size(); i < n; i++)
+		{
+			STetrahedron& t = m_tetrahedra[i];
+			for (int k = 0; k < 4; k++)
+			{
+				t.Neighbor[k] = -1;
+
+				SBuildFace f;
+				f.Key = getFaceKey(t.Vertex[s_faceVertex[k][0]], t.Vertex[s_faceVertex[k][1]], t.Vertex[s_faceVertex[k][2]]);
+				f.V[0] = (int)i;
+				f.V[1] = k;
+				faces.push_back(f);
+			}
+		}
+
+		std::sort(faces.begin(), faces.end());
+
+		for (size_t j = 0, n = faces.size(); j + 1 < n; j++)
+		{
+			if (faces[j].Key == faces[j + 1].Key)
+			{
+				m_tetrahedra[faces[j].V[0]].Neighbor[faces[j].V[1]] = faces[j + 1].V[0];
+				m_tetrahedra[faces[j + 1].V[0]].Neighbor[faces[j + 1].V[1]] = faces[j].V[0];
+				j++;
+			}
+		}
+	}
+
+	bool CProbeTetrahedra::updatePositions(const core::vector3df* positions, int count)
+	{
+		m_valid = false;
+
+		if (count != m_numVertex || m_tetrahedra.size() == 0)
+			return false;
+
+		jitterPositions(positions, count, m_positions);
+
+		u32 numTet = m_tetrahedra.size();
+		m_matrix.set_used(numTet * 9);
+
+		for (u32 i = 0; i < numTet; i++)
+		{
+			const STetrahedron& t = m_tetrahedra[i];
+
+			for (int k = 0; k < 4; k++)
+			{
+				if (t.Vertex[k] < 0 || t.Vertex[k] >= count)
+					return false;
+			}
+
+			const core::vector3df& p3 = m_positions[t.Vertex[3]];
+			core::vector3df c0 = m_positions[t.Vertex[0]] - p3;
+			core::vector3df c1 = m_positions[t.Vertex[1]] - p3;
+			core::vector3df c2 = m_positions[t.Vertex[2]] - p3;
+
+			SVec3d d0(c0.X, c0.Y, c0.Z);
+			SVec3d d1(c1.X, c1.Y, c1.Z);
+			SVec3d d2(c2.X, c2.Y, c2.Z);
+
+			// the probes moved and inverted the tetrahedron
+			f64 det = d0.dotProduct(d1.crossProduct(d2));
+			if (det <= 0.0)
+				return false;
+
+			// the rows of inverse matrix [c0 c1 c2]
+			SVec3d r0 = d1.crossProduct(d2) / det;
+			SVec3d r1 = d2.crossProduct(d0) / det;
+			SVec3d r2 = d0.crossProduct(d1) / det;
+
+			float* m = &m_matrix[i * 9];
+			m[0] = (float)r0.X; m[1] = (float)r0.Y; m[2] = (float)r0.Z;
+			m[3] = (float)r1.X; m[4] = (float)r1.Y; m[5] = (float)r1.Z;
+			m[6] = (float)r2.X; m[7] = (float)r2.Y; m[8] = (float)r2.Z;
+		}
+
+		m_valid = true;
+		return true;
+	}
+
+	void CProbeTetrahedra::getBarycentric(int tet, const core::vector3df& position, float* weights)
+	{
+		const float* m = &m_matrix[tet * 9];
+		core::vector3df d = position - m_positions[m_tetrahedra[tet].Vertex[3]];
+
+		weights[0] = m[0] * d.X + m[1] * d.Y + m[2] * d.Z;
+		weights[1] = m[3] * d.X + m[4] * d.Y + m[5] * d.Z;
+		weights[2] = m[6] * d.X + m[7] * d.Y + m[8] * d.Z;
+		weights[3] = 1.0f - weights[0] - weights[1] - weights[2];
+	}
+
+	int CProbeTetrahedra::findTetrahedron(const core::vector3df& position, int start, float* weights)
+	{
+		if (!m_valid)
+			return -1;
+
+		int numTet = (int)m_tetrahedra.size();
+		int tet = (start >= 0 && start < numTet) ? start : 0;
+
+		const float eps = -1e-5f;
+
+		// walk to the neighbor on the face that has the most negative weight
+		for (int step = 0; step < numTet; step++)
+		{
+			getBarycentric(tet, position, weights);
+
+			int face = -1;
+			float minWeight = eps;
+			for (int k = 0; k < 4; k++)
+			{
+				if (weights[k] < minWeight)
+				{
+					minWeight = weights[k];
+					face = k;
+				}
+			}
+
+			// inside, or outside of the hull
+			if (face == -1 || m_tetrahedra[tet].Neighbor[face] == -1)
+				break;
+
+			tet = m_tetrahedra[tet].Neighbor[face];
+		}
+
+		// clamp the weights of the position that is outside the probes
+		float sum = 0.0f;
+		for (int k = 0; k < 4; k++)
+		{
+			weights[k] = core::max_(weights[k], 0.0f);
+			sum += weights[k];
+		}
+
+		if (sum > 0.0f)
+		{
+			for (int k = 0; k < 4; k++)
+				weights[k] = weights[k] / sum;
+		}
+		else
+		{
+			for (int k = 0; k < 4; k++)
+				weights[k] = 0.25f;
+		}
+
+		return tet;
+	}
+}
@@ -0,0 +1,134 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+	/**
+	 * @brief Delaunay tetrahedralization of the light probe positions, it is used to blend the SH of 4 probes around an object.
+	 * @ingroup IndirectLighting
+	 *
+	 * The tetrahedra are built offline (see CLightProbes::buildTetrahedra) and saved with the probes,
+	 * the runtime only binds the current probe positions and never rebuilds the topology.
+	 *
+	 * An object keeps the tetrahedron of last lookup, the query walks from it to the neighbor tetrahedra,
+	 * so the cost is O(1) for a moving object.
+	 *
+	 * @code
+	 * float weights[4];
+	 * int tet = tetrahedra->findTetrahedron(position, lastTet, weights);
+	 * const CProbeTetrahedra::STetrahedron& t = tetrahedra->getTetrahedron(tet);
+	 * sh = weights[0] * probeSH[t.Vertex[0]] + ... + weights[3] * probeSH[t.Vertex[3]];
+	 * @endcode
+	 */
+	class SKYLICHT_API CProbeTetrahedra
+	{
+	public:
+		struct STetrahedron
+		{
+			int Vertex[4];
+
+			//! The tetrahedron on the face that is opposite to Vertex[i], -1 if it is the hull face
+			int Neighbor[4];
+		};
+
+	protected:
+		int m_numVertex;
+
+		core::array<STetrahedron> m_tetrahedra;
+
+		// inverse matrix of each tetrahedron to get the barycentric coordinates
+		core::array<float> m_matrix;
+
+		core::array<core::vector3df> m_positions;
+
+		bool m_valid;
+
+	public:
+		CProbeTetrahedra();
+
+		virtual ~CProbeTetrahedra();
+
+		void clear();
+
+		/**
+		 * @brief Build the Delaunay tetrahedralization (Bowyer-Watson), this is an offline step.
+		 * @return false if there are less than 4 probes, or all probes are on a plane.
+		 */
+		bool build(const core::vector3df* positions, int count);
+
+		/**
+		 * @brief Set the saved topology, call updatePositions after it.
+		 */
+		void setTetrahedra(const STetrahedron* tetrahedra, int numTetrahedra, int numVertex);
+
+		/**
+		 * @brief Bind the current probe positions to the tetrahedra.
+		 * @return false if the count of positions is not match or a tetrahedron is inverted by the moved probes.
+		 */
+		bool updatePositions(const core::vector3df* positions, int count);
+
+		/**
+		 * @brief Find the tetrahedron that contains the position by walking from the start tetrahedron.
+		 * @param start The result of last query, or -1.
+		 * @param weights The barycentric weights of 4 vertices, they are clamped if the position is outside of the probes.
+		 * @return The tetrahedron index, -1 if the tetrahedra is not valid.
+		 */
+		int findTetrahedron(const core::vector3df& position, int start, float* weights);
+
+		void getBarycentric(int tet, const core::vector3df& position, float* weights);
+
+		inline bool isValid()
+		{
+			return m_valid;
+		}
+
+		inline int getVertexCount()
+		{
+			return m_numVertex;
+		}
+
+		inline int getTetrahedronCount()
+		{
+			return (int)m_tetrahedra.size();
+		}
+
+		inline const STetrahedron& getTetrahedron(int i)
+		{
+			return m_tetrahedra[i];
+		}
+
+		inline const STetrahedron* getTetrahedra()
+		{
+			return m_tetrahedra.const_pointer();
+		}
+
+	protected:
+
+		void jitterPositions(const core::vector3df* positions, int count, core::array<core::vector3df>& result);
+
+		void updateNeighbors();
+	};
+}
@@ -0,0 +1,70 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CProbeTetrahedronSerializable.h"
+
+namespace Skylicht
+{
+	SERIALIZABLE_REGISTER(CProbeTetrahedronSerializable);
+
+	CProbeTetrahedronSerializable::CProbeTetrahedronSerializable() :
+		CObjectSerializable(getTypeName())
+	{
+		initProperty();
+	}
+
+	CProbeTetrahedronSerializable::CProbeTetrahedronSerializable(CObjectSerializable* parent) :
+		CObjectSerializable(getTypeName(), parent)
+	{
+		initProperty();
+	}
+
+	CProbeTetrahedronSerializable::~CProbeTetrahedronSerializable()
+	{
+
+	}
+
+	void CProbeTetrahedronSerializable::initProperty()
+	{
+		char name[64];
+		for (int i = 0; i < 4; i++)
+		{
+			sprintf(name, "v%d", i);
+			Vertex[i] = new CIntProperty(this, name, 0);
+			autoRelease(Vertex[i]);
+
+			sprintf(name, "n%d", i);
+			Neighbor[i] = new CIntProperty(this, name, -1);
+			autoRelease(Neighbor[i]);
+		}
+	}
+
+	CObjectSerializable* CProbeTetrahedronSerializable::clone()
+	{
+		CProbeTetrahedronSerializable* object = new CProbeTetrahedronSerializable();
+		copyTo(object);
+		return object;
+	}
+}
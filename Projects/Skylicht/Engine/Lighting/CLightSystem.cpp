@@ -512,14 +512,24 @@ namespace Skylicht
 		// set index
 		if (indirectData)
 		{
+			SVec4 lightIndex = indirectData->LightIndex;
+
 			if (data->CachedPointLights.Count >= 1)
-				indirectData->LightIndex.X = (float)(data->CachedPointLights.Lights[0]->UBOIndex);
+				lightIndex.X = (float)(data->CachedPointLights.Lights[0]->UBOIndex);
 
 			if (data->CachedPointLights.Count >= 2)
-				indirectData->LightIndex.Y = (float)(data->CachedPointLights.Lights[1]->UBOIndex);
+				lightIndex.Y = (float)(data->CachedPointLights.Lights[1]->UBOIndex);
 
 			if (data->CachedSpotLights.Count >= 1)
-				indirectData->LightIndex.Z = (float)(data->CachedSpotLights.Lights[0]->UBOIndex);
+				lightIndex.Z = (float)(data->CachedSpotLights.Lights[0]->UBOIndex);
+
+			if (lightIndex.X != indirectData->LightIndex.X ||
+				lightIndex.Y != indirectData->LightIndex.Y ||
+				lightIndex.Z != indirectData->LightIndex.Z)
+			{
+				indirectData->LightIndex = lightIndex;
+				indirectData->notifyChanged();
+			}
 		}
 	}
 
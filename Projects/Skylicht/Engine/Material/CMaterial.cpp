@@ -32,6 +32,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	u32 CMaterial::s_globalParamsChangeID = 0;
+
 	CMaterial::CMaterial(const char* name, const char* shaderPath) :
 		m_zBuffer(video::ECFN_LESSEQUAL),
 		m_zWriteEnable(true),
@@ -39,6 +41,7 @@ namespace Skylicht
 		m_frontfaceCulling(false),
 		m_doubleSided(false),
 		m_manualInitMaterial(false),
+		m_paramsChangeID(0),
 		m_deferred(false),
 		m_shaderPath(shaderPath),
 		m_materialName(name),
@@ -94,6 +97,8 @@ namespace Skylicht
 
 		for (int i = 0; i < MAX_SHADERPARAMS; i++)
 			mat->m_shaderParams.setValue(i, m_shaderParams.getParam(i));
+		mat->m_paramsChangeID++;
+		s_globalParamsChangeID++;
 
 		for (SUniformValue*& u : m_uniformParams)
 		{
@@ -111,6 +116,12 @@ namespace Skylicht
 			mat->m_uniformTextures.push_back(t);
 		}
 
+		for (SAsyncUniformTexture& async : m_asyncTextures)
+		{
+			async.Request->grab();
+			mat->m_asyncTextures.push_back(async);
+		}
+
 		for (int i = 0; i < MATERIAL_MAX_TEXTURES; i++)
 		{
 			mat->m_resourceTexture[i] = m_resourceTexture[i];
@@ -146,6 +157,8 @@ namespace Skylicht
 
 		for (int i = 0; i < MAX_SHADERPARAMS; i++)
 			mat->m_shaderParams.setValue(i, m_shaderParams.getParam(i));
+		mat->m_paramsChangeID++;
+		s_globalParamsChangeID++;
 
 		for (SUniformValue*& u : m_uniformParams)
 		{
@@ -167,6 +180,8 @@ namespace Skylicht
 
 	void CMaterial::deleteAllParams()
 	{
+		dropAsyncTexture();
+
 		for (SUniformValue*& uniform : m_uniformParams)
 			delete uniform;
 		m_uniformParams.clear();
@@ -571,6 +586,95 @@ namespace Skylicht
 		}
 	}
 
+	void CMaterial::loadUniformTextureAsync(int priority)
+	{
+		if (m_shader == NULL)
+			return;
+
+		dropAsyncTexture();
+
+		CTextureManager* textureManager = CTextureManager::getInstance();
+
+		for (int i = 0, n = (int)m_uniformTextures.size(); i < n; i++)
+		{
+			SUniformTexture* uniformTexture = m_uniformTextures[i];
+			SUniform* uniform = m_shader->getFSUniform(uniformTexture->Name.c_str());
+
+			if (uniform != NULL)
+			{
+				int textureSlot = (int)uniform->Value[0];
+				if (textureSlot < MATERIAL_MAX_TEXTURES && uniformTexture->Path.empty() == false)
+				{
+					CAsyncTexture* request = textureManager->getTextureAsync(uniformTexture->Path.c_str(), priority);
+					if (request == NULL)
+						continue;
+
+					ITexture* texture = NULL;
+					if (request->isReady())
+					{
+						texture = request->getTexture();
+						request->drop();
+					}
+					else
+					{
+						// use the null texture while loading
+						texture = textureManager->getNullTexture();
+						m_asyncTextures.push_back({ uniformTexture->Name, request });
+					}
+
+					m_textures[textureSlot] = texture;
+					uniformTexture->Texture = texture;
+					if (texture)
+						texture->grab();
+				}
+			}
+		}
+	}
+
+	bool CMaterial::updateAsyncTexture()
+	{
+		bool changed = false;
+
+		for (u32 i = 0; i < (u32)m_asyncTextures.size(); )
+		{
+			CAsyncTexture* request = m_asyncTextures[i].Request;
+			if (!request->isFinished())
+			{
+				i++;
+				continue;
+			}
+
+			SUniformTexture* uniformTexture = getUniformTexture(m_asyncTextures[i].Name.c_str());
+			if (uniformTexture != NULL && request->isReady())
+			{
+				ITexture* texture = request->getTexture();
+				texture->grab();
+
+				if (uniformTexture->Texture)
+					uniformTexture->Texture->drop();
+				uniformTexture->Texture = texture;
+
+				int textureSlot = uniformTexture->TextureSlot;
+				if (textureSlot >= 0 && textureSlot < MATERIAL_MAX_TEXTURES)
+					m_textures[textureSlot] = texture;
+
+				changed = true;
+			}
+
+			request->drop();
+			m_asyncTextures.erase(m_asyncTextures.begin() + i);
+		}
+
+		return changed;
+	}
+
+	void CMaterial::dropAsyncTexture()
+	{
+		for (SAsyncUniformTexture& async : m_asyncTextures)
+			async.Request->drop();
+		m_asyncTextures.clear();
+	}
+
 	void CMaterial::loadDefaultTexture()
 	{
 		CTextureManager* textureManager = CTextureManager::getInstance();
@@ -671,6 +775,8 @@ namespace Skylicht
 		if (m_shader == NULL)
 			return;
 
+		dropAsyncTexture();
+
 		for (int i = 0, n = (int)m_uniformTextures.size(); i < n; i++)
 		{
 			SUniformTexture* uniformTexture = m_uniformTextures[i];
@@ -1015,6 +1121,9 @@ namespace Skylicht
 
 	void CMaterial::updateTexture(SMaterial& mat)
 	{
+		if (m_asyncTextures.size() > 0)
+			updateAsyncTexture();
+
 		// property
 		mat.ZBuffer = m_zBuffer;
 		mat.ZWriteEnable = m_zWriteEnable;
@@ -1209,6 +1318,9 @@ namespace Skylicht
 		if (m_shader == NULL)
 			return;
 
+		m_paramsChangeID++;
+		s_globalParamsChangeID++;
+
 		for (int i = 0, n = (int)m_uniformParams.size(); i < n; i++)
 		{
 			SUniformValue* uniformValue = m_uniformParams[i];
@@ -31,6 +31,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	class CAsyncTexture;
+
 	/// @brief The object class describes material information
 	/// such as which shader it's associated with, which texture it uses, and what its color parameters are.
 	/// @ingroup Materials
@@ -251,6 +253,15 @@ namespace Skylicht
 		/// Extra parameters for shader switching
 		std::vector<SExtraParams*> m_extras;
 
+		struct SAsyncUniformTexture
+		{
+			std::string Name;
+			CAsyncTexture* Request;
+		};
+
+		/// The uniform textures that are loading by loadUniformTextureAsync
+		std::vector<SAsyncUniformTexture> m_asyncTextures;
+
 		/// Default textures from shader resources
 		ITexture* m_resourceTexture[MATERIAL_MAX_TEXTURES];
 
@@ -284,6 +295,12 @@ namespace Skylicht
 		/// Manual material initialization flag
 		bool m_manualInitMaterial;
 
+		/// Increased when m_shaderParams is changed
+		u32 m_paramsChangeID;
+
+		/// Increased when the shader parameters of any material are changed
+		static u32 s_globalParamsChangeID;
+
 		/// Pointer to associated shader
 		CShader* m_shader;
 
@@ -677,6 +694,24 @@ namespace Skylicht
 			return m_shaderParams;
 		}
 
+		/**
+		 * @brief Get the counter that is increased each time the shader parameters are updated.
+		 * @return Change id of shader parameters.
+		 */
+		inline u32 getParamsChangeID()
+		{
+			return m_paramsChangeID;
+		}
+
+		/**
+		 * @brief Get the counter that is increased each time the shader parameters of any material are updated.
+		 * @return Change id of shader parameters of all materials.
+		 */
+		static u32 getGlobalParamsChangeID()
+		{
+			return s_globalParamsChangeID;
+		}
+
 		/**
 		 * @brief Returns true if the uniform with the given name exists.
 		 * @param name Uniform name.
@@ -734,6 +769,27 @@ namespace Skylicht
 		 */
 		void loadUniformTexture();
 
+		/**
+		 * @brief Load all uniform textures on the job threads (see CTextureManager::getTextureAsync).
+		 * The null texture is used until the texture is ready.
+		 * @param priority The request priority.
+		 */
+		void loadUniformTextureAsync(int priority = 0);
+
+		/**
+		 * @brief Apply the async uniform textures that are ready, it is called by updateTexture.
+		 * @return True if a texture is changed.
+		 */
+		bool updateAsyncTexture();
+
+		/**
+		 * @brief Check the material is loading the async textures.
+		 */
+		inline bool isLoadingAsyncTexture()
+		{
+			return m_asyncTextures.size() > 0;
+		}
+
 		/**
 		 * @brief Unload all default textures.
 		 */
@@ -820,6 +876,11 @@ namespace Skylicht
 		 */
 		void updateSetTextureSlot();
 
+		/**
+		 * @brief Release the async texture requests.
+		 */
+		void dropAsyncTexture();
+
 		/**
 		 * @brief Initialize default values for material uniforms based on shader defaults.
 		 */
@@ -111,6 +111,7 @@ namespace Skylicht
 		loadShader("BuiltIn/Shader/ShadowDepthWrite/ShadowDepthWriteSkinMesh.xml");
 		loadShader("BuiltIn/Shader/ShadowDepthWrite/ShadowLightDistanceWrite.xml");
 		loadShader("BuiltIn/Shader/ShadowDepthWrite/ShadowLightDistanceWriteSkinMesh.xml");
+		loadShader("BuiltIn/Shader/ShadowDepthWrite/ShadowDepthCopy.xml");
 
 		loadShader("BuiltIn/Shader/ShadowDepthWrite/SDWStandardSGInstancing.xml");
 		loadShader("BuiltIn/Shader/ShadowDepthWrite/SDWTangentSGInstancing.xml");
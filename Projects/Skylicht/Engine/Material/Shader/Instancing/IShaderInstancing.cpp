@@ -271,60 +271,136 @@ namespace Skylicht
 		transformBuffer->set_used(count);
 		indirectLightBuffer->set_used(count);
 
-		float invColor = 1.111f / 255.0f;
-
 		for (int i = 0; i < count; i++)
 		{
-			SVtxTransform& transform = transformBuffer->getVertex(i);
-			SVtxIndirectLighting& indirectLight = indirectLightBuffer->getVertex(i);
+			getTransformAndLighting(
+				entities[i],
+				transformBuffer->getVertex(i),
+				indirectLightBuffer->getVertex(i));
+		}
 
-			// world transform
-			CWorldTransformData* world = GET_ENTITY_DATA(entities[i], CWorldTransformData);
-			transform.World = world->World;
+		tBuffer->setDirty();
+		lBuffer->setDirty();
+	}
+
+	int IShaderInstancing::updateTransformAndLighting(
+		CVertexBuffer<SVtxTransform>* tBuffer,
+		CVertexBuffer<SVtxIndirectLighting>* lBuffer,
+		CEntity** entities,
+		int count,
+		int* dirtySlots,
+		int numDirtySlot)
+	{
+		tBuffer->set_used(count);
+		lBuffer->set_used(count);
+
+		SVtxTransform* transforms = (SVtxTransform*)tBuffer->getVertices();
+		SVtxIndirectLighting* indirectLights = (SVtxIndirectLighting*)lBuffer->getVertices();
+
+		if (numDirtySlot >= count && count > 0)
+		{
+			// all instances are changed, rewrite the whole buffers
+			for (int i = 0; i < count; i++)
+				getTransformAndLighting(entities[i], transforms[i], indirectLights[i]);
 
-			// indirect lighting
-			CIndirectLightingData* indirectLighting = GET_ENTITY_DATA(entities[i], CIndirectLightingData);
-			if (indirectLighting)
+			tBuffer->setDirty();
+			lBuffer->setDirty();
+			return 1;
+		}
+
+		std::sort(dirtySlots, dirtySlots + numDirtySlot);
+
+		int numRange = 0;
+		int rangeBegin = 0;
+		int rangeEnd = 0;
+
+		for (int i = 0; i < numDirtySlot; i++)
+		{
+			int slot = dirtySlots[i];
+
+			// the slot is removed or already rewritten
+			if (slot >= count || slot < rangeEnd)
+				continue;
+
+			getTransformAndLighting(entities[slot], transforms[slot], indirectLights[slot]);
+
+			if (slot == rangeEnd && rangeBegin < rangeEnd)
 			{
-				switch (indirectLighting->Type)
-				{
-				case CIndirectLightingData::SH9:
-				{
-					if (indirectLighting->SH)
-					{
-						indirectLight.D0 = indirectLighting->SH[0];
-						indirectLight.D1 = indirectLighting->SH[1];
-						indirectLight.D2 = indirectLighting->SH[2];
-						indirectLight.D3 = indirectLighting->SH[3];
-					}
-				}
-				break;
-				case CIndirectLightingData::AmbientColor:
-				{
-					indirectLight.D0.set(
-						indirectLighting->Color.getRed() * invColor,
-						indirectLighting->Color.getGreen() * invColor,
-						indirectLighting->Color.getBlue() * invColor
-					);
-
-					indirectLight.D1.set(0.0f, 0.0f, 0.0f);
-					indirectLight.D2.set(0.0f, 0.0f, 0.0f);
-					indirectLight.D3.set(0.0f, 0.0f, 0.0f);
-				}
-				break;
-				default:
+				rangeEnd++;
+				continue;
+			}
+
+			if (rangeBegin < rangeEnd)
+			{
+				tBuffer->setDirty((u32)rangeBegin, (u32)rangeEnd);
+				lBuffer->setDirty((u32)rangeBegin, (u32)rangeEnd);
+				numRange++;
+			}
+
+			rangeBegin = slot;
+			rangeEnd = slot + 1;
+		}
+
+		if (rangeBegin < rangeEnd)
+		{
+			tBuffer->setDirty((u32)rangeBegin, (u32)rangeEnd);
+			lBuffer->setDirty((u32)rangeBegin, (u32)rangeEnd);
+			numRange++;
+		}
+
+		return numRange;
+	}
+
+	void IShaderInstancing::getTransformAndLighting(
+		CEntity* entity,
+		SVtxTransform& transform,
+		SVtxIndirectLighting& indirectLight)
+	{
+		// world transform
+		CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+		transform.World = world->World;
+
+		// indirect lighting
+		CIndirectLightingData* indirectLighting = GET_ENTITY_DATA(entity, CIndirectLightingData);
+		if (indirectLighting)
+		{
+			switch (indirectLighting->Type)
+			{
+			case CIndirectLightingData::SH9:
+			{
+				if (indirectLighting->SH)
 				{
+					indirectLight.D0 = indirectLighting->SH[0];
+					indirectLight.D1 = indirectLighting->SH[1];
+					indirectLight.D2 = indirectLighting->SH[2];
+					indirectLight.D3 = indirectLighting->SH[3];
 				}
-				break;
-				}
+			}
+			break;
+			case CIndirectLightingData::AmbientColor:
+			{
+				float invColor = 1.111f / 255.0f;
+
+				indirectLight.D0.set(
+					indirectLighting->Color.getRed() * invColor,
+					indirectLighting->Color.getGreen() * invColor,
+					indirectLighting->Color.getBlue() * invColor
+				);
 
-				// light affect for this entity
-				transform.LightIndex = indirectLighting->LightIndex;
+				indirectLight.D1.set(0.0f, 0.0f, 0.0f);
+				indirectLight.D2.set(0.0f, 0.0f, 0.0f);
+				indirectLight.D3.set(0.0f, 0.0f, 0.0f);
+			}
+			break;
+			default:
+			{
+			}
+			break;
 			}
-		}
 
-		tBuffer->setDirty();
-		lBuffer->setDirty();
+			// light affect for this entity
+			transform.LightIndex = indirectLighting->LightIndex;
+		}
 	}
 
 	void IShaderInstancing::batchTransform(
@@ -195,6 +195,36 @@ namespace Skylicht
 			CEntity** entities,
 			int count);
 
+		/**
+		 * @brief Update transform and lighting vertex buffers, only the dirty instances are rewritten (static method).
+		 *        Each run of adjacent dirty slots is marked as a dirty range of the buffers, the other instances are not accessed.
+		 * @param tBuffer Transform vertex buffer.
+		 * @param lBuffer Indirect lighting vertex buffer.
+		 * @param entities Array of entities.
+		 * @param count Number of instances.
+		 * @param dirtySlots The slots must be rewritten (they are sorted), the slots >= count are skipped.
+		 * @param numDirtySlot Number of dirty slots.
+		 * @return Number of the dirty ranges.
+		 */
+		static int updateTransformAndLighting(
+			CVertexBuffer<SVtxTransform>* tBuffer,
+			CVertexBuffer<SVtxIndirectLighting>* lBuffer,
+			CEntity** entities,
+			int count,
+			int* dirtySlots,
+			int numDirtySlot);
+
+		/**
+		 * @brief Get the transform and lighting instance data of an entity (static method).
+		 * @param entity The entity.
+		 * @param transform Output transform data.
+		 * @param indirectLight Output indirect lighting data, unchanged if the entity has no SH or ambient color.
+		 */
+		static void getTransformAndLighting(
+			CEntity* entity,
+			SVtxTransform& transform,
+			SVtxIndirectLighting& indirectLight);
+
 		/**
 		 * @brief Batch update transform vertex buffer for multiple entities (static method).
 		 * @param tBuffer Transform vertex buffer.
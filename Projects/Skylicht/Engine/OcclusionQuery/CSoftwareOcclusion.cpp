@@ -0,0 +1,693 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CSoftwareOcclusion.h"
+#include "Utils/SIMD.h"
+#include "Job/CJobScheduler.h"
+
+#include <chrono>
+
+// the vertex is near the eye plane or behind the camera
+#define OCCLUSION_NEAR_W 0.0001f
+
+namespace Skylicht
+{
+	typedef std::chrono::high_resolution_clock SOcclusionClock;
+
+	static inline float getTimeMs(const SOcclusionClock::time_point& begin)
+	{
+		std::chrono::duration<float, std::milli> t = SOcclusionClock::now() - begin;
+		return t.count();
+	}
+
+	CSoftwareOcclusion::CSoftwareOcclusion(int width, int height) :
+		m_width(0),
+		m_height(0),
+		m_tileX(0),
+		m_tileY(0),
+		m_blockX(0),
+		m_blockY(0),
+		m_testTime(0.0f)
+	{
+		memset(&m_stats, 0, sizeof(SStats));
+		setResolution(width, height);
+	}
+
+	CSoftwareOcclusion::~CSoftwareOcclusion()
+	{
+
+	}
+
+	void CSoftwareOcclusion::setResolution(int width, int height)
+	{
+		m_tileX = core::max_((width + TileWidth - 1) / TileWidth, 1);
+		m_tileY = core::max_((height + TileHeight - 1) / TileHeight, 1);
+
+		m_width = m_tileX * TileWidth;
+		m_height = m_tileY * TileHeight;
+
+		m_blockX = m_width / BlockSize;
+		m_blockY = m_height / BlockSize;
+
+		m_depth.set_used(m_width * m_height);
+		m_hiz.set_used(m_blockX * m_blockY);
+		m_bins.resize(m_tileX * m_tileY);
+
+		for (u32 i = 0, n = m_depth.size(); i < n; i++)
+			m_depth[i] = FLT_MAX;
+
+		for (u32 i = 0, n = m_hiz.size(); i < n; i++)
+			m_hiz[i] = FLT_MAX;
+	}
+
+	void CSoftwareOcclusion::beginFrame(const core::matrix4& viewProj)
+	{
+		m_viewProj = viewProj;
+
+		m_triangles.set_used(0);
+		for (u32 i = 0, n = (u32)m_bins.size(); i < n; i++)
+			m_bins[i].set_used(0);
+
+		memset(&m_stats, 0, sizeof(SStats));
+		m_testTime = 0.0f;
+	}
+
+	void CSoftwareOcclusion::transformVertices(const u8* vertices, u32 stride, int numVertex, const core::matrix4& mvp)
+	{
+		m_clipVertices.set_used(numVertex);
+		SClipVertex* out = m_clipVertices.pointer();
+		const f32* m = mvp.pointer();
+
+#if defined(SKYLICHT_SIMD_SSE)
+		__m128 c0 = _mm_loadu_ps(m);
+		__m128 c1 = _mm_loadu_ps(m + 4);
+		__m128 c2 = _mm_loadu_ps(m + 8);
+		__m128 c3 = _mm_loadu_ps(m + 12);
+
+		for (int i = 0; i < numVertex; i++)
+		{
+			const f32* p = (const f32*)(vertices + i * stride);
+
+			__m128 r = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_set1_ps(p[0])));
+			r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(p[1])));
+			r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(p[2])));
+			_mm_storeu_ps(&out[i].X, r);
+		}
+#elif defined(SKYLICHT_SIMD_NEON)
+		float32x4_t c0 = vld1q_f32(m);
+		float32x4_t c1 = vld1q_f32(m + 4);
+		float32x4_t c2 = vld1q_f32(m + 8);
+		float32x4_t c3 = vld1q_f32(m + 12);
+
+		for (int i = 0; i < numVertex; i++)
+		{
+			const f32* p = (const f32*)(vertices + i * stride);
+
+			float32x4_t r = vmlaq_n_f32(c3, c0, p[0]);
+			r = vmlaq_n_f32(r, c1, p[1]);
+			r = vmlaq_n_f32(r, c2, p[2]);
+			vst1q_f32(&out[i].X, r);
+		}
+#else
+		for (int i = 0; i < numVertex; i++)
+		{
+			const f32* p = (const f32*)(vertices + i * stride);
+
+			out[i].X = p[0] * m[0] + p[1] * m[4] + p[2] * m[8] + m[12];
+			out[i].Y = p[0] * m[1] + p[1] * m[5] + p[2] * m[9] + m[13];
+			out[i].Z = p[0] * m[2] + p[1] * m[6] + p[2] * m[10] + m[14];
+			out[i].W = p[0] * m[3] + p[1] * m[7] + p[2] * m[11] + m[15];
+		}
+#endif
+	}
+
+	void CSoftwareOcclusion::setupTriangle4Scalar(const SClipTriangle4& in, f32 width, f32 height, STriangleSetup4& out)
+	{
+		out.Valid = 0;
+
+		for (int t = 0; t < 4; t++)
+		{
+			f32 x[3], y[3], z[3];
+			bool clipped = false;
+
+			for (int i = 0; i < 3; i++)
+			{
+				// skip the triangle that is clipped by near plane (the occluder is conservative)
+				if (in.W[i][t] < OCCLUSION_NEAR_W)
+					clipped = true;
+
+				f32 invW = 1.0f / in.W[i][t];
+				x[i] = (in.X[i][t] * invW * 0.5f + 0.5f) * width;
+				y[i] = (0.5f - in.Y[i][t] * invW * 0.5f) * height;
+				z[i] = in.Z[i][t] * invW;
+			}
+
+			out.MinX[t] = core::min_(core::min_(x[0], x[1]), x[2]);
+			out.MinY[t] = core::min_(core::min_(y[0], y[1]), y[2]);
+			out.MaxX[t] = core::max_(core::max_(x[0], x[1]), x[2]);
+			out.MaxY[t] = core::max_(core::max_(y[0], y[1]), y[2]);
+
+			f32 area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+			f32 invArea = 1.0f / area;
+
+			// edge i is opposite vertex i, the pixel is inside if all edges >= 0
+			f32 a[3], b[3], c[3];
+			for (int i = 0; i < 3; i++)
+			{
+				int v0 = (i + 1) % 3;
+				int v1 = (i + 2) % 3;
+				a[i] = y[v0] - y[v1];
+				b[i] = x[v1] - x[v0];
+				c[i] = x[v0] * y[v1] - y[v0] * x[v1];
+			}
+
+			// depth plane from the barycentric, it does not depend on the winding
+			out.ZA[t] = (a[0] * z[0] + a[1] * z[1] + a[2] * z[2]) * invArea;
+			out.ZB[t] = (b[0] * z[0] + b[1] * z[1] + b[2] * z[2]) * invArea;
+			out.ZC[t] = (c[0] * z[0] + c[1] * z[1] + c[2] * z[2]) * invArea;
+
+			// the occluder is 2 sided, flip the edges of the back face
+			f32 sign = area < 0.0f ? -1.0f : 1.0f;
+			for (int i = 0; i < 3; i++)
+			{
+				out.EdgeA[i][t] = a[i] * sign;
+				out.EdgeB[i][t] = b[i] * sign;
+				out.EdgeC[i][t] = c[i] * sign;
+			}
+
+			if (!clipped && fabsf(area) >= 1e-8f)
+				out.Valid |= 1 << t;
+		}
+	}
+
+	void CSoftwareOcclusion::setupTriangle4(const SClipTriangle4& in, f32 width, f32 height, STriangleSetup4& out)
+	{
+#if defined(SKYLICHT_SIMD_SSE)
+		__m128 x[3], y[3], z[3];
+		__m128 half = _mm_set1_ps(0.5f);
+		__m128 w = _mm_set1_ps(width);
+		__m128 h = _mm_set1_ps(height);
+		__m128 nearW = _mm_set1_ps(OCCLUSION_NEAR_W);
+		__m128 one = _mm_set1_ps(1.0f);
+		__m128 signBit = _mm_set1_ps(-0.0f);
+		__m128 valid = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+		for (int i = 0; i < 3; i++)
+		{
+			__m128 cw = _mm_loadu_ps(in.W[i]);
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(cw, nearW));
+
+			__m128 invW = _mm_div_ps(one, cw);
+			x[i] = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(in.X[i]), invW), half), half), w);
+			y[i] = _mm_mul_ps(_mm_sub_ps(half, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(in.Y[i]), invW), half)), h);
+			z[i] = _mm_mul_ps(_mm_loadu_ps(in.Z[i]), invW);
+		}
+
+		_mm_storeu_ps(out.MinX, _mm_min_ps(_mm_min_ps(x[0], x[1]), x[2]));
+		_mm_storeu_ps(out.MinY, _mm_min_ps(_mm_min_ps(y[0], y[1]), y[2]));
+		_mm_storeu_ps(out.MaxX, _mm_max_ps(_mm_max_ps(x[0], x[1]), x[2]));
+		_mm_storeu_ps(out.MaxY, _mm_max_ps(_mm_max_ps(y[0], y[1]), y[2]));
+
+		__m128 area = _mm_sub_ps(
+			_mm_mul_ps(_mm_sub_ps(x[1], x[0]), _mm_sub_ps(y[2], y[0])),
+			_mm_mul_ps(_mm_sub_ps(y[1], y[0]), _mm_sub_ps(x[2], x[0])));
+		__m128 invArea = _mm_div_ps(one, area);
+
+		__m128 a[3], b[3], c[3];
+		for (int i = 0; i < 3; i++)
+		{
+			int v0 = (i + 1) % 3;
+			int v1 = (i + 2) % 3;
+			a[i] = _mm_sub_ps(y[v0], y[v1]);
+			b[i] = _mm_sub_ps(x[v1], x[v0]);
+			c[i] = _mm_sub_ps(_mm_mul_ps(x[v0], y[v1]), _mm_mul_ps(y[v0], x[v1]));
+		}
+
+		_mm_storeu_ps(out.ZA, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], z[0]), _mm_mul_ps(a[1], z[1])), _mm_mul_ps(a[2], z[2])), invArea));
+		_mm_storeu_ps(out.ZB, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b[0], z[0]), _mm_mul_ps(b[1], z[1])), _mm_mul_ps(b[2], z[2])), invArea));
+		_mm_storeu_ps(out.ZC, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0], z[0]), _mm_mul_ps(c[1], z[1])), _mm_mul_ps(c[2], z[2])), invArea));
+
+		// flip the sign of the edges if the area is negative
+		__m128 flip = _mm_and_ps(area, signBit);
+		for (int i = 0; i < 3; i++)
+		{
+			_mm_storeu_ps(out.EdgeA[i], _mm_xor_ps(a[i], flip));
+			_mm_storeu_ps(out.EdgeB[i], _mm_xor_ps(b[i], flip));
+			_mm_storeu_ps(out.EdgeC[i], _mm_xor_ps(c[i], flip));
+		}
+
+		valid = _mm_and_ps(valid, _mm_cmpge_ps(_mm_andnot_ps(signBit, area), _mm_set1_ps(1e-8f)));
+		out.Valid = (u32)_mm_movemask_ps(valid);
+#elif defined(SKYLICHT_SIMD_NEON)
+		float32x4_t x[3], y[3], z[3];
+		float32x4_t half = vdupq_n_f32(0.5f);
+		float32x4_t w = vdupq_n_f32(width);
+		float32x4_t h = vdupq_n_f32(height);
+		float32x4_t nearW = vdupq_n_f32(OCCLUSION_NEAR_W);
+		uint32x4_t valid = vdupq_n_u32(0xFFFFFFFF);
+
+		for (int i = 0; i < 3; i++)
+		{
+			float32x4_t cw = vld1q_f32(in.W[i]);
+			valid = vandq_u32(valid, vcgeq_f32(cw, nearW));
+
+			// reciprocal with 2 newton steps
+			float32x4_t invW = vrecpeq_f32(cw);
+			invW = vmulq_f32(vrecpsq_f32(cw, invW), invW);
+			invW = vmulq_f32(vrecpsq_f32(cw, invW), invW);
+
+			x[i] = vmulq_f32(vaddq_f32(vmulq_f32(vmulq_f32(vld1q_f32(in.X[i]), invW), half), half), w);
+			y[i] = vmulq_f32(vsubq_f32(half, vmulq_f32(vmulq_f32(vld1q_f32(in.Y[i]), invW), half)), h);
+			z[i] = vmulq_f32(vld1q_f32(in.Z[i]), invW);
+		}
+
+		vst1q_f32(out.MinX, vminq_f32(vminq_f32(x[0], x[1]), x[2]));
+		vst1q_f32(out.MinY, vminq_f32(vminq_f32(y[0], y[1]), y[2]));
+		vst1q_f32(out.MaxX, vmaxq_f32(vmaxq_f32(x[0], x[1]), x[2]));
+		vst1q_f32(out.MaxY, vmaxq_f32(vmaxq_f32(y[0], y[1]), y[2]));
+
+		float32x4_t area = vsubq_f32(
+			vmulq_f32(vsubq_f32(x[1], x[0]), vsubq_f32(y[2], y[0])),
+			vmulq_f32(vsubq_f32(y[1], y[0]), vsubq_f32(x[2], x[0])));
+
+		float32x4_t invArea = vrecpeq_f32(area);
+		invArea = vmulq_f32(vrecpsq_f32(area, invArea), invArea);
+		invArea = vmulq_f32(vrecpsq_f32(area, invArea), invArea);
+
+		float32x4_t a[3], b[3], c[3];
+		for (int i = 0; i < 3; i++)
+		{
+			int v0 = (i + 1) % 3;
+			int v1 = (i + 2) % 3;
+			a[i] = vsubq_f32(y[v0], y[v1]);
+			b[i] = vsubq_f32(x[v1], x[v0]);
+			c[i] = vsubq_f32(vmulq_f32(x[v0], y[v1]), vmulq_f32(y[v0], x[v1]));
+		}
+
+		vst1q_f32(out.ZA, vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(a[0], z[0]), vmulq_f32(a[1], z[1])), vmulq_f32(a[2], z[2])), invArea));
+		vst1q_f32(out.ZB, vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(b[0], z[0]), vmulq_f32(b[1], z[1])), vmulq_f32(b[2], z[2])), invArea));
+		vst1q_f32(out.ZC, vmulq_f32(vaddq_f32(vaddq_f32(vmulq_f32(c[0], z[0]), vmulq_f32(c[1], z[1])), vmulq_f32(c[2], z[2])), invArea));
+
+		// flip the sign of the edges if the area is negative
+		uint32x4_t flip = vandq_u32(vreinterpretq_u32_f32(area), vdupq_n_u32(0x80000000));
+		for (int i = 0; i < 3; i++)
+		{
+			vst1q_f32(out.EdgeA[i], vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a[i]), flip)));
+			vst1q_f32(out.EdgeB[i], vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(b[i]), flip)));
+			vst1q_f32(out.EdgeC[i], vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(c[i]), flip)));
+		}
+
+		valid = vandq_u32(valid, vcgeq_f32(vabsq_f32(area), vdupq_n_f32(1e-8f)));
+		out.Valid = (vgetq_lane_u32(valid, 0) & 1) |
+			(vgetq_lane_u32(valid, 1) & 2) |
+			(vgetq_lane_u32(valid, 2) & 4) |
+			(vgetq_lane_u32(valid, 3) & 8);
+#else
+		setupTriangle4Scalar(in, width, height, out);
+#endif
+	}
+
+	void CSoftwareOcclusion::binTriangles(const STriangleSetup4& setup, int count)
+	{
+		for (int t = 0; t < count; t++)
+		{
+			if ((setup.Valid & (1 << t)) == 0)
+				continue;
+
+			// clamp before the int conversion, the vertex near the eye plane is very far on the screen
+			s32 minX = (s32)floorf(core::clamp(setup.MinX[t], 0.0f, (f32)m_width));
+			s32 minY = (s32)floorf(core::clamp(setup.MinY[t], 0.0f, (f32)m_height));
+			s32 maxX = core::min_((s32)ceilf(core::clamp(setup.MaxX[t], -1.0f, (f32)m_width)), m_width - 1);
+			s32 maxY = core::min_((s32)ceilf(core::clamp(setup.MaxY[t], -1.0f, (f32)m_height)), m_height - 1);
+
+			if (minX > maxX || minY > maxY)
+				continue;
+
+			STriangle tri;
+			tri.MinX = minX;
+			tri.MinY = minY;
+			tri.MaxX = maxX;
+			tri.MaxY = maxY;
+
+			for (int i = 0; i < 3; i++)
+			{
+				tri.EdgeA[i] = setup.EdgeA[i][t];
+				tri.EdgeB[i] = setup.EdgeB[i][t];
+				tri.EdgeC[i] = setup.EdgeC[i][t];
+			}
+
+			tri.ZA = setup.ZA[t];
+			tri.ZB = setup.ZB[t];
+			tri.ZC = setup.ZC[t];
+
+			// bin to tiles
+			u32 id = m_triangles.size();
+			m_triangles.push_back(tri);
+
+			int tx0 = minX / TileWidth;
+			int tx1 = maxX / TileWidth;
+			int ty0 = minY / TileHeight;
+			int ty1 = maxY / TileHeight;
+
+			for (int ty = ty0; ty <= ty1; ty++)
+			{
+				for (int tx = tx0; tx <= tx1; tx++)
+					m_bins[ty * m_tileX + tx].push_back(id);
+			}
+
+			m_stats.TrianglesDrawn++;
+		}
+	}
+
+	template<class T>
+	void CSoftwareOcclusion::setupTriangles(const T* indices, int numIndex)
+	{
+		const SClipVertex* v = m_clipVertices.const_pointer();
+		u32 numVertex = m_clipVertices.size();
+
+		SClipTriangle4 batch;
+		STriangleSetup4 setup;
+		int count = 0;
+
+		f32 width = (f32)m_width;
+		f32 height = (f32)m_height;
+
+		for (int i = 0; i + 2 < numIndex; i += 3)
+		{
+			u32 id[3] = {
+				(u32)indices[i],
+				(u32)indices[i + 1],
+				(u32)indices[i + 2]
+			};
+
+			if (id[0] >= numVertex || id[1] >= numVertex || id[2] >= numVertex)
+				continue;
+
+			// gather 4 triangles to setup them together
+			for (int j = 0; j < 3; j++)
+			{
+				const SClipVertex& c = v[id[j]];
+				batch.X[j][count] = c.X;
+				batch.Y[j][count] = c.Y;
+				batch.Z[j][count] = c.Z;
+				batch.W[j][count] = c.W;
+			}
+
+			if (++count == 4)
+			{
+				setupTriangle4(batch, width, height, setup);
+				binTriangles(setup, count);
+				count = 0;
+			}
+		}
+
+		if (count > 0)
+		{
+			// the unused lanes repeat the first triangle, they are not binned
+			for (int t = count; t < 4; t++)
+			{
+				for (int j = 0; j < 3; j++)
+				{
+					batch.X[j][t] = batch.X[j][0];
+					batch.Y[j][t] = batch.Y[j][0];
+					batch.Z[j][t] = batch.Z[j][0];
+					batch.W[j][t] = batch.W[j][0];
+				}
+			}
+
+			setupTriangle4(batch, width, height, setup);
+			binTriangles(setup, count);
+		}
+	}
+
+	void CSoftwareOcclusion::addOccluder(CMesh* mesh, const core::matrix4& world)
+	{
+		SOcclusionClock::time_point begin = SOcclusionClock::now();
+
+		core::matrix4 mvp = m_viewProj * world;
+
+		for (u32 i = 0, n = mesh->getMeshBufferCount(); i < n; i++)
+		{
+			IMeshBuffer* mb = mesh->getMeshBuffer(i);
+			if (mb->getPrimitiveType() != scene::EPT_TRIANGLES)
+				continue;
+
+			IVertexBuffer* vb = mb->getVertexBuffer();
+			IIndexBuffer* ib = mb->getIndexBuffer();
+
+			int numVertex = (int)vb->getVertexCount();
+			int numIndex = (int)ib->getIndexCount();
+
+			// the position is the first attribute of all vertex types
+			transformVertices((const u8*)vb->getVertices(), vb->getVertexSize(), numVertex, mvp);
+
+			if (ib->getType() == video::EIT_16BIT)
+				setupTriangles((const u16*)ib->getIndices(), numIndex);
+			else
+				setupTriangles((const u32*)ib->getIndices(), numIndex);
+		}
+
+		m_stats.OccludersDrawn++;
+		m_stats.RasterizeTime += getTimeMs(begin);
+	}
+
+	void CSoftwareOcclusion::addOccluder(const core::vector3df* positions, int numVertex, const u32* indices, int numIndex, const core::matrix4& world)
+	{
+		SOcclusionClock::time_point begin = SOcclusionClock::now();
+
+		core::matrix4 mvp = m_viewProj * world;
+
+		transformVertices((const u8*)positions, sizeof(core::vector3df), numVertex, mvp);
+		setupTriangles(indices, numIndex);
+
+		m_stats.OccludersDrawn++;
+		m_stats.RasterizeTime += getTimeMs(begin);
+	}
+
+	void CSoftwareOcclusion::rasterize()
+	{
+		SOcclusionClock::time_point begin = SOcclusionClock::now();
+
+		int numTile = m_tileX * m_tileY;
+
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+		scheduler->parallelFor(0, numTile, 1,
+			[this](int from, int to)
+			{
+				for (int i = from; i < to; i++)
+					rasterizeTile(i);
+			});
+
+		m_stats.RasterizeTime += getTimeMs(begin);
+	}
+
+	void CSoftwareOcclusion::rasterizeTile(int tile)
+	{
+		int x0 = (tile % m_tileX) * TileWidth;
+		int y0 = (tile / m_tileX) * TileHeight;
+		int x1 = x0 + TileWidth - 1;
+		int y1 = y0 + TileHeight - 1;
+
+		f32* depth = m_depth.pointer();
+
+		// clear
+		for (int y = y0; y <= y1; y++)
+		{
+			f32* row = depth + y * m_width;
+			for (int x = x0; x <= x1; x++)
+				row[x] = FLT_MAX;
+		}
+
+		core::array<u32>& bin = m_bins[tile];
+		const STriangle* triangles = m_triangles.const_pointer();
+
+		for (u32 t = 0, n = bin.size(); t < n; t++)
+		{
+			const STriangle& tri = triangles[bin[t]];
+
+			int xs = core::max_(tri.MinX, x0);
+			int xe = core::min_(tri.MaxX, x1);
+			int ys = core::max_(tri.MinY, y0);
+			int ye = core::min_(tri.MaxY, y1);
+
+			// 4 pixels per step, x0 is aligned to 4
+			xs = x0 + ((xs - x0) & ~3);
+
+			for (int y = ys; y <= ye; y++)
+			{
+				f32 py = (f32)y + 0.5f;
+				f32* row = depth + y * m_width;
+
+#if defined(SKYLICHT_SIMD_SSE)
+				__m128 px = _mm_add_ps(_mm_set1_ps((f32)xs), _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f));
+				__m128 step = _mm_set1_ps(4.0f);
+				__m128 zero = _mm_setzero_ps();
+
+				__m128 a0 = _mm_set1_ps(tri.EdgeA[0]);
+				__m128 a1 = _mm_set1_ps(tri.EdgeA[1]);
+				__m128 a2 = _mm_set1_ps(tri.EdgeA[2]);
+				__m128 r0 = _mm_set1_ps(tri.EdgeB[0] * py + tri.EdgeC[0]);
+				__m128 r1 = _mm_set1_ps(tri.EdgeB[1] * py + tri.EdgeC[1]);
+				__m128 r2 = _mm_set1_ps(tri.EdgeB[2] * py + tri.EdgeC[2]);
+				__m128 za = _mm_set1_ps(tri.ZA);
+				__m128 zr = _mm_set1_ps(tri.ZB * py + tri.ZC);
+
+				for (int x = xs; x <= xe; x += 4)
+				{
+					__m128 e0 = _mm_add_ps(_mm_mul_ps(a0, px), r0);
+					__m128 e1 = _mm_add_ps(_mm_mul_ps(a1, px), r1);
+					__m128 e2 = _mm_add_ps(_mm_mul_ps(a2, px), r2);
+
+					__m128 mask = _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_and_ps(_mm_cmpge_ps(e1, zero), _mm_cmpge_ps(e2, zero)));
+					if (_mm_movemask_ps(mask))
+					{
+						__m128 z = _mm_add_ps(_mm_mul_ps(za, px), zr);
+						__m128 d = _mm_loadu_ps(row + x);
+						__m128 m = _mm_min_ps(d, z);
+						_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(mask, m), _mm_andnot_ps(mask, d)));
+					}
+
+					px = _mm_add_ps(px, step);
+				}
+#else
+				for (int x = xs; x <= xe; x++)
+				{
+					f32 px = (f32)x + 0.5f;
+					f32 e0 = tri.EdgeA[0] * px + tri.EdgeB[0] * py + tri.EdgeC[0];
+					f32 e1 = tri.EdgeA[1] * px + tri.EdgeB[1] * py + tri.EdgeC[1];
+					f32 e2 = tri.EdgeA[2] * px + tri.EdgeB[2] * py + tri.EdgeC[2];
+
+					if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f)
+					{
+						f32 z = tri.ZA * px + tri.ZB * py + tri.ZC;
+						if (z < row[x])
+							row[x] = z;
+					}
+				}
+#endif
+			}
+		}
+
+		// update max depth of the blocks in this tile
+		for (int by = y0 / BlockSize, bye = y1 / BlockSize; by <= bye; by++)
+		{
+			for (int bx = x0 / BlockSize, bxe = x1 / BlockSize; bx <= bxe; bx++)
+			{
+				f32 maxDepth = -FLT_MAX;
+
+				for (int y = by * BlockSize, ey = y + BlockSize; y < ey; y++)
+				{
+					const f32* row = depth + y * m_width;
+					for (int x = bx * BlockSize, ex = x + BlockSize; x < ex; x++)
+					{
+						if (row[x] > maxDepth)
+							maxDepth = row[x];
+					}
+				}
+
+				m_hiz[by * m_blockX + bx] = maxDepth;
+			}
+		}
+	}
+
+	bool CSoftwareOcclusion::testBox(const core::aabbox3df& box)
+	{
+		m_stats.ObjectsTested++;
+
+		core::vector3df edges[8];
+		box.getEdges(edges);
+
+		f32 minX = FLT_MAX, minY = FLT_MAX, minZ = FLT_MAX;
+		f32 maxX = -FLT_MAX, maxY = -FLT_MAX;
+
+		const f32* m = m_viewProj.pointer();
+
+		for (int i = 0; i < 8; i++)
+		{
+			const core::vector3df& p = edges[i];
+
+			f32 w = p.X * m[3] + p.Y * m[7] + p.Z * m[11] + m[15];
+			if (w < OCCLUSION_NEAR_W)
+			{
+				// the box intersects the near plane
+				return true;
+			}
+
+			f32 invW = 1.0f / w;
+			f32 x = ((p.X * m[0] + p.Y * m[4] + p.Z * m[8] + m[12]) * invW * 0.5f + 0.5f) * m_width;
+			f32 y = (0.5f - (p.X * m[1] + p.Y * m[5] + p.Z * m[9] + m[13]) * invW * 0.5f) * m_height;
+			f32 z = (p.X * m[2] + p.Y * m[6] + p.Z * m[10] + m[14]) * invW;
+
+			minX = core::min_(minX, x);
+			maxX = core::max_(maxX, x);
+			minY = core::min_(minY, y);
+			maxY = core::max_(maxY, y);
+			minZ = core::min_(minZ, z);
+		}
+
+		int x0 = core::max_((int)floorf(minX), 0);
+		int y0 = core::max_((int)floorf(minY), 0);
+		int x1 = core::min_((int)floorf(maxX), m_width - 1);
+		int y1 = core::min_((int)floorf(maxY), m_height - 1);
+
+		if (x0 > x1 || y0 > y1)
+		{
+			// out of screen, let frustum culling decide
+			return true;
+		}
+
+		const f32* depth = m_depth.const_pointer();
+
+		for (int by = y0 / BlockSize, bye = y1 / BlockSize; by <= bye; by++)
+		{
+			for (int bx = x0 / BlockSize, bxe = x1 / BlockSize; bx <= bxe; bx++)
+			{
+				// all the occluders in this block are nearer than the box
+				if (m_hiz[by * m_blockX + bx] < minZ)
+					continue;
+
+				int sx = core::max_(bx * BlockSize, x0);
+				int ex = core::min_(bx * BlockSize + BlockSize - 1, x1);
+				int sy = core::max_(by * BlockSize, y0);
+				int ey = core::min_(by * BlockSize + BlockSize - 1, y1);
+
+				for (int y = sy; y <= ey; y++)
+				{
+					const f32* row = depth + y * m_width;
+					for (int x = sx; x <= ex; x++)
+					{
+						if (row[x] >= minZ)
+						{
+							return true;
+						}
+					}
+				}
+			}
+		}
+
+		m_stats.ObjectsRejected++;
+		return false;
+	}
+}
@@ -0,0 +1,217 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "RenderMesh/CMesh.h"
+
+namespace Skylicht
+{
+	/**
+	 * @brief CPU occlusion culling with a low resolution software depth buffer.
+	 * @ingroup Culling
+	 *
+	 * The occluder meshes are transformed and binned to the screen tiles, then the tiles are rasterized on the job threads.
+	 * Each tile also builds the max depth of 8x8 pixel blocks (hierarchical depth) that is used to reject the bounding boxes quickly.
+	 * It does not use the video driver, so it works without GPU occlusion query (and with EDT_NULL).
+	 *
+	 * @code
+	 * CSoftwareOcclusion* occlusion = new CSoftwareOcclusion(256, 128);
+	 * occlusion->beginFrame(camera->getProjectionMatrix() * camera->getViewMatrix());
+	 * occlusion->addOccluder(wallMesh, wallTransform);
+	 * occlusion->rasterize();
+	 *
+	 * if (!occlusion->testBox(worldBox))
+	 * {
+	 *	// the box is hidden by the occluders
+	 * }
+	 * @endcode
+	 *
+	 * @see COccluderData, CCullingSystem::enableSoftwareOcclusion
+	 */
+	class SKYLICHT_API CSoftwareOcclusion
+	{
+	public:
+		struct SStats
+		{
+			int OccludersDrawn;
+			int TrianglesDrawn;
+			int ObjectsTested;
+			int ObjectsRejected;
+			float RasterizeTime;
+			float TestTime;
+		};
+
+		// screen space triangle: edge functions and depth plane
+		struct STriangle
+		{
+			f32 EdgeA[3];
+			f32 EdgeB[3];
+			f32 EdgeC[3];
+			f32 ZA;
+			f32 ZB;
+			f32 ZC;
+			s32 MinX;
+			s32 MinY;
+			s32 MaxX;
+			s32 MaxY;
+		};
+
+		struct SClipVertex
+		{
+			f32 X;
+			f32 Y;
+			f32 Z;
+			f32 W;
+		};
+
+		// clip space vertices of 4 triangles, [vertex][triangle]
+		struct SClipTriangle4
+		{
+			f32 X[3][4];
+			f32 Y[3][4];
+			f32 Z[3][4];
+			f32 W[3][4];
+		};
+
+		// screen space setup of 4 triangles, [edge][triangle]
+		struct STriangleSetup4
+		{
+			f32 EdgeA[3][4];
+			f32 EdgeB[3][4];
+			f32 EdgeC[3][4];
+			f32 ZA[4];
+			f32 ZB[4];
+			f32 ZC[4];
+			f32 MinX[4];
+			f32 MinY[4];
+			f32 MaxX[4];
+			f32 MaxY[4];
+
+			// bit mask of the triangles that are not clipped or degenerate
+			u32 Valid;
+		};
+
+		static const int TileWidth = 64;
+		static const int TileHeight = 32;
+		static const int BlockSize = 8;
+
+	protected:
+		int m_width;
+		int m_height;
+
+		int m_tileX;
+		int m_tileY;
+
+		int m_blockX;
+		int m_blockY;
+
+		core::array<f32> m_depth;
+
+		// max depth of each 8x8 block
+		core::array<f32> m_hiz;
+
+		core::matrix4 m_viewProj;
+
+		core::array<SClipVertex> m_clipVertices;
+
+		core::array<STriangle> m_triangles;
+
+		// triangle indices of each tile
+		std::vector<core::array<u32>> m_bins;
+
+		SStats m_stats;
+
+		float m_testTime;
+
+	public:
+		CSoftwareOcclusion(int width = 256, int height = 128);
+
+		virtual ~CSoftwareOcclusion();
+
+		/// @brief Change the depth buffer size, it is rounded to the tile size.
+		void setResolution(int width, int height);
+
+		inline int getWidth()
+		{
+			return m_width;
+		}
+
+		inline int getHeight()
+		{
+			return m_height;
+		}
+
+		/// @brief Clear the depth buffer and the stats
+		void beginFrame(const core::matrix4& viewProj);
+
+		/// @brief Transform the triangles of the mesh and bin them to the tiles
+		void addOccluder(CMesh* mesh, const core::matrix4& world);
+
+		/// @brief Add the triangles list (3 indices per triangle)
+		void addOccluder(const core::vector3df* positions, int numVertex, const u32* indices, int numIndex, const core::matrix4& world);
+
+		/// @brief Rasterize the binned occluders to the depth buffer
+		void rasterize();
+
+		/// @brief Test the world bounding box with the depth buffer
+		/// @return false if the box is hidden by the occluders
+		bool testBox(const core::aabbox3df& box);
+
+		/// @brief Depth (z/w) at the pixel, FLT_MAX if no occluder is drawn
+		inline f32 getDepth(int x, int y)
+		{
+			return m_depth[y * m_width + x];
+		}
+
+		/// @brief The caller measures the time of its testBox calls, it is reported in SStats::TestTime
+		inline void addTestTime(float ms)
+		{
+			m_testTime += ms;
+		}
+
+		inline const SStats& getStats()
+		{
+			m_stats.TestTime = m_testTime;
+			return m_stats;
+		}
+
+		/// @brief Setup the edge equations and depth planes of 4 triangles with SSE/NEON
+		static void setupTriangle4(const SClipTriangle4& in, f32 width, f32 height, STriangleSetup4& out);
+
+		/// @brief The scalar version of setupTriangle4
+		static void setupTriangle4Scalar(const SClipTriangle4& in, f32 width, f32 height, STriangleSetup4& out);
+
+	protected:
+
+		void transformVertices(const u8* vertices, u32 stride, int numVertex, const core::matrix4& mvp);
+
+		void binTriangles(const STriangleSetup4& setup, int count);
+
+		template<class T>
+		void setupTriangles(const T* indices, int numIndex);
+
+		void rasterizeTile(int tile);
+	};
+}
@@ -204,4 +204,11 @@ namespace Skylicht
 			}
 		}
 	}
+
+	bool CReflectionProbeSystem::getDataAccess(u64& read, u64& write)
+	{
+		read = DATA_TYPE_MASK(CWorldTransformData);
+		write = DATA_TYPE_MASK(CReflectionProbeData) | DATA_TYPE_MASK(CIndirectLightingData);
+		return true;
+	}
 }
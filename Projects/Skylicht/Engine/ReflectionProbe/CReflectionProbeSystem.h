@@ -62,5 +62,7 @@ namespace Skylicht
 		virtual void init(CEntityManager* entityManager);
 
 		virtual void update(CEntityManager* entityManager);
+
+		virtual bool getDataAccess(u64& read, u64& write);
 	};
 }
\ No newline at end of file
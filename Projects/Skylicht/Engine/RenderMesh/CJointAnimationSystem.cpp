@@ -26,6 +26,11 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CJointAnimationSystem.h"
 #include "Entity/CEntityManager.h"
 #include "Culling/CVisibleData.h"
+#include "Job/CJobScheduler.h"
+
+// the joints of many characters are split to the job threads
+#define PARALLEL_JOINT_COUNT 2048
+#define PARALLEL_JOINT_GRAIN 512
 
 namespace Skylicht
 {
@@ -71,6 +76,23 @@ namespace Skylicht
 	{
 		CEntity** allEntities = entityManager->getEntities();
 
+		if (numEntity >= PARALLEL_JOINT_COUNT)
+		{
+			System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+			scheduler->parallelFor(0, numEntity, PARALLEL_JOINT_GRAIN,
+				[allEntities, entities](int from, int to)
+				{
+					updateAnimationMatrix(allEntities, entities + from, to - from);
+				});
+		}
+		else
+		{
+			updateAnimationMatrix(allEntities, entities, numEntity);
+		}
+	}
+
+	void CJointAnimationSystem::updateAnimationMatrix(CEntity** allEntities, CEntity** entities, int numEntity)
+	{
 		for (int i = 0; i < numEntity; i++)
 		{
 			CEntity* entity = entities[i];
@@ -95,4 +117,11 @@ namespace Skylicht
 			}
 		}
 	}
+
+	bool CJointAnimationSystem::getDataAccess(u64& read, u64& write)
+	{
+		read = DATA_TYPE_MASK(CWorldTransformData) | DATA_TYPE_MASK(CWorldInverseTransformData);
+		write = DATA_TYPE_MASK(CJointData);
+		return true;
+	}
 }
\ No newline at end of file
@@ -50,6 +50,12 @@ namespace Skylicht
 
 		virtual void update(CEntityManager* entityManager);
 
+		virtual bool getDataAccess(u64& read, u64& write);
+
 		static void updateAnimationMatrix(CEntityManager* entityManager, CEntity** entities, int numEntity);
+
+	protected:
+
+		static void updateAnimationMatrix(CEntity** allEntities, CEntity** entities, int numEntity);
 	};
 }
\ No newline at end of file
@@ -55,11 +55,20 @@ namespace Skylicht
 
 		float Weight;
 
+		struct SVertex
+		{
+			u32 Vertex;
+			u32 Offset;
+		};
+
 		// see function CSoftwareSkinningUtils::softwareBlendShape, CFBXMeshLoader::loadModel
 		core::array<u32> VtxId;
 		core::array<core::vector3df> Offset;
 		core::array<core::vector3df> NormalOffset;
 
+		// the vertices that have the offset in each mesh buffer, see CSoftwareSkinningUtils::initBlendShapeVertices
+		std::vector<core::array<SVertex>> Vertices;
+
 		CBlendShape()
 		{
 			Weight = 1.0f;
@@ -33,10 +33,12 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Material/Shader/ShaderCallback/CShaderMaterial.h"
 
 #include "Lighting/CLightSystem.h"
+#include "Instancing/CInstancingMaterialData.h"
 
 namespace Skylicht
 {
-	CMeshRendererInstancing::CMeshRendererInstancing()
+	CMeshRendererInstancing::CMeshRendererInstancing() :
+		m_updateFrame(0)
 	{
 		m_pipelineType = IRenderPipeline::Mix;
 	}
@@ -55,13 +57,6 @@ namespace Skylicht
 	{
 		m_meshs.set_used(0);
 
-		for (auto it : m_groups)
-		{
-			SMeshInstancingGroup* group = it.second;
-			group->Materials.reset();
-			group->Entities.reset();
-		}
-
 		CMeshRenderSystem::beginQuery(entityManager);
 	}
 
@@ -119,7 +114,8 @@ namespace Skylicht
 		CLightSystem* lightSystem = entityManager->getRenderSystem<CLightSystem>();
 
 		CRenderMeshData** renderData = m_meshs.pointer();
-		CEntity** allEntities = entityManager->getEntities();
+
+		m_updateFrame++;
 
 		// update instancing
 		for (u32 i = 0; i < numEntity; i++)
@@ -147,7 +143,29 @@ namespace Skylicht
 				lightSystem->onSetupLightIndex(meshData, indirectData, transform);
 			}
 
-			group->Entities.push(entity);
+			// the instance keeps its slot while it is visible
+			int slot = meshData->getInstancingSlot();
+			if (slot >= 0 && slot < group->Slots.count() && group->Slots.pointer()[slot].RenderMesh == meshData)
+			{
+				SMeshInstanceSlot& s = group->Slots.pointer()[slot];
+				s.Frame = m_updateFrame;
+
+				// NeedValidate is the world changed flag of this frame (HasChanged is reset before render systems)
+				bool changed = s.Transform->NeedValidate;
+
+				if (s.IndirectLighting && s.IndirectLighting->ChangeRevision != s.LightingRevision)
+				{
+					s.LightingRevision = s.IndirectLighting->ChangeRevision;
+					changed = true;
+				}
+
+				if (changed)
+					group->DirtySlots.push(slot);
+			}
+			else
+			{
+				addInstance(group, meshData);
+			}
 		}
 
 		// bake instancing in group
@@ -156,68 +174,229 @@ namespace Skylicht
 			SMeshInstancing* data = it.first;
 			SMeshInstancingGroup* group = it.second;
 
-			u32 count = group->Entities.count();
-			if (count == 0)
+			removeCulledInstances(group);
+
+			if (group->Entities.count() > 0)
+			{
+				batchMaterials(data, group);
+				batchTransforms(data, group);
+			}
+
+			group->DirtySlots.reset();
+			group->SlotsMoved = false;
+		}
+	}
+
+	void CMeshRendererInstancing::addInstance(SMeshInstancingGroup* group, CRenderMeshData* meshData)
+	{
+		int slot = group->Slots.count();
+		CEntity* entity = meshData->Entity;
+
+		SMeshInstanceSlot& s = *group->Slots.getPush();
+		s.RenderMesh = meshData;
+		s.Transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+		s.IndirectLighting = GET_ENTITY_DATA(entity, CIndirectLightingData);
+		s.Material = GET_ENTITY_DATA(entity, CInstancingMaterialData);
+		s.Frame = m_updateFrame;
+		s.LightingRevision = s.IndirectLighting ? s.IndirectLighting->ChangeRevision : 0;
+
+		group->Entities.push(entity);
+
+		meshData->setInstancingSlot(slot);
+
+		group->DirtySlots.push(slot);
+		group->SlotsMoved = true;
+	}
+
+	void CMeshRendererInstancing::removeCulledInstances(SMeshInstancingGroup* group)
+	{
+		int count = group->Slots.count();
+
+		SMeshInstanceSlot* slots = group->Slots.pointer();
+		CEntity** entities = group->Entities.pointer();
+
+		int i = 0;
+		while (i < count)
+		{
+			if (slots[i].Frame == m_updateFrame)
+			{
+				i++;
 				continue;
+			}
 
-			CEntity** entities = group->Entities.pointer();
+			// the instance is culled or removed (do not access it)
+			// move the last instance to this slot
+			count--;
+			if (i < count)
+			{
+				slots[i] = slots[count];
+				entities[i] = entities[count];
+
+				// only the filled hole is rewritten, not the slots between the holes
+				slots[i].RenderMesh->setInstancingSlot(i);
+				group->DirtySlots.push(i);
+				group->SlotsMoved = true;
+			}
+		}
+
+		group->Slots.set_used(count);
+		group->Entities.set_used(count);
+	}
+
+	void CMeshRendererInstancing::batchMaterials(SMeshInstancing* data, SMeshInstancingGroup* group)
+	{
+		u32 count = (u32)group->Entities.count();
+		CEntity** entities = group->Entities.pointer();
+		SMeshInstanceSlot* slots = group->Slots.pointer();
 
-			for (u32 i = 0, n = data->RenderMeshBuffers.size(); i < n; i++)
+		u32 numBuffer = data->RenderMeshBuffers.size();
+
+		if (group->BatchedMaterialBuffer.size() != numBuffer)
+		{
+			group->BatchedMaterialBuffer.set_used(numBuffer);
+			group->BatchedMaterialID.set_used(numBuffer);
+			group->BatchedMaterialHash.set_used(numBuffer);
+
+			for (u32 i = 0; i < numBuffer; i++)
 			{
-				group->Materials.reset();
+				group->BatchedMaterialBuffer[i] = NULL;
+				group->BatchedMaterialID[i] = 0;
+				group->BatchedMaterialHash[i] = 0;
+			}
+		}
 
-				bool batchMaterial = true;
-				if (data->UseShareMaterialsBuffer)
-				{
-					// see function CRenderMeshInstancing::applyShareMaterialBuffer
-					if (*data->ShareDataMaterials == 0)
-						*data->ShareDataMaterials = 1;
-					else
-						batchMaterial = false;
-				}
+		// no instance is added or moved, and no material (or its params) is changed
+		bool materialChanged = group->SlotsMoved ||
+			group->BatchedParamsChangeID != CMaterial::getGlobalParamsChangeID() ||
+			group->BatchedMaterialDataID != CInstancingMaterialData::getChangeID();
 
-				if (batchMaterial)
-				{
-					for (u32 j = 0; j < count; j++)
-					{
-						CInstancingMaterialData* m = GET_ENTITY_DATA(entities[j], CInstancingMaterialData);
-						if (m && m->Enable)
-							group->Materials.push(m->Materials[i]);
-						else
-							group->Materials.push(data->Materials[i]);
-					}
-
-					// batching transform & material data to buffer
-					data->InstancingShader[i]->batchIntancing(
-						data->MaterialBuffer[i],
-						group->Materials.pointer(),
-						group->Entities.pointer(),
-						count
-					);
-				}
+		group->BatchedParamsChangeID = CMaterial::getGlobalParamsChangeID();
+		group->BatchedMaterialDataID = CInstancingMaterialData::getChangeID();
+
+		for (u32 i = 0; i < numBuffer; i++)
+		{
+			bool batchMaterial = true;
+			if (data->UseShareMaterialsBuffer)
+			{
+				// see function CRenderMeshInstancing::applyShareMaterialBuffer
+				if (*data->ShareDataMaterials == 0)
+					*data->ShareDataMaterials = 1;
+				else
+					batchMaterial = false;
 			}
 
-			bool batchTransform = true;
-			if (data->UseShareTransformBuffer)
+			if (!batchMaterial)
+				continue;
+
+			IVertexBuffer* buffer = data->MaterialBuffer[i];
+
+			if (!materialChanged &&
+				group->BatchedMaterialBuffer[i] == buffer &&
+				group->BatchedMaterialID[i] == buffer->getChangedID())
+			{
+				// nothing changed, just resize the culled instances
+				if (buffer->getVertexCount() != count)
+					buffer->set_used(count);
+				continue;
+			}
+
+			// a material is changed, but it may not be used in this group, so check the hash
+			group->Materials.reset();
+
+			u32 hash = count;
+			for (u32 j = 0; j < count; j++)
 			{
-				// see function CRenderMeshInstancing::applyShareTransformBuffer
-				// batch only 1 time in first group, it will reset 0 on onQuery
-				if (*data->ShareDataTransform == 0)
-					*data->ShareDataTransform = 1;
+				CInstancingMaterialData* m = slots[j].Material;
+
+				CMaterial* material;
+				if (m && m->Enable)
+					material = m->Materials[i];
 				else
-					batchTransform = false;
+					material = data->Materials[i];
+
+				group->Materials.push(material);
+
+				u32 id = material ? material->getParamsChangeID() : 0;
+				hash = hash * 31 + (u32)(size_t)material;
+				hash = hash * 31 + id;
 			}
 
-			if (batchTransform)
+			if (!group->SlotsMoved &&
+				group->BatchedMaterialBuffer[i] == buffer &&
+				group->BatchedMaterialID[i] == buffer->getChangedID() &&
+				group->BatchedMaterialHash[i] == hash)
 			{
-				IShaderInstancing::batchTransformAndLighting(
-					data->TransformBuffer,
-					data->IndirectLightingBuffer,
-					group->Entities.pointer(),
-					count
-				);
+				// nothing changed, just resize the culled instances
+				if (buffer->getVertexCount() != count)
+					buffer->set_used(count);
+				continue;
 			}
+
+			// batching material data to buffer
+			data->InstancingShader[i]->batchIntancing(
+				buffer,
+				group->Materials.pointer(),
+				entities,
+				count
+			);
+
+			group->BatchedMaterialBuffer[i] = buffer;
+			group->BatchedMaterialID[i] = buffer->getChangedID();
+			group->BatchedMaterialHash[i] = hash;
+		}
+	}
+
+	void CMeshRendererInstancing::batchTransforms(SMeshInstancing* data, SMeshInstancingGroup* group)
+	{
+		if (data->UseShareTransformBuffer)
+		{
+			// see function CRenderMeshInstancing::applyShareTransformBuffer
+			// batch only 1 time in first group, it will reset 0 on onQuery
+			if (*data->ShareDataTransform == 0)
+				*data->ShareDataTransform = 1;
+			else
+				return;
 		}
+
+		// cast the buffers only when they are changed (see CMeshManager::changeInstancingTransformBuffer)
+		if (group->TransformBuffer != data->TransformBuffer ||
+			group->IndirectLightingBuffer != data->IndirectLightingBuffer)
+		{
+			group->TransformBuffer = data->TransformBuffer;
+			group->IndirectLightingBuffer = data->IndirectLightingBuffer;
+			group->TransformVertices = dynamic_cast<CVertexBuffer<SVtxTransform>*>(data->TransformBuffer);
+			group->IndirectLightingVertices = dynamic_cast<CVertexBuffer<SVtxIndirectLighting>*>(data->IndirectLightingBuffer);
+		}
+
+		if (group->TransformVertices == NULL || group->IndirectLightingVertices == NULL)
+			return;
+
+		int count = group->Entities.count();
+
+		if (group->BatchedTransformBuffer != data->TransformBuffer ||
+			group->BatchedTransformID != data->TransformBuffer->getChangedID())
+		{
+			// the buffer is changed by another group, rewrite all instances
+			IShaderInstancing::batchTransformAndLighting(
+				group->TransformBuffer,
+				group->IndirectLightingBuffer,
+				group->Entities.pointer(),
+				count);
+		}
+		else
+		{
+			// only the added, moved and changed instances are rewritten and uploaded
+			IShaderInstancing::updateTransformAndLighting(
+				group->TransformVertices,
+				group->IndirectLightingVertices,
+				group->Entities.pointer(),
+				count,
+				group->DirtySlots.pointer(),
+				group->DirtySlots.count());
+		}
+
+		group->BatchedTransformBuffer = data->TransformBuffer;
+		group->BatchedTransformID = data->TransformBuffer->getChangedID();
 	}
 
 	void CMeshRendererInstancing::render(CEntityManager* entityManager)
@@ -50,6 +50,8 @@ namespace Skylicht
 
 		core::array<SInstancingGroup> m_transparents;
 
+		u32 m_updateFrame;
+
 	public:
 		CMeshRendererInstancing();
 
@@ -68,5 +70,15 @@ namespace Skylicht
 		virtual void renderTransparent(CEntityManager* entityManager);
 
 		void sortBeforeRender(core::array<SInstancingGroup>& instancing);
+
+	protected:
+
+		void addInstance(SMeshInstancingGroup* group, CRenderMeshData* meshData);
+
+		void removeCulledInstances(SMeshInstancingGroup* group);
+
+		void batchMaterials(SMeshInstancing* data, SMeshInstancingGroup* group);
+
+		void batchTransforms(SMeshInstancing* data, SMeshInstancingGroup* group);
 	};
 }
\ No newline at end of file
@@ -57,6 +57,7 @@ namespace Skylicht
 		IsInstancing(false),
 		IsSkinnedInstancing(false),
 		MeshInstancing(NULL),
+		InstancingSlot(-1),
 		Visible(true)
 	{
 
@@ -346,10 +347,12 @@ namespace Skylicht
 				stream->writeShort(attribute->getTypeSize());
 			}
 
-			// write vertex data
+			// write vertex data (aligned for the memory-mapped loader)
+			stream->writePadding(16);
 			stream->writeData(vb->getVertices(), vtxBufferSize);
 
 			// write indices data
+			stream->writePadding(16);
 			stream->writeData(ib->getIndices(), idxBufferSize);
 		}
 
@@ -472,9 +475,16 @@ namespace Skylicht
 				IVertexBuffer* vtxBuffer = mb->getVertexBuffer();
 				IIndexBuffer* idxBuffer = mb->getIndexBuffer();
 
+				// version 2: the blocks are aligned, copy once from the mapped file
+				if (version >= 2)
+					stream->readPadding(16);
+
 				vtxBuffer->set_used(vtxCount);
 				stream->readData(vtxBuffer->getVertices(), vtxBufferSize);
 
+				if (version >= 2)
+					stream->readPadding(16);
+
 				idxBuffer->set_used(idxCount);
 				stream->readData(idxBuffer->getIndices(), idxBufferSize);
 
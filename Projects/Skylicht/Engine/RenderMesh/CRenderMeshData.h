@@ -52,6 +52,9 @@ namespace Skylicht
 
 		SMeshInstancing* MeshInstancing;
 
+		// the persistent slot in SMeshInstancingGroup (see CMeshRendererInstancing)
+		int InstancingSlot;
+
 		bool Visible;
 
 	public:
@@ -80,6 +83,16 @@ namespace Skylicht
 			return MeshInstancing;
 		}
 
+		inline int getInstancingSlot()
+		{
+			return InstancingSlot;
+		}
+
+		inline void setInstancingSlot(int slot)
+		{
+			InstancingSlot = slot;
+		}
+
 		void setMesh(CMesh* mesh);
 
 		void setShareMesh(CMesh* mesh);
@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Culling/CVisibleData.h"
 #include "Entity/CEntityManager.h"
 #include "CSkinnedMeshSystem.h"
+#include "CJointData.h"
 
 namespace Skylicht
 {
@@ -105,4 +106,11 @@ namespace Skylicht
 			}
 		}
 	}
+
+	bool CSkinnedMeshSystem::getDataAccess(u64& read, u64& write)
+	{
+		read = DATA_TYPE_MASK(CJointData);
+		write = DATA_TYPE_MASK(CRenderMeshData);
+		return true;
+	}
 }
\ No newline at end of file
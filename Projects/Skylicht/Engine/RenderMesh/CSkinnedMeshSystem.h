@@ -45,6 +45,8 @@ namespace Skylicht
 
 		virtual void update(CEntityManager* entityManager);
 
+		virtual bool getDataAccess(u64& read, u64& write);
+
 		static void updateSkinnedMesh(CEntityManager* entityManager, CEntity** entities, int numEntity);
 	};
 }
\ No newline at end of file
@@ -76,4 +76,11 @@ namespace Skylicht
 			}
 		}
 	}
+
+	bool CSoftwareBlendShapeSystem::getDataAccess(u64& read, u64& write)
+	{
+		read = DATA_TYPE_MASK(CCullingData);
+		write = DATA_TYPE_MASK(CRenderMeshData);
+		return true;
+	}
 }
\ No newline at end of file
@@ -79,4 +79,11 @@ namespace Skylicht
 				CSoftwareSkinningUtils::softwareSkinning(skinnedMesh, renderMesh, blendShapeMesh);
 		}
 	}
+
+	bool CSoftwareSkinningSystem::getDataAccess(u64& read, u64& write)
+	{
+		read = DATA_TYPE_MASK(CCullingData);
+		write = DATA_TYPE_MASK(CRenderMeshData);
+		return true;
+	}
 }
\ No newline at end of file
@@ -37,6 +37,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Lighting/CDirectionalLight.h"
 #include "Lighting/CAreaLight.h"
 #include "Shadow/CShadowRTTManager.h"
+#include "Culling/CCullingSystem.h"
 
 namespace Skylicht
 {
@@ -50,6 +51,11 @@ namespace Skylicht
 		m_shadowMapSize(2048),
 		m_numCascade(3),
 		m_currentCSM(0),
+		m_casterCulling(NULL),
+		m_casterPass(CShadowMapRP::AllCasters),
+		m_untrackedCaster(false),
+		m_cacheStaticShadow(false),
+		m_depthCopyShader(-1),
 		m_saveDebug(false),
 		m_saveDebugPL(false),
 		m_screenWidth(0),
@@ -77,6 +83,22 @@ namespace Skylicht
 		m_writeDepthMaterial.BackfaceCulling = false;
 		m_writeDepthMaterial.FrontfaceCulling = false;
 
+		// copy the static depth, it writes the depth buffer for the dynamic casters
+		CShader* depthCopy = shaderMgr->getShaderByName("ShadowDepthCopy");
+		if (depthCopy)
+			m_depthCopyShader = depthCopy->getMaterialRenderID();
+
+		m_depthCopyMaterial.MaterialType = m_depthCopyShader;
+		m_depthCopyMaterial.ZBuffer = video::ECFN_ALWAYS;
+		m_depthCopyMaterial.ZWriteEnable = true;
+		m_depthCopyMaterial.BackfaceCulling = false;
+		disableTextureBilinear(m_depthCopyMaterial, 0);
+
+		for (int i = 0; i < MAX_SHADOW_CASCADE; i++)
+			m_staticDepth[i] = NULL;
+
+		invalidateShadowCache();
+
 		// CEventManager::getInstance()->registerProcessorEvent("ShadowRP", this);
 	}
 
@@ -104,10 +126,167 @@ namespace Skylicht
 		if (m_lsm)
 			delete m_lsm;
 
+		if (m_casterCulling)
+			delete m_casterCulling;
+
+		for (int i = 0; i < MAX_SHADOW_CASCADE; i++)
+		{
+			if (m_staticDepth[i] != NULL)
+				getVideoDriver()->removeTexture(m_staticDepth[i]);
+			m_staticDepth[i] = NULL;
+		}
+
 		m_depthTexture = NULL;
 		m_csm = NULL;
 		m_sm = NULL;
 		m_lsm = NULL;
+		m_casterCulling = NULL;
+
+		invalidateShadowCache();
+	}
+
+	void CShadowMapRP::setCacheStaticShadow(bool b)
+	{
+		m_cacheStaticShadow = b;
+
+		if (m_csm)
+			m_csm->setWorldAnchor(b);
+
+		invalidateShadowCache();
+	}
+
+	void CShadowMapRP::invalidateShadowCache()
+	{
+		for (int i = 0; i < MAX_SHADOW_CASCADE; i++)
+		{
+			m_staticValid[i] = false;
+			m_staticHash[i] = 0;
+			m_cascadeUntracked[i] = false;
+			m_depthIsStatic[i] = false;
+		}
+	}
+
+	bool CShadowMapRP::useStaticDepth(bool castShadow)
+	{
+		return m_cacheStaticShadow &&
+			castShadow &&
+			m_casterCulling != NULL &&
+			m_depthCopyShader >= 0 &&
+			!m_saveDebug &&
+			!CCullingSystem::useCacheCulling();
+	}
+
+	void CShadowMapRP::renderStaticCascade(int cascade, CEntityManager* entityManager)
+	{
+		IVideoDriver* driver = getVideoDriver();
+
+		const core::matrix4& proj = m_csm->getProjectionMatrices(cascade);
+		const core::matrix4& view = m_csm->getViewMatrices(cascade);
+		core::matrix4 viewProj = proj * view;
+
+		u32 hash = m_casterCulling->getCascadeHash(cascade);
+
+		// render the static casters again if they or the cascade (light direction) change
+		if (!m_staticValid[cascade] ||
+			m_staticHash[cascade] != hash ||
+			m_cascadeViewProj[cascade] != viewProj)
+		{
+			if (m_staticDepth[cascade] == NULL)
+			{
+				core::dimension2du size = core::dimension2du((u32)m_shadowMapSize, (u32)m_shadowMapSize);
+				m_staticDepth[cascade] = driver->addRenderTargetTexture(size, "shadow_static_depth", ECF_R32F);
+			}
+
+			// note: clear while 0xFFFFFFFF for max depth value
+			driver->setRenderTarget(m_staticDepth[cascade], true, true, SColor(255, 255, 255, 255));
+			driver->setTransform(video::ETS_PROJECTION, proj);
+			driver->setTransform(video::ETS_VIEW, view);
+
+			m_casterPass = CShadowMapRP::StaticCasters;
+			m_untrackedCaster = false;
+
+			entityManager->render();
+
+			m_cascadeUntracked[cascade] = m_untrackedCaster;
+			m_staticValid[cascade] = true;
+			m_staticHash[cascade] = hash;
+			m_cascadeViewProj[cascade] = viewProj;
+			m_depthIsStatic[cascade] = false;
+		}
+
+		bool dynamic = m_casterCulling->isCascadeDynamic(cascade) || m_cascadeUntracked[cascade];
+
+		// keep the depth of last frame
+		if (!dynamic && m_depthIsStatic[cascade])
+		{
+			m_casterPass = CShadowMapRP::AllCasters;
+			return;
+		}
+
+		driver->setRenderTargetArray(m_depthTexture, cascade, true, true, SColor(255, 255, 255, 255));
+		copyStaticDepth(cascade);
+
+		if (dynamic)
+		{
+			driver->setTransform(video::ETS_PROJECTION, proj);
+			driver->setTransform(video::ETS_VIEW, view);
+
+			m_casterPass = CShadowMapRP::DynamicCasters;
+			entityManager->render();
+		}
+
+		m_casterPass = CShadowMapRP::AllCasters;
+		m_depthIsStatic[cascade] = !dynamic;
+	}
+
+	void CShadowMapRP::copyStaticDepth(int cascade)
+	{
+		float size = (float)m_shadowMapSize;
+		beginRender2D(size, size);
+
+		// see renderBufferToTarget, but the copy writes the depth buffer
+		m_verticesImage->set_used(4);
+		S3DVertex2TCoords* vertices = (S3DVertex2TCoords*)m_verticesImage->getVertices();
+		SColor color(255, 255, 255, 255);
+
+		float ty1 = 0.0f;
+		float ty2 = 1.0f;
+		if (getVideoDriver()->getDriverType() != EDT_DIRECT3D11)
+		{
+			ty1 = 1.0f;
+			ty2 = 0.0f;
+		}
+
+		vertices[0] = S3DVertex2TCoords(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, color, 0.0f, ty1, 0.0f, ty1);
+		vertices[1] = S3DVertex2TCoords(size, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, color, 1.0f, ty1, 1.0f, ty1);
+		vertices[2] = S3DVertex2TCoords(size, size, 0.0f, 0.0f, 0.0f, 1.0f, color, 1.0f, ty2, 1.0f, ty2);
+		vertices[3] = S3DVertex2TCoords(0.0f, size, 0.0f, 0.0f, 0.0f, 1.0f, color, 0.0f, ty2, 0.0f, ty2);
+
+		m_drawBuffer->setDirty(scene::EBT_VERTEX);
+
+		m_depthCopyMaterial.setTexture(0, m_staticDepth[cascade]);
+
+		IVideoDriver* driver = getVideoDriver();
+		driver->setMaterial(m_depthCopyMaterial);
+		driver->drawMeshBuffer(m_drawBuffer);
+	}
+
+	bool CShadowMapRP::isDrawInPass(CCullingData* culling)
+	{
+		if (m_casterPass == CShadowMapRP::AllCasters)
+			return true;
+
+		// the untracked casters are drawn with the dynamic casters
+		bool dynamic = culling == NULL || culling->ShadowDynamic;
+
+		if (m_casterPass == CShadowMapRP::StaticCasters)
+		{
+			if (culling == NULL)
+				m_untrackedCaster = true;
+			return !dynamic;
+		}
+
+		return dynamic;
 	}
 
 	void CShadowMapRP::setShadowMapping(EShadowMapType type)
@@ -169,9 +348,12 @@ namespace Skylicht
 		{
 			m_csm = new CCascadedShadowMaps();
 			m_csm->init(m_numCascade, m_shadowMapSize, m_shadowFar, w, h);
+			m_csm->setWorldAnchor(m_cacheStaticShadow);
 
 			core::dimension2du size = core::dimension2du((u32)m_shadowMapSize, (u32)m_shadowMapSize);
 			m_depthTexture = getVideoDriver()->addRenderTargetTextureArray(size, m_numCascade, "shadow_depth", ECF_R32F);
+
+			m_casterCulling = new CShadowCasterCulling();
 		}
 		else
 		{
@@ -191,6 +373,8 @@ namespace Skylicht
 		m_screenWidth = w;
 		m_screenHeight = h;
 
+		invalidateShadowCache();
+
 		if (m_shadowMapType == CShadowMapRP::CascadedShadow)
 		{
 			if (m_csm != NULL)
@@ -199,6 +383,7 @@ namespace Skylicht
 
 				m_csm = new CCascadedShadowMaps();
 				m_csm->init(m_numCascade, m_shadowMapSize, m_shadowFar, w, h);
+				m_csm->setWorldAnchor(m_cacheStaticShadow);
 			}
 		}
 		else
@@ -226,6 +411,20 @@ namespace Skylicht
 
 	void CShadowMapRP::drawMeshBuffer(CMesh* mesh, int bufferID, CEntityManager* entity, int entityID, bool skinnedMesh)
 	{
+		// skip the caster that is outside of current cascade
+		if (m_casterCulling != NULL &&
+			m_renderShadowState == DirectionLight &&
+			!CCullingSystem::useCacheCulling())
+		{
+			CCullingData* culling = GET_ENTITY_DATA(entity->getEntity(entityID), CCullingData);
+			if (culling != NULL && (culling->ShadowCascadeMask & (1 << m_currentCSM)) == 0)
+				return;
+
+			// the static or dynamic casters of the cached cascade
+			if (!isDrawInPass(culling))
+				return;
+		}
+
 		CShader* shader = NULL;
 
 		if (mesh->Materials.size() > (u32)bufferID)
@@ -344,6 +543,10 @@ namespace Skylicht
 		if (instancingShader && !instancingShader->isDrawDepthShadow())
 			return;
 
+		// the instancing is not tracked per instance, it is drawn with the dynamic casters
+		if (!isDrawInPass(NULL))
+			return;
+
 		IMeshBuffer* mb = mesh->getMeshBuffer(bufferID);
 		IVideoDriver* driver = getVideoDriver();
 
@@ -434,7 +637,13 @@ namespace Skylicht
 	const core::aabbox3df& CShadowMapRP::getFrustumBox()
 	{
 		if (m_shadowMapType == CShadowMapRP::CascadedShadow)
+		{
+			// the casters of all cascades are culled at once
+			if (m_casterCulling != NULL)
+				return m_cascadeBox;
+
 			return m_csm->getFrustumBox(m_currentCSM);
+		}
 
 		return m_sm->getFrustumBox();
 	}
@@ -478,7 +687,20 @@ namespace Skylicht
 				castShadow = false;
 
 			if (m_shadowMapType == CShadowMapRP::CascadedShadow)
+			{
 				m_csm->update(camera, m_lightDirection);
+
+				core::matrix4 viewProj[MAX_SHADOW_CASCADE];
+				m_cascadeBox = m_csm->getFrustumBox(0);
+
+				for (int i = 0; i < m_numCascade; i++)
+				{
+					viewProj[i] = m_csm->getProjectionMatrices(i) * m_csm->getViewMatrices(i);
+					m_cascadeBox.addInternalBox(m_csm->getFrustumBox(i));
+				}
+
+				m_casterCulling->setCascades(m_numCascade, viewProj);
+			}
 			else
 				m_sm->update(camera, m_lightDirection);
 		}
@@ -495,25 +717,33 @@ namespace Skylicht
 
 		if (m_shadowMapType == CShadowMapRP::CascadedShadow)
 		{
+			bool renderCaster = castShadow && light;
+
 			for (int i = m_numCascade - 1; i >= 0; i--)
 			{
+				m_currentCSM = i;
+
+				// the casters of all cascades are culled on the first cascade
+				if (renderCaster && i == m_numCascade - 1)
+				{
+					entityManager->updateRenderer();
+					rendererUpdated = true;
+				}
+
+				// draw the dynamic casters on the static depth
+				if (useStaticDepth(renderCaster))
+				{
+					renderStaticCascade(i, entityManager);
+					continue;
+				}
+
 				// note: clear while 0xFFFFFFFF for max depth value
 				driver->setRenderTargetArray(m_depthTexture, i, true, true, SColor(255, 255, 255, 255));
 				driver->setTransform(video::ETS_PROJECTION, m_csm->getProjectionMatrices(i));
 				driver->setTransform(video::ETS_VIEW, m_csm->getViewMatrices(i));
 
-				m_currentCSM = i;
-
-				if (castShadow && light)
-				{
-					if (i == m_numCascade - 1)
-					{
-						entityManager->cullingAndRender();
-						rendererUpdated = true;
-					}
-					else
-						entityManager->render();
-				}
+				if (renderCaster)
+					entityManager->render();
 			}
 		}
 		else
@@ -28,10 +28,13 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Shadow/CCascadedShadowMaps.h"
 #include "Shadow/CShadowMaps.h"
 #include "Shadow/CBoundShadowMaps.h"
+#include "Shadow/CShadowCasterCulling.h"
 #include "EventManager/CEventManager.h"
 
 namespace Skylicht
 {
+	class CCullingData;
+
 	/**
 	 * @brief Shadow mapping pipeline for generating depth maps.
 	 * @ingroup RP
@@ -51,6 +54,11 @@ namespace Skylicht
 	 * <shaderConfig name="SkinToonVATInstancing2" baseShader="SOLID" shadowDepth="SDWSkinVATInstancing2">
 	 * @endcode
 	 * 
+	 * With cascaded shadow, the casters are classified against all cascades once per frame (see CShadowCasterCulling),
+	 * so each cascade only draws the casters that touch it.
+	 * When the scene is mostly static, setCacheStaticShadow keeps a static depth layer of each cascade, it is rendered again only when the static casters or the light change.
+	 * The cascades are anchored in world space, and the dynamic casters are drawn on a copy of the static layer each frame.
+	 * 
 	 * @see CDeferredRP, CForwardRP
 	 */
 	class SKYLICHT_API CShadowMapRP :
@@ -93,6 +101,36 @@ namespace Skylicht
 		CCascadedShadowMaps* m_csm;
 		int m_currentCSM;
 
+		CShadowCasterCulling* m_casterCulling;
+		core::aabbox3df m_cascadeBox;
+
+		enum ECasterPass
+		{
+			AllCasters = 0,
+			StaticCasters,
+			DynamicCasters
+		};
+
+		ECasterPass m_casterPass;
+		bool m_untrackedCaster;
+
+		bool m_cacheStaticShadow;
+
+		// the depth of static casters, keyed on the static caster hash and the cascade matrix (light direction)
+		ITexture* m_staticDepth[MAX_SHADOW_CASCADE];
+		bool m_staticValid[MAX_SHADOW_CASCADE];
+		u32 m_staticHash[MAX_SHADOW_CASCADE];
+		core::matrix4 m_cascadeViewProj[MAX_SHADOW_CASCADE];
+
+		// the static pass skipped the casters that are not tracked (instancing or no CCullingData), they are drawn with the dynamic casters
+		bool m_cascadeUntracked[MAX_SHADOW_CASCADE];
+
+		// the cascade depth is a copy of the static depth, without dynamic casters
+		bool m_depthIsStatic[MAX_SHADOW_CASCADE];
+
+		int m_depthCopyShader;
+		SMaterial m_depthCopyMaterial;
+
 		int m_texColorShader;
 		int m_skinShader;
 
@@ -154,7 +192,36 @@ namespace Skylicht
 			return m_renderShadowState;
 		}
 
+		//! The per cascade caster culling, NULL if the shadow is not cascaded
+		inline CShadowCasterCulling* getCasterCulling()
+		{
+			return m_casterCulling;
+		}
+
+		/**
+		 * @brief Keep the depth of static casters of each cascade, and only draw the dynamic casters on it each frame.
+		 * The static depth is rendered again when a static caster enters, leaves or moves, or the cascade matrix (light direction) changes.
+		 * The cascades are anchored in world space (see CCascadedShadowMaps::setWorldAnchor), so the camera can move without invalidating it.
+		 * @note Only the entities that have CCullingData are tracked, the other casters and the instancing are drawn every frame with the dynamic casters.
+		 */
+		void setCacheStaticShadow(bool b);
+
+		inline bool isCacheStaticShadow()
+		{
+			return m_cacheStaticShadow;
+		}
+
+		void invalidateShadowCache();
+
 	protected:
+		bool useStaticDepth(bool castShadow);
+
+		void renderStaticCascade(int cascade, CEntityManager* entityManager);
+
+		void copyStaticDepth(int cascade);
+
+		bool isDrawInPass(CCullingData* culling);
+
 		CCascadedShadowMaps* getCSM()
 		{
 			return m_csm;
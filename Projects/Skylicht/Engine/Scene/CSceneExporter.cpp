@@ -25,6 +25,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "pch.h"
 #include "CSceneExporter.h"
 #include "Utils/CPath.h"
+#include "Serializable/CSerializableBinary.h"
 
 namespace Skylicht
 {
@@ -75,15 +76,21 @@ namespace Skylicht
 		delete data;
 	}
 
-	void CSceneExporter::exportScene(CScene* scene, const char* path)
+	bool CSceneExporter::exportGameObjectBinary(CGameObject* object, const char* path)
+	{
+		CObjectSerializable* data = exportGameObject(object);
+		bool result = CSerializableBinary::save(data, path);
+		delete data;
+		return result;
+	}
+
+	CObjectSerializable* CSceneExporter::createSceneSerializable(CScene* scene, std::stack<CObjectSerializable*>& zones)
 	{
 		CObjectSerializable* data = scene->createSerializable();
 
 		ArrayZone* zone = scene->getAllZone();
 		ArrayZoneIter i = zone->begin(), end = zone->end();
 
-		std::stack<CObjectSerializable*> stack;
-
 		while (i != end)
 		{
 			CZone* zone = (*i);
@@ -101,9 +108,27 @@ namespace Skylicht
 			data->autoRelease(zoneData);
 			++i;
 
-			stack.push(zoneData);
+			zones.push(zoneData);
 		}
 
+		return data;
+	}
+
+	bool CSceneExporter::exportSceneBinary(CScene* scene, const char* path)
+	{
+		std::stack<CObjectSerializable*> zones;
+		CObjectSerializable* data = createSceneSerializable(scene, zones);
+
+		bool result = CSerializableBinary::save(data, path);
+		delete data;
+		return result;
+	}
+
+	void CSceneExporter::exportScene(CScene* scene, const char* path)
+	{
+		std::stack<CObjectSerializable*> stack;
+		CObjectSerializable* data = createSceneSerializable(scene, stack);
+
 		data->save(path);
 
 		// list all components, that used
@@ -35,11 +35,19 @@ namespace Skylicht
 	protected:
 		static void loadChildObjectSerializable(CContainerObject* container, CObjectSerializable* data);
 
+		static CObjectSerializable* createSceneSerializable(CScene* scene, std::stack<CObjectSerializable*>& zones);
+
 	public:
 		static CObjectSerializable* exportGameObject(CGameObject* object);
 
 		static void exportGameObject(CGameObject* object, const char* path);
 
 		static void exportScene(CScene* scene, const char* path);
+
+		/// @brief Export the object to the binary template file (see CSerializableBinary).
+		static bool exportGameObjectBinary(CGameObject* object, const char* path);
+
+		/// @brief Export the scene to the binary scene file, CSceneImporter detects the format by the file header.
+		static bool exportSceneBinary(CScene* scene, const char* path);
 	};
 }
\ No newline at end of file
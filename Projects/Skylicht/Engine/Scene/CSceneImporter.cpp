@@ -27,6 +27,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CSceneExporter.h"
 #include "Utils/CStringImp.h"
 #include "Components/CDependentComponent.h"
+#include "Job/CJobScheduler.h"
 
 namespace Skylicht
 {
@@ -43,6 +44,15 @@ namespace Skylicht
 
 	CObjectSerializable* g_template = NULL;
 
+	// binary scene, the object data is decoded on the job threads
+	const u32 BinaryDecodeBatch = 64;
+
+	CSerializableBinary* g_binaryScene = NULL;
+	u32 g_binarySceneNode = CSerializableBinary::Invalid;
+	std::vector<u32> g_binaryObjectNode;
+	std::vector<CObjectSerializable*> g_binaryObjectData;
+	std::vector<System::CJobHandle> g_binaryJobs;
+
 	void CSceneImporter::buildComponent(CGameObject* object, io::IXMLReader* reader)
 	{
 		std::wstring nodeName = L"node";
@@ -185,6 +195,20 @@ namespace Skylicht
 
 	bool CSceneImporter::beginImportScene(CScene* scene, const char* file)
 	{
+		releaseBinary();
+
+		if (CSerializableBinary::isBinaryFile(file))
+		{
+			if (!beginLoadBinary(scene, NULL, file))
+				return false;
+
+			g_sceneReaderPath = file;
+			g_scene = scene;
+			g_loadingScene = 0;
+			g_generateId = false;
+			return true;
+		}
+
 		// step 1
 		// build scene object
 		g_sceneReader = getIrrlichtDevice()->getFileSystem()->createXMLReader(file);
@@ -268,6 +292,209 @@ namespace Skylicht
 		return g_currentGameObject == g_listGameObject.end();
 	}
 
+	void CSceneImporter::buildComponentBinary(CGameObject* object, CSerializableBinary* data, u32 node)
+	{
+		for (u32 child = data->getFirstChild(node); child != CSerializableBinary::Invalid; child = data->getNextSibling(child))
+		{
+			const char* componentName = data->getType(child);
+
+			CComponentSystem* comSystem = object->getComponentByTypeName(componentName);
+			if (comSystem == NULL)
+			{
+				// try add component
+				if (object->addComponentByTypeName(componentName) == NULL)
+				{
+					char log[512];
+					sprintf(log, "[CSceneImporter] Found unsupport component '%s'", componentName);
+					os::Printer::log(log);
+
+					// unsupport component
+					CNullComponent* nullComponent = object->addComponent<CNullComponent>();
+					nullComponent->setName(componentName);
+				}
+			}
+		}
+	}
+
+	void CSceneImporter::buildNodeBinary(CScene* scene, CContainerObject* container, CSerializableBinary* data, u32 node)
+	{
+		const char* type = data->getType(node);
+
+		CGameObject* object = NULL;
+		CContainerObject* childContainer = container;
+
+		if (strcmp(type, "CZone") == 0)
+		{
+			CZone* zone = scene->createZone();
+			childContainer = zone;
+			object = zone;
+		}
+		else if (strcmp(type, "CContainerObject") == 0 && container != NULL)
+		{
+			CContainerObject* containerObject = container->createContainerObject();
+			childContainer = containerObject;
+			object = containerObject;
+		}
+		else if (strcmp(type, "CGameObject") == 0 && container != NULL)
+		{
+			object = container->createEmptyObject();
+		}
+
+		if (object)
+		{
+			g_listGameObject.push_back(object);
+			g_binaryObjectNode.push_back(node);
+		}
+
+		for (u32 child = data->getFirstChild(node); child != CSerializableBinary::Invalid; child = data->getNextSibling(child))
+		{
+			if (object != NULL && strcmp(data->getType(child), "Components") == 0)
+				buildComponentBinary(object, data, child);
+			else
+				buildNodeBinary(scene, childContainer, data, child);
+		}
+	}
+
+	void CSceneImporter::buildSceneBinary(CScene* scene, CContainerObject* target, CSerializableBinary* data)
+	{
+		g_listGameObject.clear();
+		g_binaryObjectNode.clear();
+
+		buildNodeBinary(scene, target, data, 0);
+
+		g_currentGameObject = g_listGameObject.begin();
+	}
+
+	bool CSceneImporter::beginLoadBinary(CScene* scene, CContainerObject* target, const char* path)
+	{
+		CSerializableBinary* data = new CSerializableBinary();
+		if (!data->load(path))
+		{
+			delete data;
+			return false;
+		}
+
+		// create the objects and components on main thread
+		buildSceneBinary(scene, target, data);
+
+		g_binaryScene = data;
+		g_binarySceneNode = strcmp(data->getType(0), "CScene") == 0 ? 0 : CSerializableBinary::Invalid;
+
+		// decode the object data on the job threads
+		u32 numObjects = (u32)g_binaryObjectNode.size();
+		g_binaryObjectData.resize(numObjects, NULL);
+
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+
+		for (u32 begin = 0; begin < numObjects; begin += BinaryDecodeBatch)
+		{
+			u32 end = core::min_(begin + BinaryDecodeBatch, numObjects);
+
+			g_binaryJobs.push_back(scheduler->run([data, begin, end]()
+				{
+					for (u32 i = begin; i < end; i++)
+					{
+						u32 node = g_binaryObjectNode[i];
+
+						// load to end of node Components
+						CObjectSerializable* objectData = new CObjectSerializable(data->getType(node));
+						data->loadObject(node, objectData, "Components");
+						g_binaryObjectData[i] = objectData;
+					}
+				}));
+		}
+
+		return true;
+	}
+
+	bool CSceneImporter::loadStepBinary(CScene* scene)
+	{
+		if (g_binarySceneNode != CSerializableBinary::Invalid)
+		{
+			// only load the scene properties, the zones are loaded by steps
+			CObjectSerializable* data = scene->createSerializable();
+
+			io::IAttributes* attr = getIrrlichtDevice()->getFileSystem()->createEmptyAttributes();
+			g_binaryScene->readAttributes(g_binarySceneNode, attr);
+			data->deserialize(attr);
+			attr->drop();
+
+			for (u32 child = g_binaryScene->getFirstChild(g_binarySceneNode); child != CSerializableBinary::Invalid; child = g_binaryScene->getNextSibling(child))
+			{
+				CObjectSerializable* property = data->getProperty<CObjectSerializable>(g_binaryScene->getType(child));
+				if (property)
+					g_binaryScene->loadObject(child, property);
+			}
+
+			scene->loadSerializable(data);
+			delete data;
+
+			g_binarySceneNode = CSerializableBinary::Invalid;
+		}
+
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+
+		int step = 0;
+
+		while (step < g_loadSceneStep && g_currentGameObject != g_listGameObject.end())
+		{
+			u32 i = (u32)g_loadingScene;
+
+			// wait the decode job of this object
+			scheduler->wait(g_binaryJobs[i / BinaryDecodeBatch]);
+
+			CGameObject* gameobject = *g_currentGameObject;
+
+			// get id generated
+			std::string id = gameobject->getID();
+
+			++g_currentGameObject;
+			++g_loadingScene;
+			++step;
+
+			CObjectSerializable* data = g_binaryObjectData[i];
+			gameobject->loadSerializable(data);
+			gameobject->startComponent();
+			delete data;
+			g_binaryObjectData[i] = NULL;
+
+			// use new id, that generated
+			if (g_generateId)
+				gameobject->setID(id.c_str());
+		}
+
+		return g_currentGameObject == g_listGameObject.end();
+	}
+
+	void CSceneImporter::releaseBinary()
+	{
+		if (g_binaryScene == NULL)
+			return;
+
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+		if (g_binaryJobs.size() > 0)
+			scheduler->wait(g_binaryJobs.data(), (int)g_binaryJobs.size());
+
+		for (CObjectSerializable* data : g_binaryObjectData)
+		{
+			if (data)
+				delete data;
+		}
+
+		g_binaryObjectData.clear();
+		g_binaryObjectNode.clear();
+		g_binaryJobs.clear();
+
+		delete g_binaryScene;
+		g_binaryScene = NULL;
+		g_binarySceneNode = CSerializableBinary::Invalid;
+	}
+
+	void CSceneImporter::setLoadSceneStep(int step)
+	{
+		g_loadSceneStep = core::max_(step, 1);
+	}
+
 	float CSceneImporter::getLoadingPercent()
 	{
 		int size = (int)g_listGameObject.size();
@@ -283,7 +510,19 @@ namespace Skylicht
 	{
 		// step 2
 		// load object attribute
-		if (CSceneImporter::loadStep(g_scene, g_sceneReader))
+		bool finish = false;
+		if (g_binaryScene)
+		{
+			finish = CSceneImporter::loadStepBinary(g_scene);
+			if (finish)
+				releaseBinary();
+		}
+		else
+		{
+			finish = CSceneImporter::loadStep(g_scene, g_sceneReader);
+		}
+
+		if (finish)
 		{
 			// drop
 			if (g_sceneReader)
@@ -307,10 +546,15 @@ namespace Skylicht
 			return NULL;
 
 		if (g_listGameObject.size() == 0)
+		{
+			releaseBinary();
 			return NULL;
+		}
 
 		// re-open the scene file
-		g_sceneReader = getIrrlichtDevice()->getFileSystem()->createXMLReader(path);
+		if (g_binaryScene == NULL)
+			g_sceneReader = getIrrlichtDevice()->getFileSystem()->createXMLReader(path);
+
 		g_sceneReaderPath = path;
 		g_scene = target->getScene();
 		g_loadingScene = 0;
@@ -324,6 +568,20 @@ namespace Skylicht
 
 	bool CSceneImporter::beginImportTemplate(CContainerObject* target, const char* path)
 	{
+		releaseBinary();
+
+		if (CSerializableBinary::isBinaryFile(path))
+		{
+			if (!beginLoadBinary(target->getScene(), target, path))
+				return false;
+
+			g_sceneReaderPath = path;
+			g_scene = target->getScene();
+			g_loadingScene = 0;
+			g_generateId = true;
+			return true;
+		}
+
 		io::IXMLReader* xmlReader = getIrrlichtDevice()->getFileSystem()->createXMLReader(path);
 		if (xmlReader == NULL)
 			return false;
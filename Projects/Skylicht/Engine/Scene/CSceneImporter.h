@@ -28,6 +28,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CScene.h"
 #include "Serializable/CObjectSerializable.h"
 #include "Serializable/CSerializableLoader.h"
+#include "Serializable/CSerializableBinary.h"
 
 namespace Skylicht
 {
@@ -39,12 +40,27 @@ namespace Skylicht
 
 		static bool loadStep(CScene* scene, io::IXMLReader* reader);
 
+		static void buildSceneBinary(CScene* scene, CContainerObject* target, CSerializableBinary* data);
+
+		static void buildNodeBinary(CScene* scene, CContainerObject* container, CSerializableBinary* data, u32 node);
+
+		static void buildComponentBinary(CGameObject* object, CSerializableBinary* data, u32 node);
+
+		static bool beginLoadBinary(CScene* scene, CContainerObject* target, const char* path);
+
+		static bool loadStepBinary(CScene* scene);
+
+		static void releaseBinary();
+
 	public:
 
 		static bool beginImportScene(CScene* scene, const char* path);
 
 		static bool updateLoadScene();
 
+		/// @brief Set the number of objects that are loaded per updateLoadScene (default 10).
+		static void setLoadSceneStep(int step);
+
 		static float getLoadingPercent();
 
 		static int getTotalObjects();
@@ -0,0 +1,642 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CSerializableBinary.h"
+#include "CSerializableLoader.h"
+
+namespace Skylicht
+{
+	namespace
+	{
+		struct SBinaryWriter
+		{
+			std::vector<char> Strings;
+			std::vector<u32> StringOffset;
+			std::map<std::string, u32> StringId;
+
+			std::vector<u32> Schemas;
+			std::vector<u32> SchemaOffset;
+			std::map<std::vector<u32>, u32> SchemaId;
+
+			std::vector<CSerializableBinary::SNode> Nodes;
+			std::vector<u8> Data;
+
+			std::vector<u32> Schema;
+
+			io::IAttributes* Attributes;
+
+			u32 intern(const char* s)
+			{
+				std::map<std::string, u32>::iterator i = StringId.find(s);
+				if (i != StringId.end())
+					return i->second;
+
+				u32 id = (u32)StringOffset.size();
+				StringOffset.push_back((u32)Strings.size());
+				Strings.insert(Strings.end(), s, s + strlen(s) + 1);
+				StringId[s] = id;
+				return id;
+			}
+
+			u32 internSchema()
+			{
+				std::map<std::vector<u32>, u32>::iterator i = SchemaId.find(Schema);
+				if (i != SchemaId.end())
+					return i->second;
+
+				u32 id = (u32)SchemaOffset.size();
+				SchemaOffset.push_back((u32)(Schemas.size() * sizeof(u32)));
+				Schemas.push_back((u32)Schema.size() / 2);
+				Schemas.insert(Schemas.end(), Schema.begin(), Schema.end());
+				SchemaId[Schema] = id;
+				return id;
+			}
+
+			void write(const void* value, u32 size)
+			{
+				const u8* p = (const u8*)value;
+				Data.insert(Data.end(), p, p + size);
+			}
+
+			void writeNode(CObjectSerializable* object, u32 parent)
+			{
+				u32 id = (u32)Nodes.size();
+				Nodes.push_back(CSerializableBinary::SNode());
+
+				CSerializableBinary::SNode node;
+				node.Type = intern(object->Name.c_str());
+				node.Flags = 0;
+				node.Parent = parent;
+				node.DataOffset = (u32)Data.size();
+
+				if (object->getObjectType() == ObjectArray ||
+					object->getObjectType() == FileArray ||
+					object->getObjectType() == TextureArray)
+					node.Flags |= CSerializableBinary::ArrayNode;
+
+				Attributes->clear();
+				object->serialize(Attributes);
+
+				Schema.clear();
+
+				for (s32 i = 0, n = (s32)Attributes->getAttributeCount(); i < n; i++)
+				{
+					io::E_ATTRIBUTE_TYPE type = Attributes->getAttributeType(i);
+					u32 name = intern(Attributes->getAttributeName(i));
+
+					switch (type)
+					{
+					case io::EAT_INT:
+					{
+						s32 v = Attributes->getAttributeAsInt(i);
+						write(&v, sizeof(v));
+					}
+					break;
+					case io::EAT_UINT:
+					{
+						u32 v = Attributes->getAttributeAsUInt(i);
+						write(&v, sizeof(v));
+					}
+					break;
+					case io::EAT_FLOAT:
+					{
+						f32 v = Attributes->getAttributeAsFloat(i);
+						write(&v, sizeof(v));
+					}
+					break;
+					case io::EAT_DOUBLE:
+					{
+						f64 v = Attributes->getAttributeAsDouble(i);
+						write(&v, sizeof(v));
+					}
+					break;
+					case io::EAT_BOOL:
+					{
+						u32 v = Attributes->getAttributeAsBool(i) ? 1 : 0;
+						write(&v, sizeof(v));
+					}
+					break;
+					case io::EAT_COLOR:
+					{
+						u32 v = Attributes->getAttributeAsColor(i).color;
+						write(&v, sizeof(v));
+					}
+					break;
+					case io::EAT_VECTOR3D:
+					{
+						core::vector3df v = Attributes->getAttributeAsVector3d(i);
+						write(&v.X, sizeof(f32) * 3);
+					}
+					break;
+					case io::EAT_VECTOR2D:
+					{
+						core::vector2df v = Attributes->getAttributeAsVector2d(i);
+						write(&v.X, sizeof(f32) * 2);
+					}
+					break;
+					case io::EAT_QUATERNION:
+					{
+						core::quaternion v = Attributes->getAttributeAsQuaternion(i);
+						f32 q[4] = { v.X, v.Y, v.Z, v.W };
+						write(q, sizeof(q));
+					}
+					break;
+					case io::EAT_MATRIX:
+					{
+						core::matrix4 v = Attributes->getAttributeAsMatrix(i);
+						write(v.pointer(), sizeof(f32) * 16);
+					}
+					break;
+					default:
+					{
+						// the other types are saved as string
+						type = io::EAT_STRING;
+						u32 v = intern(Attributes->getAttributeAsString(i).c_str());
+						write(&v, sizeof(v));
+					}
+					break;
+					}
+
+					Schema.push_back(name);
+					Schema.push_back((u32)type);
+				}
+
+				node.Schema = internSchema();
+
+				// child objects
+				for (u32 i = 0, n = object->getNumProperty(); i < n; i++)
+				{
+					CValueProperty* p = object->getPropertyID(i);
+					if (p->getType() == EPropertyDataType::Object)
+						writeNode((CObjectSerializable*)p, id);
+				}
+
+				node.NumDescendant = (u32)Nodes.size() - id - 1;
+				Nodes[id] = node;
+			}
+		};
+
+		inline void alignBuffer(std::vector<u8>& output)
+		{
+			while (output.size() % 8 != 0)
+				output.push_back(0);
+		}
+
+		template<class T>
+		inline void appendBuffer(std::vector<u8>& output, const std::vector<T>& data)
+		{
+			const u8* p = (const u8*)data.data();
+			output.insert(output.end(), p, p + data.size() * sizeof(T));
+		}
+	}
+
+	CSerializableBinary::CSerializableBinary() :
+		m_data(NULL),
+		m_size(0),
+		m_header(NULL),
+		m_stringOffset(NULL),
+		m_schemaOffset(NULL),
+		m_nodes(NULL)
+	{
+
+	}
+
+	CSerializableBinary::~CSerializableBinary()
+	{
+		clear();
+	}
+
+	void CSerializableBinary::clear()
+	{
+		if (m_data)
+			delete[] m_data;
+
+		m_data = NULL;
+		m_size = 0;
+		m_header = NULL;
+		m_stringOffset = NULL;
+		m_schemaOffset = NULL;
+		m_nodes = NULL;
+	}
+
+	void CSerializableBinary::save(CObjectSerializable* object, std::vector<u8>& output)
+	{
+		SBinaryWriter writer;
+		writer.Attributes = getIrrlichtDevice()->getFileSystem()->createEmptyAttributes();
+		writer.writeNode(object, Invalid);
+		writer.Attributes->drop();
+
+		SHeader header;
+		header.Magic = Magic;
+		header.Version = Version;
+		header.NumString = (u32)writer.StringOffset.size();
+		header.NumSchema = (u32)writer.SchemaOffset.size();
+		header.NumNode = (u32)writer.Nodes.size();
+
+		output.clear();
+		output.resize(sizeof(SHeader));
+		alignBuffer(output);
+
+		// string table
+		header.StringOffset = (u32)output.size();
+		appendBuffer(output, writer.StringOffset);
+		u32 stringData = (u32)output.size();
+		appendBuffer(output, writer.Strings);
+		alignBuffer(output);
+
+		// the offsets is relative to the string data
+		for (u32 i = 0; i < header.NumString; i++)
+		{
+			u32 offset = writer.StringOffset[i] + stringData - header.StringOffset;
+			memcpy(&output[header.StringOffset + i * sizeof(u32)], &offset, sizeof(u32));
+		}
+
+		// schema table
+		header.SchemaOffset = (u32)output.size();
+		u32 schemaData = header.SchemaOffset + header.NumSchema * sizeof(u32);
+		for (u32 i = 0; i < header.NumSchema; i++)
+			writer.SchemaOffset[i] += schemaData - header.SchemaOffset;
+		appendBuffer(output, writer.SchemaOffset);
+		appendBuffer(output, writer.Schemas);
+		alignBuffer(output);
+
+		// node table
+		header.NodeOffset = (u32)output.size();
+		appendBuffer(output, writer.Nodes);
+		alignBuffer(output);
+
+		// value data
+		header.DataOffset = (u32)output.size();
+		appendBuffer(output, writer.Data);
+
+		header.Size = (u32)output.size();
+		memcpy(output.data(), &header, sizeof(SHeader));
+	}
+
+	bool CSerializableBinary::save(CObjectSerializable* object, const char* path)
+	{
+		std::vector<u8> output;
+		save(object, output);
+
+		io::IWriteFile* file = getIrrlichtDevice()->getFileSystem()->createAndWriteFile(path);
+		if (file == NULL)
+			return false;
+
+		bool result = file->write(output.data(), (u32)output.size()) == (s32)output.size();
+		file->drop();
+		return result;
+	}
+
+	bool CSerializableBinary::isBinaryFile(const char* path)
+	{
+		io::IReadFile* file = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(path);
+		if (file == NULL)
+			return false;
+
+		u32 magic = 0;
+		bool result = file->read(&magic, sizeof(u32)) == sizeof(u32) && magic == Magic;
+		file->drop();
+		return result;
+	}
+
+	bool CSerializableBinary::load(const char* path)
+	{
+		clear();
+
+		io::IReadFile* file = getIrrlichtDevice()->getFileSystem()->createAndOpenFile(path);
+		if (file == NULL)
+			return false;
+
+		m_size = (u32)file->getSize();
+		m_data = new u8[m_size];
+
+		bool result = file->read(m_data, m_size) == (s32)m_size;
+		file->drop();
+
+		if (!result || !validate())
+		{
+			char log[1024];
+			sprintf(log, "[CSerializableBinary::load] Invalid file: %s", path);
+			os::Printer::log(log);
+
+			clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool CSerializableBinary::load(const void* data, u32 size)
+	{
+		clear();
+
+		m_size = size;
+		m_data = new u8[m_size];
+		memcpy(m_data, data, size);
+
+		if (!validate())
+		{
+			clear();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool CSerializableBinary::validate()
+	{
+		if (m_size < sizeof(SHeader))
+			return false;
+
+		const SHeader* header = (const SHeader*)m_data;
+		if (header->Magic != Magic || header->Version != Version || header->Size != m_size)
+			return false;
+
+		if (header->StringOffset < sizeof(SHeader) ||
+			header->SchemaOffset < header->StringOffset + (u64)header->NumString * sizeof(u32) ||
+			header->NodeOffset < header->SchemaOffset + (u64)header->NumSchema * sizeof(u32) ||
+			header->DataOffset < header->NodeOffset + (u64)header->NumNode * sizeof(SNode) ||
+			header->DataOffset > m_size ||
+			header->NumNode == 0)
+			return false;
+
+		m_header = header;
+		m_stringOffset = (const u32*)(m_data + header->StringOffset);
+		m_schemaOffset = (const u32*)(m_data + header->SchemaOffset);
+		m_nodes = (const SNode*)(m_data + header->NodeOffset);
+
+		// all the strings are terminated before the schema table
+		if (header->NumString > 0 && m_data[header->SchemaOffset - 1] != 0)
+			return false;
+
+		for (u32 i = 0; i < header->NumString; i++)
+		{
+			if (header->StringOffset + (u64)m_stringOffset[i] >= header->SchemaOffset)
+				return false;
+		}
+
+		for (u32 i = 0; i < header->NumSchema; i++)
+		{
+			u64 offset = header->SchemaOffset + (u64)m_schemaOffset[i];
+			if (offset + sizeof(u32) > m_size)
+				return false;
+
+			u32 count;
+			memcpy(&count, m_data + offset, sizeof(u32));
+			if (offset + sizeof(u32) + (u64)count * 2 * sizeof(u32) > m_size)
+				return false;
+		}
+
+		for (u32 i = 0; i < header->NumNode; i++)
+		{
+			const SNode& node = m_nodes[i];
+			if (node.Type >= header->NumString ||
+				node.Schema >= header->NumSchema ||
+				i + (u64)node.NumDescendant >= header->NumNode ||
+				(node.Parent != Invalid && node.Parent >= i) ||
+				header->DataOffset + (u64)node.DataOffset > m_size)
+				return false;
+		}
+
+		return true;
+	}
+
+	u32 CSerializableBinary::getNextSibling(u32 node) const
+	{
+		u32 parent = m_nodes[node].Parent;
+		if (parent == Invalid)
+			return Invalid;
+
+		u32 next = node + m_nodes[node].NumDescendant + 1;
+		if (next > parent + m_nodes[parent].NumDescendant)
+			return Invalid;
+
+		return next;
+	}
+
+	u32 CSerializableBinary::findChild(u32 node, const char* type) const
+	{
+		for (u32 child = getFirstChild(node); child != Invalid; child = getNextSibling(child))
+		{
+			if (strcmp(getType(child), type) == 0)
+				return child;
+		}
+		return Invalid;
+	}
+
+	void CSerializableBinary::readAttributes(u32 node, io::IAttributes* attributes) const
+	{
+		const u8* schema = m_data + m_header->SchemaOffset + m_schemaOffset[m_nodes[node].Schema];
+		const u8* value = m_data + m_header->DataOffset + m_nodes[node].DataOffset;
+		const u8* end = m_data + m_size;
+
+		u32 count;
+		memcpy(&count, schema, sizeof(u32));
+		schema += sizeof(u32);
+
+		for (u32 i = 0; i < count; i++)
+		{
+			u32 name, type;
+			memcpy(&name, schema, sizeof(u32));
+			memcpy(&type, schema + sizeof(u32), sizeof(u32));
+			schema += 2 * sizeof(u32);
+
+			if (name >= m_header->NumString)
+				return;
+
+			const c8* attributeName = getString(name);
+
+			u32 size = sizeof(u32);
+			if (type == io::EAT_DOUBLE || type == io::EAT_VECTOR2D)
+				size = 8;
+			else if (type == io::EAT_VECTOR3D)
+				size = 12;
+			else if (type == io::EAT_QUATERNION)
+				size = 16;
+			else if (type == io::EAT_MATRIX)
+				size = 64;
+
+			if (value + size > end)
+				return;
+
+			switch (type)
+			{
+			case io::EAT_INT:
+			{
+				s32 v;
+				memcpy(&v, value, sizeof(v));
+				attributes->addInt(attributeName, v);
+			}
+			break;
+			case io::EAT_UINT:
+			{
+				u32 v;
+				memcpy(&v, value, sizeof(v));
+				attributes->addUInt(attributeName, v);
+			}
+			break;
+			case io::EAT_FLOAT:
+			{
+				f32 v;
+				memcpy(&v, value, sizeof(v));
+				attributes->addFloat(attributeName, v);
+			}
+			break;
+			case io::EAT_DOUBLE:
+			{
+				f64 v;
+				memcpy(&v, value, sizeof(v));
+				attributes->addDouble(attributeName, v);
+			}
+			break;
+			case io::EAT_BOOL:
+			{
+				u32 v;
+				memcpy(&v, value, sizeof(v));
+				attributes->addBool(attributeName, v != 0);
+			}
+			break;
+			case io::EAT_COLOR:
+			{
+				u32 v;
+				memcpy(&v, value, sizeof(v));
+				attributes->addColor(attributeName, video::SColor(v));
+			}
+			break;
+			case io::EAT_VECTOR3D:
+			{
+				core::vector3df v;
+				memcpy(&v.X, value, sizeof(f32) * 3);
+				attributes->addVector3d(attributeName, v);
+			}
+			break;
+			case io::EAT_VECTOR2D:
+			{
+				core::vector2df v;
+				memcpy(&v.X, value, sizeof(f32) * 2);
+				attributes->addVector2d(attributeName, v);
+			}
+			break;
+			case io::EAT_QUATERNION:
+			{
+				f32 q[4];
+				memcpy(q, value, sizeof(q));
+				attributes->addQuaternion(attributeName, core::quaternion(q[0], q[1], q[2], q[3]));
+			}
+			break;
+			case io::EAT_MATRIX:
+			{
+				core::matrix4 v(core::matrix4::EM4CONST_NOTHING);
+				memcpy(v.pointer(), value, sizeof(f32) * 16);
+				attributes->addMatrix(attributeName, v);
+			}
+			break;
+			case io::EAT_STRING:
+			{
+				u32 v;
+				memcpy(&v, value, sizeof(v));
+				if (v < m_header->NumString)
+					attributes->addString(attributeName, getString(v));
+			}
+			break;
+			default:
+				return;
+			}
+
+			value += size;
+		}
+	}
+
+	void CSerializableBinary::loadObject(u32 node, CObjectSerializable* object, const char* exitNode) const
+	{
+		const char* type = getType(node);
+
+		bool acceptName = object->Name == type;
+		if (!acceptName)
+		{
+			for (const std::string& name : object->OtherName)
+			{
+				if (name == type)
+				{
+					acceptName = true;
+					break;
+				}
+			}
+		}
+
+		if (!acceptName)
+		{
+			char log[1024];
+			sprintf(log, "[CSerializableBinary::loadObject] Skip wrong data: type: %s, %s ", object->Name.c_str(), type);
+			os::Printer::log(log);
+			return;
+		}
+
+		io::IAttributes* attr = getIrrlichtDevice()->getFileSystem()->createEmptyAttributes();
+		readAttributes(node, attr);
+		CSerializableLoader::loadAttributes(object, attr);
+		attr->drop();
+
+		for (u32 child = getFirstChild(node); child != Invalid; child = getNextSibling(child))
+		{
+			const char* name = getType(child);
+
+			bool newObject = true;
+			CObjectSerializable* data;
+
+			// activator
+			data = CSerializableActivator::getInstance()->createInstance(name);
+			if (data == NULL)
+			{
+				// try find the current object with the name
+				data = dynamic_cast<CObjectSerializable*>(object->getProperty(name));
+				if (data != NULL)
+				{
+					// use exist property
+					newObject = false;
+				}
+				else
+				{
+					// we will add new object serializable
+					if (m_nodes[child].Flags & ArrayNode)
+						data = new CArraySerializable(name);
+					else
+						data = new CObjectSerializable(name);
+				}
+			}
+
+			loadObject(child, data, NULL);
+
+			if (newObject)
+			{
+				object->addProperty(data);
+				object->autoRelease(data);
+			}
+
+			if (exitNode != NULL && strcmp(name, exitNode) == 0)
+				return;
+		}
+	}
+}
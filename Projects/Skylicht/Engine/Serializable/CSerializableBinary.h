@@ -0,0 +1,162 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CObjectSerializable.h"
+
+namespace Skylicht
+{
+	/**
+	 * @brief The compact binary format of a CObjectSerializable tree, it is used by the binary scene and template files.
+	 *
+	 * File layout:
+	 * - SHeader
+	 * - String table: u32 offsets[NumString], then the null terminated strings. The type names, property names and string values are interned.
+	 * - Schema table: u32 offsets[NumSchema], each schema is {count, (name, io::E_ATTRIBUTE_TYPE) * count}. The nodes that have the same property layout share one schema.
+	 * - Node table: SNode[NumNode] in pre-order, the children of a node follow it.
+	 * - Value data: the packed property values of each node, in the order of its schema.
+	 *
+	 * The loaded data is read only, so the nodes can be decoded on the job threads at the same time.
+	 *
+	 * @code
+	 * CSerializableBinary::save(data, "Scene/MyScene.sbin");
+	 *
+	 * CSerializableBinary binary;
+	 * if (binary.load("Scene/MyScene.sbin"))
+	 *	binary.loadObject(0, data);
+	 * @endcode
+	 */
+	class SKYLICHT_API CSerializableBinary
+	{
+	public:
+		static const u32 Magic = 0x42534B53; // "SKSB"
+		static const u32 Version = 1;
+		static const u32 Invalid = 0xFFFFFFFF;
+
+		struct SHeader
+		{
+			u32 Magic;
+			u32 Version;
+			u32 NumString;
+			u32 NumSchema;
+			u32 NumNode;
+			u32 StringOffset;
+			u32 SchemaOffset;
+			u32 NodeOffset;
+			u32 DataOffset;
+			u32 Size;
+		};
+
+		enum ENodeFlag
+		{
+			ArrayNode = 1
+		};
+
+		struct SNode
+		{
+			u32 Type;
+			u32 Flags;
+			u32 Schema;
+			u32 Parent;
+			u32 NumDescendant;
+			u32 DataOffset;
+		};
+
+	protected:
+		u8* m_data;
+		u32 m_size;
+
+		const SHeader* m_header;
+		const u32* m_stringOffset;
+		const u32* m_schemaOffset;
+		const SNode* m_nodes;
+
+	public:
+		CSerializableBinary();
+
+		virtual ~CSerializableBinary();
+
+		/// @brief Write the object tree to a binary file.
+		static bool save(CObjectSerializable* object, const char* path);
+
+		/// @brief Write the object tree to a memory buffer.
+		static void save(CObjectSerializable* object, std::vector<u8>& output);
+
+		/// @brief Check the file header is the binary serializable format.
+		static bool isBinaryFile(const char* path);
+
+		bool load(const char* path);
+
+		/// @brief Load from a memory buffer, the data is copied.
+		bool load(const void* data, u32 size);
+
+		void clear();
+
+		inline u32 getNumNode()
+		{
+			return m_header ? m_header->NumNode : 0;
+		}
+
+		inline const SNode& getNode(u32 node) const
+		{
+			return m_nodes[node];
+		}
+
+		inline const char* getString(u32 id) const
+		{
+			return (const char*)(m_data + m_header->StringOffset + m_stringOffset[id]);
+		}
+
+		/// @brief The type name of the node (the name of CObjectSerializable).
+		inline const char* getType(u32 node) const
+		{
+			return getString(m_nodes[node].Type);
+		}
+
+		inline u32 getFirstChild(u32 node) const
+		{
+			return m_nodes[node].NumDescendant > 0 ? node + 1 : Invalid;
+		}
+
+		u32 getNextSibling(u32 node) const;
+
+		u32 findChild(u32 node, const char* type) const;
+
+		/// @brief Read the property values of a node.
+		void readAttributes(u32 node, io::IAttributes* attributes) const;
+
+		/**
+		 * @brief Load a node and its children to the object, same as CSerializableLoader::load from the xml file.
+		 * @param node The node index.
+		 * @param object The object that have the same name with the node type.
+		 * @param exitNode Stop after the child node that have this type is loaded, or NULL to load all childs.
+		 */
+		void loadObject(u32 node, CObjectSerializable* object, const char* exitNode = NULL) const;
+
+	protected:
+
+		bool validate();
+	};
+}
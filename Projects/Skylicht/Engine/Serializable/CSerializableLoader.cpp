@@ -61,34 +61,7 @@ namespace Skylicht
 		if (nodeName == reader->getNodeName() && acceptName)
 		{
 			attr->read(reader);
-
-			if (object->getNumProperty() > 0)
-				object->deserialize(attr); // for SerializableActivator
-			else
-			{
-				if (object->getObjectType() == ObjectArray ||
-					object->getObjectType() == FileArray ||
-					object->getObjectType() == TextureArray)
-				{
-					CArraySerializable* arrayObject = dynamic_cast<CArraySerializable*>(object);
-					if (arrayObject->haveCreateElementFunction())
-					{
-						// create element and deserialize
-						int numElement = attr->getAttributeCount();
-						arrayObject->resize(numElement);
-						arrayObject->deserialize(attr);
-					}
-					else
-					{
-						// this is array but no create element function
-						initProperty(object, attr);
-					}
-				}
-				else
-				{
-					initProperty(object, attr);
-				}
-			}
+			loadAttributes(object, attr);
 		}
 		else
 		{
@@ -171,6 +144,37 @@ namespace Skylicht
 		}
 	}
 
+	void CSerializableLoader::loadAttributes(CObjectSerializable* object, io::IAttributes* attr)
+	{
+		if (object->getNumProperty() > 0)
+			object->deserialize(attr); // for SerializableActivator
+		else
+		{
+			if (object->getObjectType() == ObjectArray ||
+				object->getObjectType() == FileArray ||
+				object->getObjectType() == TextureArray)
+			{
+				CArraySerializable* arrayObject = dynamic_cast<CArraySerializable*>(object);
+				if (arrayObject->haveCreateElementFunction())
+				{
+					// create element and deserialize
+					int numElement = attr->getAttributeCount();
+					arrayObject->resize(numElement);
+					arrayObject->deserialize(attr);
+				}
+				else
+				{
+					// this is array but no create element function
+					initProperty(object, attr);
+				}
+			}
+			else
+			{
+				initProperty(object, attr);
+			}
+		}
+	}
+
 	bool CSerializableLoader::loadSerializable(const char* file, CObjectSerializable* object)
 	{
 		io::IXMLReader* reader = getIrrlichtDevice()->getFileSystem()->createXMLReader(file);
@@ -37,6 +37,8 @@ namespace Skylicht
 		
 		static bool loadSerializable(const char* file, CObjectSerializable* object);
 
+		static void loadAttributes(CObjectSerializable* object, io::IAttributes* attributes);
+
 		static void initProperty(CObjectSerializable* object, io::IAttributes* attributes);
 	};
 }
\ No newline at end of file
@@ -36,7 +36,8 @@ namespace Skylicht
 		m_shadowMapSize(2048),
 		m_lambda(0.9f),
 		m_nearOffset(300.0f),
-		m_farValue(500.0f)
+		m_farValue(500.0f),
+		m_worldAnchor(false)
 	{
 
 	}
@@ -199,6 +200,23 @@ namespace Skylicht
 
 			radius = ceil(radius * 16.0f) / 16.0f;
 
+			if (m_worldAnchor)
+			{
+				// the snapped center moves at most half a step on each axis of light space
+				radius = ceil(radius * 8.0f / 7.0f * 16.0f) / 16.0f;
+				float step = radius * 0.25f;
+
+				core::vector3df lightX = Transform::Oy.crossProduct(m_lightDirection);
+				lightX.normalize();
+				core::vector3df lightY = m_lightDirection.crossProduct(lightX);
+
+				float x = floorf(frustum.Center.dotProduct(lightX) / step + 0.5f) * step;
+				float y = floorf(frustum.Center.dotProduct(lightY) / step + 0.5f) * step;
+				float z = floorf(frustum.Center.dotProduct(m_lightDirection) / step + 0.5f) * step;
+
+				frustum.Center = lightX * x + lightY * y + m_lightDirection * z;
+			}
+
 			// Find bounding box that fits the sphere
 			core::vector3df radius3(radius, radius, radius);
 
@@ -55,6 +55,8 @@ namespace Skylicht
 
 		float m_farValue;
 
+		bool m_worldAnchor;
+
 	public:
 		CCascadedShadowMaps();
 
@@ -64,6 +66,18 @@ namespace Skylicht
 
 		void update(CCamera *camera, const core::vector3df& lightDir);
 
+		// anchor the cascades on a world grid (1/8 of cascade size), the matrices do not change while the camera moves inside a cell
+		// the shadow resolution is lower a bit, because the cascade is extended to cover the frustum split
+		inline void setWorldAnchor(bool b)
+		{
+			m_worldAnchor = b;
+		}
+
+		inline bool isWorldAnchor()
+		{
+			return m_worldAnchor;
+		}
+
 		inline const core::aabbox3df& getFrustumBox(int cascaded)
 		{
 			return m_frustumBox[cascaded];
@@ -0,0 +1,255 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CShadowCasterCulling.h"
+#include "Utils/SIMD.h"
+#include "Job/CJobScheduler.h"
+
+namespace Skylicht
+{
+	// test the box of 4 casters with the frustum planes, return the bit mask of the casters that are not outside
+	static inline u32 testBox4(const float* cx, const float* cy, const float* cz, const float* ex, const float* ey, const float* ez, const float planes[][4], int numPlane)
+	{
+#if defined(SKYLICHT_SIMD_SSE)
+		__m128 x = _mm_loadu_ps(cx);
+		__m128 y = _mm_loadu_ps(cy);
+		__m128 z = _mm_loadu_ps(cz);
+		__m128 hx = _mm_loadu_ps(ex);
+		__m128 hy = _mm_loadu_ps(ey);
+		__m128 hz = _mm_loadu_ps(ez);
+		__m128 zero = _mm_setzero_ps();
+		__m128 outside = zero;
+
+		for (int i = 0; i < numPlane; i++)
+		{
+			const float* p = planes[i];
+
+			// the nearest distance of box to the plane: n.c + d - |n|.e
+#if defined(SKYLICHT_SIMD_AVX2)
+			__m128 d = _mm_fmadd_ps(z, _mm_set1_ps(p[2]), _mm_fmadd_ps(y, _mm_set1_ps(p[1]), _mm_fmadd_ps(x, _mm_set1_ps(p[0]), _mm_set1_ps(p[3]))));
+			__m128 r = _mm_fmadd_ps(hz, _mm_set1_ps(fabsf(p[2])), _mm_fmadd_ps(hy, _mm_set1_ps(fabsf(p[1])), _mm_mul_ps(hx, _mm_set1_ps(fabsf(p[0])))));
+#else
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(p[0])), _mm_mul_ps(y, _mm_set1_ps(p[1]))), _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(p[2])), _mm_set1_ps(p[3])));
+			__m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(hx, _mm_set1_ps(fabsf(p[0]))), _mm_mul_ps(hy, _mm_set1_ps(fabsf(p[1])))), _mm_mul_ps(hz, _mm_set1_ps(fabsf(p[2]))));
+#endif
+			outside = _mm_or_ps(outside, _mm_cmpgt_ps(_mm_sub_ps(d, r), zero));
+		}
+
+		return (~(u32)_mm_movemask_ps(outside)) & 0xF;
+#elif defined(SKYLICHT_SIMD_NEON)
+		float32x4_t x = vld1q_f32(cx);
+		float32x4_t y = vld1q_f32(cy);
+		float32x4_t z = vld1q_f32(cz);
+		float32x4_t hx = vld1q_f32(ex);
+		float32x4_t hy = vld1q_f32(ey);
+		float32x4_t hz = vld1q_f32(ez);
+		float32x4_t zero = vdupq_n_f32(0.0f);
+		uint32x4_t outside = vdupq_n_u32(0);
+
+		for (int i = 0; i < numPlane; i++)
+		{
+			const float* p = planes[i];
+
+			float32x4_t d = vmlaq_f32(vmlaq_f32(vmlaq_f32(vdupq_n_f32(p[3]), x, vdupq_n_f32(p[0])), y, vdupq_n_f32(p[1])), z, vdupq_n_f32(p[2]));
+			float32x4_t r = vmlaq_f32(vmlaq_f32(vmulq_f32(hx, vdupq_n_f32(fabsf(p[0]))), hy, vdupq_n_f32(fabsf(p[1]))), hz, vdupq_n_f32(fabsf(p[2])));
+
+			outside = vorrq_u32(outside, vcgtq_f32(vsubq_f32(d, r), zero));
+		}
+
+		return ((vgetq_lane_u32(outside, 0) & 1) |
+			(vgetq_lane_u32(outside, 1) & 2) |
+			(vgetq_lane_u32(outside, 2) & 4) |
+			(vgetq_lane_u32(outside, 3) & 8)) ^ 0xF;
+#else
+		u32 mask = 0;
+		for (int j = 0; j < 4; j++)
+		{
+			bool inside = true;
+			for (int i = 0; i < numPlane && inside; i++)
+			{
+				const float* p = planes[i];
+				float d = p[0] * cx[j] + p[1] * cy[j] + p[2] * cz[j] + p[3];
+				float r = fabsf(p[0]) * ex[j] + fabsf(p[1]) * ey[j] + fabsf(p[2]) * ez[j];
+				if (d - r > 0.0f)
+					inside = false;
+			}
+
+			if (inside)
+				mask |= 1 << j;
+		}
+		return mask;
+#endif
+	}
+
+	CShadowCasterCulling::CShadowCasterCulling() :
+		m_numCascade(0)
+	{
+		for (int i = 0; i < MAX_SHADOW_CASCADE; i++)
+		{
+			m_cascadeHash[i] = 0;
+			m_cascadeDynamic[i] = false;
+		}
+	}
+
+	CShadowCasterCulling::~CShadowCasterCulling()
+	{
+
+	}
+
+	void CShadowCasterCulling::setCascades(int count, const core::matrix4* viewProj)
+	{
+		m_numCascade = core::clamp(count, 0, MAX_SHADOW_CASCADE);
+
+		for (int i = 0; i < m_numCascade; i++)
+		{
+			// the plane normals point to outside of frustum
+			SViewFrustum frustum;
+			frustum.setFrom(viewProj[i]);
+
+			for (int j = 0; j < SViewFrustum::VF_PLANE_COUNT; j++)
+			{
+				const core::plane3df& plane = frustum.planes[j];
+				m_planes[i][j][0] = plane.Normal.X;
+				m_planes[i][j][1] = plane.Normal.Y;
+				m_planes[i][j][2] = plane.Normal.Z;
+				m_planes[i][j][3] = plane.D;
+			}
+		}
+	}
+
+	void CShadowCasterCulling::beginCasters()
+	{
+		m_centerX.set_used(0);
+		m_centerY.set_used(0);
+		m_centerZ.set_used(0);
+		m_extentX.set_used(0);
+		m_extentY.set_used(0);
+		m_extentZ.set_used(0);
+		m_ids.set_used(0);
+		m_dynamic.set_used(0);
+	}
+
+	u32 CShadowCasterCulling::addCaster(const core::aabbox3df& box, u32 id, bool dynamic)
+	{
+		core::vector3df center = box.getCenter();
+		core::vector3df extent = box.getExtent() * 0.5f;
+
+		m_centerX.push_back(center.X);
+		m_centerY.push_back(center.Y);
+		m_centerZ.push_back(center.Z);
+		m_extentX.push_back(extent.X);
+		m_extentY.push_back(extent.Y);
+		m_extentZ.push_back(extent.Z);
+		m_ids.push_back(id);
+		m_dynamic.push_back(dynamic);
+
+		return m_ids.size() - 1;
+	}
+
+	void CShadowCasterCulling::classify()
+	{
+		u32 count = m_ids.size();
+		u32 numBlock = (count + 3) / 4;
+
+		// pad the arrays to the block of 4 casters, the padding casters are not used
+		u32 padded = numBlock * 4;
+		for (u32 i = count; i < padded; i++)
+		{
+			m_centerX.push_back(0.0f);
+			m_centerY.push_back(0.0f);
+			m_centerZ.push_back(0.0f);
+			m_extentX.push_back(0.0f);
+			m_extentY.push_back(0.0f);
+			m_extentZ.push_back(0.0f);
+		}
+
+		m_masks.set_used(padded);
+
+		int numCascade = m_numCascade;
+
+		System::CJobScheduler::getInstance()->parallelFor(0, (int)numBlock, 64, [&](int from, int to)
+			{
+				for (int b = from; b < to; b++)
+				{
+					u32 i = (u32)b * 4;
+					u32 masks[4] = { 0, 0, 0, 0 };
+
+					for (int c = 0; c < numCascade; c++)
+					{
+						u32 inside = testBox4(
+							&m_centerX[i], &m_centerY[i], &m_centerZ[i],
+							&m_extentX[i], &m_extentY[i], &m_extentZ[i],
+							m_planes[c], SViewFrustum::VF_PLANE_COUNT);
+
+						for (int j = 0; j < 4; j++)
+						{
+							if (inside & (1 << j))
+								masks[j] |= 1 << c;
+						}
+					}
+
+					for (int j = 0; j < 4; j++)
+						m_masks[i + j] = masks[j];
+				}
+			});
+
+		// remove the padding
+		m_centerX.set_used(count);
+		m_centerY.set_used(count);
+		m_centerZ.set_used(count);
+		m_extentX.set_used(count);
+		m_extentY.set_used(count);
+		m_extentZ.set_used(count);
+		m_masks.set_used(count);
+
+		// build the draw list of cascades
+		for (int c = 0; c < numCascade; c++)
+		{
+			core::array<u32>& casters = m_cascadeCasters[c];
+			casters.set_used(0);
+
+			u32 hash = 2166136261u;
+			bool dynamic = false;
+			u32 bit = 1 << c;
+
+			for (u32 i = 0; i < count; i++)
+			{
+				if (m_masks[i] & bit)
+				{
+					casters.push_back(i);
+
+					// a moving caster leaves the static set, so the static depth is rendered again
+					if (m_dynamic[i])
+						dynamic = true;
+					else
+						hash = (hash ^ m_ids[i]) * 16777619u;
+				}
+			}
+
+			m_cascadeHash[c] = hash;
+			m_cascadeDynamic[c] = dynamic;
+		}
+	}
+}
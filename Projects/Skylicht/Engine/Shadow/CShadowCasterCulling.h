@@ -0,0 +1,133 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#define MAX_SHADOW_CASCADE 8
+
+namespace Skylicht
+{
+	/**
+	 * @brief Classify the shadow casters against all cascade frusta of the directional light in one pass.
+	 * @ingroup Shadow
+	 *
+	 * The caster boxes are stored as center/extent arrays and tested by 4 casters at once (SSE/NEON) on the job threads.
+	 * The result is a cascade bit mask per caster and a draw list per cascade, so a caster is only drawn in the cascades it touches.
+	 *
+	 * @code
+	 * culling.setCascades(numCascade, viewProj);
+	 * culling.beginCasters();
+	 * for (...)
+	 *     culling.addCaster(box, id, dynamic);
+	 * culling.classify();
+	 *
+	 * if (culling.getMask(caster) & (1 << cascade))
+	 *     drawCaster(caster);
+	 * @endcode
+	 */
+	class SKYLICHT_API CShadowCasterCulling
+	{
+	protected:
+		int m_numCascade;
+
+		// the planes of cascade frusta: nx, ny, nz, d
+		float m_planes[MAX_SHADOW_CASCADE][SViewFrustum::VF_PLANE_COUNT][4];
+
+		core::array<float> m_centerX;
+		core::array<float> m_centerY;
+		core::array<float> m_centerZ;
+		core::array<float> m_extentX;
+		core::array<float> m_extentY;
+		core::array<float> m_extentZ;
+
+		core::array<u32> m_ids;
+		core::array<bool> m_dynamic;
+
+		core::array<u32> m_masks;
+		core::array<u32> m_cascadeCasters[MAX_SHADOW_CASCADE];
+
+		u32 m_cascadeHash[MAX_SHADOW_CASCADE];
+		bool m_cascadeDynamic[MAX_SHADOW_CASCADE];
+
+	public:
+		CShadowCasterCulling();
+
+		virtual ~CShadowCasterCulling();
+
+		/**
+		 * @brief Set the cascade frusta.
+		 * @param viewProj The projection * view matrix of each cascade.
+		 */
+		void setCascades(int count, const core::matrix4* viewProj);
+
+		void beginCasters();
+
+		/**
+		 * @brief Add a shadow caster.
+		 * @param box The world bounding box.
+		 * @param id The id of caster, it is used to detect the changes of static casters.
+		 * @param dynamic The caster moves or animates on this frame.
+		 * @return The index of caster, use it with getMask.
+		 */
+		u32 addCaster(const core::aabbox3df& box, u32 id, bool dynamic);
+
+		/**
+		 * @brief Test all casters with all cascades, build the masks and the draw lists.
+		 */
+		void classify();
+
+		inline int getCascadeCount()
+		{
+			return m_numCascade;
+		}
+
+		inline u32 getCasterCount()
+		{
+			return m_ids.size();
+		}
+
+		//! The bit i is set if the caster touches the cascade i
+		inline u32 getMask(u32 caster)
+		{
+			return m_masks[caster];
+		}
+
+		inline const core::array<u32>& getCascadeCasters(int cascade)
+		{
+			return m_cascadeCasters[cascade];
+		}
+
+		//! Hash of the static caster ids in the cascade, it changes when a static caster enters or leaves the cascade
+		inline u32 getCascadeHash(int cascade)
+		{
+			return m_cascadeHash[cascade];
+		}
+
+		//! The cascade has a dynamic caster, it must be rendered again
+		inline bool isCascadeDynamic(int cascade)
+		{
+			return m_cascadeDynamic[cascade];
+		}
+	};
+}
@@ -63,6 +63,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Graphics2D/Glyph/CGlyphFreetype.h"
 
+#include "Job/CJobScheduler.h"
+
 
 namespace Skylicht
 {
@@ -155,6 +157,8 @@ namespace Skylicht
 		CJoystick::releaseInstance();
 
 		CEventManager::releaseInstance();
+
+		System::CJobScheduler::releaseInstance();
 	}
 
 	void updateSkylicht()
@@ -163,6 +167,7 @@ namespace Skylicht
 		CAccelerometer::getInstance()->update();
 		CJoystick::getInstance()->update();
 		CTweenManager::getInstance()->update();
+		CTextureManager::getInstance()->updateAsyncTexture();
 
 		CSceneDebug* debug = CSceneDebug::getInstance();
 		CSceneDebug* noZDebug = debug->getNoZDebug();
@@ -0,0 +1,128 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "pch.h"
+#include "Job/CJobScheduler.h"
+
+#include <atomic>
+
+namespace Skylicht
+{
+	/**
+	 * @brief The handle of a texture that is loading by CTextureManager::getTextureAsync.
+	 * @ingroup Materials
+	 *
+	 * The file is read on the main thread, the image is decoded on the job threads, and the texture is created on the main thread in CTextureManager::updateAsyncTexture.
+	 * The handle is shared by all the requests of the same texture path, it is cancelled when all of them call CTextureManager::cancelTextureAsync.
+	 *
+	 * @code
+	 * CAsyncTexture* request = CTextureManager::getInstance()->getTextureAsync("SampleModels/Textures/Diffuse.png");
+	 * ...
+	 * if (request->isReady())
+	 * {
+	 *	ITexture* texture = request->getTexture();
+	 *	request->drop();
+	 * }
+	 * @endcode
+	 */
+	class SKYLICHT_API CAsyncTexture : public IReferenceCounted
+	{
+	public:
+		enum EState
+		{
+			Queued = 0,
+			Loading,
+			Decoded,
+			Ready,
+			Failed,
+			Cancelled
+		};
+
+	protected:
+		std::string m_path;
+
+		std::string m_package;
+
+		int m_priority;
+
+		u32 m_order;
+
+		std::atomic<int> m_state;
+
+		std::atomic<bool> m_cancel;
+
+		int m_holders;
+
+		io::IReadFile* m_file;
+
+		IImage* m_image;
+
+		ITexture* m_texture;
+
+		System::CJobHandle m_job;
+
+		friend class CTextureManager;
+
+	public:
+		CAsyncTexture(const char* path, const char* package, int priority, u32 order);
+
+		virtual ~CAsyncTexture();
+
+		/// @brief The resolved file path of the texture.
+		inline const char* getPath()
+		{
+			return m_path.c_str();
+		}
+
+		inline int getPriority()
+		{
+			return m_priority;
+		}
+
+		inline EState getState()
+		{
+			return (EState)m_state.load(std::memory_order_acquire);
+		}
+
+		inline bool isReady()
+		{
+			return getState() == Ready;
+		}
+
+		/// @brief The request is ready, failed or cancelled.
+		inline bool isFinished()
+		{
+			EState state = getState();
+			return state == Ready || state == Failed || state == Cancelled;
+		}
+
+		/// @brief Get the texture, it is NULL until the request is ready.
+		inline ITexture* getTexture()
+		{
+			return m_texture;
+		}
+	};
+}
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "CTextureManager.h"
 #include "Utils/CPath.h"
+#include "Graphics2D/CGraphics2D.h"
 
 namespace Skylicht
 {
@@ -15,7 +16,10 @@ namespace Skylicht
 
 	CTextureManager::CTextureManager() :
 		m_nullNormalMap(NULL),
-		m_nullTexture(NULL)
+		m_nullTexture(NULL),
+		m_asyncOrder(0),
+		m_maxAsyncDecode(4),
+		m_asyncUploadBudget(4 * 1024 * 1024)
 	{
 		m_currentPackage = GlobalPackage;
 	}
@@ -54,6 +58,11 @@ namespace Skylicht
 	}
 
 	void CTextureManager::registerTexture(ITexture* tex, const char* path)
+	{
+		registerTexture(tex, path, m_currentPackage.c_str());
+	}
+
+	void CTextureManager::registerTexture(ITexture* tex, const char* path, const char* packageName)
 	{
 		if (tex == NULL)
 			return;
@@ -70,13 +79,20 @@ namespace Skylicht
 		m_textureList.push_back(new STexturePackage());
 
 		STexturePackage* package = m_textureList.back();
-		package->Package = m_currentPackage;
+		package->Package = packageName;
 		package->Texture = tex;
 		package->Path = path;
 	}
 
 	void CTextureManager::removeAllTexture()
 	{
+		cancelAllAsyncTexture();
+
+		// the runtime atlas keeps the textures
+		CGraphics2D* g = CGraphics2D::getInstance();
+		if (g)
+			g->clearRuntimeAtlas();
+
 		IVideoDriver* driver = getVideoDriver();
 
 		std::vector<STexturePackage*>::iterator i = m_textureList.begin(), end = m_textureList.end();
@@ -100,6 +116,10 @@ namespace Skylicht
 
 	void CTextureManager::removeTexture(ITexture* tex)
 	{
+		CGraphics2D* g = CGraphics2D::getInstance();
+		if (g)
+			g->releaseRuntimeAtlasTexture(tex);
+
 		IVideoDriver* driver = getVideoDriver();
 
 		std::vector<STexturePackage*>::iterator i = m_textureList.begin(), end = m_textureList.end();
@@ -128,6 +148,7 @@ namespace Skylicht
 	void CTextureManager::removeTexture(const char* namePackage)
 	{
 		IVideoDriver* driver = getVideoDriver();
+		CGraphics2D* g = CGraphics2D::getInstance();
 		char log[1024];
 
 		std::map<ITexture*, int> skips;
@@ -143,6 +164,9 @@ namespace Skylicht
 				if ((*i)->Package == namePackage)
 				{
 					ITexture* texture = (*i)->Texture;
+					if (g)
+						g->releaseRuntimeAtlasTexture(texture);
+
 					if (texture->getReferenceCount() == 1)
 					{
 						sprintf(log, "Remove Texture: %s - refCount: %d",
@@ -383,6 +407,310 @@ namespace Skylicht
 		return texture;
 	}
 
+	CAsyncTexture* CTextureManager::getTextureAsync(const char* path, int priority)
+	{
+		std::string realPath;
+		if (!resolveTexturePath(path, realPath))
+			return NULL;
+
+		IVideoDriver* driver = getVideoDriver();
+
+		// the placeholder textures while loading
+		if (m_nullNormalMap == NULL)
+			m_nullNormalMap = driver->getTexture("BuiltIn/Textures/NullNormalMap.png");
+
+		if (m_nullTexture == NULL)
+			m_nullTexture = driver->getTexture("BuiltIn/Textures/NullTexture.png");
+
+		// the texture is loaded
+		for (STexturePackage* t : m_textureList)
+		{
+			if (t->Texture && t->Path == realPath)
+			{
+				CAsyncTexture* request = new CAsyncTexture(realPath.c_str(), t->Package.c_str(), priority, m_asyncOrder++);
+				request->m_texture = t->Texture;
+				request->m_state = CAsyncTexture::Ready;
+				return request;
+			}
+		}
+
+		// share the pending request
+		for (CAsyncTexture* request : m_asyncQueue)
+		{
+			if (request->m_path == realPath)
+			{
+				if (priority > request->m_priority)
+					request->m_priority = priority;
+				request->m_holders++;
+				request->grab();
+				return request;
+			}
+		}
+
+		for (CAsyncTexture* request : m_asyncLoading)
+		{
+			if (request->m_path == realPath && !request->m_cancel)
+			{
+				request->m_holders++;
+				request->grab();
+				return request;
+			}
+		}
+
+		// the queue holds a reference, and the caller holds the other
+		CAsyncTexture* request = new CAsyncTexture(realPath.c_str(), m_currentPackage.c_str(), priority, m_asyncOrder++);
+		request->grab();
+		m_asyncQueue.push_back(request);
+		return request;
+	}
+
+	void CTextureManager::setAsyncTexturePriority(CAsyncTexture* request, int priority)
+	{
+		request->m_priority = priority;
+	}
+
+	void CTextureManager::cancelTextureAsync(CAsyncTexture* request)
+	{
+		if (request->isFinished())
+			return;
+
+		// the request is shared, the other holders still wait for it
+		if (--request->m_holders > 0)
+			return;
+
+		request->m_cancel = true;
+
+		for (u32 i = 0, n = (u32)m_asyncQueue.size(); i < n; i++)
+		{
+			if (m_asyncQueue[i] == request)
+			{
+				m_asyncQueue.erase(m_asyncQueue.begin() + i);
+				request->m_state = CAsyncTexture::Cancelled;
+				request->drop();
+				return;
+			}
+		}
+
+		// the decoding request is discarded in updateAsyncTexture
+	}
+
+	io::IReadFile* CTextureManager::readAsyncFile(const char* path)
+	{
+		// the file system (and the mounted archives) is not thread safe, so the bytes are read here on the main thread
+		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+
+		io::IReadFile* file = fs->createAndOpenFile(path);
+		if (file == NULL)
+			return NULL;
+
+		u8* data = NULL;
+		s32 size = (s32)file->getSize();
+		if (size > 0)
+		{
+			data = new u8[size];
+			if (file->read(data, size) != size)
+			{
+				delete[] data;
+				data = NULL;
+			}
+		}
+		file->drop();
+
+		if (data == NULL)
+			return NULL;
+
+		return fs->createMemoryReadFile(data, size, path, true);
+	}
+
+	void CTextureManager::decodeAsyncTexture(CAsyncTexture* request)
+	{
+		if (request->m_cancel)
+		{
+			request->m_state.store(CAsyncTexture::Failed, std::memory_order_release);
+			return;
+		}
+
+		request->m_image = getVideoDriver()->createImageFromFile(request->m_file);
+
+		request->m_state.store(request->m_image ? CAsyncTexture::Decoded : CAsyncTexture::Failed, std::memory_order_release);
+	}
+
+	bool CTextureManager::uploadAsyncTexture(CAsyncTexture* request)
+	{
+		IVideoDriver* driver = getVideoDriver();
+		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+
+		// same name as driver->getTexture, the texture may be loaded by getTexture while decoding
+		io::path name = fs->getAbsolutePath(request->m_path.c_str());
+
+		ITexture* texture = driver->findTexture(name);
+		if (texture == NULL)
+			texture = driver->addTexture(name, request->m_image);
+
+		request->m_image->drop();
+		request->m_image = NULL;
+
+		if (texture == NULL)
+		{
+			char errorLog[512];
+			sprintf(errorLog, "Can not load texture: %s", request->m_path.c_str());
+			os::Printer::log(errorLog);
+			return false;
+		}
+
+		registerTexture(texture, request->m_path.c_str(), request->m_package.c_str());
+		request->m_texture = texture;
+		return true;
+	}
+
+	void CTextureManager::updateAsyncTexture()
+	{
+		if (m_asyncQueue.size() == 0 && m_asyncLoading.size() == 0)
+			return;
+
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+
+		// dispatch the highest priority requests, the older first
+		while (m_asyncQueue.size() > 0 && (int)m_asyncLoading.size() < m_maxAsyncDecode)
+		{
+			u32 best = 0;
+			for (u32 i = 1, n = (u32)m_asyncQueue.size(); i < n; i++)
+			{
+				CAsyncTexture* r = m_asyncQueue[i];
+				CAsyncTexture* b = m_asyncQueue[best];
+				if (r->m_priority > b->m_priority || (r->m_priority == b->m_priority && r->m_order < b->m_order))
+					best = i;
+			}
+
+			CAsyncTexture* request = m_asyncQueue[best];
+			m_asyncQueue.erase(m_asyncQueue.begin() + best);
+
+			request->m_file = readAsyncFile(request->m_path.c_str());
+			if (request->m_file == NULL)
+			{
+				char errorLog[512];
+				sprintf(errorLog, "Can not load texture: %s", request->m_path.c_str());
+				os::Printer::log(errorLog);
+
+				request->m_state = CAsyncTexture::Failed;
+				request->drop();
+				continue;
+			}
+
+			request->m_state = CAsyncTexture::Loading;
+			m_asyncLoading.push_back(request);
+
+			request->m_job = scheduler->run([this, request]()
+				{
+					decodeAsyncTexture(request);
+				});
+		}
+
+		// create the decoded textures within the upload budget
+		u32 uploadBytes = 0;
+		u32 numUpload = 0;
+
+		for (u32 i = 0; i < (u32)m_asyncLoading.size(); )
+		{
+			CAsyncTexture* request = m_asyncLoading[i];
+
+			int state = request->m_state.load(std::memory_order_acquire);
+			if (state == CAsyncTexture::Loading || !request->m_job.isFinished())
+			{
+				i++;
+				continue;
+			}
+
+			// the file bytes are decoded
+			if (request->m_file)
+			{
+				request->m_file->drop();
+				request->m_file = NULL;
+			}
+
+			if (request->m_cancel)
+			{
+				if (request->m_image)
+				{
+					request->m_image->drop();
+					request->m_image = NULL;
+				}
+				request->m_state = CAsyncTexture::Cancelled;
+			}
+			else if (state == CAsyncTexture::Decoded)
+			{
+				if (numUpload > 0 && uploadBytes >= m_asyncUploadBudget)
+				{
+					i++;
+					continue;
+				}
+
+				uploadBytes += request->m_image->getImageDataSizeInBytes();
+				numUpload++;
+
+				request->m_state = uploadAsyncTexture(request) ? CAsyncTexture::Ready : CAsyncTexture::Failed;
+			}
+			else
+			{
+				char errorLog[512];
+				sprintf(errorLog, "Can not load texture: %s", request->m_path.c_str());
+				os::Printer::log(errorLog);
+			}
+
+			m_asyncLoading.erase(m_asyncLoading.begin() + i);
+			request->drop();
+		}
+	}
+
+	void CTextureManager::finishAsyncTexture()
+	{
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+
+		u32 budget = m_asyncUploadBudget;
+		m_asyncUploadBudget = 0xFFFFFFFF;
+
+		while (getNumAsyncTexture() > 0)
+		{
+			for (CAsyncTexture* request : m_asyncLoading)
+				scheduler->wait(request->m_job);
+
+			updateAsyncTexture();
+		}
+
+		m_asyncUploadBudget = budget;
+	}
+
+	void CTextureManager::cancelAllAsyncTexture()
+	{
+		for (CAsyncTexture* request : m_asyncQueue)
+		{
+			request->m_cancel = true;
+			request->m_state = CAsyncTexture::Cancelled;
+			request->drop();
+		}
+		m_asyncQueue.clear();
+
+		if (m_asyncLoading.size() == 0)
+			return;
+
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+		for (CAsyncTexture* request : m_asyncLoading)
+		{
+			request->m_cancel = true;
+			scheduler->wait(request->m_job);
+
+			if (request->m_image)
+			{
+				request->m_image->drop();
+				request->m_image = NULL;
+			}
+
+			request->m_state = CAsyncTexture::Cancelled;
+			request->drop();
+		}
+		m_asyncLoading.clear();
+	}
+
 	ITexture* CTextureManager::getTextureArray(std::vector<std::string>& listTexture)
 	{
 		IVideoDriver* driver = getVideoDriver();
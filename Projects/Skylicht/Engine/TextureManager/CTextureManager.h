@@ -28,6 +28,8 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "Utils/CSingleton.h"
 #include "Utils/CStringImp.h"
+#include "CAsyncTexture.h"
+
 
 namespace Skylicht
 {
@@ -87,6 +89,20 @@ namespace Skylicht
 		/// Default null texture.
 		ITexture* m_nullTexture;
 
+		/// The async requests that wait to be decoded.
+		std::vector<CAsyncTexture*> m_asyncQueue;
+
+		/// The async requests that are decoding on the job threads or wait to upload.
+		std::vector<CAsyncTexture*> m_asyncLoading;
+
+		u32 m_asyncOrder;
+
+		/// Maximum number of the images that decode at the same time.
+		int m_maxAsyncDecode;
+
+		/// Maximum image bytes that are uploaded to the gpu per frame.
+		u32 m_asyncUploadBudget;
+
 	public:
 		/**
 		 * @brief Constructor.
@@ -190,6 +206,65 @@ namespace Skylicht
 		 */
 		ITexture* getTexture(const char* filename, const std::vector<std::string>& folders);
 
+		/**
+		 * @brief Request a texture that is decoded on the job threads.
+		 * The texture is created in updateAsyncTexture, and it is registered in the current package.
+		 * The requests of the same path share one handle.
+		 * @param path Texture file path.
+		 * @param priority The request with higher priority is decoded first.
+		 * @return The handle of the request (call drop() when it is not used), or NULL if the file is not found.
+		 */
+		CAsyncTexture* getTextureAsync(const char* path, int priority = 0);
+
+		/**
+		 * @brief Change the priority of a request that is still queued.
+		 * @param request The async request.
+		 * @param priority New priority.
+		 */
+		void setAsyncTexturePriority(CAsyncTexture* request, int priority);
+
+		/**
+		 * @brief Cancel an async request, the decoding image will be discarded.
+		 * A shared request is cancelled when all its holders have cancelled it.
+		 * @param request The async request.
+		 */
+		void cancelTextureAsync(CAsyncTexture* request);
+
+		/**
+		 * @brief Dispatch the queued requests to the job threads and create the decoded textures within the upload budget.
+		 * It is called each frame by updateSkylicht.
+		 */
+		void updateAsyncTexture();
+
+		/**
+		 * @brief Wait and create all the pending async textures.
+		 */
+		void finishAsyncTexture();
+
+		/**
+		 * @brief Get the number of the async requests that are not finished.
+		 */
+		inline u32 getNumAsyncTexture()
+		{
+			return (u32)(m_asyncQueue.size() + m_asyncLoading.size());
+		}
+
+		/**
+		 * @brief Set the maximum number of the images that decode at the same time.
+		 */
+		inline void setMaxAsyncDecode(int num)
+		{
+			m_maxAsyncDecode = core::max_(num, 1);
+		}
+
+		/**
+		 * @brief Set the maximum image bytes that are uploaded per frame, at least one texture is uploaded per frame.
+		 */
+		inline void setAsyncUploadBudget(u32 bytes)
+		{
+			m_asyncUploadBudget = bytes;
+		}
+
 		/**
 		* @brief Get texture using the real file path.
 		* @param path Real file path.
@@ -279,6 +354,22 @@ namespace Skylicht
 		 * @param path File path of the texture.
 		 */
 		void registerTexture(ITexture* tex, const char* path);
+
+		/**
+		 * @brief Register a texture with the manager in a package.
+		 * @param tex Pointer to texture.
+		 * @param path File path of the texture.
+		 * @param package Name of the package.
+		 */
+		void registerTexture(ITexture* tex, const char* path, const char* package);
+
+		io::IReadFile* readAsyncFile(const char* path);
+
+		void decodeAsyncTexture(CAsyncTexture* request);
+
+		bool uploadAsyncTexture(CAsyncTexture* request);
+
+		void cancelAllAsyncTexture();
 	};
 
 }
\ No newline at end of file
@@ -29,7 +29,8 @@ https://github.com/skylicht-lab/skylicht-engine
 namespace Skylicht
 {
 	CGroupTransform::CGroupTransform(CEntityGroup* parent) :
-		CEntityGroup(NULL, 0)
+		CEntityGroup(NULL, 0),
+		m_needRebuild(true)
 	{
 		m_parentGroup = parent;
 		m_dataTypes.push_back(DATA_TYPE_INDEX(CWorldTransformData));
@@ -40,43 +41,85 @@ namespace Skylicht
 
 	}
 
-	void CGroupTransform::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
+	void CGroupTransform::rebuildHierarchy(CEntityManager* entityManager, CEntity** entities, int numEntity)
 	{
 		CEntity** allEntities = entityManager->getEntities();
 
+		m_hierarchyEntities.reset();
+		m_hierarchy.reset();
+
+		CEntity* entity;
+		CWorldTransformData* transform;
+		int parentID;
+
+		for (int i = 0; i < numEntity; i++)
+		{
+			entity = entities[i];
+			transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+
+			parentID = transform->AttachParentIndex >= 0 ?
+				transform->AttachParentIndex :
+				transform->ParentIndex;
+
+			if (parentID != -1)
+			{
+				transform->Parent = GET_ENTITY_DATA(allEntities[parentID], CWorldTransformData);
+				transform->Depth = transform->Parent->Depth + 1;
+			}
+			else
+			{
+				transform->Parent = NULL;
+				transform->Depth = 0;
+			}
+
+			m_hierarchyEntities.push(entity);
+			m_hierarchy.push(transform);
+		}
+
+		m_needRebuild = false;
+	}
+
+	void CGroupTransform::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
+	{
 		if (m_parentGroup)
 		{
 			numEntity = m_parentGroup->getEntityCount();
 			entities = m_parentGroup->getEntities();
+
+			// the visible entities are changed (add/remove/reparent)
+			if (m_parentGroup->needValidate())
+				m_needRebuild = true;
+		}
+		else
+		{
+			m_needRebuild = true;
 		}
 
+		if (m_needRebuild)
+			rebuildHierarchy(entityManager, entities, numEntity);
+
 		m_entities.reset();
 		m_roots.reset();
 		m_childs.reset();
+		m_childLevels.reset();
 		m_lateUpdate.reset();
 
-		CEntity* entity;
+		CEntity** hierarchyEntities = m_hierarchyEntities.pointer();
+		CWorldTransformData** hierarchy = m_hierarchy.pointer();
+		numEntity = m_hierarchy.count();
+
 		CWorldTransformData* transform;
-		int parentID;
 
 		for (int i = 0; i < numEntity; i++)
 		{
-			entity = entities[i];
-			transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+			transform = hierarchy[i];
 
 			// set disable flag
 			transform->NeedValidate = false;
 			transform->NeedValidateForLate = false;
 
-			parentID = transform->AttachParentIndex >= 0 ?
-				transform->AttachParentIndex :
-				transform->ParentIndex;
-
-			if (parentID != -1)
+			if (transform->Parent)
 			{
-				transform->Parent = GET_ENTITY_DATA(allEntities[parentID], CWorldTransformData);
-				transform->Depth = transform->Parent->Depth + 1;
-
 				// this transform changed because parent is changed
 				if (transform->Parent->NeedValidate)
 					transform->HasChanged = true;
@@ -84,11 +127,6 @@ namespace Skylicht
 				if (transform->Parent->NeedValidateForLate)
 					transform->HasLateChanged = true;
 			}
-			else
-			{
-				transform->Parent = NULL;
-				transform->Depth = 0;
-			}
 
 			// tag to update list
 			if (transform->HasChanged)
@@ -96,12 +134,17 @@ namespace Skylicht
 				// set enable flag for another system
 				transform->NeedValidate = true;
 
-				m_entities.push(entity);
+				m_entities.push(hierarchyEntities[i]);
 
 				if (transform->Depth == 0 || transform->IsWorldTransform)
 					m_roots.push(transform);
 				else
+				{
+					if (m_childs.count() == 0 || m_childs.pointer()[m_childs.count() - 1]->Depth != transform->Depth)
+						m_childLevels.push(m_childs.count());
+
 					m_childs.push(transform);
+				}
 
 				transform->HasChanged = false;
 			}
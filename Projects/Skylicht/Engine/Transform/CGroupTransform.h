@@ -28,12 +28,27 @@ https://github.com/skylicht-lab/skylicht-engine
 
 namespace Skylicht
 {
+	/// @brief The group of transforms that changed in this frame.
+	/**
+	 * The hierarchy (parent link, depth) is cached and only rebuilt when the parent group is queried again.
+	 * Each frame, only the transforms that HasChanged (or have a changed ancestor) are listed to roots/childs,
+	 * and getEntities() returns the entities of the changed transforms.
+	 */
 	class SKYLICHT_API CGroupTransform : public CEntityGroup
 	{
 	protected:
 		CFastArray<CWorldTransformData*> m_roots;
 		CFastArray<CWorldTransformData*> m_childs;
 		CFastArray<CWorldTransformData*> m_lateUpdate;
+
+		// start index of each depth level in m_childs
+		CFastArray<int> m_childLevels;
+
+		// cached hierarchy, sorted by depth
+		CFastArray<CEntity*> m_hierarchyEntities;
+		CFastArray<CWorldTransformData*> m_hierarchy;
+		bool m_needRebuild;
+
 	public:
 		CGroupTransform(CEntityGroup* parent);
 
@@ -59,6 +74,18 @@ namespace Skylicht
 			return m_childs.pointer();
 		}
 
+		/// @brief The childs are sorted by depth, the transforms in a same level do not depend on each other.
+		inline int getNumChildLevels()
+		{
+			return m_childLevels.count();
+		}
+
+		/// @brief The start index in getChilds() of a depth level, the level ends at the start of next level (or getNumChilds).
+		inline int getChildLevelBegin(int level)
+		{
+			return m_childLevels.pointer()[level];
+		}
+
 		inline CWorldTransformData** getLateUpdate()
 		{
 			return m_lateUpdate.pointer();
@@ -69,6 +96,20 @@ namespace Skylicht
 			return m_lateUpdate.count();
 		}
 
+		inline CEntity** getChangedEntities()
+		{
+			return m_entities.pointer();
+		}
+
+		inline int getChangedCount()
+		{
+			return m_entities.count();
+		}
+
 		virtual void onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity);
+
+	protected:
+
+		void rebuildHierarchy(CEntityManager* entityManager, CEntity** entities, int numEntity);
 	};
 }
\ No newline at end of file
@@ -27,11 +27,14 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Entity/CEntityManager.h"
 #include "Culling/CVisibleData.h"
 #include "Transform/CTransform.h"
+#include "Transform/CWorldTransformSystem.h"
+#include "Utils/CMatrixBatch.h"
 
 namespace Skylicht
 {
 	CWorldInverseTransformSystem::CWorldInverseTransformSystem() :
-		m_group(NULL)
+		m_group(NULL),
+		m_groupTransform(NULL)
 	{
 	}
 
@@ -46,6 +49,13 @@ namespace Skylicht
 			const u32 type[] = GET_LIST_ENTITY_DATA(CWorldInverseTransformData);
 			m_group = entityManager->createGroupFromVisible(type, 1);
 		}
+
+		if (m_groupTransform == NULL)
+		{
+			CWorldTransformSystem* transformSystem = entityManager->getSystem<CWorldTransformSystem>();
+			if (transformSystem)
+				m_groupTransform = transformSystem->getGroupTransform();
+		}
 	}
 
 	void CWorldInverseTransformSystem::onQuery(CEntityManager* entityManager, CEntity** entities, int numEntity)
@@ -63,18 +73,53 @@ namespace Skylicht
 		CEntity** entities = m_group->getEntities();
 		int numEntity = m_group->getEntityCount();
 
-		for (int i = 0; i < numEntity; i++)
+		// only visit the transforms that changed in this frame
+		if (m_groupTransform && m_groupTransform->getChangedCount() < numEntity)
 		{
-			CEntity* entity = entities[i];
+			CEntity** changed = m_groupTransform->getChangedEntities();
+			int numChanged = m_groupTransform->getChangedCount();
+
+			for (int i = 0; i < numChanged; i++)
+			{
+				CEntity* entity = changed[i];
+
+				CWorldInverseTransformData* worldInv = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
+				if (worldInv)
+				{
+					CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+					CMatrixBatch::inverse(world->World, worldInv->WorldInverse);
+				}
+			}
+			return;
+		}
 
-			CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
-			CWorldInverseTransformData* worldInv = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
+		// iterate the inverse data by the chunk spans
+		const core::array<CEntityGroup::SDataSpan>& spans = m_group->getDataSpans(DATA_TYPE_INDEX(CWorldInverseTransformData));
 
-			if (world->NeedValidate)
+		for (u32 i = 0, n = spans.size(); i < n; i++)
+		{
+			const CEntityGroup::SDataSpan& span = spans[i];
+
+			for (u32 j = 0; j < span.Count; j++)
 			{
-				// Get inverse matrix of world
-				world->World.getInverse(worldInv->WorldInverse);
+				CEntity* entity = entities[span.Begin + j];
+
+				CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+				if (world->NeedValidate)
+				{
+					CWorldInverseTransformData* worldInv = (CWorldInverseTransformData*)(IEntityData*)(span.Data + j * span.Stride);
+
+					// Get inverse matrix of world
+					CMatrixBatch::inverse(world->World, worldInv->WorldInverse);
+				}
 			}
 		}
 	}
+
+	bool CWorldInverseTransformSystem::getDataAccess(u64& read, u64& write)
+	{
+		read = DATA_TYPE_MASK(CWorldTransformData);
+		write = DATA_TYPE_MASK(CWorldInverseTransformData);
+		return true;
+	}
 }
\ No newline at end of file
@@ -28,6 +28,12 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Entity/CEntityManager.h"
 #include "Transform/CTransform.h"
 #include "Culling/CVisibleData.h"
+#include "Utils/CMatrixBatch.h"
+#include "Job/CJobScheduler.h"
+
+// the depth level that have more transforms will be split to the job threads
+#define PARALLEL_TRANSFORM_LEVEL 2048
+#define PARALLEL_TRANSFORM_GRAIN 512
 
 namespace Skylicht
 {
@@ -93,14 +99,29 @@ namespace Skylicht
 		transforms = m_groupTransform->getChilds();
 		numEntity = m_groupTransform->getNumChilds();
 
-		for (int i = 0; i < numEntity; i++)
+		// calc world = parent * relative
+		// - relative is copied from CTransformComponentSystem
+		// - relative is also defined in CEntityPrefab
+		// the childs are sorted by depth, so the parents are always updated before the level of their childs
+		int numLevel = m_groupTransform->getNumChildLevels();
+		for (int level = 0; level < numLevel; level++)
 		{
-			CWorldTransformData* t = transforms[i];
-
-			// calc world = parent * relative
-			// - relative is copied from CTransformComponentSystem
-			// - relative is also defined in CEntityPrefab
-			t->World.setbyproduct_nocheck(t->Parent->World, t->Relative);
+			int begin = m_groupTransform->getChildLevelBegin(level);
+			int end = level + 1 < numLevel ? m_groupTransform->getChildLevelBegin(level + 1) : numEntity;
+
+			if (end - begin >= PARALLEL_TRANSFORM_LEVEL)
+			{
+				System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+				scheduler->parallelFor(begin, end, PARALLEL_TRANSFORM_GRAIN,
+					[transforms](int from, int to)
+					{
+						updateChilds(transforms, from, to);
+					});
+			}
+			else
+			{
+				updateChilds(transforms, begin, end);
+			}
 		}
 
 		lateUpdate(entityManager);
@@ -115,10 +136,15 @@ namespace Skylicht
 		// late update: recalculate the world transform after late update
 		CWorldTransformData** transforms = m_groupTransform->getLateUpdate();
 		int numEntity = m_groupTransform->getLateUpdateCount();
-		for (int i = 0; i < numEntity; i++)
+		updateChilds(transforms, 0, numEntity);
+	}
+
+	void CWorldTransformSystem::updateChilds(CWorldTransformData** transforms, int from, int to)
+	{
+		for (int i = from; i < to; i++)
 		{
 			CWorldTransformData* t = transforms[i];
-			t->World.setbyproduct_nocheck(t->Parent->World, t->Relative);
+			CMatrixBatch::multiply(t->World, t->Parent->World, t->Relative);
 		}
 	}
 }
\ No newline at end of file
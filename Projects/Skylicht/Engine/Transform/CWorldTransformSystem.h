@@ -56,5 +56,17 @@ namespace Skylicht
 		virtual void update(CEntityManager* entityManager);
 
 		virtual void lateUpdate(CEntityManager* entityManager);
+
+	protected:
+
+		static void updateChilds(CWorldTransformData** transforms, int from, int to);
+
+	public:
+
+		/// @brief The group that lists the entities whose transform changed in this frame.
+		inline CGroupTransform* getGroupTransform()
+		{
+			return m_groupTransform;
+		}
 	};
 }
\ No newline at end of file
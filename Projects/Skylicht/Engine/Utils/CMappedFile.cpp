@@ -0,0 +1,187 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CMappedFile.h"
+
+#if defined(_WIN32)
+#include <Windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Skylicht
+{
+	CMappedFile::CMappedFile() :
+		m_data(NULL),
+		m_size(0),
+		m_mapped(false)
+	{
+#if defined(_WIN32)
+		m_file = INVALID_HANDLE_VALUE;
+		m_mapping = NULL;
+#endif
+	}
+
+	CMappedFile::~CMappedFile()
+	{
+		close();
+	}
+
+	bool CMappedFile::open(const char* path)
+	{
+		close();
+
+		io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+
+		// the archives override the files on disk, same order of IFileSystem::createAndOpenFile
+		for (u32 i = 0, n = fs->getFileArchiveCount(); i < n; i++)
+		{
+			io::IReadFile* file = fs->getFileArchive(i)->createAndOpenFile(path);
+			if (file != NULL)
+				return read(file);
+		}
+
+		// the file on disk
+		io::path absolutePath = fs->getAbsolutePath(path);
+		if (map(absolutePath.c_str()))
+			return true;
+
+		// the empty file or the platform that does not support the mapping
+		io::IReadFile* file = fs->createAndOpenFile(path);
+		if (file == NULL)
+			return false;
+
+		return read(file);
+	}
+
+	bool CMappedFile::read(io::IReadFile* file)
+	{
+		m_size = (u32)file->getSize();
+		m_data = new u8[m_size > 0 ? m_size : 1];
+
+		bool result = file->read(m_data, m_size) == (s32)m_size;
+		file->drop();
+
+		if (!result)
+		{
+			close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void CMappedFile::close()
+	{
+		if (m_mapped)
+			unmap();
+		else if (m_data)
+			delete[] m_data;
+
+		m_data = NULL;
+		m_size = 0;
+		m_mapped = false;
+	}
+
+	bool CMappedFile::map(const char* path)
+	{
+#if defined(_WIN32) && !defined(WINDOWS_STORE)
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0 || size.QuadPart > 0xFFFFFFFF)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping == NULL)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == NULL)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_file = file;
+		m_mapping = mapping;
+		m_data = (u8*)data;
+		m_size = (u32)size.QuadPart;
+		m_mapped = true;
+		return true;
+#elif !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+		int fd = ::open(path, O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0 || (u64)info.st_size > 0xFFFFFFFF)
+		{
+			::close(fd);
+			return false;
+		}
+
+		void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		// the mapping keeps the file
+		::close(fd);
+
+		if (data == MAP_FAILED)
+			return false;
+
+		m_data = (u8*)data;
+		m_size = (u32)info.st_size;
+		m_mapped = true;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void CMappedFile::unmap()
+	{
+#if defined(_WIN32) && !defined(WINDOWS_STORE)
+		UnmapViewOfFile(m_data);
+		CloseHandle((HANDLE)m_mapping);
+		CloseHandle((HANDLE)m_file);
+		m_mapping = NULL;
+		m_file = INVALID_HANDLE_VALUE;
+#elif !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+		munmap(m_data, m_size);
+#endif
+	}
+}
@@ -0,0 +1,97 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+namespace Skylicht
+{
+	/**
+	 * @brief Read only view of a file, the file on disk is memory-mapped.
+	 * @ingroup Utilities
+	 *
+	 * The path is looked up in the file archives first, like IFileSystem::createAndOpenFile, the file in an archive
+	 * (or on the platform that does not support the mapping) is read to a memory buffer.
+	 * The data is valid until the object is destroyed or close() is called.
+	 *
+	 * @code
+	 * CMappedFile file;
+	 * if (file.open("SampleModels/Model.smesh"))
+	 * {
+	 *	CMemoryStream stream((unsigned char*)file.getData(), file.getSize());
+	 *	...
+	 * }
+	 * @endcode
+	 */
+	class SKYLICHT_API CMappedFile
+	{
+	protected:
+		u8* m_data;
+		u32 m_size;
+		bool m_mapped;
+
+#if defined(_WIN32)
+		void* m_file;
+		void* m_mapping;
+#endif
+
+	public:
+		CMappedFile();
+
+		virtual ~CMappedFile();
+
+		/**
+		 * @brief Map a file, the path is resolved by the Irrlicht file system.
+		 * @param path File path.
+		 * @return True if the file is opened.
+		 */
+		bool open(const char* path);
+
+		void close();
+
+		inline const u8* getData()
+		{
+			return m_data;
+		}
+
+		inline u32 getSize()
+		{
+			return m_size;
+		}
+
+		/// @brief False if the file is read to a memory buffer.
+		inline bool isMapped()
+		{
+			return m_mapped;
+		}
+
+	protected:
+
+		bool map(const char* path);
+
+		/// @brief Read the file to a memory buffer and drop it.
+		bool read(io::IReadFile* file);
+
+		void unmap();
+	};
+}
@@ -0,0 +1,159 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CMatrixBatch.h"
+
+namespace Skylicht
+{
+	void CMatrixBatch::multiply(core::matrix4* out, const core::matrix4* a, const core::matrix4* b, int count)
+	{
+		for (int i = 0; i < count; i++)
+			multiply(out[i], a[i], b[i]);
+	}
+
+	void CMatrixBatch::multiplyScalar(core::matrix4* out, const core::matrix4* a, const core::matrix4* b, int count)
+	{
+		for (int i = 0; i < count; i++)
+			out[i].setbyproduct_nocheck(a[i], b[i]);
+	}
+
+	bool CMatrixBatch::inverse(const core::matrix4& mat, core::matrix4& out)
+	{
+		const f32* m = mat.pointer();
+
+		// projection or other non-affine matrix
+		if (m[3] != 0.0f || m[7] != 0.0f || m[11] != 0.0f || m[15] != 1.0f)
+			return mat.getInverse(out);
+
+		// The affine matrix: v' = v * A + t
+		// A^-1 have the columns: r1 x r2, r2 x r0, r0 x r1 (divided by det)
+		// and the translation is -t * A^-1
+
+#if defined(SKYLICHT_SIMD_SSE)
+		__m128 r0 = _mm_loadu_ps(m);
+		__m128 r1 = _mm_loadu_ps(m + 4);
+		__m128 r2 = _mm_loadu_ps(m + 8);
+
+#define SK_SHUFFLE_YZX(v) _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1))
+#define SK_SHUFFLE_ZXY(v) _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2))
+#define SK_CROSS(a, b) _mm_sub_ps(_mm_mul_ps(SK_SHUFFLE_YZX(a), SK_SHUFFLE_ZXY(b)), _mm_mul_ps(SK_SHUFFLE_ZXY(a), SK_SHUFFLE_YZX(b)))
+
+		__m128 c0 = SK_CROSS(r1, r2);
+		__m128 c1 = SK_CROSS(r2, r0);
+		__m128 c2 = SK_CROSS(r0, r1);
+
+#undef SK_CROSS
+#undef SK_SHUFFLE_ZXY
+#undef SK_SHUFFLE_YZX
+
+		f32 d[4];
+		_mm_storeu_ps(d, _mm_mul_ps(r0, c0));
+		f32 det = d[0] + d[1] + d[2];
+
+		if (core::iszero(det, FLT_MIN))
+			return false;
+
+		__m128 c3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+		__m128 invDet = _mm_set1_ps(1.0f / det);
+		c0 = _mm_mul_ps(c0, invDet);
+		c1 = _mm_mul_ps(c1, invDet);
+		c2 = _mm_mul_ps(c2, invDet);
+
+		__m128 t = _mm_mul_ps(c0, _mm_set1_ps(m[12]));
+		t = _mm_add_ps(t, _mm_mul_ps(c1, _mm_set1_ps(m[13])));
+		t = _mm_add_ps(t, _mm_mul_ps(c2, _mm_set1_ps(m[14])));
+		t = _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), t);
+
+		f32* o = out.pointer();
+		_mm_storeu_ps(o, c0);
+		_mm_storeu_ps(o + 4, c1);
+		_mm_storeu_ps(o + 8, c2);
+		_mm_storeu_ps(o + 12, t);
+#else
+		f32 c0[3], c1[3], c2[3];
+
+		// c0 = r1 x r2
+		c0[0] = m[5] * m[10] - m[6] * m[9];
+		c0[1] = m[6] * m[8] - m[4] * m[10];
+		c0[2] = m[4] * m[9] - m[5] * m[8];
+
+		// c1 = r2 x r0
+		c1[0] = m[9] * m[2] - m[10] * m[1];
+		c1[1] = m[10] * m[0] - m[8] * m[2];
+		c1[2] = m[8] * m[1] - m[9] * m[0];
+
+		// c2 = r0 x r1
+		c2[0] = m[1] * m[6] - m[2] * m[5];
+		c2[1] = m[2] * m[4] - m[0] * m[6];
+		c2[2] = m[0] * m[5] - m[1] * m[4];
+
+		f32 det = m[0] * c0[0] + m[1] * c0[1] + m[2] * c0[2];
+		if (core::iszero(det, FLT_MIN))
+			return false;
+
+		f32 invDet = 1.0f / det;
+		f32 tx = m[12], ty = m[13], tz = m[14];
+
+		f32* o = out.pointer();
+		for (int i = 0; i < 3; i++)
+		{
+			o[i * 4] = c0[i] * invDet;
+			o[i * 4 + 1] = c1[i] * invDet;
+			o[i * 4 + 2] = c2[i] * invDet;
+			o[i * 4 + 3] = 0.0f;
+		}
+
+		o[12] = -(tx * o[0] + ty * o[4] + tz * o[8]);
+		o[13] = -(tx * o[1] + ty * o[5] + tz * o[9]);
+		o[14] = -(tx * o[2] + ty * o[6] + tz * o[10]);
+		o[15] = 1.0f;
+#endif
+		return true;
+	}
+
+	int CMatrixBatch::inverse(const core::matrix4* m, core::matrix4* out, int count)
+	{
+		int failed = 0;
+		for (int i = 0; i < count; i++)
+		{
+			if (!inverse(m[i], out[i]))
+				failed++;
+		}
+		return failed;
+	}
+
+	int CMatrixBatch::inverseScalar(const core::matrix4* m, core::matrix4* out, int count)
+	{
+		int failed = 0;
+		for (int i = 0; i < count; i++)
+		{
+			if (!m[i].getInverse(out[i]))
+				failed++;
+		}
+		return failed;
+	}
+}
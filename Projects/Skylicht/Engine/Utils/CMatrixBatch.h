@@ -0,0 +1,113 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "SIMD.h"
+
+namespace Skylicht
+{
+	/**
+	 * @brief Batched 4x4 matrix kernels with SSE/AVX2/NEON code path.
+	 * @ingroup Utilities
+	 *
+	 * The result is the same as core::matrix4::setbyproduct_nocheck and core::matrix4::getInverse,
+	 * the matrices do not need to be aligned.
+	 *
+	 * @code
+	 * // world = parent * relative
+	 * CMatrixBatch::multiply(t->World, t->Parent->World, t->Relative);
+	 *
+	 * // batched: out[i] = a[i] * b[i]
+	 * CMatrixBatch::multiply(out, a, b, count);
+	 * @endcode
+	 */
+	class SKYLICHT_API CMatrixBatch
+	{
+	public:
+		/// @brief out = a * b. out must not be a or b.
+		static inline void multiply(core::matrix4& out, const core::matrix4& a, const core::matrix4& b)
+		{
+			const f32* m1 = a.pointer();
+			const f32* m2 = b.pointer();
+			f32* m = out.pointer();
+
+#if defined(SKYLICHT_SIMD_SSE)
+			__m128 c0 = _mm_loadu_ps(m1);
+			__m128 c1 = _mm_loadu_ps(m1 + 4);
+			__m128 c2 = _mm_loadu_ps(m1 + 8);
+			__m128 c3 = _mm_loadu_ps(m1 + 12);
+
+			for (int i = 0; i < 16; i += 4)
+			{
+#if defined(SKYLICHT_SIMD_AVX2)
+				__m128 r = _mm_mul_ps(c0, _mm_set1_ps(m2[i]));
+				r = _mm_fmadd_ps(c1, _mm_set1_ps(m2[i + 1]), r);
+				r = _mm_fmadd_ps(c2, _mm_set1_ps(m2[i + 2]), r);
+				r = _mm_fmadd_ps(c3, _mm_set1_ps(m2[i + 3]), r);
+#else
+				__m128 r = _mm_mul_ps(c0, _mm_set1_ps(m2[i]));
+				r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(m2[i + 1])));
+				r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(m2[i + 2])));
+				r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(m2[i + 3])));
+#endif
+				_mm_storeu_ps(m + i, r);
+			}
+#elif defined(SKYLICHT_SIMD_NEON)
+			float32x4_t c0 = vld1q_f32(m1);
+			float32x4_t c1 = vld1q_f32(m1 + 4);
+			float32x4_t c2 = vld1q_f32(m1 + 8);
+			float32x4_t c3 = vld1q_f32(m1 + 12);
+
+			for (int i = 0; i < 16; i += 4)
+			{
+				float32x4_t r = vmulq_n_f32(c0, m2[i]);
+				r = vmlaq_n_f32(r, c1, m2[i + 1]);
+				r = vmlaq_n_f32(r, c2, m2[i + 2]);
+				r = vmlaq_n_f32(r, c3, m2[i + 3]);
+				vst1q_f32(m + i, r);
+			}
+#else
+			out.setbyproduct_nocheck(a, b);
+#endif
+		}
+
+		/// @brief out[i] = a[i] * b[i]
+		static void multiply(core::matrix4* out, const core::matrix4* a, const core::matrix4* b, int count);
+
+		/// @brief Scalar version of multiply (core::matrix4::setbyproduct_nocheck), used to compare the result and the speed.
+		static void multiplyScalar(core::matrix4* out, const core::matrix4* a, const core::matrix4* b, int count);
+
+		/// @brief Inverse the matrix, the affine matrix (last column is 0, 0, 0, 1) use the fast path.
+		/// @return false if the matrix is not invertible, out is not changed.
+		static bool inverse(const core::matrix4& m, core::matrix4& out);
+
+		/// @brief out[i] = inverse(m[i])
+		/// @return number of the matrices that is not invertible.
+		static int inverse(const core::matrix4* m, core::matrix4* out, int count);
+
+		/// @brief Scalar version of inverse (core::matrix4::getInverse)
+		static int inverseScalar(const core::matrix4* m, core::matrix4* out, int count);
+	};
+}
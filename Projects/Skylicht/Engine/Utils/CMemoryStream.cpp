@@ -92,6 +92,18 @@ namespace Skylicht
 		m_size += size;
 	}
 
+	void CMemoryStream::writePadding(unsigned int alignment, unsigned int baseOffset)
+	{
+		unsigned int remain = (baseOffset + m_size) % alignment;
+		if (remain == 0)
+			return;
+
+		unsigned int size = alignment - remain;
+		autoGrow(size);
+		memset(&m_memory[m_size], 0, size);
+		m_size += size;
+	}
+
 	void CMemoryStream::writeStream(CMemoryStream* stream)
 	{
 		writeData(stream->getData(), stream->getSize());
@@ -286,6 +298,13 @@ namespace Skylicht
 		m_pos += size;
 	}
 
+	void CMemoryStream::readPadding(unsigned int alignment)
+	{
+		unsigned int remain = m_pos % alignment;
+		if (remain != 0)
+			m_pos += alignment - remain;
+	}
+
 	std::string CMemoryStream::readString()
 	{
 		int numchar = 0;
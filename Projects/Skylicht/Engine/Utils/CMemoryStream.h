@@ -113,6 +113,12 @@ namespace Skylicht
 		 * @param count Number of float values.
 		 */
 		void writeFloatArray(const float* f, int count);
+		/**
+		 * @brief Append zero bytes until the write position is aligned.
+		 * @param alignment Alignment in bytes.
+		 * @param baseOffset Offset of this stream in the final file, the alignment is relative to the file.
+		 */
+		void writePadding(unsigned int alignment, unsigned int baseOffset = 0);
 
 		/**
 		 * @brief Read raw bytes from the current read position.
@@ -146,6 +152,11 @@ namespace Skylicht
 		 * @param count Number of float values to read.
 		 */
 		void readFloatArray(float* f, int count);
+		/**
+		 * @brief Skip the bytes written by `writePadding`.
+		 * @param alignment Alignment in bytes.
+		 */
+		void readPadding(unsigned int alignment);
 
 		/**
 		 * @brief Get the backing memory pointer.
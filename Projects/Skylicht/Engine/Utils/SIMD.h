@@ -0,0 +1,49 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+// SIMD instruction set detection
+// - SKYLICHT_SIMD_SSE: x86/x64 with SSE2 (all x64 compilers)
+// - SKYLICHT_SIMD_AVX2: the engine is compiled with -mavx2 -mfma (or /arch:AVX2)
+// - SKYLICHT_SIMD_NEON: ARM with NEON (arm64, armv7 -mfpu=neon)
+// Define SKYLICHT_NO_SIMD to force the scalar code path.
+
+#if !defined(SKYLICHT_NO_SIMD)
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKYLICHT_SIMD_SSE
+#include <emmintrin.h>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#define SKYLICHT_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SKYLICHT_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#endif
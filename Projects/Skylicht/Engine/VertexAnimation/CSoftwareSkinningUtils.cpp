@@ -24,9 +24,15 @@ https://github.com/skylicht-lab/skylicht-engine
 
 #include "pch.h"
 #include "CSoftwareSkinningUtils.h"
+#include "Job/CJobScheduler.h"
+#include "Utils/SIMD.h"
 
 // #define VERTEX_NORMALIZE
 
+// the vertices of a large mesh buffer are split to the job threads
+#define PARALLEL_SKIN_VERTEX 4096
+#define PARALLEL_SKIN_GRAIN 1024
+
 namespace Skylicht
 {
 	CMesh* CSoftwareSkinningUtils::initSoftwareSkinning(CMesh* originalMesh)
@@ -155,6 +161,9 @@ namespace Skylicht
 			meshBuffer->drop();
 		}
 
+		// the sparse vertex list for softwareBlendShape
+		initBlendShapeVertices(originalMesh);
+
 		return mesh;
 	}
 
@@ -185,103 +194,141 @@ namespace Skylicht
 		}
 	}
 
-	void CSoftwareSkinningUtils::softwareSkinning(CMesh* skinnedMesh, CSkinnedMesh* originalMesh, CSkinnedMesh* blendShapeMesh)
+	template<class T>
+	static void skinVertices(const CSkinnedMesh::SJoint* joints, const T* vertex, video::S3DVertex* resultVertex, int from, int to)
 	{
-		CSkinnedMesh::SJoint* arrayJoint = originalMesh->Joints.pointer();
-
-		CSkinnedMesh* sourceMesh = blendShapeMesh ? blendShapeMesh : originalMesh;
+		vertex += from;
+		resultVertex += from;
 
-		for (u32 i = 0, n = sourceMesh->getMeshBufferCount(); i < n; i++)
+		for (int i = from; i < to; i++)
 		{
-			IMeshBuffer* originalMeshBuffer = sourceMesh->getMeshBuffer(i);
-			IVertexBuffer* originalVertexbuffer = originalMeshBuffer->getVertexBuffer(0);
-			video::S3DVertexSkin* vertex = (video::S3DVertexSkin*)originalVertexbuffer->getVertices();
+			const f32* weight = &vertex->BoneWeight.X;
+			const f32* boneId = &vertex->BoneIndex.X;
 
-			int numVertex = originalVertexbuffer->getVertexCount();
-
-			IMeshBuffer* resultMeshBuffer = skinnedMesh->getMeshBuffer(i);
-			IVertexBuffer* resultVertexBuffer = resultMeshBuffer->getVertexBuffer(0);
-			video::S3DVertex* resultVertex = (video::S3DVertex*)resultVertexBuffer->getVertices();
+			// blend the bone matrices, then transform the vertex once
+#if defined(SKYLICHT_SIMD_SSE)
+			__m128 r0 = _mm_setzero_ps();
+			__m128 r1 = _mm_setzero_ps();
+			__m128 r2 = _mm_setzero_ps();
+			__m128 r3 = _mm_setzero_ps();
 
-#ifdef VERTEX_NORMALIZE
-			float length, invLength;
-#endif
-			// skinning
-			for (int i = 0; i < numVertex; i++)
+			for (int b = 0; b < 4; b++)
 			{
-				resultVertex->Pos.X = 0.0f;
-				resultVertex->Pos.Y = 0.0f;
-				resultVertex->Pos.Z = 0.0f;
-
-				resultVertex->Normal.X = 0.0f;
-				resultVertex->Normal.Y = 0.0f;
-				resultVertex->Normal.Z = 0.0f;
-
-				// bone 0
-				if (vertex->BoneWeight.X > 0.0f)
+				if (weight[b] > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.X].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.X);
+					const f32* m = joints[(int)boneId[b]].SkinningMatrix;
+					__m128 w = _mm_set1_ps(weight[b]);
+#if defined(SKYLICHT_SIMD_AVX2)
+					r0 = _mm_fmadd_ps(_mm_loadu_ps(m), w, r0);
+					r1 = _mm_fmadd_ps(_mm_loadu_ps(m + 4), w, r1);
+					r2 = _mm_fmadd_ps(_mm_loadu_ps(m + 8), w, r2);
+					r3 = _mm_fmadd_ps(_mm_loadu_ps(m + 12), w, r3);
+#else
+					r0 = _mm_add_ps(r0, _mm_mul_ps(_mm_loadu_ps(m), w));
+					r1 = _mm_add_ps(r1, _mm_mul_ps(_mm_loadu_ps(m + 4), w));
+					r2 = _mm_add_ps(r2, _mm_mul_ps(_mm_loadu_ps(m + 8), w));
+					r3 = _mm_add_ps(r3, _mm_mul_ps(_mm_loadu_ps(m + 12), w));
+#endif
 				}
+			}
 
-				// bone 1
-				if (vertex->BoneWeight.Y > 0.0f)
+			__m128 p = _mm_add_ps(r3, _mm_mul_ps(r0, _mm_set1_ps(vertex->Pos.X)));
+			p = _mm_add_ps(p, _mm_mul_ps(r1, _mm_set1_ps(vertex->Pos.Y)));
+			p = _mm_add_ps(p, _mm_mul_ps(r2, _mm_set1_ps(vertex->Pos.Z)));
+
+			__m128 n = _mm_mul_ps(r0, _mm_set1_ps(vertex->Normal.X));
+			n = _mm_add_ps(n, _mm_mul_ps(r1, _mm_set1_ps(vertex->Normal.Y)));
+			n = _mm_add_ps(n, _mm_mul_ps(r2, _mm_set1_ps(vertex->Normal.Z)));
+
+			// the 4th float of position is Normal.X, that is written after
+			_mm_storeu_ps(&resultVertex->Pos.X, p);
+			_mm_storel_pi((__m64*) & resultVertex->Normal.X, n);
+			_mm_store_ss(&resultVertex->Normal.Z, _mm_movehl_ps(n, n));
+#elif defined(SKYLICHT_SIMD_NEON)
+			float32x4_t r0 = vdupq_n_f32(0.0f);
+			float32x4_t r1 = vdupq_n_f32(0.0f);
+			float32x4_t r2 = vdupq_n_f32(0.0f);
+			float32x4_t r3 = vdupq_n_f32(0.0f);
+
+			for (int b = 0; b < 4; b++)
+			{
+				if (weight[b] > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.Y].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.Y);
+					const f32* m = joints[(int)boneId[b]].SkinningMatrix;
+					r0 = vmlaq_n_f32(r0, vld1q_f32(m), weight[b]);
+					r1 = vmlaq_n_f32(r1, vld1q_f32(m + 4), weight[b]);
+					r2 = vmlaq_n_f32(r2, vld1q_f32(m + 8), weight[b]);
+					r3 = vmlaq_n_f32(r3, vld1q_f32(m + 12), weight[b]);
 				}
+			}
 
-				// bone 2
-				if (vertex->BoneWeight.Z > 0.0f)
-				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.Z].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.Z);
-				}
+			float32x4_t p = vmlaq_n_f32(r3, r0, vertex->Pos.X);
+			p = vmlaq_n_f32(p, r1, vertex->Pos.Y);
+			p = vmlaq_n_f32(p, r2, vertex->Pos.Z);
+
+			float32x4_t n = vmulq_n_f32(r0, vertex->Normal.X);
+			n = vmlaq_n_f32(n, r1, vertex->Normal.Y);
+			n = vmlaq_n_f32(n, r2, vertex->Normal.Z);
+
+			vst1_f32(&resultVertex->Pos.X, vget_low_f32(p));
+			vst1q_lane_f32(&resultVertex->Pos.Z, p, 2);
+			vst1_f32(&resultVertex->Normal.X, vget_low_f32(n));
+			vst1q_lane_f32(&resultVertex->Normal.Z, n, 2);
+#else
+			f32 r[16];
+			memset(r, 0, sizeof(r));
 
-				// bone 3
-				if (vertex->BoneWeight.W > 0.0f)
+			for (int b = 0; b < 4; b++)
+			{
+				if (weight[b] > 0.0f)
 				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.W].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.W);
+					const f32* m = joints[(int)boneId[b]].SkinningMatrix;
+					for (int j = 0; j < 16; j++)
+						r[j] += m[j] * weight[b];
 				}
+			}
 
-				// apply skin normal
+			const core::vector3df& srcPos = vertex->Pos;
+			const core::vector3df& srcNormal = vertex->Normal;
+
+			resultVertex->Pos.X = srcPos.X * r[0] + srcPos.Y * r[4] + srcPos.Z * r[8] + r[12];
+			resultVertex->Pos.Y = srcPos.X * r[1] + srcPos.Y * r[5] + srcPos.Z * r[9] + r[13];
+			resultVertex->Pos.Z = srcPos.X * r[2] + srcPos.Y * r[6] + srcPos.Z * r[10] + r[14];
+
+			resultVertex->Normal.X = srcNormal.X * r[0] + srcNormal.Y * r[4] + srcNormal.Z * r[8];
+			resultVertex->Normal.Y = srcNormal.X * r[1] + srcNormal.Y * r[5] + srcNormal.Z * r[9];
+			resultVertex->Normal.Z = srcNormal.X * r[2] + srcNormal.Y * r[6] + srcNormal.Z * r[10];
+#endif
+
+			// apply skin normal
 #ifdef VERTEX_NORMALIZE
-				length = resultVertex->Normal.X * resultVertex->Normal.X +
-					resultVertex->Normal.Y * resultVertex->Normal.Y +
-					resultVertex->Normal.Z * resultVertex->Normal.Z;
-
-				invLength = 1.0f / sqrtf(length);
-				resultVertex->Normal.X = resultVertex->Normal.X * invLength;
-				resultVertex->Normal.Y = resultVertex->Normal.Y * invLength;
-				resultVertex->Normal.Z = resultVertex->Normal.Z * invLength;
+			resultVertex->Normal.normalize();
 #endif
 
-				++resultVertex;
-				++vertex;
-			}
+			++resultVertex;
+			++vertex;
+		}
+	}
 
-			skinnedMesh->setDirty(EBT_VERTEX);
+	template<class T>
+	static void skinMeshBuffer(const CSkinnedMesh::SJoint* joints, const T* vertex, video::S3DVertex* resultVertex, int numVertex)
+	{
+		if (numVertex >= PARALLEL_SKIN_VERTEX)
+		{
+			System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+			scheduler->parallelFor(0, numVertex, PARALLEL_SKIN_GRAIN,
+				[joints, vertex, resultVertex](int from, int to)
+				{
+					skinVertices(joints, vertex, resultVertex, from, to);
+				});
+		}
+		else
+		{
+			skinVertices(joints, vertex, resultVertex, 0, numVertex);
 		}
 	}
 
-	void CSoftwareSkinningUtils::softwareSkinningTangent(CMesh* skinnedMesh, CSkinnedMesh* originalMesh, CSkinnedMesh* blendShapeMesh)
+	void CSoftwareSkinningUtils::softwareSkinning(CMesh* skinnedMesh, CSkinnedMesh* originalMesh, CSkinnedMesh* blendShapeMesh)
 	{
 		CSkinnedMesh::SJoint* arrayJoint = originalMesh->Joints.pointer();
 
@@ -291,7 +338,7 @@ namespace Skylicht
 		{
 			IMeshBuffer* originalMeshBuffer = sourceMesh->getMeshBuffer(i);
 			IVertexBuffer* originalVertexbuffer = originalMeshBuffer->getVertexBuffer(0);
-			video::S3DVertexSkinTangents* vertex = (video::S3DVertexSkinTangents*)originalVertexbuffer->getVertices();
+			video::S3DVertexSkin* vertex = (video::S3DVertexSkin*)originalVertexbuffer->getVertices();
 
 			int numVertex = originalVertexbuffer->getVertexCount();
 
@@ -299,87 +346,36 @@ namespace Skylicht
 			IVertexBuffer* resultVertexBuffer = resultMeshBuffer->getVertexBuffer(0);
 			video::S3DVertex* resultVertex = (video::S3DVertex*)resultVertexBuffer->getVertices();
 
-#ifdef VERTEX_NORMALIZE
-			float length, invLength;
-#endif
-
-			// skinning
-			for (int i = 0; i < numVertex; i++)
-			{
-				resultVertex->Pos.X = 0.0f;
-				resultVertex->Pos.Y = 0.0f;
-				resultVertex->Pos.Z = 0.0f;
+			skinMeshBuffer(arrayJoint, vertex, resultVertex, numVertex);
+		}
 
-				resultVertex->Normal.X = 0.0f;
-				resultVertex->Normal.Y = 0.0f;
-				resultVertex->Normal.Z = 0.0f;
+		skinnedMesh->setDirty(EBT_VERTEX);
+	}
 
-				// bone 0
-				if (vertex->BoneWeight.X > 0.0f)
-				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.X].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.X);
-				}
+	void CSoftwareSkinningUtils::softwareSkinningTangent(CMesh* skinnedMesh, CSkinnedMesh* originalMesh, CSkinnedMesh* blendShapeMesh)
+	{
+		CSkinnedMesh::SJoint* arrayJoint = originalMesh->Joints.pointer();
 
-				// bone 1
-				if (vertex->BoneWeight.Y > 0.0f)
-				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.Y].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.Y);
-				}
+		CSkinnedMesh* sourceMesh = blendShapeMesh ? blendShapeMesh : originalMesh;
 
-				// bone 2
-				if (vertex->BoneWeight.Z > 0.0f)
-				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.Z].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.Z);
-				}
+		for (u32 i = 0, n = sourceMesh->getMeshBufferCount(); i < n; i++)
+		{
+			IMeshBuffer* originalMeshBuffer = sourceMesh->getMeshBuffer(i);
+			IVertexBuffer* originalVertexbuffer = originalMeshBuffer->getVertexBuffer(0);
+			video::S3DVertexSkinTangents* vertex = (video::S3DVertexSkinTangents*)originalVertexbuffer->getVertices();
 
-				// bone 3
-				if (vertex->BoneWeight.W > 0.0f)
-				{
-					skinVertex(arrayJoint[(int)vertex->BoneIndex.W].SkinningMatrix,
-						resultVertex->Pos,
-						resultVertex->Normal,
-						vertex->Pos,
-						vertex->Normal,
-						vertex->BoneWeight.W);
-				}
+			int numVertex = originalVertexbuffer->getVertexCount();
 
-				// apply skin normal
-#ifdef VERTEX_NORMALIZE
-				length = resultVertex->Normal.X * resultVertex->Normal.X +
-					resultVertex->Normal.Y * resultVertex->Normal.Y +
-					resultVertex->Normal.Z * resultVertex->Normal.Z;
-
-				invLength = 1.0f / sqrtf(length);
-				resultVertex->Normal.X = resultVertex->Normal.X * invLength;
-				resultVertex->Normal.Y = resultVertex->Normal.Y * invLength;
-				resultVertex->Normal.Z = resultVertex->Normal.Z * invLength;
-#endif
+			IMeshBuffer* resultMeshBuffer = skinnedMesh->getMeshBuffer(i);
+			IVertexBuffer* resultVertexBuffer = resultMeshBuffer->getVertexBuffer(0);
+			video::S3DVertex* resultVertex = (video::S3DVertex*)resultVertexBuffer->getVertices();
 
-				++resultVertex;
-				++vertex;
-			}
+			skinMeshBuffer(arrayJoint, vertex, resultVertex, numVertex);
 		}
 
 		skinnedMesh->setDirty(EBT_VERTEX);
 	}
 
-	float px, py, pz, nx, ny, nz;
-
 	void CSoftwareSkinningUtils::skinVertex(const float* m,
 		core::vector3df& vertex,
 		core::vector3df& normal,
@@ -387,6 +383,8 @@ namespace Skylicht
 		const core::vector3df& srcNormal,
 		const float& weight)
 	{
+		float px, py, pz, nx, ny, nz;
+
 		px = srcPos.X * m[0] + srcPos.Y * m[4] + srcPos.Z * m[8] + m[12];
 		py = srcPos.X * m[1] + srcPos.Y * m[5] + srcPos.Z * m[9] + m[13];
 		pz = srcPos.X * m[2] + srcPos.Y * m[6] + srcPos.Z * m[10] + m[14];
@@ -412,100 +410,169 @@ namespace Skylicht
 		normal.Z += nz;
 	}
 
+	void CSoftwareSkinningUtils::initBlendShapeVertices(CMesh* originalMesh)
+	{
+		u32 numBuffer = originalMesh->getMeshBufferCount();
+
+		for (u32 j = 0, m = originalMesh->BlendShape.size(); j < m; j++)
+		{
+			CBlendShape* blendShape = originalMesh->BlendShape[j];
+			if (blendShape->Vertices.size() == numBuffer)
+				continue;
+
+			blendShape->Vertices.clear();
+			blendShape->Vertices.resize(numBuffer);
+
+			const u32* vtxId = blendShape->VtxId.const_pointer();
+			u32 numId = blendShape->VtxId.size();
+			u32 size = blendShape->Offset.size() - 1;
+
+			for (u32 i = 0; i < numBuffer; i++)
+			{
+				IVertexBuffer* vertexBuffer = originalMesh->getMeshBuffer(i)->getVertexBuffer(0);
+
+				u32 vtxSize = vertexBuffer->getVertexSize();
+				unsigned char* data = (unsigned char*)vertexBuffer->getVertices();
+
+				core::array<CBlendShape::SVertex>& vertices = blendShape->Vertices[i];
+
+				for (u32 v = 0, n = vertexBuffer->getVertexCount(); v < n; v++)
+				{
+					video::S3DVertexTangents* vertex = (video::S3DVertexTangents*)(data + v * vtxSize);
+
+					u32 id = (u32)vertex->VertexData.Y;
+					if (id < numId && vtxId[id] != size)
+					{
+						CBlendShape::SVertex blendVertex;
+						blendVertex.Vertex = v;
+						blendVertex.Offset = vtxId[id];
+						vertices.push_back(blendVertex);
+					}
+				}
+			}
+		}
+	}
+
+	static void resetBlendShape(const CBlendShape::SVertex* vertices, int from, int to, unsigned char* dataSrc, unsigned char* dataDst, u32 vtxSize)
+	{
+		for (int i = from; i < to; i++)
+		{
+			u32 offset = vertices[i].Vertex * vtxSize;
+
+			video::S3DVertexTangents* vertex = (video::S3DVertexTangents*)(dataSrc + offset);
+			video::S3DVertexTangents* resultVertex = (video::S3DVertexTangents*)(dataDst + offset);
+
+			resultVertex->Pos = vertex->Pos;
+			resultVertex->Normal = vertex->Normal;
+		}
+	}
+
+	static void accumulateBlendShape(const CBlendShape::SVertex* vertices, int from, int to, CBlendShape* blendShape, unsigned char* dataDst, u32 vtxSize)
+	{
+		const core::vector3df* positionOffsets = blendShape->Offset.const_pointer();
+		const core::vector3df* normalOffsets = blendShape->NormalOffset.const_pointer();
+		float weight = blendShape->Weight;
+
+		for (int i = from; i < to; i++)
+		{
+			const CBlendShape::SVertex& v = vertices[i];
+
+			video::S3DVertexTangents* resultVertex = (video::S3DVertexTangents*)(dataDst + v.Vertex * vtxSize);
+
+			const core::vector3df& positionOffset = positionOffsets[v.Offset];
+			const core::vector3df& normalOffset = normalOffsets[v.Offset];
+
+			resultVertex->Pos.X += weight * positionOffset.X;
+			resultVertex->Pos.Y += weight * positionOffset.Y;
+			resultVertex->Pos.Z += weight * positionOffset.Z;
+
+			resultVertex->Normal.X += weight * normalOffset.X;
+			resultVertex->Normal.Y += weight * normalOffset.Y;
+			resultVertex->Normal.Z += weight * normalOffset.Z;
+		}
+	}
+
 	void CSoftwareSkinningUtils::softwareBlendShape(CMesh* blendShape, CMesh* originalMesh)
 	{
 		CBlendShape** blendShapeData = originalMesh->BlendShape.pointer();
 		u32 numBlendShape = originalMesh->BlendShape.size();
 
+		// it is built in initSoftwareBlendShape
+		initBlendShapeVertices(originalMesh);
+
+		System::CJobScheduler* scheduler = System::CJobScheduler::getInstance();
+
 		for (u32 i = 0, n = originalMesh->getMeshBufferCount(); i < n; i++)
 		{
 			IMeshBuffer* originalMeshBuffer = originalMesh->getMeshBuffer(i);
 			IVertexBuffer* originalVertexbuffer = originalMeshBuffer->getVertexBuffer(0);
 
-			int numVertex = originalVertexbuffer->getVertexCount();
-
 			IMeshBuffer* resultMeshBuffer = blendShape->getMeshBuffer(i);
 			IVertexBuffer* resultVertexBuffer = resultMeshBuffer->getVertexBuffer(0);
 
-			video::S3DVertexTangents* vertex = NULL;
-			video::S3DVertexTangents* resultVertex = NULL;
+			u32 vtxSize = originalVertexbuffer->getVertexSize();
+			unsigned char* dataSrc = (unsigned char*)originalVertexbuffer->getVertices();
+			unsigned char* dataDst = (unsigned char*)resultVertexBuffer->getVertices();
 
-			core::vector3df* srcPos, * dstPos, * srcNormal, * dstNormal;
-
-			const core::vector3df* positionOffsets = NULL;
-			const core::vector3df* positionOffset = NULL;
-
-			const core::vector3df* normalOffsets = NULL;
-			const core::vector3df* normalOffset = NULL;
-
-			const u32* vtxId = NULL;
-
-			float weight = 0.0f;
-			u32 ix, size;
+			// restore the vertices of all the blend shapes, the weight can be changed to zero since the last frame
+			for (u32 j = 0; j < numBlendShape; j++)
+			{
+				core::array<CBlendShape::SVertex>& vertices = blendShapeData[j]->Vertices[i];
+				const CBlendShape::SVertex* v = vertices.const_pointer();
+				int numVertex = (int)vertices.size();
 
-#ifdef VERTEX_NORMALIZE
-			float length, invLength;
-#endif
+				if (numVertex >= PARALLEL_SKIN_VERTEX)
+				{
+					scheduler->parallelFor(0, numVertex, PARALLEL_SKIN_GRAIN,
+						[v, dataSrc, dataDst, vtxSize](int from, int to)
+						{
+							resetBlendShape(v, from, to, dataSrc, dataDst, vtxSize);
+						});
+				}
+				else
+				{
+					resetBlendShape(v, 0, numVertex, dataSrc, dataDst, vtxSize);
+				}
+			}
 
+			// accumulate the offsets of the non-zero weights, a blend shape has no duplicated vertex
 			for (u32 j = 0; j < numBlendShape; j++)
 			{
-				CBlendShape* blendShape = blendShapeData[j];
-
-				weight = blendShape->Weight;
-				if (weight == 0.0f)
+				CBlendShape* shape = blendShapeData[j];
+				if (shape->Weight == 0.0f)
 					continue;
 
-				u32 vtxSize = originalVertexbuffer->getVertexSize();
-				unsigned char* dataSrc = (unsigned char*)originalVertexbuffer->getVertices();
-				unsigned char* dataDst = (unsigned char*)resultVertexBuffer->getVertices();
+				core::array<CBlendShape::SVertex>& vertices = shape->Vertices[i];
+				const CBlendShape::SVertex* v = vertices.const_pointer();
+				int numVertex = (int)vertices.size();
 
-				vtxId = blendShape->VtxId.const_pointer();
-				size = blendShape->Offset.size() - 1;
-				positionOffsets = blendShape->Offset.const_pointer();
-				normalOffsets = blendShape->NormalOffset.const_pointer();
-
-				for (int i = 0; i < numVertex; i++)
+				if (numVertex >= PARALLEL_SKIN_VERTEX)
 				{
-					vertex = (video::S3DVertexTangents*)dataSrc;
-					resultVertex = (video::S3DVertexTangents*)dataDst;
-
-					ix = vtxId[(int)(vertex->VertexData.Y)];
-					if (ix != size)
-					{
-						positionOffset = &positionOffsets[ix];
-						normalOffset = &normalOffsets[ix];
-
-						srcPos = &vertex->Pos;
-						dstPos = &resultVertex->Pos;
-						srcNormal = &vertex->Normal;
-						dstNormal = &resultVertex->Normal;
-
-						dstPos->X = srcPos->X + weight * positionOffset->X;
-						dstPos->Y = srcPos->Y + weight * positionOffset->Y;
-						dstPos->Z = srcPos->Z + weight * positionOffset->Z;
-
-						dstNormal->X = srcNormal->X + weight * normalOffset->X;
-						dstNormal->Y = srcNormal->Y + weight * normalOffset->Y;
-						dstNormal->Z = srcNormal->Z + weight * normalOffset->Z;
+					scheduler->parallelFor(0, numVertex, PARALLEL_SKIN_GRAIN,
+						[v, shape, dataDst, vtxSize](int from, int to)
+						{
+							accumulateBlendShape(v, from, to, shape, dataDst, vtxSize);
+						});
+				}
+				else
+				{
+					accumulateBlendShape(v, 0, numVertex, shape, dataDst, vtxSize);
+				}
+			}
 
 #ifdef VERTEX_NORMALIZE
-						length = dstNormal->X * dstNormal->X +
-							dstNormal->Y * dstNormal->Y +
-							dstNormal->Z * dstNormal->Z;
-
-						invLength = 1.0f / sqrtf(length);
-						dstNormal->X = dstNormal->X * invLength;
-						dstNormal->Y = dstNormal->Y * invLength;
-						dstNormal->Z = dstNormal->Z * invLength;
-#endif
-					}
-
-					dataSrc += vtxSize;
-					dataDst += vtxSize;
+			for (u32 j = 0; j < numBlendShape; j++)
+			{
+				core::array<CBlendShape::SVertex>& vertices = blendShapeData[j]->Vertices[i];
+				for (u32 k = 0, m = vertices.size(); k < m; k++)
+				{
+					video::S3DVertexTangents* resultVertex = (video::S3DVertexTangents*)(dataDst + vertices[k].Vertex * vtxSize);
+					resultVertex->Normal.normalize();
 				}
 			}
+#endif
 		}
 
 		blendShape->setDirty(EBT_VERTEX);
 	}
-}
\ No newline at end of file
+}
@@ -49,6 +49,8 @@ namespace Skylicht
 			const core::vector3df& srcNormal,
 			const float& weight);
 
+		static void initBlendShapeVertices(CMesh* originalMesh);
+
 		static void softwareBlendShape(CMesh* blendShape, CMesh* originalMesh);
 	};
 }
\ No newline at end of file
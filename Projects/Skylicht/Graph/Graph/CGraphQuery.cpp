@@ -22,59 +22,6 @@ namespace Skylicht
 			}
 		}
 
-		CDistancePriorityQueue::CDistancePriorityQueue()
-		{
-
-		}
-
-		CDistancePriorityQueue::~CDistancePriorityQueue()
-		{
-
-		}
-
-		void CDistancePriorityQueue::push(const SDistanceTile& d)
-		{
-			SDistanceTile* a = m_queue.pointer();
-
-			// find position
-			int pos = -1;
-			for (u32 i = 0, n = m_queue.size(); i < n; i++)
-			{
-				if (m_queue[i].Distance < d.Distance)
-				{
-					pos = i;
-					break;
-				}
-			}
-
-			if (pos == -1)
-				pos = m_queue.size();
-
-			// insert empty at last
-			m_queue.push_back(SDistanceTile());
-
-			// swap
-			for (int i = m_queue.size() - 1; i > pos; i--)
-			{
-				SDistanceTile t = m_queue[i];
-				m_queue[i] = m_queue[i - 1];
-				m_queue[i - 1] = t;
-			}
-
-			m_queue[pos] = d;
-		}
-
-		void CDistancePriorityQueue::pop()
-		{
-			m_queue.set_used(m_queue.size() - 1);
-		}
-
-		const SDistanceTile& CDistancePriorityQueue::top()
-		{
-			return m_queue.getLast();
-		}
-
-
 		CGraphQuery::CGraphQuery() :
 			m_root(NULL),
 			m_minimalPolysPerNode(4)
@@ -436,84 +383,9 @@ namespace Skylicht
 
 		bool CGraphQuery::findPath(CWalkingTileMap* map, STile* from, STile* to, core::array<STile*>& result)
 		{
-			result.clear();
-
-			if (from->AreaId != to->AreaId)
-				return false;
-
-			u32 numTile = map->getNumTile();
-
-			CDistancePriorityQueue queue;
-
-			std::vector<STile*> prev(numTile, NULL);
-			std::vector<float> dist(numTile, -1.0);
-
-			float length = (to->Position - from->Position).getLengthSQ();
-			queue.push({ length, from });
-
-			dist[from->Id] = 0.0f;
-
-			map->resetVisit();
-
-			while (!queue.empty())
-			{
-				const SDistanceTile& t = queue.top();
-
-				STile* tile = t.Tile;
-				queue.pop();
-
-				if (tile->Visit)
-					continue;
-
-				tile->Visit = true;
-				if (tile == to)
-					break;
-
-				float walkDistance = dist[tile->Id];
-
-				for (u32 i = 0, n = tile->Neighbours.size(); i < n; i++)
-				{
-					STile* nei = tile->Neighbours[i];
-
-					float neiDist = (nei->Position - tile->Position).getLengthSQ();
-					float currentDist = walkDistance + neiDist;
-
-					if (dist[nei->Id] < 0 || dist[nei->Id] > currentDist)
-					{
-						// if not yet calc dist of nei
-						// or have another link shorter
-						dist[nei->Id] = currentDist;
-
-						float length = currentDist + (to->Position - nei->Position).getLengthSQ();
-						queue.push({ length, nei });
-
-						prev[nei->Id] = tile;
-					}
-				}
-			}
-
-			map->resetVisit();
-
-			if (prev[to->Id] == NULL)
-				return false;
-
-			STile* u = to;
-			result.push_back(u);
-			while (u != from) {
-				result.push_back(prev[u->Id]);
-				u = prev[u->Id];
-			}
-
-			// reverse result
-			u32 count = result.size();
-			for (u32 i = 0, n = count / 2; i < n; i++)
-			{
-				STile* temp = result[count - i - 1];
-				result[count - i - 1] = result[i];
-				result[i] = temp;
-			}
-
-			return true;
+			// each thread has its own scratch buffers
+			static thread_local CPathFinder finder;
+			return finder.findPath(map, from, to, result);
 		}
 	}
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "RenderMesh/CRenderMeshData.h"
 #include "ObstacleAvoidance/CObstacleAvoidance.h"
 #include "WalkingMap/CWalkingTileMap.h"
+#include "CPathFinder.h"
 
 namespace Skylicht
 {
@@ -51,34 +52,6 @@ namespace Skylicht
 			virtual ~COctreeNode();
 		};
 
-		struct SDistanceTile
-		{
-			float Distance;
-			STile* Tile;
-		};
-
-		class CDistancePriorityQueue
-		{
-		protected:
-			core::array<SDistanceTile> m_queue;
-
-		public:
-			CDistancePriorityQueue();
-
-			virtual ~CDistancePriorityQueue();
-
-			void push(const SDistanceTile& d);
-
-			void pop();
-
-			inline bool empty()
-			{
-				return m_queue.empty();
-			}
-
-			const SDistanceTile& top();
-		};
-
 		class CGraphQuery
 		{
 		protected:
@@ -110,6 +83,8 @@ namespace Skylicht
 
 			void getObstacles(const core::aabbox3df& box, CObstacleAvoidance& obstacle);
 
+			/// @brief Find the path between 2 tiles, it can be called from many threads at the same time.
+			/// @see CPathFinder
 			bool findPath(CWalkingTileMap* map, STile* from, STile* to, core::array<STile*>& result);
 
 		protected:
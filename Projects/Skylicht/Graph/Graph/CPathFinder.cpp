@@ -0,0 +1,228 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CPathFinder.h"
+
+namespace Skylicht
+{
+	namespace Graph
+	{
+		CPathFinder::CPathFinder() :
+			m_generation(0)
+		{
+
+		}
+
+		CPathFinder::~CPathFinder()
+		{
+
+		}
+
+		void CPathFinder::beginQuery(u32 numTile)
+		{
+			if (m_nodes.size() < numTile)
+			{
+				SNode node;
+				node.Generation = 0;
+				m_nodes.resize(numTile, node);
+			}
+
+			m_generation++;
+			if (m_generation == 0)
+			{
+				// generation overflow, reset all stamps
+				for (SNode& node : m_nodes)
+					node.Generation = 0;
+				m_generation = 1;
+			}
+
+			m_heap.clear();
+		}
+
+		void CPathFinder::heapSiftUp(s32 index)
+		{
+			s32* heap = m_heap.data();
+			s32 id = heap[index];
+			float estimate = m_nodes[id].Estimate;
+
+			while (index > 0)
+			{
+				s32 parent = (index - 1) >> 1;
+				s32 parentId = heap[parent];
+
+				if (m_nodes[parentId].Estimate <= estimate)
+					break;
+
+				heap[index] = parentId;
+				m_nodes[parentId].HeapIndex = index;
+				index = parent;
+			}
+
+			heap[index] = id;
+			m_nodes[id].HeapIndex = index;
+		}
+
+		void CPathFinder::heapSiftDown(s32 index)
+		{
+			s32* heap = m_heap.data();
+			s32 count = (s32)m_heap.size();
+			s32 id = heap[index];
+			float estimate = m_nodes[id].Estimate;
+
+			while (true)
+			{
+				s32 child = (index << 1) + 1;
+				if (child >= count)
+					break;
+
+				// the smaller child
+				if (child + 1 < count && m_nodes[heap[child + 1]].Estimate < m_nodes[heap[child]].Estimate)
+					child++;
+
+				s32 childId = heap[child];
+				if (estimate <= m_nodes[childId].Estimate)
+					break;
+
+				heap[index] = childId;
+				m_nodes[childId].HeapIndex = index;
+				index = child;
+			}
+
+			heap[index] = id;
+			m_nodes[id].HeapIndex = index;
+		}
+
+		void CPathFinder::heapPush(s32 id)
+		{
+			SNode& node = m_nodes[id];
+			if (node.HeapIndex >= 0)
+			{
+				// decrease key
+				heapSiftUp(node.HeapIndex);
+				return;
+			}
+
+			m_heap.push_back(id);
+			heapSiftUp((s32)m_heap.size() - 1);
+		}
+
+		s32 CPathFinder::heapPop()
+		{
+			s32 top = m_heap[0];
+			m_nodes[top].HeapIndex = -1;
+
+			s32 last = m_heap.back();
+			m_heap.pop_back();
+
+			if (!m_heap.empty())
+			{
+				m_heap[0] = last;
+				heapSiftDown(0);
+			}
+
+			return top;
+		}
+
+		bool CPathFinder::findPath(CWalkingTileMap* map, STile* from, STile* to, core::array<STile*>& result)
+		{
+			result.set_used(0);
+
+			if (from->AreaId != to->AreaId || from == to)
+				return false;
+
+			STile** tiles = map->getTiles().pointer();
+
+			beginQuery(map->getNumTile());
+
+			// note: the cost is the sum of the squared step length,
+			// and the heuristic is the squared distance to the goal
+			SNode& start = getNode(from->Id);
+			start.Cost = 0.0f;
+			start.Estimate = (to->Position - from->Position).getLengthSQ();
+			heapPush(from->Id);
+
+			bool found = false;
+
+			while (!m_heap.empty())
+			{
+				s32 id = heapPop();
+
+				SNode& node = m_nodes[id];
+				node.Closed = true;
+
+				STile* tile = tiles[id];
+				if (tile == to)
+				{
+					found = true;
+					break;
+				}
+
+				float walkDistance = node.Cost;
+
+				STile** neighbours = tile->Neighbours.pointer();
+				for (u32 i = 0, n = tile->Neighbours.size(); i < n; i++)
+				{
+					STile* nei = neighbours[i];
+
+					SNode& neiNode = getNode(nei->Id);
+					if (neiNode.Closed)
+						continue;
+
+					float currentDist = walkDistance + (nei->Position - tile->Position).getLengthSQ();
+
+					if (neiNode.Cost < 0.0f || neiNode.Cost > currentDist)
+					{
+						// if not yet calc dist of nei
+						// or have another link shorter
+						neiNode.Cost = currentDist;
+						neiNode.Estimate = currentDist + (to->Position - nei->Position).getLengthSQ();
+						neiNode.Prev = id;
+
+						heapPush(nei->Id);
+					}
+				}
+			}
+
+			if (!found)
+				return false;
+
+			// count the tiles and fill the result from the goal
+			u32 count = 1;
+			for (s32 id = to->Id; id != from->Id; id = m_nodes[id].Prev)
+				count++;
+
+			result.set_used(count);
+
+			s32 id = to->Id;
+			for (s32 i = (s32)count - 1; i >= 0; i--)
+			{
+				result[i] = tiles[id];
+				id = m_nodes[id].Prev;
+			}
+
+			return true;
+		}
+	}
+}
@@ -0,0 +1,113 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "WalkingMap/CWalkingTileMap.h"
+
+namespace Skylicht
+{
+	namespace Graph
+	{
+		/// @brief A* path finding on CWalkingTileMap with an indexed binary heap.
+		/**
+		 * The open/closed state of the tiles is stored in the finder, not in STile,
+		 * so each thread can run its own CPathFinder on the same map.
+		 * The scratch nodes are stamped with a query generation, a new query does not need to clear them.
+		 *
+		 * @code
+		 * CPathFinder finder;
+		 * core::array<STile*> path;
+		 * if (finder.findPath(map, fromTile, toTile, path))
+		 * {
+		 *	// path[0] is fromTile, path.getLast() is toTile
+		 * }
+		 * @endcode
+		 */
+		class CPathFinder
+		{
+		protected:
+			struct SNode
+			{
+				// walk cost from the start tile
+				float Cost;
+
+				// Cost + heuristic to the goal tile
+				float Estimate;
+
+				u32 Generation;
+
+				// position in m_heap, -1 if the node is not in open list
+				s32 HeapIndex;
+
+				s32 Prev;
+
+				bool Closed;
+			};
+
+			std::vector<SNode> m_nodes;
+
+			std::vector<s32> m_heap;
+
+			u32 m_generation;
+
+		public:
+			CPathFinder();
+
+			virtual ~CPathFinder();
+
+			/// @brief Find the path from a tile to another tile in the same area.
+			/// @param result the list of tiles from the start tile to the goal tile
+			/// @return false if there is no path
+			bool findPath(CWalkingTileMap* map, STile* from, STile* to, core::array<STile*>& result);
+
+		protected:
+
+			void beginQuery(u32 numTile);
+
+			inline SNode& getNode(s32 id)
+			{
+				SNode& node = m_nodes[id];
+				if (node.Generation != m_generation)
+				{
+					node.Generation = m_generation;
+					node.Cost = -1.0f;
+					node.Estimate = 0.0f;
+					node.HeapIndex = -1;
+					node.Prev = -1;
+					node.Closed = false;
+				}
+				return node;
+			}
+
+			void heapPush(s32 id);
+
+			s32 heapPop();
+
+			void heapSiftUp(s32 index);
+
+			void heapSiftDown(s32 index);
+		};
+	}
+}
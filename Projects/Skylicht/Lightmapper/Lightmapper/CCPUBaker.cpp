@@ -0,0 +1,620 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CCPUBaker.h"
+#include "CBaker.h"
+
+#include "RenderMesh/CRenderMeshData.h"
+#include "Transform/CWorldTransformData.h"
+#include "Lighting/CLightCullingData.h"
+#include "Lighting/CPointLight.h"
+#include "Lighting/CAreaLight.h"
+#include "Job/CJobScheduler.h"
+
+// number of bake points per job
+#define PARALLEL_BAKE_GRAIN 4
+
+namespace Skylicht
+{
+	namespace Lightmapper
+	{
+		static inline u32 hashU32(u32 x)
+		{
+			x ^= x >> 16;
+			x *= 0x7feb352d;
+			x ^= x >> 15;
+			x *= 0x846ca68b;
+			x ^= x >> 16;
+			return x;
+		}
+
+		static inline float randomFloat(u32& state)
+		{
+			state = state * 1664525u + 1013904223u;
+			return (hashU32(state) >> 8) * (1.0f / 16777216.0f);
+		}
+
+		static void getBasis(const core::vector3df& n, core::vector3df& t, core::vector3df& b)
+		{
+			if (fabsf(n.Y) < 0.999f)
+				t = core::vector3df(0.0f, 1.0f, 0.0f).crossProduct(n);
+			else
+				t = core::vector3df(1.0f, 0.0f, 0.0f).crossProduct(n);
+			t.normalize();
+			b = n.crossProduct(t);
+		}
+
+		static core::vector3df sampleSphere(u32& rng)
+		{
+			float z = 1.0f - 2.0f * randomFloat(rng);
+			float r = sqrtf(core::max_(0.0f, 1.0f - z * z));
+			float phi = 2.0f * core::PI * randomFloat(rng);
+			return core::vector3df(r * cosf(phi), r * sinf(phi), z);
+		}
+
+		static core::vector3df sampleHemisphere(const core::vector3df& n, u32& rng)
+		{
+			core::vector3df t, b;
+			getBasis(n, t, b);
+
+			float z = randomFloat(rng);
+			float r = sqrtf(core::max_(0.0f, 1.0f - z * z));
+			float phi = 2.0f * core::PI * randomFloat(rng);
+			return t * (r * cosf(phi)) + b * (r * sinf(phi)) + n * z;
+		}
+
+		static core::vector3df sampleCosine(const core::vector3df& n, u32& rng)
+		{
+			core::vector3df t, b;
+			getBasis(n, t, b);
+
+			float u = randomFloat(rng);
+			float r = sqrtf(u);
+			float phi = 2.0f * core::PI * randomFloat(rng);
+			return t * (r * cosf(phi)) + b * (r * sinf(phi)) + n * sqrtf(core::max_(0.0f, 1.0f - u));
+		}
+
+		static inline u32 hashCombine(u32 h, u32 v)
+		{
+			return hashU32(h ^ (v + 0x9e3779b9 + (h << 6) + (h >> 2)));
+		}
+
+		static inline u32 hashCombine(u32 h, f32 v)
+		{
+			u32 bits;
+			memcpy(&bits, &v, sizeof(u32));
+			return hashCombine(h, bits);
+		}
+
+		CCPUBaker::CCPUBaker() :
+			m_sceneEntityMgr(NULL),
+			m_sceneRevision(0),
+			m_sceneChanged(true),
+			m_numPass(0),
+			m_numSample(0),
+			m_samplesPerPass(64),
+			m_maxBounce(3),
+			m_areaLightSamples(8),
+			m_seed(0),
+			m_bakeDirectLight(false),
+			m_albedo(0.5f, 0.5f, 0.5f),
+			m_bias(0.001f),
+			m_maxDistance(1000.0f)
+		{
+
+		}
+
+		CCPUBaker::~CCPUBaker()
+		{
+			clearScene();
+		}
+
+		void CCPUBaker::clearScene()
+		{
+			m_bvh.clear();
+			m_lights.clear();
+			m_sceneEntityMgr = NULL;
+			m_sceneChanged = true;
+		}
+
+		u32 CCPUBaker::getSceneRevision(CEntityManager* entityMgr)
+		{
+			CEntity** entities = entityMgr->getEntities();
+			int numEntity = entityMgr->getNumEntities();
+
+			u32 h = hashCombine(0u, (u32)numEntity);
+
+			for (int i = 0; i < numEntity; i++)
+			{
+				CEntity* entity = entities[i];
+				if (entity == NULL || !entity->isAlive())
+					continue;
+
+				CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+				if (transform == NULL)
+					continue;
+
+				CRenderMeshData* renderMesh = GET_ENTITY_DATA(entity, CRenderMeshData);
+				bool haveMesh = renderMesh != NULL && renderMesh->getMesh() != NULL && !renderMesh->isSkinnedMesh();
+
+				CLightCullingData* lightData = GET_ENTITY_DATA(entity, CLightCullingData);
+				bool haveLight = lightData != NULL && lightData->Light != NULL && lightData->Light->getRenderLightType() != CLight::Realtime;
+
+				if (!haveMesh && !haveLight)
+					continue;
+
+				h = hashCombine(h, (u32)entity->getIndex());
+
+				const f32* m = transform->World.pointer();
+				for (int j = 0; j < 16; j++)
+					h = hashCombine(h, m[j]);
+
+				if (haveMesh)
+				{
+					IMesh* mesh = renderMesh->getMesh();
+					h = hashCombine(h, (u32)(size_t)mesh);
+					h = hashCombine(h, mesh->getMeshBufferCount());
+				}
+
+				if (haveLight)
+				{
+					// the color, intensity, radius... changes increase the light revision
+					h = hashCombine(h, (u32)lightData->LightType);
+					h = hashCombine(h, (u32)lightData->Light->getChangeRevision());
+
+					if (lightData->LightType == CLight::AreaLight)
+					{
+						CAreaLight* areaLight = (CAreaLight*)lightData->Light;
+						h = hashCombine(h, areaLight->getSizeX());
+						h = hashCombine(h, areaLight->getSizeY());
+					}
+				}
+			}
+
+			return h;
+		}
+
+		void CCPUBaker::captureScene(CEntityManager* entityMgr)
+		{
+			if (entityMgr == NULL)
+				return;
+
+			// the entity manager can be the same, but the entities, transforms or lights are changed
+			u32 revision = getSceneRevision(entityMgr);
+			if (entityMgr == m_sceneEntityMgr && revision == m_sceneRevision && !m_sceneChanged)
+				return;
+
+			clearScene();
+
+			CEntity** entities = entityMgr->getEntities();
+			int numEntity = entityMgr->getNumEntities();
+
+			for (int i = 0; i < numEntity; i++)
+			{
+				CEntity* entity = entities[i];
+				if (entity == NULL || !entity->isAlive())
+					continue;
+
+				CWorldTransformData* transform = GET_ENTITY_DATA(entity, CWorldTransformData);
+				if (transform == NULL)
+					continue;
+
+				// the skinned meshes are not baked
+				CRenderMeshData* renderMesh = GET_ENTITY_DATA(entity, CRenderMeshData);
+				if (renderMesh != NULL && renderMesh->getMesh() != NULL && !renderMesh->isSkinnedMesh())
+					addMesh(renderMesh->getMesh(), transform->World, m_albedo);
+
+				CLightCullingData* lightData = GET_ENTITY_DATA(entity, CLightCullingData);
+				if (lightData == NULL || lightData->Light == NULL)
+					continue;
+
+				CLight* light = lightData->Light;
+				if (light->getRenderLightType() == CLight::Realtime)
+					continue;
+
+				switch (lightData->LightType)
+				{
+				case CLight::DirectionalLight:
+					addDirectionalLight(light->getDirection(), light->getColor(), light->getIntensity());
+					break;
+				case CLight::PointLight:
+				{
+					CPointLight* pointLight = (CPointLight*)light;
+					addPointLight(pointLight->getPosition(), light->getColor(), light->getIntensity(), light->getRadius());
+				}
+				break;
+				case CLight::AreaLight:
+				{
+					CAreaLight* areaLight = (CAreaLight*)light;
+					addAreaLight(areaLight->getWorldTransform(), areaLight->getSizeX(), areaLight->getSizeY(), light->getColor(), light->getIntensity());
+				}
+				break;
+				default:
+					break;
+				}
+			}
+
+			buildScene();
+
+			m_sceneEntityMgr = entityMgr;
+			m_sceneRevision = revision;
+			m_sceneChanged = false;
+		}
+
+		void CCPUBaker::addMesh(IMesh* mesh, const core::matrix4& transform, const core::vector3df& albedo)
+		{
+			CBakeCollisionNode* node = new CBakeCollisionNode(albedo);
+
+			for (u32 i = 0, n = mesh->getMeshBufferCount(); i < n; i++)
+			{
+				IMeshBuffer* mb = mesh->getMeshBuffer(i);
+				if (mb->getPrimitiveType() != scene::EPT_TRIANGLES || mb->getVertexBufferCount() == 0)
+					continue;
+
+				IVertexBuffer* vb = mb->getVertexBuffer(0);
+				IIndexBuffer* ib = mb->getIndexBuffer();
+
+				// all the vertex types begin with the position
+				u8* vertices = (u8*)vb->getVertices();
+				u32 stride = vb->getVertexSize();
+				u32 numIndex = ib->getIndexCount();
+
+				u16* indices16 = (u16*)ib->getIndices();
+				u32* indices32 = (u32*)ib->getIndices();
+				bool is32Bit = ib->getType() == video::EIT_32BIT;
+
+				core::vector3df v[3];
+				for (u32 j = 0; j + 2 < numIndex; j += 3)
+				{
+					for (u32 k = 0; k < 3; k++)
+					{
+						u32 id = is32Bit ? indices32[j + k] : indices16[j + k];
+						v[k] = *(core::vector3df*)(vertices + id * stride);
+						transform.transformVect(v[k]);
+					}
+					node->Triangles.push_back(core::triangle3df(v[0], v[1], v[2]));
+				}
+			}
+
+			if (node->Triangles.size() > 0)
+				m_bvh.addCollision(node);
+			else
+				delete node;
+		}
+
+		void CCPUBaker::addTriangles(const core::triangle3df* tris, u32 count, const core::vector3df& albedo)
+		{
+			CBakeCollisionNode* node = new CBakeCollisionNode(albedo);
+			for (u32 i = 0; i < count; i++)
+				node->Triangles.push_back(tris[i]);
+			m_bvh.addCollision(node);
+		}
+
+		void CCPUBaker::addDirectionalLight(const core::vector3df& direction, const SColorf& color, float intensity)
+		{
+			SBakeLight light;
+			light.Type = CLight::DirectionalLight;
+			light.Color.set(color.r * intensity, color.g * intensity, color.b * intensity);
+			light.Direction = direction;
+			light.Direction.normalize();
+			light.Radius = 0.0f;
+			m_lights.push_back(light);
+		}
+
+		void CCPUBaker::addPointLight(const core::vector3df& position, const SColorf& color, float intensity, float radius)
+		{
+			SBakeLight light;
+			light.Type = CLight::PointLight;
+			light.Color.set(color.r * intensity, color.g * intensity, color.b * intensity);
+			light.Position = position;
+			light.Radius = radius;
+			m_lights.push_back(light);
+		}
+
+		void CCPUBaker::addAreaLight(const core::matrix4& transform, float sizeX, float sizeY, const SColorf& color, float intensity)
+		{
+			SBakeLight light;
+			light.Type = CLight::AreaLight;
+			light.Color.set(color.r * intensity, color.g * intensity, color.b * intensity);
+			light.Position = transform.getTranslation();
+
+			// the same with AREA_LIGHT_DIR_X, AREA_LIGHT_DIR_Y and AREA_LIGHT_SIZE in CShaderLighting
+			light.AxisX.set(sizeX * 0.5f, 0.0f, 0.0f);
+			light.AxisY.set(0.0f, sizeY * 0.5f, 0.0f);
+			transform.rotateVect(light.AxisX);
+			transform.rotateVect(light.AxisY);
+
+			// the surface is lit if it faces to this normal (see LibAreaLightShadow)
+			light.Direction = -light.AxisX.crossProduct(light.AxisY);
+			light.Direction.normalize();
+			light.Radius = 0.0f;
+			m_lights.push_back(light);
+		}
+
+		void CCPUBaker::buildScene()
+		{
+			if (m_bvh.getCollisionCount() > 0)
+				m_bvh.build();
+		}
+
+		void CCPUBaker::beginBake(int count)
+		{
+			m_sh.set_used(count);
+			for (int i = 0; i < count; i++)
+				m_sh[i].zero();
+
+			m_result.set_used(count);
+			m_numPass = 0;
+			m_numSample = 0;
+		}
+
+		void CCPUBaker::bakePass(const core::vector3df* position,
+			const core::vector3df* normal,
+			int count,
+			int numFace)
+		{
+			if ((int)m_sh.size() != count)
+				beginBake(count);
+
+			// the full sphere on the probes, the hemisphere on the surfaces
+			bool sphere = numFace >= NUM_FACES;
+			float invPdf = sphere ? 4.0f * core::PI : 2.0f * core::PI;
+
+			u32 samples = m_samplesPerPass;
+			u32 firstSample = m_numSample;
+			CSH9* sh = m_sh.pointer();
+
+			System::CJobScheduler::getInstance()->parallelFor(0, count, PARALLEL_BAKE_GRAIN, [&](int from, int to)
+				{
+					for (int i = from; i < to; i++)
+					{
+						core::vector3df n = normal[i];
+						n.normalize();
+
+						core::vector3df origin = position[i] + n * m_bias;
+						u32 pointSeed = hashU32(m_seed ^ hashU32((u32)i));
+
+						for (u32 s = 0; s < samples; s++)
+						{
+							// the same sequence for the same point & sample, on any thread
+							u32 rng = hashU32(pointSeed + firstSample + s);
+
+							core::vector3df dir = sphere ? sampleSphere(rng) : sampleHemisphere(n, rng);
+							core::vector3df radiance = traceRadiance(origin, dir, rng);
+
+							sh[i].projectAddOntoSH(dir, radiance * invPdf);
+						}
+
+						if (m_bakeDirectLight)
+						{
+							u32 rng = hashU32(pointSeed ^ (firstSample + 0x9e3779b9));
+
+							CSH9 direct;
+							projectDirectLight(origin, n, numFace, rng, direct);
+							sh[i] += direct * (float)samples;
+						}
+					}
+				});
+
+			m_numPass++;
+			m_numSample += samples;
+		}
+
+		void CCPUBaker::bake(CEntityManager* entityMgr,
+			const core::vector3df* position,
+			const core::vector3df* normal,
+			const core::vector3df* tangent,
+			const core::vector3df* binormal,
+			int count,
+			int numFace)
+		{
+			captureScene(entityMgr);
+
+			beginBake(count);
+			bakePass(position, normal, count, numFace);
+		}
+
+		const CSH9& CCPUBaker::getSH(int i)
+		{
+			m_result[i] = m_sh[i];
+			if (m_numSample > 0)
+				m_result[i] *= 1.0f / (float)m_numSample;
+			return m_result[i];
+		}
+
+		core::vector3df CCPUBaker::traceRadiance(core::vector3df origin, core::vector3df dir, u32& rng)
+		{
+			core::vector3df radiance(0.0f, 0.0f, 0.0f);
+			core::vector3df throughput(1.0f, 1.0f, 1.0f);
+
+			for (u32 bounce = 0; bounce < m_maxBounce; bounce++)
+			{
+				core::line3df ray(origin, origin + dir * m_maxDistance);
+				f32 distance = m_maxDistance * m_maxDistance;
+
+				core::vector3df hitPoint;
+				core::triangle3df triangle;
+				CCollisionNode* node = NULL;
+
+				if (!m_bvh.getCollisionPoint(ray, distance, hitPoint, triangle, node))
+				{
+					radiance += throughput * m_skyColor;
+					break;
+				}
+
+				// the triangles are double-sided
+				core::vector3df n = triangle.getNormal();
+				n.normalize();
+				if (n.dotProduct(dir) > 0.0f)
+					n = -n;
+
+				const core::vector3df& albedo = ((CBakeCollisionNode*)node)->Albedo;
+				origin = hitPoint + n * m_bias;
+
+				// lambert diffuse
+				radiance += throughput * albedo * sampleDirectLight(origin, n, rng) * core::RECIPROCAL_PI;
+
+				// the cosine sampling cancels the cos / pi of lambert brdf
+				throughput *= albedo;
+
+				// russian roulette
+				if (bounce >= 2)
+				{
+					float q = core::clamp(core::max_(throughput.X, throughput.Y, throughput.Z), 0.05f, 0.95f);
+					if (randomFloat(rng) > q)
+						break;
+					throughput /= q;
+				}
+
+				dir = sampleCosine(n, rng);
+			}
+
+			return radiance;
+		}
+
+		core::vector3df CCPUBaker::sampleDirectLight(const core::vector3df& position, const core::vector3df& normal, u32& rng)
+		{
+			core::vector3df result(0.0f, 0.0f, 0.0f);
+
+			for (u32 i = 0, n = m_lights.size(); i < n; i++)
+			{
+				const SBakeLight& light = m_lights[i];
+
+				if (light.Type == CLight::DirectionalLight)
+				{
+					core::vector3df l = -light.Direction;
+					float NdotL = normal.dotProduct(l);
+					if (NdotL > 0.0f && !isOccluded(position, position + l * m_maxDistance))
+						result += light.Color * NdotL;
+				}
+				else if (light.Type == CLight::PointLight)
+				{
+					core::vector3df l = light.Position - position;
+					float d = l.getLength();
+					if (d <= 0.0f || d >= light.Radius)
+						continue;
+
+					l /= d;
+					float NdotL = normal.dotProduct(l);
+
+					// the same attenuation with the point light shader
+					float attenuation = 1.0f - d / light.Radius;
+					if (NdotL > 0.0f && !isOccluded(position, light.Position))
+						result += light.Color * (NdotL * attenuation);
+				}
+				else if (light.Type == CLight::AreaLight)
+				{
+					float area = 4.0f * light.AxisX.getLength() * light.AxisY.getLength();
+					float weight = area / (core::PI * m_areaLightSamples);
+
+					for (u32 s = 0; s < m_areaLightSamples; s++)
+					{
+						core::vector3df p = light.Position +
+							light.AxisX * (2.0f * randomFloat(rng) - 1.0f) +
+							light.AxisY * (2.0f * randomFloat(rng) - 1.0f);
+
+						core::vector3df l = p - position;
+						float d2 = core::max_(l.getLengthSQ(), 0.01f);
+						l.normalize();
+
+						float cosSurface = normal.dotProduct(l);
+						float cosLight = light.Direction.dotProduct(l);
+						if (cosSurface > 0.0f && cosLight > 0.0f && !isOccluded(position, p))
+							result += light.Color * (cosSurface * cosLight * weight / d2);
+					}
+				}
+			}
+
+			return result;
+		}
+
+		void CCPUBaker::projectDirectLight(const core::vector3df& position, const core::vector3df& normal, int numFace, u32& rng, CSH9& sh)
+		{
+			sh.zero();
+
+			bool sphere = numFace >= NUM_FACES;
+
+			for (u32 i = 0, n = m_lights.size(); i < n; i++)
+			{
+				const SBakeLight& light = m_lights[i];
+
+				if (light.Type == CLight::DirectionalLight)
+				{
+					core::vector3df l = -light.Direction;
+					if ((sphere || normal.dotProduct(l) > 0.0f) && !isOccluded(position, position + l * m_maxDistance))
+						sh.projectAddOntoSH(l, light.Color);
+				}
+				else if (light.Type == CLight::PointLight)
+				{
+					core::vector3df l = light.Position - position;
+					float d = l.getLength();
+					if (d <= 0.0f || d >= light.Radius)
+						continue;
+
+					l /= d;
+					if ((sphere || normal.dotProduct(l) > 0.0f) && !isOccluded(position, light.Position))
+						sh.projectAddOntoSH(l, light.Color * (1.0f - d / light.Radius));
+				}
+				else if (light.Type == CLight::AreaLight)
+				{
+					float area = 4.0f * light.AxisX.getLength() * light.AxisY.getLength();
+					float weight = area / (core::PI * m_areaLightSamples);
+
+					for (u32 s = 0; s < m_areaLightSamples; s++)
+					{
+						core::vector3df p = light.Position +
+							light.AxisX * (2.0f * randomFloat(rng) - 1.0f) +
+							light.AxisY * (2.0f * randomFloat(rng) - 1.0f);
+
+						core::vector3df l = p - position;
+						float d2 = core::max_(l.getLengthSQ(), 0.01f);
+						l.normalize();
+
+						float cosLight = light.Direction.dotProduct(l);
+						if (cosLight > 0.0f && (sphere || normal.dotProduct(l) > 0.0f) && !isOccluded(position, p))
+							sh.projectAddOntoSH(l, light.Color * (cosLight * weight / d2));
+					}
+				}
+			}
+		}
+
+		bool CCPUBaker::isOccluded(const core::vector3df& from, const core::vector3df& to)
+		{
+			core::vector3df d = to - from;
+			float length = d.getLength();
+			if (length <= m_bias)
+				return false;
+
+			// stop before the light
+			core::line3df ray(from, from + d * ((length - m_bias) / length));
+			f32 distance = ray.getLengthSQ();
+
+			core::vector3df hitPoint;
+			core::triangle3df triangle;
+			CCollisionNode* node = NULL;
+			return m_bvh.getCollisionPoint(ray, distance, hitPoint, triangle, node);
+		}
+	}
+}
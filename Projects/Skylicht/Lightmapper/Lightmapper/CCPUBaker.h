@@ -0,0 +1,236 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "CSH9.h"
+#include "Entity/CEntityManager.h"
+#include "Collision/CBVHBuilder.h"
+
+namespace Skylicht
+{
+	namespace Lightmapper
+	{
+		// The triangles of a mesh in world space, with the diffuse color that use to bounce the light
+		class CBakeCollisionNode : public CCollisionNode
+		{
+		public:
+			core::vector3df Albedo;
+
+		public:
+			CBakeCollisionNode(const core::vector3df& albedo) :
+				CCollisionNode(NULL, NULL, NULL),
+				Albedo(albedo)
+			{
+			}
+		};
+
+		struct SBakeLight
+		{
+			int Type;
+
+			// color * intensity
+			core::vector3df Color;
+
+			// the light direction of directional light, the normal of area light
+			core::vector3df Direction;
+
+			core::vector3df Position;
+
+			// the half size of area light
+			core::vector3df AxisX;
+			core::vector3df AxisY;
+
+			float Radius;
+		};
+
+		/*
+		* CCPUBaker
+		* Path trace the scene on the job threads, without render the hemicube on GPU.
+		* - The triangles are traced by CBVHBuilder
+		* - The lights are sampled at every bounce (next event estimation), the path is stopped by russian roulette
+		* - The random sequence is hashed from (point, sample), so the result is the same with any number of thread
+		* - Call bakePass many times to accumulate the SH progressive
+		*/
+		class CCPUBaker
+		{
+		protected:
+			CBVHBuilder m_bvh;
+
+			core::array<SBakeLight> m_lights;
+
+			CEntityManager* m_sceneEntityMgr;
+
+			// the revision of the captured meshes and lights, see getSceneRevision
+			u32 m_sceneRevision;
+
+			bool m_sceneChanged;
+
+			core::array<CSH9> m_sh;
+
+			core::array<CSH9> m_result;
+
+			u32 m_numPass;
+
+			u32 m_numSample;
+
+			u32 m_samplesPerPass;
+
+			u32 m_maxBounce;
+
+			u32 m_areaLightSamples;
+
+			u32 m_seed;
+
+			bool m_bakeDirectLight;
+
+			core::vector3df m_albedo;
+
+			core::vector3df m_skyColor;
+
+			float m_bias;
+
+			float m_maxDistance;
+
+		public:
+			CCPUBaker();
+
+			virtual ~CCPUBaker();
+
+			void clearScene();
+
+			// collect the static meshes and the lights of entity manager, skip if the scene revision is not changed
+			void captureScene(CEntityManager* entityMgr);
+
+			// hash of the static meshes, their transform and the baked lights, it changes when the scene must be captured again
+			u32 getSceneRevision(CEntityManager* entityMgr);
+
+			void addMesh(IMesh* mesh, const core::matrix4& transform, const core::vector3df& albedo);
+
+			void addTriangles(const core::triangle3df* tris, u32 count, const core::vector3df& albedo);
+
+			void addDirectionalLight(const core::vector3df& direction, const SColorf& color, float intensity);
+
+			void addPointLight(const core::vector3df& position, const SColorf& color, float intensity, float radius);
+
+			void addAreaLight(const core::matrix4& transform, float sizeX, float sizeY, const SColorf& color, float intensity);
+
+			// build the BVH after add the triangles
+			void buildScene();
+
+			// reset the accumulated SH
+			void beginBake(int count);
+
+			// add the samples of 1 pass to the accumulated SH
+			void bakePass(const core::vector3df* position,
+				const core::vector3df* normal,
+				int count,
+				int numFace);
+
+			// capture the scene, reset and bake 1 pass
+			virtual void bake(CEntityManager* entityMgr,
+				const core::vector3df* position,
+				const core::vector3df* normal,
+				const core::vector3df* tangent,
+				const core::vector3df* binormal,
+				int count,
+				int numFace);
+
+			const CSH9& getSH(int i);
+
+			inline int getMaxMT()
+			{
+				return 4096;
+			}
+
+			inline u32 getNumPass()
+			{
+				return m_numPass;
+			}
+
+			inline u32 getNumLight()
+			{
+				return m_lights.size();
+			}
+
+			inline void invalidateScene()
+			{
+				m_sceneChanged = true;
+			}
+
+			inline void setSamplesPerPass(u32 samples)
+			{
+				m_samplesPerPass = core::max_(samples, 1u);
+			}
+
+			inline u32 getSamplesPerPass()
+			{
+				return m_samplesPerPass;
+			}
+
+			inline void setMaxBounce(u32 bounce)
+			{
+				m_maxBounce = core::max_(bounce, 1u);
+			}
+
+			inline u32 getMaxBounce()
+			{
+				return m_maxBounce;
+			}
+
+			inline void setSeed(u32 seed)
+			{
+				m_seed = seed;
+			}
+
+			// the gpu baker does not render the light source, so the direct light at bake point is skipped by default
+			inline void setBakeDirectLight(bool b)
+			{
+				m_bakeDirectLight = b;
+			}
+
+			inline void setAlbedo(const core::vector3df& albedo)
+			{
+				m_albedo = albedo;
+			}
+
+			inline void setSkyColor(const core::vector3df& color)
+			{
+				m_skyColor = color;
+			}
+
+		protected:
+
+			core::vector3df traceRadiance(core::vector3df origin, core::vector3df dir, u32& rng);
+
+			// the irradiance of all lights at the surface
+			core::vector3df sampleDirectLight(const core::vector3df& position, const core::vector3df& normal, u32& rng);
+
+			// project the light sources that visible at the bake point to SH
+			void projectDirectLight(const core::vector3df& position, const core::vector3df& normal, int numFace, u32& rng, CSH9& sh);
+
+			bool isOccluded(const core::vector3df& from, const core::vector3df& to);
+		};
+	}
+}
@@ -38,7 +38,9 @@ namespace Skylicht
 		CLightmapper::CLightmapper() :
 			m_singleBaker(NULL),
 			m_multiBaker(NULL),
-			m_gpuBaker(NULL)
+			m_gpuBaker(NULL),
+			m_cpuBaker(NULL),
+			m_useCPUBaker(false)
 		{
 
 		}
@@ -67,6 +69,12 @@ namespace Skylicht
 				delete m_gpuBaker;
 				m_gpuBaker = NULL;
 			}
+
+			if (m_cpuBaker != NULL)
+			{
+				delete m_cpuBaker;
+				m_cpuBaker = NULL;
+			}
 		}
 
 		void CLightmapper::initBaker(u32 hemisphereBakeSize)
@@ -87,11 +95,15 @@ namespace Skylicht
 			if (m_gpuBaker != NULL)
 				delete m_gpuBaker;
 
+			if (m_cpuBaker != NULL)
+				delete m_cpuBaker;
+
 			g_hemisphereBakeSize = size;
 
 			m_singleBaker = new CBaker();
 			m_multiBaker = new CMTBaker();
 			m_gpuBaker = new CGPUBaker();
+			m_cpuBaker = new CCPUBaker();
 		}
 
 		const CSH9& CLightmapper::bakeAtPosition(
@@ -108,6 +120,13 @@ namespace Skylicht
 				return m_temp;
 			}
 
+			if (m_useCPUBaker)
+			{
+				m_cpuBaker->bake(entityMgr, &position, &normal, &tangent, &binormal, 1, numFace);
+				m_temp = m_cpuBaker->getSH(0);
+				return m_temp;
+			}
+
 			return m_singleBaker->bake(camera, rp, entityMgr, position, normal, tangent, binormal, numFace);
 		}
 
@@ -129,6 +148,16 @@ namespace Skylicht
 				return;
 			}
 
+			if (m_useCPUBaker)
+			{
+				// path trace all the positions at once, the points are split to the job threads
+				m_cpuBaker->bake(entityMgr, position, normal, tangent, binormal, count, numFace);
+
+				for (int i = 0; i < count; i++)
+					out.push_back(m_cpuBaker->getSH(i));
+				return;
+			}
+
 			// default use multi thread bakder
 			CMTBaker* baker = m_multiBaker;
 
@@ -241,6 +270,60 @@ namespace Skylicht
 				(int)position.size());
 		}
 
+		void CLightmapper::bakeRasterisation(CRasterisation* raster, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr)
+		{
+			core::array<SBakePixel>& pixels = raster->getBakePixelQueue();
+			u32 count = pixels.size();
+			if (count == 0)
+				return;
+
+			core::array<core::vector3df> positions;
+			core::array<core::vector3df> normals;
+			core::array<core::vector3df> tangents;
+			core::array<core::vector3df> binormals;
+
+			positions.set_used(count);
+			normals.set_used(count);
+			tangents.set_used(count);
+			binormals.set_used(count);
+
+			for (u32 i = 0; i < count; i++)
+			{
+				SBakePixel& p = pixels[i];
+
+				normals[i] = p.Normal;
+				tangents[i] = p.Tangent;
+				binormals[i] = p.Binormal;
+
+				normals[i].normalize();
+				tangents[i].normalize();
+				binormals[i].normalize();
+
+				// move 2cm
+				positions[i] = p.Position + normals[i] * 0.02f;
+			}
+
+			CBaseRP::setBakeLightmapMode(true);
+
+			// only the pixels that can not interpolate are in the queue
+			std::vector<CSH9> resultSH;
+			bakeAtPosition(
+				camera,
+				rp,
+				entityMgr,
+				positions.pointer(),
+				normals.pointer(),
+				tangents.pointer(),
+				binormals.pointer(),
+				resultSH,
+				(int)count,
+				5);
+
+			CBaseRP::setBakeLightmapMode(false);
+
+			raster->flushPixel(resultSH);
+		}
+
 		int CLightmapper::bakeMeshBuffer(IMeshBuffer* mb, const core::matrix4& transform, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr, int begin, int count, core::array<SColor>& outColor, core::array<CSH9>& outSH)
 		{
 			if (mb->getVertexBufferCount() == 0)
@@ -28,6 +28,8 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "CBaker.h"
 #include "CMTBaker.h"
 #include "CGPUBaker.h"
+#include "CCPUBaker.h"
+#include "Rasterisation/CRasterisation.h"
 #include "LightProbes/CLightProbe.h"
 
 namespace Skylicht
@@ -44,6 +46,9 @@ namespace Skylicht
 			CBaker* m_singleBaker;
 			CMTBaker* m_multiBaker;
 			CGPUBaker* m_gpuBaker;
+			CCPUBaker* m_cpuBaker;
+
+			bool m_useCPUBaker;
 
 			CSH9 m_temp;
 
@@ -78,8 +83,26 @@ namespace Skylicht
 
 			void bakeProbes(std::vector<core::vector3df>& position, std::vector<CSH9>& probes, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr);
 
+			void bakeRasterisation(CRasterisation* raster, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr);
+
 			int bakeMeshBuffer(IMeshBuffer* mb, const core::matrix4& transform, CCamera* camera, IRenderPipeline* rp, CEntityManager* entityMgr, int begin, int count, core::array<SColor>& outColor, core::array<CSH9>& outSH);
 
+			// path trace on CPU instead of render the hemicube, the camera and render pipeline can be NULL
+			inline void setUseCPUBaker(bool b)
+			{
+				m_useCPUBaker = b;
+			}
+
+			inline bool isUseCPUBaker()
+			{
+				return m_useCPUBaker;
+			}
+
+			inline CCPUBaker* getCPUBaker()
+			{
+				return m_cpuBaker;
+			}
+
 			static void setNumThread(u32 num);
 
 			static void setHemisphereBakeSize(u32 size);
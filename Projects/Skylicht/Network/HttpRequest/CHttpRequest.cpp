@@ -26,6 +26,7 @@ https://github.com/skylicht-lab/skylicht-engine
 #include "Crypto/md5.h"
 #include "CMD5.h"
 #include "CHttpRequest.h"
+#include "CHttpRequestManager.h"
 
 #ifndef __EMSCRIPTEN__
 
@@ -88,8 +89,9 @@ namespace Skylicht
 			return ret;
 		}
 
-		CHttpRequest::CHttpRequest(IHttpStream* stream) :
-			IHttpRequest(stream)
+		CHttpRequest::CHttpRequest(IHttpStream* stream, CHttpRequestManager* manager) :
+			IHttpRequest(stream),
+			m_manager(manager)
 		{
 			m_curl = curl_easy_init();
 
@@ -114,8 +116,20 @@ namespace Skylicht
 			// firefox agent
 			curl_easy_setopt(m_curl, CURLOPT_USERAGENT, "Mozilla/5.0 (Windows NT 10.0; Win64; x64)");
 
-			m_multiHandle = curl_multi_init();
-			curl_multi_add_handle(m_multiHandle, m_curl);
+			if (m_manager != NULL)
+			{
+				// the transfer is polled by the shared multi handle
+				m_multiHandle = NULL;
+				m_manager->initHandle(m_curl);
+				curl_easy_setopt(m_curl, CURLOPT_PRIVATE, this);
+			}
+			else
+			{
+				m_multiHandle = curl_multi_init();
+				curl_multi_add_handle(m_multiHandle, m_curl);
+			}
+
+			m_needContinue = 0;
 
 			m_cancel = false;
 			m_sendRequest = false;
@@ -150,6 +164,9 @@ namespace Skylicht
 			if (m_headerlist)
 				curl_slist_free_all(m_headerlist);
 
+			if (m_manager != NULL)
+				m_manager->removeRequest(this);
+
 			if (m_multiHandle != NULL)
 			{
 				curl_multi_remove_handle(m_multiHandle, m_curl);
@@ -251,21 +268,7 @@ namespace Skylicht
 				curl_easy_setopt(m_curl, CURLOPT_COOKIEJAR, m_sessionFile.c_str());
 			}
 
-			curl_multi_remove_handle(m_multiHandle, m_curl);
-			curl_multi_add_handle(m_multiHandle, m_curl);
-			curl_multi_perform(m_multiHandle, &m_needContinue);
-
-			m_httpCode = -1;
-			m_downloading = 0;
-			m_sizeBuffer = 0;
-
-			m_bytePerSecond = 0;
-			m_totalBytePerSecond = 0;
-
-			m_requestTime = os::Timer::getTime();
-			m_time = m_requestTime;
-			m_revcTime = m_requestTime;
-			m_currentTime = m_requestTime;
+			startTransfer();
 		}
 
 		void CHttpRequest::sendRequestByDelete()
@@ -291,9 +294,7 @@ namespace Skylicht
 				curl_easy_setopt(m_curl, CURLOPT_HTTPHEADER, m_headerlist);
 			}
 
-			curl_multi_remove_handle(m_multiHandle, m_curl);
-			curl_multi_add_handle(m_multiHandle, m_curl);
-			curl_multi_perform(m_multiHandle, &m_needContinue);
+			startTransfer();
 		}
 
 		void CHttpRequest::sendRequestByPost()
@@ -360,9 +361,7 @@ namespace Skylicht
 				curl_easy_setopt(m_curl, CURLOPT_HTTPHEADER, m_headerlist);
 			}
 
-			curl_multi_remove_handle(m_multiHandle, m_curl);
-			curl_multi_add_handle(m_multiHandle, m_curl);
-			curl_multi_perform(m_multiHandle, &m_needContinue);
+			startTransfer();
 		}
 
 		void CHttpRequest::sendRequestByPostJson()
@@ -430,9 +429,7 @@ namespace Skylicht
 				curl_easy_setopt(m_curl, CURLOPT_COOKIEJAR, m_sessionFile.c_str());
 			}
 
-			curl_multi_remove_handle(m_multiHandle, m_curl);
-			curl_multi_add_handle(m_multiHandle, m_curl);
-			curl_multi_perform(m_multiHandle, &m_needContinue);
+			startTransfer();
 		}
 
 		void CHttpRequest::sendRequestByGet()
@@ -457,9 +454,38 @@ namespace Skylicht
 				curl_easy_setopt(m_curl, CURLOPT_COOKIEJAR, m_sessionFile.c_str());
 			}
 
-			curl_multi_remove_handle(m_multiHandle, m_curl);
-			curl_multi_add_handle(m_multiHandle, m_curl);
-			curl_multi_perform(m_multiHandle, &m_needContinue);
+			startTransfer();
+		}
+
+		void CHttpRequest::startTransfer()
+		{
+			if (m_manager != NULL)
+			{
+				m_needContinue = 1;
+				m_manager->addRequest(this);
+			}
+			else
+			{
+				curl_multi_remove_handle(m_multiHandle, m_curl);
+				curl_multi_add_handle(m_multiHandle, m_curl);
+				curl_multi_perform(m_multiHandle, &m_needContinue);
+
+				// the transfer to a local server can be done in the first perform
+				if (m_needContinue == 0)
+				{
+					CURLcode code = CURLE_OK;
+					int msgInQueue = 0;
+					CURLMsg* msg = NULL;
+
+					while ((msg = curl_multi_info_read(m_multiHandle, &msgInQueue)) != NULL)
+					{
+						if (msg->msg == CURLMSG_DONE)
+							code = msg->data.result;
+					}
+
+					onFinish(code);
+				}
+			}
 		}
 
 		bool CHttpRequest::checkTimeOut()
@@ -471,6 +497,9 @@ namespace Skylicht
 
 		bool CHttpRequest::updateRequest()
 		{
+			if (m_manager != NULL)
+				return updateSharedRequest();
+
 			if (m_needContinue == 0)
 			{
 				return true;
@@ -558,6 +587,59 @@ namespace Skylicht
 				m_httpCode = -1;
 			}
 
+			flushDownloadBuffer();
+			return true;
+		}
+
+		bool CHttpRequest::updateSharedRequest()
+		{
+			if (m_needContinue == 0)
+				return true;
+
+			// the transfer is polled by CHttpRequestManager::update, onFinish is called when it is done
+			m_currentTime = os::Timer::getTime();
+
+			// calc speed download
+			if (m_currentTime - m_time > 1000)
+			{
+				m_bytePerSecond = m_totalBytePerSecond;
+				m_totalBytePerSecond = 0;
+				m_time = m_currentTime;
+			}
+
+			// quit request
+			if (checkTimeOut() == false && m_checkTimeout == true)
+			{
+				os::Printer::log("Http request time out");
+				m_manager->removeRequest(this);
+				m_needContinue = 0;
+				m_isTimeOut = true;
+				return true;
+			}
+
+			return false;
+		}
+
+		void CHttpRequest::onFinish(CURLcode code)
+		{
+			m_needContinue = 0;
+
+			if (code == CURLE_OK)
+			{
+				long ret = -1;
+				curl_easy_getinfo(m_curl, CURLINFO_RESPONSE_CODE, &ret);
+				m_httpCode = (int)ret;
+			}
+			else
+			{
+				m_httpCode = -1;
+			}
+
+			flushDownloadBuffer();
+		}
+
+		void CHttpRequest::flushDownloadBuffer()
+		{
 			// add the end buffer...
 			if (m_sizeBuffer > 0)
 			{
@@ -572,8 +654,6 @@ namespace Skylicht
 
 				m_sizeBuffer = 0;
 			}
-
-			return true;
 		}
 
 		void CHttpRequest::onRevcData(unsigned char* lpData, unsigned long size, unsigned long num)
@@ -40,6 +40,8 @@ namespace Skylicht
 {
 	namespace Network
 	{
+		class CHttpRequestManager;
+
 		class CHttpRequest : public IHttpRequest
 		{
 		protected:
@@ -47,6 +49,9 @@ namespace Skylicht
 			CURL* m_curl;
 			CURLM* m_multiHandle;
 
+			// the shared multi handle, NULL if the request uses its own multi handle
+			CHttpRequestManager* m_manager;
+
 			void* m_formpost;
 			void* m_lastptr;
 
@@ -77,7 +82,8 @@ namespace Skylicht
 			bool m_checkTimeout;
 
 		public:
-			CHttpRequest(IHttpStream* stream);
+			// the request is driven by the manager if it is not NULL, else it uses its own multi handle
+			CHttpRequest(IHttpStream* stream, CHttpRequestManager* manager = NULL);
 
 			virtual ~CHttpRequest();
 
@@ -102,6 +108,19 @@ namespace Skylicht
 
 			virtual bool updateRequest();
 
+			// called by CHttpRequestManager when the transfer is done
+			void onFinish(CURLcode code);
+
+			inline CHttpRequestManager* getManager()
+			{
+				return m_manager;
+			}
+
+			inline CURL* getHandle()
+			{
+				return m_curl;
+			}
+
 			inline bool isSendRequest()
 			{
 				return m_sendRequest;
@@ -147,6 +166,14 @@ namespace Skylicht
 			{
 				return m_requestTimeOut;
 			}
+
+		protected:
+
+			void startTransfer();
+
+			bool updateSharedRequest();
+
+			void flushDownloadBuffer();
 		};
 	}
 }
@@ -0,0 +1,179 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "pch.h"
+#include "CHttpRequestManager.h"
+#include "CHttpRequest.h"
+
+#ifndef __EMSCRIPTEN__
+
+namespace Skylicht
+{
+	namespace Network
+	{
+		IMPLEMENT_SINGLETON(CHttpRequestManager);
+
+		CHttpRequestManager::CHttpRequestManager() :
+			m_running(0),
+			m_maxHostConnections(6),
+			m_maxTotalConnections(0),
+			m_multiplex(true)
+		{
+			m_multiHandle = curl_multi_init();
+
+			// the easy handles of the same multi handle already share the connection cache
+			// share the dns and tls session, that are cached on each easy handle by default
+			m_share = curl_share_init();
+			curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+			curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+			curl_multi_setopt(m_multiHandle, CURLMOPT_MAX_HOST_CONNECTIONS, m_maxHostConnections);
+			curl_multi_setopt(m_multiHandle, CURLMOPT_MAX_TOTAL_CONNECTIONS, m_maxTotalConnections);
+			curl_multi_setopt(m_multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+		}
+
+		CHttpRequestManager::~CHttpRequestManager()
+		{
+			for (CHttpRequest* request : m_requests)
+				curl_multi_remove_handle(m_multiHandle, request->getHandle());
+			m_requests.clear();
+
+			curl_multi_cleanup(m_multiHandle);
+			curl_share_cleanup(m_share);
+		}
+
+		CHttpRequest* CHttpRequestManager::createRequest(IHttpStream* stream)
+		{
+			return new CHttpRequest(stream, this);
+		}
+
+		void CHttpRequestManager::initHandle(CURL* curl)
+		{
+			curl_easy_setopt(curl, CURLOPT_SHARE, m_share);
+
+			if (m_multiplex)
+			{
+				// wait for the connection that can multiplex, instead of open the new connection
+				curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+				curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+			}
+		}
+
+		void CHttpRequestManager::addRequest(CHttpRequest* request)
+		{
+			// send again
+			removeRequest(request);
+
+			curl_multi_add_handle(m_multiHandle, request->getHandle());
+			m_requests.push_back(request);
+
+			// start the transfer without wait the next poll
+			curl_multi_perform(m_multiHandle, &m_running);
+		}
+
+		void CHttpRequestManager::removeRequest(CHttpRequest* request)
+		{
+			for (size_t i = 0, n = m_requests.size(); i < n; i++)
+			{
+				if (m_requests[i] == request)
+				{
+					curl_multi_remove_handle(m_multiHandle, request->getHandle());
+					m_requests[i] = m_requests[n - 1];
+					m_requests.pop_back();
+					return;
+				}
+			}
+		}
+
+		void CHttpRequestManager::update()
+		{
+			if (m_requests.size() == 0)
+				return;
+
+			int numFinish = 0;
+			do
+			{
+				CURLMcode result = CURLM_OK;
+				do
+				{
+					result = curl_multi_perform(m_multiHandle, &m_running);
+				} while (result == CURLM_CALL_MULTI_PERFORM);
+
+				if (result != CURLM_OK)
+				{
+					os::Printer::log("CHttpRequestManager: curl multi update failed");
+					return;
+				}
+
+				// dispatch all the finished requests
+				int msgInQueue = 0;
+				CURLMsg* msg = NULL;
+
+				numFinish = 0;
+
+				while ((msg = curl_multi_info_read(m_multiHandle, &msgInQueue)) != NULL)
+				{
+					if (msg->msg != CURLMSG_DONE)
+						continue;
+
+					CHttpRequest* request = NULL;
+					curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&request);
+
+					CURLcode code = msg->data.result;
+
+					// the msg is invalid after remove the handle
+					removeRequest(request);
+
+					if (request)
+						request->onFinish(code);
+
+					numFinish++;
+				}
+
+				// the finished transfers free the connections, perform again to start
+				// the requests that wait for the host connection limit on this frame
+			} while (numFinish > 0 && m_requests.size() > 0);
+		}
+
+		void CHttpRequestManager::setMaxHostConnections(long num)
+		{
+			m_maxHostConnections = num;
+			curl_multi_setopt(m_multiHandle, CURLMOPT_MAX_HOST_CONNECTIONS, m_maxHostConnections);
+		}
+
+		void CHttpRequestManager::setMaxTotalConnections(long num)
+		{
+			m_maxTotalConnections = num;
+			curl_multi_setopt(m_multiHandle, CURLMOPT_MAX_TOTAL_CONNECTIONS, m_maxTotalConnections);
+		}
+
+		void CHttpRequestManager::setEnableMultiplex(bool b)
+		{
+			m_multiplex = b;
+			curl_multi_setopt(m_multiHandle, CURLMOPT_PIPELINING, b ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+		}
+	}
+}
+
+#endif
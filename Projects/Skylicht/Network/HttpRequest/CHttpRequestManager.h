@@ -0,0 +1,122 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "pch.h"
+
+#ifndef __EMSCRIPTEN__
+
+#include "Utils/CSingleton.h"
+#include "curl/curl.h"
+#include "IHttpStream.h"
+
+namespace Skylicht
+{
+	namespace Network
+	{
+		class CHttpRequest;
+
+		/*
+		* CHttpRequestManager
+		* The requests created by createRequest() (or constructed with the manager) are driven by one curl multi handle:
+		* - The connections, DNS and TLS sessions are reused by the requests to the same host
+		* - The requests to a https host are multiplexed on 1 connection if the server supports HTTP/2
+		* - The application calls update() once per frame, and the finished requests are dispatched together
+		* The manager is not thread safe: create, send and update its requests on the main thread.
+		* The requests created by IHttpRequest::create stay on their own multi handle, so they can run on a worker thread.
+		* Release the manager after delete all the requests.
+		*/
+		class CHttpRequestManager
+		{
+		public:
+			DECLARE_SINGLETON(CHttpRequestManager)
+
+		protected:
+			CURLM* m_multiHandle;
+			CURLSH* m_share;
+
+			std::vector<CHttpRequest*> m_requests;
+
+			int m_running;
+
+			long m_maxHostConnections;
+
+			long m_maxTotalConnections;
+
+			bool m_multiplex;
+
+		public:
+			CHttpRequestManager();
+
+			virtual ~CHttpRequestManager();
+
+			// create a request that is driven by this manager
+			CHttpRequest* createRequest(IHttpStream* stream);
+
+			// setup the shared caches on the easy handle of a request
+			void initHandle(CURL* curl);
+
+			void addRequest(CHttpRequest* request);
+
+			void removeRequest(CHttpRequest* request);
+
+			// poll all the transfers, call it once per frame from the application update
+			void update();
+
+			void setMaxHostConnections(long num);
+
+			void setMaxTotalConnections(long num);
+
+			void setEnableMultiplex(bool b);
+
+			inline long getMaxHostConnections()
+			{
+				return m_maxHostConnections;
+			}
+
+			inline long getMaxTotalConnections()
+			{
+				return m_maxTotalConnections;
+			}
+
+			inline bool isEnableMultiplex()
+			{
+				return m_multiplex;
+			}
+
+			inline u32 getRequestCount()
+			{
+				return (u32)m_requests.size();
+			}
+
+			inline int getRunningCount()
+			{
+				return m_running;
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,318 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#include "stdafx.h"
+#include "CJobScheduler.h"
+
+namespace Skylicht
+{
+	namespace System
+	{
+		CJobScheduler* CJobScheduler::s_instance = NULL;
+
+		static thread_local CJobScheduler* s_currentScheduler = NULL;
+		static thread_local int s_currentWorker = -1;
+
+		CJobScheduler::CJobScheduler(int numWorker) :
+			m_running(true),
+			m_pendingJobs(0),
+			m_nextWorker(0)
+		{
+#ifdef USE_JOB_THREAD
+			for (int i = 0; i < numWorker; i++)
+				m_workers.push_back(new SWorker());
+
+			for (int i = 0; i < numWorker; i++)
+				m_workers[i]->Thread = new std::thread(&CJobScheduler::workerLoop, this, i);
+#endif
+		}
+
+		CJobScheduler::~CJobScheduler()
+		{
+#ifdef USE_JOB_THREAD
+			{
+				std::lock_guard<std::mutex> lock(m_sleepLock);
+				m_running = false;
+			}
+			m_wakeup.notify_all();
+
+			for (SWorker* worker : m_workers)
+			{
+				worker->Thread->join();
+				delete worker->Thread;
+				delete worker;
+			}
+#endif
+			m_workers.clear();
+		}
+
+		CJobScheduler* CJobScheduler::getInstance()
+		{
+			if (s_instance == NULL)
+				s_instance = new CJobScheduler(getDefaultWorkerCount());
+			return s_instance;
+		}
+
+		void CJobScheduler::createInstance(int numWorker)
+		{
+			releaseInstance();
+			s_instance = new CJobScheduler(numWorker);
+		}
+
+		void CJobScheduler::releaseInstance()
+		{
+			if (s_instance)
+			{
+				delete s_instance;
+				s_instance = NULL;
+			}
+		}
+
+		int CJobScheduler::getDefaultWorkerCount()
+		{
+#ifdef USE_JOB_THREAD
+			// the main thread also executes the jobs when it waits
+			int n = (int)std::thread::hardware_concurrency() - 1;
+			return n > 0 ? n : 0;
+#else
+			return 0;
+#endif
+		}
+
+		int CJobScheduler::getCurrentWorker()
+		{
+			return s_currentScheduler == this ? s_currentWorker : -1;
+		}
+
+		CJobHandle CJobScheduler::run(const std::function<void()>& func)
+		{
+			return run(func, NULL, 0);
+		}
+
+		CJobHandle CJobScheduler::run(const std::function<void()>& func, const CJobHandle* dependencies, int count)
+		{
+			std::shared_ptr<SJob> job = std::make_shared<SJob>();
+			job->Func = func;
+
+			// hold the job until all dependencies are registered
+			job->Dependencies = 1;
+
+			for (int i = 0; i < count; i++)
+			{
+				const std::shared_ptr<SJob>& dep = dependencies[i].m_job;
+				if (!dep)
+					continue;
+
+				std::lock_guard<std::mutex> lock(dep->Lock);
+				if (!dep->Finished.load(std::memory_order_acquire))
+				{
+					job->Dependencies++;
+					dep->Continuations.push_back(job);
+				}
+			}
+
+			if (job->Dependencies.fetch_sub(1) == 1)
+				push(job);
+
+			return CJobHandle(job);
+		}
+
+		void CJobScheduler::push(const std::shared_ptr<SJob>& job)
+		{
+			int n = (int)m_workers.size();
+			if (n == 0)
+			{
+				// no worker thread
+				execute(job);
+				return;
+			}
+
+#ifdef USE_JOB_THREAD
+			int id = getCurrentWorker();
+			if (id < 0)
+				id = (int)(m_nextWorker++ % (unsigned int)n);
+
+			SWorker* worker = m_workers[id];
+			{
+				std::lock_guard<std::mutex> lock(worker->Lock);
+				worker->Queue.push_back(job);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_sleepLock);
+				m_pendingJobs++;
+			}
+			m_wakeup.notify_one();
+#endif
+		}
+
+		std::shared_ptr<SJob> CJobScheduler::take(int workerId)
+		{
+			std::shared_ptr<SJob> job;
+			int n = (int)m_workers.size();
+			if (n == 0)
+				return job;
+
+			// pop the newest job on own queue
+			if (workerId >= 0)
+			{
+				SWorker* worker = m_workers[workerId];
+				std::lock_guard<std::mutex> lock(worker->Lock);
+				if (!worker->Queue.empty())
+				{
+					job = worker->Queue.back();
+					worker->Queue.pop_back();
+				}
+			}
+
+			// steal the oldest job on another queue
+			if (!job)
+			{
+				int begin = workerId >= 0 ? workerId + 1 : 0;
+				for (int i = 0; i < n && !job; i++)
+				{
+					int id = (begin + i) % n;
+					if (id == workerId)
+						continue;
+
+					SWorker* worker = m_workers[id];
+					std::lock_guard<std::mutex> lock(worker->Lock);
+					if (!worker->Queue.empty())
+					{
+						job = worker->Queue.front();
+						worker->Queue.pop_front();
+					}
+				}
+			}
+
+			if (job)
+				m_pendingJobs--;
+
+			return job;
+		}
+
+		void CJobScheduler::execute(const std::shared_ptr<SJob>& job)
+		{
+			if (job->Func)
+				job->Func();
+
+			std::vector<std::shared_ptr<SJob>> continuations;
+			{
+				std::lock_guard<std::mutex> lock(job->Lock);
+				job->Finished.store(true, std::memory_order_release);
+				continuations.swap(job->Continuations);
+			}
+
+			for (std::shared_ptr<SJob>& c : continuations)
+			{
+				if (c->Dependencies.fetch_sub(1) == 1)
+					push(c);
+			}
+		}
+
+		void CJobScheduler::workerLoop(int workerId)
+		{
+#ifdef USE_JOB_THREAD
+			s_currentScheduler = this;
+			s_currentWorker = workerId;
+
+			while (m_running)
+			{
+				std::shared_ptr<SJob> job = take(workerId);
+				if (job)
+				{
+					execute(job);
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(m_sleepLock);
+				m_wakeup.wait(lock, [this]() { return m_pendingJobs > 0 || !m_running; });
+			}
+#endif
+		}
+
+		void CJobScheduler::wait(const CJobHandle& handle)
+		{
+			int workerId = getCurrentWorker();
+
+			while (!handle.isFinished())
+			{
+				// help to execute the pending jobs
+				std::shared_ptr<SJob> job = take(workerId);
+				if (job)
+				{
+					execute(job);
+				}
+				else
+				{
+#ifdef USE_JOB_THREAD
+					std::this_thread::yield();
+#endif
+				}
+			}
+		}
+
+		void CJobScheduler::wait(const CJobHandle* jobs, int count)
+		{
+			for (int i = 0; i < count; i++)
+				wait(jobs[i]);
+		}
+
+		void CJobScheduler::parallelFor(int begin, int end, int grainSize, const std::function<void(int, int)>& func)
+		{
+			int count = end - begin;
+			if (count <= 0)
+				return;
+
+			if (grainSize < 1)
+				grainSize = 1;
+
+			if (m_workers.size() == 0 || count <= grainSize)
+			{
+				func(begin, end);
+				return;
+			}
+
+			int numJobs = (count + grainSize - 1) / grainSize;
+
+			std::vector<CJobHandle> jobs;
+			jobs.reserve(numJobs - 1);
+
+			for (int i = 1; i < numJobs; i++)
+			{
+				int from = begin + i * grainSize;
+				int to = from + grainSize;
+				if (to > end)
+					to = end;
+
+				jobs.push_back(run([&func, from, to]() { func(from, to); }));
+			}
+
+			// the caller thread process the first range
+			func(begin, begin + grainSize);
+
+			wait(jobs.data(), (int)jobs.size());
+		}
+	}
+}
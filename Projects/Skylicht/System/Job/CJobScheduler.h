@@ -0,0 +1,180 @@
+/*
+!@
+MIT License
+
+Copyright (c) 2026 Skylicht Technology CO., LTD
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files
+(the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify,
+merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+This file is part of the "Skylicht Engine".
+https://github.com/skylicht-lab/skylicht-engine
+!#
+*/
+
+#pragma once
+
+#include "stdafx.h"
+
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <deque>
+
+#if !defined(__EMSCRIPTEN__)
+#define USE_JOB_THREAD
+#include <thread>
+#include <condition_variable>
+#endif
+
+namespace Skylicht
+{
+	namespace System
+	{
+		struct SJob
+		{
+			std::function<void()> Func;
+
+			// the number of unfinished dependencies
+			std::atomic<int> Dependencies;
+
+			std::atomic<bool> Finished;
+
+			std::mutex Lock;
+
+			// the jobs that wait this job finish
+			std::vector<std::shared_ptr<SJob>> Continuations;
+
+			SJob() :
+				Dependencies(0),
+				Finished(false)
+			{
+			}
+		};
+
+		class CJobHandle
+		{
+		protected:
+			std::shared_ptr<SJob> m_job;
+
+			friend class CJobScheduler;
+
+		public:
+			CJobHandle()
+			{
+			}
+
+			CJobHandle(const std::shared_ptr<SJob>& job) :
+				m_job(job)
+			{
+			}
+
+			inline bool isValid() const
+			{
+				return m_job != nullptr;
+			}
+
+			inline bool isFinished() const
+			{
+				return m_job == nullptr || m_job->Finished.load(std::memory_order_acquire);
+			}
+		};
+
+		/// @brief The job scheduler with a fixed worker pool.
+		/**
+		 * Each worker has its own job queue, a worker pops the jobs on its queue (LIFO)
+		 * and steals the jobs from the other queues (FIFO) when its queue is empty.
+		 * The thread that waits a job also helps to execute the pending jobs, so a job can wait another job.
+		 *
+		 * @code
+		 * CJobScheduler* scheduler = CJobScheduler::getInstance();
+		 *
+		 * CJobHandle a = scheduler->run([]() { ... });
+		 * CJobHandle b = scheduler->run([]() { ... }, &a, 1); // b run after a finished
+		 * scheduler->wait(b);
+		 *
+		 * scheduler->parallelFor(0, numEntity, 256, [&](int from, int to) { ... });
+		 * @endcode
+		 */
+		class CJobScheduler
+		{
+		protected:
+			struct SWorker
+			{
+				std::mutex Lock;
+				std::deque<std::shared_ptr<SJob>> Queue;
+#ifdef USE_JOB_THREAD
+				std::thread* Thread;
+#endif
+			};
+
+			std::vector<SWorker*> m_workers;
+
+			std::atomic<bool> m_running;
+
+			std::atomic<int> m_pendingJobs;
+
+			std::atomic<unsigned int> m_nextWorker;
+
+#ifdef USE_JOB_THREAD
+			std::mutex m_sleepLock;
+			std::condition_variable m_wakeup;
+#endif
+
+			static CJobScheduler* s_instance;
+
+		public:
+			CJobScheduler(int numWorker);
+
+			virtual ~CJobScheduler();
+
+			static CJobScheduler* getInstance();
+
+			static void createInstance(int numWorker);
+
+			static void releaseInstance();
+
+			static int getDefaultWorkerCount();
+
+			inline int getWorkerCount()
+			{
+				return (int)m_workers.size();
+			}
+
+			CJobHandle run(const std::function<void()>& func);
+
+			CJobHandle run(const std::function<void()>& func, const CJobHandle* dependencies, int count);
+
+			void wait(const CJobHandle& job);
+
+			void wait(const CJobHandle* jobs, int count);
+
+			/// @brief Split the range [begin, end) to the jobs, each job process grainSize items.
+			/// The caller thread also executes the jobs, and the function returns when all items are done.
+			void parallelFor(int begin, int end, int grainSize, const std::function<void(int, int)>& func);
+
+		protected:
+
+			void push(const std::shared_ptr<SJob>& job);
+
+			std::shared_ptr<SJob> take(int workerId);
+
+			void execute(const std::shared_ptr<SJob>& job);
+
+			void workerLoop(int workerId);
+
+			int getCurrentWorker();
+		};
+	}
+}
@@ -7,6 +7,9 @@
 #include "imgui.h"
 #include "CImguiManager.h"
 
+#include "HttpRequest/CHttpRequest.h"
+#include "HttpRequest/CHttpRequestManager.h"
+
 void installApplication(const std::vector<std::string>& argv)
 {
 	SampleHttpRequest* app = new SampleHttpRequest();
@@ -25,6 +28,9 @@ SampleHttpRequest::SampleHttpRequest() :
 	m_scrollToBottom = true;
 	m_autoScroll = true;
 	strcpy(m_inputBuffer, "");
+
+	m_benchStart = 0;
+	m_benchShared = false;
 }
 
 SampleHttpRequest::~SampleHttpRequest()
@@ -35,6 +41,14 @@ SampleHttpRequest::~SampleHttpRequest()
 
 	delete m_httpRequest;
 
+	for (Network::IHttpRequest* request : m_benchRequests)
+		delete request;
+	m_benchRequests.clear();
+
+#ifndef __EMSCRIPTEN__
+	Network::CHttpRequestManager::releaseInstance();
+#endif
+
 	CImguiManager::releaseInstance();
 }
 
@@ -115,6 +129,13 @@ void SampleHttpRequest::onUpdate()
 	// update application
 	m_scene->update();
 
+#ifndef __EMSCRIPTEN__
+	// poll all the shared transfers once per frame
+	Network::CHttpRequestManager* requestManager = Network::CHttpRequestManager::getInstance();
+	if (requestManager != NULL)
+		requestManager->update();
+#endif
+
 	// update request
 	if (m_httpRequest->updateRequest() == true)
 	{
@@ -164,6 +185,8 @@ void SampleHttpRequest::onUpdate()
 		}
 	}
 
+	updateBenchmark();
+
 	// imgui gui
 	CImguiManager::getInstance()->onNewFrame();
 	onImGui();
@@ -275,6 +298,19 @@ void SampleHttpRequest::onImGui()
 		{
 			m_logs.clear();
 		}
+
+		if (m_benchRequests.size() == 0)
+		{
+			if (ImGui::Button("Benchmark"))
+				startBenchmark(false);
+
+#ifndef __EMSCRIPTEN__
+			ImGui::SameLine();
+
+			if (ImGui::Button("Benchmark (shared connection)"))
+				startBenchmark(true);
+#endif
+		}
 	}
 	else
 	{
@@ -317,6 +353,75 @@ void SampleHttpRequest::onImGui()
 	ImGui::End();
 }
 
+void SampleHttpRequest::startBenchmark(bool shared)
+{
+	const int numRequest = 32;
+
+	m_benchShared = shared;
+	m_benchStart = os::Timer::getRealTime();
+
+	for (int i = 0; i < numRequest; i++)
+	{
+		Network::IHttpRequest* request = NULL;
+		Network::IHttpStream* stream = new Network::CHttpStream(64 * 1024);
+
+#ifndef __EMSCRIPTEN__
+		// the shared requests are polled by CHttpRequestManager::update in onUpdate
+		if (shared)
+			request = Network::CHttpRequestManager::createGetInstance()->createRequest(stream);
+		else
+			request = Network::IHttpRequest::create(stream);
+#else
+		request = Network::IHttpRequest::create(stream);
+#endif
+
+		request->setRequestID(i + 1);
+		request->setURL(m_inputBuffer);
+		request->setSendRequestType(Network::IHttpRequest::Get);
+		request->sendRequest();
+		m_benchRequests.push_back(request);
+	}
+}
+
+void SampleHttpRequest::updateBenchmark()
+{
+	if (m_benchRequests.size() == 0)
+		return;
+
+	bool finish = true;
+	for (Network::IHttpRequest* request : m_benchRequests)
+	{
+		if (request->updateRequest() == false)
+			finish = false;
+	}
+
+	if (!finish)
+		return;
+
+	int numError = 0;
+	for (Network::IHttpRequest* request : m_benchRequests)
+	{
+		if (request->getResponseCode() <= 0)
+			numError++;
+		delete request;
+	}
+
+	char log[512];
+	sprintf(log, "[success] Benchmark%s: %d requests in %d ms (%d error)",
+		m_benchShared ? " (shared connection)" : "",
+		(int)m_benchRequests.size(),
+		(int)(os::Timer::getRealTime() - m_benchStart),
+		numError);
+	m_logs.push_back(log);
+
+	m_benchRequests.clear();
+
+#ifndef __EMSCRIPTEN__
+	if (m_benchShared)
+		Network::CHttpRequestManager::releaseInstance();
+#endif
+}
+
 void SampleHttpRequest::onRender()
 {
 	// render 3d scene
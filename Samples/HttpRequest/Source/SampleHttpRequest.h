@@ -21,6 +21,10 @@ private:
 	bool m_scrollToBottom;
 	bool m_autoScroll;
 	char m_inputBuffer[256];
+
+	std::vector<Network::IHttpRequest*> m_benchRequests;
+	u32 m_benchStart;
+	bool m_benchShared;
 public:
 	SampleHttpRequest();
 	virtual ~SampleHttpRequest();
@@ -46,4 +50,8 @@ public:
 protected:
 
 	void onImGui();
+
+	void startBenchmark(bool shared);
+
+	void updateBenchmark();
 };
\ No newline at end of file
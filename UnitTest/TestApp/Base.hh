@@ -71,4 +71,24 @@
   }                                                                 \
 }
 
+// a deterministic random sequence for the tests, the result does not depend on the platform rand()
+class CTestRandom
+{
+protected:
+  unsigned int m_seed;
+
+public:
+  CTestRandom(unsigned int seed) :
+    m_seed(seed)
+  {
+  }
+
+  // a float in [min, max)
+  float frand(float min, float max)
+  {
+    m_seed = m_seed * 1664525 + 1013904223;
+    return min + (max - min) * ((m_seed >> 8) / (float)(1 << 24));
+  }
+};
+
 #endif
\ No newline at end of file
@@ -4,6 +4,28 @@
 #include "TestScene.h"
 #include "TestMemoryStream.h"
 #include "TestSpreadsheet.h"
+#include "TestEntityStorage.h"
+#include "TestMatrixBatch.h"
+#include "TestCullingBVH.h"
+#include "TestSoftwareOcclusion.h"
+#include "TestParticleSystem.h"
+#include "TestPathFinder.h"
+#include "TestAsyncTexture.h"
+#include "TestSceneBinary.h"
+#include "TestSkylichtAsset.h"
+#include "TestCollisionBVH.h"
+#include "TestAnimationSystem.h"
+#include "TestSoftwareSkinning.h"
+#include "TestCPUBaker.h"
+#include "TestInstancingBuffer.h"
+#include "TestShadowCasterCulling.h"
+#include "TestProbeTetrahedra.h"
+#include "TestCanvasRenderCache.h"
+#include "TestGraphics2DBatching.h"
+#include "TestParallelUpdate.h"
+#include "TestTransformHierarchy.h"
+#include "TestAudioMixer.h"
+#include "TestHttpRequest.h"
 
 #include "CApplication.h"
 #include "Material/Shader/CShaderManager.h"
@@ -12,8 +34,17 @@
 
 bool g_finalPass = false;
 
+// run the benchmarks with the -benchmark argument
+bool g_benchmark = false;
+
 void installApplication(const std::vector<std::string>& argv)
 {
+	for (const std::string& arg : argv)
+	{
+		if (arg == "-benchmark")
+			g_benchmark = true;
+	}
+
 	CApp *mainTest = new CApp();
 	getApplication()->registerAppEvent("CApp", mainTest);
 }
@@ -57,6 +88,57 @@ void CApp::onInitApp()
 	testScene();
 
 	testSpreadsheet();
+
+	testEntityStorage();
+
+	testMatrixBatch();
+
+	testCullingBVH();
+
+	testSoftwareOcclusion();
+
+	testParticleSystem();
+
+	testPathFinder();
+
+	testAsyncTexture();
+
+	testSceneBinary();
+
+	testSkylichtAsset();
+
+	testCollisionBVH();
+
+	testAnimationSystem();
+
+	testSoftwareSkinning();
+
+	testCPUBaker();
+
+
+	testInstancingBuffer();
+
+	testInstancingSlot();
+
+	testInstancingBufferCost();
+
+	testShadowCasterCulling();
+
+	testShadowCascadeAnchor();
+
+	testProbeTetrahedra();
+
+	testCanvasRenderCache();
+
+	testGraphics2DBatching();
+
+	testParallelUpdate();
+
+	testTransformHierarchy();
+
+	testAudioMixer();
+
+	testHttpRequest();
 }
 
 void CApp::onUpdate()
@@ -0,0 +1,142 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestAnimationSystem.h"
+
+#include "Scene/CScene.h"
+#include "Animation/CAnimationClip.h"
+#include "Animation/CAnimationController.h"
+#include "Animation/CAnimationSystem.h"
+
+using namespace Skylicht;
+
+// x = frame * 10 in 1 second
+static SEntityAnim* createMoveAnim(const char* name)
+{
+	SEntityAnim* anim = new SEntityAnim();
+	anim->Name = name;
+
+	for (int i = 0; i <= 1; i++)
+	{
+		CPositionKey pos;
+		pos.Frame = (f32)i;
+		pos.Value.set(i * 10.0f, 0.0f, 0.0f);
+		anim->Data.Positions.Data.push_back(pos);
+	}
+
+	anim->Data.Rotations.Default.set(0.0f, 0.0f, 0.0f, 1.0f);
+	anim->Data.Scales.Default.set(1.0f, 1.0f, 1.0f);
+	return anim;
+}
+
+static f32 getBonePosition(CEntity* bone)
+{
+	CWorldTransformData* transform = GET_ENTITY_DATA(bone, CWorldTransformData);
+	return transform->World.getTranslation().X;
+}
+
+void testAnimationSystem()
+{
+	TEST_CASE("Animation system parallel update");
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+	CEntityManager* entityManager = zone->getEntityManager();
+
+	CAnimationClip clip;
+	clip.AnimName = "Move";
+	clip.Duration = 1.0f;
+	clip.addAnim(createMoveAnim("Bone"));
+
+	// enough characters to split to the jobs
+	const int count = 40;
+	std::vector<CAnimationController*> controllers;
+	std::vector<CEntity*> bones;
+
+	for (int i = 0; i < count; i++)
+	{
+		CGameObject* obj = zone->createEmptyObject();
+
+		// the far characters for the animation LOD
+		if (i % 2 == 1)
+			obj->getTransformEuler()->setPosition(core::vector3df(1000.0f, 0.0f, 0.0f));
+
+		CEntity* bone = entityManager->createEntity();
+		CWorldTransformData* transform = bone->addData<CWorldTransformData>();
+		transform->Name = "Bone";
+		transform->ParentIndex = obj->getEntity()->getIndex();
+		transform->Depth = 1;
+		bones.push_back(bone);
+
+		core::array<CEntity*> entities;
+		entities.push_back(bone);
+
+		CAnimationController* controller = obj->addComponent<CAnimationController>();
+		CSkeleton* skeleton = controller->createSkeleton(entities);
+		skeleton->setAnimation(&clip, true, true);
+		skeleton->getTimeline().Frame = (i % 10) * 0.1f;
+		controllers.push_back(controller);
+	}
+
+	scene->updateAddRemoveObject();
+	scene->update();
+
+	bool pass = true;
+	for (int i = 0; i < count; i++)
+	{
+		f32 x = (i % 2 == 1 ? 1000.0f : 0.0f) + (i % 10) * 1.0f;
+		if (!core::equals(getBonePosition(bones[i]), x, 0.001f))
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+
+	TEST_CASE("Animation system LOD");
+
+	CGameObject* cameraObj = zone->createEmptyObject();
+	CCamera* camera = cameraObj->addComponent<CCamera>();
+	entityManager->setCamera(camera);
+
+	CAnimationSystem* animationSystem = entityManager->getSystem<CAnimationSystem>();
+	TEST_ASSERT_THROW(animationSystem != NULL);
+
+	animationSystem->addLOD(100.0f, 10000.0f, 4);
+	TEST_ASSERT_EQUAL(animationSystem->getUpdateInterval(50.0f * 50.0f), 1);
+	TEST_ASSERT_EQUAL(animationSystem->getUpdateInterval(1000.0f * 1000.0f), 4);
+
+	scene->updateAddRemoveObject();
+
+	// the first frame samples all the characters and staggers the far characters
+	scene->update();
+
+	for (int i = 0; i < count; i++)
+		controllers[i]->getSkeleton(0)->getTimeline().Frame = 0.5f;
+
+	scene->update();
+
+	int numNear = 0;
+	int numFar = 0;
+	for (int i = 0; i < count; i++)
+	{
+		f32 x = getBonePosition(bones[i]);
+		if (i % 2 == 0 && core::equals(x, 5.0f, 0.001f))
+			numNear++;
+		else if (i % 2 == 1 && core::equals(x, 1005.0f, 0.001f))
+			numFar++;
+	}
+
+	// the near characters are sampled every frame, the far characters are staggered
+	TEST_ASSERT_EQUAL(numNear, count / 2);
+	TEST_ASSERT_THROW(numFar < count / 2);
+
+	for (int frame = 0; frame < 3; frame++)
+		scene->update();
+
+	numFar = 0;
+	for (int i = 1; i < count; i += 2)
+	{
+		if (core::equals(getBonePosition(bones[i]), 1005.0f, 0.001f))
+			numFar++;
+	}
+	TEST_ASSERT_EQUAL(numFar, count / 2);
+
+	delete scene;
+}
@@ -0,0 +1,97 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestAsyncTexture.h"
+
+#include "TextureManager/CTextureManager.h"
+
+using namespace Skylicht;
+
+static bool writeTestImage(const char* path, u32 size)
+{
+	IVideoDriver* driver = getVideoDriver();
+
+	IImage* image = driver->createImage(video::ECF_A8R8G8B8, core::dimension2du(size, size));
+	for (u32 y = 0; y < size; y++)
+	{
+		for (u32 x = 0; x < size; x++)
+			image->setPixel(x, y, SColor(255, x * 8, y * 8, size));
+	}
+
+	bool result = driver->writeImageToFile(image, path);
+	image->drop();
+	return result;
+}
+
+void testAsyncTexture()
+{
+	TEST_CASE("Async texture");
+
+	const char* paths[] = { "AsyncTexture0.png", "AsyncTexture1.png", "AsyncTexture2.png" };
+	for (int i = 0; i < 3; i++)
+		TEST_ASSERT_THROW(writeTestImage(paths[i], 16 << i));
+
+	CTextureManager* textureManager = CTextureManager::getInstance();
+	textureManager->setMaxAsyncDecode(1);
+
+	CAsyncTexture* a = textureManager->getTextureAsync(paths[0], 0);
+	CAsyncTexture* b = textureManager->getTextureAsync(paths[1], 5);
+	CAsyncTexture* c = textureManager->getTextureAsync(paths[2], 1);
+	TEST_ASSERT_THROW(a != NULL && b != NULL && c != NULL);
+	TEST_ASSERT_THROW(textureManager->getTextureAsync("AsyncTextureNotFound.png") == NULL);
+
+	// the same path share the request
+	CAsyncTexture* d = textureManager->getTextureAsync(paths[2], 0);
+	TEST_ASSERT_THROW(d == c);
+	TEST_ASSERT_THROW(c->getPriority() == 1);
+	TEST_ASSERT_EQUAL(textureManager->getNumAsyncTexture(), 3);
+
+	textureManager->cancelTextureAsync(a);
+	TEST_ASSERT_THROW(a->getState() == CAsyncTexture::Cancelled);
+	TEST_ASSERT_EQUAL(textureManager->getNumAsyncTexture(), 2);
+
+	// the shared request is kept while a holder still wait for it
+	textureManager->cancelTextureAsync(d);
+	TEST_ASSERT_THROW(c->getState() == CAsyncTexture::Queued);
+	TEST_ASSERT_EQUAL(textureManager->getNumAsyncTexture(), 2);
+
+	TEST_CASE("Async texture priority");
+	int frame = 0;
+	while (!b->isFinished() && frame < 10000)
+	{
+		textureManager->updateAsyncTexture();
+		frame++;
+	}
+
+	// decode one by one, the higher priority is ready first
+	TEST_ASSERT_THROW(b->isReady());
+	TEST_ASSERT_THROW(!c->isFinished());
+	TEST_ASSERT_STRING_EQUAL(textureManager->getTexturePath(b->getTexture()), b->getPath());
+
+	textureManager->finishAsyncTexture();
+	TEST_ASSERT_THROW(c->isReady());
+	TEST_ASSERT_THROW(c->getTexture() != NULL);
+	TEST_ASSERT_EQUAL(textureManager->getNumAsyncTexture(), 0);
+	TEST_ASSERT_THROW(a->getTexture() == NULL);
+	TEST_ASSERT_THROW(!textureManager->isTextureLoaded(paths[0]));
+
+	TEST_CASE("Async texture registered");
+	TEST_ASSERT_THROW(textureManager->isTextureLoaded(paths[1]));
+	TEST_ASSERT_THROW(textureManager->getTexture(paths[1]) == b->getTexture());
+
+	CAsyncTexture* e = textureManager->getTextureAsync(paths[2]);
+	TEST_ASSERT_THROW(e->isReady());
+	TEST_ASSERT_THROW(e->getTexture() == c->getTexture());
+
+	textureManager->removeTexture(b->getTexture());
+	textureManager->removeTexture(c->getTexture());
+	textureManager->setMaxAsyncDecode(4);
+
+	a->drop();
+	b->drop();
+	c->drop();
+	d->drop();
+	e->drop();
+
+	for (int i = 0; i < 3; i++)
+		remove(paths[i]);
+}
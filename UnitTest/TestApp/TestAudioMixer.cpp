@@ -0,0 +1,172 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestAudioMixer.h"
+
+#ifdef BUILD_SKYLICHT_AUDIO
+
+#include "Driver/CDriverNull.h"
+#include "Driver/CAudioMixer.h"
+
+using namespace Skylicht::Audio;
+
+static bool mixEqual(const std::vector<float>& a, const std::vector<float>& b)
+{
+	for (size_t i = 0, n = a.size(); i < n; i++)
+	{
+		// the samples are in the 16 bit range
+		if (fabsf(a[i] - b[i]) > 0.01f)
+			return false;
+	}
+	return true;
+}
+
+void testAudioMixer()
+{
+	TEST_CASE("Audio mixer SIMD");
+	const int numFrames = 1021;
+	std::vector<short> samples(numFrames * 2);
+	for (int i = 0; i < numFrames * 2; i++)
+		samples[i] = (short)((i * 7919) % 65536 - 32768);
+
+	float steps[] = { 1.0f, 0.5f, 1.37f };
+	for (int channels = 1; channels <= 2; channels++)
+	{
+		for (float step : steps)
+		{
+			int numOut = (int)(numFrames / step);
+			std::vector<float> simd(numOut * 2, 0.0f);
+			std::vector<float> scalar(numOut * 2, 0.0f);
+
+			CAudioMixer::mix(simd.data(), numOut, samples.data(), numFrames, channels, step, 0.2f, 0.9f, 0.7f, 0.1f);
+			CAudioMixer::mixScalar(scalar.data(), numOut, samples.data(), numFrames, channels, step, 0.2f, 0.9f, 0.7f, 0.1f);
+			TEST_ASSERT_THROW(mixEqual(simd, scalar));
+		}
+	}
+
+	// saturation and rounding
+	std::vector<float> bus(1027);
+	for (int i = 0, n = (int)bus.size(); i < n; i++)
+		bus[i] = (i - n / 2) * 71.3f;
+
+	std::vector<short> pcm(bus.size());
+	std::vector<short> pcmScalar(bus.size());
+	CAudioMixer::convertToPCM16(pcm.data(), bus.data(), (int)bus.size());
+	CAudioMixer::convertToPCM16Scalar(pcmScalar.data(), bus.data(), (int)bus.size());
+	TEST_ASSERT_THROW(pcm == pcmScalar);
+	TEST_ASSERT_THROW(pcm[0] == -32768);
+	TEST_ASSERT_THROW(pcm.back() == 32767);
+
+	TEST_CASE("Audio mixer gain ramp");
+	CDriverNull driver;
+
+	SSourceParam sourceParam;
+	driver.getSourceParam(&sourceParam);
+
+	STrackParams trackParam;
+	trackParam.NumChannels = 1;
+	trackParam.SamplingRate = sourceParam.SamplingRate;
+	trackParam.BitsPerSample = 16;
+
+	CSoundSource* source = (CSoundSource*)driver.createSource();
+	source->init(trackParam, sourceParam);
+
+	int bufferSize = source->getBufferSize();
+	int frames = bufferSize / 2;
+	std::vector<short> dc(frames, 1000);
+
+	source->setGain(0.5f);
+	source->play();
+	source->uploadData(dc.data(), bufferSize);
+	source->uploadData(dc.data(), bufferSize);
+
+	// render offline, the first buffer ramps in from silent
+	std::vector<short> out(frames * 2);
+	driver.fillBuffer((unsigned short*)out.data(), frames);
+	TEST_ASSERT_THROW(out[0] == 0 && out[1] == 0);
+
+	bool ramp = true;
+	for (int i = 0; i < frames; i++)
+	{
+		float expected = 1000.0f * (0.5f / frames * i);
+		if (fabsf(out[i * 2] - expected) > 1.0f || out[i * 2] != out[i * 2 + 1])
+			ramp = false;
+	}
+	TEST_ASSERT_THROW(ramp);
+
+	// the next buffer has the constant gain
+	driver.fillBuffer((unsigned short*)out.data(), frames);
+	bool constant = true;
+	for (int i = 0; i < frames * 2; i++)
+	{
+		if (out[i] != 500)
+			constant = false;
+	}
+	TEST_ASSERT_THROW(constant);
+
+	TEST_CASE("Audio mixer stop");
+	source->uploadData(dc.data(), bufferSize);
+	source->stop();
+
+	driver.fillBuffer((unsigned short*)out.data(), frames);
+	bool silent = true;
+	for (int i = 0; i < frames * 2; i++)
+	{
+		if (out[i] != 0)
+			silent = false;
+	}
+	TEST_ASSERT_THROW(silent);
+	TEST_ASSERT_THROW(source->getState() == ISoundSource::StateStopped);
+
+	// the queued buffer is dropped
+	TEST_ASSERT_THROW(source->needData());
+
+	driver.destroyAllSource();
+
+	TEST_CASE("Audio command retry");
+	CAudioCommandQueue queue(2);
+	CSoundSource commandSource(0.0625f, &queue);
+
+	// fill the queue, the gain stays pending
+	commandSource.setPitch(2.0f);
+	commandSource.setRollOff(5.0f);
+	commandSource.setGain(0.25f);
+	TEST_ASSERT_THROW(commandSource.getGain() == 0.25f);
+
+	// only the last value is sent again
+	commandSource.setPitch(1.5f);
+	commandSource.setPitch(1.0f);
+
+	SSourceCommand command;
+	TEST_ASSERT_THROW(queue.pop(command) && command.Type == SSourceCommand::SetPitch);
+	TEST_ASSERT_THROW(queue.pop(command) && command.Type == SSourceCommand::SetRollOff);
+	TEST_ASSERT_THROW(!queue.pop(command));
+
+	commandSource.update(0.0f);
+
+	int numCommand = 0;
+	bool haveGain = false;
+	bool havePitch = false;
+	while (queue.pop(command))
+	{
+		if (command.Type == SSourceCommand::SetGain)
+			haveGain = command.Value[0] == 0.25f;
+		else if (command.Type == SSourceCommand::SetPitch)
+			havePitch = command.Value[0] == 1.0f;
+		numCommand++;
+	}
+	TEST_ASSERT_THROW(haveGain);
+	TEST_ASSERT_THROW(havePitch);
+	TEST_ASSERT_THROW(numCommand == 2);
+
+	// nothing is pending
+	commandSource.update(0.0f);
+	TEST_ASSERT_THROW(!queue.pop(command));
+}
+
+#else
+
+void testAudioMixer()
+{
+}
+
+#endif
@@ -0,0 +1,171 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCPUBaker.h"
+
+#include "Lightmapper/CCPUBaker.h"
+#include "Scene/CScene.h"
+#include "Lighting/CDirectionalLight.h"
+#include "Job/CJobScheduler.h"
+
+using namespace Skylicht;
+using namespace Skylicht::Lightmapper;
+
+#define TEST_BAKE_POINT 16
+
+static void addQuad(CCPUBaker* baker, float y, float size, const core::vector3df& albedo)
+{
+	core::vector3df a(-size, y, -size);
+	core::vector3df b(size, y, -size);
+	core::vector3df c(size, y, size);
+	core::vector3df d(-size, y, size);
+
+	core::triangle3df tris[2] = {
+		core::triangle3df(a, b, c),
+		core::triangle3df(a, c, d)
+	};
+	baker->addTriangles(tris, 2, albedo);
+}
+
+static void bakeProbes(CCPUBaker* baker, core::array<core::vector3df>& positions, std::vector<CSH9>& out)
+{
+	core::array<core::vector3df> normals;
+	for (u32 i = 0; i < positions.size(); i++)
+		normals.push_back(core::vector3df(0.0f, 1.0f, 0.0f));
+
+	baker->beginBake((int)positions.size());
+	baker->bakePass(positions.pointer(), normals.pointer(), (int)positions.size(), 6);
+
+	out.clear();
+	for (u32 i = 0; i < positions.size(); i++)
+		out.push_back(baker->getSH(i));
+}
+
+static bool shEqual(CSH9& a, CSH9& b)
+{
+	core::vector3df sa[9];
+	core::vector3df sb[9];
+	a.copyTo(sa);
+	b.copyTo(sb);
+
+	for (int i = 0; i < 9; i++)
+	{
+		if (sa[i] != sb[i])
+			return false;
+	}
+	return true;
+}
+
+void testCPUBaker()
+{
+	TEST_CASE("CPU baker");
+
+	CCPUBaker* baker = new CCPUBaker();
+	baker->setSamplesPerPass(256);
+	baker->setMaxBounce(1);
+
+	// the ground is lit by the sun
+	addQuad(baker, 0.0f, 50.0f, core::vector3df(0.5f, 0.5f, 0.5f));
+	baker->addDirectionalLight(core::vector3df(0.0f, -1.0f, 0.0f), SColorf(1.0f, 1.0f, 1.0f), 1.0f);
+	baker->buildScene();
+
+	core::array<core::vector3df> positions;
+	for (int i = 0; i < TEST_BAKE_POINT; i++)
+		positions.push_back(core::vector3df((f32)(i % 4), 1.0f, (f32)(i / 4)));
+
+	std::vector<CSH9> lit;
+	bakeProbes(baker, positions, lit);
+
+	// the irradiance from the ground is albedo * sun
+	core::vector3df down, up;
+	lit[0].getSHIrradiance(core::vector3df(0.0f, -1.0f, 0.0f), down);
+	lit[0].getSHIrradiance(core::vector3df(0.0f, 1.0f, 0.0f), up);
+	TEST_ASSERT_THROW(down.X > 0.4f && down.X < 0.6f);
+	TEST_ASSERT_THROW(up.X < down.X * 0.2f);
+
+	TEST_CASE("CPU baker deterministic");
+	std::vector<CSH9> again;
+	bakeProbes(baker, positions, again);
+	for (int i = 0; i < TEST_BAKE_POINT; i++)
+		TEST_ASSERT_THROW(shEqual(lit[i], again[i]));
+
+	TEST_CASE("CPU baker progressive");
+	core::array<core::vector3df> normals;
+	for (int i = 0; i < TEST_BAKE_POINT; i++)
+		normals.push_back(core::vector3df(0.0f, 1.0f, 0.0f));
+
+	baker->beginBake(TEST_BAKE_POINT);
+	for (int pass = 0; pass < 4; pass++)
+		baker->bakePass(positions.pointer(), normals.pointer(), TEST_BAKE_POINT, 6);
+	TEST_ASSERT_THROW(baker->getNumPass() == 4);
+
+	// the first pass is the same, the next passes refine the result
+	core::vector3df progressive;
+	CSH9 progressiveSH = baker->getSH(0);
+	progressiveSH.getSHIrradiance(core::vector3df(0.0f, -1.0f, 0.0f), progressive);
+	TEST_ASSERT_THROW(fabsf(progressive.X - down.X) < 0.1f);
+
+	TEST_CASE("CPU baker occlusion");
+	// the roof casts the shadow on the ground
+	addQuad(baker, 5.0f, 50.0f, core::vector3df(0.5f, 0.5f, 0.5f));
+	baker->buildScene();
+
+	std::vector<CSH9> shadow;
+	bakeProbes(baker, positions, shadow);
+
+	core::vector3df shadowDown;
+	shadow[0].getSHIrradiance(core::vector3df(0.0f, -1.0f, 0.0f), shadowDown);
+	TEST_ASSERT_THROW(shadowDown.X < down.X * 0.1f);
+
+	TEST_CASE("CPU baker job scheduler");
+	// the same result on the main thread only and on the job threads
+	System::CJobScheduler::createInstance(0);
+	std::vector<CSH9> serial;
+	bakeProbes(baker, positions, serial);
+
+	System::CJobScheduler::createInstance(4);
+	std::vector<CSH9> parallel;
+	bakeProbes(baker, positions, parallel);
+
+	System::CJobScheduler::createInstance(System::CJobScheduler::getDefaultWorkerCount());
+
+	for (int i = 0; i < TEST_BAKE_POINT; i++)
+	{
+		TEST_ASSERT_THROW(shEqual(serial[i], parallel[i]));
+		TEST_ASSERT_THROW(shEqual(serial[i], shadow[i]));
+	}
+
+	delete baker;
+
+	TEST_CASE("CPU baker scene revision");
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+	CEntityManager* entityManager = zone->getEntityManager();
+
+	CDirectionalLight* sun = zone->createEmptyObject()->addComponent<CDirectionalLight>();
+	scene->updateAddRemoveObject();
+	scene->update();
+
+	CCPUBaker* sceneBaker = new CCPUBaker();
+	sceneBaker->captureScene(entityManager);
+	TEST_ASSERT_THROW(sceneBaker->getNumLight() == 1);
+
+	u32 revision = sceneBaker->getSceneRevision(entityManager);
+	TEST_ASSERT_EQUAL(revision, sceneBaker->getSceneRevision(entityManager));
+
+	// the same entity manager, but a new light
+	zone->createEmptyObject()->addComponent<CDirectionalLight>();
+	scene->updateAddRemoveObject();
+	scene->update();
+
+	TEST_ASSERT_THROW(sceneBaker->getSceneRevision(entityManager) != revision);
+	sceneBaker->captureScene(entityManager);
+	TEST_ASSERT_THROW(sceneBaker->getNumLight() == 2);
+
+	// the light is changed
+	revision = sceneBaker->getSceneRevision(entityManager);
+	sun->setIntensity(2.0f);
+	TEST_ASSERT_THROW(sceneBaker->getSceneRevision(entityManager) != revision);
+
+	delete sceneBaker;
+	delete scene;
+}
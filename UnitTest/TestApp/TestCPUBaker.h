@@ -0,0 +1,3 @@
+#pragma once
+
+void testCPUBaker();
\ No newline at end of file
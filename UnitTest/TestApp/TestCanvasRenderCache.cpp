@@ -0,0 +1,133 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCanvasRenderCache.h"
+
+#include "Graphics2D/CCanvas.h"
+#include "Graphics2D/CGraphics2D.h"
+#include "Material/Shader/CShaderManager.h"
+
+using namespace Skylicht;
+
+static void copyVertices(core::array<S3DVertex>& out)
+{
+	IVertexBuffer* vb = CGraphics2D::getInstance()->getCurrentBuffer()->getVertexBuffer();
+
+	out.set_used(vb->getVertexCount());
+	memcpy(out.pointer(), vb->getVertices(), out.size() * sizeof(S3DVertex));
+}
+
+static void renderCanvas(CCanvas* canvas, core::array<S3DVertex>& out)
+{
+	CGraphics2D* g = CGraphics2D::getInstance();
+	g->beginRenderGUI(core::IdentityMatrix, core::IdentityMatrix);
+
+	canvas->updateEntities();
+	canvas->render(NULL);
+
+	copyVertices(out);
+	g->endRenderGUI();
+}
+
+static bool verticesEqual(const core::array<S3DVertex>& a, const core::array<S3DVertex>& b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	for (u32 i = 0, n = a.size(); i < n; i++)
+	{
+		if (a[i].Pos != b[i].Pos || a[i].Color != b[i].Color || a[i].TCoords != b[i].TCoords)
+			return false;
+	}
+	return true;
+}
+
+static void createElements(CCanvas* canvas, core::array<CGUIRect*>& rects)
+{
+	for (int i = 0; i < 6; i++)
+	{
+		core::rectf r(10.0f * i, 5.0f, 10.0f * i + 8.0f, 20.0f);
+		rects.push_back(canvas->createRect(r, SColor(255, 40 * i, 100, 200)));
+	}
+
+	canvas->createElipse(core::rectf(100.0f, 100.0f, 140.0f, 130.0f), SColor(255, 255, 0, 0));
+}
+
+void testCanvasRenderCache()
+{
+	CGraphics2D* g = CGraphics2D::getInstance();
+
+	TEST_CASE("Graphics2D cache record");
+	CGraphics2DCache cache;
+	core::array<S3DVertex> direct;
+	core::array<S3DVertex> replay;
+
+	core::matrix4 world;
+	world.setTranslation(core::vector3df(3.0f, 4.0f, 0.0f));
+	int shader = CShaderManager::getInstance()->getShaderIDByName("TextureColorAlpha");
+
+	g->beginRenderGUI(core::IdentityMatrix, core::IdentityMatrix);
+	g->beginCache(&cache);
+	g->addRectangleBatch(core::rectf(0.0f, 0.0f, 10.0f, 10.0f), core::rectf(0.0f, 0.0f, 1.0f, 1.0f), SColor(255, 255, 255, 255), world, shader);
+	g->addRectangleBatch(core::rectf(20.0f, 0.0f, 30.0f, 10.0f), core::rectf(0.0f, 0.0f, 1.0f, 1.0f), SColor(255, 0, 255, 0), world, shader);
+	g->endCache();
+	copyVertices(direct);
+	g->endRenderGUI();
+
+	TEST_ASSERT_EQUAL(cache.Batches.size(), 1);
+	TEST_ASSERT_EQUAL(cache.Vertices.size(), 8);
+	TEST_ASSERT_EQUAL(cache.Indices.size(), 12);
+	TEST_ASSERT_EQUAL(cache.Indices[6], 4);
+
+	TEST_CASE("Graphics2D cache replay");
+	g->beginRenderGUI(core::IdentityMatrix, core::IdentityMatrix);
+	g->addCacheBatch(&cache);
+	copyVertices(replay);
+	g->endRenderGUI();
+
+	TEST_ASSERT_THROW(verticesEqual(direct, replay));
+
+	TEST_CASE("Canvas render cache");
+	CCanvas* reference = new CCanvas();
+	CCanvas* retained = new CCanvas();
+	retained->setEnableRenderCache(true);
+
+	core::array<CGUIRect*> referenceRects;
+	core::array<CGUIRect*> retainedRects;
+	createElements(reference, referenceRects);
+	createElements(retained, retainedRects);
+
+	core::array<S3DVertex> a;
+	core::array<S3DVertex> b;
+
+	for (int frame = 0; frame < 3; frame++)
+	{
+		renderCanvas(reference, a);
+		renderCanvas(retained, b);
+		TEST_ASSERT_THROW(a.size() > 0);
+		TEST_ASSERT_THROW(verticesEqual(a, b));
+	}
+
+	TEST_CASE("Canvas render cache changed element");
+	referenceRects[2]->setColor(SColor(255, 1, 2, 3));
+	retainedRects[2]->setColor(SColor(255, 1, 2, 3));
+	referenceRects[4]->setPosition(core::vector3df(7.0f, 9.0f, 0.0f));
+	retainedRects[4]->setPosition(core::vector3df(7.0f, 9.0f, 0.0f));
+
+	renderCanvas(reference, a);
+	renderCanvas(retained, b);
+	TEST_ASSERT_THROW(verticesEqual(a, b));
+	TEST_ASSERT_THROW(b[8].Color == SColor(255, 1, 2, 3));
+
+	TEST_CASE("Canvas render cache add element");
+	u32 count = b.size();
+	reference->createRect(core::rectf(0.0f, 50.0f, 30.0f, 60.0f), SColor(255, 9, 9, 9));
+	retained->createRect(core::rectf(0.0f, 50.0f, 30.0f, 60.0f), SColor(255, 9, 9, 9));
+
+	renderCanvas(reference, a);
+	renderCanvas(retained, b);
+	TEST_ASSERT_EQUAL(b.size(), count + 4);
+	TEST_ASSERT_THROW(verticesEqual(a, b));
+
+	delete reference;
+	delete retained;
+}
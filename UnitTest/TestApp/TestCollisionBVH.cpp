@@ -0,0 +1,165 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCollisionBVH.h"
+
+#include "Collision/CBVHBuilder.h"
+
+using namespace Skylicht;
+
+// a bumpy ground of size * size quads, the triangles are already in world space
+static CCollisionNode* createGround(f32 x, f32 z, int size)
+{
+	CCollisionNode* node = new CCollisionNode(NULL, NULL, NULL);
+
+	for (int i = 0; i < size; i++)
+	{
+		for (int j = 0; j < size; j++)
+		{
+			core::vector3df a(x + i, sinf(x + i) * 0.5f, z + j);
+			core::vector3df b(x + i + 1, sinf(x + i + 1) * 0.5f, z + j);
+			core::vector3df c(x + i, sinf(x + i) * 0.5f, z + j + 1);
+			core::vector3df d(x + i + 1, sinf(x + i + 1) * 0.5f, z + j + 1);
+			node->Triangles.push_back(core::triangle3df(a, b, c));
+			node->Triangles.push_back(core::triangle3df(b, d, c));
+		}
+	}
+	return node;
+}
+
+static bool bruteForce(core::array<CCollisionNode*>& nodes, const core::line3df& ray, f32& outDistanceSQ, CCollisionNode*& outNode)
+{
+	outNode = NULL;
+	outDistanceSQ = ray.getLengthSQ();
+
+	core::vector3df out;
+	for (u32 i = 0; i < nodes.size(); i++)
+	{
+		for (u32 j = 0; j < nodes[i]->Triangles.size(); j++)
+		{
+			if (nodes[i]->Triangles[j].getIntersectionWithLimitedLine(ray, out))
+			{
+				f32 d = out.getDistanceFromSQ(ray.start);
+				if (d < outDistanceSQ)
+				{
+					outDistanceSQ = d;
+					outNode = nodes[i];
+				}
+			}
+		}
+	}
+	return outNode != NULL;
+}
+
+static core::line3df randomRay(CTestRandom& random)
+{
+	core::vector3df start(random.frand(-2.0f, 66.0f), random.frand(1.0f, 5.0f), random.frand(-2.0f, 66.0f));
+	core::vector3df end(random.frand(-2.0f, 66.0f), random.frand(-3.0f, 0.2f), random.frand(-2.0f, 66.0f));
+	return core::line3df(start, end);
+}
+
+void testCollisionBVH()
+{
+	TEST_CASE("Collision BVH build");
+
+	CBVHBuilder builder;
+	core::array<CCollisionNode*> nodes;
+
+	for (int i = 0; i < 4; i++)
+	{
+		for (int j = 0; j < 4; j++)
+		{
+			CCollisionNode* node = createGround(i * 16.0f, j * 16.0f, 16);
+			nodes.push_back(node);
+			builder.addCollision(node);
+		}
+	}
+
+	builder.build();
+	TEST_ASSERT_THROW(builder.getBVHNodeCount() > 1);
+
+	TEST_CASE("Collision BVH ray");
+	const int numRay = 301;
+	core::line3df rays[numRay];
+	CTestRandom random(12345);
+	for (int i = 0; i < numRay; i++)
+		rays[i] = randomRay(random);
+
+	int numHit = 0;
+	for (int i = 0; i < numRay; i++)
+	{
+		f32 refDistance;
+		CCollisionNode* refNode;
+		bool refHit = bruteForce(nodes, rays[i], refDistance, refNode);
+
+		f32 distance = rays[i].getLengthSQ();
+		core::vector3df intersection;
+		core::triangle3df triangle;
+		CCollisionNode* node = NULL;
+		bool hit = builder.getCollisionPoint(rays[i], distance, intersection, triangle, node);
+
+		TEST_ASSERT_THROW(hit == refHit);
+		if (hit && refHit)
+		{
+			TEST_ASSERT_THROW(fabsf(sqrtf(distance) - sqrtf(refDistance)) < 0.001f);
+			TEST_ASSERT_THROW(node == refNode);
+			numHit++;
+		}
+	}
+	TEST_ASSERT_THROW(numHit > numRay / 2);
+
+	TEST_CASE("Collision BVH ray packet");
+	SBVHRayHit hits[numRay];
+	u32 packetHit = builder.getCollisionPoints(rays, numRay, hits);
+	TEST_ASSERT_EQUAL(packetHit, (u32)numHit);
+
+	for (int i = 0; i < numRay; i++)
+	{
+		f32 distance = rays[i].getLengthSQ();
+		core::vector3df intersection;
+		core::triangle3df triangle;
+		CCollisionNode* node = NULL;
+		builder.getCollisionPoint(rays[i], distance, intersection, triangle, node);
+
+		TEST_ASSERT_THROW(hits[i].Node == node);
+		if (node != NULL)
+		{
+			TEST_ASSERT_THROW(fabsf(hits[i].DistanceSquared - distance) < 0.01f);
+			TEST_ASSERT_THROW(hits[i].Intersection.getDistanceFrom(intersection) < 0.001f);
+		}
+	}
+
+	TEST_CASE("Collision BVH refit");
+	// move the first ground up 10m
+	CCollisionNode* moving = nodes[0];
+	for (u32 i = 0; i < moving->Triangles.size(); i++)
+	{
+		core::triangle3df& t = moving->Triangles[i];
+		t.pointA.Y += 10.0f;
+		t.pointB.Y += 10.0f;
+		t.pointC.Y += 10.0f;
+	}
+	builder.refit(&moving, 1);
+
+	core::line3df down(core::vector3df(8.5f, 20.0f, 8.5f), core::vector3df(8.5f, -20.0f, 8.5f));
+	f32 distance = down.getLengthSQ();
+	core::vector3df intersection;
+	core::triangle3df triangle;
+	CCollisionNode* node = NULL;
+	TEST_ASSERT_THROW(builder.getCollisionPoint(down, distance, intersection, triangle, node));
+	TEST_ASSERT_THROW(node == moving);
+	TEST_ASSERT_THROW(intersection.Y > 9.0f);
+
+	TEST_CASE("Collision BVH remove");
+	builder.removeCollision(&moving, 1);
+
+	distance = down.getLengthSQ();
+	TEST_ASSERT_THROW(builder.getCollisionPoint(down, distance, intersection, triangle, node) == false);
+	TEST_ASSERT_THROW(builder.getCollisionCount() == nodes.size() - 1);
+
+	core::aabbox3df box(core::vector3df(20.0f, -1.0f, 20.0f), core::vector3df(21.0f, 1.0f, 21.0f));
+	core::array<core::triangle3df*> triangles;
+	core::array<CCollisionNode*> triangleNodes;
+	builder.getTriangles(box, triangles, triangleNodes);
+	TEST_ASSERT_THROW(triangles.size() > 0);
+	TEST_ASSERT_THROW(triangles.size() == triangleNodes.size());
+}
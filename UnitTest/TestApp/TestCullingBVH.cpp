@@ -0,0 +1,130 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestCullingBVH.h"
+
+#include "Entity/CEntityManager.h"
+#include "Culling/CCullingBVH.h"
+
+using namespace Skylicht;
+
+static bool isBoxVisible(const SViewFrustum& frustum, const core::aabbox3df& box)
+{
+	core::vector3df edges[8];
+	box.getEdges(edges);
+
+	for (int i = 0; i < SViewFrustum::VF_PLANE_COUNT; i++)
+	{
+		bool inFrustum = false;
+		for (int j = 0; j < 8; j++)
+		{
+			if (frustum.planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
+			{
+				inFrustum = true;
+				break;
+			}
+		}
+
+		if (!inFrustum)
+			return false;
+	}
+	return true;
+}
+
+static bool haveEntity(CFastArray<CEntity*>& result, CEntity* entity)
+{
+	for (int i = 0, n = result.count(); i < n; i++)
+	{
+		if (result.pointer()[i] == entity)
+			return true;
+	}
+	return false;
+}
+
+void testCullingBVH()
+{
+	CEntityManager* entityMgr = new CEntityManager();
+
+	const int count = 500;
+	core::array<CEntity*> entities;
+	CEntity** list = entityMgr->createEntity(count, entities);
+
+	core::array<core::aabbox3df> boxes;
+	core::array<int> proxies;
+
+	CCullingBVH bvh;
+
+	TEST_CASE("Culling BVH insert");
+	for (int i = 0; i < count; i++)
+	{
+		core::vector3df pos((f32)((i * 37) % 200) - 100.0f, (f32)((i * 11) % 20), (f32)((i * 53) % 200) - 100.0f);
+		core::aabbox3df box(pos - core::vector3df(1.0f, 1.0f, 1.0f), pos + core::vector3df(1.0f, 2.0f, 1.0f));
+		boxes.push_back(box);
+		proxies.push_back(bvh.createProxy(box, list[i]));
+	}
+	TEST_ASSERT_EQUAL(bvh.getLeafCount(), count);
+	TEST_ASSERT_THROW(bvh.validate());
+	// the tree is balanced
+	TEST_ASSERT_THROW(bvh.getHeight() < 32);
+
+	TEST_CASE("Culling BVH move and remove");
+	for (int i = 0; i < count; i += 3)
+	{
+		// small move is in the fat box
+		core::aabbox3df box = boxes[i];
+		box.MinEdge.X += 0.01f;
+		box.MaxEdge.X += 0.01f;
+		TEST_ASSERT_THROW(bvh.moveProxy(proxies[i], box) == false);
+
+		box.MinEdge.X += 10.0f;
+		box.MaxEdge.X += 10.0f;
+		TEST_ASSERT_THROW(bvh.moveProxy(proxies[i], box) == true);
+		boxes[i] = box;
+	}
+
+	for (int i = 1; i < count; i += 5)
+	{
+		bvh.destroyProxy(proxies[i]);
+		proxies[i] = -1;
+	}
+	TEST_ASSERT_THROW(bvh.validate());
+
+	TEST_CASE("Culling BVH query frustum");
+	core::matrix4 proj, view;
+	proj.buildProjectionMatrixPerspectiveFovLH(core::PI / 3.0f, 1.5f, 0.1f, 80.0f);
+	view.buildCameraLookAtMatrixLH(core::vector3df(0.0f, 10.0f, -50.0f), core::vector3df(20.0f, 0.0f, 0.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+	SViewFrustum frustum(proj * view);
+
+	CFastArray<CEntity*> result;
+	bvh.queryFrustum(frustum, result);
+
+	int numVisible = 0;
+	for (int i = 0; i < count; i++)
+	{
+		if (proxies[i] == -1)
+		{
+			TEST_ASSERT_THROW(!haveEntity(result, list[i]));
+			continue;
+		}
+
+		// no false negative
+		if (isBoxVisible(frustum, boxes[i]))
+		{
+			numVisible++;
+			TEST_ASSERT_THROW(haveEntity(result, list[i]));
+		}
+	}
+	TEST_ASSERT_THROW(numVisible > 0);
+	TEST_ASSERT_THROW(result.count() < bvh.getLeafCount());
+
+	TEST_CASE("Culling BVH query box");
+	core::aabbox3df queryBox(core::vector3df(-20.0f, -5.0f, -20.0f), core::vector3df(20.0f, 30.0f, 20.0f));
+	result.reset();
+	bvh.queryBox(queryBox, result);
+	for (int i = 0; i < count; i++)
+	{
+		if (proxies[i] != -1 && boxes[i].intersectsWithBox(queryBox))
+			TEST_ASSERT_THROW(haveEntity(result, list[i]));
+	}
+
+	delete entityMgr;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testCullingBVH();
\ No newline at end of file
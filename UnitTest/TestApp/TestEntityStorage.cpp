@@ -0,0 +1,99 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestEntityStorage.h"
+
+#include "Entity/CEntityManager.h"
+#include "Transform/CWorldTransformData.h"
+
+using namespace Skylicht;
+
+void testEntityStorage()
+{
+	CEntityManager* entityMgr = new CEntityManager();
+
+	TEST_CASE("Entity chunk storage");
+	TEST_ASSERT_THROW(entityMgr->setUseChunkStorage(true));
+	TEST_ASSERT_THROW(entityMgr->isUseChunkStorage());
+
+	core::array<CEntity*> entities;
+	CEntity** list = entityMgr->createEntity(100, entities);
+	for (int i = 0; i < 100; i++)
+		list[i]->addData<CWorldTransformData>();
+
+	// can't change the storage mode after create entities
+	TEST_ASSERT_THROW(entityMgr->setUseChunkStorage(false) == false);
+
+	CEntityDataAllocator* allocator = entityMgr->getDataAllocator();
+	u32 transformType = DATA_TYPE_INDEX(CWorldTransformData);
+	TEST_ASSERT_EQUAL(allocator->getAllocatedCount(transformType), 100);
+	TEST_ASSERT_EQUAL(allocator->getChunkCount(transformType), 2);
+
+	TEST_CASE("Entity chunk storage contiguous");
+	const CEntityDataAllocator::SChunk* chunk = allocator->getChunk(transformType, 0);
+	TEST_ASSERT_THROW(((size_t)chunk->Data % ENTITY_DATA_CHUNK_ALIGN) == 0);
+	for (int i = 1; i < ENTITY_DATA_CHUNK_SLOTS; i++)
+	{
+		u8* a = (u8*)GET_ENTITY_DATA(list[i - 1], CWorldTransformData);
+		u8* b = (u8*)GET_ENTITY_DATA(list[i], CWorldTransformData);
+		TEST_ASSERT_THROW(b - a == (int)chunk->SlotSize);
+	}
+
+	TEST_CASE("Entity signature");
+	const u32 transformGroup[] = GET_LIST_ENTITY_DATA(CWorldTransformData);
+	u64 signature = (u64)1 << transformType;
+	TEST_ASSERT_THROW((list[0]->getSignature() & signature) == signature);
+	CEntityGroup* group = entityMgr->createGroup(transformGroup, 1);
+	TEST_ASSERT_THROW(group->getSignature() == signature);
+
+	list[0]->removeData<CWorldTransformData>();
+	TEST_ASSERT_THROW((list[0]->getSignature() & signature) == 0);
+	TEST_ASSERT_EQUAL(allocator->getAllocatedCount(transformType), 99);
+
+	// re-use the free slot
+	list[0]->addData<CWorldTransformData>();
+	TEST_ASSERT_EQUAL(allocator->getAllocatedCount(transformType), 100);
+	TEST_ASSERT_EQUAL(allocator->getChunkCount(transformType), 2);
+
+	TEST_CASE("Entity group chunk spans");
+	group->onQuery(entityMgr, list, 100);
+	group->updateDataSpans(entityMgr);
+	TEST_ASSERT_EQUAL(group->getEntityCount(), 100);
+
+	// the entities are created together, so there is a span per chunk
+	const core::array<CEntityGroup::SDataSpan>& spans = group->getDataSpans(transformType);
+	TEST_ASSERT_EQUAL(spans.size(), 2);
+
+	u32 numSpanEntity = 0;
+	CEntity** groupEntities = group->getEntities();
+	for (u32 i = 0; i < spans.size(); i++)
+	{
+		const CEntityGroup::SDataSpan& span = spans[i];
+		TEST_ASSERT_EQUAL(span.Begin, numSpanEntity);
+		TEST_ASSERT_EQUAL(span.Stride, chunk->SlotSize);
+
+		for (u32 j = 0; j < span.Count; j++)
+		{
+			CWorldTransformData* t = (CWorldTransformData*)(IEntityData*)(span.Data + j * span.Stride);
+			TEST_ASSERT_THROW(t == GET_ENTITY_DATA(groupEntities[span.Begin + j], CWorldTransformData));
+		}
+
+		numSpanEntity += span.Count;
+	}
+	TEST_ASSERT_EQUAL(numSpanEntity, 100);
+
+	// an entity without the data splits the span
+	list[10]->removeData<CWorldTransformData>();
+	group->onQuery(entityMgr, list, 100);
+	group->updateDataSpans(entityMgr);
+	TEST_ASSERT_EQUAL(group->getEntityCount(), 99);
+	TEST_ASSERT_EQUAL(group->getDataSpans(transformType).size(), 3);
+	list[10]->addData<CWorldTransformData>();
+
+	TEST_CASE("Entity chunk storage remove");
+	for (int i = 0; i < 50; i++)
+		entityMgr->removeEntity(list[i]);
+	entityMgr->updateRemoveEntity();
+	TEST_ASSERT_EQUAL(allocator->getAllocatedCount(transformType), 50);
+
+	delete entityMgr;
+}
@@ -0,0 +1,155 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestGraphics2DBatching.h"
+
+#include "Graphics2D/CGraphics2D.h"
+#include "Graphics2D/Atlas/CRuntimeAtlas.h"
+
+using namespace Skylicht;
+
+// a readable texture, because the textures of the null driver can not be locked
+class CTestTexture : public ITexture
+{
+protected:
+	core::array<u32> m_data;
+	bool m_readOnly;
+
+public:
+	CTestTexture(const char* name, u32 size, const SColor& color) : ITexture(name),
+		m_readOnly(false)
+	{
+		OriginalSize.set(size, size);
+		Size = OriginalSize;
+		ColorFormat = ECF_A8R8G8B8;
+		Pitch = size * 4;
+
+		m_data.set_used(size * size);
+		for (u32 i = 0; i < size * size; i++)
+			m_data[i] = color.color;
+	}
+
+	virtual void* lock(E_TEXTURE_LOCK_MODE mode = ETLM_READ_WRITE, u32 mipmapLevel = 0)
+	{
+		m_readOnly = mode == ETLM_READ_ONLY;
+		return m_data.pointer();
+	}
+
+	virtual void unlock()
+	{
+		if (!m_readOnly)
+			++ChangedID;
+	}
+
+	virtual void regenerateMipMapLevels(void* mipmapData = 0)
+	{
+	}
+};
+
+static void addImages(ITexture* a, ITexture* b, int count)
+{
+	CGraphics2D* g = CGraphics2D::getInstance();
+	for (int i = 0; i < count; i++)
+	{
+		core::matrix4 world;
+		world.setTranslation(core::vector3df((f32)(i * 20), 0.0f, 0.0f));
+		g->addImageBatch((i % 2) == 0 ? a : b, SColor(255, 255, 255, 255), world, 0);
+	}
+}
+
+void testGraphics2DBatching()
+{
+	CGraphics2D* g = CGraphics2D::getInstance();
+
+	SColor red(255, 255, 0, 0);
+	SColor green(255, 0, 255, 0);
+	CTestTexture* a = new CTestTexture("a", 16, red);
+	CTestTexture* b = new CTestTexture("b", 24, green);
+
+	TEST_CASE("Graphics2D draw call count");
+	g->beginRenderGUI(core::IdentityMatrix, core::IdentityMatrix);
+	addImages(a, b, 10);
+	g->endRenderGUI();
+	TEST_ASSERT_EQUAL(g->getDrawCallCount(), 10);
+
+	TEST_CASE("Graphics2D large batch");
+	g->beginRenderGUI(core::IdentityMatrix, core::IdentityMatrix);
+	for (int i = 0; i < 5000; i++)
+		g->addImageBatch(a, SColor(255, 255, 255, 255), core::IdentityMatrix, 0);
+	TEST_ASSERT_EQUAL(g->getCurrentBuffer()->getVertexBuffer()->getVertexCount(), 20000);
+	g->endRenderGUI();
+	TEST_ASSERT_EQUAL(g->getDrawCallCount(), 1);
+
+	TEST_CASE("Graphics2D runtime atlas");
+	g->setEnableRuntimeAtlas(true);
+	g->beginRenderGUI(core::IdentityMatrix, core::IdentityMatrix);
+	addImages(a, b, 10);
+
+	CRuntimeAtlas* runtimeAtlas = g->getRuntimeAtlas();
+	TEST_ASSERT_EQUAL(runtimeAtlas->getNumAtlas(), 1);
+
+	S3DVertex* vertices = (S3DVertex*)g->getCurrentBuffer()->getVertexBuffer()->getVertices();
+	IImage* image = runtimeAtlas->getAtlas(0)->getImage();
+	float size = (float)runtimeAtlas->getAtlasSize();
+
+	// the first image is red, the second is green
+	int x = core::round32(vertices[0].TCoords.X * size);
+	int y = core::round32(vertices[0].TCoords.Y * size);
+	TEST_ASSERT_THROW(image->getPixel(x, y) == red);
+	TEST_ASSERT_THROW(image->getPixel(x - 1, y) == red);
+	TEST_ASSERT_EQUAL(core::round32(vertices[2].TCoords.X * size) - x, 16);
+
+	x = core::round32(vertices[4].TCoords.X * size);
+	y = core::round32(vertices[4].TCoords.Y * size);
+	TEST_ASSERT_THROW(image->getPixel(x, y) == green);
+	TEST_ASSERT_THROW(image->getPixel(x + 23, y + 23) == green);
+	TEST_ASSERT_EQUAL(core::round32(vertices[6].TCoords.Y * size) - y, 24);
+
+	g->endRenderGUI();
+	TEST_ASSERT_EQUAL(g->getDrawCallCount(), 1);
+
+	TEST_CASE("Graphics2D runtime atlas repeat texture");
+	g->beginRenderGUI(core::IdentityMatrix, core::IdentityMatrix);
+	g->addImageBatch(a, core::rectf(0.0f, 0.0f, 32.0f, 32.0f), core::rectf(0.0f, 0.0f, 32.0f, 32.0f), red, core::IdentityMatrix, 0);
+	TEST_ASSERT_THROW(g->getMaterial().getTexture(0) == a);
+	g->addImageBatch(a, core::rectf(0.0f, 0.0f, 8.0f, 8.0f), core::rectf(0.0f, 0.0f, 8.0f, 8.0f), red, core::IdentityMatrix, 0);
+	TEST_ASSERT_THROW(g->getMaterial().getTexture(0) == runtimeAtlas->getAtlas(0)->getTexture());
+	g->endRenderGUI();
+	TEST_ASSERT_EQUAL(g->getDrawCallCount(), 2);
+
+	TEST_CASE("Graphics2D runtime atlas changed texture");
+	SColor blue(255, 0, 0, 255);
+	u32* pixels = (u32*)a->lock();
+	for (u32 i = 0; i < 16 * 16; i++)
+		pixels[i] = blue.color;
+	a->unlock();
+
+	CRuntimeAtlas::SSlot* slot = runtimeAtlas->getSlot(a);
+	x = slot->Rect.UpperLeftCorner.X;
+	y = slot->Rect.UpperLeftCorner.Y;
+	TEST_ASSERT_THROW(image->getPixel(x, y) == blue);
+	TEST_ASSERT_THROW(image->getPixel(x - 1, y) == blue);
+	TEST_ASSERT_EQUAL(runtimeAtlas->getNumTexture(), 2);
+
+	TEST_CASE("Graphics2D runtime atlas release");
+	CTestTexture* big = new CTestTexture("big", 512, red);
+	TEST_ASSERT_THROW(runtimeAtlas->getSlot(big) == NULL);
+	TEST_ASSERT_EQUAL(big->getReferenceCount(), 2);
+
+	u32 revision = g->getRuntimeAtlasRevision();
+	g->releaseRuntimeAtlasTexture(a);
+	TEST_ASSERT_EQUAL(runtimeAtlas->getNumTexture(), 1);
+	TEST_ASSERT_EQUAL(a->getReferenceCount(), 1);
+	TEST_ASSERT_THROW(g->getRuntimeAtlasRevision() != revision);
+
+	g->clearRuntimeAtlas();
+	TEST_ASSERT_EQUAL(runtimeAtlas->getNumAtlas(), 0);
+	TEST_ASSERT_EQUAL(runtimeAtlas->getNumTexture(), 0);
+	TEST_ASSERT_EQUAL(b->getReferenceCount(), 1);
+	TEST_ASSERT_EQUAL(big->getReferenceCount(), 1);
+
+	g->setEnableRuntimeAtlas(false);
+
+	a->drop();
+	b->drop();
+	big->drop();
+}
@@ -0,0 +1,94 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestHttpRequest.h"
+
+#if defined(BUILD_SKYLICHT_NETWORK) && !defined(__EMSCRIPTEN__)
+
+#include "HttpRequest/CHttpRequest.h"
+#include "HttpRequest/CHttpRequestManager.h"
+
+using namespace Skylicht::Network;
+
+// nothing listens on this port, the connection is refused
+#define REFUSED_URL "http://127.0.0.1:1/"
+
+static bool waitShared(CHttpRequestManager* manager, CHttpRequest* request)
+{
+	u32 start = os::Timer::getRealTime();
+	while (os::Timer::getRealTime() - start < 5000)
+	{
+		// the application polls the manager once per frame
+		manager->update();
+
+		if (request->updateRequest())
+			return true;
+	}
+	return false;
+}
+
+void testHttpRequest()
+{
+	CHttpRequest::globalInit();
+
+	TEST_CASE("Http request manager update");
+	CHttpRequestManager* manager = CHttpRequestManager::createGetInstance();
+
+	CHttpRequest* request = manager->createRequest(new CHttpStream(1024));
+	TEST_ASSERT_THROW(request->getManager() == manager);
+
+	request->setURL(REFUSED_URL);
+	request->sendRequest();
+	TEST_ASSERT_THROW(manager->getRequestCount() == 1);
+
+	// the request only reads its own state, the transfer does not progress without the manager
+	for (int i = 0; i < 100; i++)
+		TEST_ASSERT_THROW(request->updateRequest() == false);
+	TEST_ASSERT_THROW(manager->getRequestCount() == 1);
+
+	TEST_ASSERT_THROW(waitShared(manager, request));
+	TEST_ASSERT_THROW(request->getResponseCode() == -1);
+	TEST_ASSERT_THROW(request->isTimeOut() == false);
+	TEST_ASSERT_THROW(manager->getRequestCount() == 0);
+
+	// send again on the same request
+	request->sendRequest();
+	TEST_ASSERT_THROW(manager->getRequestCount() == 1);
+	TEST_ASSERT_THROW(waitShared(manager, request));
+	TEST_ASSERT_THROW(manager->getRequestCount() == 0);
+
+	// delete a running request
+	request->sendRequest();
+	TEST_ASSERT_THROW(manager->getRequestCount() == 1);
+	delete request;
+	TEST_ASSERT_THROW(manager->getRequestCount() == 0);
+	manager->update();
+
+	TEST_CASE("Http request standalone");
+	// the requests that do not join the manager keep their own multi handle
+	IHttpRequest* standalone = IHttpRequest::create(new CHttpStream(1024));
+	TEST_ASSERT_THROW(((CHttpRequest*)standalone)->getManager() == NULL);
+
+	standalone->setURL(REFUSED_URL);
+	standalone->sendRequest();
+	TEST_ASSERT_THROW(manager->getRequestCount() == 0);
+
+	bool finish = false;
+	u32 start = os::Timer::getRealTime();
+	while (!finish && os::Timer::getRealTime() - start < 5000)
+		finish = standalone->updateRequest();
+
+	TEST_ASSERT_THROW(finish);
+	TEST_ASSERT_THROW(standalone->getResponseCode() == -1);
+	delete standalone;
+
+	CHttpRequestManager::releaseInstance();
+	CHttpRequest::globalFree();
+}
+
+#else
+
+void testHttpRequest()
+{
+}
+
+#endif
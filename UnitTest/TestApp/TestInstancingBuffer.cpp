@@ -0,0 +1,376 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestInstancingBuffer.h"
+
+#include "Entity/CEntityManager.h"
+#include "Material/Shader/Instancing/IShaderInstancing.h"
+#include "RenderMesh/CMeshRendererInstancing.h"
+
+#include <chrono>
+
+using namespace Skylicht;
+
+extern bool g_benchmark;
+
+class CTestMeshRendererInstancing : public CMeshRendererInstancing
+{
+public:
+	u32 nextFrame()
+	{
+		return ++m_updateFrame;
+	}
+
+	void add(SMeshInstancingGroup* group, CRenderMeshData* meshData)
+	{
+		addInstance(group, meshData);
+	}
+
+	void removeCulled(SMeshInstancingGroup* group)
+	{
+		removeCulledInstances(group);
+	}
+};
+
+// a hardware buffer that only records the update ranges
+class CTestHardwareBuffer : public IHardwareBuffer
+{
+public:
+	CTestHardwareBuffer() : IHardwareBuffer(scene::EHM_DYNAMIC, 0, 1024, EHBT_VERTEX, EDT_NULL)
+	{
+	}
+
+	virtual bool update(const scene::E_HARDWARE_MAPPING mapping, const u32 size, const void* data)
+	{
+		RequiredUpdate = false;
+		NumUpdateRange = 0;
+		return true;
+	}
+};
+
+static double getTimeMs(std::chrono::high_resolution_clock::time_point begin)
+{
+	std::chrono::duration<double, std::milli> t = std::chrono::high_resolution_clock::now() - begin;
+	return t.count();
+}
+
+static bool bufferEqual(IVertexBuffer* a, IVertexBuffer* b)
+{
+	if (a->getVertexCount() != b->getVertexCount())
+		return false;
+
+	SVtxTransform* ta = (SVtxTransform*)a->getVertices();
+	SVtxTransform* tb = (SVtxTransform*)b->getVertices();
+	for (u32 i = 0, n = a->getVertexCount(); i < n; i++)
+	{
+		if (!(ta[i] == tb[i]))
+			return false;
+	}
+	return true;
+}
+
+static bool lightingEqual(IVertexBuffer* a, IVertexBuffer* b)
+{
+	if (a->getVertexCount() != b->getVertexCount())
+		return false;
+
+	SVtxIndirectLighting* la = (SVtxIndirectLighting*)a->getVertices();
+	SVtxIndirectLighting* lb = (SVtxIndirectLighting*)b->getVertices();
+	for (u32 i = 0, n = a->getVertexCount(); i < n; i++)
+	{
+		if (!(la[i] == lb[i]))
+			return false;
+	}
+	return true;
+}
+
+void testInstancingBuffer()
+{
+	CEntityManager* entityMgr = new CEntityManager();
+
+	const int count = 1000;
+	core::array<CEntity*> entities;
+	CEntity** list = entityMgr->createEntity(count, entities);
+
+	for (int i = 0; i < count; i++)
+	{
+		CWorldTransformData* world = list[i]->addData<CWorldTransformData>();
+		world->World.setTranslation(core::vector3df((f32)i, 0.0f, (f32)(i % 7)));
+
+		CIndirectLightingData* lighting = list[i]->addData<CIndirectLightingData>();
+		lighting->Type = CIndirectLightingData::AmbientColor;
+		lighting->Color = SColor(255, i % 255, 100, 50);
+	}
+
+	IVertexBuffer* tBuffer = IShaderInstancing::createTransformVertexBuffer();
+	IVertexBuffer* lBuffer = IShaderInstancing::createIndirectLightingVertexBuffer();
+
+	IVertexBuffer* tReference = IShaderInstancing::createTransformVertexBuffer();
+	IVertexBuffer* lReference = IShaderInstancing::createIndirectLightingVertexBuffer();
+
+	CVertexBuffer<SVtxTransform>* tVertices = dynamic_cast<CVertexBuffer<SVtxTransform>*>(tBuffer);
+	CVertexBuffer<SVtxIndirectLighting>* lVertices = dynamic_cast<CVertexBuffer<SVtxIndirectLighting>*>(lBuffer);
+	TEST_ASSERT_THROW(tVertices != NULL && lVertices != NULL);
+
+	TEST_CASE("Instancing buffer first batch");
+	core::array<int> allSlots;
+	for (int i = 0; i < count; i++)
+		allSlots.push_back(i);
+	TEST_ASSERT_EQUAL(IShaderInstancing::updateTransformAndLighting(tVertices, lVertices, list, count, allSlots.pointer(), count), 1);
+
+	IShaderInstancing::batchTransformAndLighting(tReference, lReference, list, count);
+	TEST_ASSERT_THROW(bufferEqual(tBuffer, tReference));
+	TEST_ASSERT_THROW(lightingEqual(lBuffer, lReference));
+
+	TEST_CASE("Instancing buffer skip unchanged");
+	u32 changeID = tBuffer->getChangedID();
+	TEST_ASSERT_EQUAL(IShaderInstancing::updateTransformAndLighting(tVertices, lVertices, list, count, NULL, 0), 0);
+	TEST_ASSERT_EQUAL(tBuffer->getChangedID(), changeID);
+
+	TEST_CASE("Instancing buffer dirty range");
+	GET_ENTITY_DATA(list[17], CWorldTransformData)->World.setTranslation(core::vector3df(0.0f, 10.0f, 0.0f));
+	GET_ENTITY_DATA(list[42], CIndirectLightingData)->Color = SColor(255, 0, 0, 255);
+	GET_ENTITY_DATA(list[42], CIndirectLightingData)->notifyChanged();
+
+	// the renderer collects the changed slots from NeedValidate and ChangeRevision
+	int changedSlots[] = { 42, 17, 43, 42 };
+
+	// [17, 18) and [42, 44)
+	TEST_ASSERT_EQUAL(IShaderInstancing::updateTransformAndLighting(tVertices, lVertices, list, count, changedSlots, 4), 2);
+	TEST_ASSERT_THROW(tBuffer->getChangedID() != changeID);
+
+	IShaderInstancing::batchTransformAndLighting(tReference, lReference, list, count);
+	TEST_ASSERT_THROW(bufferEqual(tBuffer, tReference));
+	TEST_ASSERT_THROW(lightingEqual(lBuffer, lReference));
+
+	TEST_CASE("Instancing buffer moved slot");
+	// the slot 5 is replaced by the last instance, it must be rewritten
+	list[5] = list[count - 1];
+	int movedSlots[] = { 5 };
+	TEST_ASSERT_EQUAL(IShaderInstancing::updateTransformAndLighting(tVertices, lVertices, list, count - 1, movedSlots, 1), 1);
+	TEST_ASSERT_EQUAL((int)tBuffer->getVertexCount(), count - 1);
+
+	IShaderInstancing::batchTransformAndLighting(tReference, lReference, list, count - 1);
+	TEST_ASSERT_THROW(bufferEqual(tBuffer, tReference));
+	TEST_ASSERT_THROW(lightingEqual(lBuffer, lReference));
+
+	TEST_CASE("Instancing buffer changed slot out of range");
+	// the changed instance at the last slot is moved to slot 5 (rewritten as a moved slot), its old slot is skipped
+	changedSlots[0] = count - 1;
+	TEST_ASSERT_EQUAL(IShaderInstancing::updateTransformAndLighting(tVertices, lVertices, list, count - 1, changedSlots, 1), 0);
+
+	TEST_CASE("Instancing buffer update ranges");
+	CTestHardwareBuffer* hwBuffer = new CTestHardwareBuffer();
+	hwBuffer->update(scene::EHM_DYNAMIC, 0, NULL);
+
+	// the scattered ranges are kept, the overlapped ranges are merged
+	hwBuffer->requestUpdate(0, 16);
+	hwBuffer->requestUpdate(512, 16);
+	hwBuffer->requestUpdate(8, 16);
+	TEST_ASSERT_THROW(hwBuffer->isRequiredUpdate());
+	TEST_ASSERT_EQUAL(hwBuffer->getNumUpdateRange(), 2);
+	TEST_ASSERT_EQUAL(hwBuffer->getUpdateOffset(0), 512);
+	TEST_ASSERT_EQUAL(hwBuffer->getUpdateOffset(1), 0);
+	TEST_ASSERT_EQUAL(hwBuffer->getUpdateSize(1), 24);
+
+	// too many ranges, the nearest ranges are merged
+	for (u32 i = 0; i < 32; i++)
+		hwBuffer->requestUpdate(32 + i * 8, 4);
+	TEST_ASSERT_THROW(hwBuffer->getNumUpdateRange() <= 16);
+	u32 numBytes = 0;
+	for (u32 i = 0; i < hwBuffer->getNumUpdateRange(); i++)
+		numBytes += hwBuffer->getUpdateSize(i);
+	TEST_ASSERT_THROW(numBytes < 512);
+
+	// the full update
+	hwBuffer->requestUpdate();
+	hwBuffer->requestUpdate(0, 16);
+	TEST_ASSERT_EQUAL(hwBuffer->getNumUpdateRange(), 0);
+	hwBuffer->drop();
+
+	tBuffer->drop();
+	lBuffer->drop();
+	tReference->drop();
+	lReference->drop();
+
+	delete entityMgr;
+}
+
+void testInstancingSlot()
+{
+	CEntityManager* entityMgr = new CEntityManager();
+
+	const int count = 10;
+	core::array<CEntity*> entities;
+	CEntity** list = entityMgr->createEntity(count, entities);
+
+	CRenderMeshData* meshes[count];
+	for (int i = 0; i < count; i++)
+	{
+		list[i]->addData<CWorldTransformData>();
+		list[i]->addData<CIndirectLightingData>();
+		meshes[i] = list[i]->addData<CRenderMeshData>();
+	}
+
+	CTestMeshRendererInstancing* renderer = new CTestMeshRendererInstancing();
+	SMeshInstancingGroup* group = new SMeshInstancingGroup();
+
+	TEST_CASE("Instancing slot add");
+	u32 frame = renderer->nextFrame();
+	for (int i = 0; i < count; i++)
+		renderer->add(group, meshes[i]);
+
+	TEST_ASSERT_EQUAL(group->Slots.count(), count);
+	TEST_ASSERT_EQUAL(group->DirtySlots.count(), count);
+	TEST_ASSERT_THROW(group->SlotsMoved);
+	for (int i = 0; i < count; i++)
+	{
+		SMeshInstanceSlot& slot = group->Slots.pointer()[i];
+		TEST_ASSERT_EQUAL(meshes[i]->getInstancingSlot(), i);
+		TEST_ASSERT_THROW(slot.RenderMesh == meshes[i]);
+		TEST_ASSERT_THROW(slot.Transform == GET_ENTITY_DATA(list[i], CWorldTransformData));
+		TEST_ASSERT_THROW(slot.IndirectLighting == GET_ENTITY_DATA(list[i], CIndirectLightingData));
+		TEST_ASSERT_THROW(slot.Material == NULL);
+		TEST_ASSERT_THROW(slot.Frame == frame);
+	}
+
+	renderer->removeCulled(group);
+	TEST_ASSERT_EQUAL(group->Slots.count(), count);
+
+	TEST_CASE("Instancing slot culled");
+	group->DirtySlots.reset();
+	group->SlotsMoved = false;
+
+	// the instance 3 and 9 are culled
+	frame = renderer->nextFrame();
+	for (int i = 0; i < count; i++)
+	{
+		if (i != 3 && i != 9)
+			group->Slots.pointer()[meshes[i]->getInstancingSlot()].Frame = frame;
+	}
+
+	renderer->removeCulled(group);
+
+	// the last visible instance is moved to slot 3, the others keep their slots
+	TEST_ASSERT_EQUAL(group->Slots.count(), count - 2);
+	TEST_ASSERT_EQUAL(group->Entities.count(), count - 2);
+	TEST_ASSERT_THROW(group->SlotsMoved);
+	TEST_ASSERT_THROW(group->DirtySlots.count() > 0);
+	for (int i = 0; i < group->DirtySlots.count(); i++)
+		TEST_ASSERT_EQUAL(group->DirtySlots.pointer()[i], 3);
+	TEST_ASSERT_THROW(group->Slots.pointer()[3].RenderMesh == meshes[8]);
+	TEST_ASSERT_THROW(group->Entities.pointer()[3] == list[8]);
+	TEST_ASSERT_EQUAL(meshes[8]->getInstancingSlot(), 3);
+	for (int i = 0; i < count - 2; i++)
+	{
+		if (i != 3)
+		{
+			TEST_ASSERT_THROW(group->Slots.pointer()[i].RenderMesh == meshes[i]);
+			TEST_ASSERT_EQUAL(meshes[i]->getInstancingSlot(), i);
+		}
+	}
+
+	TEST_CASE("Instancing slot reuse");
+	group->DirtySlots.reset();
+	group->SlotsMoved = false;
+
+	// the instance 3 is visible again, it is added at the end
+	frame = renderer->nextFrame();
+	for (int i = 0; i < group->Slots.count(); i++)
+		group->Slots.pointer()[i].Frame = frame;
+	renderer->add(group, meshes[3]);
+
+	renderer->removeCulled(group);
+
+	TEST_ASSERT_EQUAL(group->Slots.count(), count - 1);
+	TEST_ASSERT_EQUAL(meshes[3]->getInstancingSlot(), count - 2);
+	TEST_ASSERT_THROW(group->Slots.pointer()[count - 2].RenderMesh == meshes[3]);
+	TEST_ASSERT_EQUAL(group->DirtySlots.count(), 1);
+	TEST_ASSERT_EQUAL(group->DirtySlots.pointer()[0], count - 2);
+	TEST_ASSERT_EQUAL(meshes[8]->getInstancingSlot(), 3);
+
+	TEST_CASE("Instancing slot scattered culled");
+	group->DirtySlots.reset();
+	group->SlotsMoved = false;
+
+	// the instances at slot 1 and 4 are culled, only these slots are rewritten (not the slots between them)
+	frame = renderer->nextFrame();
+	for (int i = 0; i < group->Slots.count(); i++)
+	{
+		if (i != 1 && i != 4)
+			group->Slots.pointer()[i].Frame = frame;
+	}
+
+	renderer->removeCulled(group);
+
+	TEST_ASSERT_EQUAL(group->Slots.count(), count - 3);
+	TEST_ASSERT_EQUAL(group->DirtySlots.count(), 2);
+	TEST_ASSERT_EQUAL(group->DirtySlots.pointer()[0], 1);
+	TEST_ASSERT_EQUAL(group->DirtySlots.pointer()[1], 4);
+	for (int i = 0; i < group->Slots.count(); i++)
+		TEST_ASSERT_EQUAL(group->Slots.pointer()[i].RenderMesh->getInstancingSlot(), i);
+
+	delete group;
+	delete renderer;
+	delete entityMgr;
+}
+
+void testInstancingBufferCost()
+{
+	if (!g_benchmark)
+		return;
+
+	CEntityManager* entityMgr = new CEntityManager();
+
+	const int count = 10000;
+	const int numChanged = 100;
+	const int loop = 100;
+
+	core::array<CEntity*> entities;
+	CEntity** list = entityMgr->createEntity(count, entities);
+
+	for (int i = 0; i < count; i++)
+	{
+		CWorldTransformData* world = list[i]->addData<CWorldTransformData>();
+		world->World.setTranslation(core::vector3df((f32)i, 0.0f, 0.0f));
+
+		CIndirectLightingData* lighting = list[i]->addData<CIndirectLightingData>();
+		lighting->Type = CIndirectLightingData::AmbientColor;
+		lighting->Color = SColor(255, i % 255, 100, 50);
+	}
+
+	int changedSlots[numChanged];
+	int dirtySlots[numChanged];
+	for (int i = 0; i < numChanged; i++)
+		changedSlots[i] = i * (count / numChanged);
+
+	IVertexBuffer* tBuffer = IShaderInstancing::createTransformVertexBuffer();
+	IVertexBuffer* lBuffer = IShaderInstancing::createIndirectLightingVertexBuffer();
+	CVertexBuffer<SVtxTransform>* tVertices = dynamic_cast<CVertexBuffer<SVtxTransform>*>(tBuffer);
+	CVertexBuffer<SVtxIndirectLighting>* lVertices = dynamic_cast<CVertexBuffer<SVtxIndirectLighting>*>(lBuffer);
+
+	TEST_CASE("Instancing buffer CPU cost");
+
+	std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loop; i++)
+		IShaderInstancing::batchTransformAndLighting(tBuffer, lBuffer, list, count);
+	double fullTime = getTimeMs(begin);
+
+	begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loop; i++)
+	{
+		for (int j = 0; j < numChanged; j++)
+			dirtySlots[j] = changedSlots[j];
+		IShaderInstancing::updateTransformAndLighting(tVertices, lVertices, list, count, dirtySlots, numChanged);
+	}
+	double dirtyTime = getTimeMs(begin);
+
+	printf("   %d instances (%d changed) x %d: full rewrite %.3f ms/frame, dirty slots %.3f ms/frame\n",
+		count, numChanged, loop,
+		fullTime / loop,
+		dirtyTime / loop);
+
+	tBuffer->drop();
+	lBuffer->drop();
+
+	delete entityMgr;
+}
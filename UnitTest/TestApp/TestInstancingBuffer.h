@@ -0,0 +1,7 @@
+#pragma once
+
+void testInstancingBuffer();
+
+void testInstancingSlot();
+
+void testInstancingBufferCost();
@@ -0,0 +1,136 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestMatrixBatch.h"
+
+#include "Utils/CMatrixBatch.h"
+
+#include <chrono>
+
+using namespace Skylicht;
+
+extern bool g_benchmark;
+
+static void randomTransform(core::matrix4& m, int seed)
+{
+	core::vector3df rot((f32)(seed % 360), (f32)((seed * 7) % 360), (f32)((seed * 13) % 360));
+	core::vector3df pos((f32)(seed % 100), (f32)(seed % 50), (f32)(seed % 25));
+	core::vector3df scale(1.0f + (seed % 3) * 0.5f, 1.0f, 2.0f);
+
+	m.makeIdentity();
+	m.setRotationDegrees(rot);
+	m.setTranslation(pos);
+	m.setScale(scale);
+}
+
+static bool matrixEqual(const core::matrix4& a, const core::matrix4& b)
+{
+	for (int i = 0; i < 16; i++)
+	{
+		if (!core::equals(a[i], b[i], 0.001f))
+			return false;
+	}
+	return true;
+}
+
+static double getTimeMs(std::chrono::high_resolution_clock::time_point begin)
+{
+	std::chrono::duration<double, std::milli> t = std::chrono::high_resolution_clock::now() - begin;
+	return t.count();
+}
+
+static void benchmarkMatrixBatch(int count)
+{
+	std::vector<core::matrix4> a(count);
+	std::vector<core::matrix4> b(count);
+	std::vector<core::matrix4> out(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		randomTransform(a[i], i);
+		randomTransform(b[i], i + 1);
+	}
+
+	// same amount of work for each size
+	int loop = core::max_(1, 2000000 / count);
+
+	std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loop; i++)
+		CMatrixBatch::multiplyScalar(out.data(), a.data(), b.data(), count);
+	double scalarTime = getTimeMs(begin);
+
+	begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loop; i++)
+		CMatrixBatch::multiply(out.data(), a.data(), b.data(), count);
+	double simdTime = getTimeMs(begin);
+
+	begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loop; i++)
+		CMatrixBatch::inverseScalar(a.data(), out.data(), count);
+	double scalarInvTime = getTimeMs(begin);
+
+	begin = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < loop; i++)
+		CMatrixBatch::inverse(a.data(), out.data(), count);
+	double simdInvTime = getTimeMs(begin);
+
+	double total = (double)count * loop;
+	printf("   %d matrices x %d: multiply scalar %.2f M/s, simd %.2f M/s; inverse scalar %.2f M/s, simd %.2f M/s\n",
+		count, loop,
+		total / (scalarTime * 1000.0),
+		total / (simdTime * 1000.0),
+		total / (scalarInvTime * 1000.0),
+		total / (simdInvTime * 1000.0));
+}
+
+void testMatrixBatch()
+{
+	TEST_CASE("Matrix batch multiply");
+	const int count = 64;
+	core::matrix4 a[count], b[count], out[count], ref[count];
+	for (int i = 0; i < count; i++)
+	{
+		randomTransform(a[i], i);
+		randomTransform(b[i], i * 3 + 1);
+	}
+
+	CMatrixBatch::multiply(out, a, b, count);
+	CMatrixBatch::multiplyScalar(ref, a, b, count);
+	for (int i = 0; i < count; i++)
+		TEST_ASSERT_THROW(matrixEqual(out[i], ref[i]));
+
+	TEST_CASE("Matrix batch inverse");
+	TEST_ASSERT_EQUAL(CMatrixBatch::inverse(a, out, count), 0);
+	TEST_ASSERT_EQUAL(CMatrixBatch::inverseScalar(a, ref, count), 0);
+	for (int i = 0; i < count; i++)
+	{
+		TEST_ASSERT_THROW(matrixEqual(out[i], ref[i]));
+
+		// in-place
+		core::matrix4 m = a[i];
+		TEST_ASSERT_THROW(CMatrixBatch::inverse(m, m));
+		TEST_ASSERT_THROW(matrixEqual(m, ref[i]));
+	}
+
+	// singular matrix
+	core::matrix4 zero(core::matrix4::EM4CONST_NOTHING);
+	zero.makeIdentity();
+	zero.setScale(core::vector3df(0.0f, 1.0f, 1.0f));
+	core::matrix4 unchanged;
+	TEST_ASSERT_THROW(CMatrixBatch::inverse(zero, unchanged) == false);
+	TEST_ASSERT_THROW(unchanged.isIdentity());
+
+	// projection matrix use the generic path
+	core::matrix4 proj;
+	proj.buildProjectionMatrixPerspectiveFovLH(core::PI / 3.0f, 1.5f, 0.1f, 100.0f);
+	TEST_ASSERT_THROW(CMatrixBatch::inverse(proj, out[0]));
+	TEST_ASSERT_THROW(proj.getInverse(ref[0]));
+	TEST_ASSERT_THROW(matrixEqual(out[0], ref[0]));
+
+	if (!g_benchmark)
+		return;
+
+	TEST_CASE("Matrix batch benchmark");
+	benchmarkMatrixBatch(10000);
+	benchmarkMatrixBatch(100000);
+	benchmarkMatrixBatch(1000000);
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testMatrixBatch();
\ No newline at end of file
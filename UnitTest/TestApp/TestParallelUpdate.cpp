@@ -0,0 +1,91 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestParallelUpdate.h"
+
+#include "Scene/CScene.h"
+#include "Transform/CWorldTransformData.h"
+#include "Transform/CWorldInverseTransformData.h"
+
+using namespace Skylicht;
+
+// create a hierarchy of containers, each of them has a child object
+static void createHierarchy(CScene* scene, core::array<CGameObject*>& objects)
+{
+	CZone* zone = scene->createZone();
+
+	CContainerObject* parent = zone;
+	for (int i = 0; i < 8; i++)
+	{
+		CContainerObject* container = parent->createContainerObject();
+		CGameObject* child = container->createEmptyObject();
+
+		objects.push_back(container);
+		objects.push_back(child);
+
+		if (i % 3 == 0)
+			parent = container;
+	}
+
+	scene->updateAddRemoveObject();
+
+	for (u32 i = 0; i < objects.size(); i++)
+		objects[i]->getEntity()->addData<CWorldInverseTransformData>();
+}
+
+static void moveObjects(core::array<CGameObject*>& objects, int frame)
+{
+	for (u32 i = 0; i < objects.size(); i++)
+	{
+		// only move some of the objects each frame
+		if ((i + frame) % 3 != 0)
+			continue;
+
+		CTransformEuler* transform = objects[i]->getTransformEuler();
+		transform->setPosition(core::vector3df((f32)i, (f32)frame, 1.0f));
+		transform->setRotation(core::vector3df(0.0f, (f32)(frame * 10 + i), 0.0f));
+	}
+}
+
+void testParallelUpdate()
+{
+	TEST_CASE("Parallel entity system update");
+	CScene* serialScene = new CScene();
+	CScene* parallelScene = new CScene();
+	parallelScene->getEntityManager()->setParallelUpdate(true);
+
+	core::array<CGameObject*> serialObjects;
+	core::array<CGameObject*> parallelObjects;
+	createHierarchy(serialScene, serialObjects);
+	createHierarchy(parallelScene, parallelObjects);
+
+	for (int frame = 0; frame < 5; frame++)
+	{
+		moveObjects(serialObjects, frame);
+		moveObjects(parallelObjects, frame);
+
+		serialScene->update();
+		parallelScene->update();
+
+		for (u32 i = 0; i < serialObjects.size(); i++)
+		{
+			CEntity* a = serialObjects[i]->getEntity();
+			CEntity* b = parallelObjects[i]->getEntity();
+
+			CWorldTransformData* worldA = GET_ENTITY_DATA(a, CWorldTransformData);
+			CWorldTransformData* worldB = GET_ENTITY_DATA(b, CWorldTransformData);
+			TEST_ASSERT_THROW(worldA->World == worldB->World);
+
+			CWorldInverseTransformData* invA = GET_ENTITY_DATA(a, CWorldInverseTransformData);
+			CWorldInverseTransformData* invB = GET_ENTITY_DATA(b, CWorldInverseTransformData);
+			TEST_ASSERT_THROW(invA->WorldInverse == invB->WorldInverse);
+		}
+	}
+
+	// the child follows its moved parent
+	CWorldTransformData* child = GET_ENTITY_DATA(parallelObjects[1]->getEntity(), CWorldTransformData);
+	CWorldTransformData* parent = GET_ENTITY_DATA(parallelObjects[0]->getEntity(), CWorldTransformData);
+	TEST_ASSERT_THROW(child->World.equals(parent->World * child->Relative, 0.001f));
+
+	delete serialScene;
+	delete parallelScene;
+}
@@ -0,0 +1,240 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestParticleSystem.h"
+
+#include "ParticleSystem/CParticleGroupSystem.h"
+#include "ParticleSystem/Particles/CGroup.h"
+#include "ParticleSystem/Particles/CFactory.h"
+#include "ParticleSystem/Particles/Systems/CVortexSystem.h"
+#include "Job/CJobScheduler.h"
+
+using namespace Skylicht;
+using namespace Skylicht::Particle;
+
+// the per particle update of CParticleSystem, with fmod on every rotation
+static void updateReference(CParticle* particles, int num, CGroup* group, float dt)
+{
+	dt = dt * 0.001f;
+
+	float pi2 = 2 * core::PI;
+	core::vector3df gravity = group->Gravity * dt;
+	float friction = group->Friction * dt;
+
+	std::vector<CModel*>& models = group->getModels();
+
+	for (int i = 0; i < num; i++)
+	{
+		CParticle* p = particles + i;
+		float* params = p->Params;
+
+		p->Age = p->Age + dt;
+		if (!p->Immortal)
+			p->Life -= dt;
+
+		p->LastPosition = p->Position;
+		p->Position += p->Velocity * dt;
+		p->Velocity += gravity;
+
+		if (p->HaveRotate == true)
+		{
+			p->Rotation.X = fmod(p->Rotation.X + params[RotateSpeedX] * dt, pi2);
+			p->Rotation.Y = fmod(p->Rotation.Y + params[RotateSpeedY] * dt, pi2);
+			p->Rotation.Z = fmod(p->Rotation.Z + params[RotateSpeedZ] * dt, pi2);
+		}
+
+		if (group->Friction > 0.0f)
+			p->Velocity *= 1.0f - core::min_(1.0f, friction / params[Mass]);
+
+		float x = core::clamp(p->Age / p->LifeTime, 0.0f, 1.0f);
+
+		for (CModel* m : models)
+		{
+			EParticleParams t = m->getType();
+			params[t] = p->StartValue[t] + (p->EndValue[t] - p->StartValue[t]) * x;
+
+			if (t == Scale)
+			{
+				params[ScaleX] = params[Scale];
+				params[ScaleY] = params[Scale];
+				params[ScaleZ] = params[Scale];
+			}
+		}
+	}
+}
+
+static void initParticles(core::array<CParticle>& particles, int count)
+{
+	particles.clear();
+	for (int i = 0; i < count; i++)
+	{
+		CParticle p(i);
+		p.Position.set((f32)(i % 7), (f32)(i % 11), (f32)(i % 13));
+		p.Velocity.set((f32)(i % 5) - 2.0f, 3.0f, (f32)(i % 3));
+		p.Life = 0.5f + (i % 10) * 0.1f;
+		p.LifeTime = p.Life;
+		p.Immortal = (i % 9) == 0;
+		p.HaveRotate = (i % 2) == 0;
+		p.Params[Mass] = 1.0f + (i % 3);
+		p.Params[RotateSpeedX] = 100.0f;
+		p.Params[RotateSpeedY] = -100.0f;
+		p.StartValue[ColorA] = 1.0f;
+		p.EndValue[ColorA] = 0.0f;
+		p.StartValue[Scale] = 0.5f;
+		p.EndValue[Scale] = 2.0f + (i % 4);
+		particles.push_back(p);
+	}
+}
+
+static bool particleEqual(const CParticle& a, const CParticle& b)
+{
+	if (a.Position != b.Position || a.Velocity != b.Velocity || a.LastPosition != b.LastPosition || a.Rotation != b.Rotation)
+		return false;
+
+	if (a.Age != b.Age || a.Life != b.Life)
+		return false;
+
+	for (int i = 0; i < NumParams; i++)
+	{
+		if (a.Params[i] != b.Params[i])
+			return false;
+	}
+	return true;
+}
+
+static CGroup* createEmitGroup(CFactory* factory, s32 seed, int tank)
+{
+	CGroup* group = new CGroup();
+	group->setRandomSeed(seed);
+	group->LifeMin = 1.0f;
+	group->LifeMax = 3.0f;
+
+	CEmitter* emitter = group->addEmitter(factory->createRandomEmitter());
+	emitter->setZone(factory->createSphereZone(core::vector3df(), 2.0f));
+	emitter->setFlow(-1.0f);
+	emitter->setTank(tank);
+	emitter->setForce(1.0f, 5.0f);
+	return group;
+}
+
+void testParticleSystem()
+{
+	TEST_CASE("Particle system update");
+	CGroup* group = new CGroup();
+	group->Gravity.set(0.0f, -9.8f, 0.0f);
+	group->Friction = 0.5f;
+	group->createModel(ColorA);
+	group->createModel(Scale);
+
+	const int count = 103;
+	core::array<CParticle> particles;
+	core::array<CParticle> reference;
+	initParticles(particles, count);
+	initParticles(reference, count);
+
+	CParticleSystem system;
+	for (int frame = 0; frame < 10; frame++)
+	{
+		system.update(particles.pointer(), count, group, 16.0f);
+		updateReference(reference.pointer(), count, group, 16.0f);
+	}
+
+	for (int i = 0; i < count; i++)
+		TEST_ASSERT_THROW(particleEqual(particles[i], reference[i]));
+
+	// immortal particle keep its life
+	TEST_ASSERT_THROW(particles[0].Life == 0.5f);
+
+	TEST_CASE("Particle swap");
+	particles[0].swap(particles[1]);
+	TEST_ASSERT_THROW(particles[0].Immortal == false);
+	TEST_ASSERT_THROW(particles[1].Immortal == true);
+	TEST_ASSERT_THROW(particles[0].Index == 0);
+
+	TEST_CASE("Particle system span");
+	initParticles(particles, count);
+	initParticles(reference, count);
+
+	CVortexSystem vortex(core::vector3df(1.0f, 0.0f, 0.0f), core::vector3df(0.0f, 1.0f, 0.0f), 2.0f, 0.5f);
+	vortex.update(reference.pointer(), count, group, 16.0f);
+
+	vortex.updateSpan(SParticleSpan(particles.pointer(), 0, 50), group, 16.0f);
+	vortex.updateSpan(SParticleSpan(particles.pointer(), 50, count), group, 16.0f);
+
+	for (int i = 0; i < count; i++)
+		TEST_ASSERT_THROW(particleEqual(particles[i], reference[i]));
+
+	delete group;
+
+	TEST_CASE("Particle group lazy seed");
+	// a new group does not take a seed from the shared random sequence
+	random_reset(1234);
+	int first = random(0, 1000000);
+	random_reset(1234);
+	CGroup* lazyGroup = new CGroup();
+	TEST_ASSERT_THROW(lazyGroup->getRandomSeed() == 0);
+	TEST_ASSERT_THROW(random(0, 1000000) == first);
+
+	lazyGroup->initRandomSeed();
+	s32 seed = lazyGroup->getRandomSeed();
+	TEST_ASSERT_THROW(seed != 0);
+	lazyGroup->initRandomSeed();
+	TEST_ASSERT_EQUAL(seed, lazyGroup->getRandomSeed());
+	delete lazyGroup;
+
+	// the parallel update is a setting of each entity manager's system
+	CParticleGroupSystem parallelSystem;
+	CParticleGroupSystem serialSystem;
+	parallelSystem.setParallelUpdate(true);
+	TEST_ASSERT_THROW(parallelSystem.isParallelUpdate());
+	TEST_ASSERT_THROW(!serialSystem.isParallelUpdate());
+
+	TEST_CASE("Particle group parallel update");
+	CFactory factory;
+	const int numGroups = 4;
+	CGroup* serialGroups[numGroups];
+	CGroup* parallelGroups[numGroups];
+	for (int i = 0; i < numGroups; i++)
+	{
+		// the first group is large enough to be split into spans
+		int tank = i == 0 ? 5000 : 500;
+		serialGroups[i] = createEmitGroup(&factory, 1000 + i, tank);
+		parallelGroups[i] = createEmitGroup(&factory, 1000 + i, tank);
+	}
+
+	for (int frame = 0; frame < 3; frame++)
+	{
+		// the shared random sequence does not change the group's result
+		for (int i = numGroups - 1; i >= 0; i--)
+		{
+			serialGroups[i]->update(true);
+			random(0.0f, 1.0f);
+		}
+
+		System::CJobScheduler::getInstance()->parallelFor(0, numGroups, 1, [&](int from, int to)
+			{
+				for (int i = from; i < to; i++)
+					parallelGroups[i]->update(true);
+			});
+	}
+
+	for (int i = 0; i < numGroups; i++)
+	{
+		u32 n = serialGroups[i]->getNumParticles();
+		TEST_ASSERT_THROW(n > 0);
+		TEST_ASSERT_EQUAL(n, parallelGroups[i]->getNumParticles());
+
+		CParticle* a = serialGroups[i]->getParticlePointer();
+		CParticle* b = parallelGroups[i]->getParticlePointer();
+		for (u32 j = 0; j < n; j++)
+			TEST_ASSERT_THROW(particleEqual(a[j], b[j]));
+	}
+
+	// the groups with the different seed are not the same
+	TEST_ASSERT_THROW(serialGroups[0]->getParticlePointer()[0].Position != serialGroups[1]->getParticlePointer()[0].Position);
+
+	for (int i = 0; i < numGroups; i++)
+	{
+		delete serialGroups[i];
+		delete parallelGroups[i];
+	}
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testParticleSystem();
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestPathFinder.h"
+
+#ifdef BUILD_SKYLICHT_GRAPH
+
+#include "Graph/CPathFinder.h"
+#include "Job/CJobScheduler.h"
+
+#include <chrono>
+
+using namespace Skylicht;
+using namespace Skylicht::Graph;
+
+extern bool g_benchmark;
+
+// a grid map with 8 neighbours links, some tiles are blocked
+class CTestGridMap : public CWalkingTileMap
+{
+public:
+	CTestGridMap(int size, u32 seed)
+	{
+		std::vector<STile*> grid(size * size, NULL);
+
+		for (int y = 0; y < size; y++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				seed = seed * 1103515245 + 12345;
+				if (((seed >> 16) % 100) < 25)
+					continue;
+
+				STile* tile = new STile();
+				tile->Id = m_tiles.size();
+				tile->X = x;
+				tile->Z = y;
+				tile->Position.set((f32)x, 0.0f, (f32)y);
+				m_tiles.push_back(tile);
+
+				grid[y * size + x] = tile;
+			}
+		}
+
+		for (int y = 0; y < size; y++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				STile* tile = grid[y * size + x];
+				if (tile == NULL)
+					continue;
+
+				for (int dy = -1; dy <= 1; dy++)
+				{
+					for (int dx = -1; dx <= 1; dx++)
+					{
+						int nx = x + dx;
+						int ny = y + dy;
+						if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= size || ny >= size)
+							continue;
+
+						STile* nei = grid[ny * size + nx];
+						if (nei)
+							tile->Neighbours.push_back(nei);
+					}
+				}
+			}
+		}
+	}
+};
+
+// A* with a linear open list, same cost as CPathFinder
+static bool findPathReference(CWalkingTileMap* map, STile* from, STile* to)
+{
+	u32 numTile = map->getNumTile();
+	std::vector<float> dist(numTile, -1.0f);
+	std::vector<bool> closed(numTile, false);
+	std::vector<std::pair<float, STile*>> open;
+
+	dist[from->Id] = 0.0f;
+	open.push_back(std::make_pair((to->Position - from->Position).getLengthSQ(), from));
+
+	while (!open.empty())
+	{
+		u32 best = 0;
+		for (u32 i = 1, n = (u32)open.size(); i < n; i++)
+		{
+			if (open[i].first < open[best].first)
+				best = i;
+		}
+
+		STile* tile = open[best].second;
+		open.erase(open.begin() + best);
+
+		if (closed[tile->Id])
+			continue;
+		closed[tile->Id] = true;
+
+		if (tile == to)
+			return true;
+
+		for (u32 i = 0, n = tile->Neighbours.size(); i < n; i++)
+		{
+			STile* nei = tile->Neighbours[i];
+			float d = dist[tile->Id] + (nei->Position - tile->Position).getLengthSQ();
+			if (dist[nei->Id] < 0.0f || dist[nei->Id] > d)
+			{
+				dist[nei->Id] = d;
+				open.push_back(std::make_pair(d + (to->Position - nei->Position).getLengthSQ(), nei));
+			}
+		}
+	}
+	return false;
+}
+
+static bool isValidPath(core::array<STile*>& path, STile* from, STile* to)
+{
+	if (path.size() < 2 || path[0] != from || path.getLast() != to)
+		return false;
+
+	for (u32 i = 1, n = path.size(); i < n; i++)
+	{
+		if (path[i - 1]->Neighbours.linear_search(path[i]) < 0)
+			return false;
+	}
+	return true;
+}
+
+void testPathFinder()
+{
+	TEST_CASE("Path finder");
+
+	CTestGridMap map(64, 7);
+	core::array<STile*>& tiles = map.getTiles();
+	u32 numTile = tiles.size();
+
+	const int numQuery = 1000;
+	std::vector<STile*> from(numQuery);
+	std::vector<STile*> to(numQuery);
+
+	u32 seed = 11;
+	for (int i = 0; i < numQuery; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		from[i] = tiles[(seed >> 8) % numTile];
+		seed = seed * 1103515245 + 12345;
+		to[i] = tiles[(seed >> 8) % numTile];
+	}
+
+	CPathFinder finder;
+	core::array<STile*> path;
+
+	int numFound = 0;
+	for (int i = 0; i < 100; i++)
+	{
+		bool found = finder.findPath(&map, from[i], to[i], path);
+		TEST_ASSERT_EQUAL(found, from[i] != to[i] && findPathReference(&map, from[i], to[i]));
+
+		if (found)
+		{
+			TEST_ASSERT_THROW(isValidPath(path, from[i], to[i]));
+			numFound++;
+		}
+	}
+
+	// the blocked tiles make some unreachable queries
+	TEST_ASSERT_THROW(numFound > 0 && numFound < 100);
+
+	// the tiles visit flag is not used
+	for (u32 i = 0; i < numTile; i++)
+		TEST_ASSERT_THROW(tiles[i]->Visit == false);
+
+	TEST_CASE("Path finder parallel");
+
+	std::vector<u32> serialLength(numQuery, 0);
+	std::vector<u32> parallelLength(numQuery, 0);
+
+	auto t = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < numQuery; i++)
+	{
+		if (finder.findPath(&map, from[i], to[i], path))
+			serialLength[i] = path.size();
+	}
+
+	if (g_benchmark)
+	{
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t).count();
+
+		t = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < 100; i++)
+			findPathReference(&map, from[i], to[i]);
+		double referenceMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - t).count();
+
+		printf("Path finder: %d tiles, %.4f ms/query (linear open list %.4f ms/query)\n", numTile, ms / numQuery, referenceMs / 100);
+	}
+
+	System::CJobScheduler::getInstance()->parallelFor(0, numQuery, 16, [&](int begin, int end)
+		{
+			CPathFinder threadFinder;
+			core::array<STile*> threadPath;
+			for (int i = begin; i < end; i++)
+			{
+				if (threadFinder.findPath(&map, from[i], to[i], threadPath))
+					parallelLength[i] = threadPath.size();
+			}
+		});
+
+	for (int i = 0; i < numQuery; i++)
+		TEST_ASSERT_EQUAL(serialLength[i], parallelLength[i]);
+}
+
+#else
+
+void testPathFinder()
+{
+}
+
+#endif
@@ -0,0 +1,3 @@
+#pragma once
+
+void testPathFinder();
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestProbeTetrahedra.h"
+
+#include "LightProbes/CProbeTetrahedra.h"
+
+using namespace Skylicht;
+
+static bool checkTetrahedra(CTestRandom& random, CProbeTetrahedra& tetrahedra, const core::array<core::vector3df>& positions, int walkStart)
+{
+	float weights[4];
+	int last = walkStart;
+
+	for (int i = 0; i < 200; i++)
+	{
+		// the point inside the probes
+		core::vector3df p(random.frand(0.5f, 3.5f), random.frand(0.5f, 1.5f), random.frand(0.5f, 2.5f));
+
+		int tet = tetrahedra.findTetrahedron(p, last, weights);
+		if (tet < 0)
+			return false;
+
+		const CProbeTetrahedra::STetrahedron& t = tetrahedra.getTetrahedron(tet);
+
+		core::vector3df blend;
+		float sum = 0.0f;
+		for (int k = 0; k < 4; k++)
+		{
+			if (weights[k] < 0.0f)
+				return false;
+
+			blend += positions[t.Vertex[k]] * weights[k];
+			sum += weights[k];
+		}
+
+		if (!core::equals(sum, 1.0f, 0.001f) || !blend.equals(p, 0.01f))
+			return false;
+
+		last = tet;
+	}
+	return true;
+}
+
+void testProbeTetrahedra()
+{
+	TEST_CASE("Probe tetrahedra build");
+
+	CTestRandom random(7001);
+
+	// the grid of probes, all points of a cell are on a sphere
+	core::array<core::vector3df> positions;
+	for (int z = 0; z < 4; z++)
+	{
+		for (int y = 0; y < 3; y++)
+		{
+			for (int x = 0; x < 5; x++)
+				positions.push_back(core::vector3df((f32)x, (f32)y, (f32)z));
+		}
+	}
+
+	for (int i = 0; i < 20; i++)
+		positions.push_back(core::vector3df(random.frand(0.0f, 4.0f), random.frand(0.0f, 2.0f), random.frand(0.0f, 3.0f)));
+
+	CProbeTetrahedra tetrahedra;
+	TEST_ASSERT_THROW(tetrahedra.build(positions.pointer(), (int)positions.size()));
+	TEST_ASSERT_THROW(tetrahedra.isValid());
+	TEST_ASSERT_EQUAL(tetrahedra.getVertexCount(), (int)positions.size());
+
+	int numTet = tetrahedra.getTetrahedronCount();
+	TEST_ASSERT_THROW(numTet > 0);
+
+	// the neighbors share a face
+	for (int i = 0; i < numTet; i++)
+	{
+		const CProbeTetrahedra::STetrahedron& t = tetrahedra.getTetrahedron(i);
+		for (int k = 0; k < 4; k++)
+		{
+			int n = t.Neighbor[k];
+			if (n == -1)
+				continue;
+
+			const CProbeTetrahedra::STetrahedron& other = tetrahedra.getTetrahedron(n);
+
+			int back = 0;
+			for (int j = 0; j < 4; j++)
+			{
+				if (other.Neighbor[j] == i)
+					back++;
+			}
+			TEST_ASSERT_EQUAL(back, 1);
+		}
+	}
+
+	TEST_CASE("Probe tetrahedra lookup");
+	TEST_ASSERT_THROW(checkTetrahedra(random, tetrahedra, positions, -1));
+
+	// a probe gets the full weight at its position
+	float weights[4];
+	int tet = tetrahedra.findTetrahedron(positions[7], -1, weights);
+	const CProbeTetrahedra::STetrahedron& t = tetrahedra.getTetrahedron(tet);
+	float w = 0.0f;
+	for (int k = 0; k < 4; k++)
+	{
+		if (t.Vertex[k] == 7)
+			w = weights[k];
+	}
+	TEST_ASSERT_THROW(core::equals(w, 1.0f, 0.001f));
+
+	// the position outside the probes is clamped on the hull
+	tet = tetrahedra.findTetrahedron(core::vector3df(2.0f, 10.0f, 1.0f), tet, weights);
+	TEST_ASSERT_THROW(tet >= 0);
+	TEST_ASSERT_THROW(weights[0] >= 0.0f && weights[1] >= 0.0f && weights[2] >= 0.0f && weights[3] >= 0.0f);
+	TEST_ASSERT_THROW(core::equals(weights[0] + weights[1] + weights[2] + weights[3], 1.0f, 0.001f));
+
+	TEST_CASE("Probe tetrahedra saved topology");
+	CProbeTetrahedra loaded;
+	loaded.setTetrahedra(tetrahedra.getTetrahedra(), numTet, (int)positions.size());
+	TEST_ASSERT_THROW(!loaded.isValid());
+
+	// scale the probes, the topology is still valid
+	core::array<core::vector3df> moved;
+	for (u32 i = 0; i < positions.size(); i++)
+		moved.push_back(positions[i] * 1.05f);
+
+	TEST_ASSERT_THROW(loaded.updatePositions(moved.pointer(), (int)moved.size()));
+	TEST_ASSERT_THROW(checkTetrahedra(random, loaded, moved, numTet / 2));
+
+	// the count of probes is changed
+	TEST_ASSERT_THROW(!loaded.updatePositions(moved.pointer(), (int)moved.size() - 1));
+
+	TEST_CASE("Probe tetrahedra on a plane");
+	core::array<core::vector3df> plane;
+	for (int i = 0; i < 16; i++)
+		plane.push_back(core::vector3df((f32)(i % 4), 1.0f, (f32)(i / 4)));
+
+	CProbeTetrahedra flat;
+	TEST_ASSERT_THROW(!flat.build(plane.pointer(), (int)plane.size()));
+	TEST_ASSERT_EQUAL(flat.findTetrahedron(core::vector3df(), -1, weights), -1);
+}
@@ -5,6 +5,8 @@
 #include "TestTransform.h"
 
 #include "Scene/CScene.h"
+#include "Primitive/CCube.h"
+#include "Culling/CCullingData.h"
 
 TestScene::TestScene() : m_testStep(0)
 {
@@ -38,6 +40,15 @@ TestScene::TestScene() : m_testStep(0)
 	obj->setName("Camera");
 	m_camera = obj->addComponent<CCamera>();
 	TEST_ASSERT_THROW(m_camera != NULL);
+	m_camera->lookAt(core::vector3df(0.0f, 0.0f, 0.0f), core::vector3df(0.0f, 0.0f, 1.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	TEST_CASE("Create cubes");
+	obj = m_zone->createEmptyObject();
+	obj->setName("Cubes");
+	CCube* cubes = obj->addComponent<CCube>();
+	m_frontCube = cubes->addPrimitive(core::vector3df(0.0f, 0.0f, 10.0f), core::vector3df(), core::vector3df(1.0f, 1.0f, 1.0f));
+	m_backCube = cubes->addPrimitive(core::vector3df(0.0f, 0.0f, -10.0f), core::vector3df(), core::vector3df(1.0f, 1.0f, 1.0f));
+	TEST_ASSERT_THROW(m_frontCube != NULL && m_backCube != NULL);
 
 	TEST_CASE("Create container");
 	CContainerObject *container = m_zone->createContainerObject();
@@ -117,6 +128,25 @@ void TestScene::render()
 {
 	m_forwardRP->render(NULL, m_camera, m_zone->getEntityManager(), core::recti());
 	m_deferredRP->render(NULL, m_camera, m_zone->getEntityManager(), core::recti());
+
+	CCullingData* front = GET_ENTITY_DATA(m_frontCube, CCullingData);
+	CCullingData* back = GET_ENTITY_DATA(m_backCube, CCullingData);
+
+	if (m_testStep == 1)
+	{
+		TEST_CASE("Culling visible");
+		TEST_ASSERT_THROW(front->Visible && !front->CameraCulled);
+		TEST_ASSERT_THROW(!back->Visible && back->CameraCulled);
+
+		// turn back on the next frame
+		m_camera->lookAt(core::vector3df(0.0f, 0.0f, -1.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+	}
+	else if (m_testStep == 2)
+	{
+		TEST_CASE("Culling camera turn");
+		TEST_ASSERT_THROW(!front->Visible && front->CameraCulled);
+		TEST_ASSERT_THROW(back->Visible && !back->CameraCulled);
+	}
 }
 
 TestScene* g_testScene = NULL;
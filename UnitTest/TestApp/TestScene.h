@@ -12,6 +12,9 @@ protected:
 	CZone			*m_zone;
 	CCamera			*m_camera;
 
+	CEntity			*m_frontCube;
+	CEntity			*m_backCube;
+
 	CForwardRP		*m_forwardRP;
 	CDeferredRP		*m_deferredRP;
 
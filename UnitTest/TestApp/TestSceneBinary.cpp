@@ -0,0 +1,165 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestSceneBinary.h"
+
+#include "Scene/CScene.h"
+#include "Scene/CSceneImporter.h"
+#include "Scene/CSceneExporter.h"
+#include "Serializable/CSerializableBinary.h"
+
+#include <chrono>
+
+using namespace Skylicht;
+
+extern bool g_benchmark;
+
+static double getTimeMs(std::chrono::high_resolution_clock::time_point begin)
+{
+	std::chrono::duration<double, std::milli> t = std::chrono::high_resolution_clock::now() - begin;
+	return t.count();
+}
+
+static CScene* createTestScene(int numObjects)
+{
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+	zone->setName("Zone");
+
+	CContainerObject* container = NULL;
+
+	char name[64];
+	for (int i = 0; i < numObjects; i++)
+	{
+		// a container for every 10 objects
+		if (i % 10 == 0)
+		{
+			container = zone->createContainerObject();
+			sprintf(name, "Container%d", i / 10);
+			container->setName(name);
+		}
+
+		CGameObject* obj = container->createEmptyObject();
+		sprintf(name, "Object%d", i);
+		obj->setName(name);
+		obj->setVisible(i % 3 != 0);
+		obj->getTransformEuler()->setPosition(core::vector3df(i * 0.25f, (f32)(i % 7), -i * 0.5f));
+	}
+
+	scene->updateAddRemoveObject();
+	scene->updateIndexSearchObject();
+	return scene;
+}
+
+static CScene* importTestScene(const char* path, double& time)
+{
+	CScene* scene = new CScene();
+
+	std::chrono::high_resolution_clock::time_point begin = std::chrono::high_resolution_clock::now();
+	TEST_ASSERT_THROW(CSceneImporter::beginImportScene(scene, path));
+	while (!CSceneImporter::updateLoadScene());
+	time = getTimeMs(begin);
+
+	scene->updateAddRemoveObject();
+	return scene;
+}
+
+static void checkImportScene(CScene* source, bool exactPosition)
+{
+	std::list<CGameObject*>& objects = CSceneImporter::getObjects();
+	for (CGameObject* obj : objects)
+	{
+		CGameObject* src = source->searchObjectInChildByID(obj->getID().c_str());
+		if (src == NULL)
+		{
+			// the zone
+			TEST_ASSERT_THROW(dynamic_cast<CZone*>(obj) != NULL);
+			continue;
+		}
+
+		TEST_ASSERT_STRING_EQUAL(obj->getNameA(), src->getNameA());
+		TEST_ASSERT_THROW(obj->isVisible() == src->isVisible());
+
+		const core::vector3df& a = obj->getTransformEuler()->getPosition();
+		const core::vector3df& b = src->getTransformEuler()->getPosition();
+		bool samePosition = exactPosition ? a == b : a.equals(b, 0.001f);
+		TEST_ASSERT_THROW(samePosition);
+	}
+}
+
+void testSceneBinary()
+{
+	TEST_CASE("Binary serializable");
+	{
+		CObjectSerializable data("Root");
+		data.autoRelease(new CStringProperty(&data, "name", "binary"));
+		data.autoRelease(new CIntProperty(&data, "count", -3));
+		data.autoRelease(new CVector3Property(&data, "position", core::vector3df(1.0f, 2.0f, 3.0f)));
+
+		CObjectSerializable* child = new CObjectSerializable("Child");
+		data.addProperty(child);
+		data.autoRelease(child);
+		child->autoRelease(new CBoolProperty(child, "enable", true));
+
+		std::vector<u8> buffer;
+		CSerializableBinary::save(&data, buffer);
+
+		CSerializableBinary binary;
+		TEST_ASSERT_THROW(binary.load(buffer.data(), (u32)buffer.size()));
+		TEST_ASSERT_EQUAL(binary.getNumNode(), 2);
+		TEST_ASSERT_THROW(binary.findChild(0, "Child") == 1);
+
+		CObjectSerializable result("Root");
+		binary.loadObject(0, &result);
+		TEST_ASSERT_THROW(result.get("name", std::string("")) == "binary");
+		TEST_ASSERT_THROW(result.get("count", 0) == -3);
+		TEST_ASSERT_THROW(result.get("position", core::vector3df()) == core::vector3df(1.0f, 2.0f, 3.0f));
+
+		CObjectSerializable* resultChild = result.getProperty<CObjectSerializable>("Child");
+		TEST_ASSERT_THROW(resultChild != NULL);
+		TEST_ASSERT_THROW(resultChild->get("enable", false) == true);
+
+		// the broken data is rejected
+		buffer.resize(buffer.size() / 2);
+		TEST_ASSERT_THROW(!binary.load(buffer.data(), (u32)buffer.size()));
+	}
+
+	TEST_CASE("Binary scene import");
+	const int numObjects = 2000;
+	CScene* source = createTestScene(numObjects);
+
+	const char* xmlPath = "TestSceneBinary.scene";
+	const char* binaryPath = "TestSceneBinary.sbin";
+
+	CSceneExporter::exportScene(source, xmlPath);
+	TEST_ASSERT_THROW(CSceneExporter::exportSceneBinary(source, binaryPath));
+	TEST_ASSERT_THROW(!CSerializableBinary::isBinaryFile(xmlPath));
+	TEST_ASSERT_THROW(CSerializableBinary::isBinaryFile(binaryPath));
+
+	CSceneImporter::setLoadSceneStep(100);
+
+	double xmlTime = 0.0, binaryTime = 0.0;
+
+	CScene* xmlScene = importTestScene(xmlPath, xmlTime);
+	int numXmlObjects = CSceneImporter::getTotalObjects();
+	checkImportScene(source, false);
+
+	CScene* binaryScene = importTestScene(binaryPath, binaryTime);
+	TEST_ASSERT_EQUAL(CSceneImporter::getTotalObjects(), numXmlObjects);
+	checkImportScene(source, true);
+
+	// zone + containers + objects
+	TEST_ASSERT_EQUAL(numXmlObjects, 1 + numObjects / 10 + numObjects);
+
+	if (g_benchmark)
+		printf("   load %d objects: xml %.2f ms, binary %.2f ms\n", numXmlObjects, xmlTime, binaryTime);
+
+	CSceneImporter::setLoadSceneStep(10);
+
+	delete xmlScene;
+	delete binaryScene;
+	delete source;
+
+	remove(xmlPath);
+	remove(binaryPath);
+	remove("TestSceneBinary.txt");
+}
@@ -0,0 +1,211 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestShadowCasterCulling.h"
+
+#include "Shadow/CShadowCasterCulling.h"
+#include "Shadow/CCascadedShadowMaps.h"
+#include "Scene/CScene.h"
+
+using namespace Skylicht;
+
+#define TEST_CASTER 1001
+#define TEST_CASCADE 3
+
+// the box is outside if all corners are in front of a plane
+static bool boxInFrustum(const SViewFrustum& frustum, const core::aabbox3df& box)
+{
+	core::vector3df edges[8];
+	box.getEdges(edges);
+
+	for (s32 i = 0; i < SViewFrustum::VF_PLANE_COUNT; i++)
+	{
+		bool outside = true;
+		for (u32 j = 0; j < 8; j++)
+		{
+			if (frustum.planes[i].classifyPointRelation(edges[j]) != core::ISREL3D_FRONT)
+			{
+				outside = false;
+				break;
+			}
+		}
+
+		if (outside)
+			return false;
+	}
+	return true;
+}
+
+void testShadowCasterCulling()
+{
+	TEST_CASE("Shadow caster culling masks");
+
+	core::vector3df lightDir(-1.0f, -2.0f, -0.5f);
+	lightDir.normalize();
+
+	core::matrix4 viewProj[TEST_CASCADE];
+	SViewFrustum frustum[TEST_CASCADE];
+
+	for (int i = 0; i < TEST_CASCADE; i++)
+	{
+		float radius = 10.0f * (i + 1);
+		core::vector3df center(0.0f, 0.0f, radius);
+
+		core::matrix4 ortho;
+		ortho.buildProjectionMatrixOrthoLH(radius * 2.0f, radius * 2.0f, -50.0f, 50.0f + radius * 2.0f);
+
+		core::matrix4 view;
+		view.buildCameraLookAtMatrixLH(center - lightDir * 50.0f, center, core::vector3df(0.0f, 1.0f, 0.0f));
+
+		viewProj[i] = ortho * view;
+		frustum[i].setFrom(viewProj[i]);
+	}
+
+	CShadowCasterCulling culling;
+	culling.setCascades(TEST_CASCADE, viewProj);
+	culling.beginCasters();
+
+	CTestRandom random(4049);
+
+	core::array<core::aabbox3df> boxes;
+	for (int i = 0; i < TEST_CASTER; i++)
+	{
+		core::vector3df c(random.frand(-80.0f, 80.0f), random.frand(-40.0f, 40.0f), random.frand(-40.0f, 120.0f));
+		core::vector3df e(random.frand(0.1f, 4.0f), random.frand(0.1f, 4.0f), random.frand(0.1f, 4.0f));
+		core::aabbox3df box(c - e, c + e);
+		boxes.push_back(box);
+
+		TEST_ASSERT_EQUAL(culling.addCaster(box, (u32)i, i == 500), (u32)i);
+	}
+
+	culling.classify();
+	TEST_ASSERT_EQUAL(culling.getCasterCount(), (u32)TEST_CASTER);
+
+	u32 numInside[TEST_CASCADE] = { 0 };
+	bool dynamic[TEST_CASCADE] = { false };
+
+	for (int i = 0; i < TEST_CASTER; i++)
+	{
+		u32 mask = 0;
+		for (int c = 0; c < TEST_CASCADE; c++)
+		{
+			if (boxInFrustum(frustum[c], boxes[i]))
+			{
+				mask |= 1 << c;
+				numInside[c]++;
+				if (i == 500)
+					dynamic[c] = true;
+			}
+		}
+
+		TEST_ASSERT_EQUAL(culling.getMask((u32)i), mask);
+	}
+
+	TEST_CASE("Shadow caster culling cascade lists");
+	for (int c = 0; c < TEST_CASCADE; c++)
+	{
+		const core::array<u32>& casters = culling.getCascadeCasters(c);
+		TEST_ASSERT_EQUAL(casters.size(), numInside[c]);
+		TEST_ASSERT_THROW(numInside[c] > 0 && numInside[c] < TEST_CASTER);
+		TEST_ASSERT_EQUAL(culling.isCascadeDynamic(c), dynamic[c]);
+
+		for (u32 i = 0; i < casters.size(); i++)
+			TEST_ASSERT_THROW(culling.getMask(casters[i]) & (1 << c));
+	}
+
+	TEST_CASE("Shadow caster culling hash");
+	u32 hash = culling.getCascadeHash(0);
+
+	// the same static casters give the same hash
+	culling.beginCasters();
+	for (int i = 0; i < TEST_CASTER; i++)
+		culling.addCaster(boxes[i], (u32)i, i == 500);
+	culling.classify();
+	TEST_ASSERT_EQUAL(culling.getCascadeHash(0), hash);
+
+	// a caster of the first cascade moves, it leaves the static set
+	u32 moved = culling.getCascadeCasters(0)[0];
+	culling.beginCasters();
+	for (int i = 0; i < TEST_CASTER; i++)
+		culling.addCaster(boxes[i], (u32)i, (u32)i == moved);
+	culling.classify();
+	TEST_ASSERT_THROW(culling.getCascadeHash(0) != hash);
+	TEST_ASSERT_THROW(culling.isCascadeDynamic(0));
+
+	// remove a caster of the first cascade
+	culling.beginCasters();
+	for (int i = 0; i < TEST_CASTER; i++)
+	{
+		if ((u32)i != moved)
+			culling.addCaster(boxes[i], (u32)i, false);
+	}
+	culling.classify();
+	TEST_ASSERT_THROW(culling.getCascadeHash(0) != hash);
+	TEST_ASSERT_THROW(!culling.isCascadeDynamic(0));
+}
+
+static bool sameCascades(CCascadedShadowMaps& csm, const core::matrix4* viewProj)
+{
+	for (int i = 0; i < csm.getSplitCount(); i++)
+	{
+		if (csm.getProjectionMatrices(i) * csm.getViewMatrices(i) != viewProj[i])
+			return false;
+	}
+	return true;
+}
+
+void testShadowCascadeAnchor()
+{
+	TEST_CASE("Shadow cascade world anchor");
+
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	CGameObject* cameraObj = zone->createEmptyObject();
+	CCamera* camera = cameraObj->addComponent<CCamera>();
+	cameraObj->getTransformEuler()->setPosition(core::vector3df(1.0f, 2.0f, 3.0f));
+
+	scene->updateAddRemoveObject();
+	scene->update();
+
+	core::vector3df lightDir(-1.0f, -2.0f, -0.5f);
+
+	CCascadedShadowMaps csm;
+	csm.init(TEST_CASCADE, 2048, 300.0f, 1280, 720);
+	csm.setWorldAnchor(true);
+	csm.update(camera, lightDir);
+
+	core::matrix4 viewProj[TEST_CASCADE];
+	for (int i = 0; i < TEST_CASCADE; i++)
+		viewProj[i] = csm.getProjectionMatrices(i) * csm.getViewMatrices(i);
+
+	// the camera moves a little, the anchored cascades keep their matrices
+	cameraObj->getTransformEuler()->setPosition(core::vector3df(1.01f, 2.0f, 3.01f));
+	scene->update();
+
+	csm.update(camera, lightDir);
+	TEST_ASSERT_THROW(sameCascades(csm, viewProj));
+
+	// the cascades follow the camera that moves far
+	cameraObj->getTransformEuler()->setPosition(core::vector3df(200.0f, 2.0f, 3.0f));
+	scene->update();
+
+	csm.update(camera, lightDir);
+	TEST_ASSERT_THROW(!sameCascades(csm, viewProj));
+
+	// without anchor the matrices change on every move
+	cameraObj->getTransformEuler()->setPosition(core::vector3df(1.0f, 2.0f, 3.0f));
+	scene->update();
+
+	csm.setWorldAnchor(false);
+	csm.update(camera, lightDir);
+	for (int i = 0; i < TEST_CASCADE; i++)
+		viewProj[i] = csm.getProjectionMatrices(i) * csm.getViewMatrices(i);
+
+	cameraObj->getTransformEuler()->setPosition(core::vector3df(1.01f, 2.0f, 3.01f));
+	scene->update();
+
+	csm.update(camera, lightDir);
+	TEST_ASSERT_THROW(!sameCascades(csm, viewProj));
+
+	delete scene;
+}
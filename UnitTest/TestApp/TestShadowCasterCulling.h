@@ -0,0 +1,5 @@
+#pragma once
+
+void testShadowCasterCulling();
+
+void testShadowCascadeAnchor();
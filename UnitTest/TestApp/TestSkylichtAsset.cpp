@@ -0,0 +1,455 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestSkylichtAsset.h"
+
+#include "Entity/CEntity.h"
+#include "Entity/CEntityPrefab.h"
+#include "RenderMesh/CRenderMeshData.h"
+#include "Animation/CAnimationClip.h"
+#include "Exporter/Skylicht/CSkylichtMeshExporter.h"
+#include "Exporter/Skylicht/CSkylichtAnimExporter.h"
+#include "Importer/Skylicht/CSkylichtMeshLoader.h"
+#include "Importer/Skylicht/CSkylichtAnimLoader.h"
+#include "Utils/CMappedFile.h"
+#include "Animation/CCompressedAnimationTrack.h"
+
+using namespace Skylicht;
+
+static void testMeshAsset()
+{
+	TEST_CASE("Skylicht mesh mapped load");
+
+	const char* path = "TestSkylichtAsset.smesh";
+
+	IVideoDriver* driver = getVideoDriver();
+
+	// odd counts, that the vertex and index blocks need the padding
+	CMeshBuffer<S3DVertex>* mb = new CMeshBuffer<S3DVertex>(driver->getVertexDescriptor(EVT_STANDARD), video::EIT_16BIT);
+	IVertexBuffer* vb = mb->getVertexBuffer();
+	IIndexBuffer* ib = mb->getIndexBuffer();
+
+	for (int i = 0; i < 37; i++)
+	{
+		S3DVertex v(core::vector3df((f32)i, (f32)(i * 2), 1.0f), core::vector3df(0.0f, 1.0f, 0.0f), SColor(255, i, 0, 0), core::vector2df(0.1f * i, 0.0f));
+		vb->addVertex(&v);
+	}
+
+	for (int i = 0; i < 35; i++)
+		ib->addIndex(i);
+	mb->recalculateBoundingBox();
+
+	CMesh* mesh = new CMesh();
+	mesh->addMeshBuffer(mb, "TestMaterial");
+	mb->drop();
+
+	CEntityPrefab prefab;
+	CEntity* entity = prefab.createEntity();
+	CRenderMeshData* renderMesh = entity->addData<CRenderMeshData>();
+	renderMesh->setMesh(mesh);
+	mesh->drop();
+
+	CSkylichtMeshExporter exporter;
+	exporter.exportModel(prefab.getEntities(), prefab.getNumEntities(), path);
+
+	CEntityPrefab loadPrefab;
+	CSkylichtMeshLoader loader;
+	TEST_ASSERT_THROW(loader.loadModel(path, &loadPrefab, false, false, false, false));
+	TEST_ASSERT_THROW(loadPrefab.getNumEntities() == 1);
+
+	CRenderMeshData* loadMesh = loadPrefab.getEntity(0)->getData<CRenderMeshData>();
+	TEST_ASSERT_THROW(loadMesh != NULL);
+	TEST_ASSERT_THROW(loadMesh->getMesh()->getMeshBufferCount() == 1);
+
+	IMeshBuffer* loadMB = loadMesh->getMesh()->getMeshBuffer(0);
+	TEST_ASSERT_THROW(loadMB->getVertexBuffer()->getVertexCount() == 37);
+	TEST_ASSERT_THROW(loadMB->getIndexBuffer()->getIndexCount() == 35);
+	TEST_ASSERT_THROW(memcmp(loadMB->getVertexBuffer()->getVertices(), vb->getVertices(), 37 * sizeof(S3DVertex)) == 0);
+	TEST_ASSERT_THROW(memcmp(loadMB->getIndexBuffer()->getIndices(), ib->getIndices(), 35 * sizeof(u16)) == 0);
+
+	// the vertex block is aligned in the file
+	CMappedFile file;
+	TEST_ASSERT_THROW(file.open(path));
+	TEST_ASSERT_THROW(file.isMapped());
+
+	const u8* data = file.getData();
+	const u8* found = NULL;
+	for (u32 i = 0; i + sizeof(S3DVertex) <= file.getSize(); i++)
+	{
+		if (memcmp(data + i, vb->getVertices(), sizeof(S3DVertex)) == 0)
+		{
+			found = data + i;
+			break;
+		}
+	}
+	TEST_ASSERT_THROW(found != NULL);
+	TEST_ASSERT_THROW((found - data) % 16 == 0);
+
+	file.close();
+	remove(path);
+}
+
+static void testAnimAsset()
+{
+	TEST_CASE("Skylicht animation mapped load");
+
+	const char* path = "TestSkylichtAsset.sanim";
+
+	CAnimationClip clip;
+	clip.AnimName = "TestAnim";
+	clip.Duration = 2.0f;
+	clip.Loop = true;
+
+	for (int i = 0; i < 3; i++)
+	{
+		SEntityAnim* anim = new SEntityAnim();
+		anim->Name = std::string("Bone") + std::to_string(i);
+
+		for (int j = 0; j < 7 + i; j++)
+		{
+			CPositionKey pos;
+			pos.Frame = j * 0.1f;
+			pos.Value.set((f32)i, (f32)j, 3.0f);
+			anim->Data.Positions.Data.push_back(pos);
+
+			CRotationKey rot;
+			rot.Frame = j * 0.1f;
+			rot.Value.fromAngleAxis(j * 0.2f, core::vector3df(0.0f, 1.0f, 0.0f));
+			anim->Data.Rotations.Data.push_back(rot);
+		}
+
+		// the scale track does not have key
+		anim->Data.Scales.Default.set(1.0f, 2.0f, 3.0f);
+		clip.addAnim(anim);
+	}
+
+	CSkylichtAnimExporter exporter;
+	TEST_ASSERT_THROW(exporter.exportAnim(&clip, path));
+
+	CAnimationClip loadClip;
+	CSkylichtAnimLoader loader;
+	TEST_ASSERT_THROW(loader.loadAnimation(path, &loadClip));
+	TEST_ASSERT_STRING_EQUAL(loadClip.AnimName.c_str(), "TestAnim");
+	TEST_ASSERT_THROW(loadClip.Loop);
+	TEST_ASSERT_THROW(loadClip.getNodeAnimCount() == 3);
+
+	for (int i = 0; i < 3; i++)
+	{
+		SEntityAnim* a = clip.getAnimOfEntity(i);
+		SEntityAnim* b = loadClip.getAnimOfEntity(i);
+		TEST_ASSERT_THROW(a->Name == b->Name);
+		TEST_ASSERT_THROW(b->Data.Positions.size() == a->Data.Positions.size());
+		TEST_ASSERT_THROW(b->Data.Rotations.size() == a->Data.Rotations.size());
+		TEST_ASSERT_THROW(b->Data.Scales.size() == 0);
+		TEST_ASSERT_THROW(b->Data.Scales.Default == a->Data.Scales.Default);
+		TEST_ASSERT_THROW(memcmp(a->Data.Positions.pointer(), b->Data.Positions.pointer(), a->Data.Positions.size() * sizeof(CPositionKey)) == 0);
+		TEST_ASSERT_THROW(memcmp(a->Data.Rotations.pointer(), b->Data.Rotations.pointer(), a->Data.Rotations.size() * sizeof(CRotationKey)) == 0);
+	}
+
+	remove(path);
+}
+
+static SEntityAnim* createCompressAnim(const char* name, bool linear)
+{
+	SEntityAnim* anim = new SEntityAnim();
+	anim->Name = name;
+
+	// 3 seconds at 60 keys per second
+	for (int i = 0; i <= 180; i++)
+	{
+		f32 time = i / 60.0f;
+
+		CPositionKey pos;
+		pos.Frame = time;
+		if (linear)
+			pos.Value.set(time * 2.0f, 1.0f, -time);
+		else
+			pos.Value.set(sinf(time * 3.0f), cosf(time * 2.0f) * 0.5f, time);
+		anim->Data.Positions.Data.push_back(pos);
+
+		CRotationKey rot;
+		rot.Frame = time;
+		rot.Value.fromAngleAxis(time * 1.5f, core::vector3df(0.3f, 1.0f, 0.2f).normalize());
+		anim->Data.Rotations.Data.push_back(rot);
+
+		CScaleKey scale;
+		scale.Frame = time;
+		scale.Value.set(1.0f, 1.0f, 1.0f);
+		anim->Data.Scales.Data.push_back(scale);
+	}
+	return anim;
+}
+
+static f32 getRotationError(const core::quaternion& a, const core::quaternion& b)
+{
+	f32 d = fabsf(a.dotProduct(b));
+	return 1.0f - core::min_(d, 1.0f);
+}
+
+static void testAnimCompress()
+{
+	TEST_CASE("Skylicht animation compress");
+
+	const char* path = "TestSkylichtAssetCompress.sanim";
+
+	CAnimationClip source;
+	source.AnimName = "Compress";
+	source.Duration = 3.0f;
+	source.addAnim(createCompressAnim("Bone0", false));
+	source.addAnim(createCompressAnim("Bone1", true));
+
+	CAnimationClip clip;
+	clip.AnimName = "Compress";
+	clip.Duration = 3.0f;
+	clip.addAnim(createCompressAnim("Bone0", false));
+	clip.addAnim(createCompressAnim("Bone1", true));
+
+	SAnimationCompressSetting setting;
+	clip.compress(setting, true);
+
+	// the keys are released
+	TEST_ASSERT_THROW(clip.getAnimOfEntity(0)->Data.Positions.size() == 0);
+	TEST_ASSERT_FLOAT_EQUAL(clip.getAnimOfEntity(0)->Data.getLastFrame(), 3.0f);
+
+	CCompressedAnimationTrack* track0 = clip.getAnimOfEntity(0)->Data.Compressed;
+	CCompressedAnimationTrack* track1 = clip.getAnimOfEntity(1)->Data.Compressed;
+	TEST_ASSERT_THROW(track0 != NULL && track1 != NULL);
+	TEST_ASSERT_THROW(track0->getScaleChannel().Mode == CCompressedAnimationTrack::Constant);
+	TEST_ASSERT_THROW(track0->getPositionChannel().Mode == CCompressedAnimationTrack::Quantized);
+	TEST_ASSERT_THROW(track0->getRotationChannel().Mode == CCompressedAnimationTrack::Quantized);
+	TEST_ASSERT_THROW(track1->getPositionChannel().NumSample == 2);
+
+	// 181 keys * 3 channels
+	u32 sourceSize = 181 * (sizeof(CPositionKey) * 2 + sizeof(CRotationKey));
+	TEST_ASSERT_THROW(track0->getMemorySize() * 2 < sourceSize);
+
+	// the error is bounded on the random seek
+	CAnimationTrack a, b;
+	f32 maxPosError = 0.0f;
+	f32 maxRotError = 0.0f;
+
+	for (int bone = 0; bone < 2; bone++)
+	{
+		a.setAnimationData(&source.getAnimOfEntity(bone)->Data);
+		b.setAnimationData(&clip.getAnimOfEntity(bone)->Data);
+
+		for (int i = 0; i < 500; i++)
+		{
+			f32 time = ((i * 7919) % 3100) / 1000.0f;
+
+			core::vector3df pa, pb, sa, sb;
+			core::quaternion ra, rb;
+			a.getFrameData(time, pa, sa, ra);
+			b.getFrameData(time, pb, sb, rb);
+
+			maxPosError = core::max_(maxPosError, pa.getDistanceFrom(pb), sa.getDistanceFrom(sb));
+			maxRotError = core::max_(maxRotError, getRotationError(ra, rb));
+		}
+	}
+
+	TEST_ASSERT_THROW(maxPosError < 0.005f);
+	TEST_ASSERT_THROW(maxRotError < 0.0001f);
+
+	TEST_CASE("Skylicht animation compress export");
+	CSkylichtAnimExporter exporter;
+	exporter.setCompression(true, setting);
+	TEST_ASSERT_THROW(exporter.exportAnim(&source, path));
+
+	CAnimationClip loadClip;
+	CSkylichtAnimLoader loader;
+	TEST_ASSERT_THROW(loader.loadAnimation(path, &loadClip));
+	TEST_ASSERT_THROW(loadClip.getNodeAnimCount() == 2);
+
+	for (int bone = 0; bone < 2; bone++)
+	{
+		TEST_ASSERT_THROW(loadClip.getAnimOfEntity(bone)->Data.Compressed != NULL);
+
+		a.setAnimationData(&clip.getAnimOfEntity(bone)->Data);
+		b.setAnimationData(&loadClip.getAnimOfEntity(bone)->Data);
+
+		for (int i = 0; i < 50; i++)
+		{
+			f32 time = i * 0.0613f;
+
+			core::vector3df pa, pb, sa, sb;
+			core::quaternion ra, rb;
+			a.getFrameData(time, pa, sa, ra);
+			b.getFrameData(time, pb, sb, rb);
+
+			TEST_ASSERT_THROW(pa == pb);
+			TEST_ASSERT_THROW(ra == rb);
+		}
+	}
+
+	TEST_CASE("Skylicht animation export released keys");
+	CSkylichtAnimExporter keyExporter;
+	TEST_ASSERT_THROW(keyExporter.exportAnim(&clip, path));
+
+	CAnimationClip releasedClip;
+	TEST_ASSERT_THROW(loader.loadAnimation(path, &releasedClip));
+	TEST_ASSERT_THROW(releasedClip.getNodeAnimCount() == 2);
+
+	for (int bone = 0; bone < 2; bone++)
+	{
+		TEST_ASSERT_THROW(releasedClip.getAnimOfEntity(bone)->Data.Compressed != NULL);
+
+		a.setAnimationData(&clip.getAnimOfEntity(bone)->Data);
+		b.setAnimationData(&releasedClip.getAnimOfEntity(bone)->Data);
+
+		core::vector3df pa, pb, sa, sb;
+		core::quaternion ra, rb;
+		a.getFrameData(1.234f, pa, sa, ra);
+		b.getFrameData(1.234f, pb, sb, rb);
+
+		TEST_ASSERT_THROW(pa == pb);
+		TEST_ASSERT_THROW(ra == rb);
+	}
+
+	remove(path);
+
+	TEST_CASE("Skylicht animation compress keep keys");
+	{
+		// a step between 2 keys that the uniform samples can not reach
+		SEntityAnim* step = new SEntityAnim();
+		step->Name = "Step";
+
+		const f32 frames[] = { 0.0f, 1.0037f, 1.0038f, 3.0f };
+		for (int i = 0; i < 4; i++)
+		{
+			CPositionKey pos;
+			pos.Frame = frames[i];
+			pos.Value.set(i < 2 ? 0.0f : 1.0f, 0.0f, 0.0f);
+			step->Data.Positions.Data.push_back(pos);
+
+			CRotationKey rot;
+			rot.Frame = frames[i];
+			rot.Value.fromAngleAxis(i < 2 ? 0.0f : 2.0f, core::vector3df(0.0f, 1.0f, 0.0f));
+			step->Data.Rotations.Data.push_back(rot);
+		}
+
+		CAnimationData stepData = step->Data;
+		step->Data.compress(setting, true);
+
+		CCompressedAnimationTrack* track = step->Data.Compressed;
+		TEST_ASSERT_THROW(track->getPositionChannel().Mode == CCompressedAnimationTrack::Key);
+		TEST_ASSERT_THROW(track->getRotationChannel().Mode == CCompressedAnimationTrack::Key);
+		TEST_ASSERT_THROW(track->getPositionChannel().NumSample == 4);
+
+		a.setAnimationData(&stepData);
+		b.setAnimationData(&step->Data);
+
+		f32 maxStepPosError = 0.0f;
+		f32 maxStepRotError = 0.0f;
+
+		for (int i = 0; i <= 1000; i++)
+		{
+			f32 time = i < 100 ? 1.0036f + i * 0.000003f : (i - 100) * 0.0033f;
+
+			core::vector3df pa, pb, sa, sb;
+			core::quaternion ra, rb;
+			a.getFrameData(time, pa, sa, ra);
+			b.getFrameData(time, pb, sb, rb);
+
+			maxStepPosError = core::max_(maxStepPosError, pa.getDistanceFrom(pb));
+			maxStepRotError = core::max_(maxStepRotError, getRotationError(ra, rb));
+		}
+
+		TEST_ASSERT_THROW(maxStepPosError < 0.0001f);
+		TEST_ASSERT_THROW(maxStepRotError < 0.0001f);
+
+		delete step;
+	}
+}
+
+// an archive that has one file in memory
+class CTestMemoryArchive : public io::IFileArchive
+{
+protected:
+	io::IFileList* m_fileList;
+	io::path m_name;
+	std::string m_content;
+
+public:
+	CTestMemoryArchive(io::IFileSystem* fs, const char* name, const char* content) :
+		m_name(name),
+		m_content(content)
+	{
+		m_fileList = fs->createEmptyFileList("", true, true);
+		m_fileList->addItem(name, 0, (u32)m_content.size(), false, 0);
+		m_fileList->sort();
+	}
+
+	virtual ~CTestMemoryArchive()
+	{
+		m_fileList->drop();
+	}
+
+	virtual io::IReadFile* createAndOpenFile(const io::path& filename)
+	{
+		s32 index = m_fileList->findFile(filename);
+		if (index < 0)
+			return NULL;
+		return createAndOpenFile((u32)index);
+	}
+
+	virtual io::IReadFile* createAndOpenFile(u32 index)
+	{
+		u32 size = (u32)m_content.size();
+		u8* data = new u8[size];
+		memcpy(data, m_content.c_str(), size);
+		return getIrrlichtDevice()->getFileSystem()->createMemoryReadFile(data, size, m_name, true);
+	}
+
+	virtual const io::IFileList* getFileList() const
+	{
+		return m_fileList;
+	}
+
+	virtual const io::path& getArchiveName() const
+	{
+		return m_name;
+	}
+};
+
+static void testMappedFileArchive()
+{
+	TEST_CASE("Mapped file archive lookup");
+
+	const char* path = "TestMappedFile.bin";
+	const char* diskContent = "file on disk";
+	const char* archiveContent = "file in archive";
+
+	io::IFileSystem* fs = getIrrlichtDevice()->getFileSystem();
+	io::IWriteFile* writeFile = fs->createAndWriteFile(path);
+	TEST_ASSERT_THROW(writeFile != NULL);
+	writeFile->write(diskContent, (u32)strlen(diskContent));
+	writeFile->drop();
+
+	// the archive has the same file name, it overrides the file on disk
+	CTestMemoryArchive* archive = new CTestMemoryArchive(fs, path, archiveContent);
+	fs->addFileArchive(archive);
+
+	CMappedFile file;
+	TEST_ASSERT_THROW(file.open(path));
+	TEST_ASSERT_THROW(file.isMapped() == false);
+	TEST_ASSERT_THROW(file.getSize() == strlen(archiveContent));
+	TEST_ASSERT_THROW(memcmp(file.getData(), archiveContent, file.getSize()) == 0);
+
+	fs->removeFileArchive(archive);
+
+	// only the file on disk
+	TEST_ASSERT_THROW(file.open(path));
+	TEST_ASSERT_THROW(file.isMapped());
+	TEST_ASSERT_THROW(file.getSize() == strlen(diskContent));
+	TEST_ASSERT_THROW(memcmp(file.getData(), diskContent, file.getSize()) == 0);
+
+	file.close();
+	remove(path);
+}
+
+void testSkylichtAsset()
+{
+	testMeshAsset();
+	testAnimAsset();
+	testAnimCompress();
+	testMappedFileArchive();
+}
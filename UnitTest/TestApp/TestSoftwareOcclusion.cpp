@@ -0,0 +1,111 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestSoftwareOcclusion.h"
+
+#include "OcclusionQuery/CSoftwareOcclusion.h"
+
+using namespace Skylicht;
+
+void testSoftwareOcclusion()
+{
+	CSoftwareOcclusion* occlusion = new CSoftwareOcclusion(200, 100);
+
+	TEST_CASE("Software occlusion resolution");
+	// rounded to the tile size
+	TEST_ASSERT_EQUAL(occlusion->getWidth() % CSoftwareOcclusion::TileWidth, 0);
+	TEST_ASSERT_EQUAL(occlusion->getHeight() % CSoftwareOcclusion::TileHeight, 0);
+
+	core::matrix4 proj, view;
+	proj.buildProjectionMatrixPerspectiveFovLH(core::PI / 3.0f, 2.0f, 0.1f, 100.0f);
+	view.buildCameraLookAtMatrixLH(core::vector3df(0.0f, 0.0f, -10.0f), core::vector3df(0.0f, 0.0f, 0.0f), core::vector3df(0.0f, 1.0f, 0.0f));
+
+	// a wall 10x10 at z = 0
+	core::vector3df wall[] = {
+		core::vector3df(-5.0f, -5.0f, 0.0f),
+		core::vector3df(5.0f, -5.0f, 0.0f),
+		core::vector3df(5.0f, 5.0f, 0.0f),
+		core::vector3df(-5.0f, 5.0f, 0.0f),
+	};
+	u32 indices[] = { 0, 1, 2, 0, 2, 3 };
+
+	occlusion->beginFrame(proj * view);
+	occlusion->addOccluder(wall, 4, indices, 6, core::IdentityMatrix);
+	occlusion->rasterize();
+
+	TEST_CASE("Software occlusion depth");
+	int cx = occlusion->getWidth() / 2;
+	int cy = occlusion->getHeight() / 2;
+	TEST_ASSERT_THROW(occlusion->getDepth(cx, cy) < FLT_MAX);
+	TEST_ASSERT_THROW(occlusion->getDepth(0, 0) == FLT_MAX);
+
+	TEST_CASE("Software occlusion test box");
+	// behind the wall
+	core::aabbox3df hidden(core::vector3df(-1.0f, -1.0f, 4.0f), core::vector3df(1.0f, 1.0f, 6.0f));
+	TEST_ASSERT_THROW(occlusion->testBox(hidden) == false);
+
+	// in front of the wall
+	core::aabbox3df front(core::vector3df(-1.0f, -1.0f, -6.0f), core::vector3df(1.0f, 1.0f, -4.0f));
+	TEST_ASSERT_THROW(occlusion->testBox(front) == true);
+
+	// behind, but not covered by the wall
+	core::aabbox3df side(core::vector3df(9.0f, -1.0f, 4.0f), core::vector3df(11.0f, 1.0f, 6.0f));
+	TEST_ASSERT_THROW(occlusion->testBox(side) == true);
+
+	// cross the camera plane
+	core::aabbox3df nearBox(core::vector3df(-1.0f, -1.0f, -11.0f), core::vector3df(1.0f, 1.0f, -9.0f));
+	TEST_ASSERT_THROW(occlusion->testBox(nearBox) == true);
+
+	TEST_CASE("Software occlusion triangle setup");
+	// front face, back face, clipped by near plane and degenerate triangles
+	CSoftwareOcclusion::SClipTriangle4 batch;
+	f32 clip[4][3][4] = {
+		{ { -0.5f, -0.5f, 0.5f, 1.0f }, { 0.5f, -0.5f, 0.5f, 1.0f }, { 0.0f, 0.5f, 0.2f, 2.0f } },
+		{ { -0.5f, -0.5f, 0.5f, 1.0f }, { 0.0f, 0.5f, 0.2f, 2.0f }, { 0.5f, -0.5f, 0.5f, 1.0f } },
+		{ { -0.5f, -0.5f, 0.5f, -1.0f }, { 0.5f, -0.5f, 0.5f, 1.0f }, { 0.0f, 0.5f, 0.5f, 1.0f } },
+		{ { 0.1f, 0.1f, 0.5f, 1.0f }, { 0.1f, 0.1f, 0.5f, 1.0f }, { 0.1f, 0.1f, 0.5f, 1.0f } },
+	};
+	for (int t = 0; t < 4; t++)
+	{
+		for (int v = 0; v < 3; v++)
+		{
+			batch.X[v][t] = clip[t][v][0];
+			batch.Y[v][t] = clip[t][v][1];
+			batch.Z[v][t] = clip[t][v][2];
+			batch.W[v][t] = clip[t][v][3];
+		}
+	}
+
+	CSoftwareOcclusion::STriangleSetup4 simd, scalar;
+	CSoftwareOcclusion::setupTriangle4(batch, 256.0f, 128.0f, simd);
+	CSoftwareOcclusion::setupTriangle4Scalar(batch, 256.0f, 128.0f, scalar);
+	TEST_ASSERT_EQUAL(simd.Valid, 3);
+	TEST_ASSERT_EQUAL(scalar.Valid, 3);
+	for (int t = 0; t < 2; t++)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			TEST_ASSERT_THROW(core::equals(simd.EdgeA[i][t], scalar.EdgeA[i][t], 0.001f));
+			TEST_ASSERT_THROW(core::equals(simd.EdgeB[i][t], scalar.EdgeB[i][t], 0.001f));
+			TEST_ASSERT_THROW(core::equals(simd.EdgeC[i][t], scalar.EdgeC[i][t], 0.01f));
+		}
+		TEST_ASSERT_THROW(core::equals(simd.ZA[t], scalar.ZA[t], 0.0001f));
+		TEST_ASSERT_THROW(core::equals(simd.ZB[t], scalar.ZB[t], 0.0001f));
+		TEST_ASSERT_THROW(core::equals(simd.ZC[t], scalar.ZC[t], 0.0001f));
+		TEST_ASSERT_THROW(simd.MinX[t] == scalar.MinX[t] && simd.MaxY[t] == scalar.MaxY[t]);
+	}
+
+	// the back face has the same edges and depth plane as the front face
+	f32 frontEdge = simd.EdgeA[0][0] + simd.EdgeA[1][0] + simd.EdgeA[2][0];
+	f32 backEdge = simd.EdgeA[0][1] + simd.EdgeA[1][1] + simd.EdgeA[2][1];
+	TEST_ASSERT_THROW(core::equals(frontEdge, backEdge, 0.001f));
+	TEST_ASSERT_THROW(core::equals(simd.ZA[0], simd.ZA[1], 0.0001f));
+
+	TEST_CASE("Software occlusion stats");
+	const CSoftwareOcclusion::SStats& stats = occlusion->getStats();
+	TEST_ASSERT_EQUAL(stats.OccludersDrawn, 1);
+	TEST_ASSERT_EQUAL(stats.TrianglesDrawn, 2);
+	TEST_ASSERT_EQUAL(stats.ObjectsTested, 4);
+	TEST_ASSERT_EQUAL(stats.ObjectsRejected, 1);
+
+	delete occlusion;
+}
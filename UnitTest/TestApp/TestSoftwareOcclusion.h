@@ -0,0 +1,3 @@
+#pragma once
+
+void testSoftwareOcclusion();
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestSoftwareSkinning.h"
+
+#include "RenderMesh/CSkinnedMesh.h"
+#include "VertexAnimation/CSoftwareSkinningUtils.h"
+
+using namespace Skylicht;
+
+// large enough to be split to the jobs
+#define TEST_SKIN_VERTEX 5000
+
+static bool vectorEqual(const core::vector3df& a, const core::vector3df& b)
+{
+	return a.getDistanceFrom(b) < 0.0001f;
+}
+
+static void testSkinning()
+{
+	TEST_CASE("Software skinning");
+
+	IVideoDriver* driver = getVideoDriver();
+
+	core::matrix4 matrices[3];
+	matrices[0].setTranslation(core::vector3df(1.0f, 2.0f, 3.0f));
+	matrices[1].setRotationDegrees(core::vector3df(0.0f, 90.0f, 0.0f));
+	matrices[2].setRotationDegrees(core::vector3df(30.0f, 0.0f, 45.0f));
+	matrices[2].setTranslation(core::vector3df(-1.0f, 0.0f, 0.5f));
+
+	CSkinnedMesh* mesh = new CSkinnedMesh();
+	for (int i = 0; i < 3; i++)
+	{
+		CSkinnedMesh::SJoint joint;
+		joint.SkinningMatrix = matrices[i].pointer();
+		mesh->Joints.push_back(joint);
+	}
+
+	CMeshBuffer<S3DVertexSkin>* mb = new CMeshBuffer<S3DVertexSkin>(driver->getVertexDescriptor(EVT_SKIN), video::EIT_16BIT);
+	IVertexBuffer* vb = mb->getVertexBuffer();
+	for (int i = 0; i < TEST_SKIN_VERTEX; i++)
+	{
+		S3DVertexSkin v;
+		v.Pos.set((f32)(i % 17), (f32)(i % 5) * 0.5f, (f32)(i % 11) - 5.0f);
+		v.Normal.set(0.0f, 1.0f, 0.0f);
+		v.BoneIndex = SVec4((f32)(i % 3), (f32)((i + 1) % 3), 0.0f, 0.0f);
+
+		// some vertices have one bone
+		if (i % 4 == 0)
+			v.BoneWeight = SVec4(1.0f, 0.0f, 0.0f, 0.0f);
+		else
+			v.BoneWeight = SVec4(0.7f, 0.3f, 0.0f, 0.0f);
+		vb->addVertex(&v);
+	}
+	mesh->addMeshBuffer(mb, "Skin");
+	mb->drop();
+
+	CMesh* result = CSoftwareSkinningUtils::initSoftwareSkinning(mesh);
+	CSoftwareSkinningUtils::softwareSkinning(result, mesh, NULL);
+
+	S3DVertexSkin* src = (S3DVertexSkin*)vb->getVertices();
+	S3DVertex* dst = (S3DVertex*)result->getMeshBuffer(0)->getVertexBuffer(0)->getVertices();
+
+	bool pass = true;
+	for (int i = 0; i < TEST_SKIN_VERTEX; i++)
+	{
+		core::vector3df pos, normal;
+		const f32* weight = &src[i].BoneWeight.X;
+		const f32* boneId = &src[i].BoneIndex.X;
+		for (int b = 0; b < 4; b++)
+		{
+			if (weight[b] > 0.0f)
+				CSoftwareSkinningUtils::skinVertex(matrices[(int)boneId[b]].pointer(), pos, normal, src[i].Pos, src[i].Normal, weight[b]);
+		}
+
+		if (!vectorEqual(pos, dst[i].Pos) || !vectorEqual(normal, dst[i].Normal))
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+
+	result->drop();
+	mesh->drop();
+}
+
+static CBlendShape* createBlendShape(int step, const core::vector3df& offset)
+{
+	CBlendShape* blendShape = new CBlendShape();
+
+	// the id of the vertices that have no offset
+	u32 sentinel = (TEST_SKIN_VERTEX + step - 1) / step;
+
+	blendShape->VtxId.set_used(TEST_SKIN_VERTEX);
+	for (int i = 0; i < TEST_SKIN_VERTEX; i++)
+		blendShape->VtxId[i] = sentinel;
+
+	for (int i = 0, id = 0; i < TEST_SKIN_VERTEX; i += step, id++)
+	{
+		blendShape->VtxId[i] = id;
+		blendShape->Offset.push_back(offset);
+		blendShape->NormalOffset.push_back(core::vector3df(0.0f, 0.0f, 1.0f));
+	}
+
+	// the last offset is not used
+	blendShape->Offset.push_back(core::vector3df());
+	blendShape->NormalOffset.push_back(core::vector3df());
+	return blendShape;
+}
+
+static void testBlendShape()
+{
+	TEST_CASE("Software blend shape");
+
+	IVideoDriver* driver = getVideoDriver();
+
+	CMeshBuffer<S3DVertexTangents>* mb = new CMeshBuffer<S3DVertexTangents>(driver->getVertexDescriptor(EVT_TANGENTS), video::EIT_16BIT);
+	IVertexBuffer* vb = mb->getVertexBuffer();
+	for (int i = 0; i < TEST_SKIN_VERTEX; i++)
+	{
+		S3DVertexTangents v;
+		v.Pos.set((f32)i, 0.0f, 0.0f);
+		v.Normal.set(0.0f, 1.0f, 0.0f);
+		v.VertexData.set(1.0f, (f32)i);
+		vb->addVertex(&v);
+	}
+
+	CMesh* mesh = new CMesh();
+	mesh->addMeshBuffer(mb, "BlendShape");
+	mb->drop();
+
+	CBlendShape* a = createBlendShape(2, core::vector3df(0.0f, 2.0f, 0.0f));
+	CBlendShape* b = createBlendShape(3, core::vector3df(0.0f, 0.0f, 4.0f));
+	a->Weight = 0.5f;
+	b->Weight = 0.25f;
+	mesh->addBlendShape(a);
+	mesh->addBlendShape(b);
+	a->drop();
+	b->drop();
+
+	CMesh* result = CSoftwareSkinningUtils::initSoftwareBlendShape(mesh);
+	TEST_ASSERT_EQUAL(a->Vertices[0].size(), (TEST_SKIN_VERTEX + 1) / 2);
+
+	CSoftwareSkinningUtils::softwareBlendShape(result, mesh);
+
+	S3DVertexTangents* dst = (S3DVertexTangents*)result->getMeshBuffer(0)->getVertexBuffer(0)->getVertices();
+
+	// the weights of the blend shapes are accumulated
+	TEST_ASSERT_THROW(vectorEqual(dst[6].Pos, core::vector3df(6.0f, 1.0f, 1.0f)));
+	TEST_ASSERT_THROW(vectorEqual(dst[6].Normal, core::vector3df(0.0f, 1.0f, 0.75f)));
+	TEST_ASSERT_THROW(vectorEqual(dst[2].Pos, core::vector3df(2.0f, 1.0f, 0.0f)));
+	TEST_ASSERT_THROW(vectorEqual(dst[3].Pos, core::vector3df(3.0f, 0.0f, 1.0f)));
+	TEST_ASSERT_THROW(vectorEqual(dst[5].Pos, core::vector3df(5.0f, 0.0f, 0.0f)));
+
+	// the vertices are restored when the weight is zero
+	a->Weight = 0.0f;
+	CSoftwareSkinningUtils::softwareBlendShape(result, mesh);
+	TEST_ASSERT_THROW(vectorEqual(dst[6].Pos, core::vector3df(6.0f, 0.0f, 1.0f)));
+	TEST_ASSERT_THROW(vectorEqual(dst[2].Pos, core::vector3df(2.0f, 0.0f, 0.0f)));
+	TEST_ASSERT_THROW(vectorEqual(dst[2].Normal, core::vector3df(0.0f, 1.0f, 0.0f)));
+
+	result->drop();
+	mesh->drop();
+}
+
+void testSoftwareSkinning()
+{
+	testSkinning();
+	testBlendShape();
+}
@@ -42,6 +42,57 @@ void testSystemThread()
 	g_thread = System::IThread::createThread(new TestThreadCallback());
 
 	getIrrlichtDevice()->sleep(100);
+
+	testJobScheduler();
+}
+
+void testJobScheduler()
+{
+	TEST_CASE("Job scheduler");
+	System::CJobScheduler* scheduler = new System::CJobScheduler(3);
+	TEST_ASSERT_EQUAL(scheduler->getWorkerCount(), 3);
+
+	TEST_CASE("Job dependencies");
+	std::atomic<int> step(0);
+	int orderA = -1, orderB = -1, orderC = -1;
+
+	System::CJobHandle a = scheduler->run([&]() { orderA = step++; });
+	System::CJobHandle b = scheduler->run([&]() { orderB = step++; }, &a, 1);
+
+	System::CJobHandle ab[] = { a, b };
+	System::CJobHandle c = scheduler->run([&]() { orderC = step++; }, ab, 2);
+
+	scheduler->wait(c);
+	TEST_ASSERT_THROW(a.isFinished() && b.isFinished() && c.isFinished());
+	TEST_ASSERT_EQUAL(orderA, 0);
+	TEST_ASSERT_EQUAL(orderB, 1);
+	TEST_ASSERT_EQUAL(orderC, 2);
+
+	TEST_CASE("Job parallel for");
+	std::vector<int> values(10000, 0);
+	scheduler->parallelFor(0, (int)values.size(), 100, [&](int from, int to)
+		{
+			for (int i = from; i < to; i++)
+				values[i] += i;
+		});
+
+	bool pass = true;
+	for (int i = 0, n = (int)values.size(); i < n; i++)
+	{
+		if (values[i] != i)
+			pass = false;
+	}
+	TEST_ASSERT_THROW(pass);
+
+	TEST_CASE("Job scheduler without worker");
+	System::CJobScheduler* inlineScheduler = new System::CJobScheduler(0);
+	int value = 0;
+	System::CJobHandle job = inlineScheduler->run([&]() { value = 1; });
+	TEST_ASSERT_THROW(job.isFinished());
+	TEST_ASSERT_EQUAL(value, 1);
+
+	delete inlineScheduler;
+	delete scheduler;
 }
 
 bool isSystemThreadPass()
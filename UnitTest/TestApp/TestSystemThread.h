@@ -3,6 +3,7 @@
 #include "Base.hh"
 #include "Thread/IThread.h"
 #include "Thread/IMutex.h"
+#include "Job/CJobScheduler.h"
 
 using namespace Skylicht;
 
@@ -24,4 +25,6 @@ public:
 
 void testSystemThread();
 
+void testJobScheduler();
+
 bool isSystemThreadPass();
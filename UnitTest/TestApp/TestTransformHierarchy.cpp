@@ -0,0 +1,101 @@
+#include "pch.h"
+#include "Base.hh"
+#include "TestTransformHierarchy.h"
+
+#include "Scene/CScene.h"
+#include "Transform/CWorldTransformData.h"
+#include "Transform/CWorldInverseTransformData.h"
+#include "Transform/CWorldTransformSystem.h"
+
+using namespace Skylicht;
+
+static bool isChanged(CGroupTransform* group, CGameObject* obj)
+{
+	CEntity** changed = group->getChangedEntities();
+	for (int i = 0, n = group->getChangedCount(); i < n; i++)
+	{
+		if (changed[i] == obj->getEntity())
+			return true;
+	}
+	return false;
+}
+
+// compare with the matrices that calculated by walking the parents
+static bool checkTransform(CGameObject* obj)
+{
+	CEntity* entity = obj->getEntity();
+	CWorldTransformData* world = GET_ENTITY_DATA(entity, CWorldTransformData);
+	CWorldInverseTransformData* worldInv = GET_ENTITY_DATA(entity, CWorldInverseTransformData);
+
+	core::matrix4 reference = world->calcWorldMatrix();
+	core::matrix4 inverse;
+	reference.getInverse(inverse);
+
+	return world->World.equals(reference, 0.001f) && worldInv->WorldInverse.equals(inverse, 0.001f);
+}
+
+void testTransformHierarchy()
+{
+	TEST_CASE("Transform hierarchy");
+	CScene* scene = new CScene();
+	CZone* zone = scene->createZone();
+
+	/*
+	Zone
+	  + A
+	     + B
+	        + C
+	  + D
+	*/
+	CContainerObject* a = zone->createContainerObject();
+	CContainerObject* b = a->createContainerObject();
+	CGameObject* c = b->createEmptyObject();
+	CContainerObject* d = zone->createContainerObject();
+	scene->updateAddRemoveObject();
+
+	CGameObject* objects[] = { a, b, c, d };
+	for (CGameObject* obj : objects)
+		obj->getEntity()->addData<CWorldInverseTransformData>();
+
+	a->getTransformEuler()->setPosition(core::vector3df(1.0f, 2.0f, 3.0f));
+	b->getTransformEuler()->setRotation(core::vector3df(0.0f, 45.0f, 0.0f));
+	c->getTransformEuler()->setPosition(core::vector3df(0.0f, 0.0f, 5.0f));
+	d->getTransformEuler()->setPosition(core::vector3df(-10.0f, 0.0f, 0.0f));
+	scene->update();
+
+	CGroupTransform* group = scene->getEntityManager()->getSystem<CWorldTransformSystem>()->getGroupTransform();
+	TEST_ASSERT_EQUAL(group->getChangedCount(), 5);
+	for (CGameObject* obj : objects)
+		TEST_ASSERT_THROW(checkTransform(obj));
+
+	TEST_CASE("Transform hierarchy changed parent");
+	a->getTransformEuler()->setPosition(core::vector3df(4.0f, 5.0f, 6.0f));
+	scene->update();
+
+	// the childs of A are updated, D is not changed
+	TEST_ASSERT_EQUAL(group->getChangedCount(), 3);
+	TEST_ASSERT_THROW(isChanged(group, a));
+	TEST_ASSERT_THROW(isChanged(group, b));
+	TEST_ASSERT_THROW(isChanged(group, c));
+	TEST_ASSERT_THROW(!isChanged(group, d));
+	for (CGameObject* obj : objects)
+		TEST_ASSERT_THROW(checkTransform(obj));
+
+	TEST_CASE("Transform hierarchy reparent");
+	d->bringToChild(c);
+	scene->update();
+
+	CWorldTransformData* transformC = GET_ENTITY_DATA(c->getEntity(), CWorldTransformData);
+	TEST_ASSERT_THROW(transformC->Parent == GET_ENTITY_DATA(d->getEntity(), CWorldTransformData));
+	TEST_ASSERT_EQUAL(transformC->Depth, 2);
+	TEST_ASSERT_THROW(isChanged(group, c));
+	TEST_ASSERT_THROW(!isChanged(group, a));
+	for (CGameObject* obj : objects)
+		TEST_ASSERT_THROW(checkTransform(obj));
+
+	TEST_CASE("Transform hierarchy no change");
+	scene->update();
+	TEST_ASSERT_EQUAL(group->getChangedCount(), 0);
+
+	delete scene;
+}